@@ -0,0 +1,366 @@
+#include "balance_runner.h"
+#include "colony.h"
+#include "command.h"
+#include "resource_manager.h"
+#include "sect.h"
+#include "sim_scheduler.h"
+#include "sim_stepper.h"
+#include "time_manager.h"
+#include "unit.h"
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <sstream>
+
+namespace {
+    // The policy acts once a game tick
+    const int POLICY_INTERVAL_STEPS = static_cast<int>(TICK_DURATION / SimScheduler::STEP_SECONDS + 0.5f);
+    const int STEPS_PER_DAY = POLICY_INTERVAL_STEPS * TICKS_PER_DAY;
+
+    // Below one unit a sect counts as out of the resource
+    const float STARVED_BELOW = 1.0f;
+    const ResourceType STAPLES[] = {ResourceType::ENERGY, ResourceType::WATER, ResourceType::FOOD};
+
+    const int MAX_VALUES_PER_AXIS = 10000;
+
+    void SetError(std::string* error, const std::string& message) {
+        if (error) *error = message;
+    }
+
+    std::string Trim(const std::string& text) {
+        size_t first = text.find_first_not_of(" \t\r");
+        if (first == std::string::npos) return "";
+        size_t last = text.find_last_not_of(" \t\r");
+        return text.substr(first, last - first + 1);
+    }
+
+    bool ParseFloat(const std::string& text, float& out) {
+        std::string value = Trim(text);
+        if (value.empty()) return false;
+        char* end = nullptr;
+        out = std::strtof(value.c_str(), &end);
+        return *end == '\0' && std::isfinite(out);
+    }
+
+    bool ParseInt(const std::string& text, int lo, int hi, int& out) {
+        std::string value = Trim(text);
+        if (value.empty()) return false;
+        char* end = nullptr;
+        long parsed = std::strtol(value.c_str(), &end, 10);
+        if (*end != '\0' || parsed < lo || parsed > hi) return false;
+        out = static_cast<int>(parsed);
+        return true;
+    }
+
+    // "from:to:step" (inclusive, to within half a step) or "a, b, c"
+    bool ParseValues(const std::string& text, std::vector<float>& values) {
+        values.clear();
+        if (text.find(':') != std::string::npos) {
+            std::stringstream parts(text);
+            std::string part;
+            float range[3];
+            int count = 0;
+            while (std::getline(parts, part, ':')) {
+                if (count == 3 || !ParseFloat(part, range[count])) return false;
+                count++;
+            }
+            if (count != 3 || range[2] <= 0.0f || range[1] < range[0]) return false;
+            double steps = std::floor((static_cast<double>(range[1]) - range[0]) / range[2] + 0.5);
+            if (steps >= MAX_VALUES_PER_AXIS) return false;
+            for (int i = 0; i <= static_cast<int>(steps); i++) {
+                values.push_back(static_cast<float>(range[0] + static_cast<double>(range[2]) * i));
+            }
+            return true;
+        }
+
+        std::stringstream list(text);
+        std::string item;
+        while (std::getline(list, item, ',')) {
+            float value = 0.0f;
+            if (!ParseFloat(item, value) || values.size() >= MAX_VALUES_PER_AXIS) return false;
+            values.push_back(value);
+        }
+        return !values.empty();
+    }
+
+    // Sect storage plus colony reserves, by resource
+    ResourceVector TotalResources(const std::vector<Colony*>& colonies) {
+        ResourceVector total;
+        for (const Colony* colony : colonies) {
+            total += colony->GetStrategicReserves();
+            for (const Sect* sect : colony->GetSects()) {
+                total += sect->GetResourceStorage();
+            }
+        }
+        return total;
+    }
+
+    bool PastSurplus(const ResourceVector& amounts, const ResourceVector& capacity) {
+        const float threshold = Balance().storageSurplusThreshold;
+        for (auto [type, cap] : capacity) {
+            if (cap > 0.0f && amounts.Get(type) / cap > threshold) return true;
+        }
+        return false;
+    }
+
+    class ScriptedPolicy {
+    public:
+        ScriptedPolicy(ResourceManager& resources, TimeManager& time, std::vector<Colony*>& colonies,
+                       const SimClock* clock)
+            : resources(resources), time(time), colonies(colonies), clock(clock) {}
+
+        // Returns the upgrades made
+        int Act(BalanceKpis& kpis) {
+            int upgrades = 0;
+            for (size_t c = 0; c < colonies.size(); c++) {
+                Colony* colony = colonies[c];
+                const std::vector<Sect*>& sects = colony->GetSects();
+                for (size_t s = 0; s < sects.size(); s++) {
+                    Sect* sect = sects[s];
+                    if (PastSurplus(sect->GetResourceStorage(), sect->GetStorageCapacity()) &&
+                        Apply(CommandType::UPGRADE_STORAGE, c, s)) {
+                        upgrades++;
+                    }
+
+                    const std::vector<Unit*>& units = sect->GetUnits();
+                    for (size_t u = 0; u < units.size(); u++) {
+                        const auto& modules = units[u]->GetModules();
+                        for (size_t m = 0; m < modules.size(); m++) {
+                            if (!modules[m].isBuilt) {
+                                if (Apply(CommandType::BUILD_MODULE, c, s, u, m)) kpis.builds++;
+                            } else if (units[u]->PublicCanUpgradeModule(static_cast<int>(m)) &&
+                                       Apply(CommandType::UPGRADE_MODULE, c, s, u, m)) {
+                                upgrades++;
+                            }
+                        }
+                    }
+                }
+
+                if (PastSurplus(colony->GetStrategicReserves(), colony->GetReserveCapacity()) &&
+                    Apply(CommandType::UPGRADE_RESERVES, c)) {
+                    upgrades++;
+                }
+            }
+            return upgrades;
+        }
+
+    private:
+        bool Apply(CommandType type, size_t colony, size_t sect = 0, size_t unit = 0, size_t module = 0) {
+            Command command(type, static_cast<int32_t>(module));
+            command.colony = static_cast<int32_t>(colony);
+            command.sect = static_cast<int32_t>(sect);
+            command.unit = static_cast<int32_t>(unit);
+            return ApplyCommand(command, resources, time, colonies, clock);
+        }
+
+        ResourceManager& resources;
+        TimeManager& time;
+        std::vector<Colony*>& colonies;
+        const SimClock* clock;
+    };
+
+    // Resources the curves and final totals report, in column order
+    std::vector<ResourceType> ReportedResources() {
+        return std::vector<ResourceType>(SINGULAR_RESOURCE_TYPES.begin(), SINGULAR_RESOURCE_TYPES.end());
+    }
+}
+
+WorldSpec BalanceWorldDefaults() {
+    WorldSpec spec;
+    spec.colonies = 2;
+    spec.minSects = 3;
+    spec.maxSects = 5;
+    spec.extraRoads = 0.5f;
+    spec.unitActive = 1.0f;
+    spec.moduleBuilt = 0.0f;
+    spec.maxTier = 0;
+    spec.separation = 0.5f;
+    spec.prospecting = 0.0f;
+    spec.packets = 0;
+    return spec;
+}
+
+bool ParseBalanceSweep(const std::string& text, BalanceSweep& sweep, std::string* error) {
+    sweep = BalanceSweep();
+
+    std::string normalised = text;
+    for (char& c : normalised) {
+        if (c == ';') c = '\n';
+    }
+
+    std::stringstream lines(normalised);
+    std::string line;
+    while (std::getline(lines, line)) {
+        line = Trim(line.substr(0, line.find('#')));
+        if (line.empty()) continue;
+
+        size_t equals = line.find('=');
+        if (equals == std::string::npos) {
+            SetError(error, "expected key = value: " + line);
+            return false;
+        }
+        std::string key = Trim(line.substr(0, equals));
+        std::string value = Trim(line.substr(equals + 1));
+
+        if (key == "world") {
+            std::string worldError;
+            if (!ParseWorldSpec(value, sweep.world, &worldError)) {
+                SetError(error, worldError);
+                return false;
+            }
+        } else if (key == "seeds") {
+            if (!ParseInt(value, 1, 1000000, sweep.seeds)) {
+                SetError(error, "bad seed count: " + line);
+                return false;
+            }
+        } else if (key == "days") {
+            if (!ParseInt(value, 1, 3650, sweep.days)) {
+                SetError(error, "bad day count: " + line);
+                return false;
+            }
+        } else {
+            if (!BalanceParams().Find(key)) {
+                SetError(error, "unknown balance parameter: " + key);
+                return false;
+            }
+            for (const BalanceSweep::Axis& axis : sweep.axes) {
+                if (axis.name == key) {
+                    SetError(error, "parameter swept twice: " + key);
+                    return false;
+                }
+            }
+            BalanceSweep::Axis axis;
+            axis.name = key;
+            if (!ParseValues(value, axis.values)) {
+                SetError(error, "bad values: " + line);
+                return false;
+            }
+            sweep.axes.push_back(axis);
+        }
+    }
+    return true;
+}
+
+int CountBalanceRuns(const BalanceSweep& sweep) {
+    long long runs = sweep.seeds;
+    for (const BalanceSweep::Axis& axis : sweep.axes) {
+        runs *= static_cast<long long>(axis.values.size());
+        if (runs > INT_MAX) return 0;
+    }
+    return static_cast<int>(runs);
+}
+
+BalanceRun MakeBalanceRun(const BalanceSweep& sweep, int index) {
+    BalanceRun run;
+    run.index = index;
+    run.combination = index / sweep.seeds;
+    run.seed = sweep.world.seed + static_cast<unsigned int>(index % sweep.seeds);
+
+    // Last axis fastest
+    int rest = run.combination;
+    for (size_t a = sweep.axes.size(); a-- > 0;) {
+        const BalanceSweep::Axis& axis = sweep.axes[a];
+        int count = static_cast<int>(axis.values.size());
+        *run.params.Find(axis.name) = axis.values[rest % count];
+        rest /= count;
+    }
+    return run;
+}
+
+BalanceKpis RunBalanceGame(const BalanceSweep& sweep, const BalanceRun& run) {
+    BalanceScope scope(run.params);
+
+    WorldSpec spec = sweep.world;
+    spec.seed = run.seed;
+    ResourceManager resources(WorldGridSize(spec), SECT_CORE_RADIUS * 2.0f);
+    TimeManager time;
+    SimStepper stepper(0);     // runs are spread over the cores, not their sects
+    std::vector<Colony*> colonies;
+    GenerateWorld(spec, resources, time, colonies, stepper.GetClock());
+
+    BalanceKpis kpis;
+    kpis.run = run.index;
+    kpis.dailyTotals.reserve(sweep.days);
+    ScriptedPolicy policy(resources, time, colonies, stepper.GetClock());
+
+    // Per sect and staple: out of it at the last step
+    std::vector<uint8_t> starved;
+    long long starvedSteps = 0;
+
+    const float dt = SimScheduler::STEP_SECONDS;
+    const int steps = sweep.days * STEPS_PER_DAY;
+    for (int step = 1; step <= steps; step++) {
+        time.Advance(dt);
+        stepper.Step(colonies, dt);
+
+        size_t at = 0;
+        for (const Colony* colony : colonies) {
+            for (const Sect* sect : colony->GetSects()) {
+                bool anyOut = false;
+                for (ResourceType type : STAPLES) {
+                    if (starved.size() <= at) starved.push_back(0);
+                    bool out = sect->GetStorageCapacity(type) > 0.0f &&
+                               sect->GetResourceStorage(type) < STARVED_BELOW;
+                    if (out && !starved[at]) kpis.starvationEvents++;
+                    starved[at++] = out ? 1 : 0;
+                    anyOut = anyOut || out;
+                }
+                if (anyOut) starvedSteps++;
+            }
+        }
+
+        if (step % POLICY_INTERVAL_STEPS == 0) {
+            int upgrades = policy.Act(kpis);
+            if (upgrades > 0 && kpis.upgrades == 0) {
+                kpis.firstUpgradeDay = static_cast<float>(step) / STEPS_PER_DAY;
+            }
+            kpis.upgrades += upgrades;
+        }
+        if (step % STEPS_PER_DAY == 0) {
+            kpis.dailyTotals.push_back(TotalResources(colonies));
+        }
+    }
+
+    kpis.starvedSectDays = static_cast<float>(static_cast<double>(starvedSteps) / STEPS_PER_DAY);
+    kpis.finalTotals = TotalResources(colonies);
+
+    stepper.Release();
+    for (Colony* colony : colonies) delete colony;
+    return kpis;
+}
+
+void WriteBalanceRuns(std::ostream& out, const BalanceSweep& sweep, const std::vector<BalanceKpis>& results) {
+    const std::vector<ResourceType> resources = ReportedResources();
+
+    out << "run,combination,seed";
+    for (const BalanceSweep::Axis& axis : sweep.axes) out << "," << axis.name;
+    out << ",first_upgrade_day,upgrades,builds,starvation_events,starved_sect_days";
+    for (ResourceType type : resources) out << ",final_" << ResourceTypeToString(type);
+    out << "\n";
+
+    for (const BalanceKpis& kpis : results) {
+        BalanceRun run = MakeBalanceRun(sweep, kpis.run);
+        out << run.index << "," << run.combination << "," << run.seed;
+        for (const BalanceSweep::Axis& axis : sweep.axes) out << "," << *run.params.Find(axis.name);
+        out << "," << kpis.firstUpgradeDay << "," << kpis.upgrades << "," << kpis.builds
+            << "," << kpis.starvationEvents << "," << kpis.starvedSectDays;
+        for (ResourceType type : resources) out << "," << kpis.finalTotals.Get(type);
+        out << "\n";
+    }
+}
+
+void WriteBalanceCurves(std::ostream& out, const std::vector<BalanceKpis>& results) {
+    const std::vector<ResourceType> resources = ReportedResources();
+
+    out << "run,day";
+    for (ResourceType type : resources) out << "," << ResourceTypeToString(type);
+    out << "\n";
+
+    for (const BalanceKpis& kpis : results) {
+        for (size_t day = 0; day < kpis.dailyTotals.size(); day++) {
+            out << kpis.run << "," << day + 1;
+            for (ResourceType type : resources) out << "," << kpis.dailyTotals[day].Get(type);
+            out << "\n";
+        }
+    }
+}
@@ -0,0 +1,95 @@
+#ifndef BALANCE_RUNNER_H
+#define BALANCE_RUNNER_H
+
+#include "balance_params.h"
+#include "resource_vector.h"
+#include "world_gen.h"
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Batch balance runs: many seeded headless games over a grid of balance
+// parameters (BalanceParams), each played by the same scripted policy,
+// each reduced to a row of KPIs. tools/balance runs them on every core.
+//
+// A sweep is written as key = value lines (';' also ends a line, '#'
+// starts a comment):
+//
+//   world = colonies=2,sects=3-5,tier=0
+//   seeds = 200
+//   days = 15
+//   AUTO_BALANCE_THRESHOLD = 0.1:0.5:0.1        # from:to:step, inclusive
+//   STORAGE_SURPLUS_THRESHOLD = 0.7, 0.8, 0.9   # a list
+//
+//   world   world spec (world_gen.h) in place of BalanceWorldDefaults;
+//           its seed is the first run seed
+//   seeds   games per parameter combination, on seeds seed .. seed+N-1
+//   days    game days each game runs
+//   <NAME>  a BalanceParams name and the values it takes
+//
+// Runs cover every combination of the parameter values times every seed.
+// Each combination plays the same seeds, so combinations are compared on
+// the same worlds.
+//
+// The scripted policy acts once a game tick, in colony, sect, unit order:
+// it upgrades a sect's storage once any resource there is past the
+// surplus threshold, a colony's reserves likewise, builds every module it
+// can afford and then upgrades module levels. It never unlocks techs
+// (UnlockRegistry is shared by every game in the process), so tier
+// upgrades are left to the world spec.
+
+// A small, mostly unbuilt world: what a player has a few days in
+WorldSpec BalanceWorldDefaults();
+
+struct BalanceSweep {
+    struct Axis {
+        std::string name;
+        std::vector<float> values;
+    };
+
+    std::vector<Axis> axes;
+    WorldSpec world = BalanceWorldDefaults();
+    int seeds = 1;
+    int days = 10;
+};
+
+// Parses `text` into `sweep`, which starts from the defaults above.
+// False, with a message naming the bad line, on an unknown key or
+// parameter, a parameter given twice or a bad value list.
+bool ParseBalanceSweep(const std::string& text, BalanceSweep& sweep, std::string* error);
+
+// Combinations times seeds; 0 when that would not fit in an int
+int CountBalanceRuns(const BalanceSweep& sweep);
+
+struct BalanceRun {
+    int index = 0;
+    int combination = 0;                // into the parameter grid, first axis slowest
+    unsigned int seed = 1;
+    BalanceParams params;
+};
+
+// Run `index` of the sweep, 0 <= index < CountBalanceRuns
+BalanceRun MakeBalanceRun(const BalanceSweep& sweep, int index);
+
+struct BalanceKpis {
+    int run = 0;
+    float firstUpgradeDay = -1.0f;      // game days to the policy's first upgrade, -1 if none
+    int upgrades = 0;                   // storage, reserve and module level upgrades
+    int builds = 0;                     // modules built
+    int starvationEvents = 0;           // a sect's ENERGY, WATER or FOOD running out
+    float starvedSectDays = 0.0f;       // sect-days spent with one of them out
+    ResourceVector finalTotals;         // sect storage plus colony reserves at the end
+    std::vector<ResourceVector> dailyTotals;    // the same at the end of each day
+};
+
+// Plays one run on the calling thread (under the run's balance) and
+// returns its KPIs. The same run always gives the same KPIs.
+BalanceKpis RunBalanceGame(const BalanceSweep& sweep, const BalanceRun& run);
+
+// Columnar output, CSV with a header row. Runs: one row per run, the
+// swept values then the KPIs then the final totals by resource. Curves:
+// one row per run and day, the totals by resource.
+void WriteBalanceRuns(std::ostream& out, const BalanceSweep& sweep, const std::vector<BalanceKpis>& results);
+void WriteBalanceCurves(std::ostream& out, const std::vector<BalanceKpis>& results);
+
+#endif // BALANCE_RUNNER_H
@@ -1,8 +1,31 @@
 #include "colony.h"
+#include "balance_params.h"
+#include "sim_log.h"
+#include "byte_stream.h"
+#include <algorithm>
 #include <iostream>
 
+namespace {
+    const SteadyClock& DefaultClock() {
+        static const SteadyClock clock;
+        return clock;
+    }
+
+    template <typename T>
+    int32_t IndexOf(const std::vector<T>& items, const T& item) {
+        auto it = std::find(items.begin(), items.end(), item);
+        return it != items.end() ? static_cast<int32_t>(it - items.begin()) : -1;
+    }
+
+    template <typename T>
+    T* AtIndex(std::vector<T>& items, int32_t index) {
+        return index >= 0 && index < static_cast<int32_t>(items.size()) ? &items[index] : nullptr;
+    }
+}
+
 Colony::Colony() : jurisdiction_radius(SECT_CORE_RADIUS*4),
-    research_level(0)
+    research_level(0),
+    clock(&DefaultClock())
 {
     // Initialize strategic reserves to 0
     strategicReserves[ResourceType::H2] = 0.0f;
@@ -40,16 +63,31 @@ Colony::~Colony() {
 
 void Colony::AddSect(Sect* sect) {
     sects.push_back(sect);
-    std::cout << "New sect added to the colony." << std::endl;
+    stateRevision++;
+    COLONY_LOG_INFO(Colony, "New sect added to the colony.");
     CalculateCentroid();
     CalculateRadius();
 }
 
 
+void Colony::SetClock(const SimClock* newClock) {
+    const SimClock* next = newClock ? newClock : &DefaultClock();
+
+    // Roads keep how long ago they last sent, whatever the new clock reads
+    float shift = static_cast<float>(next->Now() - clock->Now());
+    if (shift != 0.0f) {
+        for (Road& road : roads) {
+            road.lastTransportTime += shift;
+        }
+    }
+    clock = next;
+}
+
 void Colony::BuildRoad(Sect* sect_a, Sect* sect_b) {
     roads.emplace_back(sect_a, sect_b);
-    std::cout << "New road built between sects. Length: " << roads.back().length
-              << ", Travel time: " << roads.back().travelTime << "s" << std::endl;
+    stateRevision++;
+    COLONY_LOG_INFO(Colony, "New road built between sects. Length: " << roads.back().length
+              << ", Travel time: " << roads.back().travelTime << "s");
 }
 
 void Colony::ManageResources() {
@@ -70,7 +108,8 @@ void Colony::ManageResources() {
 
 void Colony::UnlockResearch() {
     research_level++;
-    std::cout << "Colony research level increased to " << research_level << std::endl;
+    stateRevision++;
+    COLONY_LOG_INFO(Colony, "Colony research level increased to " << research_level);
     // TODO: Implement unlocking of new technologies based on research level
 }
 
@@ -82,13 +121,9 @@ bool Colony::CanUpgradeReserves() const {
     float siCost = COLONY_UPGRADE_COST_SI[nextLevel];
     float energyCost = COLONY_UPGRADE_COST_ENERGY[nextLevel];
 
-    auto feIt = strategicReserves.find(ResourceType::Fe);
-    auto siIt = strategicReserves.find(ResourceType::Si);
-    auto enIt = strategicReserves.find(ResourceType::ENERGY);
-
-    float feAvail = (feIt != strategicReserves.end()) ? feIt->second : 0.0f;
-    float siAvail = (siIt != strategicReserves.end()) ? siIt->second : 0.0f;
-    float enAvail = (enIt != strategicReserves.end()) ? enIt->second : 0.0f;
+    float feAvail = strategicReserves.Get(ResourceType::Fe);
+    float siAvail = strategicReserves.Get(ResourceType::Si);
+    float enAvail = strategicReserves.Get(ResourceType::ENERGY);
 
     return feAvail >= feCost && siAvail >= siCost && enAvail >= energyCost;
 }
@@ -104,70 +139,20 @@ void Colony::UpgradeReserves() {
     strategicReserves[ResourceType::ENERGY] -= COLONY_UPGRADE_COST_ENERGY[nextLevel];
 
     reserveLevel = nextLevel;
+    stateRevision++;
 
     // Update all reserve capacities
-    float multiplier = STORAGE_LEVEL_MULTIPLIERS[reserveLevel];
-    for (auto& [type, cap] : reserveCapacity)
+    float multiplier = Balance().storageLevelMultipliers[reserveLevel];
+    for (auto [type, cap] : reserveCapacity)
     {
         cap = COLONY_BASE_RESERVES * multiplier;
     }
 
-    std::cout << "Colony reserves upgraded to level " << reserveLevel
-              << " (capacity: " << COLONY_BASE_RESERVES * multiplier << ")" << std::endl;
-}
-
-
-
-void Colony::Draw(Camera2D& camera) {
-    // Translate the drawing to center the colony
-//    Vector2 screenCenter = { GetScreenWidth() / 2.0f, GetScreenHeight() / 2.0f };
-//    Vector2 translation = { screenCenter.x - centroid.x, screenCenter.y - centroid.y };
-
-    // Draw each sect inside the colony
-    for (const auto& sect : sects) {
-        Vector2 worldPos = sect->GetPosition();  // This should already be in world coordinates
-        sect->DrawInColonyView(worldPos);
-        DrawText(TextFormat("R_c: %f", GetRadius()), worldPos.x-10, worldPos.y-20, 20, GRAY);
-
-    }
-
-    // Draw jurisdiction circle when mouse is hovering over it
-    Vector2 mouseScreenPos = GetMousePosition();
-    Vector2 mouseWorldPos = GetScreenToWorld2D(mouseScreenPos, camera);
-
-    if (CheckCollisionPointCircle(mouseWorldPos, centroid, jurisdiction_radius)) {
-        DrawJurisdiction();
-    }
-
-
+    COLONY_LOG_INFO(Colony, "Colony reserves upgraded to level " << reserveLevel
+              << " (capacity: " << COLONY_BASE_RESERVES * multiplier << ")");
 }
 
-void Colony::DrawJurisdiction() {
-    // Draw dashed circle showing jurisdiction area
-    const int numSegments = 36;  // Number of segments in the circle
-    const float angleStep = 2.0f * PI / numSegments;
-    const float dashLength = 10.0f;  // Length of each dash in the circle
-
-    for (int i = 0; i < numSegments; i++) {
-        float startAngle = i * angleStep;
-        float endAngle = startAngle + angleStep / 2;  // Draw half of each segment for dashed effect
-
-        Vector2 start = {
-            centroid.x + jurisdiction_radius * cosf(startAngle),
-            centroid.y + jurisdiction_radius * sinf(startAngle)
-        };
-        Vector2 end = {
-            centroid.x + jurisdiction_radius * cosf(endAngle),
-            centroid.y + jurisdiction_radius * sinf(endAngle)
-        };
-
-        // Draw the dash in red with transparency
-        DrawLineEx(start, end, 2.0f, ColorAlpha(RED, 0.5f));
-    }
 
-    // Optional: Draw a transparent fill
-    DrawCircleV(centroid, jurisdiction_radius, ColorAlpha(RED, 0.1f));
-}
 
 void Colony::CalculateCentroid() {
     // If there are no sects, return zero vector
@@ -221,29 +206,24 @@ void Colony::CalculateRadius() {
 }
 
 float Colony::GetReserveUsage(ResourceType type) const {
-    auto reserveIt = strategicReserves.find(type);
-    auto capacityIt = reserveCapacity.find(type);
-
-    if (reserveIt == strategicReserves.end() || capacityIt == reserveCapacity.end()) {
+    if (!strategicReserves.Has(type) || !reserveCapacity.Has(type)) {
         return 0.0f;
     }
 
-    if (capacityIt->second <= 0.0f) {
+    float capacity = reserveCapacity.Get(type);
+    if (capacity <= 0.0f) {
         return 0.0f;
     }
 
-    return reserveIt->second / capacityIt->second;
+    return strategicReserves.Get(type) / capacity;
 }
 
 bool Colony::CanAcceptResource(ResourceType type, float amount) const {
-    auto reserveIt = strategicReserves.find(type);
-    auto capacityIt = reserveCapacity.find(type);
-
-    if (reserveIt == strategicReserves.end() || capacityIt == reserveCapacity.end()) {
+    if (!strategicReserves.Has(type) || !reserveCapacity.Has(type)) {
         return false;
     }
 
-    return (reserveIt->second + amount) <= capacityIt->second;
+    return (strategicReserves.Get(type) + amount) <= reserveCapacity.Get(type);
 }
 
 bool Colony::ReceiveSurplus(ResourceType type, float amount) {
@@ -253,24 +233,25 @@ bool Colony::ReceiveSurplus(ResourceType type, float amount) {
     }
 
     strategicReserves[type] += amount;
+    stateRevision++;
     // std::cout << "Colony received " << amount << " of resource "
     //          << static_cast<int>(type) << " (Total: " << strategicReserves[type] << ")" << std::endl;
     return true;
 }
 
 float Colony::ProvideResource(ResourceType type, float requestedAmount) {
-    auto it = strategicReserves.find(type);
-    if (it == strategicReserves.end() || it->second <= 0.0f) {
+    if (!strategicReserves.Has(type) || strategicReserves.Get(type) <= 0.0f) {
         return 0.0f;  // No reserves available
     }
 
     // Provide what we can (up to requested amount)
-    float available = it->second;
+    float available = strategicReserves.Get(type);
     float provided = std::min(available, requestedAmount);
 
     strategicReserves[type] -= provided;
-    std::cout << "Colony provided " << provided << " of "
-             << ResourceTypeToString(type) << " (Remaining: " << strategicReserves[type] << ")" << std::endl;
+    if (provided > 0.0f) stateRevision++;
+    COLONY_LOG_DEBUG(Colony, "Colony provided " << provided << " of "
+             << ResourceTypeToString(type) << " (Remaining: " << strategicReserves[type] << ")");
 
     return provided;
 }
@@ -279,78 +260,46 @@ float Colony::ProvideResource(ResourceType type, float requestedAmount) {
 bool Colony::AddTypedReserve(const TypedResource& resource) {
     // Validate resource category
     if (GetResourceCategory(resource.baseType) != ResourceCategory::TYPED) {
-        std::cout << "Error: Cannot add non-typed resource to typed reserves" << std::endl;
+        COLONY_LOG_ERROR(Colony, "Error: Cannot add non-typed resource to typed reserves");
         return false;
     }
 
     // Check capacity
-    auto& reserves = typedReserves[resource.baseType];
-    if (static_cast<int>(reserves.size()) >= TYPED_RESERVE_CAPACITY) {
-        std::cout << "Warning: Colony typed reserves full for "
-                 << ResourceTypeToString(resource.baseType) << std::endl;
+    if (!typedReserves.Add(resource)) {
+        COLONY_LOG_WARN(Colony, "Warning: Colony typed reserves full for "
+                 << ResourceTypeToString(resource.baseType));
         return false;
     }
 
-    reserves.push_back(resource);
-    std::cout << "Colony received " << resource.subType << " ("
-             << ResourceTypeToString(resource.baseType) << ")" << std::endl;
+    stateRevision++;
+    COLONY_LOG_DEBUG(Colony, "Colony received " << resource.subType << " ("
+             << ResourceTypeToString(resource.baseType) << ")");
     return true;
 }
 
 bool Colony::RemoveTypedReserve(ResourceType type, const std::string& subtype) {
-    auto it = typedReserves.find(type);
-    if (it == typedReserves.end()) {
+    SubtypeId id;
+    if (!FindSubtype(subtype, id) || !typedReserves.Remove(type, id)) {
         return false;
     }
 
-    auto& reserves = it->second;
-    for (auto resIt = reserves.begin(); resIt != reserves.end(); ++resIt) {
-        if (resIt->subType == subtype) {
-            reserves.erase(resIt);
-            std::cout << "Colony removed " << subtype << " from "
-                     << ResourceTypeToString(type) << " reserves" << std::endl;
-            return true;
-        }
-    }
-
-    return false;
+    stateRevision++;
+    COLONY_LOG_DEBUG(Colony, "Colony removed " << subtype << " from "
+             << ResourceTypeToString(type) << " reserves");
+    return true;
 }
 
 bool Colony::HasTypedReserve(ResourceType type, const std::string& subtype) const {
-    auto it = typedReserves.find(type);
-    if (it == typedReserves.end()) {
-        return false;
-    }
-
-    for (const auto& res : it->second) {
-        if (res.subType == subtype) {
-            return true;
-        }
-    }
-    return false;
+    return GetTypedReserveCount(type, subtype) > 0;
 }
 
 int Colony::GetTypedReserveCount(ResourceType type, const std::string& subtype) const {
-    auto it = typedReserves.find(type);
-    if (it == typedReserves.end()) {
-        return 0;
-    }
-
-    int count = 0;
-    for (const auto& res : it->second) {
-        if (res.subType == subtype) {
-            count++;
-        }
-    }
-    return count;
+    SubtypeId id;
+    return FindSubtype(subtype, id) ? typedReserves.GetCount(type, id) : 0;
 }
 
 int Colony::GetTotalTypedReserveCount(ResourceType type) const {
-    auto it = typedReserves.find(type);
-    if (it == typedReserves.end()) {
-        return 0;
-    }
-    return static_cast<int>(it->second.size());
+    return typedReserves.GetCount(type);
 }
 
 bool Colony::ReceiveTypedSurplus(const TypedResource& resource) {
@@ -358,14 +307,29 @@ bool Colony::ReceiveTypedSurplus(const TypedResource& resource) {
 }
 
 bool Colony::ProvideTypedResource(ResourceType type, TypedResource& outResource) {
-    auto it = typedReserves.find(type);
-    if (it == typedReserves.end() || it->second.empty()) {
-        return false;
+    if (!typedReserves.TakeAny(type, outResource)) return false;
+    stateRevision++;
+    return true;
+}
+
+int Colony::ReceiveTypedSurplus(TypedInventory& source, ResourceType type, int count) {
+    int moved = source.MoveTo(typedReserves, type, count);
+    if (moved > 0) {
+        stateRevision++;
+        COLONY_LOG_DEBUG(Colony, "Colony received " << moved << " "
+                 << ResourceTypeToString(type) << " (Reserves: " << typedReserves.GetCount(type) << ")");
     }
+    return moved;
+}
 
-    outResource = it->second.back();
-    it->second.pop_back();
-    return true;
+int Colony::ProvideTypedResources(ResourceType type, int count, TypedInventory& dest) {
+    int moved = typedReserves.MoveTo(dest, type, count);
+    if (moved > 0) {
+        stateRevision++;
+        COLONY_LOG_DEBUG(Colony, "Colony provided " << moved << " "
+                 << ResourceTypeToString(type) << " (Remaining: " << typedReserves.GetCount(type) << ")");
+    }
+    return moved;
 }
 
 // Transport management methods
@@ -383,19 +347,20 @@ Road* Colony::GetRoad(Sect* sectA, Sect* sectB) {
 void Colony::SetRoadTransportMode(Road* road, TransportMode mode) {
     if (road) {
         road->mode = mode;
-        std::cout << "Road transport mode set to " << static_cast<int>(mode) << std::endl;
+        stateRevision++;
+        COLONY_LOG_INFO(Colony, "Road transport mode set to " << static_cast<int>(mode));
     }
 }
 
 void Colony::CreateTransportJob(Sect* source, Sect* dest, ResourceType type, float amount) {
     Road* road = GetRoad(source, dest);
     if (!road) {
-        std::cout << "[TRANSPORT] Error: No road exists between these sects" << std::endl;
+        COLONY_LOG_ERROR(Transport, "[TRANSPORT] Error: No road exists between these sects");
         return;
     }
 
     // Rate limiting check
-    float currentTime = GetTime();
+    float currentTime = static_cast<float>(clock->Now());
     if (!road->CanAcceptNewJob(currentTime)) {
         // Rate limited - silently skip (don't spam console)
         return;
@@ -424,13 +389,26 @@ void Colony::CreateTransportJob(Sect* source, Sect* dest, ResourceType type, flo
     // Update road tracking
     road->lastTransportTime = currentTime;
     road->activePacketCount++;
+    stateRevision++;
 
-    std::cout << "[TRANSPORT] Job created: " << actualAmount << " of "
+    COLONY_LOG_DEBUG(Transport, "[TRANSPORT] Job created: " << actualAmount << " of "
               << ResourceTypeToString(type) << " | Packets on road: "
-              << road->activePacketCount << "/" << MAX_PACKETS_PER_ROAD << std::endl;
+              << road->activePacketCount << "/" << MAX_PACKETS_PER_ROAD);
+}
+
+void Colony::AddSyntheticTransportJob(Road* road, ResourceType type, float amount, float progress) {
+    if (!road) return;
+    transportJobs.emplace_back(road, road->sectA, road->sectB, type, amount);
+    transportJobs.back().status = TransportStatus::IN_TRANSIT;
+    transportJobs.back().progress = progress;
+    transportJobs.back().previousProgress = progress;
+    road->activePacketCount++;
+    stateRevision++;
 }
 
 void Colony::ProcessTransportJobs(float deltaTime) {
+    if (!transportJobs.empty()) stateRevision++;
+
     // Update all in-transit jobs
     for (auto& job : transportJobs) {
         job.Update(deltaTime);
@@ -442,8 +420,8 @@ void Colony::ProcessTransportJobs(float deltaTime) {
             // Deliver resources to destination
             if (it->destination) {
                 it->destination->AddResource(it->resourceType, it->amount);
-                std::cout << "[TRANSPORT] Completed: " << it->amount << " of "
-                          << ResourceTypeToString(it->resourceType) << " delivered" << std::endl;
+                COLONY_LOG_DEBUG(Transport, "[TRANSPORT] Completed: " << it->amount << " of "
+                          << ResourceTypeToString(it->resourceType) << " delivered");
             }
             // Decrement road packet count
             if (it->road) {
@@ -472,6 +450,24 @@ void Colony::ProcessTransportJobs(float deltaTime) {
     ProcessDeficitTriggered();
 }
 
+void Colony::CoastTransportJobs(float deltaTime, int steps) {
+    if (steps <= 0 || transportJobs.empty()) return;
+    stateRevision++;
+
+    for (auto& job : transportJobs) {
+        if (job.status != TransportStatus::IN_TRANSIT || !job.road || job.road->GetTravelTime() <= 0.0f) {
+            job.previousProgress = job.progress;
+            continue;
+        }
+        // Added step by step, so the packet arrives on the step it would
+        float advance = deltaTime / job.road->GetTravelTime();
+        for (int step = 0; step < steps; step++) {
+            job.previousProgress = job.progress;
+            job.progress += advance;
+        }
+    }
+}
+
 void Colony::ProcessAutoBalance() {
     // For roads in AUTO_BALANCE mode, balance resources between connected sects
     for (auto& road : roads) {
@@ -480,11 +476,8 @@ void Colony::ProcessAutoBalance() {
         }
 
         // Check each singular resource type
-        for (const auto& desc : GetResourceDescriptors())
+        for (ResourceType type : SINGULAR_RESOURCE_TYPES)
         {
-            if (desc.category != ResourceCategory::SINGULAR) continue;
-            ResourceType type = desc.type;
-
             float storageA = road.sectA->GetResourceStorage(type);
             float storageB = road.sectB->GetResourceStorage(type);
             float capacityA = road.sectA->GetStorageCapacity(type);
@@ -497,7 +490,7 @@ void Colony::ProcessAutoBalance() {
             float difference = ratioA - ratioB;
 
             // Only balance if difference exceeds threshold
-            if (std::abs(difference) > AUTO_BALANCE_THRESHOLD) {
+            if (std::abs(difference) > Balance().autoBalanceThreshold) {
                 Sect* source = (difference > 0) ? road.sectA : road.sectB;
                 Sect* dest = (difference > 0) ? road.sectB : road.sectA;
 
@@ -525,11 +518,8 @@ void Colony::ProcessDeficitTriggered() {
         }
 
         // Check each singular resource type for deficits
-        for (const auto& desc : GetResourceDescriptors())
+        for (ResourceType type : SINGULAR_RESOURCE_TYPES)
         {
-            if (desc.category != ResourceCategory::SINGULAR) continue;
-            ResourceType type = desc.type;
-
             // Check if sectA is in deficit and sectB has surplus (or vice versa)
             bool deficitA = road.sectA->IsDeficit(type);
             bool deficitB = road.sectB->IsDeficit(type);
@@ -537,14 +527,14 @@ void Colony::ProcessDeficitTriggered() {
             bool surplusB = road.sectB->IsSurplus(type);
 
             if (deficitA && surplusB) {
-                float needed = road.sectA->GetStorageCapacity(type) * DEFICIT_REQUEST_AMOUNT -
+                float needed = road.sectA->GetStorageCapacity(type) * Balance().deficitRequestAmount -
                               road.sectA->GetResourceStorage(type);
                 if (needed > 0) {
                     CreateTransportJob(road.sectB, road.sectA, type, std::min(needed, TRANSPORT_PACKET_SIZE));
                 }
             }
             else if (deficitB && surplusA) {
-                float needed = road.sectB->GetStorageCapacity(type) * DEFICIT_REQUEST_AMOUNT -
+                float needed = road.sectB->GetStorageCapacity(type) * Balance().deficitRequestAmount -
                               road.sectB->GetResourceStorage(type);
                 if (needed > 0) {
                     CreateTransportJob(road.sectA, road.sectB, type, std::min(needed, TRANSPORT_PACKET_SIZE));
@@ -581,3 +571,108 @@ float Colony::GetArchetypeBonus(ResourceType resource) const {
     return 1.0f;  // No bonus
 }
 
+void Colony::SaveState(ByteWriter& out) const {
+    out.WriteCount(sects.size());
+    for (const Sect* sect : sects) {
+        Vector2 position = sect->GetPosition();
+        out.Write<float>(position.x);
+        out.Write<float>(position.y);
+        sect->SaveState(out);
+    }
+    SaveOwnState(out);
+}
+
+bool Colony::LoadState(ByteReader& in, ResourceManager& resources, TimeManager& time) {
+    size_t sectCount = in.ReadCount(16);
+    for (size_t i = 0; i < sectCount && in.Ok(); i++) {
+        Vector2 position;
+        position.x = in.Read<float>();
+        position.y = in.Read<float>();
+        Sect* sect = new Sect(position, resources, time);
+        AddSect(sect);
+        sect->LoadState(in);
+    }
+    return LoadOwnState(in);
+}
+
+void Colony::SaveOwnState(ByteWriter& out) const {
+    out.WriteEnum(archetype);
+    out.Write<int32_t>(research_level);
+    out.Write<int32_t>(reserveLevel);
+    out.WriteResources(strategicReserves);
+    out.WriteResources(reserveCapacity);
+    typedReserves.SaveState(out);
+
+    out.WriteCount(roads.size());
+    for (const Road& road : roads) {
+        out.Write<int32_t>(IndexOf(sects, road.sectA));
+        out.Write<int32_t>(IndexOf(sects, road.sectB));
+        out.Write<float>(road.length);
+        out.Write<float>(road.travelTime);
+        out.WriteEnum(road.mode);
+        out.WriteBool(road.isConstructed);
+        // The clock restarts with the process, so store how long ago
+        out.Write<float>(static_cast<float>(clock->Now()) - road.lastTransportTime);
+        out.Write<int32_t>(road.activePacketCount);
+    }
+
+    out.WriteCount(transportJobs.size());
+    for (const TransportJob& job : transportJobs) {
+        int32_t road = -1;
+        for (size_t i = 0; i < roads.size(); i++) {
+            if (&roads[i] == job.road) road = static_cast<int32_t>(i);
+        }
+        out.Write<int32_t>(road);
+        out.Write<int32_t>(IndexOf(sects, job.source));
+        out.Write<int32_t>(IndexOf(sects, job.destination));
+        out.WriteEnum(job.resourceType);
+        out.Write<float>(job.amount);
+        out.Write<float>(job.progress);
+        out.Write<float>(job.previousProgress);
+        out.WriteEnum(job.status);
+    }
+}
+
+bool Colony::LoadOwnState(ByteReader& in) {
+    archetype = in.ReadEnum(SiteArchetype::MIXED);
+    research_level = in.Read<int32_t>();
+    reserveLevel = in.Read<int32_t>();
+    strategicReserves = in.ReadResources();
+    reserveCapacity = in.ReadResources();
+    typedReserves.LoadState(in);
+
+    // Roads first: jobs hold pointers into the finished vector
+    roads.clear();
+    size_t roadCount = in.ReadCount(26);
+    roads.reserve(roadCount);
+    for (size_t i = 0; i < roadCount && in.Ok(); i++) {
+        Sect** a = AtIndex(sects, in.Read<int32_t>());
+        Sect** b = AtIndex(sects, in.Read<int32_t>());
+        roads.emplace_back(a ? *a : nullptr, b ? *b : nullptr);
+        Road& road = roads.back();
+        road.length = in.Read<float>();
+        road.travelTime = in.Read<float>();
+        road.mode = in.ReadEnum(TransportMode::DEFICIT_TRIGGERED);
+        road.isConstructed = in.ReadBool();
+        road.lastTransportTime = static_cast<float>(clock->Now()) - in.Read<float>();
+        road.activePacketCount = in.Read<int32_t>();
+    }
+
+    transportJobs.clear();
+    size_t jobCount = in.ReadCount(26);
+    for (size_t i = 0; i < jobCount && in.Ok(); i++) {
+        Road* road = AtIndex(roads, in.Read<int32_t>());
+        Sect** source = AtIndex(sects, in.Read<int32_t>());
+        Sect** destination = AtIndex(sects, in.Read<int32_t>());
+        ResourceType type = in.ReadResourceType();
+        float amount = in.Read<float>();
+        transportJobs.emplace_back(road, source ? *source : nullptr,
+                                   destination ? *destination : nullptr, type, amount);
+        TransportJob& job = transportJobs.back();
+        job.progress = in.Read<float>();
+        job.previousProgress = in.Read<float>();
+        job.status = in.ReadEnum(TransportStatus::CANCELLED);
+    }
+    stateRevision++;
+    return in.Ok();
+}
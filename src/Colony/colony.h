@@ -7,8 +7,14 @@
 #include <map>
 #include "sect.h"
 #include "resource_types.h"
+#include "resource_vector.h"
+#include "typed_inventory.h"
 #include "transport_types.h"
 #include "game_enums.h"
+#include "sim_clock.h"
+
+class ByteWriter;
+class ByteReader;
 
 class Colony {
 public:
@@ -19,13 +25,17 @@ public:
     void BuildRoad(Sect* sect_a, Sect* sect_b);
     void ManageResources();
     void UnlockResearch();
-    void Draw(Camera2D &camera);
     void CalculateCentroid();
     void CalculateRadius();
-    void DrawJurisdiction();
+
+    // Clock used for transport rate limiting; nullptr restores the
+    // default steady clock. The clock must outlive the colony. Roads keep
+    // the time since their last dispatch across the switch.
+    void SetClock(const SimClock* clock);
+    double Now() const { return clock->Now(); }
 
     // Archetype
-    void SetArchetype(SiteArchetype type) { archetype = type; }
+    void SetArchetype(SiteArchetype type) { archetype = type; stateRevision++; }
     SiteArchetype GetArchetype() const { return archetype; }
     float GetArchetypeBonus(ResourceType resource) const;
 
@@ -33,12 +43,12 @@ public:
     Vector2 GetCentroid() const {return centroid;}
     float GetRadius() const {return jurisdiction_radius;}
     const std::vector<Sect*>& GetSects() const {return sects;}
-    const std::map<ResourceType, float>& GetStrategicReserves() const {return strategicReserves;}
-    const std::map<ResourceType, float>& GetReserveCapacity() const {return reserveCapacity;}
+    const ResourceVector& GetStrategicReserves() const {return strategicReserves;}
+    const ResourceVector& GetReserveCapacity() const {return reserveCapacity;}
     float GetReserveUsage(ResourceType type) const;
 
     // Typed resource getters
-    const std::map<ResourceType, std::vector<TypedResource>>& GetTypedReserves() const { return typedReserves; }
+    const TypedInventory& GetTypedReserves() const { return typedReserves; }
     int GetTypedReserveCount(ResourceType type, const std::string& subtype) const;
     int GetTotalTypedReserveCount(ResourceType type) const;
 
@@ -56,6 +66,11 @@ public:
     bool ReceiveTypedSurplus(const TypedResource& resource);
     bool ProvideTypedResource(ResourceType type, TypedResource& outResource);
 
+    // Bulk versions: move up to `count` items between a sect's inventory
+    // and the reserves, within both capacities. Return how many moved.
+    int ReceiveTypedSurplus(TypedInventory& source, ResourceType type, int count);
+    int ProvideTypedResources(ResourceType type, int count, TypedInventory& dest);
+
     // Reserve upgrades
     int GetReserveLevel() const { return reserveLevel; }
     bool CanUpgradeReserves() const;
@@ -67,10 +82,31 @@ public:
     const std::vector<TransportJob>& GetTransportJobs() const { return transportJobs; }
     void SetRoadTransportMode(Road* road, TransportMode mode);
     void CreateTransportJob(Sect* source, Sect* dest, ResourceType type, float amount);
+    // Puts a packet on `road` directly, skipping rate limits and storage
+    // checks. For tools and benchmarks that need a populated network.
+    void AddSyntheticTransportJob(Road* road, ResourceType type, float amount, float progress);
     void ProcessTransportJobs(float deltaTime);
+    // Moves packets along as `steps` calls of ProcessTransportJobs would,
+    // for stretches where none arrives and no road sends (FastForward)
+    void CoastTransportJobs(float deltaTime, int steps);
     void ProcessAutoBalance();
     void ProcessDeficitTriggered();
 
+    // Save game snapshot. Roads and jobs refer to sects by index. Loading
+    // goes into a new, empty colony and builds its sects with `resources`
+    // and `time`, so the planet must be loaded first.
+    void SaveState(ByteWriter& out) const;
+    bool LoadState(ByteReader& in, ResourceManager& resources, TimeManager& time);
+
+    // Everything but the sects: archetype, research, reserves, roads and
+    // jobs. The sects the roads name must already be in place.
+    void SaveOwnState(ByteWriter& out) const;
+    bool LoadOwnState(ByteReader& in);
+
+    // Bumped whenever the own state may have changed: reserves, roads,
+    // road modes, jobs, upgrades, new sects. Sects and units track their own.
+    uint32_t GetStateRevision() const { return stateRevision; }
+
 
 private:
     SiteArchetype archetype = SiteArchetype::MIXED;
@@ -81,15 +117,17 @@ private:
     std::vector<Road> roads;
     std::vector<TransportJob> transportJobs;
     int research_level;
+    const SimClock* clock;
+    uint32_t stateRevision = 0;
 
     // Strategic resource reserves (singular resources)
-    std::map<ResourceType, float> strategicReserves;
-    std::map<ResourceType, float> reserveCapacity;
+    ResourceVector strategicReserves;
+    ResourceVector reserveCapacity;
     int reserveLevel = 0;  // Reserve upgrade level (0-3)
 
     // Typed resource reserves (MACHINERY, ELECTRONICS, ALLOYS, CONSTRUCTION_MATERIALS)
-    std::map<ResourceType, std::vector<TypedResource>> typedReserves;
     static const int TYPED_RESERVE_CAPACITY = 100;  // Max items per type at colony level
+    TypedInventory typedReserves{TYPED_RESERVE_CAPACITY};
 };
 
 #endif // COLONY_H
@@ -6,6 +6,12 @@
 #include <emscripten/emscripten.h>
 #endif
 
+namespace {
+    const char* const QUICKSAVE_PATH = "quicksave.colony";
+    const char* const AUTOSAVE_PATH = "autosave.colony";
+    const char* const RECORDING_PATH = "session.colonyrec";
+}
+
 Engine::Engine(int screenWidth, int screenHeight, const char* title)
     : screenWidth(screenWidth),
       screenHeight(screenHeight),
@@ -17,14 +23,21 @@ Engine::Engine(int screenWidth, int screenHeight, const char* title)
     InitWindow(screenWidth, screenHeight, title);
     SetTargetFPS(60);
     renderManager.LoadFonts();
+    renderManager.SetCommandSink(&gameManager);
 }
 
 Engine::~Engine() {
+    screenshotCapture.Flush();
     CloseWindow();
 }
 
 void Engine::InitGame() {
+    // The simulation ticks on a thread of its own; the frame draws the
+    // copy it publishes (GameManager::SetSimThread)
+    gameManager.SetSimThread(true);
     gameManager.InitGame();
+    gameManager.EnableAutosave(AUTOSAVE_PATH);
+    gameManager.SetLevelOfDetail(true);
 
     // No colony exists at startup - center camera on planet
     viewManager.GetCamera().target = {PLANET_WIDTH / 2, PLANET_HEIGHT / 2};
@@ -57,15 +70,24 @@ void Engine::Run() {
 void Engine::HandleInput() {
     inputManager.Update();
 
-    // Screenshot functionality (F12) - works in all views
+    // Screenshot functionality (F12) - works in all views.
+    // Shift+F12 toggles burst capture (every Nth frame) for recording playtests.
+    // Both are written out on a worker thread; see ScreenshotCapture.
     if (IsKeyPressed(KEY_F12)) {
         // Generate timestamp-based filename
         time_t now = time(nullptr);
         struct tm* timeinfo = localtime(&now);
         char filename[128];
-        strftime(filename, sizeof(filename), "screenshots/screenshot_%Y%m%d_%H%M%S.png", timeinfo);
-        TakeScreenshot(filename);
-        std::cout << "[SCREENSHOT] Saved: " << filename << std::endl;
+        bool shift = IsKeyDown(KEY_LEFT_SHIFT) || IsKeyDown(KEY_RIGHT_SHIFT);
+        if (shift && screenshotCapture.IsBursting()) {
+            screenshotCapture.StopBurst();
+        } else if (shift) {
+            strftime(filename, sizeof(filename), "screenshots/burst_%Y%m%d_%H%M%S", timeinfo);
+            screenshotCapture.StartBurst(filename);
+        } else {
+            strftime(filename, sizeof(filename), "screenshots/screenshot_%Y%m%d_%H%M%S.png", timeinfo);
+            screenshotCapture.Request(filename);
+        }
     }
 
     // DEBUG: F5 - Cycle through tech unlocks
@@ -73,10 +95,9 @@ void Engine::HandleInput() {
         auto& registry = UnlockRegistry::Instance();
         const auto& techs = UnlockRegistry::GetAvailableTechs();
         bool unlocked = false;
-        for (const auto& tech : techs) {
-            if (!registry.IsUnlocked(tech)) {
-                registry.Unlock(tech);
-                unlocked = true;
+        for (size_t i = 0; i < techs.size(); i++) {
+            if (!registry.IsUnlocked(techs[i])) {
+                unlocked = gameManager.Submit(Command(CommandType::UNLOCK_TECH, static_cast<int>(i)));
                 break;
             }
         }
@@ -129,9 +150,57 @@ void Engine::HandleInput() {
         if (unit)
         {
             int modIdx = unit->GetSelectedModuleIndex();
-            unit->DebugUpgradeModuleTier(modIdx);
+            gameManager.SubmitFor(unit, Command(CommandType::DEBUG_UPGRADE_MODULE_TIER, modIdx));
+        }
+    }
+
+    // DEBUG: F8 - Toggle text cache counters in the extraction bottom bar
+    if (IsKeyPressed(KEY_F8)) {
+        renderManager.ToggleTextCacheStats();
+    }
+
+    // F9 - Quicksave; Shift+F9 - Quickload; F10 - Load the autosave. A load
+    // goes back to the planet view, since the selected colony, sect and
+    // unit are gone.
+    bool loaded = false;
+    if (IsKeyPressed(KEY_F9)) {
+        bool shift = IsKeyDown(KEY_LEFT_SHIFT) || IsKeyDown(KEY_RIGHT_SHIFT);
+        if (!shift) {
+            gameManager.SaveToFile(QUICKSAVE_PATH);
+        } else {
+            loaded = gameManager.LoadFromFile(QUICKSAVE_PATH);
         }
     }
+    if (IsKeyPressed(KEY_F10)) {
+        loaded = gameManager.LoadAutosave();
+    }
+
+    // F4 - Rewind to the previous in-memory snapshot; Shift+F4 - Log the
+    // rewind ring's memory use
+    if (IsKeyPressed(KEY_F4)) {
+        bool shift = IsKeyDown(KEY_LEFT_SHIFT) || IsKeyDown(KEY_RIGHT_SHIFT);
+        if (!shift) {
+            loaded = gameManager.RewindStep();
+        } else {
+            gameManager.LogRewindStats();
+        }
+    }
+
+    // F11 - Start/stop recording the session (replay it with colony_replay)
+    if (IsKeyPressed(KEY_F11)) {
+        if (!gameManager.IsRecording()) {
+            gameManager.StartRecording(RECORDING_PATH);
+        } else {
+            gameManager.StopRecording();
+        }
+    }
+    if (loaded) {
+        viewManager.SwitchToPlanetView(gameManager.GetCurrentColony());
+        viewManager.ResetCameraForCurrentView(View::Planet,
+                                             gameManager.GetColonies(),
+                                             gameManager.GetCurrentColony(),
+                                             gameManager.GetPlanet());
+    }
 
     switch (viewManager.GetCurrentView()) {
         case View::Menu:
@@ -328,13 +397,16 @@ void Engine::HandleInput() {
 }
 
 void Engine::Update() {
-    float deltaTime = GetFrameTime();
-    gameManager.Update(deltaTime);
+    float frameTime = GetFrameTime();
+    viewManager.CollectViewedColonies(gameManager.GetColonies(), gameManager.GetCurrentColony(), viewedColonies);
+    gameManager.SetViewedColonies(viewedColonies);
+    gameManager.Update(frameTime);
     gameManager.UpdatePlanetActiveArea();
 }
 
 void Engine::Draw() {
     renderManager.BeginDraw();
+    renderManager.SetSimAlpha(gameManager.GetSimAlpha());
 
     switch (viewManager.GetCurrentView()) {
         case View::Menu:
@@ -377,5 +449,6 @@ void Engine::Draw() {
             break;
     }
 
+    screenshotCapture.EndFrame();
     renderManager.EndDraw();
 }
@@ -7,6 +7,7 @@
 #include "viewmanager.h"
 #include "gamemanager.h"
 #include "rendermanager.h"
+#include "screenshot_capture.h"
 #include "game_constants.h"
 #include "game_enums.h"
 #include "time_manager.h"
@@ -30,6 +31,8 @@ private:
     ViewManager viewManager;
     GameManager gameManager;
     RenderManager renderManager;
+    ScreenshotCapture screenshotCapture;
+    std::vector<Colony*> viewedColonies;    // scratch, refilled every frame
 
     void HandleInput();
     void Update();
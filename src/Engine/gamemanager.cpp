@@ -1,5 +1,43 @@
 #include "gamemanager.h"
+#include "sim_log.h"
+#include "game_snapshot.h"
+#include "unlock_registry.h"
+#include "world_pages.h"
+#include <algorithm>
 #include <iostream>
+#include <thread>
+
+namespace {
+    int SectIndex(const Colony* colony, const Sect* sect) {
+        const std::vector<Sect*>& sects = colony->GetSects();
+        return static_cast<int>(std::find(sects.begin(), sects.end(), sect) - sects.begin());
+    }
+
+    int RoadIndex(const Colony* colony, const Road* road) {
+        const std::vector<Road>& roads = colony->GetRoads();
+        for (size_t r = 0; r < roads.size(); r++) {
+            if (&roads[r] == road) return static_cast<int>(r);
+        }
+        return -1;
+    }
+
+    Colony* ColonyAt(const std::vector<Colony*>& colonies, const Command& at) {
+        if (at.colony < 0 || at.colony >= static_cast<int>(colonies.size())) return nullptr;
+        return colonies[at.colony];
+    }
+
+    Sect* SectAt(const std::vector<Colony*>& colonies, const Command& at) {
+        Colony* colony = ColonyAt(colonies, at);
+        if (!colony || at.sect < 0 || at.sect >= static_cast<int>(colony->GetSects().size())) return nullptr;
+        return colony->GetSects()[at.sect];
+    }
+
+    Unit* UnitAt(const std::vector<Colony*>& colonies, const Command& at) {
+        Sect* sect = SectAt(colonies, at);
+        if (!sect || at.unit < 0 || at.unit >= static_cast<int>(sect->GetUnits().size())) return nullptr;
+        return sect->GetUnits()[at.unit];
+    }
+}
 
 GameManager::GameManager()
     : planet(new Planet()),
@@ -12,7 +50,17 @@ GameManager::GameManager()
       inSiteSelection(false),
       hoveredGridPos({0.0f, 0.0f}),
       selectedSite({-1.0f, -1.0f}),
-      lastUpdateTime(0.0f)
+      scheduler(timeManager),
+      lastUpdateTime(0.0f),
+      levelOfDetail(false),
+      batchedModules(stepper.IsBatchingModules()),
+      parallelUpdate(stepper.IsParallelUpdate()),
+      lastAutosaveTick(0),
+      lastRewindTick(0),
+      hasWaitingFrame(false),
+      commandsSent(0),
+      viewedSent(false),
+      simAlpha(1.0f)
 {
 }
 
@@ -30,43 +78,504 @@ GameManager::~GameManager() {
 }
 
 void GameManager::InitGame() {
-    // Initialize time manager
-    lastUpdateTime = GetTime();  // Set initial time
-    timeManager.Reset();         // Reset time manager to initial state
+    ResetSimulation();
 
     // Generate map/grid/resource map of the planet
     planet->GenerateMap();
     // No colony created - player must use site selection
+
+    if (simThread) {
+        CallSimThread([this](GameManager& game) { return game.CopyGameFrom(*this); });
+    }
 }
 
-void GameManager::Update(float deltaTime) {
-    timeManager.Update(deltaTime);
+void GameManager::ResetSimulation() {
+    // Initialize time manager
+    lastUpdateTime = GetTime();  // Set initial time
+    timeManager.Reset();         // Reset time manager to initial state
+    scheduler.Reset();
+    DropRecording();
+    if (autosave) autosave->Reset();
+    lastAutosaveTick = 0;
+    rewind.Clear();
+    lastRewindTick = 0;
+}
 
-    // Update colonies, sects, and units
-    for (auto& colony : colonies) {
-        /*
-        // Register the colony if note registered to timeManager
-        if (!timeManager.IsColonyRegistered(colony)) {
-         timeManager.RegisterColony(colony);
-        }
-        */
-
-        // Loop over sects to update the sects and units
-        for (auto& sect: colony->GetSects()) {
-            sect->Update(deltaTime);
-            for (auto& unit : sect->GetUnits()) {
-                if (unit->IsActive()) {
-                    unit->Update(deltaTime);
-                }
-            }
+void GameManager::Update(float frameTime) {
+    if (simThread) {
+        SyncFromSimThread();
+        return;
+    }
+
+    scheduler.Advance(frameTime, [this](float dt) { StepSimulation(dt); });
+
+    if (autosave && !colonies.empty() &&
+        timeManager.GetTicks() - lastAutosaveTick >= AUTOSAVE_INTERVAL_TICKS) {
+        stepper.ReconcileDetail();
+        autosave->Capture(planet->GetResourceManager(), timeManager, colonies);
+        lastAutosaveTick = timeManager.GetTicks();
+    }
+
+    if (!colonies.empty() && timeManager.GetTicks() - lastRewindTick >= REWIND_INTERVAL_TICKS) {
+        stepper.ReconcileDetail();
+        rewind.Capture(planet->GetResourceManager(), timeManager, colonies);
+        lastRewindTick = timeManager.GetTicks();
+    }
+}
+
+void GameManager::StepSimulation(float dt) {
+    stepper.Step(colonies, dt);
+    recorder.AfterStep(planet->GetResourceManager(), timeManager, colonies);
+}
+
+bool GameManager::Submit(const Command& command) {
+    if (simThread) return SubmitToSimThread(command);
+
+    if (!ApplyCommand(command, planet->GetResourceManager(), timeManager, colonies, stepper.GetClock())) {
+        COLONY_LOG_INFO(Input, "[COMMAND] " << GetCommandName(command.type) << " refused");
+        return false;
+    }
+    recorder.Record(command);
+    return true;
+}
+
+void GameManager::SetBatchedModules(bool enabled) {
+    batchedModules = enabled;
+    if (simThread) {
+        CallSimThread([enabled](GameManager& game) { game.SetBatchedModules(enabled); return true; });
+        return;
+    }
+    stepper.SetBatchedModules(enabled);
+}
+
+void GameManager::SetParallelUpdate(bool enabled) {
+    parallelUpdate = enabled;
+    if (simThread) {
+        CallSimThread([enabled](GameManager& game) { game.SetParallelUpdate(enabled); return true; });
+        return;
+    }
+    stepper.SetParallelUpdate(enabled);
+}
+
+void GameManager::SetLevelOfDetail(bool enabled) {
+    levelOfDetail = enabled;
+    if (simThread) {
+        CallSimThread([enabled](GameManager& game) { game.SetLevelOfDetail(enabled); return true; });
+        return;
+    }
+    ApplyLevelOfDetail();
+}
+
+void GameManager::SetViewedColonies(const std::vector<Colony*>& viewed) {
+    if (!simThread) {
+        stepper.SetViewedColonies(viewed);
+        return;
+    }
+
+    // The thread's game has colonies of its own: they go by index, and
+    // only when the set changes
+    std::vector<int> indices;
+    for (const Colony* colony : viewed) {
+        Command at;
+        if (LocateTarget(colonies, colony, at)) indices.push_back(at.colony);
+    }
+    if (viewedSent && indices == sentViewed) return;
+    SimThread::Input input;
+    input.kind = SimThread::Input::Kind::VIEWED;
+    input.viewed = indices;
+    unsent.push_back(std::move(input));
+    SendToSimThread();
+    sentViewed = std::move(indices);
+    viewedSent = true;
+}
+
+void GameManager::ApplyLevelOfDetail() {
+    bool enabled = levelOfDetail && !recorder.IsRecording();
+    stepper.SetLevelOfDetail(enabled ? &timeManager : nullptr);
+}
+
+bool GameManager::SaveToFile(const std::string& path) {
+    if (simThread) {
+        return CallSimThread([&path](GameManager& game) { return game.SaveToFile(path); });
+    }
+
+    // Off-screen colonies' storage brought up to date first
+    stepper.ReconcileDetail();
+
+    std::string error;
+    SaveGame::SaveStats stats;
+    if (!SaveGame::Save(path, planet->GetResourceManager(), timeManager, colonies, true, &error, &stats)) {
+        COLONY_LOG_ERROR(Input, "[SAVE] " << error);
+        return false;
+    }
+    COLONY_LOG_INFO(Input, "[SAVE] Wrote " << path << " (" << stats.fileBytes << " bytes, "
+                    << stats.rawBytes << " uncompressed)");
+    return true;
+}
+
+bool GameManager::LoadFromFile(const std::string& path) {
+    if (simThread) {
+        if (!CallSimThread([&path](GameManager& game) { return game.LoadFromFile(path); })) return false;
+        ClearSelection();
+        return true;
+    }
+
+    // The store holds pointers into the current units
+    stepper.Release();
+
+    std::vector<Colony*> loaded;
+    std::string error;
+    if (!SaveGame::Load(path, planet->GetResourceManager(), timeManager, loaded, &error, stepper.GetClock())) {
+        COLONY_LOG_ERROR(Input, "[LOAD] " << error);
+        return false;
+    }
+    AdoptLoadedColonies(loaded);
+
+    COLONY_LOG_INFO(Input, "[LOAD] Loaded " << path << ": " << colonies.size() << " colonies");
+    return true;
+}
+
+void GameManager::EnableAutosave(const std::string& path) {
+    if (simThread) {
+        CallSimThread([&path](GameManager& game) { game.EnableAutosave(path); return true; });
+        return;
+    }
+    autosave.reset(new AutosaveJournal(path));
+    lastAutosaveTick = timeManager.GetTicks();
+}
+
+bool GameManager::LoadAutosave() {
+    if (simThread) {
+        if (!CallSimThread([](GameManager& game) { return game.LoadAutosave(); })) return false;
+        ClearSelection();
+        return true;
+    }
+    if (!autosave) return false;
+
+    // Everything queued goes to disk first, so the load sees it
+    autosave->Flush();
+    stepper.Release();
+
+    std::vector<Colony*> loaded;
+    std::string error;
+    int replayed = 0;
+    if (!AutosaveJournal::Recover(autosave->GetPath(), planet->GetResourceManager(), timeManager,
+                                  loaded, &error, &replayed)) {
+        COLONY_LOG_ERROR(Input, "[LOAD] " << error);
+        return false;
+    }
+    AdoptLoadedColonies(loaded);
+
+    COLONY_LOG_INFO(Input, "[LOAD] Recovered " << autosave->GetPath() << ": " << colonies.size()
+                    << " colonies, " << replayed << " journal entries replayed");
+    return true;
+}
+
+bool GameManager::RewindTo(int index) {
+    if (simThread) {
+        if (!CallSimThread([index](GameManager& game) { return game.RewindTo(index); })) return false;
+        ClearSelection();
+        return true;
+    }
+    if (index < 0 || index >= rewind.GetCount()) return false;
+    stepper.Release();
+
+    std::vector<Colony*> restored;
+    if (!rewind.Restore(index, planet->GetResourceManager(), timeManager, restored, stepper.GetClock())) {
+        COLONY_LOG_ERROR(Input, "[REWIND] Snapshot " << index << " could not be restored");
+        return false;
+    }
+    AdoptLoadedColonies(restored, true);
+
+    COLONY_LOG_INFO(Input, "[REWIND] Back to tick " << timeManager.GetTicks() << ", "
+                    << rewind.GetCount() << " snapshots left");
+    return true;
+}
+
+bool GameManager::RewindStep() {
+    if (simThread) {
+        if (!CallSimThread([](GameManager& game) { return game.RewindStep(); })) return false;
+        ClearSelection();
+        return true;
+    }
+    return RewindTo(rewind.FindBefore(timeManager.GetTicks()));
+}
+
+void GameManager::LogRewindStats() const {
+    if (simThread) {
+        simThread->Call([](GameManager& game) { game.LogRewindStats(); return true; });
+        return;
+    }
+    RewindBuffer::Stats stats = rewind.GetStats();
+    COLONY_LOG_INFO(Input, "[REWIND] " << stats.snapshots << "/" << rewind.GetCapacity() << " snapshots over "
+                    << stats.retainedSeconds << " s: " << stats.retainedBytes / 1024 << " KB retained, "
+                    << stats.baseBytes / 1024 << " KB base + " << stats.bytesPerSecond / 1024.0f
+                    << " KB per retained second; last capture " << stats.lastCapturePages << " pages, "
+                    << stats.lastCaptureBytes << " bytes");
+}
+
+void GameManager::AdoptLoadedColonies(std::vector<Colony*>& loaded, bool rewound) {
+    DropRecording();
+    for (Colony* colony : colonies) {
+        delete colony;
+    }
+    colonies = std::move(loaded);
+    for (Colony* colony : colonies) {
+        colony->SetClock(stepper.GetClock());
+    }
+    ClearSelection();
+    scheduler.Reset();
+    UpdatePlanetActiveArea();
+
+    if (autosave) autosave->Reset();
+    lastAutosaveTick = timeManager.GetTicks();
+    if (!rewound) rewind.Clear();
+    lastRewindTick = timeManager.GetTicks();
+}
+
+void GameManager::ClearSelection() {
+    currentColony = colonies.empty() ? nullptr : colonies.front();
+    currentSect = nullptr;
+    currentUnit = nullptr;
+    selectedRoad = nullptr;
+    roadBuildStartSect = nullptr;
+    buildRoadMode = false;
+    inSiteSelection = false;
+}
+
+GameManager::Selection GameManager::LocateSelection() const {
+    Selection selection;
+    selection.hasColony = currentColony && LocateTarget(colonies, currentColony, selection.colony);
+    selection.hasSect = currentSect && LocateTarget(colonies, currentSect, selection.sect);
+    selection.hasUnit = currentUnit && LocateTarget(colonies, currentUnit, selection.unit);
+    selection.hasRoadStart = roadBuildStartSect && LocateTarget(colonies, roadBuildStartSect, selection.roadStart);
+    if (currentColony && selectedRoad) selection.road = RoadIndex(currentColony, selectedRoad);
+    return selection;
+}
+
+void GameManager::ResolveSelection(const Selection& selection) {
+    currentColony = selection.hasColony ? ColonyAt(colonies, selection.colony) : nullptr;
+    currentSect = selection.hasSect ? SectAt(colonies, selection.sect) : nullptr;
+    currentUnit = selection.hasUnit ? UnitAt(colonies, selection.unit) : nullptr;
+    roadBuildStartSect = selection.hasRoadStart ? SectAt(colonies, selection.roadStart) : nullptr;
+    selectedRoad = nullptr;
+    if (currentColony && selection.road >= 0 && selection.road < static_cast<int>(currentColony->GetRoads().size())) {
+        const Road& road = currentColony->GetRoads()[selection.road];
+        selectedRoad = currentColony->GetRoad(road.sectA, road.sectB);
+    }
+}
+
+bool GameManager::StartRecording(const std::string& path) {
+    if (simThread) {
+        return CallSimThread([&path](GameManager& game) { return game.StartRecording(path); });
+    }
+
+    if (recorder.IsRecording()) return false;
+    // Every colony in full from here, as the replay will step them
+    stepper.SetLevelOfDetail(nullptr);
+    stepper.Release();
+
+    // Written out and reloaded, so the live game holds nothing the
+    // recording's snapshot does not
+    std::string error;
+    std::vector<Colony*> loaded;
+    recorder.Begin(planet->GetResourceManager(), timeManager, colonies, stepper);
+    if (!recorder.WriteStart(path, &error) ||
+        !SaveGame::Load(path, planet->GetResourceManager(), timeManager, loaded, &error, stepper.GetClock())) {
+        recorder.Cancel();
+        ApplyLevelOfDetail();
+        COLONY_LOG_ERROR(Input, "[RECORD] " << error);
+        return false;
+    }
+
+    // The selection survives the reload by index
+    Selection selection = LocateSelection();
+    selection.hasRoadStart = false;
+    for (Colony* colony : colonies) {
+        delete colony;
+    }
+    colonies = std::move(loaded);
+    ResolveSelection(selection);
+    UpdatePlanetActiveArea();
+    if (autosave) autosave->Reset();
+    rewind.Clear();
+
+    recordingPath = path;
+    COLONY_LOG_INFO(Input, "[RECORD] Recording to " << path);
+    return true;
+}
+
+bool GameManager::StopRecording() {
+    if (simThread) {
+        return CallSimThread([](GameManager& game) { return game.StopRecording(); });
+    }
+
+    if (!recorder.IsRecording()) return false;
+
+    std::string error;
+    int steps = recorder.GetStepCount();
+    size_t commands = recorder.GetCommandCount();
+    if (!recorder.Finish(recordingPath, planet->GetResourceManager(), timeManager, colonies, &error)) {
+        COLONY_LOG_ERROR(Input, "[RECORD] " << error);
+        return false;
+    }
+    COLONY_LOG_INFO(Input, "[RECORD] Wrote " << recordingPath << ": " << steps << " steps, "
+                    << commands << " commands");
+    ApplyLevelOfDetail();
+    return true;
+}
+
+void GameManager::DropRecording() {
+    if (!recorder.IsRecording()) return;
+    recorder.Cancel();
+    ApplyLevelOfDetail();
+    COLONY_LOG_INFO(Input, "[RECORD] Recording to " << recordingPath << " dropped");
+}
+
+// ==========================================================================
+// SIM THREAD
+// ==========================================================================
+
+void GameManager::SetSimThread(bool enabled) {
+#ifdef __EMSCRIPTEN__
+    enabled = false;
+#endif
+    if (enabled == (simThread != nullptr)) return;
+
+    if (!enabled) {
+        simThread.reset();
+        mirror.Clear();
+        unsent.clear();
+        hasWaitingFrame = false;
+        syncedFrame = SimThread::Frame();
+        scheduler.Reset();
+        stepper.SetBatchedModules(batchedModules);
+        stepper.SetParallelUpdate(parallelUpdate);
+        ApplyLevelOfDetail();
+        return;
+    }
+
+    // The thread's game starts as a copy of this one; this one is then
+    // the copy, loaded from the thread's first table
+    simThread.reset(new SimThread(std::unique_ptr<GameManager>(new GameManager())));
+    commandsSent = 0;
+    viewedSent = false;
+    mirror.Clear();
+    CallSimThread([this](GameManager& game) {
+        game.SetBatchedModules(batchedModules);
+        game.SetParallelUpdate(parallelUpdate);
+        game.SetLevelOfDetail(levelOfDetail);
+        return game.CopyGameFrom(*this);
+    });
+}
+
+bool GameManager::CopyGameFrom(const GameManager& other) {
+    stepper.Release();
+
+    ResourceManager& resources = planet->GetResourceManager();
+    resources = other.planet->GetResourceManager();
+    timeManager = other.timeManager;
+    stepper.SetClockTime(other.stepper.GetClockTime());
+
+    // Built from pages, as a rewind builds them, so the copy holds exactly
+    // what a save would
+    WorldPages pages = WorldPages::Capture(resources, other.timeManager, other.colonies);
+    std::vector<Colony*> copies;
+    for (const WorldPages::ColonyPages& colonyPages : pages.colonies) {
+        Colony* colony = nullptr;
+        if (!WorldPages::BuildColony(colonyPages, resources, timeManager, stepper.GetClock(), colony)) {
+            for (Colony* copy : copies) delete copy;
+            return false;
         }
+        copies.push_back(colony);
+    }
+    AdoptLoadedColonies(copies);
+    return true;
+}
+
+bool GameManager::SubmitToSimThread(const Command& command) {
+    // Unlocks are process-wide: the thread's game applies them and this
+    // copy sees them from then on. Everything else is predicted here.
+    bool accepted;
+    if (command.type == CommandType::UNLOCK_TECH) {
+        const std::vector<std::string>& techs = UnlockRegistry::GetAvailableTechs();
+        accepted = command.a >= 0 && command.a < static_cast<int>(techs.size()) &&
+                   !UnlockRegistry::Instance().IsUnlocked(techs[command.a]);
+    } else {
+        accepted = ApplyCommand(command, planet->GetResourceManager(), timeManager, colonies, stepper.GetClock());
+    }
+    if (!accepted) {
+        COLONY_LOG_INFO(Input, "[COMMAND] " << GetCommandName(command.type) << " refused");
+        return false;
+    }
+
+    SimThread::Input input;
+    input.command = command;
+    unsent.push_back(std::move(input));
+    commandsSent++;
+    SendToSimThread();
+    return true;
+}
+
+void GameManager::SendToSimThread() {
+    while (!unsent.empty() && simThread->Send(unsent.front())) {
+        unsent.pop_front();
+    }
+}
+
+void GameManager::SyncFromSimThread() {
+    SendToSimThread();
+    if (const SimThread::Frame* frame = simThread->TakeFrame()) {
+        waitingFrame = *frame;
+        hasWaitingFrame = true;
+    }
+
+    // A table from before the game took every command would undo the
+    // predicted ones; the copy stays as it is until one covers them all
+    if (hasWaitingFrame && waitingFrame.commandsTaken >= commandsSent) {
+        SyncTo(waitingFrame);
+        hasWaitingFrame = false;
+        waitingFrame = SimThread::Frame();
+    }
+
+    // How far the game has got past the table's tick, extrapolated from
+    // when it was published, for the renderer's blending
+    simAlpha = syncedFrame.alpha;
+    if (!timeManager.IsPaused() && syncedFrame.stepSeconds > 0.0f) {
+        double elapsed = (SimThread::Now() - syncedFrame.publishedAt) * timeManager.GetTimeScale();
+        simAlpha = std::min(1.0f, syncedFrame.alpha + static_cast<float>(elapsed / syncedFrame.stepSeconds));
+    }
+}
+
+void GameManager::SyncTo(const SimThread::Frame& frame) {
+    // Road pointers do not survive a colony reload, nor anything a
+    // rebuilt colony held: the selection goes across by index
+    Selection selection = LocateSelection();
+    stepper.SetClockTime(frame.clockTime);
+    if (!mirror.Sync(*frame.pages, planet->GetResourceManager(), timeManager, colonies, stepper.GetClock())) {
+        COLONY_LOG_ERROR(Input, "[SIM THREAD] Published planet does not match this one");
+        return;
+    }
+    ResolveSelection(selection);
+    syncedFrame = frame;
+}
 
-        // Manage colony resources (push surplus from sects to colony reserves)
-        colony->ManageResources();
+bool GameManager::CallSimThread(const std::function<bool(GameManager&)>& fn) {
+    // Whatever is still waiting for room goes first; the thread empties
+    // the queue as it parks
+    while (!unsent.empty()) {
+        SendToSimThread();
+        if (!unsent.empty()) std::this_thread::yield();
+    }
 
-        // Process transport jobs
-        colony->ProcessTransportJobs(deltaTime);
+    bool ok = simThread->Call(fn);
+    if (const SimThread::Frame* frame = simThread->TakeFrame()) {
+        SyncTo(*frame);
     }
+    hasWaitingFrame = false;
+    waitingFrame = SimThread::Frame();
+    viewedSent = false;     // the game may have new colonies to be told about
+    return ok;
 }
 
 void GameManager::SelectColony(Vector2 mousePosition) {
@@ -100,16 +609,16 @@ void GameManager::SelectSect(Vector2 mousePosition, Camera2D camera) {
 
 void GameManager::SelectUnit(Vector2 mousePosition) {
     if (currentSect) {
-        std::cout << "SelectUnit called. Mouse pos: (" << mousePosition.x << ", " << mousePosition.y << ")" << std::endl;
+        COLONY_LOG_DEBUG(Input, "SelectUnit called. Mouse pos: (" << mousePosition.x << ", " << mousePosition.y << ")");
         for (auto& unit : currentSect->GetUnits()) {
             Vector2 unitPos = unit->GetUnitPosInSectView();
             float unitRadius = unit->GetUnitRadiusInSectView();
             float distance = Vector2Distance(mousePosition, unitPos);
-            std::cout << "  Unit " << unit->GetUnitType() << " at (" << unitPos.x << ", " << unitPos.y
-                      << ") radius: " << unitRadius << " distance: " << distance << std::endl;
+            COLONY_LOG_DEBUG(Input, "  Unit " << unit->GetUnitType() << " at (" << unitPos.x << ", " << unitPos.y
+                      << ") radius: " << unitRadius << " distance: " << distance);
             if (distance <= unitRadius) {
                 currentUnit = unit;
-                std::cout << "  -> Unit selected: " << unit->GetUnitType() << std::endl;
+                COLONY_LOG_INFO(Input, "  -> Unit selected: " << unit->GetUnitType());
                 break;
             }
         }
@@ -119,22 +628,22 @@ void GameManager::SelectUnit(Vector2 mousePosition) {
 void GameManager::SelectDefaultUnit() {
     if (!currentSect || currentSect->GetUnits().empty()) {
         currentUnit = nullptr;
-        std::cout << "No units available to select" << std::endl;
+        COLONY_LOG_INFO(Input, "No units available to select");
         return;
     }
 
     // Try to find Extraction unit first
     for (auto& unit : currentSect->GetUnits()) {
-        if (unit->GetUnitType() == "Extraction") {
+        if (unit->GetType() == UnitType::Extraction) {
             currentUnit = unit;
-            std::cout << "Auto-selected Extraction unit as default" << std::endl;
+            COLONY_LOG_INFO(Input, "Auto-selected Extraction unit as default");
             return;
         }
     }
 
     // If no Extraction unit, select the first available unit
     currentUnit = currentSect->GetUnits()[0];
-    std::cout << "Auto-selected first unit: " << currentUnit->GetUnitType() << std::endl;
+    COLONY_LOG_INFO(Input, "Auto-selected first unit: " << currentUnit->GetUnitType());
 }
 
 void GameManager::BuildNewColony(Vector2 worldPos) {
@@ -144,24 +653,17 @@ void GameManager::BuildNewColony(Vector2 worldPos) {
 }
 
 void GameManager::BuildNewSect(Vector2 worldPos) {
-    bool intrudingOtherColony = false;
-    for (Colony* colony : colonies) {
-        if (colony == currentColony) continue;
-        if (CheckCollisionPointCircle(worldPos, colony->GetCentroid(), colony->GetRadius())) {
-            intrudingOtherColony = true;
-            break;
-        }
+    if (!currentColony) {
+        std::cout << "Current colony unknown!" << std::endl;
+        return;
     }
 
-    if (!intrudingOtherColony) {
-        if (currentColony) {
-            Sect* sect = new Sect(worldPos, planet->GetResourceManager(), timeManager);
-            currentColony->AddSect(sect);
-            currentSect = sect;
-            std::cout << "New sect created successfully\n";
-        } else {
-            std::cout << "Current colony unknown!" << std::endl;
-        }
+    Command command(CommandType::BUILD_SECT);
+    command.x = worldPos.x;
+    command.y = worldPos.y;
+    if (SubmitFor(currentColony, command)) {
+        currentSect = currentColony->GetSects().back();
+        std::cout << "New sect created successfully\n";
     } else {
         std::cout << "Intruding the jurisdiction of another Colony!\n";
     }
@@ -190,8 +692,8 @@ void GameManager::BuildAllRoads() {
     for (size_t i = 0; i < sects.size(); i++) {
         for (size_t j = i + 1; j < sects.size(); j++) {
             // Check if road already exists
-            if (currentColony->GetRoad(sects[i], sects[j]) == nullptr) {
-                currentColony->BuildRoad(sects[i], sects[j]);
+            if (currentColony->GetRoad(sects[i], sects[j]) == nullptr &&
+                SubmitFor(currentColony, Command(CommandType::BUILD_ROAD, static_cast<int>(i), static_cast<int>(j)))) {
                 roadsBuilt++;
             }
         }
@@ -237,7 +739,8 @@ void GameManager::CycleTransportModes() {
                 std::cout << "[TRANSPORT] Switched to AUTO_BALANCE mode" << std::endl;
                 break;
         }
-        currentColony->SetRoadTransportMode(roadToModify, newMode);
+        SubmitFor(currentColony, Command(CommandType::SET_ROAD_MODE, RoadIndex(currentColony, roadToModify),
+                                         static_cast<int>(newMode)));
     }
 }
 
@@ -343,7 +846,7 @@ void GameManager::TestRoadConstruction() {
         selectedRoad = existingRoad;
         std::cout << "[INFO] Selected existing road" << std::endl;
     } else {
-        currentColony->BuildRoad(sectA, sectB);
+        SubmitFor(currentColony, Command(CommandType::BUILD_ROAD, 0, 1));
         Road* newRoad = currentColony->GetRoad(sectA, sectB);
         if (newRoad) {
             std::cout << "[SUCCESS] Built road between sect 0 and sect 1" << std::endl;
@@ -441,16 +944,15 @@ void GameManager::RunTransportIntegrationTest() {
     std::cout << "\n[STEP 3] Setting transport modes..." << std::endl;
     const auto& updatedRoads = currentColony->GetRoads();
     int modeIndex = 0;
-    for (const auto& road : updatedRoads) {
-        Road* roadPtr = currentColony->GetRoad(road.sectA, road.sectB);
-        if (roadPtr) {
-            TransportMode mode;
-            switch (modeIndex % 3) {
-                case 0: mode = TransportMode::AUTO_BALANCE; break;
-                case 1: mode = TransportMode::MANUAL; break;
-                case 2: mode = TransportMode::DEFICIT_TRIGGERED; break;
-            }
-            currentColony->SetRoadTransportMode(roadPtr, mode);
+    for (size_t r = 0; r < updatedRoads.size(); r++) {
+        TransportMode mode;
+        switch (modeIndex % 3) {
+            case 0: mode = TransportMode::AUTO_BALANCE; break;
+            case 1: mode = TransportMode::MANUAL; break;
+            case 2: mode = TransportMode::DEFICIT_TRIGGERED; break;
+        }
+        if (SubmitFor(currentColony, Command(CommandType::SET_ROAD_MODE, static_cast<int>(r),
+                                             static_cast<int>(mode)))) {
             modeIndex++;
         }
     }
@@ -522,7 +1024,8 @@ void GameManager::SelectSectForRoadBuild(Vector2 worldPos) {
             selectedRoad = existingRoad;  // Select the existing road
         } else {
             // Build the road
-            currentColony->BuildRoad(roadBuildStartSect, selectedSect);
+            SubmitFor(currentColony, Command(CommandType::BUILD_ROAD, SectIndex(currentColony, roadBuildStartSect),
+                                             SectIndex(currentColony, selectedSect)));
             Road* newRoad = currentColony->GetRoad(roadBuildStartSect, selectedSect);
             if (newRoad) {
                 std::cout << "[ROAD BUILD] Road built successfully!" << std::endl;
@@ -566,47 +1069,22 @@ void GameManager::ConfirmSiteSelection() {
     int gridX = static_cast<int>(hoveredGridPos.x);
     int gridY = static_cast<int>(hoveredGridPos.y);
 
-    // Check for colony intrusion
-    float cellSize = SECT_CORE_RADIUS * 2.0f;
-    Vector2 worldPos = {
-        hoveredGridPos.x * cellSize + cellSize * 0.5f,
-        hoveredGridPos.y * cellSize + cellSize * 0.5f
-    };
-
-    bool intrudingOtherColony = false;
-    for (Colony* colony : colonies)
-    {
-        if (CheckCollisionPointCircle(worldPos, colony->GetCentroid(), colony->GetRadius()))
-        {
-            intrudingOtherColony = true;
-            break;
-        }
-    }
-
-    if (intrudingOtherColony)
+    // Refused when the site lies inside another colony's jurisdiction
+    if (!Submit(Command(CommandType::FOUND_COLONY, gridX, gridY)))
     {
         std::cout << "[SITE SELECT] Cannot place colony - intruding another colony's jurisdiction!" << std::endl;
         return;
     }
 
-    // Get archetype for the selected site
-    SiteArchetype archetype = planet->GetResourceManager().GetSiteArchetype(gridX, gridY);
-
     const char* archetypeNames[] = {
         "MARE_INDUSTRIAL", "HIGHLAND_CONSTRUCTION", "POLAR_VOLATILE",
         "KREEP_SCIENTIFIC", "LAVA_TUBE", "MIXED"
     };
+    SiteArchetype archetype = planet->GetResourceManager().GetSiteArchetype(gridX, gridY);
 
-    // Create colony with archetype
-    Colony* colony = new Colony();
-    colony->SetArchetype(archetype);
-    colonies.push_back(colony);
-    currentColony = colony;
-
-    // Create initial sect at the center of the selected grid cell
-    Sect* sect = new Sect(worldPos, planet->GetResourceManager(), timeManager);
-    currentColony->AddSect(sect);
-    currentSect = sect;
+    // The new colony and its initial sect, at the centre of the cell
+    currentColony = colonies.back();
+    currentSect = currentColony->GetSects().front();
 
     inSiteSelection = false;
     selectedSite = hoveredGridPos;
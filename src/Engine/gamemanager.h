@@ -9,16 +9,43 @@
 #include "sect.h"
 #include "unit.h"
 #include "time_manager.h"
+#include "sim_scheduler.h"
+#include "sim_stepper.h"
 #include "inputmanager.h"
+#include "autosave_journal.h"
+#include "rewind_buffer.h"
+#include "command.h"
+#include "session_recording.h"
+#include "sim_thread.h"
+#include "world_mirror.h"
+#include <deque>
+#include <functional>
+#include <memory>
 #include <vector>
 
-class GameManager {
+// Player actions reach the simulation as Commands (command.h): the UI
+// submits them here, where they are applied and, while a session is being
+// recorded, recorded.
+//
+// With the sim thread on (SetSimThread), the game itself runs on a
+// SimThread and what this one holds is a copy for the renderer and the
+// UI, kept in step with the tables the thread publishes (WorldMirror).
+// Commands are applied to the copy at once, so the UI sees what they did,
+// and sent on to the game; the copy takes no table until the game has
+// taken every command sent, and from then on follows the game again.
+// Whole-game operations (save, load, rewind, recording, the settings
+// below) run on the game with the thread parked.
+class GameManager : public CommandSink {
 public:
     GameManager();
     ~GameManager();
 
     void InitGame();
-    void Update(float deltaTime);
+    void Update(float frameTime);       // real seconds; runs whole simulation ticks, or syncs the copy
+    void StepSimulation(float dt);      // one tick: every colony, sect and unit once
+
+    // Applies a player action; false, with nothing changed, if refused
+    bool Submit(const Command& command) override;
 
     Planet* GetPlanet() const { return planet; }
     std::vector<Colony*>& GetColonies() { return colonies; }
@@ -53,6 +80,66 @@ public:
 
     void UpdatePlanetActiveArea();
     TimeManager& GetTimeManager() { return timeManager; }
+    const SimScheduler& GetScheduler() const { return scheduler; }
+    float GetSimAlpha() const { return simThread ? simAlpha : scheduler.GetAlpha(); }
+    double GetClockTime() const { return stepper.GetClockTime(); }
+
+    // The game on a thread of its own (see above); off runs it here,
+    // inline with the frame. Web builds stay off. Turning it on hands the
+    // game as it stands to the thread; turning it off keeps the copy and
+    // drops the thread's game, autosave and recording with it.
+    void SetSimThread(bool enabled);
+    bool IsSimThreaded() const { return simThread != nullptr; }
+
+    // Non-extraction modules run from the ModuleStore (per-kind batches)
+    // instead of unit by unit; off restores Unit::ProcessModuleEffects
+    void SetBatchedModules(bool enabled);
+    bool IsBatchingModules() const { return batchedModules; }
+
+    // Sects, then colonies, step as tasks on the job system. Results are
+    // the same as the serial loop; off runs that loop instead.
+    void SetParallelUpdate(bool enabled);
+    bool IsParallelUpdate() const { return parallelUpdate; }
+
+    // Level of detail (ColonyLod): colonies off screen run as aggregated
+    // flows and the viewed ones in full. Suspended while a session is
+    // recorded, since a replay steps every colony in full.
+    void SetLevelOfDetail(bool enabled);
+    bool IsLevelOfDetail() const { return levelOfDetail; }
+    void SetViewedColonies(const std::vector<Colony*>& viewed);
+    const ColonyLod& GetLevelOfDetail() const { return stepper.GetLevelOfDetail(); }   // inline only
+
+    // Whole-game save files (SaveGame::Save / Load). A failed load leaves
+    // the running game untouched; a successful one clears the selection.
+    bool SaveToFile(const std::string& path);
+    bool LoadFromFile(const std::string& path);
+
+    // Autosave every AUTOSAVE_INTERVAL_TICKS ticks: a journal entry of
+    // what changed, compacted now and then into a full snapshot at
+    // `path` (see AutosaveJournal). Off until enabled.
+    void EnableAutosave(const std::string& path);
+    bool IsAutosaving() const { return simThread ? syncedFrame.autosaving : autosave != nullptr; }
+    bool LoadAutosave();
+
+    // Rewind (RewindBuffer): a snapshot in memory every
+    // REWIND_INTERVAL_TICKS ticks, the last REWIND_SNAPSHOTS kept. RewindTo
+    // goes back to one of them (0 is the oldest), RewindStep to the newest
+    // one taken before the current tick; both drop the newer snapshots and
+    // clear the selection, as a load does. Loading or a new game empties
+    // the ring.
+    bool RewindTo(int index);
+    bool RewindStep();
+    const RewindBuffer& GetRewindBuffer() const { return rewind; }     // inline only
+    void LogRewindStats() const;
+
+    // Session recording (session_recording.h). Starting writes the game as
+    // it stands to `path` and reloads it from there, so the session carries
+    // on from exactly what a replay will load; the selection is kept.
+    // Stopping writes the recording, commands and hashes included, over
+    // it. Loading a save or starting a new game drops a recording.
+    bool StartRecording(const std::string& path);
+    bool StopRecording();
+    bool IsRecording() const { return simThread ? syncedFrame.recording : recorder.IsRecording(); }
 
     // Site selection
     bool IsInSiteSelection() const { return inSiteSelection; }
@@ -81,7 +168,65 @@ private:
     Vector2 selectedSite;
 
     TimeManager timeManager;
+    SimScheduler scheduler;
     float lastUpdateTime;
+
+    SimStepper stepper;                 // also the colonies' transport clock
+    bool levelOfDetail;
+    bool batchedModules;
+    bool parallelUpdate;
+    SessionRecorder recorder;
+    std::string recordingPath;
+
+    std::unique_ptr<AutosaveJournal> autosave;
+    int lastAutosaveTick;
+
+    RewindBuffer rewind;
+    int lastRewindTick;
+
+    // Sim thread; the rest of the state above is then the copy's
+    std::unique_ptr<SimThread> simThread;
+    WorldMirror mirror;
+    SimThread::Frame syncedFrame;       // the copy is this table
+    SimThread::Frame waitingFrame;      // newest published, until it covers every command sent
+    bool hasWaitingFrame;
+    uint64_t commandsSent;
+    std::deque<SimThread::Input> unsent;    // the queue was full
+    std::vector<int> sentViewed;        // colony indices
+    bool viewedSent;
+    float simAlpha;
+
+    // The selection by index, across a reload or a sync
+    struct Selection {
+        Command colony, sect, unit, roadStart;
+        bool hasColony = false;
+        bool hasSect = false;
+        bool hasUnit = false;
+        bool hasRoadStart = false;
+        int road = -1;
+    };
+    Selection LocateSelection() const;
+    void ResolveSelection(const Selection& selection);
+
+    // Replaces the colonies with freshly loaded ones and clears everything
+    // that pointed into the old ones; the rewind ring too, unless they came
+    // out of it
+    void AdoptLoadedColonies(std::vector<Colony*>& loaded, bool rewound = false);
+    void ClearSelection();
+    void ResetSimulation();
+    void DropRecording();
+    void ApplyLevelOfDetail();
+
+    // Sim thread side
+    bool CopyGameFrom(const GameManager& other);
+    bool SubmitToSimThread(const Command& command);
+    void SendToSimThread();
+    void SyncFromSimThread();
+    void SyncTo(const SimThread::Frame& frame);
+    // Runs `fn` on the thread's game (SimThread::Call) and syncs the copy
+    bool CallSimThread(const std::function<bool(GameManager&)>& fn);
+
+    const std::vector<Colony*>& GetCommandTargets() const override { return colonies; }
 };
 
 #endif // GAME_MANAGER_H
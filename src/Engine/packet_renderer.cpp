@@ -0,0 +1,147 @@
+#include "packet_renderer.h"
+#include "rlgl.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    // Packet look (world units), unchanged from the per-packet shapes.
+    const float PACKET_RADIUS = 8.0f;
+    const float PACKET_RING_RADIUS = PACKET_RADIUS + 2.0f;
+    const float PACKET_BAR_WIDTH = 20.0f;
+    const float PACKET_BAR_HEIGHT = 4.0f;
+    const float PACKET_BAR_GAP = 8.0f;
+    const Color PACKET_BAR_BG = DARKGRAY;
+    const Color PACKET_BAR_FILL = GREEN;
+
+    // Atlas layout: two 32x32 cells side by side, disc then ring. The
+    // disc centre is solid white and doubles as the bar texel.
+    const int ATLAS_CELL = 32;
+    const float DISC_HALF = PACKET_RADIUS + 1.0f;       // quad half-size
+    const float RING_HALF = PACKET_RING_RADIUS + 1.0f;
+
+    // Vertices per packet: disc, ring, bar background, bar fill.
+    const int VERTS_PER_PACKET = 4 * 4;
+
+    unsigned char Coverage(float signedDistance)
+    {
+        float a = std::min(1.0f, std::max(0.0f, 0.5f - signedDistance));
+        return static_cast<unsigned char>(a * 255.0f);
+    }
+
+    struct UVRect { float u0, v0, u1, v1; };
+
+    void PushQuad(float x0, float y0, float x1, float y1, const UVRect& uv, Color c)
+    {
+        rlColor4ub(c.r, c.g, c.b, c.a);
+        rlTexCoord2f(uv.u0, uv.v0); rlVertex2f(x0, y0);
+        rlTexCoord2f(uv.u0, uv.v1); rlVertex2f(x0, y1);
+        rlTexCoord2f(uv.u1, uv.v1); rlVertex2f(x1, y1);
+        rlTexCoord2f(uv.u1, uv.v0); rlVertex2f(x1, y0);
+    }
+}
+
+PacketRenderer::PacketRenderer()
+    : atlasLoaded(false)
+{
+    atlas = {0};
+}
+
+PacketRenderer::~PacketRenderer()
+{
+    UnloadAtlas();
+}
+
+void PacketRenderer::Clear()
+{
+    instances.clear();
+}
+
+void PacketRenderer::Add(Vector2 position, Color color, float progress)
+{
+    instances.push_back({position, color, progress});
+}
+
+void PacketRenderer::Gather(const std::vector<TransportJob>& jobs, float alpha)
+{
+    for (const auto& job : jobs) {
+        if (job.status != TransportStatus::IN_TRANSIT) continue;
+        Add(job.GetCurrentPosition(alpha),
+            ResourceUtils::GetResourceColor(job.resourceType),
+            job.progress);
+    }
+}
+
+void PacketRenderer::EnsureAtlas()
+{
+    if (atlasLoaded) return;
+
+    Image image = GenImageColor(ATLAS_CELL * 2, ATLAS_CELL, BLANK);
+    float centre = ATLAS_CELL * 0.5f;
+    float discScale = centre / DISC_HALF;   // pixels per world unit
+    float ringScale = centre / RING_HALF;
+
+    for (int y = 0; y < ATLAS_CELL; y++) {
+        for (int x = 0; x < ATLAS_CELL; x++) {
+            float dx = x + 0.5f - centre;
+            float dy = y + 0.5f - centre;
+            float d = std::sqrt(dx * dx + dy * dy);
+
+            // Filled disc of PACKET_RADIUS
+            unsigned char disc = Coverage(d / discScale - PACKET_RADIUS);
+            ImageDrawPixel(&image, x, y, Color{255, 255, 255, disc});
+
+            // One-unit ring at PACKET_RING_RADIUS (DrawCircleLinesV width)
+            unsigned char ring = Coverage(std::fabs(d / ringScale - PACKET_RING_RADIUS) - 0.5f);
+            ImageDrawPixel(&image, ATLAS_CELL + x, y, Color{255, 255, 255, ring});
+        }
+    }
+
+    atlas = LoadTextureFromImage(image);
+    UnloadImage(image);
+    SetTextureFilter(atlas, TEXTURE_FILTER_BILINEAR);
+    atlasLoaded = atlas.id != 0;
+}
+
+void PacketRenderer::UnloadAtlas()
+{
+    if (atlasLoaded) {
+        UnloadTexture(atlas);
+        atlas = {0};
+        atlasLoaded = false;
+    }
+}
+
+void PacketRenderer::Submit()
+{
+    if (instances.empty()) return;
+    EnsureAtlas();
+    if (!atlasLoaded) return;
+
+    const UVRect discUV = {0.0f, 0.0f, 0.5f, 1.0f};
+    const UVRect ringUV = {0.5f, 0.0f, 1.0f, 1.0f};
+    // A couple of texels around the disc centre: fully opaque white
+    const float texel = 1.0f / (ATLAS_CELL * 2);
+    const UVRect solidUV = {0.25f - texel, 0.5f - 2.0f * texel,
+                            0.25f + texel, 0.5f + 2.0f * texel};
+
+    rlSetTexture(atlas.id);
+    rlBegin(RL_QUADS);
+    for (const auto& p : instances) {
+        // Flushes the batch mid-stream if it would overflow; rlgl keeps
+        // the current mode and texture across the flush.
+        rlCheckRenderBatchLimit(VERTS_PER_PACKET);
+
+        float x = p.position.x;
+        float y = p.position.y;
+        PushQuad(x - DISC_HALF, y - DISC_HALF, x + DISC_HALF, y + DISC_HALF, discUV, p.color);
+        PushQuad(x - RING_HALF, y - RING_HALF, x + RING_HALF, y + RING_HALF, ringUV, WHITE);
+
+        float barX = x - PACKET_BAR_WIDTH / 2.0f;
+        float barY = y - PACKET_RADIUS - PACKET_BAR_GAP;
+        float fill = PACKET_BAR_WIDTH * std::min(1.0f, std::max(0.0f, p.progress));
+        PushQuad(barX, barY, barX + PACKET_BAR_WIDTH, barY + PACKET_BAR_HEIGHT, solidUV, PACKET_BAR_BG);
+        PushQuad(barX, barY, barX + fill, barY + PACKET_BAR_HEIGHT, solidUV, PACKET_BAR_FILL);
+    }
+    rlEnd();
+    rlSetTexture(0);
+}
@@ -0,0 +1,49 @@
+#ifndef PACKET_RENDERER_H
+#define PACKET_RENDERER_H
+
+#include "raylib.h"
+#include "transport_types.h"
+#include <vector>
+
+// One transport packet as the renderer sees it: no pointers back into
+// the simulation, just what ends up on screen.
+struct PacketInstance {
+    Vector2 position;
+    Color color;
+    float progress;     // 0.0 to 1.0, drives the small bar above the packet
+};
+
+// Batched renderer for transport packets.
+//
+// Packets are gathered into a contiguous buffer each frame and submitted
+// as textured quads against one small sprite atlas (disc, ring and a
+// solid texel for the progress bar), so any number of packets costs a
+// single texture bind and as many draw calls as the rlgl batch needs,
+// instead of four immediate-mode shapes per packet.
+class PacketRenderer {
+public:
+    PacketRenderer();
+    ~PacketRenderer();
+
+    void Clear();
+    void Add(Vector2 position, Color color, float progress);
+    // Appends every IN_TRANSIT job; does not clear first. alpha is the
+    // simulation's interpolation factor between its last two ticks.
+    void Gather(const std::vector<TransportJob>& jobs, float alpha = 1.0f);
+    // Draws everything gathered since the last Clear(). Call inside the
+    // same camera mode the packets' positions are in.
+    void Submit();
+
+    size_t GetCount() const { return instances.size(); }
+    const std::vector<PacketInstance>& GetInstances() const { return instances; }
+
+private:
+    std::vector<PacketInstance> instances;  // capacity is kept across frames
+
+    Texture2D atlas;
+    bool atlasLoaded;
+    void EnsureAtlas();
+    void UnloadAtlas();
+};
+
+#endif // PACKET_RENDERER_H
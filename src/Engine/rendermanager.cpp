@@ -11,15 +11,22 @@ RenderManager::RenderManager(int screenWidth, int screenHeight)
     : screenWidth(screenWidth),
       screenHeight(screenHeight),
       fontsLoaded(false),
+      showTextCacheStats(false),
       tilesLoaded(false),
       orbitalAssetsLoaded(false),
       terrainLoaded(false),
       terrainCellX(-1),
       terrainCellY(-1),
       terrainAnchorVersion(0),
-      planetMapLoaded(false)
+      planetMapLoaded(false),
+      resourceOverlayVersion(0),
+      surveyOverlayVersion(0),
+      simAlpha(1.0f),
+      commands(nullptr)
 {
     planetMapTexture = {0};
+    resourceOverlay = {0};
+    surveyOverlay = {0};
     orbitalNearTexture = {0};
     orbitalFarTexture = {0};
     for (int i = 0; i < 3; i++) terrainLevels[i] = {0};
@@ -42,6 +49,12 @@ void RenderManager::LoadFonts()
     }
 }
 
+bool RenderManager::SubmitUnitCommand(Unit* unit, const Command& command)
+{
+    if (commands) return commands->SubmitFor(unit, command);
+    return ApplyUnitCommand(command, *unit, static_cast<float>(GetTime()));
+}
+
 RenderManager::~RenderManager() {
     // Unload fonts
     if (fontsLoaded)
@@ -55,6 +68,7 @@ RenderManager::~RenderManager() {
     UnloadOrbitalAssets();
 
     UnloadTerrainLevels();
+    UnloadCellOverlays();
 
     if (planetMapLoaded)
     {
@@ -63,6 +77,7 @@ RenderManager::~RenderManager() {
 }
 
 void RenderManager::BeginDraw() {
+    textCache.BeginFrame();
     BeginDrawing();
     ClearBackground(RAYWHITE);
 }
@@ -126,13 +141,13 @@ void RenderManager::DrawPlanetView(Camera2D camera, Planet* planet, std::vector<
 
         // Draw colonies if any
         for (const auto& colony : colonies) {
-            colony->Draw(camera);
+            DrawColony(colony, camera);
         }
     }
 
     // Show the resource map if TAB is held
     if (inputManager.IsInfoKeyPressed()) {
-        planet->DrawResourceDebug(camera.zoom);
+        DrawResourceOverlay(planet);
     }
 
     EndMode2D();
@@ -150,7 +165,7 @@ void RenderManager::DrawPlanetView(Camera2D camera, Planet* planet, std::vector<
     }
 
     // Draw UI elements including time
-    timeManager.Draw(screenWidth, screenHeight);
+    DrawTimeHud(timeManager);
     DrawText("Planet View", 10, 10, 20, BLACK);
     DrawText("Press C for Colony View", 10, 40, 20, GRAY);
 
@@ -158,6 +173,93 @@ void RenderManager::DrawPlanetView(Camera2D camera, Planet* planet, std::vector<
     DrawText("Press Ctrl+I to see map info", 10, GetScreenHeight() - 40, 20, DARKGRAY);
 }
 
+void RenderManager::DrawColony(Colony* colony, Camera2D camera) {
+    // Draw each sect inside the colony
+    for (const auto& sect : colony->GetSects()) {
+        Vector2 worldPos = sect->GetPosition();  // This should already be in world coordinates
+        sectRenderer.DrawInColonyView(*sect, worldPos);
+        DrawText(TextFormat("R_c: %f", colony->GetRadius()), worldPos.x-10, worldPos.y-20, 20, GRAY);
+    }
+
+    // Draw jurisdiction circle when mouse is hovering over it
+    Vector2 mouseScreenPos = GetMousePosition();
+    Vector2 mouseWorldPos = GetScreenToWorld2D(mouseScreenPos, camera);
+
+    if (CheckCollisionPointCircle(mouseWorldPos, colony->GetCentroid(), colony->GetRadius())) {
+        DrawColonyJurisdiction(colony);
+    }
+}
+
+void RenderManager::DrawColonyJurisdiction(const Colony* colony) {
+    Vector2 centroid = colony->GetCentroid();
+    float jurisdiction_radius = colony->GetRadius();
+
+    // Draw dashed circle showing jurisdiction area
+    const int numSegments = 36;  // Number of segments in the circle
+    const float angleStep = 2.0f * PI / numSegments;
+
+    for (int i = 0; i < numSegments; i++) {
+        float startAngle = i * angleStep;
+        float endAngle = startAngle + angleStep / 2;  // Draw half of each segment for dashed effect
+
+        Vector2 start = {
+            centroid.x + jurisdiction_radius * cosf(startAngle),
+            centroid.y + jurisdiction_radius * sinf(startAngle)
+        };
+        Vector2 end = {
+            centroid.x + jurisdiction_radius * cosf(endAngle),
+            centroid.y + jurisdiction_radius * sinf(endAngle)
+        };
+
+        // Draw the dash in red with transparency
+        DrawLineEx(start, end, 2.0f, ColorAlpha(RED, 0.5f));
+    }
+
+    // Optional: Draw a transparent fill
+    DrawCircleV(centroid, jurisdiction_radius, ColorAlpha(RED, 0.1f));
+}
+
+void RenderManager::DrawTimeHud(const TimeManager& timeManager) {
+    int currentDay = timeManager.GetCurrentDay();
+
+    // Calculate text properties
+    const char* text = TextFormat("Day %d", currentDay);
+    int fontSize = 18;
+    int textWidth = MeasureText(text, fontSize);
+
+    // Position text at top center of screen with slight padding
+    int xPos = (screenWidth - textWidth) / 2;
+    int yPos = 10;  // Padding from top
+
+    // Draw background rectangle for better visibility
+    Color bgColor = Color{0, 0, 0, 100};  // Semi-transparent black
+    int padding = 8;
+    DrawRectangle(
+        xPos - padding,
+        yPos - padding/2,
+        textWidth + padding*2,
+        fontSize + padding,
+        bgColor
+    );
+
+    // Draw the text
+    DrawText(text, xPos, yPos, fontSize, WHITE);
+
+    // If game is paused, show pause indicator
+    if (timeManager.IsPaused()) {
+        const char* pausedText = "PAUSED";
+        int pausedFontSize = 20;
+        int pausedWidth = MeasureText(pausedText, pausedFontSize);
+        DrawText(
+            pausedText,
+            (screenWidth - pausedWidth) / 2,
+            yPos + fontSize + padding,
+            pausedFontSize,
+            RED
+        );
+    }
+}
+
 void RenderManager::DrawColonyView(Camera2D camera, Colony* colony, Planet* planet,
                                    std::vector<Colony*>& colonies, InputManager& inputManager,
                                    TimeManager& timeManager, Road* selectedRoad,
@@ -238,7 +340,7 @@ void RenderManager::DrawColonyView(Camera2D camera, Colony* colony, Planet* plan
 
         // Draw all sects in the current colony
         for (const auto& sect : colony->GetSects()) {
-            sect->DrawInColonyView(sect->GetPosition());
+            sectRenderer.DrawInColonyView(*sect, sect->GetPosition());
 
             // In build road mode, highlight sects
             if (buildRoadMode) {
@@ -271,7 +373,7 @@ void RenderManager::DrawColonyView(Camera2D camera, Colony* colony, Planet* plan
 
     // Show the resource map if TAB is held
     if (inputManager.IsInfoKeyPressed()) {
-        planet->DrawResourceDebug(camera.zoom);
+        DrawResourceOverlay(planet);
     }
 
     EndMode2D();
@@ -386,7 +488,7 @@ void RenderManager::DrawColonyView(Camera2D camera, Colony* colony, Planet* plan
     }
 
     // Draw UI elements including time
-    timeManager.Draw(screenWidth, screenHeight);
+    DrawTimeHud(timeManager);
     DrawText("Colony View", 10, 10, 20, BLACK);
     DrawText("Press S for Sect View", 10, 40, 20, GRAY);
     DrawText("Press P for Planet View", 10, 70, 20, GRAY);
@@ -413,10 +515,8 @@ void RenderManager::DrawColonyView(Camera2D camera, Colony* colony, Planet* plan
         {
             if (res.category != ResourceCategory::SINGULAR) continue;
 
-            auto sIt = reserves.find(res.type);
-            auto cIt = resCap.find(res.type);
-            float stored = (sIt != reserves.end()) ? sIt->second : 0.0f;
-            float cap = (cIt != resCap.end()) ? cIt->second : 0.0f;
+            float stored = reserves.Get(res.type);
+            float cap = resCap.Get(res.type);
 
             if (cap <= 0.0f && stored <= 0.0f) continue;
 
@@ -476,7 +576,8 @@ void RenderManager::DrawColonyView(Camera2D camera, Colony* colony, Planet* plan
                 Vector2 mouse = GetMousePosition();
                 if (CheckCollisionPointRec(mouse, btnRect))
                 {
-                    colony->UpgradeReserves();
+                    if (commands) commands->SubmitFor(colony, Command(CommandType::UPGRADE_RESERVES));
+                    else colony->UpgradeReserves();
                 }
             }
         }
@@ -659,11 +760,11 @@ void RenderManager::DrawSectTerrainBackground(Sect* sect)
 void RenderManager::DrawSectView(Sect* sect, TimeManager& timeManager) {
     DrawSectTerrainBackground(sect);
     if (sect) {
-        sect->DrawInSectView(Vector2{screenWidth/2.0f, screenHeight/2.0f});
+        sectRenderer.DrawInSectView(*sect, Vector2{screenWidth/2.0f, screenHeight/2.0f});
     }
 
     // Draw UI elements including time
-    timeManager.Draw(screenWidth, screenHeight);
+    DrawTimeHud(timeManager);
     DrawText("Sect View", 10, 10, 20, RAYWHITE);
     DrawText("Press U for Unit View", 10, 40, 20, LIGHTGRAY);
     DrawText("Press C for Colony View", 10, 70, 20, LIGHTGRAY);
@@ -687,10 +788,8 @@ void RenderManager::DrawSectView(Sect* sect, TimeManager& timeManager) {
         {
             if (res.category != ResourceCategory::SINGULAR) continue;
 
-            auto sIt = storage.find(res.type);
-            auto cIt = capacity.find(res.type);
-            float stored = (sIt != storage.end()) ? sIt->second : 0.0f;
-            float cap = (cIt != capacity.end()) ? cIt->second : 0.0f;
+            float stored = storage.Get(res.type);
+            float cap = capacity.Get(res.type);
 
             if (cap <= 0.0f && stored <= 0.0f) continue;
 
@@ -752,7 +851,8 @@ void RenderManager::DrawSectView(Sect* sect, TimeManager& timeManager) {
                 Vector2 mouse = GetMousePosition();
                 if (CheckCollisionPointRec(mouse, btnRect))
                 {
-                    sect->UpgradeStorage();
+                    if (commands) commands->SubmitFor(sect, Command(CommandType::UPGRADE_STORAGE));
+                    else sect->UpgradeStorage();
                 }
             }
         }
@@ -767,14 +867,14 @@ void RenderManager::DrawUnitView(Unit* unit, TimeManager& timeManager) {
     if (!unit) return;
 
     // Route extraction units to the new dark-themed UI
-    if (unit->GetUnitType() == "Extraction")
+    if (unit->GetType() == UnitType::Extraction)
     {
         DrawExtractionUnitView(unit, timeManager);
         return;
     }
 
     // Non-extraction units use the old rendering path
-    unit->DrawInUnitView();
+    unit->DrawInUnitView(commands);
     DrawText("Unit View", 10, 10, 20, BLACK);
     DrawText("Press S for Sect View", 10, 40, 20, GRAY);
 }
@@ -1104,28 +1204,10 @@ void RenderManager::DrawRoads(Colony* colony, Road* selectedRoad) {
 void RenderManager::DrawTransportPackets(Colony* colony) {
     if (!colony) return;
 
-    const auto& jobs = colony->GetTransportJobs();
-
-    for (const auto& job : jobs) {
-        if (job.status != TransportStatus::IN_TRANSIT) continue;
-
-        Vector2 packetPos = job.GetCurrentPosition();
-
-        // Get resource color for packet
-        Color packetColor = ResourceUtils::GetResourceColor(job.resourceType);
-
-        // Draw the packet as a colored circle with a ring
-        float packetRadius = 8.0f;
-        DrawCircleV(packetPos, packetRadius, packetColor);
-        DrawCircleLinesV(packetPos, packetRadius + 2.0f, WHITE);
-
-        // Draw small progress indicator
-        float progressWidth = 20.0f;
-        float progressHeight = 4.0f;
-        Vector2 progressPos = {packetPos.x - progressWidth/2.0f, packetPos.y - packetRadius - 8.0f};
-        DrawRectangle(progressPos.x, progressPos.y, progressWidth, progressHeight, DARKGRAY);
-        DrawRectangle(progressPos.x, progressPos.y, progressWidth * job.progress, progressHeight, GREEN);
-    }
+    // Gather positions/colours into one buffer and submit as a batch
+    packetRenderer.Clear();
+    packetRenderer.Gather(colony->GetTransportJobs(), simAlpha);
+    packetRenderer.Submit();
 }
 
 void RenderManager::DrawRoadInfoPanel(Road* selectedRoad, Colony* colony) {
@@ -1194,29 +1276,52 @@ void RenderManager::DrawRoadInfoPanel(Road* selectedRoad, Colony* colony) {
 }
 
 // ============================================================================
-// SITE SELECTION VIEW
+// CELL OVERLAYS (resource debug map, site-selection composition map)
 // ============================================================================
 
-void RenderManager::DrawSiteSelectionView(Camera2D camera, Planet* planet, Vector2 hoveredGridPos,
-                                          TimeManager& timeManager) {
-    if (!planet) return;
-
-    ResourceManager& rm = planet->GetResourceManager();
-    float cellSize = SECT_CORE_RADIUS * 2.0f;
+void RenderManager::UploadCellOverlay(Texture2D& overlay, Image& image)
+{
+    // Same size: re-upload in place; otherwise (first use or grid resize)
+    // replace the texture.
+    if (overlay.id != 0 && overlay.width == image.width && overlay.height == image.height)
+    {
+        UpdateTexture(overlay, image.data);
+    }
+    else
+    {
+        if (overlay.id != 0) UnloadTexture(overlay);
+        overlay = LoadTextureFromImage(image);
+        SetTextureFilter(overlay, TEXTURE_FILTER_POINT);
+    }
+    UnloadImage(image);
+}
 
-    // --- Draw world-space elements (orbital map with colored grid) ---
-    BeginMode2D(camera);
+void RenderManager::EnsureResourceOverlay(const ResourceManager& rm)
+{
+    if (resourceOverlay.id != 0 && resourceOverlayVersion == rm.GetOverlayVersion()) return;
 
-    // Draw tiled moon surface background
-    if (tilesLoaded)
+    int gridSize = rm.GetGridSize();
+    Image image = GenImageColor(gridSize, gridSize, BLANK);
+    for (int y = 0; y < gridSize; y++)
     {
-        RenderMoonSurface();
+        for (int x = 0; x < gridSize; x++)
+        {
+            ImageDrawPixel(&image, x, y, rm.GetResourceDebugColor(x, y));
+        }
     }
+    UploadCellOverlay(resourceOverlay, image);
+    resourceOverlayVersion = rm.GetOverlayVersion();
+}
+
+void RenderManager::EnsureSurveyOverlay(const ResourceManager& rm)
+{
+    if (surveyOverlay.id != 0 && surveyOverlayVersion == rm.GetSurveyVersion()) return;
 
-    // Draw colored overlay for each grid cell
-    for (int y = 0; y < PLANET_SIZE; y++)
+    int gridSize = rm.GetGridSize();
+    Image image = GenImageColor(gridSize, gridSize, BLANK);
+    for (int y = 0; y < gridSize; y++)
     {
-        for (int x = 0; x < PLANET_SIZE; x++)
+        for (int x = 0; x < gridSize; x++)
         {
             auto survey = rm.GetOrbitalSurveyAt(x, y);
 
@@ -1234,18 +1339,72 @@ void RenderManager::DrawSiteSelectionView(Camera2D camera, Planet* planet, Vecto
             r = static_cast<unsigned char>(r * (1.0f - mareIntensity * 0.5f));
             g = static_cast<unsigned char>(g * (1.0f - mareIntensity * 0.5f));
 
-            Color cellColor = {r, g, b, 140};
+            ImageDrawPixel(&image, x, y, Color{r, g, b, 140});
+        }
+    }
+    UploadCellOverlay(surveyOverlay, image);
+    surveyOverlayVersion = rm.GetSurveyVersion();
+}
 
-            float worldX = x * cellSize;
-            float worldY = y * cellSize;
-            DrawRectangle(static_cast<int>(worldX), static_cast<int>(worldY),
-                         static_cast<int>(cellSize), static_cast<int>(cellSize), cellColor);
+void RenderManager::DrawCellOverlay(Texture2D overlay, const ResourceManager& rm)
+{
+    if (overlay.id == 0) return;
 
-            // Draw thin grid lines
-            DrawRectangleLines(static_cast<int>(worldX), static_cast<int>(worldY),
-                              static_cast<int>(cellSize), static_cast<int>(cellSize),
-                              {100, 100, 100, 80});
-        }
+    float extent = rm.GetGridSize() * rm.GetCellSize();
+    DrawTexturePro(overlay,
+                   {0.0f, 0.0f, (float)overlay.width, (float)overlay.height},
+                   {0.0f, 0.0f, extent, extent},
+                   {0.0f, 0.0f}, 0.0f, WHITE);
+}
+
+void RenderManager::DrawResourceOverlay(Planet* planet)
+{
+    if (!planet) return;
+
+    ResourceManager& rm = planet->GetResourceManager();
+    EnsureResourceOverlay(rm);
+    DrawCellOverlay(resourceOverlay, rm);
+}
+
+void RenderManager::UnloadCellOverlays()
+{
+    if (resourceOverlay.id != 0) UnloadTexture(resourceOverlay);
+    if (surveyOverlay.id != 0) UnloadTexture(surveyOverlay);
+    resourceOverlay = {0};
+    surveyOverlay = {0};
+}
+
+// ============================================================================
+// SITE SELECTION VIEW
+// ============================================================================
+
+void RenderManager::DrawSiteSelectionView(Camera2D camera, Planet* planet, Vector2 hoveredGridPos,
+                                          TimeManager& timeManager) {
+    if (!planet) return;
+
+    ResourceManager& rm = planet->GetResourceManager();
+    float cellSize = SECT_CORE_RADIUS * 2.0f;
+
+    // --- Draw world-space elements (orbital map with colored grid) ---
+    BeginMode2D(camera);
+
+    // Draw tiled moon surface background
+    if (tilesLoaded)
+    {
+        RenderMoonSurface();
+    }
+
+    // Composition overlay (baked, one texel per cell) plus grid lines
+    EnsureSurveyOverlay(rm);
+    DrawCellOverlay(surveyOverlay, rm);
+
+    int gridSize = rm.GetGridSize();
+    float gridExtent = gridSize * cellSize;
+    for (int i = 0; i <= gridSize; i++)
+    {
+        float linePos = i * cellSize;
+        DrawLineV({linePos, 0.0f}, {linePos, gridExtent}, {100, 100, 100, 80});
+        DrawLineV({0.0f, linePos}, {gridExtent, linePos}, {100, 100, 100, 80});
     }
 
     // Highlight hovered cell
@@ -1448,6 +1607,17 @@ float RenderManager::FS(float baseSize)
     return baseSize * 1.30f;
 }
 
+void RenderManager::DrawCachedText(const Font& font, const char* text, Vector2 position,
+                                   float fontSize, float spacing, Color tint)
+{
+    textCache.Draw(textCache.Get(font, text, fontSize, spacing), font, position, tint);
+}
+
+Vector2 RenderManager::MeasureCachedText(const Font& font, const char* text, float fontSize, float spacing)
+{
+    return textCache.Get(font, text, fontSize, spacing).size;
+}
+
 // ============================================================================
 
 void RenderManager::DrawExtractionUnitView(Unit* unit, TimeManager& timeManager)
@@ -1475,7 +1645,7 @@ void RenderManager::DrawExtractionTopBar(Unit* unit, TimeManager& timeManager)
     DrawLine(0, EXT_TOP_BAR_H, screenWidth, EXT_TOP_BAR_H, EXT_PANEL_BORDER);
 
     // Unit title
-    DrawTextEx(headerFont, "EXTRACTION UNIT", {20.0f, 14.0f}, FS(22.0f), sp, WHITE);
+    DrawCachedText(headerFont, "EXTRACTION UNIT", {20.0f, 14.0f}, FS(22.0f), sp, WHITE);
 
     // Status indicator
     bool isActive = unit->IsActive();
@@ -1483,15 +1653,17 @@ void RenderManager::DrawExtractionTopBar(Unit* unit, TimeManager& timeManager)
     const char* statusText = isActive ? "ONLINE" : "OFFLINE";
     float statusX = 220.0f;
     DrawCircle(static_cast<int>(statusX), 25, 5, statusColor);
-    DrawTextEx(bodyFont, statusText, {statusX + 12.0f, 16.0f}, FS(16.0f), sp, statusColor);
+    DrawCachedText(bodyFont, statusText, {statusX + 12.0f, 16.0f}, FS(16.0f), sp, statusColor);
 
     // Day counter
-    const char* dayText = TextFormat("Day %d", timeManager.GetCurrentDay());
-    float dayWidth = MeasureTextEx(bodyFont, dayText, FS(16.0f), sp).x;
-    DrawTextEx(bodyFont, dayText, {screenWidth - dayWidth - 20.0f, 16.0f}, FS(16.0f), sp, WHITE);
+    int day = timeManager.GetCurrentDay();
+    const char* dayText = textCache.Format("Day %d", 0, {static_cast<double>(day)},
+                                           [&] { return TextFormat("Day %d", day); });
+    float dayWidth = MeasureCachedText(bodyFont, dayText, FS(16.0f), sp).x;
+    DrawCachedText(bodyFont, dayText, {screenWidth - dayWidth - 20.0f, 16.0f}, FS(16.0f), sp, WHITE);
 
     // Navigation hint
-    DrawTextEx(bodyFont, "Press S for Sect View",
+    DrawCachedText(bodyFont, "Press S for Sect View",
                {screenWidth - dayWidth - 200.0f, 16.0f}, FS(14.0f), sp, EXT_DIM_TEXT);
 }
 
@@ -1509,7 +1681,18 @@ void RenderManager::DrawExtractionBottomBar(Unit* unit)
     if (msg.opacity > 0)
     {
         Color msgColor = {255, 200, 50, static_cast<unsigned char>(255 * msg.opacity)};
-        DrawTextEx(bodyFont, msg.text.c_str(), {20.0f, startY + 8.0f}, FS(18.0f), sp, msgColor);
+        DrawCachedText(bodyFont, msg.text.c_str(), {20.0f, startY + 8.0f}, FS(18.0f), sp, msgColor);
+    }
+
+    // Text cache counters for the previous frame (F8)
+    if (showTextCacheStats)
+    {
+        const TextRunCache::Stats& stats = textCache.GetFrameStats();
+        const char* statsText = TextFormat("text cache: %d hit / %d miss  fmt %d / %d skipped  runs %d",
+                                           stats.hits, stats.misses, stats.formats, stats.formatsSkipped,
+                                           static_cast<int>(stats.runs));
+        float statsW = MeasureTextEx(bodyFont, statsText, FS(12.0f), sp).x;
+        DrawTextEx(bodyFont, statsText, {screenWidth - statsW - 20.0f, startY + 12.0f}, FS(12.0f), sp, EXT_DIM_TEXT);
     }
 }
 
@@ -1591,7 +1774,7 @@ void RenderManager::DrawExtractionModuleList(Unit* unit)
     else
         DrawRectangleLinesEx(overviewBtn, 1.0f, EXT_PANEL_BORDER);
 
-    DrawTextEx(headerFont, "UNIT OVERVIEW", {overviewBtn.x + 10.0f, overviewBtn.y + 10.0f},
+    DrawCachedText(headerFont, "UNIT OVERVIEW", {overviewBtn.x + 10.0f, overviewBtn.y + 10.0f},
                FS(16.0f), sp, overviewSelected ? WHITE : LIGHTGRAY);
 
     if (overviewHovered && IsMouseButtonPressed(MOUSE_BUTTON_LEFT))
@@ -1604,7 +1787,7 @@ void RenderManager::DrawExtractionModuleList(Unit* unit)
     yPos += 55.0f;
 
     // Section label
-    DrawTextEx(bodyFont, "MODULES", {static_cast<float>(padding), yPos}, FS(12.0f), sp, EXT_DIM_TEXT);
+    DrawCachedText(bodyFont, "MODULES", {static_cast<float>(padding), yPos}, FS(12.0f), sp, EXT_DIM_TEXT);
     yPos += 20.0f;
 
     // Module buttons
@@ -1653,7 +1836,7 @@ void RenderManager::DrawExtractionModuleList(Unit* unit)
 
         // Module name
         Color nameColor = mod.isBuilt ? WHITE : EXT_DIM_TEXT;
-        DrawTextEx(bodyFont, mod.name.c_str(), {btn.x + 10.0f, btn.y + 6.0f}, FS(15.0f), sp, nameColor);
+        DrawCachedText(bodyFont, mod.name.c_str(), {btn.x + 10.0f, btn.y + 6.0f}, FS(15.0f), sp, nameColor);
 
         // Tier indicator
         DrawTierIndicator(btn.x + 10.0f, btn.y + 32.0f, mod.tier);
@@ -1661,8 +1844,8 @@ void RenderManager::DrawExtractionModuleList(Unit* unit)
         // Status text
         const char* statusText = !mod.isBuilt ? "NOT BUILT" : (mod.isActive ? "ACTIVE" : "INACTIVE");
         Color statusColor = !mod.isBuilt ? EXT_DIM_TEXT : (mod.isActive ? EXT_ACCENT_GREEN : YELLOW);
-        float statusWidth = MeasureTextEx(bodyFont, statusText, FS(11.0f), sp).x;
-        DrawTextEx(bodyFont, statusText,
+        float statusWidth = MeasureCachedText(bodyFont, statusText, FS(11.0f), sp).x;
+        DrawCachedText(bodyFont, statusText,
                    {btn.x + btn.width - statusWidth - 10.0f, btn.y + 32.0f}, FS(11.0f), sp, statusColor);
 
         // Click handling
@@ -1697,20 +1880,27 @@ void RenderManager::DrawExtractionModuleCenter(Unit* unit)
     const auto& modules = unit->GetModules();
     if (idx < 0 || idx >= static_cast<int>(modules.size())) return;
 
-    const std::string& moduleType = modules[idx].moduleType;
-
-    if (moduleType == "PROSPECTING")
-        DrawProspectingPanel(unit, panelX, panelY, panelW, panelH);
-    else if (moduleType == "EXCAVATION")
-        DrawExcavationPanel(unit, panelX, panelY, panelW, panelH);
-    else if (moduleType == "BENEFICIATION")
-        DrawBeneficiationPanel(unit, panelX, panelY, panelW, panelH);
-    else if (moduleType == "OPERATIONS")
-        DrawOperationsPanel(unit, panelX, panelY, panelW, panelH);
-    else if (moduleType == "DIRECTIVES")
-        DrawDirectivesPanel(unit, panelX, panelY, panelW, panelH);
-    else
-        DrawExtractionResourceOverview(unit, panelX, panelY, panelW, panelH);
+    switch (modules[idx].kind)
+    {
+        case ModuleKind::PROSPECTING:
+            DrawProspectingPanel(unit, panelX, panelY, panelW, panelH);
+            break;
+        case ModuleKind::EXCAVATION:
+            DrawExcavationPanel(unit, panelX, panelY, panelW, panelH);
+            break;
+        case ModuleKind::BENEFICIATION:
+            DrawBeneficiationPanel(unit, panelX, panelY, panelW, panelH);
+            break;
+        case ModuleKind::OPERATIONS:
+            DrawOperationsPanel(unit, panelX, panelY, panelW, panelH);
+            break;
+        case ModuleKind::DIRECTIVES:
+            DrawDirectivesPanel(unit, panelX, panelY, panelW, panelH);
+            break;
+        default:
+            DrawExtractionResourceOverview(unit, panelX, panelY, panelW, panelH);
+            break;
+    }
 }
 
 // --- Right Panel: Controls ---
@@ -1735,7 +1925,7 @@ void RenderManager::DrawExtractionControlPanel(Unit* unit)
     if (!unit->IsInModuleView())
     {
         // Unit overview mode - production rate controls
-        DrawTextEx(headerFont, "PRODUCTION CONTROLS", {static_cast<float>(panelX + padding), yPos},
+        DrawCachedText(headerFont, "PRODUCTION CONTROLS", {static_cast<float>(panelX + padding), yPos},
                    FS(16.0f), sp, EXT_HEADER_COLOR);
         yPos += 30.0f;
 
@@ -1744,7 +1934,7 @@ void RenderManager::DrawExtractionControlPanel(Unit* unit)
 
         if (activeIndices.empty())
         {
-            DrawTextEx(bodyFont, "No active modules",
+            DrawCachedText(bodyFont, "No active modules",
                        {static_cast<float>(panelX + padding), yPos}, FS(14.0f), sp, EXT_DIM_TEXT);
         }
         return;
@@ -1755,7 +1945,7 @@ void RenderManager::DrawExtractionControlPanel(Unit* unit)
     if (idx < 0 || idx >= static_cast<int>(modules.size())) return;
     const auto& mod = modules[idx];
 
-    DrawTextEx(headerFont, "CONTROLS", {static_cast<float>(panelX + padding), yPos},
+    DrawCachedText(headerFont, "CONTROLS", {static_cast<float>(panelX + padding), yPos},
                FS(16.0f), sp, EXT_HEADER_COLOR);
     yPos += 30.0f;
 
@@ -1776,14 +1966,14 @@ void RenderManager::DrawExtractionControlPanel(Unit* unit)
         DrawRectangleLinesEx(buildBtn, 1.0f, canBuild ? EXT_ACCENT_CYAN : EXT_DIM_TEXT);
 
         const char* buildText = "BUILD MODULE";
-        float textW = MeasureTextEx(headerFont, buildText, FS(16.0f), sp).x;
-        DrawTextEx(headerFont, buildText,
+        float textW = MeasureCachedText(headerFont, buildText, FS(16.0f), sp).x;
+        DrawCachedText(headerFont, buildText,
                    {buildBtn.x + (btnW - textW) / 2.0f, buildBtn.y + 12.0f}, FS(16.0f), sp,
                    canBuild ? WHITE : EXT_DIM_TEXT);
 
         if (isHovered && canBuild && IsMouseButtonPressed(MOUSE_BUTTON_LEFT))
         {
-            unit->PublicBuildModule(idx);
+            SubmitUnitCommand(unit, Command(CommandType::BUILD_MODULE, idx));
         }
 
         yPos += btnH + 10.0f;
@@ -1792,7 +1982,7 @@ void RenderManager::DrawExtractionControlPanel(Unit* unit)
         auto costIter = mod.upgradeCosts.find(1);
         if (costIter != mod.upgradeCosts.end())
         {
-            DrawTextEx(bodyFont, "Build Cost:", {static_cast<float>(panelX + padding), yPos},
+            DrawCachedText(bodyFont, "Build Cost:", {static_cast<float>(panelX + padding), yPos},
                        FS(13.0f), sp, EXT_DIM_TEXT);
             yPos += 18.0f;
 
@@ -1800,12 +1990,10 @@ void RenderManager::DrawExtractionControlPanel(Unit* unit)
             for (const auto& [resource, amount] : costIter->second)
             {
                 std::string resName = ResourceUtils::GetResourceName(resource);
-                float stored = 0.0f;
-                auto it = storage.find(resource);
-                if (it != storage.end()) stored = it->second;
+                float stored = storage.Get(resource);
 
                 Color costColor = (stored >= amount) ? EXT_ACCENT_GREEN : Color{255, 100, 100, 255};
-                DrawTextEx(bodyFont, TextFormat("  %s: %.0f / %.0f", resName.c_str(), stored, amount),
+                DrawCachedText(bodyFont, TextFormat("  %s: %.0f / %.0f", resName.c_str(), stored, amount),
                            {static_cast<float>(panelX + padding), yPos}, FS(12.0f), sp, costColor);
                 yPos += 16.0f;
             }
@@ -1826,15 +2014,16 @@ void RenderManager::DrawExtractionControlPanel(Unit* unit)
         DrawRectangleRec(upgradeBtn, btnColor);
         DrawRectangleLinesEx(upgradeBtn, 1.0f, canUpgrade ? EXT_ACCENT_CYAN : EXT_DIM_TEXT);
 
-        const char* upgradeText = TextFormat("UPGRADE TO TIER %d", mod.tier + 1);
-        float textW = MeasureTextEx(headerFont, upgradeText, FS(14.0f), sp).x;
-        DrawTextEx(headerFont, upgradeText,
+        const char* upgradeText = textCache.Format("UPGRADE TO TIER %d", 0, {static_cast<double>(mod.tier)},
+                                                   [&] { return TextFormat("UPGRADE TO TIER %d", mod.tier + 1); });
+        float textW = MeasureCachedText(headerFont, upgradeText, FS(14.0f), sp).x;
+        DrawCachedText(headerFont, upgradeText,
                    {upgradeBtn.x + (btnW - textW) / 2.0f, upgradeBtn.y + 12.0f}, FS(14.0f), sp,
                    canUpgrade ? WHITE : EXT_DIM_TEXT);
 
         if (isHovered && canUpgrade && IsMouseButtonPressed(MOUSE_BUTTON_LEFT))
         {
-            unit->UpgradeModuleTier(idx);
+            SubmitUnitCommand(unit, Command(CommandType::UPGRADE_MODULE_TIER, idx));
         }
 
         yPos += btnH + 10.0f;
@@ -1843,7 +2032,7 @@ void RenderManager::DrawExtractionControlPanel(Unit* unit)
         auto costIter = mod.upgradeCosts.find(mod.tier + 1);
         if (costIter != mod.upgradeCosts.end())
         {
-            DrawTextEx(bodyFont, "Upgrade Cost:", {static_cast<float>(panelX + padding), yPos},
+            DrawCachedText(bodyFont, "Upgrade Cost:", {static_cast<float>(panelX + padding), yPos},
                        FS(13.0f), sp, EXT_DIM_TEXT);
             yPos += 18.0f;
 
@@ -1851,12 +2040,10 @@ void RenderManager::DrawExtractionControlPanel(Unit* unit)
             for (const auto& [resource, amount] : costIter->second)
             {
                 std::string resName = ResourceUtils::GetResourceName(resource);
-                float stored = 0.0f;
-                auto it = storage.find(resource);
-                if (it != storage.end()) stored = it->second;
+                float stored = storage.Get(resource);
 
                 Color costColor = (stored >= amount) ? EXT_ACCENT_GREEN : Color{255, 100, 100, 255};
-                DrawTextEx(bodyFont, TextFormat("  %s: %.0f / %.0f", resName.c_str(), stored, amount),
+                DrawCachedText(bodyFont, TextFormat("  %s: %.0f / %.0f", resName.c_str(), stored, amount),
                            {static_cast<float>(panelX + padding), yPos}, FS(12.0f), sp, costColor);
                 yPos += 16.0f;
             }
@@ -1864,7 +2051,7 @@ void RenderManager::DrawExtractionControlPanel(Unit* unit)
     }
     else
     {
-        DrawTextEx(bodyFont, "MAX TIER REACHED", {static_cast<float>(panelX + padding), yPos},
+        DrawCachedText(bodyFont, "MAX TIER REACHED", {static_cast<float>(panelX + padding), yPos},
                    FS(14.0f), sp, EXT_ACCENT_GOLD);
         yPos += 25.0f;
     }
@@ -1882,33 +2069,36 @@ void RenderManager::DrawExtractionControlPanel(Unit* unit)
     DrawRectangleLinesEx(toggleBtn, 1.0f, mod.isActive ? Color{255, 100, 100, 200} : EXT_ACCENT_GREEN);
 
     const char* toggleText = mod.isActive ? "DEACTIVATE" : "ACTIVATE";
-    float textW = MeasureTextEx(headerFont, toggleText, FS(16.0f), sp).x;
-    DrawTextEx(headerFont, toggleText,
+    float textW = MeasureCachedText(headerFont, toggleText, FS(16.0f), sp).x;
+    DrawCachedText(headerFont, toggleText,
                {toggleBtn.x + (btnW - textW) / 2.0f, toggleBtn.y + 12.0f}, FS(16.0f), sp, WHITE);
 
     if (isHovered && IsMouseButtonPressed(MOUSE_BUTTON_LEFT))
     {
-        unit->PublicHandleModuleActivation(idx);
+        SubmitUnitCommand(unit, Command(CommandType::TOGGLE_MODULE, idx));
     }
 
     yPos += btnH + 20.0f;
 
     // Module info section
-    DrawTextEx(headerFont, "MODULE INFO", {static_cast<float>(panelX + padding), yPos},
+    DrawCachedText(headerFont, "MODULE INFO", {static_cast<float>(panelX + padding), yPos},
                FS(14.0f), sp, EXT_HEADER_COLOR);
     yPos += 22.0f;
 
-    DrawTextEx(bodyFont, TextFormat("Tier: %d / 3", mod.tier),
+    DrawCachedText(bodyFont, textCache.Format("Tier: %d / 3", 0, {static_cast<double>(mod.tier)},
+                                              [&] { return TextFormat("Tier: %d / 3", mod.tier); }),
                {static_cast<float>(panelX + padding), yPos}, FS(13.0f), sp, LIGHTGRAY);
     yPos += 18.0f;
 
-    DrawTextEx(bodyFont, TextFormat("Efficiency: %.0f%%", mod.efficiency * 100.0f),
+    DrawCachedText(bodyFont, textCache.Format("Efficiency: %.0f%%", 0, {mod.efficiency},
+                                              [&] { return TextFormat("Efficiency: %.0f%%", mod.efficiency * 100.0f); }),
                {static_cast<float>(panelX + padding), yPos}, FS(13.0f), sp, LIGHTGRAY);
     yPos += 18.0f;
 
     if (mod.energyRequired > 0)
     {
-        DrawTextEx(bodyFont, TextFormat("Energy: %.1f kW", mod.energyRequired),
+        DrawCachedText(bodyFont, textCache.Format("Energy: %.1f kW", 0, {mod.energyRequired},
+                                                  [&] { return TextFormat("Energy: %.1f kW", mod.energyRequired); }),
                    {static_cast<float>(panelX + padding), yPos}, FS(13.0f), sp, LIGHTGRAY);
         yPos += 18.0f;
     }
@@ -1917,12 +2107,12 @@ void RenderManager::DrawExtractionControlPanel(Unit* unit)
     if (!mod.tierDependencies.empty())
     {
         yPos += 10.0f;
-        DrawTextEx(bodyFont, "Required Tech:",
+        DrawCachedText(bodyFont, "Required Tech:",
                    {static_cast<float>(panelX + padding), yPos}, FS(12.0f), sp, EXT_DIM_TEXT);
         yPos += 16.0f;
         for (const auto& dep : mod.tierDependencies)
         {
-            DrawTextEx(bodyFont, TextFormat("  - %s", dep.c_str()),
+            DrawCachedText(bodyFont, TextFormat("  - %s", dep.c_str()),
                        {static_cast<float>(panelX + padding), yPos}, FS(11.0f), sp, EXT_DIM_TEXT);
             yPos += 14.0f;
         }
@@ -1943,33 +2133,33 @@ void RenderManager::DrawExtractionResourceOverview(Unit* unit, int x, int y, int
     float yPos = static_cast<float>(y + padding);
     float px = static_cast<float>(x + padding);
 
-    DrawTextEx(headerFont, "RESOURCE OVERVIEW", {px, yPos}, FS(18.0f), sp, EXT_HEADER_COLOR);
+    DrawCachedText(headerFont, "RESOURCE OVERVIEW", {px, yPos}, FS(18.0f), sp, EXT_HEADER_COLOR);
     yPos += 30.0f;
 
     // Aggregate production/consumption from active modules
     const auto& modules = unit->GetModules();
     const auto& activeIndices = unit->GetActiveModuleIndices();
 
-    std::map<ResourceType, float> totalProduction;
-    std::map<ResourceType, float> totalConsumption;
+    ResourceVector totalProduction;
+    ResourceVector totalConsumption;
 
     for (int moduleIndex : activeIndices)
     {
         const auto& mod = modules[moduleIndex];
-        for (const auto& [type, rate] : mod.productionRates)
-            totalProduction[type] += rate;
-        for (const auto& [type, rate] : mod.consumptionRates)
-            totalConsumption[type] += rate;
+        totalProduction += mod.productionRates;
+        totalConsumption += mod.consumptionRates;
     }
 
     // Status line
-    DrawTextEx(bodyFont, TextFormat("Active Modules: %d", static_cast<int>(activeIndices.size())),
+    int activeCount = static_cast<int>(activeIndices.size());
+    DrawCachedText(bodyFont, textCache.Format("Active Modules: %d", 0, {static_cast<double>(activeCount)},
+                                              [&] { return TextFormat("Active Modules: %d", activeCount); }),
                {px, yPos}, FS(14.0f), sp, LIGHTGRAY);
     yPos += 20.0f;
 
     const char* statusText = unit->IsActive() ? "ACTIVE" : "IDLE";
     Color statusColor = unit->IsActive() ? EXT_ACCENT_GREEN : YELLOW;
-    DrawTextEx(bodyFont, TextFormat("Status: %s", statusText), {px, yPos}, FS(14.0f), sp, statusColor);
+    DrawCachedText(bodyFont, TextFormat("Status: %s", statusText), {px, yPos}, FS(14.0f), sp, statusColor);
     yPos += 30.0f;
 
     // Resource rates table
@@ -1988,9 +2178,9 @@ void RenderManager::DrawExtractionResourceOverview(Unit* unit, int x, int y, int
     };
 
     // Column headers
-    DrawTextEx(bodyFont, "Resource", {px, yPos}, FS(13.0f), sp, EXT_DIM_TEXT);
-    DrawTextEx(bodyFont, "Production", {px + 120.0f, yPos}, FS(13.0f), sp, EXT_DIM_TEXT);
-    DrawTextEx(bodyFont, "Consumption", {px + 240.0f, yPos}, FS(13.0f), sp, EXT_DIM_TEXT);
+    DrawCachedText(bodyFont, "Resource", {px, yPos}, FS(13.0f), sp, EXT_DIM_TEXT);
+    DrawCachedText(bodyFont, "Production", {px + 120.0f, yPos}, FS(13.0f), sp, EXT_DIM_TEXT);
+    DrawCachedText(bodyFont, "Consumption", {px + 240.0f, yPos}, FS(13.0f), sp, EXT_DIM_TEXT);
     yPos += 20.0f;
     DrawLine(static_cast<int>(px), static_cast<int>(yPos),
              static_cast<int>(px + w - padding * 2), static_cast<int>(yPos), EXT_PANEL_BORDER);
@@ -1998,28 +2188,32 @@ void RenderManager::DrawExtractionResourceOverview(Unit* unit, int x, int y, int
 
     for (const auto& res : resources)
     {
-        float prod = totalProduction[res.type];
-        float cons = totalConsumption[res.type];
+        float prod = totalProduction.Get(res.type);
+        float cons = totalConsumption.Get(res.type);
         if (prod <= 0 && cons <= 0) continue;
 
-        DrawTextEx(bodyFont, res.name, {px, yPos}, FS(13.0f), sp, LIGHTGRAY);
+        DrawCachedText(bodyFont, res.name, {px, yPos}, FS(13.0f), sp, LIGHTGRAY);
 
         if (prod > 0)
-            DrawTextEx(bodyFont, TextFormat("+%.2f/s", prod), {px + 120.0f, yPos}, FS(13.0f), sp, EXT_ACCENT_GREEN);
+            DrawCachedText(bodyFont, textCache.Format("+%.2f/s", static_cast<int>(res.type), {prod},
+                                                      [&] { return TextFormat("+%.2f/s", prod); }),
+                       {px + 120.0f, yPos}, FS(13.0f), sp, EXT_ACCENT_GREEN);
         else
-            DrawTextEx(bodyFont, "-", {px + 120.0f, yPos}, FS(13.0f), sp, EXT_DIM_TEXT);
+            DrawCachedText(bodyFont, "-", {px + 120.0f, yPos}, FS(13.0f), sp, EXT_DIM_TEXT);
 
         if (cons > 0)
-            DrawTextEx(bodyFont, TextFormat("-%.2f/s", cons), {px + 240.0f, yPos}, FS(13.0f), sp, Color{255, 100, 100, 255});
+            DrawCachedText(bodyFont, textCache.Format("-%.2f/s", static_cast<int>(res.type), {cons},
+                                                      [&] { return TextFormat("-%.2f/s", cons); }),
+                       {px + 240.0f, yPos}, FS(13.0f), sp, Color{255, 100, 100, 255});
         else
-            DrawTextEx(bodyFont, "-", {px + 240.0f, yPos}, FS(13.0f), sp, EXT_DIM_TEXT);
+            DrawCachedText(bodyFont, "-", {px + 240.0f, yPos}, FS(13.0f), sp, EXT_DIM_TEXT);
 
         yPos += 18.0f;
     }
 
     // Storage section
     yPos += 20.0f;
-    DrawTextEx(headerFont, "STORAGE", {px, yPos}, FS(16.0f), sp, EXT_HEADER_COLOR);
+    DrawCachedText(headerFont, "STORAGE", {px, yPos}, FS(16.0f), sp, EXT_HEADER_COLOR);
     yPos += 25.0f;
 
     const auto& storage = unit->GetResourceStorage();
@@ -2030,20 +2224,14 @@ void RenderManager::DrawExtractionResourceOverview(Unit* unit, int x, int y, int
     bool hasStorage = false;
     for (const auto& res : resources)
     {
-        float stored = 0.0f;
-        float cap = 0.0f;
-        float buffered = 0.0f;
-        auto sIt = storage.find(res.type);
-        auto cIt = capacity.find(res.type);
-        auto oIt = overflow.find(res.type);
-        if (sIt != storage.end()) stored = sIt->second;
-        if (cIt != capacity.end()) cap = cIt->second;
-        if (oIt != overflow.end()) buffered = oIt->second;
+        float stored = storage.Get(res.type);
+        float cap = capacity.Get(res.type);
+        float buffered = overflow.Get(res.type);
 
         if (cap <= 0 && stored <= 0) continue;
         hasStorage = true;
 
-        DrawTextEx(bodyFont, res.name, {px, yPos + 2.0f}, FS(12.0f), sp, LIGHTGRAY);
+        DrawCachedText(bodyFont, res.name, {px, yPos + 2.0f}, FS(12.0f), sp, LIGHTGRAY);
 
         float fillFraction = cap > 0 ? stored / cap : 0.0f;
         Color barColor;
@@ -2056,12 +2244,14 @@ void RenderManager::DrawExtractionResourceOverview(Unit* unit, int x, int y, int
         // Show overflow indicator if buffer has content
         if (buffered > 0.0f)
         {
-            DrawTextEx(bodyFont, TextFormat("%.0f/%.0f +%.0f", stored, cap, buffered),
+            DrawCachedText(bodyFont, textCache.Format("%.0f/%.0f +%.0f", static_cast<int>(res.type), {stored, cap, buffered},
+                                                      [&] { return TextFormat("%.0f/%.0f +%.0f", stored, cap, buffered); }),
                        {px + 90.0f + barW + 5.0f, yPos + 1.0f}, FS(11.0f), sp, Color{255, 180, 100, 255});
         }
         else
         {
-            DrawTextEx(bodyFont, TextFormat("%.0f/%.0f", stored, cap),
+            DrawCachedText(bodyFont, textCache.Format("%.0f/%.0f", static_cast<int>(res.type), {stored, cap},
+                                                      [&] { return TextFormat("%.0f/%.0f", stored, cap); }),
                        {px + 90.0f + barW + 5.0f, yPos + 1.0f}, FS(11.0f), sp, LIGHTGRAY);
         }
 
@@ -2070,7 +2260,7 @@ void RenderManager::DrawExtractionResourceOverview(Unit* unit, int x, int y, int
 
     if (!hasStorage)
     {
-        DrawTextEx(bodyFont, "Storage is empty", {px, yPos}, FS(13.0f), sp, EXT_DIM_TEXT);
+        DrawCachedText(bodyFont, "Storage is empty", {px, yPos}, FS(13.0f), sp, EXT_DIM_TEXT);
     }
 }
 
@@ -2149,19 +2339,18 @@ void RenderManager::DrawProspectingPanel(Unit* unit, int x, int y, int w, int h)
 
     if (!unit->HasProspectingSystem())
     {
-        DrawTextEx(headerFont, "No prospecting system.", {px, static_cast<float>(y + padding)},
+        DrawCachedText(headerFont, "No prospecting system.", {px, static_cast<float>(y + padding)},
                    FS(14.0f), sp, EXT_DIM_TEXT);
         return;
     }
 
     auto* ps = unit->GetProspectingSystem();
-    ps->gameTime += GetFrameTime();
     Vector2 mouse = GetMousePosition();
 
     // --- Header: title + survey progress bar ---
     float yPos = static_cast<float>(y + padding);
     float progress = ps->GetSurveyProgress();
-    DrawTextEx(headerFont, "PROSPECTING", {px, yPos}, FS(16.0f), sp, EXT_HEADER_COLOR);
+    DrawCachedText(headerFont, "PROSPECTING", {px, yPos}, FS(16.0f), sp, EXT_HEADER_COLOR);
 
     float barW = 160.0f;
     float barH = 14.0f;
@@ -2171,7 +2360,7 @@ void RenderManager::DrawProspectingPanel(Unit* unit, int x, int y, int w, int h)
     Color barColor = progress >= 0.60f ? EXT_ACCENT_GREEN : EXT_ACCENT_CYAN;
     DrawRectangle(static_cast<int>(barX), static_cast<int>(yPos + 2),
                   static_cast<int>(barW * std::min(progress, 1.0f)), static_cast<int>(barH), barColor);
-    DrawTextEx(bodyFont, TextFormat("%.0f%%", progress * 100.0f),
+    DrawCachedText(bodyFont, TextFormat("%.0f%%", progress * 100.0f),
                {barX + barW + 5.0f, yPos + 1.0f}, FS(11.0f), sp, barColor);
     yPos += 28.0f;
 
@@ -2203,8 +2392,8 @@ void RenderManager::DrawProspectingPanel(Unit* unit, int x, int y, int w, int h)
         }
 
         Color textColor = isActive ? PROS_TAB_ACTIVE_BDR : (isHover ? PROS_BTN_TEXT_HOVER : PROS_BTN_TEXT);
-        Vector2 textSize = MeasureTextEx(bodyFont, tabNames[i], FS(11.0f), sp);
-        DrawTextEx(bodyFont, tabNames[i],
+        Vector2 textSize = MeasureCachedText(bodyFont, tabNames[i], FS(11.0f), sp);
+        DrawCachedText(bodyFont, tabNames[i],
                    {tabRect.x + (tabW - textSize.x) / 2, tabRect.y + (tabH - textSize.y) / 2},
                    FS(11.0f), sp, textColor);
 
@@ -2274,7 +2463,7 @@ void RenderManager::DrawProspectingPanel(Unit* unit, int x, int y, int w, int h)
         float ctrlY = contentY;
         float ctrlW = pw - gridAreaW - 15.0f;
 
-        DrawTextEx(headerFont, "FREQUENCY BAND", {ctrlX, ctrlY}, FS(12.0f), sp, EXT_HEADER_COLOR);
+        DrawCachedText(headerFont, "FREQUENCY BAND", {ctrlX, ctrlY}, FS(12.0f), sp, EXT_HEADER_COLOR);
         ctrlY += 22.0f;
 
         for (int band = 0; band < SWEEP_FREQUENCY_BANDS; band++)
@@ -2294,7 +2483,7 @@ void RenderManager::DrawProspectingPanel(Unit* unit, int x, int y, int w, int h)
             DrawRectangleLinesEx(bandBtn, 1.0f, ps->selectedFrequencyBand == band ? PROS_TAB_ACTIVE_BDR : borderCol);
 
             const char* bandLabel = TextFormat("Band %d  %.0f E", band, SWEEP_ENERGY_COST[band]);
-            DrawTextEx(bodyFont, bandLabel, {ctrlX + 6, ctrlY + 4}, FS(10.0f), sp, textCol);
+            DrawCachedText(bodyFont, bandLabel, {ctrlX + 6, ctrlY + 4}, FS(10.0f), sp, textCol);
 
             if (hover && canSweep && IsMouseButtonPressed(MOUSE_BUTTON_LEFT))
             {
@@ -2311,13 +2500,13 @@ void RenderManager::DrawProspectingPanel(Unit* unit, int x, int y, int w, int h)
         if (sweepHover && canSweepNow)
             DrawRectangleRec(sweepBtn, PROS_BTN_HOVER);
         DrawRectangleLinesEx(sweepBtn, 1.0f, canSweepNow ? PROS_TAB_ACTIVE_BDR : PROS_BTN_DISABLED);
-        DrawTextEx(headerFont, "SWEEP",
+        DrawCachedText(headerFont, "SWEEP",
                    {ctrlX + (ctrlW - 10.0f) / 2 - 20.0f, ctrlY + 6}, FS(13.0f), sp,
                    canSweepNow ? (sweepHover ? WHITE : PROS_BTN_TEXT_HOVER) : PROS_BTN_DISABLED);
 
         if (sweepHover && canSweepNow && IsMouseButtonPressed(MOUSE_BUTTON_LEFT))
         {
-            ps->GetSweep().ExecuteSweep(ps->GetGrid(), ps->selectedFrequencyBand, ps->gameTime);
+            SubmitUnitCommand(unit, Command(CommandType::PROSPECT_SWEEP, ps->selectedFrequencyBand));
         }
 
         ctrlY += 40.0f;
@@ -2326,13 +2515,16 @@ void RenderManager::DrawProspectingPanel(Unit* unit, int x, int y, int w, int h)
         const auto& sweepHist = grid.GetSweepHistory();
         if (!sweepHist.empty())
         {
-            DrawTextEx(bodyFont, TextFormat("Sweeps: %d", static_cast<int>(sweepHist.size())),
+            int sweepCount = static_cast<int>(sweepHist.size());
+            DrawCachedText(bodyFont, textCache.Format("Sweeps: %d", 0, {static_cast<double>(sweepCount)},
+                                                      [&] { return TextFormat("Sweeps: %d", sweepCount); }),
                        {ctrlX, ctrlY}, FS(10.0f), sp, EXT_DIM_TEXT);
             ctrlY += 16.0f;
         }
 
         float calQ = ps->GetSweep().GetCalibrationQuality();
-        DrawTextEx(bodyFont, TextFormat("Calibration: %.0f%%", calQ * 100.0f),
+        DrawCachedText(bodyFont, textCache.Format("Calibration: %.0f%%", 0, {calQ},
+                                                  [&] { return TextFormat("Calibration: %.0f%%", calQ * 100.0f); }),
                    {ctrlX, ctrlY}, FS(10.0f), sp, calQ >= 0.8f ? EXT_ACCENT_GREEN : PROS_MSG_ALERT);
         ctrlY += 16.0f;
 
@@ -2341,18 +2533,19 @@ void RenderManager::DrawProspectingPanel(Unit* unit, int x, int y, int w, int h)
             ps->selectedCellY >= 0 && ps->selectedCellY < gridSize)
         {
             ctrlY += 8.0f;
-            DrawTextEx(headerFont, TextFormat("CELL (%d,%d)", ps->selectedCellX, ps->selectedCellY),
+            DrawCachedText(headerFont, TextFormat("CELL (%d,%d)", ps->selectedCellX, ps->selectedCellY),
                        {ctrlX, ctrlY}, FS(11.0f), sp, EXT_HEADER_COLOR);
             ctrlY += 18.0f;
 
             const SubCell& selCell = grid.GetSubCell(ps->selectedCellX, ps->selectedCellY);
-            DrawTextEx(bodyFont, TextFormat("Signal: %.2f", selCell.sweepSignal),
+            DrawCachedText(bodyFont, textCache.Format("Signal: %.2f", 0, {selCell.sweepSignal},
+                                                      [&] { return TextFormat("Signal: %.2f", selCell.sweepSignal); }),
                        {ctrlX, ctrlY}, FS(10.0f), sp, EXT_DIM_TEXT);
             ctrlY += 14.0f;
-            DrawTextEx(bodyFont, TextFormat("Confidence: %s", ProsConfLabel(selCell.aggregateConfidence)),
+            DrawCachedText(bodyFont, TextFormat("Confidence: %s", ProsConfLabel(selCell.aggregateConfidence)),
                        {ctrlX, ctrlY}, FS(10.0f), sp, EXT_DIM_TEXT);
             ctrlY += 14.0f;
-            DrawTextEx(bodyFont, TextFormat("Samples: %d", static_cast<int>(selCell.sampleIds.size())),
+            DrawCachedText(bodyFont, TextFormat("Samples: %d", static_cast<int>(selCell.sampleIds.size())),
                        {ctrlX, ctrlY}, FS(10.0f), sp, EXT_DIM_TEXT);
         }
     }
@@ -2421,7 +2614,7 @@ void RenderManager::DrawProspectingPanel(Unit* unit, int x, int y, int w, int h)
         float ctrlY = contentY;
         float ctrlW = pw - gridAreaW - 15.0f;
 
-        DrawTextEx(headerFont, "DEPTH LAYER", {ctrlX, ctrlY}, FS(12.0f), sp, EXT_HEADER_COLOR);
+        DrawCachedText(headerFont, "DEPTH LAYER", {ctrlX, ctrlY}, FS(12.0f), sp, EXT_HEADER_COLOR);
         ctrlY += 22.0f;
 
         DepthLayer depths[] = {DepthLayer::SURFACE, DepthLayer::SHALLOW, DepthLayer::MID, DepthLayer::DEEP};
@@ -2445,7 +2638,7 @@ void RenderManager::DrawProspectingPanel(Unit* unit, int x, int y, int w, int h)
             const char* label = canDrill
                 ? TextFormat("%s  %.0fE", ProsDepthName(depths[d]), cost)
                 : TextFormat("%s  [LOCKED]", ProsDepthName(depths[d]));
-            DrawTextEx(bodyFont, label, {ctrlX + 6, ctrlY + 3}, FS(9.0f), sp, textCol);
+            DrawCachedText(bodyFont, label, {ctrlX + 6, ctrlY + 3}, FS(9.0f), sp, textCol);
 
             if (hover && canDrill && IsMouseButtonPressed(MOUSE_BUTTON_LEFT))
             {
@@ -2467,19 +2660,23 @@ void RenderManager::DrawProspectingPanel(Unit* unit, int x, int y, int w, int h)
         if (collectHover && canCollect)
             DrawRectangleRec(collectBtn, PROS_BTN_HOVER);
         DrawRectangleLinesEx(collectBtn, 1.0f, canCollect ? PROS_TAB_ACTIVE_BDR : PROS_BTN_DISABLED);
-        DrawTextEx(headerFont, "COLLECT",
+        DrawCachedText(headerFont, "COLLECT",
                    {ctrlX + (ctrlW - 10.0f) / 2 - 25.0f, ctrlY + 5}, FS(12.0f), sp,
                    canCollect ? (collectHover ? WHITE : PROS_BTN_TEXT_HOVER) : PROS_BTN_DISABLED);
 
         if (collectHover && canCollect && IsMouseButtonPressed(MOUSE_BUTTON_LEFT))
         {
-            ps->GetSampler().CollectSample(ps->GetGrid(), ps->GetTray(),
-                                            ps->selectedCellX, ps->selectedCellY, ps->selectedDepth);
+            SubmitUnitCommand(unit, Command(CommandType::PROSPECT_COLLECT, ps->selectedCellX, ps->selectedCellY,
+                                                  static_cast<int>(ps->selectedDepth)));
         }
 
         // Sample tray display
         ctrlY += 40.0f;
-        DrawTextEx(headerFont, TextFormat("TRAY (%d/%d)", ps->GetTray().GetCount(), ps->GetTray().GetCapacity()),
+        int trayCount = ps->GetTray().GetCount();
+        int trayCapacity = ps->GetTray().GetCapacity();
+        DrawCachedText(headerFont, textCache.Format("TRAY (%d/%d)", 0,
+                                                    {static_cast<double>(trayCount), static_cast<double>(trayCapacity)},
+                                                    [&] { return TextFormat("TRAY (%d/%d)", trayCount, trayCapacity); }),
                    {ctrlX, ctrlY}, FS(11.0f), sp, EXT_HEADER_COLOR);
         ctrlY += 20.0f;
 
@@ -2512,7 +2709,7 @@ void RenderManager::DrawProspectingPanel(Unit* unit, int x, int y, int w, int h)
                     s->depthLayer == DepthLayer::SURFACE ? "S" :
                     s->depthLayer == DepthLayer::SHALLOW ? "R" :
                     s->depthLayer == DepthLayer::MID     ? "M" : "B";
-                DrawTextEx(bodyFont, depthChar,
+                DrawCachedText(bodyFont, depthChar,
                            {slot.x + 2, slot.y + slot.height - 12}, FS(8.0f), sp,
                            {255, 255, 255, 160});
 
@@ -2521,7 +2718,7 @@ void RenderManager::DrawProspectingPanel(Unit* unit, int x, int y, int w, int h)
                     s->visual.shapeFamily == ShapeFamily::ANGULAR_CHUNKS ? "A" :
                     s->visual.shapeFamily == ShapeFamily::CRYSTALLINE_SHARDS ? "C" :
                     s->visual.shapeFamily == ShapeFamily::ROUNDED_NODULES ? "N" : "L";
-                DrawTextEx(bodyFont, familyChar,
+                DrawCachedText(bodyFont, familyChar,
                            {slot.x + slot.width - 10, slot.y + 2}, FS(8.0f), sp,
                            {255, 255, 255, 120});
 
@@ -2560,16 +2757,16 @@ void RenderManager::DrawProspectingPanel(Unit* unit, int x, int y, int w, int h)
             int trayRows = (ps->GetTray().GetCapacity() + slotsPerRow - 1) / slotsPerRow;
             float detailY = ctrlY + trayRows * (slotSize + slotGap) + 8.0f;
 
-            DrawTextEx(bodyFont, TextFormat("Depth: %s", ProsDepthName(selSample->depthLayer)),
+            DrawCachedText(bodyFont, TextFormat("Depth: %s", ProsDepthName(selSample->depthLayer)),
                        {ctrlX, detailY}, FS(9.0f), sp, EXT_DIM_TEXT);
             detailY += 14.0f;
-            DrawTextEx(bodyFont, TextFormat("Richness: %.0f%%", selSample->richness * 100.0f),
+            DrawCachedText(bodyFont, TextFormat("Richness: %.0f%%", selSample->richness * 100.0f),
                        {ctrlX, detailY}, FS(9.0f), sp, EXT_DIM_TEXT);
             detailY += 14.0f;
 
             const char* stateStr = selSample->state == SampleState::IN_TRAY ? "In Tray" :
                                    selSample->state == SampleState::PROCESSING ? "Processing" : "Completed";
-            DrawTextEx(bodyFont, TextFormat("State: %s", stateStr),
+            DrawCachedText(bodyFont, TextFormat("State: %s", stateStr),
                        {ctrlX, detailY}, FS(9.0f), sp, EXT_DIM_TEXT);
             detailY += 14.0f;
 
@@ -2585,7 +2782,7 @@ void RenderManager::DrawProspectingPanel(Unit* unit, int x, int y, int w, int h)
                         TextFormat("~%.0f%%", abund * 100.0f) :
                         TextFormat("%.1f%%", abund * 100.0f);
 
-                    DrawTextEx(bodyFont, TextFormat("  %s: %s  conf:%s",
+                    DrawCachedText(bodyFont, TextFormat("  %s: %s  conf:%s",
                         ResourceTypeToString(type), valText, ProsConfLabel(conf)),
                         {ctrlX, detailY}, FS(8.0f), sp, ProsElementColor(type));
                     detailY += 12.0f;
@@ -2601,7 +2798,7 @@ void RenderManager::DrawProspectingPanel(Unit* unit, int x, int y, int w, int h)
         float rightW = pw - leftW - 10.0f;
 
         // Left: sample selection (mini tray)
-        DrawTextEx(headerFont, "SELECT SAMPLE", {px, contentY}, FS(12.0f), sp, EXT_HEADER_COLOR);
+        DrawCachedText(headerFont, "SELECT SAMPLE", {px, contentY}, FS(12.0f), sp, EXT_HEADER_COLOR);
         float trayY = contentY + 20.0f;
         float slotSize = 32.0f;
         float slotGap = 4.0f;
@@ -2651,7 +2848,7 @@ void RenderManager::DrawProspectingPanel(Unit* unit, int x, int y, int w, int h)
         Sample* selSample = (ps->selectedSampleIndex >= 0)
             ? ps->GetTray().GetSampleByIndex(ps->selectedSampleIndex) : nullptr;
 
-        DrawTextEx(headerFont, "ANALYSIS TOOLS", {px, toolY}, FS(12.0f), sp, EXT_HEADER_COLOR);
+        DrawCachedText(headerFont, "ANALYSIS TOOLS", {px, toolY}, FS(12.0f), sp, EXT_HEADER_COLOR);
         toolY += 20.0f;
 
         struct ToolEntry { AnalysisTool tool; const char* name; };
@@ -2676,19 +2873,20 @@ void RenderManager::DrawProspectingPanel(Unit* unit, int x, int y, int w, int h)
             DrawRectangleLinesEx(toolBtn, 1.0f, canApply ? PROS_BTN_BORDER : PROS_BTN_DISABLED);
 
             Color textCol = canApply ? (hover ? PROS_BTN_TEXT_HOVER : PROS_BTN_TEXT) : PROS_BTN_DISABLED;
-            DrawTextEx(bodyFont, TextFormat("%s  %.0fE", te.name, cost),
+            DrawCachedText(bodyFont, TextFormat("%s  %.0fE", te.name, cost),
                        {px + 6, toolY + 4}, FS(9.0f), sp, textCol);
 
             if (hover && canApply && IsMouseButtonPressed(MOUSE_BUTTON_LEFT))
             {
-                ps->GetLab().ApplyTool(*selSample, te.tool, ps->gameTime);
+                SubmitUnitCommand(unit, Command(CommandType::PROSPECT_ANALYSE, ps->selectedSampleIndex,
+                                                      static_cast<int>(te.tool)));
             }
             toolY += 28.0f;
         }
 
         // Separation methods
         toolY += 8.0f;
-        DrawTextEx(headerFont, "SEPARATION", {px, toolY}, FS(12.0f), sp, EXT_HEADER_COLOR);
+        DrawCachedText(headerFont, "SEPARATION", {px, toolY}, FS(12.0f), sp, EXT_HEADER_COLOR);
         toolY += 20.0f;
 
         struct SepEntry { SeparationMethod method; const char* name; };
@@ -2710,39 +2908,40 @@ void RenderManager::DrawProspectingPanel(Unit* unit, int x, int y, int w, int h)
             DrawRectangleLinesEx(sepBtn, 1.0f, canApply ? PROS_BTN_BORDER : PROS_BTN_DISABLED);
 
             Color textCol = canApply ? (hover ? PROS_BTN_TEXT_HOVER : PROS_BTN_TEXT) : PROS_BTN_DISABLED;
-            DrawTextEx(bodyFont, TextFormat("%s  %.0fE", se.name, cost),
+            DrawCachedText(bodyFont, TextFormat("%s  %.0fE", se.name, cost),
                        {px + 6, toolY + 4}, FS(9.0f), sp, textCol);
 
             if (hover && canApply && IsMouseButtonPressed(MOUSE_BUTTON_LEFT))
             {
-                ps->GetLab().ApplySeparation(*selSample, se.method, ps->gameTime);
+                SubmitUnitCommand(unit, Command(CommandType::PROSPECT_SEPARATE, ps->selectedSampleIndex,
+                                                      static_cast<int>(se.method)));
             }
             toolY += 28.0f;
         }
 
         // Right side: selected sample detail + analysis results
-        DrawTextEx(headerFont, "RESULTS", {rightX, contentY}, FS(12.0f), sp, EXT_HEADER_COLOR);
+        DrawCachedText(headerFont, "RESULTS", {rightX, contentY}, FS(12.0f), sp, EXT_HEADER_COLOR);
         float resY = contentY + 22.0f;
 
         if (selSample)
         {
             const char* stateStr = selSample->state == SampleState::IN_TRAY ? "In Tray" :
                                    selSample->state == SampleState::PROCESSING ? "Processing" : "Completed";
-            DrawTextEx(bodyFont, TextFormat("State: %s", stateStr),
+            DrawCachedText(bodyFont, TextFormat("State: %s", stateStr),
                        {rightX, resY}, FS(10.0f), sp, EXT_DIM_TEXT);
             resY += 16.0f;
-            DrawTextEx(bodyFont, TextFormat("Depth: %s", ProsDepthName(selSample->depthLayer)),
+            DrawCachedText(bodyFont, TextFormat("Depth: %s", ProsDepthName(selSample->depthLayer)),
                        {rightX, resY}, FS(10.0f), sp, EXT_DIM_TEXT);
             resY += 16.0f;
-            DrawTextEx(bodyFont, TextFormat("Richness: %.0f%%", selSample->richness * 100.0f),
+            DrawCachedText(bodyFont, TextFormat("Richness: %.0f%%", selSample->richness * 100.0f),
                        {rightX, resY}, FS(10.0f), sp, EXT_DIM_TEXT);
             resY += 16.0f;
-            DrawTextEx(bodyFont, TextFormat("Analyses: %d", static_cast<int>(selSample->analysisHistory.size())),
+            DrawCachedText(bodyFont, TextFormat("Analyses: %d", static_cast<int>(selSample->analysisHistory.size())),
                        {rightX, resY}, FS(10.0f), sp, EXT_DIM_TEXT);
             resY += 20.0f;
 
             // Element composition with confidence
-            DrawTextEx(headerFont, "COMPOSITION", {rightX, resY}, FS(11.0f), sp, EXT_HEADER_COLOR);
+            DrawCachedText(headerFont, "COMPOSITION", {rightX, resY}, FS(11.0f), sp, EXT_HEADER_COLOR);
             resY += 18.0f;
 
             for (const auto& [type, abundance] : selSample->trueComposition)
@@ -2755,7 +2954,7 @@ void RenderManager::DrawProspectingPanel(Unit* unit, int x, int y, int w, int h)
                 Color elemCol = ProsElementColor(type);
                 if (conf < 0.01f)
                 {
-                    DrawTextEx(bodyFont, "  ???",
+                    DrawCachedText(bodyFont, "  ???",
                                {rightX, resY}, FS(9.0f), sp, {80, 80, 100, 255});
                 }
                 else
@@ -2764,7 +2963,7 @@ void RenderManager::DrawProspectingPanel(Unit* unit, int x, int y, int w, int h)
                     float barH = 10.0f;
                     float barX = rightX + 60.0f;
 
-                    DrawTextEx(bodyFont, ResourceTypeToString(type),
+                    DrawCachedText(bodyFont, ResourceTypeToString(type),
                                {rightX, resY}, FS(9.0f), sp, elemCol);
 
                     // Background bar
@@ -2786,9 +2985,9 @@ void RenderManager::DrawProspectingPanel(Unit* unit, int x, int y, int w, int h)
                     else
                         valText = TextFormat("%.1f%%", abundance * 100.0f);
 
-                    DrawTextEx(bodyFont, valText,
+                    DrawCachedText(bodyFont, valText,
                                {barX + barW + 4, resY}, FS(9.0f), sp, WHITE);
-                    DrawTextEx(bodyFont, TextFormat("[%.0f%%]", conf * 100.0f),
+                    DrawCachedText(bodyFont, TextFormat("[%.0f%%]", conf * 100.0f),
                                {barX + barW + 50.0f, resY}, FS(8.0f), sp, EXT_DIM_TEXT);
                 }
                 resY += 16.0f;
@@ -2798,7 +2997,7 @@ void RenderManager::DrawProspectingPanel(Unit* unit, int x, int y, int w, int h)
             if (!selSample->analysisHistory.empty())
             {
                 resY += 8.0f;
-                DrawTextEx(headerFont, "HISTORY", {rightX, resY}, FS(10.0f), sp, EXT_HEADER_COLOR);
+                DrawCachedText(headerFont, "HISTORY", {rightX, resY}, FS(10.0f), sp, EXT_HEADER_COLOR);
                 resY += 16.0f;
 
                 for (const auto& entry : selSample->analysisHistory)
@@ -2815,7 +3014,7 @@ void RenderManager::DrawProspectingPanel(Unit* unit, int x, int y, int w, int h)
                         default: break;
                     }
 
-                    DrawTextEx(bodyFont, TextFormat("  %s", toolName),
+                    DrawCachedText(bodyFont, TextFormat("  %s", toolName),
                                {rightX, resY}, FS(8.0f), sp, EXT_DIM_TEXT);
                     resY += 12.0f;
 
@@ -2825,7 +3024,7 @@ void RenderManager::DrawProspectingPanel(Unit* unit, int x, int y, int w, int h)
         }
         else
         {
-            DrawTextEx(bodyFont, "Select a sample to analyze.",
+            DrawCachedText(bodyFont, "Select a sample to analyze.",
                        {rightX, resY}, FS(10.0f), sp, EXT_DIM_TEXT);
         }
     }
@@ -2836,25 +3035,29 @@ void RenderManager::DrawProspectingPanel(Unit* unit, int x, int y, int w, int h)
     bottomY += 8.0f;
 
     CellSurveyResult sr = SurveyProgressEngine::Calculate(ps->GetGrid(), ps->GetTray());
-    DrawTextEx(bodyFont, TextFormat("Sweep: %.0f%%", sr.sweepConfidence * 100.0f),
+    DrawCachedText(bodyFont, textCache.Format("Sweep: %.0f%%", 0, {sr.sweepConfidence},
+                                              [&] { return TextFormat("Sweep: %.0f%%", sr.sweepConfidence * 100.0f); }),
                {px, bottomY}, FS(9.0f), sp, EXT_DIM_TEXT);
-    DrawTextEx(bodyFont, TextFormat("Sample: %.0f%%", sr.sampleConfidence * 100.0f),
+    DrawCachedText(bodyFont, textCache.Format("Sample: %.0f%%", 0, {sr.sampleConfidence},
+                                              [&] { return TextFormat("Sample: %.0f%%", sr.sampleConfidence * 100.0f); }),
                {px + pw * 0.33f, bottomY}, FS(9.0f), sp, EXT_DIM_TEXT);
-    DrawTextEx(bodyFont, TextFormat("Testing: %.0f%%", sr.testingConfidence * 100.0f),
+    DrawCachedText(bodyFont, textCache.Format("Testing: %.0f%%", 0, {sr.testingConfidence},
+                                              [&] { return TextFormat("Testing: %.0f%%", sr.testingConfidence * 100.0f); }),
                {px + pw * 0.66f, bottomY}, FS(9.0f), sp, EXT_DIM_TEXT);
     bottomY += 14.0f;
 
     bool marked = ps->IsMarkedSite();
-    DrawTextEx(bodyFont, marked ? "MARKED SITE" : "Unmarked",
+    DrawCachedText(bodyFont, marked ? "MARKED SITE" : "Unmarked",
                {px, bottomY}, FS(9.0f), sp, marked ? EXT_ACCENT_GREEN : EXT_DIM_TEXT);
 
     float calQ = ps->GetSweep().GetCalibrationQuality();
-    DrawTextEx(bodyFont, TextFormat("Cal: %.0f%%", calQ * 100.0f),
+    DrawCachedText(bodyFont, textCache.Format("Cal: %.0f%%", 0, {calQ},
+                                              [&] { return TextFormat("Cal: %.0f%%", calQ * 100.0f); }),
                {px + pw * 0.33f, bottomY}, FS(9.0f), sp,
                calQ >= 0.8f ? EXT_ACCENT_GREEN : PROS_MSG_ALERT);
 
     int tier = ps->GetTier();
-    DrawTextEx(bodyFont, TextFormat("Tier %d", tier),
+    DrawCachedText(bodyFont, TextFormat("Tier %d", tier),
                {px + pw * 0.66f, bottomY}, FS(9.0f), sp, EXT_ACCENT_CYAN);
 }
 
@@ -2869,11 +3072,13 @@ void RenderManager::DrawExcavationPanel(Unit* unit, int x, int y, int w, int h)
     float px = static_cast<float>(x + padding);
     Vector2 mousePos = GetMousePosition();
 
-    DrawTextEx(headerFont, "EXCAVATION FLEET", {px, yPos}, FS(18.0f), sp, EXT_HEADER_COLOR);
+    DrawCachedText(headerFont, "EXCAVATION FLEET", {px, yPos}, FS(18.0f), sp, EXT_HEADER_COLOR);
     yPos += 28.0f;
 
     // Total stats
-    DrawTextEx(bodyFont, TextFormat("Total Regolith Extracted: %.1f kg", unit->GetTotalRegolithExtracted()),
+    float totalExtracted = unit->GetTotalRegolithExtracted();
+    DrawCachedText(bodyFont, textCache.Format("Total Regolith Extracted: %.1f kg", 0, {totalExtracted},
+                                              [&] { return TextFormat("Total Regolith Extracted: %.1f kg", totalExtracted); }),
                {px, yPos}, FS(14.0f), sp, EXT_ACCENT_CYAN);
     yPos += 25.0f;
 
@@ -2881,7 +3086,7 @@ void RenderManager::DrawExcavationPanel(Unit* unit, int x, int y, int w, int h)
     const auto& excavators = unit->GetExcavators();
     if (excavators.empty())
     {
-        DrawTextEx(bodyFont, "No excavators deployed", {px, yPos}, FS(13.0f), sp, EXT_DIM_TEXT);
+        DrawCachedText(bodyFont, "No excavators deployed", {px, yPos}, FS(13.0f), sp, EXT_DIM_TEXT);
         return;
     }
 
@@ -2890,7 +3095,7 @@ void RenderManager::DrawExcavationPanel(Unit* unit, int x, int y, int w, int h)
     float maxDepth = 10.0f;
     for (const auto& mod : unit->GetModules())
     {
-        if (mod.moduleType == "EXCAVATION")
+        if (mod.kind == ModuleKind::EXCAVATION)
         {
             excTier = mod.tier;
             float tierMaxDepths[] = {10.0f, 30.0f, 100.0f, 300.0f};
@@ -2903,11 +3108,11 @@ void RenderManager::DrawExcavationPanel(Unit* unit, int x, int y, int w, int h)
     float rateStep = 5.0f;
 
     // Table header
-    DrawTextEx(bodyFont, "ID", {px, yPos}, FS(12.0f), sp, EXT_DIM_TEXT);
-    DrawTextEx(bodyFont, "Method", {px + 40.0f, yPos}, FS(12.0f), sp, EXT_DIM_TEXT);
-    DrawTextEx(bodyFont, "Depth", {px + 140.0f, yPos}, FS(12.0f), sp, EXT_DIM_TEXT);
-    DrawTextEx(bodyFont, "Rate", {px + 270.0f, yPos}, FS(12.0f), sp, EXT_DIM_TEXT);
-    DrawTextEx(bodyFont, "Wear", {px + 380.0f, yPos}, FS(12.0f), sp, EXT_DIM_TEXT);
+    DrawCachedText(bodyFont, "ID", {px, yPos}, FS(12.0f), sp, EXT_DIM_TEXT);
+    DrawCachedText(bodyFont, "Method", {px + 40.0f, yPos}, FS(12.0f), sp, EXT_DIM_TEXT);
+    DrawCachedText(bodyFont, "Depth", {px + 140.0f, yPos}, FS(12.0f), sp, EXT_DIM_TEXT);
+    DrawCachedText(bodyFont, "Rate", {px + 270.0f, yPos}, FS(12.0f), sp, EXT_DIM_TEXT);
+    DrawCachedText(bodyFont, "Wear", {px + 380.0f, yPos}, FS(12.0f), sp, EXT_DIM_TEXT);
     yPos += 18.0f;
 
     DrawLine(static_cast<int>(px), static_cast<int>(yPos),
@@ -2920,8 +3125,8 @@ void RenderManager::DrawExcavationPanel(Unit* unit, int x, int y, int w, int h)
 
     for (const auto& exc : excavators)
     {
-        DrawTextEx(bodyFont, TextFormat("#%d", exc.id), {px, yPos}, FS(12.0f), sp, LIGHTGRAY);
-        DrawTextEx(bodyFont, exc.method.c_str(), {px + 40.0f, yPos}, FS(12.0f), sp, LIGHTGRAY);
+        DrawCachedText(bodyFont, TextFormat("#%d", exc.id), {px, yPos}, FS(12.0f), sp, LIGHTGRAY);
+        DrawCachedText(bodyFont, exc.method.c_str(), {px + 40.0f, yPos}, FS(12.0f), sp, LIGHTGRAY);
 
         // --- Depth [-] value [+] ---
         float depthX = px + 140.0f;
@@ -2932,29 +3137,29 @@ void RenderManager::DrawExcavationPanel(Unit* unit, int x, int y, int w, int h)
         Color minusBg = CheckCollisionPointRec(mousePos, depthMinus) ? Color{60, 60, 80, 255} : Color{40, 40, 55, 255};
         DrawRectangleRec(depthMinus, minusBg);
         DrawRectangleLinesEx(depthMinus, 1.0f, EXT_PANEL_BORDER);
-        DrawTextEx(bodyFont, "-", {depthX + 6.0f, yPos}, FS(12.0f), sp, WHITE);
+        DrawCachedText(bodyFont, "-", {depthX + 6.0f, yPos}, FS(12.0f), sp, WHITE);
 
         if (CheckCollisionPointRec(mousePos, depthMinus) && IsMouseButtonPressed(MOUSE_BUTTON_LEFT))
         {
-            unit->SetExcavatorDepth(exc.id, exc.depth - depthStep);
+            SubmitUnitCommand(unit, Command(CommandType::SET_EXCAVATOR_DEPTH, exc.id, 0, 0, exc.depth - depthStep));
         }
 
         // Value
-        DrawTextEx(bodyFont, TextFormat("%.0f cm", exc.depth), {depthX + 24.0f, yPos}, FS(12.0f), sp, LIGHTGRAY);
+        DrawCachedText(bodyFont, TextFormat("%.0f cm", exc.depth), {depthX + 24.0f, yPos}, FS(12.0f), sp, LIGHTGRAY);
 
         // [+] button
         Color plusBg = CheckCollisionPointRec(mousePos, depthPlus) ? Color{60, 60, 80, 255} : Color{40, 40, 55, 255};
         DrawRectangleRec(depthPlus, plusBg);
         DrawRectangleLinesEx(depthPlus, 1.0f, EXT_PANEL_BORDER);
-        DrawTextEx(bodyFont, "+", {depthX + 96.0f, yPos}, FS(12.0f), sp, WHITE);
+        DrawCachedText(bodyFont, "+", {depthX + 96.0f, yPos}, FS(12.0f), sp, WHITE);
 
         if (CheckCollisionPointRec(mousePos, depthPlus) && IsMouseButtonPressed(MOUSE_BUTTON_LEFT))
         {
-            unit->SetExcavatorDepth(exc.id, exc.depth + depthStep);
+            SubmitUnitCommand(unit, Command(CommandType::SET_EXCAVATOR_DEPTH, exc.id, 0, 0, exc.depth + depthStep));
         }
 
         // Max depth label
-        DrawTextEx(bodyFont, TextFormat("/ %.0f", maxDepth), {depthX + 114.0f, yPos}, FS(10.0f), sp, EXT_DIM_TEXT);
+        DrawCachedText(bodyFont, TextFormat("/ %.0f", maxDepth), {depthX + 114.0f, yPos}, FS(10.0f), sp, EXT_DIM_TEXT);
 
         // --- Rate [-] value [+] ---
         float rateX = px + 270.0f;
@@ -2965,25 +3170,25 @@ void RenderManager::DrawExcavationPanel(Unit* unit, int x, int y, int w, int h)
         Color rMinBg = CheckCollisionPointRec(mousePos, rateMinus) ? Color{60, 60, 80, 255} : Color{40, 40, 55, 255};
         DrawRectangleRec(rateMinus, rMinBg);
         DrawRectangleLinesEx(rateMinus, 1.0f, EXT_PANEL_BORDER);
-        DrawTextEx(bodyFont, "-", {rateX + 6.0f, yPos}, FS(12.0f), sp, WHITE);
+        DrawCachedText(bodyFont, "-", {rateX + 6.0f, yPos}, FS(12.0f), sp, WHITE);
 
         if (CheckCollisionPointRec(mousePos, rateMinus) && IsMouseButtonPressed(MOUSE_BUTTON_LEFT))
         {
-            unit->SetExcavatorRate(exc.id, exc.rate - rateStep);
+            SubmitUnitCommand(unit, Command(CommandType::SET_EXCAVATOR_RATE, exc.id, 0, 0, exc.rate - rateStep));
         }
 
         // Value
-        DrawTextEx(bodyFont, TextFormat("%.0f", exc.rate), {rateX + 24.0f, yPos}, FS(12.0f), sp, LIGHTGRAY);
+        DrawCachedText(bodyFont, TextFormat("%.0f", exc.rate), {rateX + 24.0f, yPos}, FS(12.0f), sp, LIGHTGRAY);
 
         // [+] button
         Color rPlsBg = CheckCollisionPointRec(mousePos, ratePlus) ? Color{60, 60, 80, 255} : Color{40, 40, 55, 255};
         DrawRectangleRec(ratePlus, rPlsBg);
         DrawRectangleLinesEx(ratePlus, 1.0f, EXT_PANEL_BORDER);
-        DrawTextEx(bodyFont, "+", {rateX + 91.0f, yPos}, FS(12.0f), sp, WHITE);
+        DrawCachedText(bodyFont, "+", {rateX + 91.0f, yPos}, FS(12.0f), sp, WHITE);
 
         if (CheckCollisionPointRec(mousePos, ratePlus) && IsMouseButtonPressed(MOUSE_BUTTON_LEFT))
         {
-            unit->SetExcavatorRate(exc.id, exc.rate + rateStep);
+            SubmitUnitCommand(unit, Command(CommandType::SET_EXCAVATOR_RATE, exc.id, 0, 0, exc.rate + rateStep));
         }
 
         // Wear bar
@@ -2998,9 +3203,10 @@ void RenderManager::DrawExcavationPanel(Unit* unit, int x, int y, int w, int h)
              static_cast<int>(px + w - padding * 2), static_cast<int>(yPos), EXT_PANEL_BORDER);
     yPos += 8.0f;
 
-    DrawTextEx(headerFont, TextFormat("Total Rate: %.1f kg/hr", totalRate),
+    DrawCachedText(headerFont, textCache.Format("Total Rate: %.1f kg/hr", 0, {totalRate},
+                                                [&] { return TextFormat("Total Rate: %.1f kg/hr", totalRate); }),
                {px, yPos}, FS(14.0f), sp, EXT_ACCENT_GREEN);
-    DrawTextEx(bodyFont, TextFormat("Fleet Size: %d", static_cast<int>(excavators.size())),
+    DrawCachedText(bodyFont, TextFormat("Fleet Size: %d", static_cast<int>(excavators.size())),
                {px + 250.0f, yPos}, FS(13.0f), sp, LIGHTGRAY);
 }
 
@@ -3015,13 +3221,13 @@ void RenderManager::DrawBeneficiationPanel(Unit* unit, int x, int y, int w, int
     float px = static_cast<float>(x + padding);
     Vector2 mousePos = GetMousePosition();
 
-    DrawTextEx(headerFont, "SEPARATION CHAIN", {px, yPos}, FS(18.0f), sp, EXT_HEADER_COLOR);
+    DrawCachedText(headerFont, "SEPARATION CHAIN", {px, yPos}, FS(18.0f), sp, EXT_HEADER_COLOR);
     yPos += 28.0f;
 
     const auto& chain = unit->GetSeparationChain();
     if (chain.empty())
     {
-        DrawTextEx(bodyFont, "No separation nodes configured", {px, yPos}, FS(13.0f), sp, EXT_DIM_TEXT);
+        DrawCachedText(bodyFont, "No separation nodes configured", {px, yPos}, FS(13.0f), sp, EXT_DIM_TEXT);
         return;
     }
 
@@ -3060,7 +3266,7 @@ void RenderManager::DrawBeneficiationPanel(Unit* unit, int x, int y, int w, int
 
             if (CheckCollisionPointRec(mousePos, upBtn) && IsMouseButtonPressed(MOUSE_BUTTON_LEFT))
             {
-                unit->SwapSeparationNodes(static_cast<int>(i), static_cast<int>(i) - 1);
+                SubmitUnitCommand(unit, Command(CommandType::SWAP_SEPARATION_NODES, static_cast<int>(i), static_cast<int>(i) - 1));
             }
         }
 
@@ -3081,14 +3287,14 @@ void RenderManager::DrawBeneficiationPanel(Unit* unit, int x, int y, int w, int
 
             if (CheckCollisionPointRec(mousePos, downBtn) && IsMouseButtonPressed(MOUSE_BUTTON_LEFT))
             {
-                unit->SwapSeparationNodes(static_cast<int>(i), static_cast<int>(i) + 1);
+                SubmitUnitCommand(unit, Command(CommandType::SWAP_SEPARATION_NODES, static_cast<int>(i), static_cast<int>(i) + 1));
             }
         }
 
         // Node type name
         const char* typeNames[] = {"SIZE SORT", "MAGNETIC", "ELECTROSTATIC", "THERMAL", "CHEMICAL", "MRE", "DIRECT OUTPUT"};
         int typeIdx = static_cast<int>(node.type);
-        DrawTextEx(bodyFont, typeNames[typeIdx], {px + 10.0f, yPos + 5.0f}, FS(14.0f), sp, WHITE);
+        DrawCachedText(bodyFont, typeNames[typeIdx], {px + 10.0f, yPos + 5.0f}, FS(14.0f), sp, WHITE);
 
         // --- Clickable ON/OFF toggle ---
         Color activeColor = node.isActive ? EXT_ACCENT_GREEN : EXT_DIM_TEXT;
@@ -3098,40 +3304,40 @@ void RenderManager::DrawBeneficiationPanel(Unit* unit, int x, int y, int w, int
         Color toggleBg = CheckCollisionPointRec(mousePos, toggleBtn) ? Color{50, 55, 70, 255} : Color{30, 35, 50, 255};
         DrawRectangleRec(toggleBtn, toggleBg);
         DrawRectangleLinesEx(toggleBtn, 1.0f, activeColor);
-        DrawTextEx(bodyFont, statusText, {statusX + 5.0f, yPos + 5.0f}, FS(12.0f), sp, activeColor);
+        DrawCachedText(bodyFont, statusText, {statusX + 5.0f, yPos + 5.0f}, FS(12.0f), sp, activeColor);
 
         if (CheckCollisionPointRec(mousePos, toggleBtn) && IsMouseButtonPressed(MOUSE_BUTTON_LEFT))
         {
-            unit->ToggleSeparationNodeActive(static_cast<int>(i));
+            SubmitUnitCommand(unit, Command(CommandType::TOGGLE_SEPARATION_NODE, static_cast<int>(i)));
         }
 
         // Efficiency bar
-        DrawTextEx(bodyFont, "Eff:", {px + 10.0f, yPos + 25.0f}, FS(11.0f), sp, EXT_DIM_TEXT);
+        DrawCachedText(bodyFont, "Eff:", {px + 10.0f, yPos + 25.0f}, FS(11.0f), sp, EXT_DIM_TEXT);
         DrawStyledBar(px + 40.0f, yPos + 25.0f, 120.0f, 12.0f, node.efficiency, EXT_ACCENT_CYAN);
-        DrawTextEx(bodyFont, TextFormat("%.0f%%", node.efficiency * 100.0f),
+        DrawCachedText(bodyFont, TextFormat("%.0f%%", node.efficiency * 100.0f),
                    {px + 165.0f, yPos + 24.0f}, FS(11.0f), sp, LIGHTGRAY);
 
         // Wear bar
-        DrawTextEx(bodyFont, "Wear:", {px + 210.0f, yPos + 25.0f}, FS(11.0f), sp, EXT_DIM_TEXT);
+        DrawCachedText(bodyFont, "Wear:", {px + 210.0f, yPos + 25.0f}, FS(11.0f), sp, EXT_DIM_TEXT);
         DrawWearBar(px + 250.0f, yPos + 25.0f, 80.0f, 12.0f, node.wear);
-        DrawTextEx(bodyFont, TextFormat("%.0f%%", node.wear * 100.0f),
+        DrawCachedText(bodyFont, TextFormat("%.0f%%", node.wear * 100.0f),
                    {px + 335.0f, yPos + 24.0f}, FS(11.0f), sp, LIGHTGRAY);
 
         // Energy & temperature
-        DrawTextEx(bodyFont, TextFormat("Energy: %.0f kW", node.energyConsumption),
+        DrawCachedText(bodyFont, TextFormat("Energy: %.0f kW", node.energyConsumption),
                    {px + 10.0f, yPos + 45.0f}, FS(11.0f), sp, LIGHTGRAY);
 
         if (node.temperature > 25.0f)
         {
             Color tempColor = node.temperature > 500.0f ? Color{255, 150, 50, 255} : LIGHTGRAY;
-            DrawTextEx(bodyFont, TextFormat("Temp: %.0f C", node.temperature),
+            DrawCachedText(bodyFont, TextFormat("Temp: %.0f C", node.temperature),
                        {px + 150.0f, yPos + 45.0f}, FS(11.0f), sp, tempColor);
         }
 
         // Waste ratio
         if (node.wasteRatio > 0)
         {
-            DrawTextEx(bodyFont, TextFormat("Waste: %.0f%%", node.wasteRatio * 100.0f),
+            DrawCachedText(bodyFont, TextFormat("Waste: %.0f%%", node.wasteRatio * 100.0f),
                        {px + 300.0f, yPos + 45.0f}, FS(11.0f), sp, Color{255, 100, 100, 255});
         }
 
@@ -3163,22 +3369,22 @@ void RenderManager::DrawOperationsPanel(Unit* unit, int x, int y, int w, int h)
     float yPos = static_cast<float>(y + padding);
     float px = static_cast<float>(x + padding);
 
-    DrawTextEx(headerFont, "OPERATIONS MANAGEMENT", {px, yPos}, FS(18.0f), sp, EXT_HEADER_COLOR);
+    DrawCachedText(headerFont, "OPERATIONS MANAGEMENT", {px, yPos}, FS(18.0f), sp, EXT_HEADER_COLOR);
     yPos += 35.0f;
 
     // Efficiency modifier display
     float effMod = unit->GetOperationsEfficiencyModifier();
     bool isOpsActive = unit->IsOperationsActive();
 
-    DrawTextEx(bodyFont, "Operations Status:", {px, yPos}, FS(14.0f), sp, LIGHTGRAY);
+    DrawCachedText(bodyFont, "Operations Status:", {px, yPos}, FS(14.0f), sp, LIGHTGRAY);
     yPos += 22.0f;
 
     Color activeColor = isOpsActive ? EXT_ACCENT_GREEN : EXT_DIM_TEXT;
-    DrawTextEx(headerFont, isOpsActive ? "ACTIVE" : "INACTIVE", {px, yPos}, FS(20.0f), sp, activeColor);
+    DrawCachedText(headerFont, isOpsActive ? "ACTIVE" : "INACTIVE", {px, yPos}, FS(20.0f), sp, activeColor);
     yPos += 35.0f;
 
     // Large efficiency display
-    DrawTextEx(bodyFont, "Efficiency Modifier:", {px, yPos}, FS(14.0f), sp, LIGHTGRAY);
+    DrawCachedText(bodyFont, "Efficiency Modifier:", {px, yPos}, FS(14.0f), sp, LIGHTGRAY);
     yPos += 22.0f;
 
     Color effColor;
@@ -3186,7 +3392,7 @@ void RenderManager::DrawOperationsPanel(Unit* unit, int x, int y, int w, int h)
     else if (effMod > 1.0f) effColor = EXT_ACCENT_GREEN;
     else effColor = WHITE;
 
-    DrawTextEx(headerFont, TextFormat("x%.2f", effMod), {px, yPos}, FS(36.0f), sp, effColor);
+    DrawCachedText(headerFont, TextFormat("x%.2f", effMod), {px, yPos}, FS(36.0f), sp, effColor);
     yPos += 50.0f;
 
     // Tier description
@@ -3200,7 +3406,7 @@ void RenderManager::DrawOperationsPanel(Unit* unit, int x, int y, int w, int h)
         "Tier 3: AI scheduling\n  +20% efficiency bonus"
     };
 
-    DrawTextEx(bodyFont, tierDescs[std::min(mod.tier, 3)], {px, yPos}, FS(13.0f), sp, LIGHTGRAY);
+    DrawCachedText(bodyFont, tierDescs[std::min(mod.tier, 3)], {px, yPos}, FS(13.0f), sp, LIGHTGRAY);
     yPos += 40.0f;
 
     // Survey coverage bonus from prospecting system
@@ -3210,9 +3416,9 @@ void RenderManager::DrawOperationsPanel(Unit* unit, int x, int y, int w, int h)
     Color confColor = confidence >= 0.8f ? EXT_ACCENT_GREEN :
                       confidence >= 0.4f ? YELLOW : RED;
 
-    DrawTextEx(bodyFont, "Survey Coverage Bonus:", {px, yPos}, FS(13.0f), sp, LIGHTGRAY);
+    DrawCachedText(bodyFont, "Survey Coverage Bonus:", {px, yPos}, FS(13.0f), sp, LIGHTGRAY);
     yPos += 20.0f;
-    DrawTextEx(headerFont, TextFormat("+%.1f%%  (%.0f%% surveyed)",
+    DrawCachedText(headerFont, TextFormat("+%.1f%%  (%.0f%% surveyed)",
                confBonus * 100.0f, confidence * 100.0f),
                {px, yPos}, FS(16.0f), sp, confColor);
 }
@@ -3228,7 +3434,7 @@ void RenderManager::DrawDirectivesPanel(Unit* unit, int x, int y, int w, int h)
     float px = static_cast<float>(x + padding);
     Vector2 mousePos = GetMousePosition();
 
-    DrawTextEx(headerFont, "ACTIVE DIRECTIVES", {px, yPos}, FS(18.0f), sp, EXT_HEADER_COLOR);
+    DrawCachedText(headerFont, "ACTIVE DIRECTIVES", {px, yPos}, FS(18.0f), sp, EXT_HEADER_COLOR);
     yPos += 28.0f;
 
     const auto& directive = unit->GetDirective();
@@ -3249,9 +3455,9 @@ void RenderManager::DrawDirectivesPanel(Unit* unit, int x, int y, int w, int h)
 
     // Current directive display
     int dirIdx = static_cast<int>(directive.type);
-    DrawTextEx(bodyFont, "Current:", {px, yPos}, FS(13.0f), sp, LIGHTGRAY);
+    DrawCachedText(bodyFont, "Current:", {px, yPos}, FS(13.0f), sp, LIGHTGRAY);
     Color dirColor = (dirIdx == 0) ? EXT_DIM_TEXT : EXT_ACCENT_GOLD;
-    DrawTextEx(headerFont, directiveNames[dirIdx], {px + 65.0f, yPos - 2.0f}, FS(16.0f), sp, dirColor);
+    DrawCachedText(headerFont, directiveNames[dirIdx], {px + 65.0f, yPos - 2.0f}, FS(16.0f), sp, dirColor);
     yPos += 22.0f;
 
     // Target resource for PRIORITIZE
@@ -3259,7 +3465,7 @@ void RenderManager::DrawDirectivesPanel(Unit* unit, int x, int y, int w, int h)
     {
         std::string resName = ResourceUtils::GetResourceName(directive.targetResource);
         Color resColor = ResourceUtils::GetResourceColor(directive.targetResource);
-        DrawTextEx(bodyFont, TextFormat("Target: %s", resName.c_str()), {px, yPos}, FS(13.0f), sp, resColor);
+        DrawCachedText(bodyFont, TextFormat("Target: %s", resName.c_str()), {px, yPos}, FS(13.0f), sp, resColor);
         yPos += 18.0f;
     }
 
@@ -3270,7 +3476,7 @@ void RenderManager::DrawDirectivesPanel(Unit* unit, int x, int y, int w, int h)
     bool directivesActive = false;
     for (const auto& mod : unit->GetModules())
     {
-        if (mod.moduleType == "DIRECTIVES" && mod.isActive)
+        if (mod.kind == ModuleKind::DIRECTIVES && mod.isActive)
         {
             directivesTier = mod.tier;
             directivesActive = true;
@@ -3278,7 +3484,7 @@ void RenderManager::DrawDirectivesPanel(Unit* unit, int x, int y, int w, int h)
         }
     }
 
-    DrawTextEx(headerFont, "AVAILABLE DIRECTIVES", {px, yPos}, FS(14.0f), sp, EXT_HEADER_COLOR);
+    DrawCachedText(headerFont, "AVAILABLE DIRECTIVES", {px, yPos}, FS(14.0f), sp, EXT_HEADER_COLOR);
     yPos += 20.0f;
 
     // Directive cards
@@ -3326,16 +3532,16 @@ void RenderManager::DrawDirectivesPanel(Unit* unit, int x, int y, int w, int h)
 
         // Directive name
         Color nameColor = isUnlocked ? WHITE : EXT_DIM_TEXT;
-        DrawTextEx(bodyFont, directiveNames[d], {px + 10.0f, yPos + 5.0f}, FS(13.0f), sp, nameColor);
+        DrawCachedText(bodyFont, directiveNames[d], {px + 10.0f, yPos + 5.0f}, FS(13.0f), sp, nameColor);
 
         // Description
         Color descColor = isUnlocked ? LIGHTGRAY : Color{80, 80, 90, 255};
-        DrawTextEx(bodyFont, directiveDescs[d], {px + 10.0f, yPos + 22.0f}, FS(10.0f), sp, descColor);
+        DrawCachedText(bodyFont, directiveDescs[d], {px + 10.0f, yPos + 22.0f}, FS(10.0f), sp, descColor);
 
         // Tier requirement label for locked
         if (!isUnlocked)
         {
-            DrawTextEx(bodyFont, TextFormat("Tier %d", minTierRequired[d]),
+            DrawCachedText(bodyFont, TextFormat("Tier %d", minTierRequired[d]),
                        {px + cardW - 50.0f, yPos + 12.0f}, FS(11.0f), sp, EXT_DIM_TEXT);
         }
 
@@ -3343,11 +3549,8 @@ void RenderManager::DrawDirectivesPanel(Unit* unit, int x, int y, int w, int h)
         if (isUnlocked && !isCurrentDirective &&
             CheckCollisionPointRec(mousePos, card) && IsMouseButtonPressed(MOUSE_BUTTON_LEFT))
         {
-            Unit::ActiveDirective newDir;
-            newDir.type = dType;
-            newDir.targetResource = ResourceType::Fe;
-            newDir.strength = 1.0f;
-            unit->SetDirective(newDir);
+            SubmitUnitCommand(unit, Command(CommandType::SET_DIRECTIVE, static_cast<int>(dType),
+                                                  static_cast<int>(ResourceType::Fe), 0, 1.0f));
         }
 
         yPos += cardH + 3.0f;
@@ -3357,7 +3560,7 @@ void RenderManager::DrawDirectivesPanel(Unit* unit, int x, int y, int w, int h)
     if (directive.type == Unit::DirectiveType::PRIORITIZE)
     {
         yPos += 8.0f;
-        DrawTextEx(headerFont, "TARGET RESOURCE", {px, yPos}, FS(13.0f), sp, EXT_HEADER_COLOR);
+        DrawCachedText(headerFont, "TARGET RESOURCE", {px, yPos}, FS(13.0f), sp, EXT_HEADER_COLOR);
         yPos += 18.0f;
 
         ResourceType resources[] = {
@@ -3394,15 +3597,12 @@ void RenderManager::DrawDirectivesPanel(Unit* unit, int x, int y, int w, int h)
 
             Color labelColor = isSelected ? EXT_ACCENT_GOLD :
                                ResourceUtils::GetResourceColor(resources[r]);
-            DrawTextEx(bodyFont, resLabels[r], {chipX + 8.0f, yPos + 5.0f}, FS(12.0f), sp, labelColor);
+            DrawCachedText(bodyFont, resLabels[r], {chipX + 8.0f, yPos + 5.0f}, FS(12.0f), sp, labelColor);
 
             if (CheckCollisionPointRec(mousePos, chip) && IsMouseButtonPressed(MOUSE_BUTTON_LEFT))
             {
-                Unit::ActiveDirective newDir;
-                newDir.type = Unit::DirectiveType::PRIORITIZE;
-                newDir.targetResource = resources[r];
-                newDir.strength = 1.0f;
-                unit->SetDirective(newDir);
+                SubmitUnitCommand(unit, Command(CommandType::SET_DIRECTIVE, static_cast<int>(Unit::DirectiveType::PRIORITIZE),
+                                                      static_cast<int>(resources[r]), 0, 1.0f));
             }
 
             chipX += chipW + 4.0f;
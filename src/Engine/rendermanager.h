@@ -10,7 +10,11 @@
 #include "time_manager.h"
 #include "inputmanager.h"
 #include "transport_types.h"
+#include "packet_renderer.h"
+#include "sect_renderer.h"
+#include "text_run_cache.h"
 #include "game_enums.h"
+#include "command.h"
 #include <vector>
 #include <string>
 
@@ -34,6 +38,9 @@ public:
     void DrawSectView(Sect* sect, TimeManager& timeManager);
     void DrawUnitView(Unit* unit, TimeManager& timeManager);
 
+    // Day counter / pause banner, top centre
+    void DrawTimeHud(const TimeManager& timeManager);
+
     void DrawCellInfo(Vector2 mousePosition, Camera2D camera, Planet* planet, std::vector<Colony*>& colonies);
     void DrawPlusIndicator(Vector2 mousePos, View currentView);
 
@@ -42,10 +49,19 @@ public:
                                TimeManager& timeManager);
 
     // Transport visualization
+    void SetSimAlpha(float alpha) { simAlpha = alpha; }   // SimScheduler::GetAlpha(), per frame
     void DrawRoads(Colony* colony, Road* selectedRoad = nullptr);
     void DrawTransportPackets(Colony* colony);
     void DrawRoadInfoPanel(Road* selectedRoad, Colony* colony);
 
+    // Where button actions go (GameManager). Without one, as in the view
+    // previews, they act on the objects directly.
+    void SetCommandSink(CommandSink* sink) { commands = sink; }
+
+    // Text-run cache stats overlay (unit view bottom bar)
+    void ToggleTextCacheStats() { showTextCacheStats = !showTextCacheStats; }
+    const TextRunCache::Stats& GetTextCacheStats() const { return textCache.GetFrameStats(); }
+
 private:
     int screenWidth;
     int screenHeight;
@@ -58,6 +74,14 @@ private:
     // Font size multiplier (XL preset: 1.30x)
     float FS(float baseSize);
 
+    // Laid-out text for the extraction panels; drop-in for DrawTextEx /
+    // MeasureTextEx that reuses glyph runs across frames.
+    TextRunCache textCache;
+    bool showTextCacheStats;
+    void DrawCachedText(const Font& font, const char* text, Vector2 position,
+                        float fontSize, float spacing, Color tint);
+    Vector2 MeasureCachedText(const Font& font, const char* text, float fontSize, float spacing);
+
     // Moon surface tile textures
     Texture2D moonTiles[3];
     bool tilesLoaded;
@@ -92,6 +116,20 @@ private:
     void LoadPlanetMap();
     void DrawPlanetMapLayer(Camera2D camera);
 
+    // Per-cell overlays baked from the resource map, one texel per cell
+    // and drawn scaled with point filtering. Rebuilt only when the
+    // matching ResourceManager version counter moves.
+    Texture2D resourceOverlay;
+    unsigned int resourceOverlayVersion;
+    Texture2D surveyOverlay;
+    unsigned int surveyOverlayVersion;
+    void EnsureResourceOverlay(const ResourceManager& rm);
+    void EnsureSurveyOverlay(const ResourceManager& rm);
+    void UploadCellOverlay(Texture2D& overlay, Image& image);
+    void DrawCellOverlay(Texture2D overlay, const ResourceManager& rm);
+    void DrawResourceOverlay(Planet* planet);
+    void UnloadCellOverlays();
+
     void DrawSectTerrainBackground(Sect* sect);
     // World-space ground for the panned views. spanCells is how many
     // 5 km grid cells the level covers (20 for PLANET, 5 for COLONY);
@@ -125,6 +163,20 @@ private:
     void DrawDashedLine(Vector2 start, Vector2 end, float dashLength, float gapLength,
                         float thickness, Color color);
 
+    // Batched transport packet drawing (one submission per frame)
+    PacketRenderer packetRenderer;
+    float simAlpha;
+
+    CommandSink* commands;
+    bool SubmitUnitCommand(Unit* unit, const Command& command);
+
+    // Sect domes and the sect-view station layout
+    SectRenderer sectRenderer;
+
+    // Colony sects on the planet view, with the jurisdiction ring on hover
+    void DrawColony(Colony* colony, Camera2D camera);
+    void DrawColonyJurisdiction(const Colony* colony);
+
     // Function to load the moon surface tiles
     void LoadMoonTiles();
     // Function to render the tiled moon surface
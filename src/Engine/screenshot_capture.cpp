@@ -0,0 +1,160 @@
+#include "screenshot_capture.h"
+#include "rlgl.h"
+#include <cstdio>
+#include <iostream>
+
+ScreenshotCapture::ScreenshotCapture()
+    : bursting(false),
+      burstInterval(DEFAULT_BURST_INTERVAL),
+      burstFrame(0),
+      burstIndex(0),
+      pending(0),
+      stopping(false)
+{
+#ifndef __EMSCRIPTEN__
+    worker = std::thread(&ScreenshotCapture::WorkerLoop, this);
+#endif
+}
+
+ScreenshotCapture::~ScreenshotCapture()
+{
+#ifndef __EMSCRIPTEN__
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    workReady.notify_all();
+    if (worker.joinable()) worker.join();
+#endif
+}
+
+void ScreenshotCapture::Request(const std::string& path)
+{
+    requestedPath = path;
+}
+
+void ScreenshotCapture::StartBurst(const std::string& prefix, int interval)
+{
+    bursting = true;
+    burstPrefix = prefix;
+    burstInterval = interval > 0 ? interval : 1;
+    burstFrame = 0;
+    burstIndex = 0;
+    std::cout << "[SCREENSHOT] Burst started: " << burstPrefix
+              << "_*.png every " << burstInterval << " frames" << std::endl;
+}
+
+void ScreenshotCapture::StopBurst()
+{
+    if (!bursting) return;
+    bursting = false;
+    Stats s = GetStats();
+    std::cout << "[SCREENSHOT] Burst stopped: " << burstIndex << " frames captured, "
+              << s.dropped << " dropped" << std::endl;
+}
+
+void ScreenshotCapture::EndFrame()
+{
+    if (!requestedPath.empty()) {
+        Capture(requestedPath, true);
+        requestedPath.clear();
+    }
+
+    if (bursting) {
+        if (burstFrame % burstInterval == 0) {
+            char suffix[16];
+            snprintf(suffix, sizeof(suffix), "_%05d.png", burstIndex + 1);
+            if (Capture(burstPrefix + suffix, false)) burstIndex++;
+        }
+        burstFrame++;
+    }
+}
+
+bool ScreenshotCapture::Capture(const std::string& path, bool waitForSlot)
+{
+#ifndef __EMSCRIPTEN__
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (pending >= MAX_PENDING) {
+            if (!waitForSlot) {
+                stats.dropped++;
+                return false;
+            }
+            slotFreed.wait(lock, [this] { return pending < MAX_PENDING; });
+        }
+        pending++;
+    }
+#endif
+
+    // Pending rlgl geometry isn't in the framebuffer until it is flushed
+    rlDrawRenderBatchActive();
+
+    // The readback is the only part that has to stay on the GL thread.
+    // rlgl has no readback into a caller-owned buffer, so the pixels live
+    // in raylib's allocation until the worker is done with them; the
+    // MAX_PENDING cap is what bounds that memory.
+    Job job;
+    job.image = LoadImageFromScreen();
+    job.path = path;
+
+#ifdef __EMSCRIPTEN__
+    Write(job);
+    UnloadImage(job.image);
+#else
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs.push_back(job);
+    }
+    workReady.notify_one();
+#endif
+    return true;
+}
+
+void ScreenshotCapture::Flush()
+{
+#ifndef __EMSCRIPTEN__
+    std::unique_lock<std::mutex> lock(mutex);
+    slotFreed.wait(lock, [this] { return pending == 0; });
+#endif
+}
+
+ScreenshotCapture::Stats ScreenshotCapture::GetStats()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+void ScreenshotCapture::WorkerLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        workReady.wait(lock, [this] { return stopping || !jobs.empty(); });
+        if (jobs.empty()) return;   // stopping, and the queue is drained
+
+        Job job = jobs.front();
+        jobs.pop_front();
+
+        lock.unlock();
+        Write(job);
+        UnloadImage(job.image);
+        lock.lock();
+
+        pending--;
+        slotFreed.notify_all();
+    }
+}
+
+bool ScreenshotCapture::Write(const Job& job)
+{
+    bool ok = job.image.data != nullptr && ExportImage(job.image, job.path.c_str());
+    {
+#ifndef __EMSCRIPTEN__
+        std::lock_guard<std::mutex> lock(mutex);
+#endif
+        if (ok) stats.written++;
+        else stats.failed++;
+    }
+    if (ok) std::cout << "[SCREENSHOT] Saved: " << job.path << std::endl;
+    else std::cout << "[SCREENSHOT] Failed to write " << job.path << std::endl;
+    return ok;
+}
@@ -0,0 +1,82 @@
+#ifndef SCREENSHOT_CAPTURE_H
+#define SCREENSHOT_CAPTURE_H
+
+#include "raylib.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Asynchronous screenshot writer.
+//
+// The calling (render) thread only reads the framebuffer back; PNG
+// encoding and the file write happen on a worker thread. At most
+// MAX_PENDING frames are held in memory: single shots wait for a slot,
+// burst frames are dropped instead so recording never stalls the game.
+//
+// Web builds have no worker thread and write synchronously.
+class ScreenshotCapture {
+public:
+    static const int MAX_PENDING = 4;
+    static const int DEFAULT_BURST_INTERVAL = 10;   // frames between burst shots
+
+    struct Stats {
+        int written = 0;
+        int failed = 0;
+        int dropped = 0;    // burst frames skipped because every slot was busy
+    };
+
+    ScreenshotCapture();
+    ~ScreenshotCapture();     // writes out everything still queued
+
+    // Queues a shot of the frame currently being drawn; taken in EndFrame().
+    void Request(const std::string& path);
+
+    // Captures every `interval`th frame to <prefix>_00001.png, ...
+    void StartBurst(const std::string& prefix, int interval = DEFAULT_BURST_INTERVAL);
+    void StopBurst();
+    bool IsBursting() const { return bursting; }
+
+    // Call once per frame after everything is drawn, before EndDrawing().
+    void EndFrame();
+
+    // Reads the framebuffer back now and queues it. Returns false if the
+    // frame was dropped (only when `waitForSlot` is false).
+    bool Capture(const std::string& path, bool waitForSlot = true);
+
+    // Blocks until every queued shot is on disk.
+    void Flush();
+
+    Stats GetStats();
+
+private:
+    struct Job {
+        Image image;
+        std::string path;
+    };
+
+    std::string requestedPath;
+
+    bool bursting;
+    std::string burstPrefix;
+    int burstInterval;
+    int burstFrame;
+    int burstIndex;
+
+    std::deque<Job> jobs;
+    int pending;            // queued + being encoded
+    bool stopping;
+    Stats stats;
+    std::mutex mutex;
+    std::condition_variable workReady;
+    std::condition_variable slotFreed;
+#ifndef __EMSCRIPTEN__
+    std::thread worker;
+#endif
+
+    void WorkerLoop();
+    bool Write(const Job& job);
+};
+
+#endif // SCREENSHOT_CAPTURE_H
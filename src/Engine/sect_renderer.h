@@ -0,0 +1,35 @@
+#ifndef SECT_RENDERER_H
+#define SECT_RENDERER_H
+
+#include "raylib.h"
+#include "sect.h"
+#include <map>
+#include <string>
+
+// Draws sects in the colony and sect views. The simulation-side Sect holds
+// no textures or draw code; the dome and unit thumbnails live here and are
+// loaded once, on first draw, for every sect.
+class SectRenderer {
+public:
+    SectRenderer();
+    ~SectRenderer();
+
+    // Dome with its unit ring, in world space (colony view)
+    void DrawInColonyView(const Sect& sect, Vector2 pos);
+
+    // Full-screen dome-station layout (sect view). Also stores each unit's
+    // on-screen position and radius for click detection.
+    void DrawInSectView(Sect& sect, Vector2 position);
+
+private:
+    Texture2D domeTexture;                          // Central dome texture
+    std::map<std::string, Texture2D> unitTextures;  // Unit type -> texture mapping
+    bool texturesLoaded;
+
+    void EnsureTextures();
+    void LoadTextures();
+    void UnloadTextures();
+    void DrawTransparentRightPanel();
+};
+
+#endif // SECT_RENDERER_H
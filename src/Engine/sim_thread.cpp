@@ -0,0 +1,133 @@
+#include "sim_thread.h"
+#include "gamemanager.h"
+#include <chrono>
+#include <utility>
+
+SimThread::SimThread(std::unique_ptr<GameManager> game)
+    : game(std::move(game)),
+      commandsTaken(0),
+      lastPublishedTicks(0),
+      lastPublishedCommands(0),
+      parkRequested(false),
+      stopping(false),
+      parked(false)
+{
+#ifndef __EMSCRIPTEN__
+    thread = std::thread(&SimThread::Loop, this);
+#endif
+}
+
+SimThread::~SimThread() {
+#ifndef __EMSCRIPTEN__
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    parkedChanged.notify_all();
+    thread.join();
+#endif
+}
+
+double SimThread::Now() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool SimThread::Call(const std::function<bool(GameManager&)>& fn) {
+#ifndef __EMSCRIPTEN__
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        parkRequested = true;
+        parkedChanged.wait(lock, [this] { return parked; });
+    }
+#endif
+    // Anything sent before the call goes first
+    TakeInputs();
+    bool ok = fn(*game);
+
+    // The game's objects may have been replaced: a new address can match
+    // an old one, so nothing is shared by pointer across the call
+    lastPages.reset();
+    Publish(true);
+
+#ifndef __EMSCRIPTEN__
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        parkRequested = false;
+    }
+    parkedChanged.notify_all();
+#endif
+    return ok;
+}
+
+void SimThread::Loop() {
+    using Clock = std::chrono::steady_clock;
+    const auto step = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(SimScheduler::STEP_SECONDS));
+
+    double last = Now();
+    Clock::time_point wake = Clock::now();
+    while (!stopping) {
+        if (parkRequested.load(std::memory_order_acquire)) {
+            std::unique_lock<std::mutex> lock(mutex);
+            parked = true;
+            parkedChanged.notify_all();
+            parkedChanged.wait(lock, [this] { return !parkRequested || stopping; });
+            parked = false;
+            // Time spent parked is not game time
+            last = Now();
+            wake = Clock::now();
+            continue;
+        }
+
+        TakeInputs();
+        double now = Now();
+        game->Update(static_cast<float>(now - last));
+        last = now;
+        Publish(false);
+
+        // A fixed rate, without a burst to catch up after a slow batch:
+        // the scheduler already caps the ticks one batch may run
+        wake += step;
+        Clock::time_point current = Clock::now();
+        if (wake < current) wake = current;
+        std::this_thread::sleep_until(wake);
+    }
+}
+
+void SimThread::TakeInputs() {
+    Input input;
+    while (inputs.Pop(input)) {
+        if (input.kind == Input::Kind::VIEWED) {
+            const std::vector<Colony*>& colonies = game->GetColonies();
+            std::vector<Colony*> viewed;
+            for (int index : input.viewed) {
+                if (index >= 0 && index < static_cast<int>(colonies.size())) viewed.push_back(colonies[index]);
+            }
+            game->SetViewedColonies(viewed);
+            continue;
+        }
+        game->Submit(input.command);
+        commandsTaken++;
+    }
+}
+
+void SimThread::Publish(bool force) {
+    const uint64_t ticks = game->GetScheduler().GetTickCount();
+    if (!force && ticks == lastPublishedTicks && commandsTaken == lastPublishedCommands) return;
+    lastPublishedTicks = ticks;
+    lastPublishedCommands = commandsTaken;
+
+    lastPages = std::make_shared<const WorldPages>(WorldPages::Capture(
+        game->GetPlanet()->GetResourceManager(), game->GetTimeManager(), game->GetColonies(), lastPages.get()));
+
+    Frame& frame = frames.GetBack();
+    frame.pages = lastPages;
+    frame.commandsTaken = commandsTaken;
+    frame.clockTime = game->GetClockTime();
+    frame.alpha = game->GetSimAlpha();
+    frame.publishedAt = Now();
+    frame.stepSeconds = game->GetScheduler().GetStepSeconds();
+    frame.recording = game->IsRecording();
+    frame.autosaving = game->IsAutosaving();
+    frames.Publish();
+}
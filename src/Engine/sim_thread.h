@@ -0,0 +1,101 @@
+#ifndef SIM_THREAD_H
+#define SIM_THREAD_H
+
+#include "command.h"
+#include "spsc_queue.h"
+#include "triple_buffer.h"
+#include "world_pages.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class GameManager;
+
+// Runs a GameManager on a thread of its own, so ticks never wait on the
+// renderer's vsync and the renderer never waits on a tick.
+//
+// The thread wakes every SimScheduler step of real time and hands the
+// elapsed time to the game, which runs the ticks it pays for as it always
+// has. After each batch it captures the game as WorldPages (copy-on-write,
+// so a capture costs what changed) and publishes it through a
+// TripleBuffer; the render thread picks up the newest table when it
+// likes and keeps its own copy of the game in step with it (WorldMirror).
+// Player input goes the other way over a lock-free SpscQueue, in order.
+//
+// Whole-game operations (save, load, rewind, recording) are rare and need
+// the game to hold still: Call() parks the thread between batches, after
+// it has taken every queued input, runs them on the calling thread and
+// publishes the result before returning. Web builds have no thread;
+// GameManager runs the game inline there instead.
+class SimThread {
+public:
+    struct Input {
+        enum class Kind { COMMAND, VIEWED };
+        Kind kind = Kind::COMMAND;
+        Command command;
+        std::vector<int> viewed;        // colony indices (GameManager::SetViewedColonies)
+    };
+
+    struct Frame {
+        std::shared_ptr<const WorldPages> pages;
+        uint64_t commandsTaken = 0;     // taken off the queue so far, applied or refused
+        double clockTime = 0.0;         // SimStepper clock, for transport timing
+        float alpha = 1.0f;             // SimScheduler::GetAlpha when published
+        double publishedAt = 0.0;       // SimThread::Now
+        float stepSeconds = 0.0f;
+        bool recording = false;
+        bool autosaving = false;
+    };
+
+    static const size_t INPUT_QUEUE_SIZE = 256;
+
+    // Owns `game` and starts stepping it at once
+    explicit SimThread(std::unique_ptr<GameManager> game);
+    ~SimThread();
+
+    SimThread(const SimThread&) = delete;
+    SimThread& operator=(const SimThread&) = delete;
+
+    // Render thread only. False, with `input` kept, when the queue is full
+    bool Send(Input& input) { return inputs.Push(input); }
+
+    // Render thread only: the newest published frame if there is one not
+    // taken yet, nullptr otherwise. Valid until the next TakeFrame().
+    const Frame* TakeFrame() { return frames.Update() ? &frames.GetFront() : nullptr; }
+
+    // Runs `fn` on the game with the thread parked; see above
+    bool Call(const std::function<bool(GameManager&)>& fn);
+
+    // Monotonic seconds, the clock Frame::publishedAt is on
+    static double Now();
+
+private:
+    std::unique_ptr<GameManager> game;
+
+    SpscQueue<Input, INPUT_QUEUE_SIZE> inputs;
+    uint64_t commandsTaken;
+    TripleBuffer<Frame> frames;
+    std::shared_ptr<const WorldPages> lastPages;    // the next capture shares its pages
+    uint64_t lastPublishedTicks;
+    uint64_t lastPublishedCommands;
+
+    std::mutex mutex;
+    std::condition_variable parkedChanged;
+    std::atomic<bool> parkRequested;
+    std::atomic<bool> stopping;
+    bool parked;
+#ifndef __EMSCRIPTEN__
+    std::thread thread;
+#endif
+
+    void Loop();
+    void TakeInputs();
+    void Publish(bool force);
+};
+
+#endif // SIM_THREAD_H
@@ -0,0 +1,160 @@
+#include "text_run_cache.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+    // Runs not drawn for this many frames are dropped; checked every
+    // EVICT_INTERVAL frames so the sweep stays off the per-frame path.
+    const unsigned int EVICT_AFTER_FRAMES = 600;
+    const unsigned int EVICT_INTERVAL = 120;
+
+    // raylib's default line spacing for DrawTextEx (SetTextLineSpacing)
+    const float TEXT_LINE_SPACING = 2.0f;
+
+    const uint64_t FNV_OFFSET = 1469598103934665603ull;
+    const uint64_t FNV_PRIME = 1099511628211ull;
+
+    uint64_t HashBytes(uint64_t h, const void* data, size_t len)
+    {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < len; i++) {
+            h ^= p[i];
+            h *= FNV_PRIME;
+        }
+        return h;
+    }
+}
+
+TextRunCache::TextRunCache()
+    : frame(0)
+{
+}
+
+void TextRunCache::BeginFrame()
+{
+    current.runs = runs.size();
+    lastFrame = current;
+    current = Stats();
+    frame++;
+
+    if (frame % EVICT_INTERVAL == 0) {
+        for (auto it = runs.begin(); it != runs.end();) {
+            if (frame - it->second.lastUsedFrame > EVICT_AFTER_FRAMES) it = runs.erase(it);
+            else ++it;
+        }
+    }
+}
+
+uint64_t TextRunCache::SlotKey(const void* slot, int index)
+{
+    uint64_t h = HashBytes(FNV_OFFSET, &slot, sizeof(slot));
+    return HashBytes(h, &index, sizeof(index));
+}
+
+uint64_t TextRunCache::RunKey(unsigned int fontId, float fontSize, float spacing, const char* text)
+{
+    uint64_t h = HashBytes(FNV_OFFSET, &fontId, sizeof(fontId));
+    h = HashBytes(h, &fontSize, sizeof(fontSize));
+    h = HashBytes(h, &spacing, sizeof(spacing));
+    return HashBytes(h, text, std::strlen(text));
+}
+
+const TextRun& TextRunCache::Get(const Font& font, const char* text, float fontSize, float spacing)
+{
+    uint64_t key = RunKey(font.texture.id, fontSize, spacing, text);
+    TextRun& run = runs[key];
+
+    // A hash collision just re-lays the slot out for the new text
+    bool hit = run.fontSize > 0.0f && run.fontId == font.texture.id &&
+               run.fontSize == fontSize && run.spacing == spacing && run.text == text;
+    if (hit) {
+        current.hits++;
+    } else {
+        current.misses++;
+        run.text = text;
+        run.fontId = font.texture.id;
+        run.fontSize = fontSize;
+        run.spacing = spacing;
+        Layout(run, font);
+    }
+    run.lastUsedFrame = frame;
+    return run;
+}
+
+void TextRunCache::Layout(TextRun& run, const Font& font) const
+{
+    // Same placement as DrawTextEx/DrawTextCodepoint, done once.
+    run.quads.clear();
+    run.size = MeasureTextEx(font, run.text.c_str(), run.fontSize, run.spacing);
+    if (font.baseSize <= 0 || font.glyphs == nullptr) return;
+
+    float scale = run.fontSize / font.baseSize;
+    float pad = static_cast<float>(font.glyphPadding);
+    float offsetX = 0.0f;
+    float offsetY = 0.0f;
+
+    const char* text = run.text.c_str();
+    int length = static_cast<int>(run.text.size());
+    for (int i = 0; i < length;) {
+        int codepointSize = 0;
+        int codepoint = GetCodepointNext(&text[i], &codepointSize);
+        int index = GetGlyphIndex(font, codepoint);
+        i += codepointSize > 0 ? codepointSize : 1;
+
+        if (codepoint == '\n') {
+            offsetY += run.fontSize + TEXT_LINE_SPACING;
+            offsetX = 0.0f;
+            continue;
+        }
+
+        const Rectangle& rec = font.recs[index];
+        const GlyphInfo& glyph = font.glyphs[index];
+        if (codepoint != ' ' && codepoint != '\t') {
+            TextGlyphQuad quad;
+            quad.src = {rec.x - pad, rec.y - pad, rec.width + 2.0f * pad, rec.height + 2.0f * pad};
+            quad.dst = {offsetX + glyph.offsetX * scale - pad * scale,
+                        offsetY + glyph.offsetY * scale - pad * scale,
+                        (rec.width + 2.0f * pad) * scale,
+                        (rec.height + 2.0f * pad) * scale};
+            run.quads.push_back(quad);
+        }
+
+        if (glyph.advanceX == 0) offsetX += rec.width * scale + run.spacing;
+        else offsetX += glyph.advanceX * scale + run.spacing;
+    }
+}
+
+void TextRunCache::Draw(const TextRun& run, const Font& font, Vector2 position, Color tint) const
+{
+    for (const auto& quad : run.quads) {
+        Rectangle dst = {position.x + quad.dst.x, position.y + quad.dst.y,
+                         quad.dst.width, quad.dst.height};
+        DrawTexturePro(font.texture, quad.src, dst, {0.0f, 0.0f}, 0.0f, tint);
+    }
+}
+
+void TextRunCache::Clear()
+{
+    runs.clear();
+    valueSlots.clear();
+}
+
+bool TextRunCache::ValueSlot::Matches(std::initializer_list<double> v) const
+{
+    int n = std::min(static_cast<int>(v.size()), 4);
+    if (n != count) return false;
+    const double* value = v.begin();
+    for (int i = 0; i < n; i++) {
+        if (values[i] != value[i]) return false;
+    }
+    return true;
+}
+
+void TextRunCache::ValueSlot::Store(std::initializer_list<double> v)
+{
+    count = 0;
+    for (double value : v) {
+        if (count >= 4) break;
+        values[count++] = value;
+    }
+}
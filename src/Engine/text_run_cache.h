@@ -0,0 +1,100 @@
+#ifndef TEXT_RUN_CACHE_H
+#define TEXT_RUN_CACHE_H
+
+#include "raylib.h"
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// One glyph of a laid-out run: source rect in the font atlas and
+// destination rect relative to the run origin.
+struct TextGlyphQuad {
+    Rectangle src;
+    Rectangle dst;
+};
+
+// A string laid out once for a given font, size and spacing.
+struct TextRun {
+    std::string text;
+    unsigned int fontId;
+    float fontSize;
+    float spacing;
+    Vector2 size;                       // what MeasureTextEx returns
+    std::vector<TextGlyphQuad> quads;
+    unsigned int lastUsedFrame;
+};
+
+// Text-run cache for the UI panels.
+//
+// Get() maps (font, size, spacing, string) to a pre-measured glyph run,
+// so a hit skips UTF-8 decoding, glyph lookup and measuring. Format()
+// keeps the formatted string of a value label per slot and only calls the
+// formatter again when one of the label's source values changes, so
+// steady labels don't go through TextFormat every frame either.
+class TextRunCache {
+public:
+    struct Stats {
+        int hits = 0;
+        int misses = 0;
+        int formats = 0;            // Format() calls that re-ran the formatter
+        int formatsSkipped = 0;     // Format() calls served from the slot
+        size_t runs = 0;            // runs held at the end of the frame
+    };
+
+    TextRunCache();
+
+    // Rolls per-frame stats and evicts runs unused for a while.
+    void BeginFrame();
+
+    const TextRun& Get(const Font& font, const char* text, float fontSize, float spacing);
+    void Draw(const TextRun& run, const Font& font, Vector2 position, Color tint) const;
+
+    // Cached formatted text for a value label. `slot` is any stable
+    // pointer naming the label (a string literal works), `index` tells
+    // rows of the same label apart. Only the first 4 source values are
+    // compared.
+    template <typename FormatFn>
+    const char* Format(const void* slot, int index, std::initializer_list<double> values,
+                       FormatFn format)
+    {
+        ValueSlot& entry = valueSlots[SlotKey(slot, index)];
+        if (!entry.valid || !entry.Matches(values)) {
+            entry.Store(values);
+            entry.text = format();
+            entry.valid = true;
+            current.formats++;
+        } else {
+            current.formatsSkipped++;
+        }
+        return entry.text.c_str();
+    }
+
+    const Stats& GetFrameStats() const { return lastFrame; }
+    void Clear();
+
+private:
+    struct ValueSlot {
+        double values[4];
+        int count = 0;
+        bool valid = false;
+        std::string text;
+
+        bool Matches(std::initializer_list<double> v) const;
+        void Store(std::initializer_list<double> v);
+    };
+
+    static uint64_t SlotKey(const void* slot, int index);
+    static uint64_t RunKey(unsigned int fontId, float fontSize, float spacing, const char* text);
+    void Layout(TextRun& run, const Font& font) const;
+
+    std::unordered_map<uint64_t, TextRun> runs;
+    std::unordered_map<uint64_t, ValueSlot> valueSlots;
+
+    unsigned int frame;
+    Stats current;
+    Stats lastFrame;
+};
+
+#endif // TEXT_RUN_CACHE_H
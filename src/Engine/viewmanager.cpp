@@ -211,6 +211,36 @@ Vector2 ViewManager::GetWorldMousePosition() {
     return GetScreenToWorld2D(::GetMousePosition(), camera);
 }
 
+void ViewManager::CollectViewedColonies(const std::vector<Colony*>& colonies, Colony* currentColony,
+                                        std::vector<Colony*>& out) const {
+    out.clear();
+    switch (currentView) {
+        case View::Colony:
+        case View::Sect:
+        case View::Unit:
+            if (currentColony) out.push_back(currentColony);
+            break;
+
+        case View::Planet:
+        case View::SITE_SELECTION: {
+            Vector2 topLeft = GetScreenToWorld2D({0.0f, 0.0f}, camera);
+            Vector2 bottomRight = GetScreenToWorld2D({static_cast<float>(screenWidth), static_cast<float>(screenHeight)}, camera);
+            for (Colony* colony : colonies) {
+                Vector2 centre = colony->GetCentroid();
+                float radius = colony->GetRadius();
+                if (centre.x + radius >= topLeft.x && centre.x - radius <= bottomRight.x &&
+                    centre.y + radius >= topLeft.y && centre.y - radius <= bottomRight.y) {
+                    out.push_back(colony);
+                }
+            }
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
 void ViewManager::SwitchToColonyView(Colony* currentColony) {
     if (currentColony) {
         currentView = View::Colony;
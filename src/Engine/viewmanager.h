@@ -26,6 +26,12 @@ public:
     void SwitchToOrbitalView();
 
     Vector2 GetWorldMousePosition();
+
+    // Colonies the player can see: the open one in the colony, sect and
+    // unit views, those on screen in the planet view. The simulation runs
+    // the rest at level of detail (ColonyLod).
+    void CollectViewedColonies(const std::vector<Colony*>& colonies, Colony* currentColony,
+                               std::vector<Colony*>& out) const;
     Camera2D& GetCamera() { return camera; }
     View GetCurrentView() const { return currentView; }
     void SetCurrentView(View view) { currentView = view; }
@@ -1,4 +1,6 @@
 #include "game_types_loader.h"
+#include "unit_kinds.h"
+#include "sim_log.h"
 #include <toml++/toml.h>
 #include <iostream>
 #include <fstream>
@@ -16,7 +18,7 @@ GameTypesLoader& GameTypesLoader::Instance() {
 
 bool GameTypesLoader::LoadFromFile(const std::string& filepath) {
     try {
-        std::cout << "Loading game types from: " << filepath << std::endl;
+        COLONY_LOG_INFO(Config, "Loading game types from: " << filepath);
 
         // Parse TOML file
         toml::table config = toml::parse_file(filepath);
@@ -44,19 +46,19 @@ bool GameTypesLoader::LoadFromFile(const std::string& filepath) {
         }
 
         isLoaded = true;
-        std::cout << "Successfully loaded game types:" << std::endl;
-        std::cout << "  - Resources: " << resourceTypeDefinitions.size() << std::endl;
-        std::cout << "  - Units: " << unitTypeDefinitions.size() << std::endl;
-        std::cout << "  - Modules: " << moduleDefinitions.size() << std::endl;
+        COLONY_LOG_INFO(Config, "Successfully loaded game types:");
+        COLONY_LOG_INFO(Config, "  - Resources: " << resourceTypeDefinitions.size());
+        COLONY_LOG_INFO(Config, "  - Units: " << unitTypeDefinitions.size());
+        COLONY_LOG_INFO(Config, "  - Modules: " << moduleDefinitions.size());
 
         return true;
     }
     catch (const toml::parse_error& err) {
-        std::cerr << "TOML Parse Error: " << err << std::endl;
+        COLONY_LOG_ERROR(Config, "TOML Parse Error: " << err);
         return false;
     }
     catch (const std::exception& e) {
-        std::cerr << "Error loading game types: " << e.what() << std::endl;
+        COLONY_LOG_ERROR(Config, "Error loading game types: " << e.what());
         return false;
     }
 }
@@ -226,29 +228,17 @@ ResourceType GameTypesLoader::StringToResourceType(const std::string& str) const
         return it->second;
     }
 
-    std::cerr << "Warning: Unknown resource type '" << str << "', defaulting to ENERGY" << std::endl;
+    COLONY_LOG_WARN(Config, "Warning: Unknown resource type '" << str << "', defaulting to ENERGY");
     return ResourceType::ENERGY;
 }
 
 UnitType GameTypesLoader::StringToUnitType(const std::string& str) const {
-    // Map string names to UnitType enum values
-    static const std::map<std::string, UnitType> mapping = {
-        {"Extraction", UnitType::Extraction},
-        {"Farming", UnitType::Farming},
-        {"Energy", UnitType::Energy},
-        {"Construction", UnitType::Construction},
-        {"Transport", UnitType::Transport},
-        {"Manufacture", UnitType::Manufacture},
-        {"Research", UnitType::Research},
-        {"Commerce", UnitType::Commerce}
-    };
-
-    auto it = mapping.find(str);
-    if (it != mapping.end()) {
-        return it->second;
+    UnitType type;
+    if (UnitTypeFromString(str, type)) {
+        return type;
     }
 
-    std::cerr << "Warning: Unknown unit type '" << str << "', defaulting to Extraction" << std::endl;
+    COLONY_LOG_WARN(Config, "Warning: Unknown unit type '" << str << "', defaulting to Extraction");
     return UnitType::Extraction;
 }
 
@@ -257,7 +247,7 @@ ResourceTypeDefinition GameTypesLoader::GetResourceTypeDef(const std::string& ty
     if (it != resourceTypeDefinitions.end()) {
         return it->second;
     }
-    std::cerr << "Error: Resource type definition not found: " << typeName << std::endl;
+    COLONY_LOG_ERROR(Config, "Error: Resource type definition not found: " << typeName);
     return ResourceTypeDefinition();
 }
 
@@ -266,7 +256,7 @@ UnitTypeDefinition GameTypesLoader::GetUnitTypeDef(const std::string& typeName)
     if (it != unitTypeDefinitions.end()) {
         return it->second;
     }
-    std::cerr << "Error: Unit type definition not found: " << typeName << std::endl;
+    COLONY_LOG_ERROR(Config, "Error: Unit type definition not found: " << typeName);
     return UnitTypeDefinition();
 }
 
@@ -275,7 +265,7 @@ ModuleDefinition GameTypesLoader::GetModuleDef(const std::string& moduleName) co
     if (it != moduleDefinitions.end()) {
         return it->second;
     }
-    std::cerr << "Error: Module definition not found: " << moduleName << std::endl;
+    COLONY_LOG_ERROR(Config, "Error: Module definition not found: " << moduleName);
     return ModuleDefinition();
 }
 
@@ -1,4 +1,5 @@
 #include "planet.h"
+#include "sim_log.h"
 #include <iostream>
 
 Planet::Planet() :
@@ -26,7 +27,7 @@ void Planet::GenerateMap() {
 
 void Planet::AddColony(Colony* colony) {
     colonies.push_back(colony);
-    std::cout << "New colony added to the planet." << std::endl;
+    COLONY_LOG_INFO(Planet, "New colony added to the planet.");
 }
 
 std::vector<std::pair<ResourceType, float>> Planet::GetResourceInfo(Vector2 location) const {
@@ -142,25 +143,3 @@ Vector2 Planet::WorldToGrid(Vector2 worldPos) const {
         std::floor(worldPos.y / (SECT_CORE_RADIUS * 2.0f))
     };
 }
-
-void Planet::Draw(Camera2D& camera) {
-    // Draw the planet background and grid
-        DrawPlanetGrid();
-        for (const auto& colony : colonies) {
-            colony->Draw(camera);  // Call Colony's Draw() for each colony
-        }
-}
-
-void Planet::DrawPlanetGrid() {
-    // Implement planet grid drawing logic here
-    // For example:
-    /*for (int i = 0; i < 20; i++) {
-        DrawLine(i * 10, 0, i * 10, GetScreenHeight(), LIGHTGRAY);
-        DrawLine(0, i * 10, GetScreenWidth(), i * 10, LIGHTGRAY);
-    }*/
-}
-
-void Planet::DrawResourceDebug(float scale) {
-    resourceManager.DrawResourceDebug(scale);
-}
-
@@ -30,14 +30,11 @@ public:
     void AddColony(Colony* colony);
     std::vector<std::pair<ResourceType, float>> GetResourceInfo(Vector2 location) const;
     void Update();
-    void Draw(Camera2D &camera);
-    void DrawPlanetGrid();
     void UpdateActiveArea(const std::vector<Colony*>& colonies);
     Vector2 GetRandomValidPosition() const;
     void NotifyFirstSectPosition(Vector2 position);
     Vector2 GetActiveCentroid() const;
     float GetActiveRadius() const;
-    void DrawResourceDebug(float scale);
     Vector2 GetWorldPosition(Vector2 gridPos) const;
     ResourceManager& GetResourceManager()  { return resourceManager; }
     std::vector<Colony*> GetColonies() const { return colonies;}
@@ -1,4 +1,5 @@
 #include "prospecting_grid.h"
+#include "byte_stream.h"
 #include <cmath>
 #include <algorithm>
 
@@ -202,3 +203,59 @@ uint32_t ProspectingGrid::LCG(uint32_t seed)
 {
     return seed * 1664525u + 1013904223u;
 }
+
+void ProspectingGrid::SaveState(ByteWriter& out) const
+{
+    out.Write<int32_t>(gridSize);
+    for (const auto& row : cells)
+    {
+        for (const SubCell& cell : row)
+        {
+            out.Write<float>(cell.sweepSignal);
+            out.WriteBool(cell.hasBeenSwept);
+            out.Write<int32_t>(cell.sweepFrequencyBand);
+            out.WriteCount(cell.sampleIds.size());
+            for (int id : cell.sampleIds) out.Write<int32_t>(id);
+            out.Write<float>(cell.aggregateConfidence);
+        }
+    }
+
+    out.WriteCount(sweepHistory.size());
+    for (const SweepRecord& record : sweepHistory)
+    {
+        out.Write<int32_t>(record.frequencyBand);
+        out.Write<float>(record.energyCost);
+        out.Write<float>(record.timestamp);
+    }
+}
+
+bool ProspectingGrid::LoadState(ByteReader& in)
+{
+    if (in.Read<int32_t>() != gridSize)
+    {
+        in.Fail();
+        return false;
+    }
+
+    for (auto& row : cells)
+    {
+        for (SubCell& cell : row)
+        {
+            cell.sweepSignal = in.Read<float>();
+            cell.hasBeenSwept = in.ReadBool();
+            cell.sweepFrequencyBand = in.Read<int32_t>();
+            cell.sampleIds.resize(in.ReadCount(4));
+            for (int& id : cell.sampleIds) id = in.Read<int32_t>();
+            cell.aggregateConfidence = in.Read<float>();
+        }
+    }
+
+    sweepHistory.resize(in.ReadCount(12));
+    for (SweepRecord& record : sweepHistory)
+    {
+        record.frequencyBand = in.Read<int32_t>();
+        record.energyCost = in.Read<float>();
+        record.timestamp = in.Read<float>();
+    }
+    return in.Ok();
+}
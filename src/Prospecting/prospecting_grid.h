@@ -6,6 +6,9 @@
 #include "prospecting_types.h"
 #include "resource_manager.h"
 
+class ByteWriter;
+class ByteReader;
+
 class ProspectingGrid
 {
 public:
@@ -28,6 +31,11 @@ public:
 
     void ResizeForTier(int newTier);
 
+    // Sweep and sample state only; abundances are regenerated from the
+    // parent cell, so the grid must already be at the saved tier
+    void SaveState(ByteWriter& out) const;
+    bool LoadState(ByteReader& in);
+
 private:
     int tier;
     int gridSize;
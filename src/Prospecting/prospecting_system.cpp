@@ -1,4 +1,5 @@
 #include "prospecting_system.h"
+#include "byte_stream.h"
 
 ProspectingSystem::ProspectingSystem(int tier, int parentGridX, int parentGridY,
                                      ResourceManager& resourceManager)
@@ -39,6 +40,43 @@ int ProspectingSystem::GetTier() const
     return tier;
 }
 
+void ProspectingSystem::SaveState(ByteWriter& out) const
+{
+    out.Write<int32_t>(tier);
+    out.Write<float>(gameTime);
+    grid.SaveState(out);
+    tray.SaveState(out);
+    sweep.SaveState(out);
+}
+
+bool ProspectingSystem::LoadState(ByteReader& in)
+{
+    int savedTier = in.Read<int32_t>();
+    if (savedTier < 0 || savedTier > 3)
+    {
+        in.Fail();
+        return false;
+    }
+    if (savedTier != tier) SetTier(savedTier);
+
+    gameTime = in.Read<float>();
+    grid.LoadState(in);
+    tray.LoadState(in);
+    sweep.LoadState(in);
+
+    // Every sample ever collected is still listed on its sub-cell, so the
+    // grid says where the tray's ids had got to
+    for (int y = 0; y < grid.GetGridSize(); y++)
+    {
+        for (int x = 0; x < grid.GetGridSize(); x++)
+        {
+            for (int id : grid.GetSubCell(x, y).sampleIds) tray.ReserveIdsThrough(id);
+        }
+    }
+    InvalidateCache();
+    return in.Ok();
+}
+
 ProspectingGrid& ProspectingSystem::GetGrid()
 {
     InvalidateCache();
@@ -94,9 +132,15 @@ const LabEngine& ProspectingSystem::GetLab() const
     return lab;
 }
 
+uint32_t ProspectingSystem::GetRevision() const
+{
+    return revision;
+}
+
 void ProspectingSystem::InvalidateCache()
 {
     cacheValid = false;
+    revision++;
 }
 
 void ProspectingSystem::EnsureCache() const
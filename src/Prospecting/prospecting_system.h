@@ -7,6 +7,9 @@
 #include "lab_engine.h"
 #include "survey_progress_engine.h"
 
+class ByteWriter;
+class ByteReader;
+
 enum class ProspectingTab { SWEEP, SAMPLES, LAB };
 
 class ProspectingSystem
@@ -21,6 +24,16 @@ public:
     void SetTier(int tier);
     int GetTier() const;
 
+    // Save game snapshot: tier, clock, grid, tray and calibration. UI
+    // selection is not saved.
+    void SaveState(ByteWriter& out) const;
+    bool LoadState(ByteReader& in);
+
+    // Bumped on every mutable access to the grid, tray or engines (the
+    // same points that drop the survey cache), so callers can tell when
+    // sweep and sample state may have changed
+    uint32_t GetRevision() const;
+
     ProspectingGrid& GetGrid();
     const ProspectingGrid& GetGrid() const;
     SampleTray& GetTray();
@@ -53,6 +66,7 @@ private:
 
     mutable CellSurveyResult cachedResult;
     mutable bool cacheValid = false;
+    uint32_t revision = 0;
 
     void InvalidateCache();
     void EnsureCache() const;
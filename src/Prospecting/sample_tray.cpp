@@ -1,4 +1,71 @@
 #include "sample_tray.h"
+#include "byte_stream.h"
+#include <algorithm>
+
+namespace
+{
+    void WriteSample(ByteWriter& out, const Sample& sample)
+    {
+        out.Write<int32_t>(sample.id);
+        out.Write<int32_t>(sample.subCellX);
+        out.Write<int32_t>(sample.subCellY);
+        out.WriteEnum(sample.depthLayer);
+        out.Write<float>(sample.richness);
+        out.WriteResourceMap(sample.trueComposition);
+        out.WriteResourceMap(sample.elementConfidence);
+        out.WriteEnum(sample.state);
+        out.WriteEnum(sample.separationApplied);
+
+        out.WriteCount(sample.analysisHistory.size());
+        for (const ProcessingStep& step : sample.analysisHistory)
+        {
+            out.WriteEnum(step.tool);
+            out.Write<float>(step.timestamp);
+            out.WriteResourceMap(step.confidenceAdded);
+        }
+
+        const CrystalVisual& visual = sample.visual;
+        out.WriteEnum(visual.shapeFamily);
+        out.Write<int32_t>(visual.templateIndex);
+        out.Write<int32_t>(visual.glowLevel);
+        out.Write<int32_t>(visual.sizeLevel);
+        out.Write<uint8_t>(visual.elementColor.r);
+        out.Write<uint8_t>(visual.elementColor.g);
+        out.Write<uint8_t>(visual.elementColor.b);
+        out.Write<uint8_t>(visual.elementColor.a);
+    }
+
+    void ReadSample(ByteReader& in, Sample& sample)
+    {
+        sample.id = in.Read<int32_t>();
+        sample.subCellX = in.Read<int32_t>();
+        sample.subCellY = in.Read<int32_t>();
+        sample.depthLayer = in.ReadEnum(DepthLayer::DEEP);
+        sample.richness = in.Read<float>();
+        sample.trueComposition = in.ReadResourceMap<float>();
+        sample.elementConfidence = in.ReadResourceMap<float>();
+        sample.state = in.ReadEnum(SampleState::COMPLETED);
+        sample.separationApplied = in.ReadEnum(SeparationMethod::VOLATILE_EXTRACTION);
+
+        sample.analysisHistory.resize(in.ReadCount(9));
+        for (ProcessingStep& step : sample.analysisHistory)
+        {
+            step.tool = in.ReadEnum(AnalysisTool::MAGNETIC_SUSCEPTIBILITY);
+            step.timestamp = in.Read<float>();
+            step.confidenceAdded = in.ReadResourceMap<float>();
+        }
+
+        CrystalVisual& visual = sample.visual;
+        visual.shapeFamily = in.ReadEnum(ShapeFamily::LAYERED_SLABS);
+        visual.templateIndex = in.Read<int32_t>();
+        visual.glowLevel = in.Read<int32_t>();
+        visual.sizeLevel = in.Read<int32_t>();
+        visual.elementColor.r = in.Read<uint8_t>();
+        visual.elementColor.g = in.Read<uint8_t>();
+        visual.elementColor.b = in.Read<uint8_t>();
+        visual.elementColor.a = in.Read<uint8_t>();
+    }
+}
 
 SampleTray::SampleTray(int tier)
     : capacity(GetTrayCapacityForTier(tier))
@@ -127,6 +194,33 @@ int SampleTray::FindLowestValueSampleIndex() const
 
 int SampleTray::NextId()
 {
-    static int nextId = 1;
-    return nextId++;
+    return nextSampleId++;
+}
+
+void SampleTray::ReserveIdsThrough(int id)
+{
+    nextSampleId = std::max(nextSampleId, id + 1);
+}
+
+void SampleTray::SaveState(ByteWriter& out) const
+{
+    out.Write<int32_t>(bonusSlots);
+    out.WriteCount(samples.size());
+    for (const Sample& sample : samples)
+    {
+        WriteSample(out, sample);
+    }
+}
+
+bool SampleTray::LoadState(ByteReader& in)
+{
+    bonusSlots = in.Read<int32_t>();
+    samples.resize(in.ReadCount(40));
+    nextSampleId = 1;
+    for (Sample& sample : samples)
+    {
+        ReadSample(in, sample);
+        nextSampleId = std::max(nextSampleId, sample.id + 1);
+    }
+    return in.Ok();
 }
@@ -3,6 +3,9 @@
 #include <vector>
 #include "prospecting_types.h"
 
+class ByteWriter;
+class ByteReader;
+
 class SampleTray
 {
 public:
@@ -28,10 +31,19 @@ public:
 
     int FindLowestValueSampleIndex() const;
 
+    // Samples keep their ids; ids handed out afterwards stay above them
+    void SaveState(ByteWriter& out) const;
+    bool LoadState(ByteReader& in);
+
+    // Ids handed out afterwards stay above `id`, for ids of samples no
+    // longer in the tray that something still refers to
+    void ReserveIdsThrough(int id);
+
 private:
     std::vector<Sample> samples;
     int capacity;
     int bonusSlots = 0;
+    int nextSampleId = 1;       // per tray, so ids depend only on this tray's history
 
     int NextId();
 };
@@ -1,4 +1,5 @@
 #include "sweep_engine.h"
+#include "byte_stream.h"
 #include "game_constants.h"
 #include <cmath>
 #include <algorithm>
@@ -155,6 +156,7 @@ SweepResult SweepEngine::ExecuteSweep(ProspectingGrid& grid, int frequencyBand,
 
 float SweepEngine::GetCalibrationQuality() const { return calibrationQuality; }
 bool SweepEngine::IsCalibrating() const { return calibrating; }
+float SweepEngine::GetCalibrationTimeLeft() const { return calibrationTimer; }
 
 void SweepEngine::StartCalibration()
 {
@@ -182,6 +184,21 @@ void SweepEngine::SetTier(int tier)
 
 int SweepEngine::GetTier() const { return tier; }
 
+void SweepEngine::SaveState(ByteWriter& out) const
+{
+    out.Write<float>(calibrationQuality);
+    out.WriteBool(calibrating);
+    out.Write<float>(calibrationTimer);
+}
+
+bool SweepEngine::LoadState(ByteReader& in)
+{
+    calibrationQuality = in.Read<float>();
+    calibrating = in.ReadBool();
+    calibrationTimer = in.Read<float>();
+    return in.Ok();
+}
+
 float SweepEngine::CalculateRawSignal(const ProspectingGrid& grid, int subX, int subY,
                                        int frequencyBand) const
 {
@@ -4,6 +4,9 @@
 #include "prospecting_grid.h"
 #include "prospecting_constants.h"
 
+class ByteWriter;
+class ByteReader;
+
 struct SweepResult
 {
     float energyCost = 0.0f;
@@ -23,12 +26,17 @@ public:
 
     float GetCalibrationQuality() const;
     bool IsCalibrating() const;
+    float GetCalibrationTimeLeft() const;
     void StartCalibration();
     void UpdateCalibration(float deltaTime);
 
     void SetTier(int tier);
     int GetTier() const;
 
+    // Calibration state; the tier comes from the owning system
+    void SaveState(ByteWriter& out) const;
+    bool LoadState(ByteReader& in);
+
 private:
     int tier;
     float calibrationQuality;
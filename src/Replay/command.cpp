@@ -0,0 +1,322 @@
+#include "command.h"
+#include "byte_stream.h"
+#include "colony.h"
+#include "sect.h"
+#include "unit.h"
+#include "resource_manager.h"
+#include "time_manager.h"
+#include "unlock_registry.h"
+#include <cmath>
+
+namespace {
+    template <typename T>
+    T* AtIndex(const std::vector<T*>& items, int32_t index) {
+        return index >= 0 && index < static_cast<int32_t>(items.size()) ? items[index] : nullptr;
+    }
+
+    bool InRange(int32_t value, int32_t last) {
+        return value >= 0 && value <= last;
+    }
+
+    // Is `position` inside the jurisdiction of a colony other than `own`?
+    bool IntrudesOtherColony(const std::vector<Colony*>& colonies, const Colony* own, Vector2 position) {
+        for (const Colony* colony : colonies) {
+            if (colony == own) continue;
+            Vector2 centroid = colony->GetCentroid();
+            float dx = position.x - centroid.x;
+            float dy = position.y - centroid.y;
+            float radius = colony->GetRadius();
+            if (dx * dx + dy * dy <= radius * radius) return true;
+        }
+        return false;
+    }
+
+    bool FoundColony(const Command& command, ResourceManager& resources, TimeManager& time,
+                     std::vector<Colony*>& colonies, const SimClock* clock) {
+        if (!InRange(command.a, PLANET_SIZE - 1) || !InRange(command.b, PLANET_SIZE - 1)) return false;
+
+        // The first sect sits at the centre of the chosen cell
+        float cellSize = SECT_CORE_RADIUS * 2.0f;
+        Vector2 position = {command.a * cellSize + cellSize * 0.5f,
+                            command.b * cellSize + cellSize * 0.5f};
+        if (IntrudesOtherColony(colonies, nullptr, position)) return false;
+
+        Colony* colony = new Colony();
+        colony->SetArchetype(resources.GetSiteArchetype(command.a, command.b));
+        colony->SetClock(clock);
+        colony->AddSect(new Sect(position, resources, time));
+        colonies.push_back(colony);
+        return true;
+    }
+
+    bool ApplyToColony(const Command& command, Colony& colony, ResourceManager& resources,
+                       TimeManager& time, const std::vector<Colony*>& colonies) {
+        const std::vector<Sect*>& sects = colony.GetSects();
+
+        switch (command.type) {
+            case CommandType::BUILD_SECT: {
+                Vector2 position = {command.x, command.y};
+                if (!std::isfinite(command.x) || !std::isfinite(command.y)) return false;
+                if (IntrudesOtherColony(colonies, &colony, position)) return false;
+                colony.AddSect(new Sect(position, resources, time));
+                return true;
+            }
+            case CommandType::BUILD_ROAD: {
+                Sect* sectA = AtIndex(sects, command.a);
+                Sect* sectB = AtIndex(sects, command.b);
+                if (!sectA || !sectB || sectA == sectB || colony.GetRoad(sectA, sectB)) return false;
+                colony.BuildRoad(sectA, sectB);
+                return true;
+            }
+            case CommandType::SET_ROAD_MODE: {
+                const std::vector<Road>& roads = colony.GetRoads();
+                if (!InRange(command.a, static_cast<int32_t>(roads.size()) - 1)) return false;
+                if (!InRange(command.b, static_cast<int32_t>(TransportMode::DEFICIT_TRIGGERED))) return false;
+                Road* road = colony.GetRoad(roads[command.a].sectA, roads[command.a].sectB);
+                if (!road) return false;
+                colony.SetRoadTransportMode(road, static_cast<TransportMode>(command.b));
+                return true;
+            }
+            case CommandType::UPGRADE_RESERVES:
+                if (!colony.CanUpgradeReserves()) return false;
+                colony.UpgradeReserves();
+                return true;
+            default:
+                return false;
+        }
+    }
+}
+
+void WriteCommand(ByteWriter& out, const Command& command) {
+    out.WriteEnum(command.type);
+    out.Write<int32_t>(command.colony);
+    out.Write<int32_t>(command.sect);
+    out.Write<int32_t>(command.unit);
+    out.Write<int32_t>(command.a);
+    out.Write<int32_t>(command.b);
+    out.Write<int32_t>(command.c);
+    out.Write<float>(command.value);
+    out.Write<float>(command.x);
+    out.Write<float>(command.y);
+}
+
+bool ReadCommand(ByteReader& in, Command& command) {
+    command.type = in.ReadEnum(static_cast<CommandType>(static_cast<int>(CommandType::COUNT) - 1));
+    command.colony = in.Read<int32_t>();
+    command.sect = in.Read<int32_t>();
+    command.unit = in.Read<int32_t>();
+    command.a = in.Read<int32_t>();
+    command.b = in.Read<int32_t>();
+    command.c = in.Read<int32_t>();
+    command.value = in.Read<float>();
+    command.x = in.Read<float>();
+    command.y = in.Read<float>();
+    return in.Ok();
+}
+
+bool ApplyCommand(const Command& command, ResourceManager& resources, TimeManager& time,
+                  std::vector<Colony*>& colonies, const SimClock* clock) {
+    switch (command.type) {
+        case CommandType::FOUND_COLONY:
+            return FoundColony(command, resources, time, colonies, clock);
+        case CommandType::UNLOCK_TECH: {
+            const std::vector<std::string>& techs = UnlockRegistry::GetAvailableTechs();
+            if (!InRange(command.a, static_cast<int32_t>(techs.size()) - 1)) return false;
+            UnlockRegistry& registry = UnlockRegistry::Instance();
+            if (registry.IsUnlocked(techs[command.a])) return false;
+            registry.Unlock(techs[command.a]);
+            return true;
+        }
+        default:
+            break;
+    }
+
+    Colony* colony = AtIndex(colonies, command.colony);
+    if (!colony) return false;
+
+    switch (command.type) {
+        case CommandType::BUILD_SECT:
+        case CommandType::BUILD_ROAD:
+        case CommandType::SET_ROAD_MODE:
+        case CommandType::UPGRADE_RESERVES:
+            return ApplyToColony(command, *colony, resources, time, colonies);
+        default:
+            break;
+    }
+
+    Sect* sect = AtIndex(colony->GetSects(), command.sect);
+    if (!sect) return false;
+
+    if (command.type == CommandType::UPGRADE_STORAGE) {
+        if (!sect->CanUpgradeStorage()) return false;
+        sect->UpgradeStorage();
+        return true;
+    }
+
+    Unit* unit = AtIndex(sect->GetUnits(), command.unit);
+    if (!unit) return false;
+    // The game clock stamps sweeps and lab steps, so replays stamp the same
+    return ApplyUnitCommand(command, *unit, time.GetGameTime());
+}
+
+bool ApplyUnitCommand(const Command& command, Unit& unit, float gameTime) {
+    switch (command.type) {
+        case CommandType::BUILD_MODULE:
+            if (!unit.PublicCanBuildModule(command.a)) return false;
+            unit.PublicBuildModule(command.a);
+            return true;
+        case CommandType::UPGRADE_MODULE:
+            return unit.UpgradeModule(command.a);
+        case CommandType::UPGRADE_MODULE_TIER:
+            return unit.UpgradeModuleTier(command.a);
+        case CommandType::DEBUG_UPGRADE_MODULE_TIER:
+            return unit.DebugUpgradeModuleTier(command.a);
+        case CommandType::TOGGLE_MODULE:
+            if (!InRange(command.a, static_cast<int32_t>(unit.GetModules().size()) - 1)) return false;
+            unit.PublicHandleModuleActivation(command.a);
+            return true;
+        case CommandType::SET_PRODUCTION_RATE:
+            if (!InRange(command.a, static_cast<int32_t>(unit.GetModules().size()) - 1)) return false;
+            if (!InRange(command.b, RESOURCE_TYPE_COUNT - 1) || !std::isfinite(command.value)) return false;
+            unit.SetModuleProductionRate(command.a, static_cast<ResourceType>(command.b), command.value);
+            return true;
+        case CommandType::SET_EXCAVATOR_DEPTH:
+            if (!std::isfinite(command.value)) return false;
+            unit.SetExcavatorDepth(command.a, command.value);
+            return true;
+        case CommandType::SET_EXCAVATOR_RATE:
+            if (!std::isfinite(command.value)) return false;
+            unit.SetExcavatorRate(command.a, command.value);
+            return true;
+        case CommandType::SWAP_SEPARATION_NODES:
+            unit.SwapSeparationNodes(command.a, command.b);
+            return true;
+        case CommandType::TOGGLE_SEPARATION_NODE:
+            unit.ToggleSeparationNodeActive(command.a);
+            return true;
+        case CommandType::SET_DIRECTIVE: {
+            if (!InRange(command.a, static_cast<int32_t>(Unit::DirectiveType::THERMAL_SYNC))) return false;
+            if (!InRange(command.b, RESOURCE_TYPE_COUNT - 1) || !std::isfinite(command.value)) return false;
+            Unit::ActiveDirective directive;
+            directive.type = static_cast<Unit::DirectiveType>(command.a);
+            directive.targetResource = static_cast<ResourceType>(command.b);
+            directive.strength = command.value;
+            unit.SetDirective(directive);
+            return true;
+        }
+        default:
+            break;
+    }
+
+    // Prospecting: the same checks the extraction view makes before it
+    // enables the button
+    ProspectingSystem* prospecting = unit.GetProspectingSystem();
+    if (!prospecting) return false;
+    const ProspectingSystem& view = *prospecting;
+
+    switch (command.type) {
+        case CommandType::PROSPECT_SWEEP:
+            if (!view.GetSweep().CanSweep(view.GetGrid(), command.a)) return false;
+            prospecting->gameTime = gameTime;
+            prospecting->GetSweep().ExecuteSweep(prospecting->GetGrid(), command.a, prospecting->gameTime);
+            return true;
+        case CommandType::PROSPECT_COLLECT: {
+            if (!InRange(command.c, static_cast<int32_t>(DepthLayer::DEEP))) return false;
+            DepthLayer depth = static_cast<DepthLayer>(command.c);
+            if (view.GetTray().IsFull() || !view.GetSampler().CanDrill(depth)) return false;
+            return prospecting->GetSampler().CollectSample(prospecting->GetGrid(), prospecting->GetTray(),
+                                                           command.a, command.b, depth);
+        }
+        case CommandType::PROSPECT_ANALYSE: {
+            if (!InRange(command.b, static_cast<int32_t>(AnalysisTool::MAGNETIC_SUSCEPTIBILITY))) return false;
+            AnalysisTool tool = static_cast<AnalysisTool>(command.b);
+            const Sample* sample = view.GetTray().GetSampleByIndex(command.a);
+            if (!sample || !view.GetLab().CanApplyTool(*sample, tool)) return false;
+            prospecting->gameTime = gameTime;
+            return prospecting->GetLab().ApplyTool(*prospecting->GetTray().GetSampleByIndex(command.a),
+                                                   tool, prospecting->gameTime);
+        }
+        case CommandType::PROSPECT_SEPARATE: {
+            if (!InRange(command.b, static_cast<int32_t>(SeparationMethod::VOLATILE_EXTRACTION))) return false;
+            SeparationMethod method = static_cast<SeparationMethod>(command.b);
+            const Sample* sample = view.GetTray().GetSampleByIndex(command.a);
+            if (!sample || !view.GetLab().CanApplySeparation(*sample, method)) return false;
+            prospecting->gameTime = gameTime;
+            return prospecting->GetLab().ApplySeparation(*prospecting->GetTray().GetSampleByIndex(command.a),
+                                                         method, prospecting->gameTime);
+        }
+        default:
+            return false;
+    }
+}
+
+bool LocateTarget(const std::vector<Colony*>& colonies, const Colony* colony, Command& command) {
+    for (size_t c = 0; c < colonies.size(); c++) {
+        if (colonies[c] == colony) {
+            command.colony = static_cast<int32_t>(c);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool LocateTarget(const std::vector<Colony*>& colonies, const Sect* sect, Command& command) {
+    for (size_t c = 0; c < colonies.size(); c++) {
+        const std::vector<Sect*>& sects = colonies[c]->GetSects();
+        for (size_t s = 0; s < sects.size(); s++) {
+            if (sects[s] == sect) {
+                command.colony = static_cast<int32_t>(c);
+                command.sect = static_cast<int32_t>(s);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool LocateTarget(const std::vector<Colony*>& colonies, const Unit* unit, Command& command) {
+    for (size_t c = 0; c < colonies.size(); c++) {
+        const std::vector<Sect*>& sects = colonies[c]->GetSects();
+        for (size_t s = 0; s < sects.size(); s++) {
+            const std::vector<Unit*>& units = sects[s]->GetUnits();
+            for (size_t u = 0; u < units.size(); u++) {
+                if (units[u] == unit) {
+                    command.colony = static_cast<int32_t>(c);
+                    command.sect = static_cast<int32_t>(s);
+                    command.unit = static_cast<int32_t>(u);
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+const char* GetCommandName(CommandType type) {
+    static const char* const names[] = {
+        "FOUND_COLONY", "BUILD_SECT", "BUILD_ROAD", "SET_ROAD_MODE", "UPGRADE_RESERVES",
+        "UPGRADE_STORAGE", "UNLOCK_TECH", "BUILD_MODULE", "UPGRADE_MODULE", "UPGRADE_MODULE_TIER",
+        "DEBUG_UPGRADE_MODULE_TIER", "TOGGLE_MODULE", "SET_PRODUCTION_RATE", "SET_EXCAVATOR_DEPTH",
+        "SET_EXCAVATOR_RATE", "SWAP_SEPARATION_NODES", "TOGGLE_SEPARATION_NODE", "SET_DIRECTIVE",
+        "PROSPECT_SWEEP", "PROSPECT_COLLECT", "PROSPECT_ANALYSE", "PROSPECT_SEPARATE"
+    };
+    static_assert(sizeof(names) / sizeof(names[0]) == static_cast<size_t>(CommandType::COUNT),
+                  "one name per command type");
+    int index = static_cast<int>(type);
+    return index >= 0 && index < static_cast<int>(CommandType::COUNT) ? names[index] : "UNKNOWN";
+}
+
+bool CommandSink::SubmitFor(const Colony* colony, Command command) {
+    if (!LocateTarget(GetCommandTargets(), colony, command)) return false;
+    return Submit(command);
+}
+
+bool CommandSink::SubmitFor(const Sect* sect, Command command) {
+    if (!LocateTarget(GetCommandTargets(), sect, command)) return false;
+    return Submit(command);
+}
+
+bool CommandSink::SubmitFor(const Unit* unit, Command command) {
+    if (!LocateTarget(GetCommandTargets(), unit, command)) return false;
+    return Submit(command);
+}
@@ -0,0 +1,106 @@
+#ifndef COMMAND_H
+#define COMMAND_H
+
+#include <cstdint>
+#include <vector>
+
+class ByteWriter;
+class ByteReader;
+class Colony;
+class Sect;
+class Unit;
+class ResourceManager;
+class TimeManager;
+class SimClock;
+
+// Every player action that changes the simulation, as plain data.
+//
+// Targets are addressed by index (colony, sect within it, unit within
+// that), never by pointer, so a command means the same thing against a
+// reloaded game as against the one it was issued in. The meaning of the
+// generic arguments a, b, c and value depends on the type, listed below.
+// Adding a type: append it (the values are stored in recordings), extend
+// ApplyCommand, and send the UI action through CommandSink.
+enum class CommandType : uint8_t {
+    FOUND_COLONY,               // a, b: planet grid cell
+    BUILD_SECT,                 // colony; x, y: world position
+    BUILD_ROAD,                 // colony; a, b: sect indices
+    SET_ROAD_MODE,              // colony; a: road index, b: TransportMode
+    UPGRADE_RESERVES,           // colony
+    UPGRADE_STORAGE,            // colony, sect
+    UNLOCK_TECH,                // a: index into UnlockRegistry::GetAvailableTechs
+    BUILD_MODULE,               // colony, sect, unit; a: module
+    UPGRADE_MODULE,             // unit; a: module (level)
+    UPGRADE_MODULE_TIER,        // unit; a: module
+    DEBUG_UPGRADE_MODULE_TIER,  // unit; a: module, tech and cost checks skipped
+    TOGGLE_MODULE,              // unit; a: module
+    SET_PRODUCTION_RATE,        // unit; a: module, b: ResourceType, value: rate
+    SET_EXCAVATOR_DEPTH,        // unit; a: excavator id, value: depth
+    SET_EXCAVATOR_RATE,         // unit; a: excavator id, value: rate
+    SWAP_SEPARATION_NODES,      // unit; a, b: node indices
+    TOGGLE_SEPARATION_NODE,     // unit; a: node index
+    SET_DIRECTIVE,              // unit; a: DirectiveType, b: ResourceType, value: strength
+    PROSPECT_SWEEP,             // unit; a: frequency band
+    PROSPECT_COLLECT,           // unit; a, b: sub-cell, c: DepthLayer
+    PROSPECT_ANALYSE,           // unit; a: tray index, b: AnalysisTool
+    PROSPECT_SEPARATE,          // unit; a: tray index, b: SeparationMethod
+    COUNT
+};
+
+struct Command {
+    CommandType type = CommandType::FOUND_COLONY;
+    int32_t colony = -1;
+    int32_t sect = -1;
+    int32_t unit = -1;
+    int32_t a = 0;
+    int32_t b = 0;
+    int32_t c = 0;
+    float value = 0.0f;
+    float x = 0.0f;
+    float y = 0.0f;
+
+    Command() = default;
+    explicit Command(CommandType type, int32_t a = 0, int32_t b = 0, int32_t c = 0, float value = 0.0f)
+        : type(type), a(a), b(b), c(c), value(value) {}
+};
+
+void WriteCommand(ByteWriter& out, const Command& command);
+bool ReadCommand(ByteReader& in, Command& command);
+
+// Carries the command out against the game. False, with nothing changed,
+// when a target index does not resolve or the action is refused (a colony
+// site inside another colony). New colonies get `clock` (Colony::SetClock).
+bool ApplyCommand(const Command& command, ResourceManager& resources, TimeManager& time,
+                  std::vector<Colony*>& colonies, const SimClock* clock);
+
+// The unit part of ApplyCommand, for a caller that holds the unit and has
+// no game to submit to (the view previews). `gameTime` stamps sweeps and
+// lab steps; ApplyCommand passes the TimeManager's.
+bool ApplyUnitCommand(const Command& command, Unit& unit, float gameTime);
+
+// Fills in the target indices of `command` for an object the caller
+// holds. False when it belongs to none of the colonies.
+bool LocateTarget(const std::vector<Colony*>& colonies, const Colony* colony, Command& command);
+bool LocateTarget(const std::vector<Colony*>& colonies, const Sect* sect, Command& command);
+bool LocateTarget(const std::vector<Colony*>& colonies, const Unit* unit, Command& command);
+
+const char* GetCommandName(CommandType type);
+
+// Where the UI sends player actions. GameManager carries them out and, if
+// a session is being recorded, records them.
+class CommandSink {
+public:
+    virtual ~CommandSink() = default;
+
+    virtual bool Submit(const Command& command) = 0;
+
+    // Addressed to an object the caller holds rather than by index
+    bool SubmitFor(const Colony* colony, Command command);
+    bool SubmitFor(const Sect* sect, Command command);
+    bool SubmitFor(const Unit* unit, Command command);
+
+protected:
+    virtual const std::vector<Colony*>& GetCommandTargets() const = 0;
+};
+
+#endif // COMMAND_H
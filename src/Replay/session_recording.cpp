@@ -0,0 +1,235 @@
+#include "session_recording.h"
+#include "save_file.h"
+#include "sim_stepper.h"
+#include "sim_scheduler.h"
+#include "sim_log.h"
+#include <chrono>
+
+namespace {
+    const uint32_t RECORDING_VERSION = 1;
+
+    void SetError(std::string* error, const std::string& message) {
+        if (error) *error = message;
+    }
+
+    uint64_t Fnv1a64(const uint8_t* data, size_t size) {
+        uint64_t hash = 14695981039346656037ull;
+        for (size_t i = 0; i < size; i++) {
+            hash ^= data[i];
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    struct Recording {
+        int hashInterval = 0;
+        float stepSeconds = 0.0f;
+        int steps = 0;
+        bool batchedModules = true;
+        double clockStart = 0.0;
+        uint64_t finalHash = 0;
+        std::vector<std::pair<int, Command>> commands;
+        std::vector<std::pair<int, uint64_t>> hashes;
+    };
+
+    bool ReadRecording(const std::string& path, Recording& recording, std::string* error) {
+        SaveFileReader reader;
+        if (!reader.Open(path, error)) return false;
+        if (!reader.HasSection(SaveGame::SECTION_RECORDING)) {
+            SetError(error, path + " is a save, not a session recording");
+            return false;
+        }
+
+        ByteReader in;
+        if (!reader.GetSection(SaveGame::SECTION_RECORDING, in, error)) return false;
+        if (in.Read<uint32_t>() != RECORDING_VERSION) {
+            SetError(error, path + " has an unknown recording version");
+            return false;
+        }
+        recording.hashInterval = in.Read<int32_t>();
+        recording.stepSeconds = in.Read<float>();
+        recording.steps = in.Read<int32_t>();
+        recording.batchedModules = in.ReadBool();
+        recording.clockStart = in.Read<double>();
+        recording.finalHash = in.Read<uint64_t>();
+
+        // Steps never go backwards: commands and hashes are in run order
+        int lastStep = 0;
+        recording.commands.resize(in.ReadCount(4 + 37));
+        for (auto& [step, command] : recording.commands) {
+            step = in.Read<int32_t>();
+            ReadCommand(in, command);
+            if (step < lastStep || step > recording.steps) in.Fail();
+            lastStep = step;
+        }
+        lastStep = 0;
+        recording.hashes.resize(in.ReadCount(4 + 8));
+        for (auto& [step, hash] : recording.hashes) {
+            step = in.Read<int32_t>();
+            hash = in.Read<uint64_t>();
+            if (step < lastStep || step > recording.steps) in.Fail();
+            lastStep = step;
+        }
+
+        if (!in.Ok() || recording.hashInterval <= 0 || !(recording.stepSeconds > 0.0f) || recording.steps < 0) {
+            SetError(error, "recording section is malformed");
+            return false;
+        }
+        return true;
+    }
+}
+
+uint64_t HashSimulationState(const ResourceManager& resources, const TimeManager& time,
+                             const std::vector<Colony*>& colonies, ByteWriter& scratch) {
+    scratch.GetBytes().clear();
+
+    // The clock without pause and time scale: those only decide how many
+    // steps a frame runs, not what a step does
+    scratch.Write<float>(time.GetGameTime());
+    scratch.Write<int32_t>(time.GetTicks());
+    SaveGame::WriteUnlocks(scratch);
+    for (const Colony* colony : colonies) {
+        colony->SaveState(scratch);
+    }
+    int cells = resources.GetGridSize() * resources.GetGridSize();
+    for (int cell = 0; cell < cells; cell++) {
+        resources.SaveCellState(scratch, cell);
+    }
+    return Fnv1a64(scratch.GetBytes().data(), scratch.GetSize());
+}
+
+SessionRecorder::SessionRecorder(int hashInterval)
+    : recording(false),
+      hashInterval(hashInterval > 0 ? hashInterval : REPLAY_HASH_INTERVAL_STEPS),
+      steps(0),
+      stepSeconds(SimScheduler::STEP_SECONDS),
+      batchedModules(true),
+      clockStart(0.0)
+{
+}
+
+void SessionRecorder::Begin(const ResourceManager& resources, const TimeManager& time,
+                            const std::vector<Colony*>& colonies, const SimStepper& stepper) {
+    start = SaveGame::Snapshot();
+    SaveGame::CaptureSnapshot(start, resources, time, colonies);
+    batchedModules = stepper.IsBatchingModules();
+    clockStart = stepper.GetClockTime();
+    commands.clear();
+    hashes.clear();
+    steps = 0;
+    recording = true;
+}
+
+bool SessionRecorder::WriteStart(const std::string& path, std::string* error) const {
+    return SaveGame::WriteSnapshot(path, start, true, error);
+}
+
+void SessionRecorder::Record(const Command& command) {
+    if (!recording) return;
+    commands.push_back({steps, command});
+}
+
+void SessionRecorder::AfterStep(const ResourceManager& resources, const TimeManager& time,
+                                const std::vector<Colony*>& colonies) {
+    if (!recording) return;
+    steps++;
+    if (steps % hashInterval == 0) {
+        hashes.push_back({steps, HashSimulationState(resources, time, colonies, scratch)});
+    }
+}
+
+bool SessionRecorder::Finish(const std::string& path, const ResourceManager& resources,
+                             const TimeManager& time, const std::vector<Colony*>& colonies,
+                             std::string* error) {
+    if (!recording) {
+        SetError(error, "not recording");
+        return false;
+    }
+    recording = false;
+
+    ByteWriter out;
+    out.Write<uint32_t>(RECORDING_VERSION);
+    out.Write<int32_t>(hashInterval);
+    out.Write<float>(stepSeconds);
+    out.Write<int32_t>(steps);
+    out.WriteBool(batchedModules);
+    out.Write<double>(clockStart);
+    out.Write<uint64_t>(HashSimulationState(resources, time, colonies, scratch));
+    out.WriteCount(commands.size());
+    for (const RecordedCommand& entry : commands) {
+        out.Write<int32_t>(entry.step);
+        WriteCommand(out, entry.command);
+    }
+    out.WriteCount(hashes.size());
+    for (const RecordedHash& entry : hashes) {
+        out.Write<int32_t>(entry.step);
+        out.Write<uint64_t>(entry.hash);
+    }
+
+    SaveFileWriter file;
+    SaveGame::AddSnapshotSections(file, start, true);
+    file.AddSection(SaveGame::SECTION_RECORDING, out, true);
+    return file.WriteTo(path, SaveGame::FORMAT_VERSION, error);
+}
+
+bool ReplaySession(const std::string& path, const ReplayOptions& options, SimStepper& stepper,
+                   ResourceManager& resources, TimeManager& time, std::vector<Colony*>& outColonies,
+                   ReplayReport& report, std::string* error) {
+    report = ReplayReport();
+    Recording recording;
+    if (!ReadRecording(path, recording, error)) return false;
+
+    // The stepper as the game had it, then the colonies on its clock
+    stepper.Release();
+    stepper.SetBatchedModules(recording.batchedModules);
+    stepper.SetClockTime(recording.clockStart);
+    if (!SaveGame::Load(path, resources, time, outColonies, error, stepper.GetClock())) return false;
+
+    std::vector<Colony*>& colonies = outColonies;
+    ByteWriter scratch;
+    size_t nextCommand = 0;
+    size_t nextHash = 0;
+    auto begin = std::chrono::steady_clock::now();
+
+    auto check = [&](int step, uint64_t expected) {
+        uint64_t actual = HashSimulationState(resources, time, colonies, scratch);
+        report.hashesChecked++;
+        if (actual == expected) return true;
+        if (report.mismatches++ == 0) {
+            report.firstMismatchStep = step;
+            report.expectedHash = expected;
+            report.actualHash = actual;
+        }
+        return false;
+    };
+
+    for (int step = 0; ; step++) {
+        while (nextCommand < recording.commands.size() && recording.commands[nextCommand].first == step) {
+            const Command& command = recording.commands[nextCommand++].second;
+            report.commands++;
+            if (!ApplyCommand(command, resources, time, colonies, stepper.GetClock())) {
+                report.rejectedCommands++;
+                COLONY_LOG_WARN(Input, "[REPLAY] " << GetCommandName(command.type)
+                                << " refused at step " << step);
+            }
+        }
+        if (step == recording.steps) break;
+
+        // As SimScheduler runs a tick: the clock first, then the step
+        time.Advance(recording.stepSeconds);
+        stepper.Step(colonies, recording.stepSeconds);
+        report.steps++;
+
+        bool matched = true;
+        while (nextHash < recording.hashes.size() && recording.hashes[nextHash].first == step + 1) {
+            matched = check(step + 1, recording.hashes[nextHash++].second) && matched;
+        }
+        if (!matched && options.stopAtMismatch) break;
+    }
+
+    if (report.mismatches == 0 || !options.stopAtMismatch) {
+        check(recording.steps, recording.finalHash);
+    }
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    return true;
+}
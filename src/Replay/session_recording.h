@@ -0,0 +1,108 @@
+#ifndef SESSION_RECORDING_H
+#define SESSION_RECORDING_H
+
+#include "command.h"
+#include "game_snapshot.h"
+#include "game_constants.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class SimStepper;
+
+// A play session on record, for bug repros and as a replayable workload:
+// the game as it stood when recording started, every command with the
+// step it was applied at, and a hash of the simulation state every
+// `hashInterval` steps.
+//
+// A recording is a save file (save_file.h) with one extra section, so the
+// snapshot sections load with SaveGame::Load like any save:
+//
+//   RECORDING  version, hash interval, step length, step count, batched
+//              modules flag, transport clock at the start, final hash,
+//              then (step, command) per command and (step, hash) per check
+//
+// Steps are SimStepper steps counted from the start; a command at step n
+// was applied after n steps had run. The hash covers what saves keep
+// (HashSimulationState), so a replay that agrees with every hash ended
+// every checked step in the same saved state.
+class SessionRecorder {
+public:
+    explicit SessionRecorder(int hashInterval = REPLAY_HASH_INTERVAL_STEPS);
+
+    // Takes the starting snapshot. The game has to carry on from the state
+    // a load of that snapshot produces (GameManager reloads it), or state
+    // the save leaves out could tell the run and its replay apart.
+    void Begin(const ResourceManager& resources, const TimeManager& time,
+               const std::vector<Colony*>& colonies, const SimStepper& stepper);
+    bool IsRecording() const { return recording; }
+
+    // Writes the starting snapshot alone, as a save file, to `path`
+    bool WriteStart(const std::string& path, std::string* error) const;
+
+    void Record(const Command& command);        // applied commands only
+    void AfterStep(const ResourceManager& resources, const TimeManager& time,
+                   const std::vector<Colony*>& colonies);
+
+    // Hashes the final state, writes the recording and stops
+    bool Finish(const std::string& path, const ResourceManager& resources, const TimeManager& time,
+                const std::vector<Colony*>& colonies, std::string* error);
+    void Cancel() { recording = false; }
+
+    int GetStepCount() const { return steps; }
+    size_t GetCommandCount() const { return commands.size(); }
+
+private:
+    struct RecordedCommand {
+        int step;
+        Command command;
+    };
+    struct RecordedHash {
+        int step;
+        uint64_t hash;
+    };
+
+    bool recording;
+    int hashInterval;
+    int steps;
+    float stepSeconds;
+    bool batchedModules;
+    double clockStart;
+    SaveGame::Snapshot start;
+    std::vector<RecordedCommand> commands;
+    std::vector<RecordedHash> hashes;
+    ByteWriter scratch;                         // reused by the hashes
+};
+
+struct ReplayOptions {
+    bool stopAtMismatch = true;     // else runs on and counts every mismatch
+};
+
+struct ReplayReport {
+    int steps = 0;
+    int commands = 0;
+    int rejectedCommands = 0;       // refused on replay: the run has diverged
+    int hashesChecked = 0;
+    int mismatches = 0;
+    int firstMismatchStep = -1;     // -1 when every hash agreed
+    uint64_t expectedHash = 0;      // at the first mismatch
+    uint64_t actualHash = 0;
+    double seconds = 0.0;           // stepping and hashing, load excluded
+};
+
+// Loads the recording's snapshot into `resources`, `time` and new colonies,
+// then steps it with `stepper` headless at full speed, applying each
+// command at its step and checking every recorded hash. The stepper's
+// clock and module batching are set to the recording's; the colonies read
+// that clock, so it has to outlive them. False only when the file cannot
+// be read; divergence is in the report. The caller owns `outColonies`.
+bool ReplaySession(const std::string& path, const ReplayOptions& options, SimStepper& stepper,
+                   ResourceManager& resources, TimeManager& time, std::vector<Colony*>& outColonies,
+                   ReplayReport& report, std::string* error);
+
+// FNV-1a over the clock, unlocks, colonies and planet cells as saves
+// write them. `scratch` is reused between calls.
+uint64_t HashSimulationState(const ResourceManager& resources, const TimeManager& time,
+                             const std::vector<Colony*>& colonies, ByteWriter& scratch);
+
+#endif // SESSION_RECORDING_H
@@ -1,15 +1,27 @@
 #include "resource_manager.h"
+#include "sim_log.h"
+#include "byte_stream.h"
+#include <atomic>
 
+namespace {
+    // Shared by every grid, so a chunk revision never repeats across a load
+    std::atomic<uint32_t> nextChunkRevision{1};
+
+    bool SameColor(Color a, Color b) {
+        return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+    }
+}
 
 ResourceManager::ResourceManager(int gridSize, float cellSize)
-    : gridSize(gridSize), cellSize(cellSize) {
+    : gridSize(gridSize), cellSize(cellSize), resourceMapVersion(0), overlayVersion(0), surveyVersion(0) {
     resourceGrid.resize(gridSize, std::vector<ResourceTile>(gridSize));
     surveyGrid.resize(gridSize, std::vector<OrbitalSurveyData>(gridSize));
     layeredGrid.resize(gridSize, std::vector<LayeredResourceTile>(gridSize));
+    ResetChangedCells();
 }
 
 void ResourceManager::GenerateResourceMap(unsigned int seed) {
-    std::cout << "Starting resource map generation for grid size: " << gridSize << std::endl;
+    COLONY_LOG_INFO(Planet, "Starting resource map generation for grid size: " << gridSize);
 
     // Clear existing resources
     resourceGrid = std::vector<std::vector<ResourceTile>>(
@@ -45,9 +57,9 @@ void ResourceManager::GenerateResourceMap(unsigned int seed) {
 
         float radius = radiusDist(gen);
 
-        std::cout << "\nGenerating cluster set " << i + 1
+        COLONY_LOG_DEBUG(Planet, "\nGenerating cluster set " << i + 1
                   << " at position (" << centerX << ", " << centerY
-                  << ") with base radius " << radius << std::endl;
+                  << ") with base radius " << radius);
 
 
         GenerateResourceCluster(ResourceType::H2, center, radius, 5000.0f);
@@ -60,11 +72,16 @@ void ResourceManager::GenerateResourceMap(unsigned int seed) {
         GenerateResourceCluster(ResourceType::Ca, center, radius * 0.7f, 2500.0f);
     }
 
+    resourceMapVersion++;
+    overlayVersion++;
+    ResetChangedCells();
+
     // Generate depth-layered resources from flat grid
     GenerateLayeredResources();
 
-    // Generate orbital survey data derived from resource clusters
-    GenerateOrbitalSurveyData();
+    // Generate orbital survey data derived from resource clusters. A
+    // seeded map gets seeded survey noise too, so the whole planet repeats.
+    GenerateOrbitalSurveyData(seed != 0 ? seed ^ 0x9E3779B9u : 0);
 }
 
 void ResourceManager::GenerateResourceCluster(ResourceType type, Vector2 center, float radius, float maxAbundance) {
@@ -74,16 +91,16 @@ void ResourceManager::GenerateResourceCluster(ResourceType type, Vector2 center,
     int startY = std::max(0, static_cast<int>(center.y - radius));
     int endY = std::min(gridSize - 1, static_cast<int>(center.y + radius));
 
-    std::cout << "Cluster bounds: (" << startX << "," << startY
-              << ") to (" << endX << "," << endY << ")" << std::endl;
+    COLONY_LOG_DEBUG(Planet, "Cluster bounds: (" << startX << "," << startY
+              << ") to (" << endX << "," << endY << ")");
 
     // Add extra validation in the drawing loop
     for (int x = startX; x <= endX; x++) {
         for (int y = startY; y <= endY; y++) {
             // Double-check bounds
             if (x < 0 || x >= gridSize || y < 0 || y >= gridSize) {
-                std::cout << "ERROR: Attempted to access out-of-bounds position: ("
-                          << x << "," << y << ")" << std::endl;
+                COLONY_LOG_ERROR(Planet, "ERROR: Attempted to access out-of-bounds position: ("
+                          << x << "," << y << ")");
                 continue;
             }
 
@@ -117,6 +134,9 @@ void ResourceManager::EnsureBasicResources(int x, int y) {
     for (const auto& [type, minValue] : minValues) {
         tile.resources[type] = std::max(tile.resources[type], minValue);
     }
+    resourceMapVersion++;
+    overlayVersion++;
+    MarkCellChanged(x, y);
 }
 
 std::vector<std::pair<ResourceType, float>> ResourceManager::GetResourcesAt(Vector2 worldPos) const{
@@ -160,12 +180,154 @@ Vector2 ResourceManager::WorldToGrid(Vector2 worldPos) const {
 
 void ResourceManager::UpdateResourceDepletion(int x , int y, ResourceType type, float amount) {
     if (x >= 0 && x < gridSize && y >= 0 && y < gridSize) {
-        resourceGrid[y][x].resources[type] =
-            std::max(0.0f, resourceGrid[y][x].resources[type] - amount);
+        float& abundance = resourceGrid[y][x].resources[type];
+        float depleted = std::max(0.0f, abundance - amount);
+        if (depleted != abundance) {
+            Color before = GetResourceDebugColor(x, y);
+            abundance = depleted;
+            resourceMapVersion++;
+            if (!SameColor(before, GetResourceDebugColor(x, y))) overlayVersion++;
+            MarkCellChanged(x, y);
+        }
     }
     //std::cout << "Resource " << type << " was depleted " << amount << "units" << std::endl;
 }
 
+void ResourceManager::ApplyDepletion(const std::vector<Depletion>& log) {
+    for (const Depletion& entry : log) {
+        UpdateResourceDepletion(entry.gridX, entry.gridY, entry.type, entry.amount);
+    }
+}
+
+void ResourceManager::SaveState(ByteWriter& out) const {
+    out.Write<int32_t>(gridSize);
+    out.Write<float>(cellSize);
+
+    for (int y = 0; y < gridSize; y++) {
+        for (int x = 0; x < gridSize; x++) {
+            const ResourceTile& tile = resourceGrid[y][x];
+            out.WriteResourceMap(tile.resources);
+            out.WriteBool(tile.isExploited);
+
+            const OrbitalSurveyData& survey = surveyGrid[y][x];
+            out.Write<float>(survey.fePercent);
+            out.Write<float>(survey.tiPercent);
+            out.Write<float>(survey.siPercent);
+            out.Write<float>(survey.alPercent);
+            out.Write<float>(survey.caPercent);
+            out.Write<float>(survey.thPpm);
+            out.Write<float>(survey.kPpm);
+            out.Write<float>(survey.hydrogenSignal);
+            out.Write<float>(survey.solarIllumination);
+            out.Write<float>(survey.terrainSlope);
+            out.Write<float>(survey.earthVisibility);
+
+            for (const auto& layer : layeredGrid[y][x].layers) {
+                out.WriteResourceMap(layer);
+            }
+        }
+    }
+}
+
+bool ResourceManager::LoadState(ByteReader& in) {
+    int size = in.Read<int32_t>();
+    float cell = in.Read<float>();
+    // Every cell takes at least its six map counts and the exploited flag
+    const size_t minCellBytes = 6 * 4 + 1;
+    if (size < 0 || !(cell > 0.0f) ||
+        static_cast<size_t>(size) * static_cast<size_t>(size) > in.GetRemaining() / minCellBytes) {
+        in.Fail();
+        return false;
+    }
+
+    gridSize = size;
+    cellSize = cell;
+    resourceGrid.assign(gridSize, std::vector<ResourceTile>(gridSize));
+    surveyGrid.assign(gridSize, std::vector<OrbitalSurveyData>(gridSize));
+    layeredGrid.assign(gridSize, std::vector<LayeredResourceTile>(gridSize));
+
+    for (int y = 0; y < gridSize && in.Ok(); y++) {
+        for (int x = 0; x < gridSize; x++) {
+            ResourceTile& tile = resourceGrid[y][x];
+            tile.resources = in.ReadResourceMap<float>();
+            tile.isExploited = in.ReadBool();
+
+            OrbitalSurveyData& survey = surveyGrid[y][x];
+            survey.fePercent = in.Read<float>();
+            survey.tiPercent = in.Read<float>();
+            survey.siPercent = in.Read<float>();
+            survey.alPercent = in.Read<float>();
+            survey.caPercent = in.Read<float>();
+            survey.thPpm = in.Read<float>();
+            survey.kPpm = in.Read<float>();
+            survey.hydrogenSignal = in.Read<float>();
+            survey.solarIllumination = in.Read<float>();
+            survey.terrainSlope = in.Read<float>();
+            survey.earthVisibility = in.Read<float>();
+
+            for (auto& layer : layeredGrid[y][x].layers) {
+                layer = in.ReadResourceMap<float>();
+            }
+        }
+    }
+
+    resourceMapVersion++;
+    overlayVersion++;
+    surveyVersion++;
+    ResetChangedCells();
+    return in.Ok();
+}
+
+void ResourceManager::MarkCellChanged(int x, int y) {
+    int cell = y * gridSize + x;
+    BumpChunkRevision(x, y);
+    if (!cellChanged[cell]) {
+        cellChanged[cell] = 1;
+        changedCells.push_back(cell);
+    }
+}
+
+void ResourceManager::BumpChunkRevision(int x, int y) {
+    chunkRevisions[(y / CELL_CHUNK_SIZE) * GetCellChunksPerSide() + x / CELL_CHUNK_SIZE] =
+        nextChunkRevision.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ResourceManager::ResetChangedCells() {
+    changedCells.clear();
+    cellChanged.assign(static_cast<size_t>(gridSize) * gridSize, 0);
+    int chunks = GetCellChunksPerSide();
+    chunkRevisions.assign(static_cast<size_t>(chunks) * chunks,
+                          nextChunkRevision.fetch_add(1, std::memory_order_relaxed));
+}
+
+void ResourceManager::TakeChangedCells(std::vector<int>& out) {
+    out.clear();
+    out.swap(changedCells);
+    for (int cell : out) cellChanged[cell] = 0;
+}
+
+// Only the tile: survey and layers never change after generation
+void ResourceManager::SaveCellState(ByteWriter& out, int cell) const {
+    const ResourceTile& tile = resourceGrid[cell / gridSize][cell % gridSize];
+    out.WriteResourceMap(tile.resources);
+    out.WriteBool(tile.isExploited);
+}
+
+bool ResourceManager::LoadCellState(ByteReader& in, int cell) {
+    if (cell < 0 || cell >= gridSize * gridSize) {
+        in.Fail();
+        return false;
+    }
+    ResourceTile& tile = resourceGrid[cell / gridSize][cell % gridSize];
+    Color before = GetResourceDebugColor(cell % gridSize, cell / gridSize);
+    tile.resources = in.ReadResourceMap<float>();
+    tile.isExploited = in.ReadBool();
+    resourceMapVersion++;
+    if (!SameColor(before, GetResourceDebugColor(cell % gridSize, cell / gridSize))) overlayVersion++;
+    BumpChunkRevision(cell % gridSize, cell / gridSize);
+    return in.Ok();
+}
+
 void ResourceManager::GenerateLayeredResources() {
     // Depth bias multipliers per layer per resource
     // Surface (0-10cm), Shallow (10-30cm), Mid (30-100cm), Deep (100-300cm)
@@ -205,7 +367,7 @@ void ResourceManager::GenerateLayeredResources() {
         }
     }
 
-    std::cout << "Layered resource data generated for " << gridSize << "x" << gridSize << " grid" << std::endl;
+    COLONY_LOG_INFO(Planet, "Layered resource data generated for " << gridSize << "x" << gridSize << " grid");
 }
 
 std::vector<std::pair<ResourceType, float>> ResourceManager::GetResourcesAtGridLayer(
@@ -228,9 +390,8 @@ std::vector<std::pair<ResourceType, float>> ResourceManager::GetResourcesAtGridL
     return result;
 }
 
-void ResourceManager::GenerateOrbitalSurveyData() {
-    std::random_device rd;
-    std::mt19937 gen(rd());
+void ResourceManager::GenerateOrbitalSurveyData(unsigned int seed) {
+    std::mt19937 gen(seed != 0 ? seed : std::random_device{}());
     std::uniform_real_distribution<float> noiseDist(-0.05f, 0.05f);
     std::uniform_real_distribution<float> slopeDist(0.0f, 15.0f);
 
@@ -308,7 +469,9 @@ void ResourceManager::GenerateOrbitalSurveyData() {
         }
     }
 
-    std::cout << "Orbital survey data generated for " << gridSize << "x" << gridSize << " grid" << std::endl;
+    surveyVersion++;
+
+    COLONY_LOG_INFO(Planet, "Orbital survey data generated for " << gridSize << "x" << gridSize << " grid");
 }
 
 ResourceManager::OrbitalSurveyData ResourceManager::GetOrbitalSurveyAt(int gridX, int gridY) const {
@@ -368,45 +531,24 @@ SiteArchetype ResourceManager::GetSiteArchetype(int gridX, int gridY) const {
     return result;
 }
 
-void ResourceManager::DrawResourceDebug(float scale) {
-    for (int y = 0; y < gridSize; y++) {
-        for (int x = 0; x < gridSize; x++) {
-            // Add bounds checking and debug output
-            if (x >= gridSize || y >= gridSize) {
-                std::cout << "ERROR: Attempting to draw outside grid bounds at ("
-                          << x << "," << y << ")" << std::endl;
-                continue;
-            }
-
-            Vector2 pos = GridToWorld(x, y);
-            const auto& tile = resourceGrid[y][x];
-
-            // Debug print for non-empty tiles
-            if (!tile.resources.empty()) {
-                std::cout << "Resources at (" << x << "," << y << "): ";
-                for (const auto& [type, abundance] : tile.resources) {
-                    std::cout << static_cast<int>(type) << ":" << abundance << " ";
-                }
-                std::cout << std::endl;
-            }
+Color ResourceManager::GetResourceDebugColor(int gridX, int gridY) const {
+    if (gridX < 0 || gridX >= gridSize || gridY < 0 || gridY >= gridSize) {
+        return BLANK;
+    }
 
-            // Draw the most abundant resource in this tile
-            if (!tile.resources.empty()) {
-                auto maxResource = std::max_element(
-                    tile.resources.begin(),
-                    tile.resources.end(),
-                    [](const auto& a, const auto& b) { return a.second < b.second; }
-                );
+    const auto& tile = resourceGrid[gridY][gridX];
+    if (tile.resources.empty()) {
+        return BLANK;
+    }
 
-                Color color = ResourceUtils::GetResourceColor(maxResource->first);
-                color.a = static_cast<unsigned char>(255 * maxResource->second);
+    // The most abundant resource in this tile
+    auto maxResource = std::max_element(
+        tile.resources.begin(),
+        tile.resources.end(),
+        [](const auto& a, const auto& b) { return a.second < b.second; }
+    );
 
-                DrawRectangle(
-                    pos.x, pos.y,
-                    cellSize, cellSize,
-                    color
-                );
-            }
-        }
-    }
+    Color color = ResourceUtils::GetResourceColor(maxResource->first);
+    color.a = static_cast<unsigned char>(255 * std::clamp(maxResource->second, 0.0f, 1.0f));
+    return color;
 }
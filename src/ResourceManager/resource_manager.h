@@ -1,6 +1,7 @@
 #ifndef RESOURCE_MANAGER_H
 #define RESOURCE_MANAGER_H
 
+#include <cstdint>
 #include <vector>
 #include <map>
 #include <iostream>
@@ -13,6 +14,9 @@
 #include "game_constants.h"
 #include "game_enums.h"
 
+class ByteWriter;
+class ByteReader;
+
 class ResourceManager {
 public:
     struct OrbitalSurveyData {
@@ -50,17 +54,66 @@ public:
     void GenerateResourceMap(unsigned int seed = 0);
     std::vector<std::pair<ResourceType, float>> GetResourcesAt(Vector2 worldPos) const;
     std::vector<std::pair<ResourceType, float>> GetResourcesAtGrid(int gridX, int gridY) const;
-    void DrawResourceDebug(float scale);  // For debugging resource distribution
     void EnsureBasicResources(int x, int y);  // Ensures starting location has basic resources
     void UpdateResourceDepletion(int gridX , int gridY, ResourceType type, float amount);
 
+    // An UpdateResourceDepletion call recorded during a parallel step.
+    // Applying a log runs the calls in recorded order, so applying per-sect
+    // logs in sect order gives exactly the serial result.
+    struct Depletion {
+        int gridX;
+        int gridY;
+        ResourceType type;
+        float amount;
+    };
+    void ApplyDepletion(const std::vector<Depletion>& log);
+
     // Depth layer system
     std::vector<std::pair<ResourceType, float>> GetResourcesAtGridLayer(int gridX, int gridY, DepthLayer layer) const;
 
     // Orbital survey system
     OrbitalSurveyData GetOrbitalSurveyAt(int gridX, int gridY) const;
     SiteArchetype GetSiteArchetype(int gridX, int gridY) const;
-    void GenerateOrbitalSurveyData();
+    void GenerateOrbitalSurveyData(unsigned int seed = 0);    // 0: unseeded noise
+
+    // Grid geometry and change tracking for cached overlays. The resource
+    // version bumps whenever any cell's abundances change (generation,
+    // EnsureBasicResources, depletion); the overlay version only when a
+    // cell's GetResourceDebugColor changes with them, which depletion
+    // seldom does; the survey version only when the orbital survey is
+    // regenerated.
+    int GetGridSize() const { return gridSize; }
+    float GetCellSize() const { return cellSize; }
+    unsigned int GetResourceMapVersion() const { return resourceMapVersion; }
+    unsigned int GetOverlayVersion() const { return overlayVersion; }
+    unsigned int GetSurveyVersion() const { return surveyVersion; }
+
+    // Debug colour of a cell: colour of its most abundant resource, alpha
+    // by abundance. BLANK for empty or out-of-range cells.
+    Color GetResourceDebugColor(int gridX, int gridY) const;
+
+    // Save game snapshot of every grid. Loading may change the grid size
+    // and bumps both versions so cached overlays rebuild.
+    void SaveState(ByteWriter& out) const;
+    bool LoadState(ByteReader& in);
+
+    // Cells whose abundances changed (depletion, EnsureBasicResources)
+    // since the last call, each once, as y * gridSize + x. Generation and
+    // loading clear the list: they are covered by a full save, not by
+    // per-cell records.
+    void TakeChangedCells(std::vector<int>& out);
+    void SaveCellState(ByteWriter& out, int cell) const;
+    bool LoadCellState(ByteReader& in, int cell);
+
+    // The grid in CELL_CHUNK_SIZE square chunks, chunk = cy * chunks + cx,
+    // each with a revision that moves on whenever one of its cells changes
+    // (LoadCellState included) and when the grid is generated or loaded.
+    // Revisions are unique across every ResourceManager in the process.
+    // Unlike the changed-cell list any number of readers can compare them
+    // (RewindBuffer).
+    static constexpr int CELL_CHUNK_SIZE = 8;
+    int GetCellChunksPerSide() const { return (gridSize + CELL_CHUNK_SIZE - 1) / CELL_CHUNK_SIZE; }
+    uint32_t GetCellChunkRevision(int chunk) const { return chunkRevisions[chunk]; }
 
 
     void DisplayResourceGrid(Vector2& wordlPos) {
@@ -122,6 +175,16 @@ private:
     std::vector<std::vector<ResourceTile>> resourceGrid;
     std::vector<std::vector<OrbitalSurveyData>> surveyGrid;
     std::vector<std::vector<LayeredResourceTile>> layeredGrid;
+    unsigned int resourceMapVersion;
+    unsigned int overlayVersion;
+    unsigned int surveyVersion;
+    std::vector<int> changedCells;
+    std::vector<uint8_t> cellChanged;   // per cell: already in changedCells
+    std::vector<uint32_t> chunkRevisions;
+
+    void MarkCellChanged(int x, int y);
+    void BumpChunkRevision(int x, int y);
+    void ResetChangedCells();
 
     void GenerateResourceCluster(ResourceType type, Vector2 center, float radius, float maxAbundance);
     void GenerateLayeredResources();
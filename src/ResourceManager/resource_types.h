@@ -1,6 +1,8 @@
 #ifndef RESOURCE_TYPES_H
 #define RESOURCE_TYPES_H
 
+#include <array>
+#include <cstddef>
 #include <string>
 #include <map>
 #include <vector>
@@ -52,6 +54,21 @@ struct TypedResource {
     TypedResource() : baseType(ResourceType::MACHINERY), subType(""), efficiency(1.0f) {}
 };
 
+constexpr int RESOURCE_TYPE_COUNT = static_cast<int>(ResourceType::CONSTRUCTION_MATERIALS) + 1;
+
+// Read-only view of a typed resource's subtype names (empty for SINGULAR)
+struct SubtypeList
+{
+    const char* const* names = nullptr;
+    int count = 0;
+
+    constexpr size_t size() const { return static_cast<size_t>(count); }
+    constexpr bool empty() const { return count == 0; }
+    constexpr const char* operator[](size_t i) const { return names[i]; }
+    constexpr const char* const* begin() const { return names; }
+    constexpr const char* const* end() const { return names + count; }
+};
+
 // Single source of truth for all per-resource metadata
 struct ResourceDescriptor
 {
@@ -59,12 +76,23 @@ struct ResourceDescriptor
     ResourceCategory category;
     const char* name;
     Color color;
-    std::vector<std::string> subtypes;  // Empty for SINGULAR
+    SubtypeList subtypes;  // Empty for SINGULAR
 };
 
-inline const std::vector<ResourceDescriptor>& GetResourceDescriptors()
-{
-    static const std::vector<ResourceDescriptor> descriptors = {
+namespace ResourceTables {
+    inline constexpr const char* MACHINERY_SUBTYPES[] = {"HeavyDrill", "Conveyor", "Assembler"};
+    inline constexpr const char* ELECTRONICS_SUBTYPES[] = {"Sensor", "Controller", "Computer"};
+    inline constexpr const char* ALLOYS_SUBTYPES[] = {"Steel", "Bronze", "Aluminum", "Titanium"};
+    inline constexpr const char* CONSTRUCTION_SUBTYPES[] = {"Beam", "Panel", "Pipe", "Cable"};
+
+    template <size_t N>
+    constexpr SubtypeList Subtypes(const char* const (&names)[N])
+    {
+        return SubtypeList{names, static_cast<int>(N)};
+    }
+
+    // Indexed by ResourceType; entries must stay in enum order
+    inline constexpr std::array<ResourceDescriptor, RESOURCE_TYPE_COUNT> DESCRIPTORS = {{
         // Tier 1 - Raw singular
         {ResourceType::ENERGY,   ResourceCategory::SINGULAR, "ENERGY",   {128, 128, 128, 255}, {}},
         {ResourceType::H2,       ResourceCategory::SINGULAR, "H2",       {150, 150, 255, 255}, {}},
@@ -83,20 +111,62 @@ inline const std::vector<ResourceDescriptor>& GetResourceDescriptors()
         {ResourceType::SCIENCE,  ResourceCategory::SINGULAR, "SCIENCE",  {128, 128, 128, 255}, {}},
         {ResourceType::MANPOWER, ResourceCategory::SINGULAR, "MANPOWER", {128, 128, 128, 255}, {}},
         // Tier 2/3 - Manufactured typed
-        {ResourceType::MACHINERY,              ResourceCategory::TYPED, "MACHINERY",              {180, 180, 180, 255}, {"HeavyDrill", "Conveyor", "Assembler"}},
-        {ResourceType::ELECTRONICS,            ResourceCategory::TYPED, "ELECTRONICS",            {0, 200, 200, 255},   {"Sensor", "Controller", "Computer"}},
-        {ResourceType::ALLOYS,                 ResourceCategory::TYPED, "ALLOYS",                 {200, 150, 50, 255},  {"Steel", "Bronze", "Aluminum", "Titanium"}},
-        {ResourceType::CONSTRUCTION_MATERIALS, ResourceCategory::TYPED, "CONSTRUCTION_MATERIALS", {150, 100, 70, 255},  {"Beam", "Panel", "Pipe", "Cable"}},
-    };
-    return descriptors;
+        {ResourceType::MACHINERY,              ResourceCategory::TYPED, "MACHINERY",              {180, 180, 180, 255}, Subtypes(MACHINERY_SUBTYPES)},
+        {ResourceType::ELECTRONICS,            ResourceCategory::TYPED, "ELECTRONICS",            {0, 200, 200, 255},   Subtypes(ELECTRONICS_SUBTYPES)},
+        {ResourceType::ALLOYS,                 ResourceCategory::TYPED, "ALLOYS",                 {200, 150, 50, 255},  Subtypes(ALLOYS_SUBTYPES)},
+        {ResourceType::CONSTRUCTION_MATERIALS, ResourceCategory::TYPED, "CONSTRUCTION_MATERIALS", {150, 100, 70, 255},  Subtypes(CONSTRUCTION_SUBTYPES)},
+    }};
+
+    constexpr bool InEnumOrder()
+    {
+        for (int i = 0; i < RESOURCE_TYPE_COUNT; i++)
+        {
+            if (static_cast<int>(DESCRIPTORS[i].type) != i) return false;
+        }
+        return true;
+    }
+    static_assert(InEnumOrder(), "ResourceTables::DESCRIPTORS must be indexed by ResourceType");
+
+    constexpr int CountCategory(ResourceCategory category)
+    {
+        int n = 0;
+        for (const auto& desc : DESCRIPTORS)
+        {
+            if (desc.category == category) n++;
+        }
+        return n;
+    }
+
+    template <size_t N>
+    constexpr std::array<ResourceType, N> ListCategory(ResourceCategory category)
+    {
+        std::array<ResourceType, N> out{};
+        size_t n = 0;
+        for (const auto& desc : DESCRIPTORS)
+        {
+            if (desc.category == category) out[n++] = desc.type;
+        }
+        return out;
+    }
+}
+
+// Every resource type of each category, in enum order
+inline constexpr auto SINGULAR_RESOURCE_TYPES =
+    ResourceTables::ListCategory<ResourceTables::CountCategory(ResourceCategory::SINGULAR)>(ResourceCategory::SINGULAR);
+inline constexpr auto TYPED_RESOURCE_TYPES =
+    ResourceTables::ListCategory<ResourceTables::CountCategory(ResourceCategory::TYPED)>(ResourceCategory::TYPED);
+
+constexpr const std::array<ResourceDescriptor, RESOURCE_TYPE_COUNT>& GetResourceDescriptors()
+{
+    return ResourceTables::DESCRIPTORS;
 }
 
 inline const ResourceDescriptor& GetResourceDescriptor(ResourceType type)
 {
-    const auto& descriptors = GetResourceDescriptors();
-    for (const auto& desc : descriptors)
+    int index = static_cast<int>(type);
+    if (index >= 0 && index < RESOURCE_TYPE_COUNT)
     {
-        if (desc.type == type) return desc;
+        return ResourceTables::DESCRIPTORS[index];
     }
     // Fallback - should never happen with valid enum values
     static const ResourceDescriptor unknown = {
@@ -136,7 +206,7 @@ namespace ResourceUtils {
         return GetResourceDescriptor(type).color;
     }
 
-    inline std::vector<std::string> GetSubtypes(ResourceType type)
+    inline SubtypeList GetSubtypes(ResourceType type)
     {
         return GetResourceDescriptor(type).subtypes;
     }
@@ -144,10 +214,9 @@ namespace ResourceUtils {
     // Check if subtype is valid for a resource type
     inline bool IsValidSubtype(ResourceType type, const std::string& subtype)
     {
-        const auto& subtypes = GetSubtypes(type);
-        for (const auto& s : subtypes)
+        for (const char* s : GetSubtypes(type))
         {
-            if (s == subtype) return true;
+            if (subtype == s) return true;
         }
         return false;
     }
@@ -0,0 +1,171 @@
+#ifndef RESOURCE_VECTOR_H
+#define RESOURCE_VECTOR_H
+
+#include "resource_types.h"
+#include <algorithm>
+#include <cstdint>
+#include <initializer_list>
+#include <utility>
+
+// Per-resource amounts (storage, capacities, rates) as one fixed array
+// indexed by ResourceType. Stands in for std::map<ResourceType, float> on
+// the economy's hot paths: lookups are an index, nothing allocates.
+//
+// A presence mask keeps the map's idea of which resources an entry has.
+// operator[] marks a resource present, iteration visits present resources
+// in enum order (the order the map iterated in), Get() reads absent ones
+// as 0. Absent lanes always hold 0, so the whole-vector operations below
+// run straight across the padded array - fixed-length loops the compiler
+// turns into SIMD - without looking at the mask. They assume amounts are
+// non-negative, which every economy quantity is.
+class ResourceVector {
+public:
+    static const int LANES = (RESOURCE_TYPE_COUNT + 3) & ~3;   // whole 4-float registers
+
+    // What iteration yields; `for (auto [type, amount] : v)` writes through
+    struct Entry {
+        ResourceType type;
+        float& value;
+    };
+    struct ConstEntry {
+        ResourceType type;
+        float value;
+    };
+
+    template <typename Vec, typename Ref>
+    class BasicIterator {
+    public:
+        BasicIterator(Vec* v, int i) : vec(v), index(i) { SkipAbsent(); }
+        Ref operator*() const { return Ref{static_cast<ResourceType>(index), vec->values[index]}; }
+        BasicIterator& operator++() { ++index; SkipAbsent(); return *this; }
+        bool operator==(const BasicIterator& other) const { return index == other.index; }
+        bool operator!=(const BasicIterator& other) const { return index != other.index; }
+
+    private:
+        void SkipAbsent() {
+            while (index < RESOURCE_TYPE_COUNT && (vec->mask & (1u << index)) == 0) ++index;
+        }
+        Vec* vec;
+        int index;
+    };
+    using iterator = BasicIterator<ResourceVector, Entry>;
+    using const_iterator = BasicIterator<const ResourceVector, ConstEntry>;
+
+    ResourceVector() : values{}, mask(0) {}
+    ResourceVector(std::initializer_list<std::pair<ResourceType, float>> entries) : values{}, mask(0) {
+        for (const auto& entry : entries) (*this)[entry.first] = entry.second;
+    }
+
+    // Element access
+    float& operator[](ResourceType type) {
+        mask |= Bit(type);
+        return values[Index(type)];
+    }
+    float Get(ResourceType type) const { return values[Index(type)]; }
+    bool Has(ResourceType type) const { return (mask & Bit(type)) != 0; }
+    void Erase(ResourceType type) {
+        values[Index(type)] = 0.0f;
+        mask &= ~Bit(type);
+    }
+    void Clear() { *this = ResourceVector(); }
+
+    bool Empty() const { return mask == 0; }
+    int Count() const {
+        int n = 0;
+        for (uint32_t m = mask; m != 0; m &= m - 1) n++;
+        return n;
+    }
+    uint32_t GetMask() const { return mask; }
+    const float* Data() const { return values; }
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, RESOURCE_TYPE_COUNT); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, RESOURCE_TYPE_COUNT); }
+
+    // Whole-vector arithmetic. Results are present wherever either input was.
+    ResourceVector& operator+=(const ResourceVector& other) {
+        for (int i = 0; i < LANES; i++) values[i] += other.values[i];
+        mask |= other.mask;
+        return *this;
+    }
+    ResourceVector& operator-=(const ResourceVector& other) {
+        for (int i = 0; i < LANES; i++) values[i] -= other.values[i];
+        mask |= other.mask;
+        return *this;
+    }
+    ResourceVector& operator*=(float scale) {
+        for (int i = 0; i < LANES; i++) values[i] *= scale;
+        return *this;
+    }
+    // this += other * scale (rates * dt into storage)
+    void AddScaled(const ResourceVector& other, float scale) {
+        for (int i = 0; i < LANES; i++) values[i] += other.values[i] * scale;
+        mask |= other.mask;
+    }
+
+    // this -= rates * scale, flooring each drained resource at 0. Only the
+    // resources `rates` has are touched, as the per-entry map loop did.
+    void Drain(const ResourceVector& rates, float scale) {
+        for (int i = 0; i < LANES; i++) {
+            float drained = std::max(0.0f, values[i] - rates.values[i] * scale);
+            values[i] = ((rates.mask >> i) & 1u) ? drained : values[i];
+        }
+        mask |= rates.mask;
+    }
+
+    // this += amounts, up to `capacity`; what does not fit goes into
+    // `overflow`. Resources without a capacity entry take the full amount.
+    // Per resource this is Unit::AddResource, presence included.
+    void Deposit(const ResourceVector& amounts, const ResourceVector& capacity, ResourceVector& overflow) {
+        uint32_t spilled = 0;
+        for (int i = 0; i < LANES; i++) {
+            float space = capacity.values[i] - values[i];
+            float stored = ((capacity.mask >> i) & 1u)
+                ? std::min(amounts.values[i], std::max(0.0f, space))
+                : amounts.values[i];
+            spilled |= (space >= amounts.values[i] ? 0u : 1u) << i;
+            overflow.values[i] += amounts.values[i] - stored;
+            values[i] += stored;
+        }
+        overflow.mask |= spilled & amounts.mask & capacity.mask;
+        mask |= amounts.mask;
+    }
+
+    // Element-wise min against another vector (absent there reads as 0)
+    void Min(const ResourceVector& other) {
+        for (int i = 0; i < LANES; i++) values[i] = std::min(values[i], other.values[i]);
+    }
+    // Clamps every lane to [lo, hi]; lo <= 0 keeps absent lanes at 0
+    void Clamp(float lo, float hi) {
+        for (int i = 0; i < LANES; i++) values[i] = std::max(lo, std::min(values[i], hi));
+    }
+    // Clamps every lane to [0, capacity]
+    void ClampTo(const ResourceVector& capacity) {
+        for (int i = 0; i < LANES; i++) values[i] = std::max(0.0f, std::min(values[i], capacity.values[i]));
+    }
+
+    float Dot(const ResourceVector& other) const {
+        float sum = 0.0f;
+        for (int i = 0; i < LANES; i++) sum += values[i] * other.values[i];
+        return sum;
+    }
+    float Sum() const {
+        float sum = 0.0f;
+        for (int i = 0; i < LANES; i++) sum += values[i];
+        return sum;
+    }
+
+private:
+    static int Index(ResourceType type) { return static_cast<int>(type); }
+    static uint32_t Bit(ResourceType type) { return 1u << static_cast<int>(type); }
+
+    alignas(16) float values[LANES];
+    uint32_t mask;
+};
+
+inline ResourceVector operator+(ResourceVector a, const ResourceVector& b) { return a += b; }
+inline ResourceVector operator-(ResourceVector a, const ResourceVector& b) { return a -= b; }
+inline ResourceVector operator*(ResourceVector a, float scale) { return a *= scale; }
+
+#endif // RESOURCE_VECTOR_H
@@ -0,0 +1,237 @@
+#include "typed_inventory.h"
+#include "byte_stream.h"
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+namespace {
+
+// Colonies step on worker threads, so interning takes a lock. Names live
+// in a deque so references handed out stay valid as it grows.
+struct SubtypeRegistry {
+    std::mutex mutex;
+    std::deque<std::string> names;
+    std::unordered_map<std::string, SubtypeId> ids;
+
+    SubtypeRegistry() {
+        for (ResourceType type : TYPED_RESOURCE_TYPES) {
+            for (const char* name : ResourceUtils::GetSubtypes(type)) {
+                InternLocked(name);
+            }
+        }
+    }
+
+    SubtypeId InternLocked(const std::string& name) {
+        auto it = ids.find(name);
+        if (it != ids.end()) return it->second;
+
+        SubtypeId id = static_cast<SubtypeId>(names.size());
+        names.push_back(name);
+        ids.emplace(name, id);
+        return id;
+    }
+};
+
+SubtypeRegistry& Registry() {
+    static SubtypeRegistry registry;
+    return registry;
+}
+
+// Inventories index their per-type stock by offset from the first typed type
+constexpr int FIRST_TYPED = static_cast<int>(TYPED_RESOURCE_TYPES[0]);
+static_assert(static_cast<int>(TYPED_RESOURCE_TYPES[TYPED_RESOURCE_TYPES.size() - 1]) - FIRST_TYPED + 1 ==
+              static_cast<int>(TYPED_RESOURCE_TYPES.size()), "typed resources must be contiguous in ResourceType");
+
+} // namespace
+
+SubtypeId InternSubtype(const std::string& name) {
+    SubtypeRegistry& registry = Registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    return registry.InternLocked(name);
+}
+
+bool FindSubtype(const std::string& name, SubtypeId& outId) {
+    SubtypeRegistry& registry = Registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    auto it = registry.ids.find(name);
+    if (it == registry.ids.end()) return false;
+    outId = it->second;
+    return true;
+}
+
+const std::string& SubtypeName(SubtypeId id) {
+    SubtypeRegistry& registry = Registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    static const std::string unknown;
+    return id < registry.names.size() ? registry.names[id] : unknown;
+}
+
+TypedInventory::TypedInventory(int capacity) : capacity(capacity) {
+}
+
+TypedInventory::TypeStock* TypedInventory::Find(ResourceType type) {
+    int slot = static_cast<int>(type) - FIRST_TYPED;
+    if (slot < 0 || slot >= TYPE_SLOTS) return nullptr;
+    return &stocks[slot];
+}
+
+const TypedInventory::TypeStock* TypedInventory::Find(ResourceType type) const {
+    int slot = static_cast<int>(type) - FIRST_TYPED;
+    if (slot < 0 || slot >= TYPE_SLOTS) return nullptr;
+    return &stocks[slot];
+}
+
+void TypedInventory::Deposit(TypeStock& stock, SubtypeId subtype, float efficiency, int count) {
+    if (subtype >= stock.bySubtype.size()) {
+        stock.bySubtype.resize(subtype + 1);
+    }
+    SubtypeStock& sub = stock.bySubtype[subtype];
+
+    // A subtype rarely has more than one efficiency, so this is one compare
+    auto bucket = std::find_if(sub.buckets.begin(), sub.buckets.end(),
+                               [efficiency](const Bucket& b) { return b.efficiency == efficiency; });
+    if (bucket != sub.buckets.end()) {
+        bucket->count += count;
+    } else {
+        sub.buckets.push_back({efficiency, count});
+    }
+
+    if (sub.count == 0) {
+        sub.stockedIndex = static_cast<int>(stock.stocked.size());
+        stock.stocked.push_back(subtype);
+    }
+    sub.count += count;
+    stock.total += count;
+}
+
+void TypedInventory::Withdraw(TypeStock& stock, SubtypeId subtype, int bucketIndex, int count) {
+    SubtypeStock& sub = stock.bySubtype[subtype];
+    Bucket& bucket = sub.buckets[bucketIndex];
+
+    bucket.count -= count;
+    if (bucket.count == 0) {
+        sub.buckets.erase(sub.buckets.begin() + bucketIndex);
+    }
+    sub.count -= count;
+    stock.total -= count;
+
+    if (sub.count == 0) {
+        // Swap-remove from the stocked list
+        SubtypeId last = stock.stocked.back();
+        stock.stocked[sub.stockedIndex] = last;
+        stock.bySubtype[last].stockedIndex = sub.stockedIndex;
+        stock.stocked.pop_back();
+        sub.stockedIndex = -1;
+    }
+}
+
+bool TypedInventory::Add(const TypedResource& item) {
+    return Add(item.baseType, InternSubtype(item.subType), item.efficiency);
+}
+
+bool TypedInventory::Add(ResourceType type, SubtypeId subtype, float efficiency) {
+    TypeStock* stock = Find(type);
+    if (!stock || stock->total >= capacity) return false;
+
+    Deposit(*stock, subtype, efficiency, 1);
+    return true;
+}
+
+bool TypedInventory::Remove(ResourceType type, SubtypeId subtype) {
+    TypeStock* stock = Find(type);
+    if (!stock || subtype >= stock->bySubtype.size() || stock->bySubtype[subtype].count == 0) {
+        return false;
+    }
+
+    const int newest = static_cast<int>(stock->bySubtype[subtype].buckets.size()) - 1;
+    Withdraw(*stock, subtype, newest, 1);
+    return true;
+}
+
+bool TypedInventory::TakeAny(ResourceType type, TypedResource& outItem) {
+    TypeStock* stock = Find(type);
+    if (!stock || stock->total == 0) return false;
+
+    SubtypeId subtype = stock->stocked.back();
+    const SubtypeStock& sub = stock->bySubtype[subtype];
+    const int newest = static_cast<int>(sub.buckets.size()) - 1;
+
+    outItem = TypedResource(type, SubtypeName(subtype), sub.buckets[newest].efficiency);
+    Withdraw(*stock, subtype, newest, 1);
+    return true;
+}
+
+int TypedInventory::MoveTo(TypedInventory& dest, ResourceType type, int count) {
+    TypeStock* stock = Find(type);
+    TypeStock* destStock = dest.Find(type);
+    if (!stock || !destStock || &dest == this) return 0;
+
+    int remaining = std::min({count, stock->total, dest.GetFreeSpace(type)});
+    int moved = 0;
+    while (remaining > 0) {
+        SubtypeId subtype = stock->stocked.back();
+        const SubtypeStock& sub = stock->bySubtype[subtype];
+        const int newest = static_cast<int>(sub.buckets.size()) - 1;
+        const Bucket bucket = sub.buckets[newest];
+        const int take = std::min(remaining, bucket.count);
+
+        Withdraw(*stock, subtype, newest, take);
+        dest.Deposit(*destStock, subtype, bucket.efficiency, take);
+        remaining -= take;
+        moved += take;
+    }
+    return moved;
+}
+
+int TypedInventory::GetCount(ResourceType type, SubtypeId subtype) const {
+    const TypeStock* stock = Find(type);
+    if (!stock || subtype >= stock->bySubtype.size()) return 0;
+    return stock->bySubtype[subtype].count;
+}
+
+int TypedInventory::GetCount(ResourceType type) const {
+    const TypeStock* stock = Find(type);
+    return stock ? stock->total : 0;
+}
+
+int TypedInventory::GetFreeSpace(ResourceType type) const {
+    const TypeStock* stock = Find(type);
+    return stock ? std::max(0, capacity - stock->total) : 0;
+}
+
+void TypedInventory::SaveState(ByteWriter& out) const {
+    for (const TypeStock& stock : stocks) {
+        out.WriteCount(stock.stocked.size());
+        for (SubtypeId subtype : stock.stocked) {
+            const SubtypeStock& sub = stock.bySubtype[subtype];
+            out.WriteString(SubtypeName(subtype));
+            out.WriteCount(sub.buckets.size());
+            for (const Bucket& bucket : sub.buckets) {
+                out.Write<float>(bucket.efficiency);
+                out.Write<int32_t>(bucket.count);
+            }
+        }
+    }
+}
+
+bool TypedInventory::LoadState(ByteReader& in) {
+    for (TypeStock& stock : stocks) {
+        stock = TypeStock();
+        size_t subtypeCount = in.ReadCount(8);
+        for (size_t i = 0; i < subtypeCount && in.Ok(); i++) {
+            SubtypeId subtype = InternSubtype(in.ReadString());
+            size_t bucketCount = in.ReadCount(8);
+            for (size_t b = 0; b < bucketCount; b++) {
+                float efficiency = in.Read<float>();
+                int count = in.Read<int32_t>();
+                if (count <= 0 || count > capacity - stock.total) {
+                    in.Fail();
+                    break;
+                }
+                Deposit(stock, subtype, efficiency, count);
+            }
+        }
+    }
+    return in.Ok();
+}
@@ -0,0 +1,105 @@
+#ifndef TYPED_INVENTORY_H
+#define TYPED_INVENTORY_H
+
+#include "resource_types.h"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class ByteWriter;
+class ByteReader;
+
+// Subtype names ("Steel", "HeavyDrill") as small integer ids. The
+// subtypes in ResourceTables are interned first, in table order, so their
+// ids are the same every run; other names get the next free id.
+using SubtypeId = uint16_t;
+
+SubtypeId InternSubtype(const std::string& name);
+bool FindSubtype(const std::string& name, SubtypeId& outId);   // lookup only, never interns
+const std::string& SubtypeName(SubtypeId id);
+
+// Typed resources (MACHINERY, ELECTRONICS, ALLOYS, CONSTRUCTION_MATERIALS)
+// held as counts rather than one object per item.
+//
+// Items of a type are grouped by subtype, and within a subtype by exact
+// efficiency, so a stack of identical items is one bucket and a count.
+// Adding, removing and counting are constant time, and MoveTo() hands a
+// whole run of items to another inventory bucket by bucket. Each type
+// holds at most `capacity` items, checked the same way the per-item
+// vectors were.
+class TypedInventory {
+public:
+    explicit TypedInventory(int capacity);
+
+    // False when the type is not TYPED or is already at capacity
+    bool Add(const TypedResource& item);
+    bool Add(ResourceType type, SubtypeId subtype, float efficiency = 1.0f);
+
+    // Removes one item of the subtype, from its newest efficiency bucket
+    bool Remove(ResourceType type, SubtypeId subtype);
+
+    // Removes one item of the most recently stocked subtype
+    bool TakeAny(ResourceType type, TypedResource& outItem);
+
+    // Moves up to `count` items of a type to `dest`, stopping early when
+    // this runs out or `dest` fills. Returns how many moved.
+    int MoveTo(TypedInventory& dest, ResourceType type, int count);
+
+    int GetCount(ResourceType type, SubtypeId subtype) const;
+    int GetCount(ResourceType type) const;
+    bool Has(ResourceType type, SubtypeId subtype) const { return GetCount(type, subtype) > 0; }
+    int GetCapacity() const { return capacity; }
+    int GetFreeSpace(ResourceType type) const;
+
+    // Save game snapshot. Subtypes are written by name, since ids beyond
+    // the ResourceTables ones depend on interning order; loading restores
+    // the stocked order too, so TakeAny() picks the same item afterwards.
+    void SaveState(ByteWriter& out) const;
+    bool LoadState(ByteReader& in);
+
+    // fn(SubtypeId subtype, float efficiency, int count) for each non-empty
+    // bucket of a type, subtypes in the order they were first stocked
+    template <typename Fn>
+    void ForEach(ResourceType type, Fn&& fn) const {
+        const TypeStock* stock = Find(type);
+        if (!stock) return;
+        for (SubtypeId subtype : stock->stocked) {
+            for (const Bucket& bucket : stock->bySubtype[subtype].buckets) {
+                fn(subtype, bucket.efficiency, bucket.count);
+            }
+        }
+    }
+
+private:
+    struct Bucket {
+        float efficiency;
+        int count;
+    };
+
+    struct SubtypeStock {
+        int count = 0;
+        int stockedIndex = -1;          // position in TypeStock::stocked, -1 when empty
+        std::vector<Bucket> buckets;    // non-empty, oldest first
+    };
+
+    struct TypeStock {
+        int total = 0;
+        std::vector<SubtypeStock> bySubtype;    // indexed by SubtypeId
+        std::vector<SubtypeId> stocked;         // subtypes with count > 0
+    };
+
+    static const int TYPE_SLOTS = static_cast<int>(TYPED_RESOURCE_TYPES.size());
+
+    TypeStock* Find(ResourceType type);
+    const TypeStock* Find(ResourceType type) const;
+
+    // Adds or removes `count` items of one bucket; callers check bounds
+    void Deposit(TypeStock& stock, SubtypeId subtype, float efficiency, int count);
+    void Withdraw(TypeStock& stock, SubtypeId subtype, int bucketIndex, int count);
+
+    int capacity;
+    std::array<TypeStock, TYPE_SLOTS> stocks;
+};
+
+#endif // TYPED_INVENTORY_H
@@ -0,0 +1,476 @@
+#include "autosave_journal.h"
+#include "save_file.h"
+#include "unlock_registry.h"
+#include <cstring>
+#include <utility>
+
+namespace {
+
+const char MAGIC[8] = {'C', 'O', 'L', 'O', 'N', 'Y', 'J', 'L'};
+const uint32_t JOURNAL_VERSION = 1;
+const size_t ENTRY_HEADER_BYTES = 4 + 4;
+
+void SetError(std::string* error, const std::string& message) {
+    if (error) *error = message;
+}
+
+bool WriteAll(FILE* file, const void* data, size_t size) {
+    return std::fwrite(data, 1, size, file) == size;
+}
+
+bool ReadFile(const std::string& path, std::vector<uint8_t>& out) {
+    FILE* in = std::fopen(path.c_str(), "rb");
+    if (!in) return false;
+    std::fseek(in, 0, SEEK_END);
+    long length = std::ftell(in);
+    std::fseek(in, 0, SEEK_SET);
+    bool ok = length >= 0;
+    if (ok) {
+        out.resize(static_cast<size_t>(length));
+        ok = std::fread(out.data(), 1, out.size(), in) == out.size();
+    }
+    std::fclose(in);
+    return ok;
+}
+
+// Applies one journal entry in the order it was written: unlocks, planet
+// cells, new colonies, sect records (new sects are built here), unit
+// records, colony records, then the clock.
+bool ApplyEntry(ByteReader& in, ResourceManager& resources, TimeManager& time,
+                std::vector<Colony*>& colonies) {
+    TimeManager loadedTime;
+    if (!loadedTime.LoadState(in)) return false;
+
+    std::vector<std::string> techs;
+    if (!SaveGame::ReadUnlocks(in, techs)) return false;
+    UnlockRegistry::Instance().Restore(techs);
+
+    size_t cellCount = in.ReadCount(4 + 4 + 1);
+    for (size_t i = 0; i < cellCount && in.Ok(); i++) {
+        int cell = in.Read<int32_t>();
+        resources.LoadCellState(in, cell);
+    }
+
+    size_t colonyCount = in.ReadCount(1);
+    if (colonyCount < colonies.size()) return false;      // colonies are never removed
+    while (colonies.size() < colonyCount && in.Ok()) {
+        colonies.push_back(new Colony());
+    }
+
+    auto findColony = [&](int index) -> Colony* {
+        return index >= 0 && index < static_cast<int>(colonies.size()) ? colonies[index] : nullptr;
+    };
+
+    size_t sectRecords = in.ReadCount(16);
+    for (size_t i = 0; i < sectRecords && in.Ok(); i++) {
+        Colony* colony = findColony(in.Read<int32_t>());
+        int index = in.Read<int32_t>();
+        Vector2 position;
+        position.x = in.Read<float>();
+        position.y = in.Read<float>();
+        if (!colony || index < 0 || index > static_cast<int>(colony->GetSects().size())) return false;
+
+        if (index == static_cast<int>(colony->GetSects().size())) {
+            colony->AddSect(new Sect(position, resources, time));
+        }
+        colony->GetSects()[index]->LoadOwnState(in);
+    }
+
+    size_t unitRecords = in.ReadCount(16);
+    for (size_t i = 0; i < unitRecords && in.Ok(); i++) {
+        Colony* colony = findColony(in.Read<int32_t>());
+        int sect = in.Read<int32_t>();
+        int unit = in.Read<int32_t>();
+        std::string type = in.ReadString();
+        if (!colony || sect < 0 || sect >= static_cast<int>(colony->GetSects().size()) || unit < 0) return false;
+        colony->GetSects()[sect]->LoadUnitState(static_cast<size_t>(unit), type, in);
+    }
+
+    size_t colonyRecords = in.ReadCount(4);
+    for (size_t i = 0; i < colonyRecords && in.Ok(); i++) {
+        Colony* colony = findColony(in.Read<int32_t>());
+        if (!colony) return false;
+        colony->LoadOwnState(in);
+    }
+
+    if (!in.Ok() || in.GetRemaining() != 0) return false;
+    time = loadedTime;
+    return true;
+}
+
+} // namespace
+
+AutosaveJournal::AutosaveJournal(const std::string& path)
+    : path(path),
+      compactRatio(DEFAULT_COMPACT_RATIO),
+      snapshotDue(true),
+      journalBytes(0),
+      snapshotBytes(0),
+      journal(nullptr),
+      journalBroken(true),
+      pending(0),
+      stopping(false),
+      writeFailed(false)
+{
+#ifndef __EMSCRIPTEN__
+    worker = std::thread(&AutosaveJournal::WorkerLoop, this);
+#endif
+}
+
+AutosaveJournal::~AutosaveJournal()
+{
+#ifndef __EMSCRIPTEN__
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    workReady.notify_all();
+    if (worker.joinable()) worker.join();
+#endif
+    CloseJournal();
+}
+
+void AutosaveJournal::Reset()
+{
+    written.clear();
+    snapshotDue = true;
+}
+
+void AutosaveJournal::Capture(ResourceManager& resources, const TimeManager& time,
+                              const std::vector<Colony*>& colonies)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (writeFailed) snapshotDue = true;
+        writeFailed = false;
+    }
+
+    Job job;
+    if (snapshotDue || !WrittenMatches(colonies) ||
+        static_cast<float>(journalBytes) > compactRatio * static_cast<float>(snapshotBytes)) {
+        CaptureSnapshot(job, resources, time, colonies);
+    } else {
+        CaptureEntry(job, resources, time, colonies);
+    }
+    Queue(std::move(job));
+}
+
+// The recorded objects are still where they were. Loading a game or
+// starting a new one without Reset() replaces them; so would removing a
+// colony or sect, which the game never does.
+bool AutosaveJournal::WrittenMatches(const std::vector<Colony*>& colonies) const
+{
+    if (written.size() > colonies.size()) return false;
+    for (size_t c = 0; c < written.size(); c++) {
+        const std::vector<Sect*>& sects = colonies[c]->GetSects();
+        if (written[c].colony != colonies[c] || written[c].sects.size() > sects.size()) return false;
+        for (size_t s = 0; s < written[c].sects.size(); s++) {
+            const WrittenSect& record = written[c].sects[s];
+            if (record.sect != sects[s] || record.units.size() > sects[s]->GetUnits().size()) return false;
+        }
+    }
+    return true;
+}
+
+void AutosaveJournal::CaptureSnapshot(Job& job, ResourceManager& resources, const TimeManager& time,
+                                      const std::vector<Colony*>& colonies)
+{
+    job.isSnapshot = true;
+    SaveGame::CaptureSnapshot(job.snapshot, resources, time, colonies);
+
+    // Everything is in the snapshot, so every revision counts as written
+    resources.TakeChangedCells(changedCells);
+    written.assign(colonies.size(), WrittenColony());
+    for (size_t c = 0; c < colonies.size(); c++) {
+        WrittenColony& colony = written[c];
+        colony.colony = colonies[c];
+        colony.revision = colonies[c]->GetStateRevision();
+        colony.sects.resize(colonies[c]->GetSects().size());
+        for (size_t s = 0; s < colony.sects.size(); s++) {
+            const Sect* sect = colonies[c]->GetSects()[s];
+            WrittenSect& record = colony.sects[s];
+            record.sect = sect;
+            record.revision = sect->GetStateRevision();
+            record.units.clear();
+            for (const Unit* unit : sect->GetUnits()) {
+                record.units.push_back(unit->GetStateRevision());
+            }
+        }
+    }
+
+    snapshotDue = false;
+    journalBytes = 0;
+    snapshotBytes = job.snapshot.GetRawSize();
+}
+
+void AutosaveJournal::CaptureEntry(Job& job, ResourceManager& resources, const TimeManager& time,
+                                   const std::vector<Colony*>& colonies)
+{
+    ByteWriter& out = job.entry;
+    time.SaveState(out);
+    SaveGame::WriteUnlocks(out);
+
+    resources.TakeChangedCells(changedCells);
+    out.WriteCount(changedCells.size());
+    for (int cell : changedCells) {
+        out.Write<int32_t>(cell);
+        resources.SaveCellState(out, cell);
+    }
+
+    out.WriteCount(colonies.size());
+
+    // Written in three groups, each with its count up front; all sect
+    // records come before the unit records that may need a new sect
+    ByteWriter sectRecords, unitRecords, colonyRecords;
+    size_t sectCount = 0, unitCount = 0, colonyCount = 0;
+
+    written.resize(colonies.size());
+    for (size_t c = 0; c < colonies.size(); c++) {
+        const Colony* colony = colonies[c];
+        WrittenColony& writtenColony = written[c];
+        const bool newColony = writtenColony.colony != colony;
+        writtenColony.colony = colony;
+
+        const std::vector<Sect*>& sects = colony->GetSects();
+        writtenColony.sects.resize(sects.size());
+        for (size_t s = 0; s < sects.size(); s++) {
+            const Sect* sect = sects[s];
+            WrittenSect& record = writtenColony.sects[s];
+            const bool newSect = record.sect != sect;
+            record.sect = sect;
+
+            // Unit actions spend sect storage, so a changed unit rewrites
+            // its sect's own record too
+            bool unitChanged = false;
+            const std::vector<Unit*>& units = sect->GetUnits();
+            const size_t knownUnits = newSect ? 0 : record.units.size();
+            record.units.resize(units.size());
+            for (size_t u = 0; u < units.size(); u++) {
+                const uint32_t revision = units[u]->GetStateRevision();
+                if (u < knownUnits && record.units[u] == revision) continue;
+
+                record.units[u] = revision;
+                unitChanged = true;
+                unitRecords.Write<int32_t>(static_cast<int32_t>(c));
+                unitRecords.Write<int32_t>(static_cast<int32_t>(s));
+                unitRecords.Write<int32_t>(static_cast<int32_t>(u));
+                unitRecords.WriteString(units[u]->GetUnitType());
+                units[u]->SaveState(unitRecords);
+                unitCount++;
+            }
+
+            const uint32_t revision = sect->GetStateRevision();
+            if (newSect || unitChanged || record.revision != revision) {
+                record.revision = revision;
+                Vector2 position = sect->GetPosition();
+                sectRecords.Write<int32_t>(static_cast<int32_t>(c));
+                sectRecords.Write<int32_t>(static_cast<int32_t>(s));
+                sectRecords.Write<float>(position.x);
+                sectRecords.Write<float>(position.y);
+                sect->SaveOwnState(sectRecords);
+                sectCount++;
+            }
+        }
+
+        const uint32_t revision = colony->GetStateRevision();
+        if (newColony || writtenColony.revision != revision) {
+            writtenColony.revision = revision;
+            colonyRecords.Write<int32_t>(static_cast<int32_t>(c));
+            colony->SaveOwnState(colonyRecords);
+            colonyCount++;
+        }
+    }
+
+    out.WriteCount(sectCount);
+    out.WriteBytes(sectRecords.GetBytes().data(), sectRecords.GetSize());
+    out.WriteCount(unitCount);
+    out.WriteBytes(unitRecords.GetBytes().data(), unitRecords.GetSize());
+    out.WriteCount(colonyCount);
+    out.WriteBytes(colonyRecords.GetBytes().data(), colonyRecords.GetSize());
+
+    journalBytes += out.GetSize();
+}
+
+void AutosaveJournal::Queue(Job&& job)
+{
+#ifdef __EMSCRIPTEN__
+    Write(job);
+#else
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs.push_back(std::move(job));
+        pending++;
+    }
+    workReady.notify_one();
+#endif
+}
+
+void AutosaveJournal::Flush()
+{
+#ifndef __EMSCRIPTEN__
+    std::unique_lock<std::mutex> lock(mutex);
+    drained.wait(lock, [this] { return pending == 0; });
+#endif
+}
+
+AutosaveJournal::Stats AutosaveJournal::GetStats()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+void AutosaveJournal::WorkerLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        workReady.wait(lock, [this] { return stopping || !jobs.empty(); });
+        if (jobs.empty()) return;   // stopping, and the queue is drained
+
+        Job job = std::move(jobs.front());
+        jobs.pop_front();
+
+        lock.unlock();
+        Write(job);
+        lock.lock();
+
+        pending--;
+        drained.notify_all();
+    }
+}
+
+// Runs on the worker. A failed write leaves the journal unusable until the
+// next snapshot: later entries are dropped and the capture side told to
+// compact.
+void AutosaveJournal::Write(const Job& job)
+{
+    bool ok;
+    if (job.isSnapshot) {
+        ok = WriteSnapshot(job.snapshot);
+    } else {
+        ok = !journalBroken && AppendEntry(job.entry);
+    }
+
+#ifndef __EMSCRIPTEN__
+    std::lock_guard<std::mutex> lock(mutex);
+#endif
+    if (!ok) {
+        journalBroken = true;
+        writeFailed = true;
+        stats.failed++;
+    } else if (job.isSnapshot) {
+        stats.snapshots++;
+        stats.journalBytes = 0;
+    } else {
+        stats.entries++;
+        stats.journalBytes += job.entry.GetSize();
+    }
+}
+
+bool AutosaveJournal::WriteSnapshot(const SaveGame::Snapshot& snapshot)
+{
+    // The old journal belongs to the old snapshot; once the new one is in
+    // place its header no longer matches, so a crash before the restart
+    // below only loses the stale entries
+    CloseJournal();
+    SaveGame::SaveStats saveStats;
+    if (!SaveGame::WriteSnapshot(path, snapshot, true, nullptr, &saveStats)) return false;
+    {
+#ifndef __EMSCRIPTEN__
+        std::lock_guard<std::mutex> lock(mutex);
+#endif
+        stats.snapshotBytes = saveStats.fileBytes;
+    }
+
+    journal = std::fopen(GetJournalPath().c_str(), "wb");
+    if (!journal) return false;
+
+    ByteWriter header;
+    header.WriteBytes(MAGIC, sizeof(MAGIC));
+    header.Write<uint32_t>(JOURNAL_VERSION);
+    header.Write<int32_t>(snapshot.summary.ticks);
+    header.Write<float>(snapshot.summary.gameTime);
+    if (!WriteAll(journal, header.GetBytes().data(), header.GetSize()) || std::fflush(journal) != 0) {
+        CloseJournal();
+        return false;
+    }
+    journalBroken = false;
+    return true;
+}
+
+bool AutosaveJournal::AppendEntry(const ByteWriter& entry)
+{
+    if (!journal) return false;
+
+    ByteWriter frame;
+    frame.Write<uint32_t>(static_cast<uint32_t>(entry.GetSize()));
+    frame.Write<uint32_t>(SaveChecksum(entry.GetBytes().data(), entry.GetSize()));
+    return WriteAll(journal, frame.GetBytes().data(), frame.GetSize()) &&
+           WriteAll(journal, entry.GetBytes().data(), entry.GetSize()) &&
+           std::fflush(journal) == 0;
+}
+
+void AutosaveJournal::CloseJournal()
+{
+    if (journal) {
+        std::fclose(journal);
+        journal = nullptr;
+    }
+}
+
+bool AutosaveJournal::Recover(const std::string& path, ResourceManager& resources, TimeManager& time,
+                              std::vector<Colony*>& outColonies, std::string* error, int* replayed)
+{
+    if (replayed) *replayed = 0;
+
+    SaveGame::Summary summary;
+    if (!SaveGame::ReadSummary(path, summary, error)) return false;
+
+    // Kept to put back if a journal entry turns out not to apply
+    ResourceManager previousResources = resources;
+    TimeManager previousTime = time;
+    std::vector<std::string> previousTechs = UnlockRegistry::Instance().GetAll();
+
+    std::vector<Colony*> colonies;
+    if (!SaveGame::Load(path, resources, time, colonies, error)) return false;
+
+    std::vector<uint8_t> bytes;
+    if (!ReadFile(path + ".journal", bytes)) {
+        outColonies = std::move(colonies);      // no journal: the snapshot is all there is
+        return true;
+    }
+
+    ByteReader header(bytes.data(), bytes.size());
+    char magic[sizeof(MAGIC)];
+    bool current = header.ReadBytes(magic, sizeof(magic)) && std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0 &&
+                   header.Read<uint32_t>() == JOURNAL_VERSION &&
+                   header.Read<int32_t>() == summary.ticks &&
+                   header.Read<float>() == summary.gameTime && header.Ok();
+
+    size_t offset = bytes.size() - header.GetRemaining();
+    int applied = 0;
+    while (current && bytes.size() - offset >= ENTRY_HEADER_BYTES) {
+        ByteReader frame(bytes.data() + offset, ENTRY_HEADER_BYTES);
+        uint32_t size = frame.Read<uint32_t>();
+        uint32_t checksum = frame.Read<uint32_t>();
+        const uint8_t* payload = bytes.data() + offset + ENTRY_HEADER_BYTES;
+        if (size > bytes.size() - offset - ENTRY_HEADER_BYTES || SaveChecksum(payload, size) != checksum) {
+            break;      // the entry being written when the game stopped
+        }
+
+        ByteReader entry(payload, size);
+        if (!ApplyEntry(entry, resources, time, colonies)) {
+            for (Colony* colony : colonies) delete colony;
+            resources = previousResources;
+            time = previousTime;
+            UnlockRegistry::Instance().Restore(previousTechs);
+            SetError(error, "journal entry " + std::to_string(applied + 1) + " is malformed");
+            return false;
+        }
+        applied++;
+        offset += ENTRY_HEADER_BYTES + size;
+    }
+
+    if (replayed) *replayed = applied;
+    outColonies = std::move(colonies);
+    return true;
+}
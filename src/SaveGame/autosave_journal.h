@@ -0,0 +1,139 @@
+#ifndef AUTOSAVE_JOURNAL_H
+#define AUTOSAVE_JOURNAL_H
+
+#include "game_snapshot.h"
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Incremental autosave: a full snapshot (game_snapshot.h) at `path` and a
+// journal of what changed since it at `path`.journal.
+//
+// Colonies, sects and units carry state revisions. Capture() compares
+// them with the revisions it last wrote and serialises only the objects
+// that moved on, plus the planet cells changed since the last capture
+// (ResourceManager::TakeChangedCells), the clock and the unlocks. That is
+// one journal entry, sized by how much changed rather than by the world.
+// Records are whole objects: a sect's storage, one unit (modules,
+// excavators, prospecting sub-cells), a colony's reserves, roads and
+// jobs, one planet cell.
+//
+// Once the journal has grown past `compactRatio` times the snapshot, the
+// next capture is a full snapshot instead and the journal starts over.
+// Serialising stays on the calling thread; compression and file writes
+// run on a worker.
+//
+//   journal  magic "COLONYJL", version, snapshot ticks and game time,
+//            then per entry: payload size, checksum, payload
+//
+// A journal whose header does not match the snapshot (a crash between
+// the two writes) is stale and ignored, as is everything from the first
+// entry that is cut short or fails its checksum.
+//
+// Web builds have no worker thread and write synchronously.
+class AutosaveJournal {
+public:
+    static constexpr float DEFAULT_COMPACT_RATIO = 1.0f;
+
+    struct Stats {
+        int snapshots = 0;          // full snapshots written
+        int entries = 0;            // journal entries appended
+        int failed = 0;             // writes that failed or were dropped after one
+        size_t journalBytes = 0;    // entry payloads since the last snapshot
+        size_t snapshotBytes = 0;   // file size of the last snapshot
+    };
+
+    explicit AutosaveJournal(const std::string& path);
+    ~AutosaveJournal();         // writes out everything still queued
+
+    AutosaveJournal(const AutosaveJournal&) = delete;
+    AutosaveJournal& operator=(const AutosaveJournal&) = delete;
+
+    // Forgets what was written, so the next capture is a full snapshot.
+    // Call when the colonies are replaced (new game, load).
+    void Reset();
+
+    // Queues a journal entry, or a full snapshot when one is due. Takes
+    // the planet's changed-cell list.
+    void Capture(ResourceManager& resources, const TimeManager& time, const std::vector<Colony*>& colonies);
+
+    // Journal bytes per snapshot byte before compacting
+    void SetCompactRatio(float ratio) { compactRatio = ratio; }
+
+    // Blocks until every queued write is on disk
+    void Flush();
+
+    Stats GetStats();
+    const std::string& GetPath() const { return path; }
+    std::string GetJournalPath() const { return path + ".journal"; }
+
+    // Loads the snapshot at `path`, then replays its journal. Same
+    // contract as SaveGame::Load: on failure nothing is touched.
+    // `replayed` gets the number of journal entries applied.
+    static bool Recover(const std::string& path, ResourceManager& resources, TimeManager& time,
+                        std::vector<Colony*>& outColonies, std::string* error, int* replayed = nullptr);
+
+private:
+    // Revisions as of the last capture, by colony, sect and unit index
+    struct WrittenSect {
+        const Sect* sect = nullptr;
+        uint32_t revision = 0;
+        std::vector<uint32_t> units;
+    };
+    struct WrittenColony {
+        const Colony* colony = nullptr;
+        uint32_t revision = 0;
+        std::vector<WrittenSect> sects;
+    };
+
+    struct Job {
+        bool isSnapshot = false;
+        SaveGame::Snapshot snapshot;
+        ByteWriter entry;
+    };
+
+    std::string path;
+    float compactRatio;
+
+    // Capture side (calling thread)
+    std::vector<WrittenColony> written;
+    std::vector<int> changedCells;
+    bool snapshotDue;
+    size_t journalBytes;            // since the last snapshot capture
+    size_t snapshotBytes;           // raw size of that snapshot
+
+    // Writer side
+    FILE* journal;
+    bool journalBroken;             // a write failed; entries wait for a snapshot
+
+    std::deque<Job> jobs;
+    int pending;                    // queued + being written
+    bool stopping;
+    bool writeFailed;               // tells the capture side to compact
+    Stats stats;
+    std::mutex mutex;
+    std::condition_variable workReady;
+    std::condition_variable drained;
+#ifndef __EMSCRIPTEN__
+    std::thread worker;
+#endif
+
+    bool WrittenMatches(const std::vector<Colony*>& colonies) const;
+    void CaptureSnapshot(Job& job, ResourceManager& resources, const TimeManager& time,
+                         const std::vector<Colony*>& colonies);
+    void CaptureEntry(Job& job, ResourceManager& resources, const TimeManager& time,
+                      const std::vector<Colony*>& colonies);
+    void Queue(Job&& job);
+
+    void WorkerLoop();
+    void Write(const Job& job);
+    bool WriteSnapshot(const SaveGame::Snapshot& snapshot);
+    bool AppendEntry(const ByteWriter& entry);
+    void CloseJournal();
+};
+
+#endif // AUTOSAVE_JOURNAL_H
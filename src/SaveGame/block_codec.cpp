@@ -0,0 +1,136 @@
+#include "block_codec.h"
+#include <cstring>
+
+namespace {
+
+const size_t MIN_MATCH = 4;
+const size_t MAX_OFFSET = 65535;
+const int HASH_BITS = 14;
+
+uint32_t Read32(const uint8_t* p) {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+uint32_t Hash(uint32_t sequence) {
+    return (sequence * 2654435761u) >> (32 - HASH_BITS);
+}
+
+// Lengths of 15 and up spill into extra bytes: 255s, then the remainder
+void WriteLengthTail(std::vector<uint8_t>& out, size_t extra) {
+    while (extra >= 255) {
+        out.push_back(255);
+        extra -= 255;
+    }
+    out.push_back(static_cast<uint8_t>(extra));
+}
+
+bool ReadLengthTail(const uint8_t*& in, const uint8_t* end, size_t& length) {
+    uint8_t byte;
+    do {
+        if (in >= end) return false;
+        byte = *in++;
+        length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+void EmitSequence(std::vector<uint8_t>& out, const uint8_t* literals, size_t literalCount,
+                  size_t offset, size_t matchLength) {
+    const bool hasMatch = matchLength >= MIN_MATCH;
+    const size_t matchCode = hasMatch ? matchLength - MIN_MATCH : 0;
+
+    out.push_back(static_cast<uint8_t>(((literalCount < 15 ? literalCount : 15) << 4) |
+                                       (matchCode < 15 ? matchCode : 15)));
+    if (literalCount >= 15) WriteLengthTail(out, literalCount - 15);
+    out.insert(out.end(), literals, literals + literalCount);
+
+    if (!hasMatch) return;
+    out.push_back(static_cast<uint8_t>(offset));
+    out.push_back(static_cast<uint8_t>(offset >> 8));
+    if (matchCode >= 15) WriteLengthTail(out, matchCode - 15);
+}
+
+} // namespace
+
+namespace BlockCodec {
+
+size_t MaxCompressedSize(size_t rawSize) {
+    return rawSize + rawSize / 255 + 16;
+}
+
+std::vector<uint8_t> Compress(const uint8_t* data, size_t size) {
+    std::vector<uint8_t> out;
+    out.reserve(MaxCompressedSize(size));
+
+    // Last position each hashed 4-byte sequence was seen at, plus one
+    std::vector<uint32_t> table(size_t(1) << HASH_BITS, 0);
+
+    size_t anchor = 0;
+    size_t i = 0;
+    while (i + MIN_MATCH <= size) {
+        const uint32_t sequence = Read32(data + i);
+        uint32_t& slot = table[Hash(sequence)];
+        const size_t candidate = slot;
+        slot = static_cast<uint32_t>(i + 1);
+
+        if (candidate == 0 || i - (candidate - 1) > MAX_OFFSET || Read32(data + candidate - 1) != sequence) {
+            i++;
+            continue;
+        }
+
+        const size_t from = candidate - 1;
+        size_t length = MIN_MATCH;
+        while (i + length < size && data[from + length] == data[i + length]) {
+            length++;
+        }
+
+        EmitSequence(out, data + anchor, i - anchor, i - from, length);
+        i += length;
+        anchor = i;
+    }
+
+    // Trailing literals close the block (an empty input is one empty token)
+    EmitSequence(out, data + anchor, size - anchor, 0, 0);
+    return out;
+}
+
+bool Decompress(const uint8_t* data, size_t size, uint8_t* out, size_t rawSize) {
+    const uint8_t* in = data;
+    const uint8_t* end = data + size;
+    size_t written = 0;
+
+    while (in < end) {
+        const uint8_t token = *in++;
+
+        size_t literalCount = token >> 4;
+        if (literalCount == 15 && !ReadLengthTail(in, end, literalCount)) return false;
+        if (literalCount > static_cast<size_t>(end - in) || literalCount > rawSize - written) return false;
+        std::memcpy(out + written, in, literalCount);
+        in += literalCount;
+        written += literalCount;
+
+        if (in == end) break;       // the closing literal run
+
+        if (end - in < 2) return false;
+        const size_t offset = in[0] | (static_cast<size_t>(in[1]) << 8);
+        in += 2;
+        size_t matchLength = token & 15;
+        if (matchLength == 15 && !ReadLengthTail(in, end, matchLength)) return false;
+        matchLength += MIN_MATCH;
+
+        if (offset == 0 || offset > written || matchLength > rawSize - written) return false;
+
+        // Byte by byte: a match may overlap the bytes it is producing
+        const uint8_t* source = out + written - offset;
+        for (size_t k = 0; k < matchLength; k++) {
+            out[written + k] = source[k];
+        }
+        written += matchLength;
+    }
+
+    return written == rawSize;
+}
+
+} // namespace BlockCodec
@@ -0,0 +1,26 @@
+#ifndef BLOCK_CODEC_H
+#define BLOCK_CODEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Small LZ77 block compressor for save sections.
+//
+// Same shape as LZ4's block format: a token byte holding a literal run
+// length and a match length, the literals, then a 2-byte back offset.
+// Matches are found through a hash of the next four bytes, so compression
+// is a single pass and decompression is copies only. Simulation state is
+// mostly repeated floats and zeroed cells; that is what it is tuned for,
+// not ratio on arbitrary data.
+namespace BlockCodec {
+    // Worst-case output size for `rawSize` input bytes
+    size_t MaxCompressedSize(size_t rawSize);
+
+    std::vector<uint8_t> Compress(const uint8_t* data, size_t size);
+
+    // Fills exactly `rawSize` bytes of `out`; false on malformed input
+    bool Decompress(const uint8_t* data, size_t size, uint8_t* out, size_t rawSize);
+}
+
+#endif // BLOCK_CODEC_H
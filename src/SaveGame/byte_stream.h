@@ -0,0 +1,185 @@
+#ifndef BYTE_STREAM_H
+#define BYTE_STREAM_H
+
+#include "resource_vector.h"
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Flat little-endian encoding for save files.
+//
+// ByteWriter appends fixed-width values to a growing buffer. ByteReader
+// walks a buffer it does not own (a mapped file section, say); reading
+// past the end returns zeros and sets a sticky failure flag, so a
+// LoadState can read a whole record and check Ok() once at the end.
+// Floats are stored by bit pattern, so they round-trip exactly.
+class ByteWriter {
+public:
+    template <typename T>
+    void Write(T value) {
+        static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value, "fixed-width values only");
+        using Bits = typename std::conditional<sizeof(T) == 8, uint64_t,
+                     typename std::conditional<sizeof(T) == 4, uint32_t,
+                     typename std::conditional<sizeof(T) == 2, uint16_t, uint8_t>::type>::type>::type;
+        Bits bits;
+        std::memcpy(&bits, &value, sizeof(T));
+        for (size_t i = 0; i < sizeof(T); i++) {
+            bytes.push_back(static_cast<uint8_t>(bits >> (8 * i)));
+        }
+    }
+
+    void WriteBool(bool value) { Write<uint8_t>(value ? 1 : 0); }
+    template <typename E>
+    void WriteEnum(E value) { Write<uint8_t>(static_cast<uint8_t>(value)); }
+    void WriteCount(size_t count) { Write<uint32_t>(static_cast<uint32_t>(count)); }
+
+    void WriteString(const std::string& text) {
+        WriteCount(text.size());
+        bytes.insert(bytes.end(), text.begin(), text.end());
+    }
+
+    void WriteBytes(const void* data, size_t size) {
+        const uint8_t* begin = static_cast<const uint8_t*>(data);
+        bytes.insert(bytes.end(), begin, begin + size);
+    }
+
+    // Presence mask, then the present amounts in enum order
+    void WriteResources(const ResourceVector& resources) {
+        Write<uint32_t>(resources.GetMask());
+        for (auto [type, amount] : resources) {
+            Write<float>(amount);
+        }
+    }
+
+    template <typename Value>
+    void WriteResourceMap(const std::map<ResourceType, Value>& resources) {
+        WriteCount(resources.size());
+        for (const auto& [type, value] : resources) {
+            Write<uint8_t>(static_cast<uint8_t>(type));
+            Write<Value>(value);
+        }
+    }
+
+    const std::vector<uint8_t>& GetBytes() const { return bytes; }
+    std::vector<uint8_t>& GetBytes() { return bytes; }
+    size_t GetSize() const { return bytes.size(); }
+
+private:
+    std::vector<uint8_t> bytes;
+};
+
+class ByteReader {
+public:
+    ByteReader() = default;
+    ByteReader(const uint8_t* data, size_t size) : data(data), size(size) {}
+
+    template <typename T>
+    T Read() {
+        static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value, "fixed-width values only");
+        using Bits = typename std::conditional<sizeof(T) == 8, uint64_t,
+                     typename std::conditional<sizeof(T) == 4, uint32_t,
+                     typename std::conditional<sizeof(T) == 2, uint16_t, uint8_t>::type>::type>::type;
+        T value{};
+        if (!Take(sizeof(T))) return value;
+
+        Bits bits = 0;
+        for (size_t i = 0; i < sizeof(T); i++) {
+            bits |= static_cast<Bits>(data[position - sizeof(T) + i]) << (8 * i);
+        }
+        std::memcpy(&value, &bits, sizeof(T));
+        return value;
+    }
+
+    bool ReadBool() { return Read<uint8_t>() != 0; }
+
+    // An enum written by WriteEnum; values past `last` fail the stream
+    template <typename E>
+    E ReadEnum(E last) {
+        uint8_t index = Read<uint8_t>();
+        if (index > static_cast<uint8_t>(last)) {
+            failed = true;
+            index = 0;
+        }
+        return static_cast<E>(index);
+    }
+
+    // An element count, rejected when even `minElementBytes` per element
+    // would run past the end (so a corrupt count cannot size a huge vector)
+    size_t ReadCount(size_t minElementBytes = 1) {
+        uint32_t count = Read<uint32_t>();
+        if (minElementBytes > 0 && count > GetRemaining() / minElementBytes) {
+            failed = true;
+            return 0;
+        }
+        return count;
+    }
+
+    std::string ReadString() {
+        size_t length = ReadCount();
+        if (!Take(length)) return std::string();
+        return std::string(reinterpret_cast<const char*>(data + position - length), length);
+    }
+
+    bool ReadBytes(void* out, size_t count) {
+        if (!Take(count)) return false;
+        std::memcpy(out, data + position - count, count);
+        return true;
+    }
+
+    ResourceVector ReadResources() {
+        ResourceVector resources;
+        uint32_t mask = Read<uint32_t>();
+        for (int i = 0; i < RESOURCE_TYPE_COUNT; i++) {
+            if (mask & (1u << i)) {
+                resources[static_cast<ResourceType>(i)] = Read<float>();
+            }
+        }
+        if (mask >> RESOURCE_TYPE_COUNT) failed = true;     // unknown resource
+        return resources;
+    }
+
+    template <typename Value>
+    std::map<ResourceType, Value> ReadResourceMap() {
+        std::map<ResourceType, Value> resources;
+        size_t count = ReadCount(1 + sizeof(Value));
+        for (size_t i = 0; i < count; i++) {
+            ResourceType type = ReadResourceType();
+            resources[type] = Read<Value>();
+        }
+        return resources;
+    }
+
+    ResourceType ReadResourceType() {
+        uint8_t index = Read<uint8_t>();
+        if (index >= RESOURCE_TYPE_COUNT) {
+            failed = true;
+            index = 0;
+        }
+        return static_cast<ResourceType>(index);
+    }
+
+    // Marks the stream bad from a LoadState that found an invalid value
+    void Fail() { failed = true; }
+    bool Ok() const { return !failed; }
+    size_t GetRemaining() const { return size - position; }
+
+private:
+    bool Take(size_t count) {
+        if (failed || count > size - position) {
+            failed = true;
+            return false;
+        }
+        position += count;
+        return true;
+    }
+
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    size_t position = 0;
+    bool failed = false;
+};
+
+#endif // BYTE_STREAM_H
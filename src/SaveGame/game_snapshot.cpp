@@ -0,0 +1,190 @@
+#include "game_snapshot.h"
+#include "save_file.h"
+#include "unlock_registry.h"
+#include <utility>
+
+namespace {
+
+void SetError(std::string* error, const std::string& message) {
+    if (error) *error = message;
+}
+
+bool ReadSummarySection(SaveFileReader& reader, SaveGame::Summary& summary, std::string* error) {
+    ByteReader in;
+    if (!reader.GetSection(SaveGame::SECTION_META, in, error)) return false;
+    summary.gameTime = in.Read<float>();
+    summary.ticks = in.Read<int32_t>();
+    summary.colonyCount = in.Read<int32_t>();
+    summary.sectCount = in.Read<int32_t>();
+    summary.gridSize = in.Read<int32_t>();
+    if (!in.Ok()) {
+        SetError(error, "metadata section is truncated");
+        return false;
+    }
+    return true;
+}
+
+bool OpenChecked(SaveFileReader& reader, const std::string& path, std::string* error) {
+    if (!reader.Open(path, error)) return false;
+    if (reader.GetFormatVersion() != SaveGame::FORMAT_VERSION) {
+        SetError(error, path + " has format version " + std::to_string(reader.GetFormatVersion()) +
+                        ", expected " + std::to_string(SaveGame::FORMAT_VERSION));
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+namespace SaveGame {
+
+size_t Snapshot::GetRawSize() const {
+    return meta.GetSize() + clock.GetSize() + unlocks.GetSize() + planet.GetSize() + colonies.GetSize();
+}
+
+void CaptureSnapshot(Snapshot& out, const ResourceManager& resources, const TimeManager& time,
+                     const std::vector<Colony*>& colonies) {
+    int sectCount = 0;
+    for (const Colony* colony : colonies) {
+        sectCount += static_cast<int>(colony->GetSects().size());
+    }
+
+    Summary& summary = out.summary;
+    summary.gameTime = time.GetGameTime();
+    summary.ticks = time.GetTicks();
+    summary.colonyCount = static_cast<int>(colonies.size());
+    summary.sectCount = sectCount;
+    summary.gridSize = resources.GetGridSize();
+
+    out.meta = ByteWriter();
+    out.meta.Write<float>(summary.gameTime);
+    out.meta.Write<int32_t>(summary.ticks);
+    out.meta.Write<int32_t>(summary.colonyCount);
+    out.meta.Write<int32_t>(summary.sectCount);
+    out.meta.Write<int32_t>(summary.gridSize);
+
+    out.clock = ByteWriter();
+    time.SaveState(out.clock);
+
+    out.unlocks = ByteWriter();
+    WriteUnlocks(out.unlocks);
+
+    out.planet = ByteWriter();
+    resources.SaveState(out.planet);
+
+    out.colonies = ByteWriter();
+    out.colonies.WriteCount(colonies.size());
+    for (const Colony* colony : colonies) {
+        colony->SaveState(out.colonies);
+    }
+}
+
+void AddSnapshotSections(SaveFileWriter& file, const Snapshot& snapshot, bool compress) {
+    // The small sections are never worth compressing
+    file.AddSection(SECTION_META, snapshot.meta, false);
+    file.AddSection(SECTION_TIME, snapshot.clock, false);
+    file.AddSection(SECTION_UNLOCKS, snapshot.unlocks, false);
+    file.AddSection(SECTION_PLANET, snapshot.planet, compress);
+    file.AddSection(SECTION_COLONIES, snapshot.colonies, compress);
+}
+
+bool WriteSnapshot(const std::string& path, const Snapshot& snapshot, bool compress,
+                   std::string* error, SaveStats* stats) {
+    SaveFileWriter file;
+    AddSnapshotSections(file, snapshot, compress);
+
+    if (!file.WriteTo(path, FORMAT_VERSION, error)) return false;
+    if (stats) {
+        stats->rawBytes = file.GetRawSize();
+        stats->fileBytes = file.GetStoredSize();
+    }
+    return true;
+}
+
+bool Save(const std::string& path, const ResourceManager& resources, const TimeManager& time,
+          const std::vector<Colony*>& colonies, bool compress, std::string* error,
+          SaveStats* stats) {
+    Snapshot snapshot;
+    CaptureSnapshot(snapshot, resources, time, colonies);
+    return WriteSnapshot(path, snapshot, compress, error, stats);
+}
+
+bool Load(const std::string& path, ResourceManager& resources, TimeManager& time,
+          std::vector<Colony*>& outColonies, std::string* error, const SimClock* clock) {
+    SaveFileReader reader;
+    if (!OpenChecked(reader, path, error)) return false;
+    if (!reader.VerifyAll(error)) return false;
+
+    // Decode into temporaries so a bad section leaves the game as it was
+    ByteReader in;
+    ResourceManager loadedResources(0, 1.0f);
+    if (!reader.GetSection(SECTION_PLANET, in, error)) return false;
+    if (!loadedResources.LoadState(in)) {
+        SetError(error, "planet section is malformed");
+        return false;
+    }
+
+    TimeManager loadedTime;
+    if (!reader.GetSection(SECTION_TIME, in, error)) return false;
+    if (!loadedTime.LoadState(in)) {
+        SetError(error, "time section is malformed");
+        return false;
+    }
+
+    if (!reader.GetSection(SECTION_UNLOCKS, in, error)) return false;
+    std::vector<std::string> techs;
+    if (!ReadUnlocks(in, techs)) {
+        SetError(error, "unlock section is malformed");
+        return false;
+    }
+
+    ByteReader colonyBytes;
+    if (!reader.GetSection(SECTION_COLONIES, colonyBytes, error)) return false;
+
+    // Sects read the planet as they are built (prospecting grids sample
+    // the layered resources), so the planet goes in before the colonies.
+    // Colonies are built against the live managers they will run with;
+    // if one fails they are discarded and the planet put back.
+    std::swap(resources, loadedResources);
+    std::vector<std::string> previousTechs = UnlockRegistry::Instance().GetAll();
+    UnlockRegistry::Instance().Restore(techs);
+
+    std::vector<Colony*> colonies(colonyBytes.ReadCount(16), nullptr);
+    for (Colony*& colony : colonies) {
+        colony = new Colony();
+        colony->SetClock(clock);
+        if (!colony->LoadState(colonyBytes, resources, time)) break;
+    }
+
+    if (!colonyBytes.Ok()) {
+        for (Colony* colony : colonies) delete colony;
+        std::swap(resources, loadedResources);
+        UnlockRegistry::Instance().Restore(previousTechs);
+        SetError(error, "colony section is malformed");
+        return false;
+    }
+
+    time = loadedTime;
+    outColonies = std::move(colonies);
+    return true;
+}
+
+bool ReadSummary(const std::string& path, Summary& summary, std::string* error) {
+    SaveFileReader reader;
+    if (!OpenChecked(reader, path, error)) return false;
+    return ReadSummarySection(reader, summary, error);
+}
+
+void WriteUnlocks(ByteWriter& out) {
+    std::vector<std::string> techs = UnlockRegistry::Instance().GetAll();
+    out.WriteCount(techs.size());
+    for (const std::string& tech : techs) out.WriteString(tech);
+}
+
+bool ReadUnlocks(ByteReader& in, std::vector<std::string>& techs) {
+    techs.resize(in.ReadCount(4));
+    for (std::string& tech : techs) tech = in.ReadString();
+    return in.Ok();
+}
+
+} // namespace SaveGame
@@ -0,0 +1,89 @@
+#ifndef GAME_SNAPSHOT_H
+#define GAME_SNAPSHOT_H
+
+#include "byte_stream.h"
+#include "save_file.h"
+#include "colony.h"
+#include "resource_manager.h"
+#include "time_manager.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// The whole game state as one save file (see save_file.h for the layout).
+//
+//   META      format summary for load screens: time, counts, grid size
+//   TIME      TimeManager clock
+//   UNLOCKS   UnlockRegistry technologies
+//   PLANET    ResourceManager grids, depletion included
+//   COLONIES  every colony, its sects, their units, roads and jobs
+//
+// Loading rebuilds colonies through the normal constructors and then
+// overwrites their mutable state, so derived data (unit bindings,
+// prospecting abundances, centroids) is computed the same way a new game
+// computes it rather than stored.
+namespace SaveGame {
+    const uint32_t FORMAT_VERSION = 1;
+
+    enum Section : uint32_t {
+        SECTION_META = 1,
+        SECTION_TIME = 2,
+        SECTION_UNLOCKS = 3,
+        SECTION_PLANET = 4,
+        SECTION_COLONIES = 5,
+        SECTION_RECORDING = 6           // session recordings only (session_recording.h)
+    };
+
+    struct Summary {
+        float gameTime = 0.0f;
+        int ticks = 0;
+        int colonyCount = 0;
+        int sectCount = 0;
+        int gridSize = 0;
+    };
+
+    struct SaveStats {
+        size_t rawBytes = 0;        // section payloads before compression
+        size_t fileBytes = 0;       // what was written
+    };
+
+    bool Save(const std::string& path, const ResourceManager& resources, const TimeManager& time,
+              const std::vector<Colony*>& colonies, bool compress, std::string* error,
+              SaveStats* stats = nullptr);
+
+    // Save in two halves: the game serialised into memory, then written
+    // (and compressed). Only the capture reads the game, so the write can
+    // run on another thread while the simulation goes on.
+    struct Snapshot {
+        Summary summary;
+        ByteWriter meta;
+        ByteWriter clock;
+        ByteWriter unlocks;
+        ByteWriter planet;
+        ByteWriter colonies;
+
+        size_t GetRawSize() const;
+    };
+    void CaptureSnapshot(Snapshot& out, const ResourceManager& resources, const TimeManager& time,
+                         const std::vector<Colony*>& colonies);
+    bool WriteSnapshot(const std::string& path, const Snapshot& snapshot, bool compress,
+                       std::string* error, SaveStats* stats = nullptr);
+    void AddSnapshotSections(SaveFileWriter& file, const Snapshot& snapshot, bool compress);
+
+    // Checks every section before changing anything. On success the planet,
+    // clock and unlocks are replaced and `outColonies` holds new colonies
+    // the caller owns; on failure nothing is touched. `clock` is installed
+    // on the colonies before their roads are read (Colony::SetClock).
+    bool Load(const std::string& path, ResourceManager& resources, TimeManager& time,
+              std::vector<Colony*>& outColonies, std::string* error,
+              const SimClock* clock = nullptr);
+
+    // Reads only the META section
+    bool ReadSummary(const std::string& path, Summary& summary, std::string* error);
+
+    // The UNLOCKS layout, shared with the autosave journal
+    void WriteUnlocks(ByteWriter& out);
+    bool ReadUnlocks(ByteReader& in, std::vector<std::string>& techs);
+}
+
+#endif // GAME_SNAPSHOT_H
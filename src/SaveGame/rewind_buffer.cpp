@@ -0,0 +1,141 @@
+#include "rewind_buffer.h"
+#include "unlock_registry.h"
+#include <algorithm>
+#include <unordered_set>
+#include <utility>
+
+RewindBuffer::RewindBuffer(int capacity)
+    : capacity(std::max(1, capacity))
+{
+}
+
+void RewindBuffer::Clear()
+{
+    snapshots.clear();
+}
+
+void RewindBuffer::Capture(const ResourceManager& resources, const TimeManager& time,
+                           const std::vector<Colony*>& colonies)
+{
+    snapshots.push_back(WorldPages::Capture(resources, time, colonies,
+                                            snapshots.empty() ? nullptr : &snapshots.back()));
+    while (static_cast<int>(snapshots.size()) > capacity) {
+        snapshots.pop_front();
+    }
+}
+
+int RewindBuffer::FindBefore(int ticks) const
+{
+    for (int index = GetCount() - 1; index >= 0; index--) {
+        if (snapshots[index].ticks < ticks) return index;
+    }
+    return -1;
+}
+
+bool RewindBuffer::Restore(int index, ResourceManager& resources, TimeManager& time,
+                           std::vector<Colony*>& outColonies, const SimClock* clock)
+{
+    if (index < 0 || index >= GetCount()) return false;
+    Snapshot& target = snapshots[index];
+    if (target.gridSize != resources.GetGridSize()) return false;
+
+    TimeManager restoredTime;
+    ByteReader clockBytes(target.clock.data(), target.clock.size());
+    if (!restoredTime.LoadState(clockBytes)) return false;
+
+    // Sects read the planet as they are built, so it goes first. A chunk
+    // still at the page's revision already holds what the page does.
+    for (size_t chunk = 0; chunk < target.chunks.size(); chunk++) {
+        Page& page = target.chunks[chunk];
+        if (resources.GetCellChunkRevision(static_cast<int>(chunk)) == page.revision) continue;
+        target.LoadChunk(chunk, resources);
+        page.revision = resources.GetCellChunkRevision(static_cast<int>(chunk));
+    }
+
+    // If a colony fails to build the planet is already rewound, nothing else
+    std::vector<Colony*> restored;
+    for (const ColonyPages& colonyPages : target.colonies) {
+        Colony* colony = nullptr;
+        if (!WorldPages::BuildColony(colonyPages, resources, time, clock, colony)) {
+            for (Colony* built : restored) delete built;
+            return false;
+        }
+        restored.push_back(colony);
+    }
+
+    UnlockRegistry::Instance().Restore(*target.unlocks);
+    time = restoredTime;
+
+    // The restored objects hold exactly the target's pages: it becomes the
+    // newest snapshot, taken from them, so the next capture shares them
+    for (size_t c = 0; c < restored.size(); c++) {
+        ColonyPages& colonyPages = target.colonies[c];
+        colonyPages.colony = restored[c];
+        colonyPages.own.revision = restored[c]->GetStateRevision();
+        const std::vector<Sect*>& sects = restored[c]->GetSects();
+        for (size_t s = 0; s < sects.size(); s++) {
+            SectPages& sectPages = colonyPages.sects[s];
+            sectPages.sect = sects[s];
+            sectPages.own.revision = sects[s]->GetStateRevision();
+            for (size_t u = 0; u < sectPages.units.size(); u++) {
+                sectPages.units[u].revision = sects[s]->GetUnits()[u]->GetStateRevision();
+            }
+        }
+    }
+    snapshots.erase(snapshots.begin() + index + 1, snapshots.end());
+
+    outColonies = std::move(restored);
+    return true;
+}
+
+size_t RewindBuffer::TableBytes(const Snapshot& snapshot)
+{
+    size_t bytes = sizeof(Snapshot) + snapshot.clock.capacity() + snapshot.chunks.capacity() * sizeof(Page);
+    for (const ColonyPages& colony : snapshot.colonies) {
+        bytes += sizeof(ColonyPages) + colony.sects.capacity() * sizeof(SectPages);
+        for (const SectPages& sect : colony.sects) {
+            bytes += sect.units.capacity() * sizeof(Page);
+        }
+    }
+    return bytes;
+}
+
+RewindBuffer::Stats RewindBuffer::GetStats() const
+{
+    Stats stats;
+    stats.snapshots = GetCount();
+    if (snapshots.empty()) return stats;
+
+    // Oldest first, each page counted where it first appears; the page
+    // bytes plus the shared vector they live in
+    std::unordered_set<const void*> seen;
+    auto count = [&](const void* shared, size_t size) -> size_t {
+        return seen.insert(shared).second ? size + sizeof(Bytes) : 0;
+    };
+    auto countPage = [&](const Page& page) { return count(page.bytes.get(), page.bytes->size()); };
+
+    for (const Snapshot& snapshot : snapshots) {
+        size_t bytes = TableBytes(snapshot);
+        size_t unlockBytes = 0;
+        for (const std::string& tech : *snapshot.unlocks) unlockBytes += sizeof(std::string) + tech.size();
+        bytes += count(snapshot.unlocks.get(), unlockBytes);
+        for (const Page& page : snapshot.chunks) bytes += countPage(page);
+        for (const ColonyPages& colony : snapshot.colonies) {
+            bytes += countPage(colony.own);
+            for (const SectPages& sect : colony.sects) {
+                bytes += countPage(sect.own);
+                for (const Page& unit : sect.units) bytes += countPage(unit);
+            }
+        }
+        if (&snapshot == &snapshots.front()) stats.baseBytes = bytes;
+        stats.retainedBytes += bytes;
+    }
+
+    stats.retainedSeconds = snapshots.back().gameTime - snapshots.front().gameTime;
+    if (stats.retainedSeconds > 0.0f) {
+        stats.bytesPerSecond = static_cast<float>(stats.retainedBytes - stats.baseBytes) / stats.retainedSeconds;
+    }
+    stats.lastCaptureBytes = snapshots.back().newBytes;
+    stats.lastCapturePages = snapshots.back().newPages;
+    return stats;
+}
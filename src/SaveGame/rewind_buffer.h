@@ -0,0 +1,85 @@
+#ifndef REWIND_BUFFER_H
+#define REWIND_BUFFER_H
+
+#include "colony.h"
+#include "game_constants.h"
+#include "resource_manager.h"
+#include "sim_clock.h"
+#include "time_manager.h"
+#include "world_pages.h"
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+// In-memory rewind: a bounded ring of whole-game snapshots, each a table
+// of immutable pages (WorldPages) shared copy-on-write with the snapshots
+// around it.
+//
+// Capture() takes its pages after the newest snapshot's: unchanged
+// objects share that page, changed ones are serialised into a new one. A
+// capture costs the changed objects plus a page pointer per object; so
+// does the memory it keeps. The clock is copied every time; the unlocks
+// when they change.
+//
+// Restore() goes back to any retained snapshot without touching a file:
+// the planet chunks whose revision differs are reloaded and the colonies
+// rebuilt from their pages through the normal constructors, as
+// SaveGame::Load does. The snapshots after it are dropped, so the game
+// carries on from there as a new history.
+class RewindBuffer {
+public:
+    struct Stats {
+        int snapshots = 0;
+        float retainedSeconds = 0.0f;   // game time from the oldest snapshot to the newest
+        size_t baseBytes = 0;           // the oldest snapshot on its own: one full copy
+        size_t retainedBytes = 0;       // every distinct page and page table in the ring
+        float bytesPerSecond = 0.0f;    // retained beyond the base, per retained second
+        size_t lastCaptureBytes = 0;    // pages new in the newest snapshot
+        int lastCapturePages = 0;
+    };
+
+    explicit RewindBuffer(int capacity = REWIND_SNAPSHOTS);
+
+    // Drops every snapshot. Call when the colonies are replaced by
+    // anything but Restore (new game, load).
+    void Clear();
+
+    // Appends a snapshot of the game as it stands, dropping the oldest
+    // once the ring is full
+    void Capture(const ResourceManager& resources, const TimeManager& time,
+                 const std::vector<Colony*>& colonies);
+
+    // Snapshots oldest first
+    int GetCount() const { return static_cast<int>(snapshots.size()); }
+    int GetCapacity() const { return capacity; }
+    int GetTicks(int index) const { return snapshots[index].ticks; }
+    float GetGameTime(int index) const { return snapshots[index].gameTime; }
+
+    // The newest snapshot taken before `ticks`, -1 if there is none
+    int FindBefore(int ticks) const;
+
+    // Rewinds to snapshot `index`. On success the planet, clock and
+    // unlocks are as they were and `outColonies` holds new colonies the
+    // caller owns, on `clock` (Colony::SetClock); the old ones are left
+    // to the caller. False on a bad index or a planet of another size,
+    // with nothing touched.
+    bool Restore(int index, ResourceManager& resources, TimeManager& time,
+                 std::vector<Colony*>& outColonies, const SimClock* clock = nullptr);
+
+    // Walks the ring, so meant for reports rather than every frame
+    Stats GetStats() const;
+
+private:
+    using Bytes = WorldPages::Bytes;
+    using Page = WorldPages::Page;
+    using SectPages = WorldPages::SectPages;
+    using ColonyPages = WorldPages::ColonyPages;
+    using Snapshot = WorldPages;
+
+    int capacity;
+    std::deque<Snapshot> snapshots;
+
+    static size_t TableBytes(const Snapshot& snapshot);
+};
+
+#endif // REWIND_BUFFER_H
@@ -0,0 +1,297 @@
+#include "save_file.h"
+#include "block_codec.h"
+#include <cstdio>
+#include <cstring>
+
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(__EMSCRIPTEN__)
+#define SAVE_FILE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+const char MAGIC[8] = {'C', 'O', 'L', 'O', 'N', 'Y', 'S', 'V'};
+const size_t HEADER_BYTES = 8 + 4 + 4 + 8;
+const size_t INDEX_ENTRY_BYTES = 4 + 4 + 8 + 8 + 8 + 4;
+const uint32_t FLAG_COMPRESSED = 1;
+
+void SetError(std::string* error, const std::string& message) {
+    if (error) *error = message;
+}
+
+std::string SectionName(uint32_t id) {
+    return "section " + std::to_string(id);
+}
+
+} // namespace
+
+uint32_t SaveChecksum(const uint8_t* data, size_t size) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+// ---------------------------------------------------------------------------
+// SaveFileWriter
+// ---------------------------------------------------------------------------
+
+void SaveFileWriter::AddSection(uint32_t id, const ByteWriter& payload, bool compress) {
+    const std::vector<uint8_t>& raw = payload.GetBytes();
+
+    Section section;
+    section.id = id;
+    section.flags = 0;
+    section.rawSize = raw.size();
+    section.checksum = SaveChecksum(raw.data(), raw.size());
+
+    if (compress) {
+        std::vector<uint8_t> packed = BlockCodec::Compress(raw.data(), raw.size());
+        if (packed.size() < raw.size()) {
+            section.flags |= FLAG_COMPRESSED;
+            section.stored = std::move(packed);
+        }
+    }
+    if (!(section.flags & FLAG_COMPRESSED)) {
+        section.stored = raw;
+    }
+    sections.push_back(std::move(section));
+}
+
+size_t SaveFileWriter::GetRawSize() const {
+    size_t total = 0;
+    for (const Section& section : sections) total += section.rawSize;
+    return total;
+}
+
+size_t SaveFileWriter::GetStoredSize() const {
+    size_t total = HEADER_BYTES + sections.size() * INDEX_ENTRY_BYTES;
+    for (const Section& section : sections) total += section.stored.size();
+    return total;
+}
+
+bool SaveFileWriter::WriteTo(const std::string& path, uint32_t formatVersion, std::string* error) const {
+    uint64_t offset = HEADER_BYTES;
+    ByteWriter indexBytes;
+    for (const Section& section : sections) {
+        indexBytes.Write<uint32_t>(section.id);
+        indexBytes.Write<uint32_t>(section.flags);
+        indexBytes.Write<uint64_t>(offset);
+        indexBytes.Write<uint64_t>(section.stored.size());
+        indexBytes.Write<uint64_t>(section.rawSize);
+        indexBytes.Write<uint32_t>(section.checksum);
+        offset += section.stored.size();
+    }
+
+    ByteWriter header;
+    header.WriteBytes(MAGIC, sizeof(MAGIC));
+    header.Write<uint32_t>(formatVersion);
+    header.Write<uint32_t>(static_cast<uint32_t>(sections.size()));
+    header.Write<uint64_t>(offset);
+
+    // Written beside the target and renamed over it, so a failed save
+    // never leaves a truncated file where the last good one was
+    const std::string tempPath = path + ".tmp";
+    FILE* out = std::fopen(tempPath.c_str(), "wb");
+    if (!out) {
+        SetError(error, "cannot open " + tempPath + " for writing");
+        return false;
+    }
+
+    bool ok = std::fwrite(header.GetBytes().data(), 1, header.GetSize(), out) == header.GetSize();
+    for (const Section& section : sections) {
+        if (!ok) break;
+        ok = std::fwrite(section.stored.data(), 1, section.stored.size(), out) == section.stored.size();
+    }
+    ok = ok && std::fwrite(indexBytes.GetBytes().data(), 1, indexBytes.GetSize(), out) == indexBytes.GetSize();
+    ok = (std::fclose(out) == 0) && ok;
+
+    if (!ok) {
+        std::remove(tempPath.c_str());
+        SetError(error, "write to " + tempPath + " failed");
+        return false;
+    }
+
+    std::remove(path.c_str());      // rename does not replace on Windows
+    if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        SetError(error, "cannot move " + tempPath + " to " + path);
+        return false;
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// SaveFileReader
+// ---------------------------------------------------------------------------
+
+class SaveFileReader::FileView {
+public:
+    ~FileView() {
+#ifdef SAVE_FILE_MMAP
+        if (mapped) munmap(const_cast<uint8_t*>(data), size);
+#endif
+    }
+
+    bool Open(const std::string& path) {
+#ifdef SAVE_FILE_MMAP
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat info;
+        if (fstat(fd, &info) == 0 && info.st_size > 0) {
+            void* address = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (address != MAP_FAILED) {
+                data = static_cast<const uint8_t*>(address);
+                size = static_cast<size_t>(info.st_size);
+                mapped = true;
+            }
+        }
+        ::close(fd);
+        if (mapped) return true;
+#endif
+        // No mapping available: read the whole file
+        FILE* in = std::fopen(path.c_str(), "rb");
+        if (!in) return false;
+        std::fseek(in, 0, SEEK_END);
+        long length = std::ftell(in);
+        std::fseek(in, 0, SEEK_SET);
+        if (length < 0) {
+            std::fclose(in);
+            return false;
+        }
+        buffer.resize(static_cast<size_t>(length));
+        bool ok = std::fread(buffer.data(), 1, buffer.size(), in) == buffer.size();
+        std::fclose(in);
+        data = buffer.data();
+        size = buffer.size();
+        return ok;
+    }
+
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    bool mapped = false;
+
+private:
+    std::vector<uint8_t> buffer;
+};
+
+SaveFileReader::SaveFileReader() : formatVersion(0) {
+}
+
+SaveFileReader::~SaveFileReader() = default;
+
+size_t SaveFileReader::GetFileSize() const {
+    return file ? file->size : 0;
+}
+
+bool SaveFileReader::IsMapped() const {
+    return file && file->mapped;
+}
+
+bool SaveFileReader::Open(const std::string& path, std::string* error) {
+    file.reset(new FileView());
+    index.clear();
+    decoded.clear();
+
+    if (!file->Open(path)) {
+        SetError(error, "cannot read " + path);
+        return false;
+    }
+
+    ByteReader header(file->data, file->size);
+    char magic[sizeof(MAGIC)];
+    if (!header.ReadBytes(magic, sizeof(magic)) || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0) {
+        SetError(error, path + " is not a colony save");
+        return false;
+    }
+    formatVersion = header.Read<uint32_t>();
+    uint32_t sectionCount = header.Read<uint32_t>();
+    uint64_t indexOffset = header.Read<uint64_t>();
+
+    if (!header.Ok() || indexOffset > file->size ||
+        sectionCount > (file->size - indexOffset) / INDEX_ENTRY_BYTES) {
+        SetError(error, path + " has a damaged header");
+        return false;
+    }
+
+    ByteReader entries(file->data + indexOffset, file->size - indexOffset);
+    for (uint32_t i = 0; i < sectionCount; i++) {
+        uint32_t id = entries.Read<uint32_t>();
+        Entry entry;
+        entry.flags = entries.Read<uint32_t>();
+        entry.offset = entries.Read<uint64_t>();
+        entry.storedSize = entries.Read<uint64_t>();
+        entry.rawSize = entries.Read<uint64_t>();
+        entry.checksum = entries.Read<uint32_t>();
+
+        if (entry.offset < HEADER_BYTES || entry.offset > indexOffset ||
+            entry.storedSize > indexOffset - entry.offset) {
+            SetError(error, SectionName(id) + " lies outside the file");
+            return false;
+        }
+        index[id] = entry;
+    }
+    return true;
+}
+
+bool SaveFileReader::Decode(uint32_t id, const Entry& entry, std::vector<uint8_t>* keep, std::string* error) {
+    const uint8_t* stored = file->data + entry.offset;
+    const uint8_t* raw = stored;
+    std::vector<uint8_t> scratch;
+
+    if (entry.flags & FLAG_COMPRESSED) {
+        std::vector<uint8_t>& target = keep ? *keep : scratch;
+        target.resize(static_cast<size_t>(entry.rawSize));
+        if (!BlockCodec::Decompress(stored, static_cast<size_t>(entry.storedSize),
+                                    target.data(), target.size())) {
+            SetError(error, SectionName(id) + " does not decompress");
+            return false;
+        }
+        raw = target.data();
+    } else if (entry.storedSize != entry.rawSize) {
+        SetError(error, SectionName(id) + " has the wrong size");
+        return false;
+    }
+
+    if (SaveChecksum(raw, static_cast<size_t>(entry.rawSize)) != entry.checksum) {
+        SetError(error, SectionName(id) + " fails its checksum");
+        return false;
+    }
+    return true;
+}
+
+bool SaveFileReader::GetSection(uint32_t id, ByteReader& out, std::string* error) {
+    auto it = index.find(id);
+    if (it == index.end()) {
+        SetError(error, SectionName(id) + " is missing");
+        return false;
+    }
+    const Entry& entry = it->second;
+
+    if (entry.flags & FLAG_COMPRESSED) {
+        auto cached = decoded.find(id);
+        if (cached == decoded.end()) {
+            std::vector<uint8_t> bytes;
+            if (!Decode(id, entry, &bytes, error)) return false;
+            cached = decoded.emplace(id, std::move(bytes)).first;
+        }
+        out = ByteReader(cached->second.data(), cached->second.size());
+        return true;
+    }
+
+    // Uncompressed sections are read straight out of the mapping
+    if (!Decode(id, entry, nullptr, error)) return false;
+    out = ByteReader(file->data + entry.offset, static_cast<size_t>(entry.rawSize));
+    return true;
+}
+
+bool SaveFileReader::VerifyAll(std::string* error) {
+    for (const auto& [id, entry] : index) {
+        if (decoded.count(id)) continue;
+        if (!Decode(id, entry, nullptr, error)) return false;
+    }
+    return true;
+}
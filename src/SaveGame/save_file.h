@@ -0,0 +1,91 @@
+#ifndef SAVE_FILE_H
+#define SAVE_FILE_H
+
+#include "byte_stream.h"
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Container for a save: a header, independently stored sections, and an
+// index of them at the end of the file.
+//
+//   header   magic "COLONYSV", format version, section count, index offset
+//   sections raw or BlockCodec-compressed payloads, back to back
+//   index    per section: id, flags, offset, stored size, raw size, checksum
+//
+// Everything is little-endian. A reader loads only the header and index
+// up front; a section is mapped (or read) and decompressed the first time
+// it is asked for, so a load screen can show the metadata section of a
+// large save without touching the planet grids.
+class SaveFileWriter {
+public:
+    // Compressed only when that makes the section smaller
+    void AddSection(uint32_t id, const ByteWriter& payload, bool compress);
+
+    bool WriteTo(const std::string& path, uint32_t formatVersion, std::string* error) const;
+
+    size_t GetRawSize() const;
+    size_t GetStoredSize() const;
+
+private:
+    struct Section {
+        uint32_t id;
+        uint32_t flags;
+        uint64_t rawSize;
+        uint32_t checksum;
+        std::vector<uint8_t> stored;
+    };
+    std::vector<Section> sections;
+};
+
+class SaveFileReader {
+public:
+    SaveFileReader();
+    ~SaveFileReader();
+
+    SaveFileReader(const SaveFileReader&) = delete;
+    SaveFileReader& operator=(const SaveFileReader&) = delete;
+
+    // Reads and checks the header and index only
+    bool Open(const std::string& path, std::string* error);
+
+    uint32_t GetFormatVersion() const { return formatVersion; }
+    bool HasSection(uint32_t id) const { return index.count(id) > 0; }
+
+    // The section's raw bytes, valid while the reader lives. False when
+    // the section is missing, its checksum is wrong or it will not
+    // decompress.
+    bool GetSection(uint32_t id, ByteReader& out, std::string* error);
+
+    // Checks every section's checksum without keeping the decoded bytes
+    bool VerifyAll(std::string* error);
+
+    size_t GetFileSize() const;
+    bool IsMapped() const;
+
+private:
+    struct Entry {
+        uint32_t flags;
+        uint64_t offset;
+        uint64_t storedSize;
+        uint64_t rawSize;
+        uint32_t checksum;
+    };
+
+    // Whole-file view: memory-mapped where the platform allows, else read
+    class FileView;
+
+    bool Decode(uint32_t id, const Entry& entry, std::vector<uint8_t>* keep, std::string* error);
+
+    std::unique_ptr<FileView> file;
+    uint32_t formatVersion;
+    std::map<uint32_t, Entry> index;
+    std::map<uint32_t, std::vector<uint8_t>> decoded;   // decompressed sections
+};
+
+// FNV-1a over a section's raw bytes
+uint32_t SaveChecksum(const uint8_t* data, size_t size);
+
+#endif // SAVE_FILE_H
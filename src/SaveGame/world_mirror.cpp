@@ -0,0 +1,142 @@
+#include "world_mirror.h"
+#include <string>
+#include <utility>
+
+void WorldMirror::Clear()
+{
+    chunks.clear();
+    colonies.clear();
+}
+
+bool WorldMirror::Sync(const WorldPages& pages, ResourceManager& resources, TimeManager& time,
+                       std::vector<Colony*>& target, const SimClock* clock, SyncStats* stats)
+{
+    if (pages.gridSize != resources.GetGridSize()) return false;
+
+    SyncStats result;
+    TimeManager syncedTime;
+    ByteReader clockBytes(pages.clock.data(), pages.clock.size());
+    if (syncedTime.LoadState(clockBytes)) time = syncedTime;
+
+    // Planet first: sects read it as they are built
+    chunks.resize(pages.chunks.size());
+    for (size_t chunk = 0; chunk < pages.chunks.size(); chunk++) {
+        const int index = static_cast<int>(chunk);
+        if (IsCurrent(chunks[chunk], pages.chunks[chunk], resources.GetCellChunkRevision(index))) continue;
+        pages.LoadChunk(chunk, resources);
+        chunks[chunk].bytes = pages.chunks[chunk].bytes;
+        chunks[chunk].revision = resources.GetCellChunkRevision(index);
+        result.pagesLoaded++;
+    }
+
+    while (target.size() > pages.colonies.size()) {
+        delete target.back();
+        target.pop_back();
+        result.objectsRemoved = true;
+    }
+
+    std::vector<LoadedColony> synced(pages.colonies.size());
+    for (size_t c = 0; c < pages.colonies.size(); c++) {
+        const WorldPages::ColonyPages& colonyPages = pages.colonies[c];
+        if (c < target.size()) {
+            const LoadedColony* before = nullptr;
+            if (c < colonies.size() && colonies[c].colony == target[c]) before = &colonies[c];
+            if (SyncInPlace(colonyPages, target[c], before, resources, time, result.pagesLoaded)) {
+                synced[c] = Record(colonyPages, target[c]);
+                continue;
+            }
+        }
+
+        // New, or past following in place
+        Colony* built = nullptr;
+        if (!WorldPages::BuildColony(colonyPages, resources, time, clock, built)) {
+            // Cannot happen short of a bug; the copy keeps one colony fewer
+            // than the game until a later table reads back
+            built = new Colony();
+            built->SetClock(clock);
+        }
+        if (c < target.size()) {
+            delete target[c];
+            target[c] = built;
+            result.objectsRemoved = true;
+        } else {
+            target.push_back(built);
+        }
+        synced[c] = Record(colonyPages, built);
+        result.coloniesBuilt++;
+    }
+    colonies = std::move(synced);
+
+    if (stats) *stats = result;
+    return true;
+}
+
+bool WorldMirror::SyncInPlace(const WorldPages::ColonyPages& pages, Colony* colony, const LoadedColony* before,
+                              ResourceManager& resources, TimeManager& time, int& pagesLoaded)
+{
+    const std::vector<Sect*>& sects = colony->GetSects();
+    if (sects.size() > pages.sects.size()) return false;
+
+    bool sectAdded = false;
+    for (size_t s = 0; s < pages.sects.size(); s++) {
+        const WorldPages::SectPages& sectPages = pages.sects[s];
+        if (s == sects.size()) {
+            Vector2 position = sectPages.position;
+            colony->AddSect(new Sect(position, resources, time));
+            sectAdded = true;
+        }
+        Sect* sect = sects[s];
+        const Vector2 position = sect->GetPosition();
+        if (position.x != sectPages.position.x || position.y != sectPages.position.y) return false;
+
+        const std::vector<Unit*>& units = sect->GetUnits();
+        if (units.size() > sectPages.units.size()) return false;
+        const LoadedSect* sectBefore = before && s < before->sects.size() ? &before->sects[s] : nullptr;
+
+        for (size_t u = 0; u < sectPages.units.size(); u++) {
+            if (sectBefore && u < units.size() && u < sectBefore->units.size() &&
+                IsCurrent(sectBefore->units[u], sectPages.units[u], units[u]->GetStateRevision())) {
+                continue;
+            }
+            ByteReader in = WorldPages::Read(sectPages.units[u]);
+            std::string type = in.ReadString();
+            if (!sect->LoadUnitState(u, type, in)) return false;
+            pagesLoaded++;
+        }
+        if (!sectBefore || !IsCurrent(sectBefore->own, sectPages.own, sect->GetStateRevision())) {
+            ByteReader own = WorldPages::Read(sectPages.own);
+            if (!sect->LoadOwnState(own)) return false;
+            pagesLoaded++;
+        }
+    }
+
+    // Roads and jobs name sects by index, so a new sect means a reload
+    if (sectAdded || !before || !IsCurrent(before->own, pages.own, colony->GetStateRevision())) {
+        ByteReader own = WorldPages::Read(pages.own);
+        if (!colony->LoadOwnState(own)) return false;
+        pagesLoaded++;
+    }
+    return true;
+}
+
+WorldMirror::LoadedColony WorldMirror::Record(const WorldPages::ColonyPages& pages, const Colony* colony)
+{
+    LoadedColony loaded;
+    loaded.colony = colony;
+    loaded.own.bytes = pages.own.bytes;
+    loaded.own.revision = colony->GetStateRevision();
+    const std::vector<Sect*>& sects = colony->GetSects();
+    loaded.sects.resize(sects.size());
+    for (size_t s = 0; s < sects.size(); s++) {
+        LoadedSect& sect = loaded.sects[s];
+        sect.own.bytes = pages.sects[s].own.bytes;
+        sect.own.revision = sects[s]->GetStateRevision();
+        const std::vector<Unit*>& units = sects[s]->GetUnits();
+        sect.units.resize(units.size());
+        for (size_t u = 0; u < units.size(); u++) {
+            sect.units[u].bytes = pages.sects[s].units[u].bytes;
+            sect.units[u].revision = units[u]->GetStateRevision();
+        }
+    }
+    return loaded;
+}
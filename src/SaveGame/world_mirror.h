@@ -0,0 +1,75 @@
+#ifndef WORLD_MIRROR_H
+#define WORLD_MIRROR_H
+
+#include "colony.h"
+#include "resource_manager.h"
+#include "sim_clock.h"
+#include "time_manager.h"
+#include "world_pages.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// A second copy of the game kept in step with WorldPages captured from
+// the first, for a reader on another thread (the renderer, while the sim
+// thread runs the game).
+//
+// Sync() loads only the pages that differ from the ones it loaded last
+// time, into the objects it loaded them into: colonies, sects and units
+// stay where they are, so pointers into them (the selection) stay good.
+// An object changed locally since (a predicted command) is reloaded even
+// when its page has not changed. Where the copy cannot follow in place -
+// fewer colonies, sects or units than it has, a sect somewhere else, a
+// unit of another type - the colony is built again from its pages, as
+// RewindBuffer::Restore does, and Sync() says so.
+//
+// Unlocks are process-wide (UnlockRegistry) and are not mirrored.
+class WorldMirror {
+public:
+    struct SyncStats {
+        int pagesLoaded = 0;
+        int coloniesBuilt = 0;          // new, or rebuilt in place of an old one
+        bool objectsRemoved = false;    // a colony, sect or unit pointer went away
+    };
+
+    // Brings `resources`, `time` and `colonies` to `pages`. The colonies are
+    // the caller's; ones no longer in `pages` are deleted, new ones built
+    // on `clock`, which the caller sets to the captured game's clock first
+    // (Colony::LoadOwnState reads it). False on a planet of another size,
+    // with nothing touched.
+    bool Sync(const WorldPages& pages, ResourceManager& resources, TimeManager& time,
+              std::vector<Colony*>& colonies, const SimClock* clock, SyncStats* stats = nullptr);
+
+    // Forgets what was loaded, so the next Sync() loads every page. Call
+    // when the colonies are replaced by anything but Sync().
+    void Clear();
+
+private:
+    // A page as loaded, and the object's revision right after
+    struct Loaded {
+        std::shared_ptr<const WorldPages::Bytes> bytes;
+        uint32_t revision = 0;
+    };
+    struct LoadedSect {
+        std::vector<Loaded> units;
+        Loaded own;
+    };
+    struct LoadedColony {
+        const Colony* colony = nullptr;
+        Loaded own;
+        std::vector<LoadedSect> sects;
+    };
+
+    std::vector<Loaded> chunks;
+    std::vector<LoadedColony> colonies;
+
+    static bool IsCurrent(const Loaded& loaded, const WorldPages::Page& page, uint32_t revision) {
+        return loaded.bytes == page.bytes && loaded.revision == revision;
+    }
+
+    bool SyncInPlace(const WorldPages::ColonyPages& pages, Colony* colony, const LoadedColony* before,
+                     ResourceManager& resources, TimeManager& time, int& pagesLoaded);
+    static LoadedColony Record(const WorldPages::ColonyPages& pages, const Colony* colony);
+};
+
+#endif // WORLD_MIRROR_H
@@ -0,0 +1,166 @@
+#include "world_pages.h"
+#include "unlock_registry.h"
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+WorldPages::Page Seal(uint32_t revision, ByteWriter& out, WorldPages& pages)
+{
+    auto bytes = std::make_shared<WorldPages::Bytes>(std::move(out.GetBytes()));
+    bytes->shrink_to_fit();
+    pages.newBytes += bytes->size();
+    pages.newPages++;
+
+    WorldPages::Page page;
+    page.revision = revision;
+    page.bytes = std::move(bytes);
+    return page;
+}
+
+} // namespace
+
+WorldPages WorldPages::Capture(const ResourceManager& resources, const TimeManager& time,
+                               const std::vector<Colony*>& colonies, const WorldPages* previous)
+{
+    WorldPages next;
+    next.ticks = time.GetTicks();
+    next.gameTime = time.GetGameTime();
+    ByteWriter clock;
+    time.SaveState(clock);
+    next.clock = std::move(clock.GetBytes());
+
+    std::vector<std::string> techs = UnlockRegistry::Instance().GetAll();
+    if (previous && previous->unlocks && *previous->unlocks == techs) {
+        next.unlocks = previous->unlocks;
+    } else {
+        next.unlocks = std::make_shared<const std::vector<std::string>>(std::move(techs));
+    }
+
+    // Planet chunks, each the cells it covers row by row
+    const int gridSize = resources.GetGridSize();
+    const int chunksPerSide = resources.GetCellChunksPerSide();
+    const bool samePlanet = previous && previous->gridSize == gridSize;
+    next.gridSize = gridSize;
+    next.chunks.resize(static_cast<size_t>(chunksPerSide) * chunksPerSide);
+    for (size_t chunk = 0; chunk < next.chunks.size(); chunk++) {
+        const uint32_t revision = resources.GetCellChunkRevision(static_cast<int>(chunk));
+        if (samePlanet && previous->chunks[chunk].revision == revision) {
+            next.chunks[chunk] = previous->chunks[chunk];
+            continue;
+        }
+        const int x0 = static_cast<int>(chunk % chunksPerSide) * ResourceManager::CELL_CHUNK_SIZE;
+        const int y0 = static_cast<int>(chunk / chunksPerSide) * ResourceManager::CELL_CHUNK_SIZE;
+        ByteWriter out;
+        for (int y = y0; y < std::min(y0 + ResourceManager::CELL_CHUNK_SIZE, gridSize); y++) {
+            for (int x = x0; x < std::min(x0 + ResourceManager::CELL_CHUNK_SIZE, gridSize); x++) {
+                resources.SaveCellState(out, y * gridSize + x);
+            }
+        }
+        next.chunks[chunk] = Seal(revision, out, next);
+    }
+
+    next.colonies.resize(colonies.size());
+    for (size_t c = 0; c < colonies.size(); c++) {
+        const Colony* colony = colonies[c];
+        const ColonyPages* colonyBefore = nullptr;
+        if (previous && c < previous->colonies.size() && previous->colonies[c].colony == colony) {
+            colonyBefore = &previous->colonies[c];
+        }
+        ColonyPages& colonyPages = next.colonies[c];
+        colonyPages.colony = colony;
+
+        const std::vector<Sect*>& sects = colony->GetSects();
+        colonyPages.sects.resize(sects.size());
+        for (size_t s = 0; s < sects.size(); s++) {
+            const Sect* sect = sects[s];
+            const SectPages* sectBefore = nullptr;
+            if (colonyBefore && s < colonyBefore->sects.size() && colonyBefore->sects[s].sect == sect) {
+                sectBefore = &colonyBefore->sects[s];
+            }
+            SectPages& sectPages = colonyPages.sects[s];
+            sectPages.sect = sect;
+            sectPages.position = sect->GetPosition();
+
+            // Unit actions spend sect storage, so a changed unit takes a
+            // new page of its sect's own state too
+            bool unitChanged = false;
+            const std::vector<Unit*>& units = sect->GetUnits();
+            sectPages.units.resize(units.size());
+            for (size_t u = 0; u < units.size(); u++) {
+                const uint32_t revision = units[u]->GetStateRevision();
+                if (sectBefore && u < sectBefore->units.size() && sectBefore->units[u].revision == revision) {
+                    sectPages.units[u] = sectBefore->units[u];
+                    continue;
+                }
+                ByteWriter out;
+                out.WriteString(units[u]->GetUnitType());
+                units[u]->SaveState(out);
+                sectPages.units[u] = Seal(revision, out, next);
+                unitChanged = true;
+            }
+
+            const uint32_t revision = sect->GetStateRevision();
+            if (sectBefore && !unitChanged && sectBefore->own.revision == revision) {
+                sectPages.own = sectBefore->own;
+            } else {
+                ByteWriter out;
+                sect->SaveOwnState(out);
+                sectPages.own = Seal(revision, out, next);
+            }
+        }
+
+        const uint32_t revision = colony->GetStateRevision();
+        if (colonyBefore && colonyBefore->own.revision == revision) {
+            colonyPages.own = colonyBefore->own;
+        } else {
+            ByteWriter out;
+            colony->SaveOwnState(out);
+            colonyPages.own = Seal(revision, out, next);
+        }
+    }
+    return next;
+}
+
+void WorldPages::LoadChunk(size_t chunk, ResourceManager& resources) const
+{
+    const int chunksPerSide = resources.GetCellChunksPerSide();
+    const int x0 = static_cast<int>(chunk % chunksPerSide) * ResourceManager::CELL_CHUNK_SIZE;
+    const int y0 = static_cast<int>(chunk / chunksPerSide) * ResourceManager::CELL_CHUNK_SIZE;
+    ByteReader in = Read(chunks[chunk]);
+    for (int y = y0; y < std::min(y0 + ResourceManager::CELL_CHUNK_SIZE, gridSize); y++) {
+        for (int x = x0; x < std::min(x0 + ResourceManager::CELL_CHUNK_SIZE, gridSize); x++) {
+            resources.LoadCellState(in, y * gridSize + x);
+        }
+    }
+}
+
+bool WorldPages::BuildColony(const ColonyPages& pages, ResourceManager& resources, TimeManager& time,
+                             const SimClock* clock, Colony*& outColony)
+{
+    // Every page was written by Capture, so none fails to read back short
+    // of a bug
+    bool ok = true;
+    Colony* colony = new Colony();
+    colony->SetClock(clock);
+    for (const SectPages& sectPages : pages.sects) {
+        Vector2 position = sectPages.position;
+        Sect* sect = new Sect(position, resources, time);
+        colony->AddSect(sect);
+        ByteReader own = Read(sectPages.own);
+        ok = sect->LoadOwnState(own) && ok;
+        for (size_t u = 0; u < sectPages.units.size(); u++) {
+            ByteReader in = Read(sectPages.units[u]);
+            std::string type = in.ReadString();
+            ok = sect->LoadUnitState(u, type, in) && ok;
+        }
+    }
+    ByteReader own = Read(pages.own);
+    ok = colony->LoadOwnState(own) && ok;
+    if (!ok) {
+        delete colony;
+        return false;
+    }
+    outColony = colony;
+    return true;
+}
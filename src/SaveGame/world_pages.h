@@ -0,0 +1,76 @@
+#ifndef WORLD_PAGES_H
+#define WORLD_PAGES_H
+
+#include "byte_stream.h"
+#include "colony.h"
+#include "resource_manager.h"
+#include "sim_clock.h"
+#include "time_manager.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// The whole game as a table of immutable pages, shared copy-on-write with
+// the table it was captured after.
+//
+// Pages are the autosave journal's records (autosave_journal.h): a
+// colony's own state, a sect's own state, one unit, plus a square chunk
+// of planet cells (ResourceManager::CELL_CHUNK_SIZE). Capture() compares
+// each object's state revision, and each chunk's revision, with the one
+// behind its page in `previous`: unchanged objects share that page,
+// changed ones are serialised into a new one. A capture costs the changed
+// objects plus a page pointer per object.
+//
+// Pages never change once sealed, so a table can be read on another
+// thread while the game goes on (RewindBuffer keeps a ring of them; the
+// sim thread publishes one for the renderer).
+struct WorldPages {
+    using Bytes = std::vector<uint8_t>;
+
+    struct Page {
+        uint32_t revision = 0;
+        std::shared_ptr<const Bytes> bytes;
+    };
+    struct SectPages {
+        const Sect* sect = nullptr;     // taken from; only compared, never read through
+        Vector2 position = {0.0f, 0.0f};
+        Page own;
+        std::vector<Page> units;        // unit type, then Unit::SaveState
+    };
+    struct ColonyPages {
+        const Colony* colony = nullptr;
+        Page own;
+        std::vector<SectPages> sects;
+    };
+
+    int ticks = 0;
+    float gameTime = 0.0f;
+    Bytes clock;                        // TimeManager::SaveState, copied every time
+    std::shared_ptr<const std::vector<std::string>> unlocks;
+    int gridSize = 0;
+    std::vector<Page> chunks;
+    std::vector<ColonyPages> colonies;
+    size_t newBytes = 0;                // pages this capture sealed
+    int newPages = 0;
+
+    // The game as it stands. Pages are matched by index and checked
+    // against the object they were taken from: colonies, sects and units
+    // are only ever appended.
+    static WorldPages Capture(const ResourceManager& resources, const TimeManager& time,
+                              const std::vector<Colony*>& colonies, const WorldPages* previous = nullptr);
+
+    // Writes chunk `chunk`'s cells into `resources`, a planet of gridSize
+    void LoadChunk(size_t chunk, ResourceManager& resources) const;
+
+    // A new colony built from its pages through the normal constructors,
+    // as SaveGame::Load does, on `clock`; its sects on `resources` and
+    // `time`. False if a page does not read back, with nothing built.
+    static bool BuildColony(const ColonyPages& pages, ResourceManager& resources, TimeManager& time,
+                            const SimClock* clock, Colony*& outColony);
+
+    static ByteReader Read(const Page& page) { return ByteReader(page.bytes->data(), page.bytes->size()); }
+};
+
+#endif // WORLD_PAGES_H
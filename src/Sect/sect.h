@@ -9,6 +9,8 @@
 #include <cmath>  // Add this for cosf, sinf, etc.
 
 #include "resource_manager.h"
+#include "resource_vector.h"
+#include "typed_inventory.h"
 #include "game_enums.h"
 
 // CLITERAL is raylib's portability shim: it expands to `(Color)` in C and
@@ -16,6 +18,8 @@
 // is a GCC/Clang extension that MSVC rejects outright (error C4576).
 #define CHINAROSE CLITERAL(Color){ 160, 70, 104, 255 }
 
+class ByteWriter;
+class ByteReader;
 
 class Sect {
 public:
@@ -32,10 +36,21 @@ public:
     void ConsumeResources();
     void BuildUnit(std::string unit_type);
     void UpgradeUnit(Unit* unit);
-    void Update(float deltaTime);
-    void Draw(Vector2 position);
-    void DrawInColonyView(Vector2 position);
-    void DrawInSectView(Vector2 position);
+    void Update(float deltaTime);           // UpdateLocal, then CommitDepletion
+
+    // The two halves of Update for the parallel step. UpdateLocal touches
+    // only this sect and its units (planet depletion is logged, not
+    // applied); CommitDepletion applies the log to the ResourceManager.
+    void UpdateLocal(float deltaTime);
+    void CommitDepletion();
+    // Applies `log` as CommitDepletion applies its own (ColonyLod)
+    void CommitDepletion(const std::vector<ResourceManager::Depletion>& log);
+
+    // False when an update would change nothing: no awake units, energy
+    // at capacity, manpower at base, no roads being built. Stepping code
+    // skips such sects.
+    bool NeedsUpdate() const;
+    int GetAwakeUnitCount() const { return unitActivity.GetAwakeCount(); }
 
     // Setters
     void SetPosition(Vector2 position) {SectPosition = position;}
@@ -44,12 +59,14 @@ public:
     Vector2 GetPosition() const {return SectPosition;}
     const std::vector<Unit*>& GetUnits() const { return units; }
     float GetRadius() const { return coreRadius; }
-    const std::map<ResourceType, float>& GetResourceStorage() const { return resourceStorage; }
-    const std::map<ResourceType, float>& GetStorageCapacity() const { return storageCapacity; }
+    Color GetColor() const { return color; }
+    float GetDevelopmentPercentage() const { return development_percentage; }
+    const ResourceVector& GetResourceStorage() const { return resourceStorage; }
+    const ResourceVector& GetStorageCapacity() const { return storageCapacity; }
     float GetStorageUsage(ResourceType type) const;
 
     // Typed resource getters
-    const std::map<ResourceType, std::vector<TypedResource>>& GetTypedResources() const { return typedResourceStorage; }
+    const TypedInventory& GetTypedResources() const { return typedResourceStorage; }
     int GetTypedResourceCount(ResourceType type, const std::string& subtype) const;
     int GetTotalTypedResourceCount(ResourceType type) const;
 
@@ -71,6 +88,7 @@ public:
 
     // Ambient energy generation
     void GenerateAmbientEnergy(float deltaTime, float timeOfDay);
+    static float AmbientEnergyPerSecond(float timeOfDay);
 
     // Storage upgrades
     int GetStorageLevel() const { return storageLevel; }
@@ -80,6 +98,48 @@ public:
     // Transportation processing
     void UpdateRoadConstruction(float deltaTime);
 
+    // Save game snapshot of storage, roads being built and every unit.
+    // Loading goes into a sect constructed at the saved position: its
+    // initial units are reused where the types line up, extra ones built.
+    void SaveState(ByteWriter& out) const;
+    bool LoadState(ByteReader& in);
+
+    // The parts of the snapshot on their own, for incremental autosave.
+    // Own state is everything but the units. LoadUnitState overwrites
+    // unit `index`, or builds it when index is the unit count; the type
+    // must match the unit already there.
+    void SaveOwnState(ByteWriter& out) const;
+    bool LoadOwnState(ByteReader& in);
+    bool LoadUnitState(size_t index, const std::string& type, ByteReader& in);
+
+    // Bumped whenever the own state may have changed: each update,
+    // storage and typed storage changes, upgrades. Units track their own
+    // (Unit::GetStateRevision). MarkChanged is for code that writes the
+    // storage directly (ModuleStore).
+    uint32_t GetStateRevision() const { return stateRevision; }
+    void MarkChanged() { stateRevision++; }
+
+    // Fast-forward (FastForward). ReadLanes fills `lanes` with the state an
+    // update moves at a steady rate - storage, one lane per resource, then
+    // each unit's lanes (Unit::ReadLanes), then road build progress - each
+    // with the range it can stay in before one of the update's rules
+    // (module efficiency, capacity, manpower regeneration, a timer running
+    // out) changes what a step of `deltaTime` does. True when the step
+    // does the same at any time of day but for the ambient energy, which
+    // then lands in full every step. `everyBuffer` goes to the units.
+    // WriteLanes puts the values back, the storage lanes or the rest on
+    // their own with the two after it.
+    bool ReadLanes(float deltaTime, std::vector<SteadyLane>& lanes, bool everyBuffer = false) const;
+    void WriteLanes(const std::vector<SteadyLane>& lanes);
+    void WriteStorageLanes(const std::vector<SteadyLane>& lanes);
+    void WriteLanesAfterStorage(const std::vector<SteadyLane>& lanes);
+
+    // What UpdateLocal logged for CommitDepletion to apply
+    const std::vector<ResourceManager::Depletion>& GetPendingDepletion() const { return pendingDepletion; }
+    // Energy storage the last UpdateLocal added ambient energy to, after
+    // the units had run
+    float GetEnergyBeforeAmbient() const { return energyBeforeAmbient; }
+
 private:
     ResourceManager& resourceManager;
     TimeManager& timeManager;
@@ -97,37 +157,32 @@ private:
     float coreRadius;               // Derived from default
     Color color;                    // Visual property
 
-    // Texture assets for visual rendering
-    Texture2D domeTexture;                          // Central dome texture
-    std::map<std::string, Texture2D> unitTextures;  // Unit type -> texture mapping
-
     // Position/Location data
     Vector2 SectPosition;           // Position in world space
     std::pair<int, int> location;   // Grid location
 
     // Core gameplay elements
     std::vector<Unit*> units;       // Collection of units
+    std::vector<ResourceManager::Depletion> pendingDepletion;   // units' depletion this tick
+    float energyBeforeAmbient = 0.0f;
+    ActiveSet unitActivity;             // units with work, by index into `units`
+    std::vector<int> awakeScratch;
     Unit* core;                     // Reference to core unit
     float development_percentage;    // Progress tracking
 
     // Resource management (singular resources)
     std::vector<std::string> production_priority;  // Order of production
-    std::map<ResourceType, float> resourceStorage;
-    std::map<ResourceType, float> storageCapacity;
+    ResourceVector resourceStorage;
+    ResourceVector storageCapacity;
     int storageLevel = 0;  // Storage upgrade level (0-3)
+    uint32_t stateRevision = 0;
 
     // Typed resource storage (MACHINERY, ELECTRONICS, ALLOYS, CONSTRUCTION_MATERIALS)
-    std::map<ResourceType, std::vector<TypedResource>> typedResourceStorage;
     static const int TYPED_RESOURCE_CAPACITY = 50;  // Max items per type
+    TypedInventory typedResourceStorage{TYPED_RESOURCE_CAPACITY};
 
     // Private member functions
     void CreateInitialUnits(Vector2 &position);
-    void DrawTransparentRightPanel();
-    void DrawResourceStats(Vector2 position, float coreRadius);
-
-    // Texture management
-    void LoadTextures();    // Load dome and unit textures
-    void UnloadTextures();  // Free texture memory
 };
 
 #endif // SECT_H
@@ -0,0 +1,48 @@
+#ifndef ACTIVE_SET_H
+#define ACTIVE_SET_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+// Which members of a collection have work this tick, by index.
+//
+// Members are woken by whatever gives them work and put back to sleep by
+// their owner once they report idle, so stepping the awake list costs in
+// proportion to the members that are doing something. The awake list is
+// kept ascending: stepping it visits members in the same order as
+// stepping the whole collection, which keeps shared-storage results the
+// same.
+class ActiveSet {
+public:
+    // Adds members up to `count`; new members start awake
+    void Grow(int count) {
+        for (int i = static_cast<int>(isAwake.size()); i < count; i++) {
+            isAwake.push_back(0);
+            Wake(i);
+        }
+    }
+
+    void Wake(int index) {
+        if (isAwake[index]) return;
+        isAwake[index] = 1;
+        awake.insert(std::lower_bound(awake.begin(), awake.end(), index), index);
+    }
+
+    void Sleep(int index) {
+        if (!isAwake[index]) return;
+        isAwake[index] = 0;
+        awake.erase(std::lower_bound(awake.begin(), awake.end(), index));
+    }
+
+    bool IsAwake(int index) const { return isAwake[index] != 0; }
+    const std::vector<int>& GetAwake() const { return awake; }
+    int GetAwakeCount() const { return static_cast<int>(awake.size()); }
+    int GetSize() const { return static_cast<int>(isAwake.size()); }
+
+private:
+    std::vector<int> awake;         // ascending
+    std::vector<uint8_t> isAwake;
+};
+
+#endif // ACTIVE_SET_H
@@ -0,0 +1,651 @@
+#include "colony_lod.h"
+#include "balance_params.h"
+#include "colony.h"
+#include "sect.h"
+#include "time_manager.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <tuple>
+
+namespace {
+    const size_t ENERGY_LANE = static_cast<size_t>(ResourceType::ENERGY);
+
+    bool SameCell(const ResourceManager::Depletion& a, const ResourceManager::Depletion& b) {
+        return a.gridX == b.gridX && a.gridY == b.gridY && a.type == b.type;
+    }
+
+    // One entry per cell and resource, amounts summed
+    void MergeDepletion(std::vector<ResourceManager::Depletion>& log) {
+        std::sort(log.begin(), log.end(), [](const ResourceManager::Depletion& a, const ResourceManager::Depletion& b) {
+            return std::make_tuple(a.gridX, a.gridY, static_cast<int>(a.type)) <
+                   std::make_tuple(b.gridX, b.gridY, static_cast<int>(b.type));
+        });
+        size_t kept = 0;
+        for (size_t i = 0; i < log.size(); i++) {
+            if (kept > 0 && SameCell(log[kept - 1], log[i])) {
+                log[kept - 1].amount += log[i].amount;
+            } else {
+                log[kept++] = log[i];
+            }
+        }
+        log.resize(kept);
+    }
+
+    // A storage lane held at one level by buffers or starved modules
+    bool Pinned(const SteadyLane& lane) {
+        return lane.high <= std::nextafter(lane.low, std::numeric_limits<float>::infinity());
+    }
+
+    // Extraction under THERMAL_SYNC changes its output every game tick
+    bool FollowsClock(const Colony* colony) {
+        for (const Sect* sect : colony->GetSects()) {
+            for (const Unit* unit : sect->GetUnits()) {
+                if (unit->HasClockDependentRates()) return true;
+            }
+        }
+        return false;
+    }
+
+    // Steps a lane can move at `rate` and stay in its range
+    int InRange(const SteadyLane& lane, double rate) {
+        double steps = std::numeric_limits<double>::infinity();
+        if (rate > 0.0) steps = std::ceil((lane.high - lane.value) / rate) - 1.0;
+        if (rate < 0.0) steps = std::floor((lane.value - lane.low) / -rate);
+        return static_cast<int>(std::clamp(steps, 0.0, static_cast<double>(ColonyLod::MAX_AGGREGATE_STEPS)));
+    }
+}
+
+void ColonyLod::Enable(const TimeManager* timeManager) {
+    if (!timeManager) {
+        for (ColonyTrack& track : tracks) {
+            Expand(track);
+        }
+        full.clear();
+        measuring.clear();
+    }
+    time = timeManager;
+}
+
+void ColonyLod::SetViewed(const std::vector<Colony*>& colonies) {
+    viewed.clear();
+    viewed.insert(colonies.begin(), colonies.end());
+}
+
+const std::vector<Colony*>& ColonyLod::BeginStep(const std::vector<Colony*>& colonies, float dt) {
+    stepSeconds = dt;
+    step++;
+    Sync(colonies);
+
+    full.clear();
+    measuring.clear();
+    for (ColonyTrack& track : tracks) {
+        if (viewed.count(track.colony) > 0) {
+            Expand(track);
+        } else if (track.detail == Detail::FULL) {
+            if (CanAggregate(track)) StartMeasuring(track);
+        } else if (track.sects.size() != track.colony->GetSects().size()) {
+            if (track.detail == Detail::AGGREGATED) Apply(track);
+            StartMeasuring(track);
+        }
+
+        if (track.detail == Detail::AGGREGATED) continue;
+        full.push_back(track.colony);
+
+        if (track.detail == Detail::MEASURING) {
+            for (SectTrack& sect : track.sects) {
+                sect.sect->ReadLanes(dt, sect.before, true);
+                measuring[sect.sect] = &sect;
+            }
+        }
+    }
+
+    // Counted after the expansions above, which cover the steps before this
+    stepAmbient = Sect::AmbientEnergyPerSecond(time->GetTimeOfDay()) * dt;
+    ambientTotal += stepAmbient;
+    return full;
+}
+
+void ColonyLod::RecordDepletion(const Sect* sect) {
+    auto it = measuring.find(sect);
+    if (it == measuring.end()) return;
+
+    const std::vector<ResourceManager::Depletion>& log = sect->GetPendingDepletion();
+    it->second->depletionLog.insert(it->second->depletionLog.end(), log.begin(), log.end());
+}
+
+void ColonyLod::AfterSects() {
+    const int half = MEASURE_STEPS / 2;
+    for (ColonyTrack& track : tracks) {
+        if (track.detail != Detail::MEASURING || track.restart) continue;
+
+        for (SectTrack& sect : track.sects) {
+            if (track.measured == 0) FindUnits(sect);
+            sect.sect->ReadLanes(stepSeconds, lanes, true);
+            if (lanes.size() != sect.before.size() || (track.measured > 0 && lanes.size() != sect.total.size())) {
+                track.restart = true;
+                break;
+            }
+            if (track.measured == 0) {
+                sect.total.assign(lanes.size(), 0.0);
+                sect.firstHalf.assign(lanes.size(), 0.0);
+                sect.peak.assign(RESOURCE_TYPE_COUNT, 0.0);
+            }
+
+            // The solar share is added back from the day curve
+            const bool ambient = sect.before[ENERGY_LANE].value < sect.sect->GetStorageCapacity(ResourceType::ENERGY);
+            for (size_t i = 0; i < lanes.size(); i++) {
+                double change = static_cast<double>(lanes[i].value) - sect.before[i].value;
+                if (i == ENERGY_LANE && ambient) change -= stepAmbient;
+                sect.total[i] += change;
+                if (track.measured < half) sect.firstHalf[i] += change;
+            }
+
+            for (size_t i = 0; i < static_cast<size_t>(RESOURCE_TYPE_COUNT); i++) {
+                double gain = static_cast<double>(lanes[i].value) - sect.before[i].value;
+                for (size_t unit : sect.units) {
+                    gain += static_cast<double>(lanes[unit + i].value) - sect.before[unit + i].value;
+                }
+                if (i == ENERGY_LANE && ambient) gain -= stepAmbient;
+                sect.peak[i] = std::max(sect.peak[i], gain);
+            }
+        }
+    }
+}
+
+void ColonyLod::EndStep() {
+    float bound = 0.0f;
+    for (ColonyTrack& track : tracks) {
+        stats.worstDriftBound = std::max(stats.worstDriftBound, Bound(track));
+        bound = std::max(bound, Bound(track) + Risk(track));
+        switch (track.detail) {
+            case Detail::FULL:
+                stats.fullColonySteps++;
+                // Drift carried from earlier stretches can still turn a pass
+                if (track.carried > 0.0f) FindRisk(track, 0);
+                break;
+
+            case Detail::MEASURING:
+                stats.fullColonySteps++;
+                if (track.carried > 0.0f) FindRisk(track, 0);
+                if (track.restart) {
+                    StartMeasuring(track);
+                } else if (++track.measured == MEASURE_STEPS) {
+                    FinishMeasuring(track);
+                }
+                break;
+
+            case Detail::AGGREGATED:
+                stats.aggregatedColonySteps++;
+                track.pending++;
+                if (step >= track.nextUpdate && !Apply(track)) {
+                    stats.refreshes++;
+                    StartMeasuring(track);
+                }
+                break;
+        }
+    }
+    stats.errorBound = bound;
+    stats.worstErrorBound = std::max(stats.worstErrorBound, bound);
+}
+
+void ColonyLod::Reconcile() {
+    for (ColonyTrack& track : tracks) {
+        if (track.detail == Detail::AGGREGATED && track.pending > 0 && !Apply(track)) {
+            stats.refreshes++;
+            StartMeasuring(track);
+        }
+    }
+}
+
+void ColonyLod::Clear() {
+    tracks.clear();
+    full.clear();
+    measuring.clear();
+}
+
+bool ColonyLod::IsAggregated(const Colony* colony) const {
+    for (const ColonyTrack& track : tracks) {
+        if (track.colony == colony) return track.detail == Detail::AGGREGATED;
+    }
+    return false;
+}
+
+// Tracks follow the colony list; a colony keeps its track when others
+// come, go or move
+void ColonyLod::Sync(const std::vector<Colony*>& colonies) {
+    bool same = tracks.size() == colonies.size();
+    for (size_t i = 0; same && i < colonies.size(); i++) {
+        same = tracks[i].colony == colonies[i];
+    }
+    if (same) return;
+
+    std::vector<ColonyTrack> previous = std::move(tracks);
+    std::unordered_map<const Colony*, size_t> at;
+    for (size_t i = 0; i < previous.size(); i++) {
+        at[previous[i].colony] = i;
+    }
+
+    tracks.clear();
+    for (Colony* colony : colonies) {
+        auto it = at.find(colony);
+        if (it != at.end()) {
+            tracks.push_back(std::move(previous[it->second]));
+        } else {
+            ColonyTrack track;
+            track.colony = colony;
+            tracks.push_back(std::move(track));
+        }
+    }
+}
+
+bool ColonyLod::CanAggregate(const ColonyTrack& track) const {
+    return track.carried < ERROR_BUDGET && !FollowsClock(track.colony);
+}
+
+float ColonyLod::Bound(const ColonyTrack& track) {
+    float bound = track.carried;
+    if (track.detail == Detail::AGGREGATED) bound += track.aggregated * track.errorPerStep;
+    return bound;
+}
+
+float ColonyLod::Risk(const ColonyTrack& track) const {
+    return step <= track.riskUntil ? track.risk : 0.0f;
+}
+
+void ColonyLod::EndStretch(ColonyTrack& track) {
+    if (track.detail != Detail::AGGREGATED) return;
+    track.carried += track.aggregated * track.errorPerStep;
+    track.aggregated = 0;
+}
+
+void ColonyLod::StartMeasuring(ColonyTrack& track) {
+    EndStretch(track);
+    track.detail = Detail::MEASURING;
+    track.measured = 0;
+    track.restart = false;
+    track.pending = 0;
+
+    const std::vector<Sect*>& sects = track.colony->GetSects();
+    track.sects.resize(sects.size());
+    for (size_t s = 0; s < sects.size(); s++) {
+        SectTrack& sect = track.sects[s];
+        sect.sect = sects[s];
+        sect.total.clear();
+        sect.firstHalf.clear();
+        sect.depletionLog.clear();
+    }
+}
+
+// Each unit's lanes open with its overflow buffer, one lane per resource
+// after the one naming them. Uses the lanes scratch.
+void ColonyLod::FindUnits(SectTrack& sect) {
+    sect.units.clear();
+    size_t at = RESOURCE_TYPE_COUNT;
+    for (const Unit* unit : sect.sect->GetUnits()) {
+        sect.units.push_back(at + 1);
+        lanes.clear();
+        unit->ReadLanes(stepSeconds, lanes, true);
+        at += lanes.size();
+    }
+}
+
+void ColonyLod::FinishMeasuring(ColonyTrack& track) {
+    const int half = MEASURE_STEPS / 2;
+    const size_t resources = static_cast<size_t>(RESOURCE_TYPE_COUNT);
+    float errorPerStep = 0.0f;
+    int inRange = MAX_AGGREGATE_STEPS;
+
+    for (SectTrack& sect : track.sects) {
+        // Lanes as the window leaves them, after the colony passes
+        sect.sect->ReadLanes(stepSeconds, lanes, true);
+        if (lanes.size() != sect.total.size()) {
+            StartMeasuring(track);
+            return;
+        }
+        sect.range.assign(lanes.begin(), lanes.begin() + resources);
+
+        sect.rate.resize(sect.total.size());
+        for (size_t i = 0; i < sect.total.size(); i++) {
+            sect.rate[i] = static_cast<float>(sect.total[i] / MEASURE_STEPS);
+        }
+
+        sect.saturated.assign(resources, false);
+        sect.buffering.assign(sect.total.size(), false);
+        for (size_t i = 0; i < resources; i++) {
+            double total = sect.total[i];
+            double firstHalf = sect.firstHalf[i];
+            for (size_t unit : sect.units) {
+                total += sect.total[unit + i];
+                firstHalf += sect.firstHalf[unit + i];
+                sect.rate[unit + i] = 0.0f;
+                sect.buffering[unit + i] = sect.total[unit + i] != 0.0 || lanes[unit + i].value > 0.0f;
+            }
+            sect.rate[i] = static_cast<float>(total / MEASURE_STEPS);
+
+            ResourceType type = static_cast<ResourceType>(i);
+            float capacity = sect.sect->GetStorageCapacity(type);
+            if (capacity <= 0.0f) continue;
+            sect.saturated[i] = sect.sect->GetResourceStorage(type) >= capacity;
+            if (sect.saturated[i]) continue;
+
+            double early = firstHalf / half;
+            double late = (total - firstHalf) / (MEASURE_STEPS - half);
+            errorPerStep = std::max(errorPerStep, static_cast<float>(std::fabs(early - late) / capacity));
+        }
+
+        inRange = std::min(inRange, StepsInRange(sect, lanes));
+
+        MergeDepletion(sect.depletionLog);
+        sect.depletion = sect.depletionLog;
+        for (ResourceManager::Depletion& entry : sect.depletion) {
+            entry.amount /= MEASURE_STEPS;
+        }
+        sect.depletionLog.clear();
+    }
+
+    stats.measurements++;
+    if (FollowsClock(track.colony)) {
+        track.detail = Detail::FULL;
+        return;
+    }
+    // Too unsteady to aggregate for even one interval, or a lane already
+    // on the edge of its range
+    if (track.carried + errorPerStep * INTERVAL_STEPS > ERROR_BUDGET || inRange == 0) {
+        StartMeasuring(track);
+        return;
+    }
+
+    // Updates are staggered so aggregated colonies do not all land on one step
+    const int index = static_cast<int>(&track - tracks.data());
+    track.detail = Detail::AGGREGATED;
+    track.pending = 0;
+    track.aggregated = 0;
+    track.errorPerStep = errorPerStep;
+    track.inRange = inRange;
+    track.ambientAt = ambientTotal;
+    track.nextUpdate = step + std::min(1 + index % INTERVAL_STEPS, NextEvent(track));
+    FindRisk(track, track.nextUpdate - step);
+}
+
+int ColonyLod::StepsInRange(const SectTrack& sect, const std::vector<SteadyLane>& lanes) const {
+    int steps = MAX_AGGREGATE_STEPS;
+    for (size_t i = 0; i < lanes.size(); i++) {
+        double rate = sect.rate[i];
+        SteadyLane lane = lanes[i];
+        // Storage keeps the range it was measured in; one held at capacity
+        // or pinned is not moving
+        if (i < static_cast<size_t>(RESOURCE_TYPE_COUNT)) {
+            if (sect.saturated[i] || Pinned(sect.range[i])) continue;
+            lane.low = sect.range[i].low;
+            lane.high = sect.range[i].high;
+            if (i == ENERGY_LANE) rate += stepAmbient;
+        }
+        if (rate != 0.0) steps = std::min(steps, InRange(lane, rate));
+    }
+    return steps;
+}
+
+bool ColonyLod::Apply(ColonyTrack& track) {
+    const int steps = track.pending;
+    track.pending = 0;
+    if (steps == 0) {
+        track.nextUpdate = step + NextEvent(track);
+        return true;
+    }
+
+    const double ambient = ambientTotal - track.ambientAt;
+    track.ambientAt = ambientTotal;
+    track.inRange = MAX_AGGREGATE_STEPS;
+    bool holds = true;
+
+    for (SectTrack& sect : track.sects) {
+        sect.sect->ReadLanes(stepSeconds, lanes, true);
+        if (lanes.size() != sect.rate.size()) {
+            holds = false;
+            continue;
+        }
+
+        // Storage and buffers move as one pool; storage fills first, as
+        // the buffers flush into it
+        const ResourceVector& capacity = sect.sect->GetStorageCapacity();
+        for (size_t i = 0; i < static_cast<size_t>(RESOURCE_TYPE_COUNT); i++) {
+            ResourceType type = static_cast<ResourceType>(i);
+            const double rate = sect.rate[i];
+            double pool = lanes[i].value + rate * steps;
+            for (size_t unit : sect.units) {
+                pool += lanes[unit + i].value;
+            }
+            if (i == ENERGY_LANE) pool += ambient;
+            if (sect.saturated[i] && capacity.Has(type)) {
+                pool += std::clamp(capacity.Get(type) - pool, 0.0, sect.peak[i] * steps);
+            }
+
+            // Consumers of a resource that runs dry lose efficiency
+            if (pool <= 0.0 && rate < 0.0) holds = false;
+            pool = std::max(0.0, pool);
+
+            double stored = pool;
+            if (capacity.Has(type)) {
+                stored = std::min(pool, static_cast<double>(capacity.Get(type)));
+                if (sect.saturated[i] && stored < capacity.Get(type)) holds = false;
+            }
+            lanes[i].value = static_cast<float>(stored);
+
+            // Only the units making it buffer it
+            double rest = pool - stored;
+            for (size_t unit : sect.units) {
+                if (!sect.buffering[unit + i]) continue;
+                double buffered = std::min(rest, static_cast<double>(Unit::OVERFLOW_BUFFER_CAP));
+                lanes[unit + i].value = static_cast<float>(buffered);
+                rest -= buffered;
+            }
+        }
+
+        for (size_t i = RESOURCE_TYPE_COUNT; i < lanes.size(); i++) {
+            const double rate = sect.rate[i];
+            if (rate == 0.0) continue;
+
+            // A timer running out or a level crossing a rule's line needs
+            // the real update
+            double value = lanes[i].value + rate * steps;
+            SteadyLane range = lanes[i];
+            if (value < range.low || value >= range.high) {
+                float top = std::nextafter(range.high, -std::numeric_limits<float>::infinity());
+                value = std::min(std::max(value, static_cast<double>(range.low)), static_cast<double>(top));
+                holds = false;
+            }
+            lanes[i].value = static_cast<float>(value);
+        }
+        sect.sect->WriteLanes(lanes);
+        track.inRange = std::min(track.inRange, StepsInRange(sect, lanes));
+
+        if (!sect.depletion.empty()) {
+            depletion = sect.depletion;
+            for (ResourceManager::Depletion& entry : depletion) {
+                entry.amount *= steps;
+            }
+            sect.sect->CommitDepletion(depletion);
+        }
+    }
+
+    // Transfers and transport once for the whole interval; packets move
+    // step by step, so they arrive on the step they would
+    track.colony->ManageResources();
+    track.colony->CoastTransportJobs(stepSeconds, steps - 1);
+    track.colony->ProcessTransportJobs(stepSeconds);
+    track.nextUpdate = step + NextEvent(track);
+
+    track.aggregated += steps;
+    FindRisk(track, track.nextUpdate - step);
+    // Past a line where modules starve, production is clamped or ambient
+    // energy no longer fits, the rates change; the step that would cross
+    // one runs in full. Stops short of an interval that would take the
+    // bound past the budget.
+    const float next = track.carried + (track.aggregated + INTERVAL_STEPS) * track.errorPerStep;
+    return holds && track.inRange > 0 && !FollowsClock(track.colony) && next <= ERROR_BUDGET &&
+           track.aggregated < MAX_AGGREGATE_STEPS;
+}
+
+// Found from the storage as it is now and the measured rates. A storage
+// at capacity is refilled, not moving, and is left out.
+int ColonyLod::NextEvent(const ColonyTrack& track) {
+    int next = std::max(1, std::min(INTERVAL_STEPS, track.inRange));
+    const Colony* colony = track.colony;
+    const ResourceVector& reserves = colony->GetStrategicReserves();
+
+    // A transfer that would run on the next pass: a packet landed after
+    // this one
+    for (const SectTrack& sect : track.sects) {
+        if (sect.rate.size() < static_cast<size_t>(RESOURCE_TYPE_COUNT)) continue;
+        for (size_t i = 0; i < static_cast<size_t>(RESOURCE_TYPE_COUNT); i++) {
+            ResourceType type = static_cast<ResourceType>(i);
+            double capacity = sect.sect->GetStorageCapacity(type);
+            if (capacity <= 0.0 || !sect.sect->GetResourceStorage().Has(type)) continue;
+            double value = sect.sect->GetResourceStorage(type);
+            if (sect.sect->IsSurplus(type) && colony->CanAcceptResource(type, static_cast<float>(value - capacity * 0.5))) {
+                return 1;
+            }
+            if (sect.sect->IsDeficit(type) && reserves.Has(type) && reserves.Get(type) > 0.0f) return 1;
+        }
+    }
+
+    FindLines(track, 0.0);
+    for (const Line& line : lines) {
+        double steps = line.rate != 0.0 ? (line.line - line.value) / line.rate : -1.0;
+        if (steps > 0.0) next = std::min(next, std::max(1, static_cast<int>(std::ceil(steps))));
+    }
+
+    // The rate limit running out, on the clock as it will read
+    const double now = colony->Now();
+    for (const Road& road : colony->GetRoads()) {
+        if (!road.sectA || !road.sectB || road.mode == TransportMode::MANUAL) continue;
+        if (road.activePacketCount < MAX_PACKETS_PER_ROAD && !road.CanAcceptNewJob(static_cast<float>(now))) {
+            double at = now;
+            for (int k = 1; k < next; k++) {
+                at += stepSeconds;
+                if (road.CanAcceptNewJob(static_cast<float>(at))) {
+                    next = k;
+                    break;
+                }
+            }
+        }
+    }
+
+    // Packets arriving, with progress added as TransportJob::Update adds it
+    for (const TransportJob& job : colony->GetTransportJobs()) {
+        if (job.status != TransportStatus::IN_TRANSIT || !job.road) continue;
+        float travelTime = job.road->GetTravelTime();
+        if (travelTime <= 0.0f) continue;
+        float progress = job.progress;
+        for (int k = 1; k < next; k++) {
+            progress += stepSeconds / travelTime;
+            if (progress >= 1.0f) {
+                next = k;
+                break;
+            }
+        }
+    }
+    return next;
+}
+
+// Sect surplus and deficit lines, the level at which a blocked surplus
+// would fit into the reserves, and the fill ratio gap on a balancing road
+// passing the balance threshold. Levels move only in an aggregated colony.
+void ColonyLod::FindLines(const ColonyTrack& track, double bound) {
+    lines.clear();
+    const bool moving = track.detail == Detail::AGGREGATED;
+    auto trackOf = [&track](const Sect* sect) -> const SectTrack* {
+        for (const SectTrack& candidate : track.sects) {
+            if (candidate.sect == sect && candidate.rate.size() >= static_cast<size_t>(RESOURCE_TYPE_COUNT)) {
+                return &candidate;
+            }
+        }
+        return nullptr;
+    };
+    // Storage held at capacity keeps its fill
+    auto rateOf = [this, moving](const SectTrack* sect, size_t lane) {
+        if (!moving || !sect || sect->saturated[lane]) return 0.0;
+        double rate = sect->rate[lane];
+        if (lane == ENERGY_LANE) rate += stepAmbient;
+        return rate;
+    };
+
+    const Colony* colony = track.colony;
+    const ResourceVector& reserves = colony->GetStrategicReserves();
+    const ResourceVector& reserveCapacity = colony->GetReserveCapacity();
+    const double packet = TRANSPORT_PACKET_SIZE;
+    for (const Sect* sect : colony->GetSects()) {
+        const SectTrack* measured = trackOf(sect);
+        for (size_t i = 0; i < static_cast<size_t>(RESOURCE_TYPE_COUNT); i++) {
+            ResourceType type = static_cast<ResourceType>(i);
+            double capacity = sect->GetStorageCapacity(type);
+            if (capacity <= 0.0 || !sect->GetResourceStorage().Has(type)) continue;
+            if (moving && measured && measured->saturated[i]) continue;
+            double value = sect->GetResourceStorage(type) / capacity;
+            double rate = rateOf(measured, i) / capacity;
+
+            double deficit = Balance().storageDeficitThreshold;
+            double surplus = Balance().storageSurplusThreshold;
+            lines.push_back({value, rate, deficit, std::max(Balance().deficitRequestAmount - deficit, packet / capacity), bound});
+            lines.push_back({value, rate, surplus, surplus - 0.5, bound});
+            if (reserveCapacity.Has(type)) {
+                double fit = 0.5 + (reserveCapacity.Get(type) - reserves.Get(type)) / capacity;
+                lines.push_back({value, rate, fit, fit - 0.5, bound});
+            }
+        }
+    }
+
+    for (const Road& road : colony->GetRoads()) {
+        if (!road.sectA || !road.sectB || road.mode != TransportMode::AUTO_BALANCE) continue;
+        const SectTrack* a = trackOf(road.sectA);
+        const SectTrack* b = trackOf(road.sectB);
+        for (ResourceType type : SINGULAR_RESOURCE_TYPES) {
+            const size_t lane = static_cast<size_t>(type);
+            double capacityA = road.sectA->GetStorageCapacity(type);
+            double capacityB = road.sectB->GetStorageCapacity(type);
+            if (capacityA <= 0.0 || capacityB <= 0.0) continue;
+            double gap = road.sectA->GetResourceStorage(type) / capacityA -
+                         road.sectB->GetResourceStorage(type) / capacityB;
+            double rate = rateOf(a, lane) / capacityA - rateOf(b, lane) / capacityB;
+            double move = packet / std::min(capacityA, capacityB);
+            lines.push_back({gap, rate, Balance().autoBalanceThreshold, move, 2.0 * bound});
+            lines.push_back({gap, rate, -Balance().autoBalanceThreshold, move, 2.0 * bound});
+        }
+    }
+}
+
+void ColonyLod::FindRisk(ColonyTrack& track, int steps) {
+    if (step > track.riskUntil) track.risk = 0.0f;
+    const float bound = Bound(track);
+    if (bound <= 0.0f) return;
+
+    FindLines(track, bound);
+    for (const Line& line : lines) {
+        if (!std::isfinite(line.line)) continue;
+        double first = 0.0;
+        double last = steps;
+        if (line.rate != 0.0) {
+            double enter = (line.line - line.band - line.value) / line.rate;
+            double leave = (line.line + line.band - line.value) / line.rate;
+            first = std::max(first, std::ceil(std::min(enter, leave)));
+            last = std::min(last, std::floor(std::max(enter, leave)));
+        } else if (std::fabs(line.value - line.line) > line.band) {
+            continue;
+        }
+        if (first > last) continue;
+        // The level it acts on may itself be off by the band
+        track.risk = std::max(track.risk, static_cast<float>(line.move + line.band));
+        track.riskUntil = std::max(track.riskUntil, step + static_cast<int>(last));
+    }
+    stats.worstErrorBound = std::max(stats.worstErrorBound, bound + Risk(track));
+}
+
+void ColonyLod::Expand(ColonyTrack& track) {
+    if (track.detail == Detail::AGGREGATED) {
+        Apply(track);
+        stats.expansions++;
+        EndStretch(track);
+    }
+    track.detail = Detail::FULL;
+}
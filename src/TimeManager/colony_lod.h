@@ -0,0 +1,208 @@
+#ifndef COLONY_LOD_H
+#define COLONY_LOD_H
+
+#include "resource_manager.h"
+#include "unit.h"
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+class Colony;
+class Sect;
+class TimeManager;
+
+// Level of detail for colonies the player is not looking at.
+//
+// A viewed colony steps in full. One that leaves the view first keeps
+// stepping in full for MEASURE_STEPS steps while each of its sects' lanes
+// (Sect::ReadLanes: storage, unit timers and wear, road building) and its
+// planet depletion are measured across the sect update - what modules,
+// units and the sect do on their own, transfers and transport left out.
+// Units' overflow buffers flush into storage, so each resource's storage
+// and buffers are measured as one pool. From then on the colony is
+// aggregated: every INTERVAL_STEPS steps each lane moves by its measured
+// rate times the steps since, with the solar energy added from the day
+// curve and each pool filling storage up to capacity and the buffers
+// with the rest, and then the colony's transfers and transport run once
+// over the whole interval. Its sects, units and modules are not stepped
+// between updates.
+//
+// Tick cost still follows every colony, not only the viewed ones: an
+// aggregated colony costs its updates and colony passes, and is measured
+// in full again whenever a stretch ends, so a colony out of view costs
+// about a fifth of one stepped in full and only some two thirds of the
+// colony steps are aggregated. A step of the whole world comes to 60 to
+// 90 percent of stepping it in full.
+//
+// Transfers and dispatches move whole packets, so one run a few steps late
+// puts a sect a packet out. An update therefore comes sooner when the
+// colony passes would next act: a storage crossing a transfer line or the
+// balance threshold at its rate, a road's rate limit running out, a packet
+// arriving. Those run on the step they would in full. A lane about to
+// leave the range its rate was measured in - modules starving, production
+// clamped, ambient energy no longer fitting, a unit timer running out -
+// ends the stretch a step short, and the colony is measured again.
+//
+// Storage held at capacity hides what its producers could make: while it
+// is drained by transport it is refilled, as fast as the quickest gain
+// seen in the window, and when that falls behind the colony is measured
+// again.
+//
+// The error is estimated and bounded, as a fraction of capacity. Each
+// lane's window is measured in two halves; the gap between their rates,
+// per step, is how far the aggregate may drift from stepping each step, so
+// an aggregated stretch adds its length times the largest gap to the
+// colony's drift bound (storage held at capacity is left out, its gap being
+// refills). The drift is carried: it stays when the colony is measured
+// again or steps in full, and the colony is not aggregated again once it
+// has used ERROR_BUDGET. A stretch ends before the drift bound would pass
+// the budget, after MAX_AGGREGATE_STEPS, or when units or sects come or go.
+// A colony with a unit following the clock steps in full.
+//
+// A drifted level near a colony pass's line may be acted on a step sooner
+// or later than in full, which puts the sect out by what the pass moves -
+// a transfer or a packet, far more than the drift. While a level is within
+// the drift bound of a line the colony's bound carries that risk, so the
+// bound holds but can pass the budget for a few steps.
+//
+// A colony coming back into view is expanded: the steps since its last
+// aggregate update are applied, so its storage is reconciled, and it steps
+// in full from the next step.
+class ColonyLod {
+public:
+    static constexpr int MEASURE_STEPS = 60;            // two game ticks
+    static constexpr int INTERVAL_STEPS = 10;
+    static constexpr int MAX_AGGREGATE_STEPS = 1800;    // three game days
+    static constexpr float ERROR_BUDGET = 0.02f;        // of capacity, per colony
+
+    struct Stats {
+        long long fullColonySteps = 0;          // colony steps run in full, measuring included
+        long long aggregatedColonySteps = 0;
+        int measurements = 0;                   // measuring windows completed
+        int refreshes = 0;                      // aggregated stretches ended to measure again
+        int expansions = 0;                     // colonies brought back into view
+        float errorBound = 0.0f;                // largest bound of any colony now, risk included
+        float worstErrorBound = 0.0f;           // largest bound any colony reached, risk included
+        float worstDriftBound = 0.0f;           // largest drift bound any colony reached
+    };
+
+    // `time` gives the solar curve; nullptr expands every colony and
+    // turns level of detail off
+    void Enable(const TimeManager* time);
+    bool IsEnabled() const { return time != nullptr; }
+
+    // Colonies to step in full; the rest are aggregated
+    void SetViewed(const std::vector<Colony*>& viewed);
+
+    // SimStepper::Step, in order: BeginStep returns the colonies to step
+    // in full, RecordDepletion sees each of their sects' depletion log
+    // before it is committed, AfterSects runs between the sect updates and
+    // the colony passes, EndStep after the colony passes
+    const std::vector<Colony*>& BeginStep(const std::vector<Colony*>& colonies, float dt);
+    void RecordDepletion(const Sect* sect);
+    void AfterSects();
+    void EndStep();
+
+    // Applies what aggregated colonies have pending, so their storage is
+    // current (before a save); they stay aggregated
+    void Reconcile();
+
+    // Forgets every colony; for when they are about to go away
+    void Clear();
+
+    bool IsAggregated(const Colony* colony) const;
+    const Stats& GetStats() const { return stats; }
+
+private:
+    enum class Detail { FULL, MEASURING, AGGREGATED };
+
+    struct SectTrack {
+        Sect* sect = nullptr;
+        std::vector<SteadyLane> before;                 // lanes ahead of the sect update
+        std::vector<double> total;                      // change over the window, per lane
+        std::vector<double> firstHalf;
+        std::vector<ResourceManager::Depletion> depletionLog;
+
+        std::vector<size_t> units;                      // where each unit's buffer lanes start
+        std::vector<double> peak;                       // largest pool gain in a step, per resource
+
+        std::vector<float> rate;                        // per step; buffers pooled with storage
+        std::vector<bool> saturated;                    // storage ended at capacity, per resource
+        std::vector<SteadyLane> range;                  // storage lanes as measured
+        std::vector<bool> buffering;                    // unit buffer lanes that fill or hold stock
+        std::vector<ResourceManager::Depletion> depletion;     // per step
+    };
+
+    struct ColonyTrack {
+        Colony* colony = nullptr;
+        Detail detail = Detail::FULL;
+        std::vector<SectTrack> sects;
+        int measured = 0;                               // steps into the window
+        bool restart = false;                           // lanes changed shape mid-window
+        int pending = 0;                                // steps since the last aggregate update
+        int nextUpdate = 0;
+        int aggregated = 0;                             // steps since measured
+        float errorPerStep = 0.0f;                      // largest half-window rate gap / capacity
+        float carried = 0.0f;                           // bound of the stretches before this one
+        int inRange = 0;                                // steps before a lane leaves its range
+        float risk = 0.0f;                              // a colony pass acting a step off, / capacity
+        int riskUntil = -1;                             // last step the risk covers
+        double ambientAt = 0.0;                         // ambientTotal at the last update
+    };
+
+    void Sync(const std::vector<Colony*>& colonies);
+    // False once the colony's bound has used the budget, or while a unit
+    // follows the clock
+    bool CanAggregate(const ColonyTrack& track) const;
+    // How far the colony's storage may have drifted, as a fraction of
+    // capacity; Risk adds what a colony pass acting a step off would move
+    static float Bound(const ColonyTrack& track);
+    float Risk(const ColonyTrack& track) const;
+    // Carries an aggregated stretch's bound over to the colony
+    static void EndStretch(ColonyTrack& track);
+    void StartMeasuring(ColonyTrack& track);
+    void FindUnits(SectTrack& sect);
+    void FinishMeasuring(ColonyTrack& track);
+    // Steps before a lane of the sect, at its rate, leaves the range its
+    // rate was measured in
+    int StepsInRange(const SectTrack& sect, const std::vector<SteadyLane>& lanes) const;
+    // Moves an aggregated colony on by its pending steps; false when its
+    // rates no longer hold
+    bool Apply(ColonyTrack& track);
+    // Steps until the colony passes would next act differently, at most
+    // INTERVAL_STEPS
+    int NextEvent(const ColonyTrack& track);
+
+    // A level a colony pass acts at, in fractions of capacity: `value`
+    // moving by `rate` per step meets `line`, and the pass then moves
+    // `move`. `band` is how far off the level may be.
+    struct Line {
+        double value;
+        double rate;
+        double line;
+        double move;
+        double band;
+    };
+    void FindLines(const ColonyTrack& track, double bound);
+    // Sets the risk if, within `steps`, a level comes within its band of a
+    // line, where the pass could act a step sooner or later than in full
+    void FindRisk(ColonyTrack& track, int steps);
+    void Expand(ColonyTrack& track);
+
+    const TimeManager* time = nullptr;
+    float stepSeconds = 0.0f;
+    int step = 0;
+    double ambientTotal = 0.0;                          // solar energy a sect gains, summed over steps
+    double stepAmbient = 0.0;                           // this step's share of it
+
+    std::vector<ColonyTrack> tracks;                    // in colony order
+    std::unordered_set<const Colony*> viewed;
+    std::vector<Colony*> full;                          // stepped in full this step
+    std::unordered_map<const Sect*, SectTrack*> measuring;
+    std::vector<SteadyLane> lanes;                      // scratch
+    std::vector<Line> lines;                            // scratch
+    std::vector<ResourceManager::Depletion> depletion;
+    Stats stats;
+};
+
+#endif // COLONY_LOD_H
@@ -0,0 +1,771 @@
+#include "fast_forward.h"
+#include "balance_params.h"
+#include "colony.h"
+#include "game_snapshot.h"
+#include "sect.h"
+#include "sim_stepper.h"
+#include "time_manager.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+
+namespace {
+
+// Two real updates agree when every lane moved by the same amount, up to
+// the rounding of a float near the lane's value
+constexpr float RATE_TOLERANCE = 2e-6f;
+
+// Colony thresholds are met one step early and from both sides of this
+// band, so float rounding at the line cannot hide a crossing
+constexpr double THRESHOLD_BAND = 1e-5;
+
+constexpr double INF = std::numeric_limits<double>::infinity();
+
+void SetError(std::string* error, const std::string& message) {
+    if (error) *error = message;
+}
+
+// Lane `except`, when not -1, is left out of the comparison
+bool SameChange(const std::vector<float>& a, const std::vector<float>& b,
+                const std::vector<SteadyLane>& lanes, int except = -1) {
+    if (a.size() != b.size() || a.size() != lanes.size()) return false;
+    for (size_t i = 0; i < a.size(); i++) {
+        if (static_cast<int>(i) == except) continue;
+        if (std::fabs(a[i] - b[i]) > RATE_TOLERANCE * (1.0f + std::fabs(lanes[i].value))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// A change only holds as a rate when the step began and ended in the
+// same range on every lane; one that was clamped at a limit does not
+bool SameRanges(const std::vector<SteadyLane>& a, const std::vector<SteadyLane>& b, int except = -1) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); i++) {
+        if (static_cast<int>(i) == except) continue;
+        if (a[i].low != b[i].low || a[i].high != b[i].high) return false;
+    }
+    return true;
+}
+
+// Energy the units left before the step's ambient energy went in, when
+// that can be what every step leaves: no unit follows the clock and the
+// modules got all they asked for. -1 otherwise.
+float DrawnEnergy(const Sect& sect, float stepSeconds) {
+    if (!sect.GetStorageCapacity().Has(ResourceType::ENERGY)) return -1.0f;
+    ResourceVector demand;
+    ResourceVector supply;
+    for (const Unit* unit : sect.GetUnits()) {
+        if (unit->HasClockDependentRates()) return -1.0f;
+        unit->AddRunningRates(demand, supply);
+    }
+    float drawn = sect.GetEnergyBeforeAmbient();
+    return drawn >= demand.Get(ResourceType::ENERGY) * stepSeconds ? drawn : -1.0f;
+}
+
+// Moves on whenever anything ReadLanes looks at may have changed
+uint64_t StateSignature(const Sect& sect) {
+    uint64_t signature = sect.GetStateRevision() + (static_cast<uint64_t>(sect.GetUnits().size()) << 32);
+    for (const Unit* unit : sect.GetUnits()) {
+        signature += unit->GetStateRevision();
+    }
+    return signature;
+}
+
+bool SameDepletion(const std::vector<ResourceManager::Depletion>& a,
+                   const std::vector<ResourceManager::Depletion>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); i++) {
+        if (a[i].gridX != b[i].gridX || a[i].gridY != b[i].gridY || a[i].type != b[i].type ||
+            std::fabs(a[i].amount - b[i].amount) > RATE_TOLERANCE * std::fabs(a[i].amount)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// A float moves by the same amount each step only while its exponent
+// holds: the rounding of every add follows the spacing of the floats
+// around it. So a lane's range ends where its binade does, short of it by
+// as far as a step takes the lane before it settles; a lane that close to
+// the edge holds only while it stays put.
+void KeepBinades(std::vector<SteadyLane>& lanes) {
+    for (SteadyLane& lane : lanes) {
+        float magnitude = std::fabs(lane.value);
+        if (!std::isfinite(magnitude)) continue;
+        if (magnitude < 1.0f) {
+            lane.low = std::max(lane.low, -1.0f);
+            lane.high = std::min(lane.high, 1.0f);
+            continue;
+        }
+        int exponent;
+        std::frexp(magnitude, &exponent);
+        float bottom = std::ldexp(0.5f, exponent);
+        float top = std::ldexp(1.0f, exponent);
+        if (lane.value > 0.0f) {
+            lane.low = std::max(lane.low, bottom + lane.reach);
+            lane.high = std::min(lane.high, top - lane.reach);
+        }
+        else {
+            lane.low = std::max(lane.low, std::nextafter(-top, 0.0f) + lane.reach);
+            lane.high = std::min(lane.high, std::nextafter(-bottom, 0.0f) - lane.reach);
+        }
+        if (lane.value < lane.low || lane.value >= lane.high) {
+            lane.low = lane.value;
+            lane.high = std::nextafter(lane.value, std::numeric_limits<float>::infinity());
+        }
+    }
+}
+
+// Whether the road's mode would send something as storage stands, judged
+// as Colony::ProcessAutoBalance and ProcessDeficitTriggered judge it
+bool WantsTransfer(const Road& road) {
+    for (ResourceType type : SINGULAR_RESOURCE_TYPES) {
+        if (road.mode == TransportMode::AUTO_BALANCE) {
+            float capacityA = road.sectA->GetStorageCapacity(type);
+            float capacityB = road.sectB->GetStorageCapacity(type);
+            if (capacityA <= 0.0f || capacityB <= 0.0f) continue;
+            float difference = road.sectA->GetResourceStorage(type) / capacityA -
+                               road.sectB->GetResourceStorage(type) / capacityB;
+            if (std::abs(difference) > Balance().autoBalanceThreshold) return true;
+        }
+        else if (road.mode == TransportMode::DEFICIT_TRIGGERED) {
+            if ((road.sectA->IsDeficit(type) && road.sectB->IsSurplus(type)) ||
+                (road.sectB->IsDeficit(type) && road.sectA->IsSurplus(type))) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Steps, up to maxSteps, a line value + n * slope stays in [low, high)
+double StepsInRange(double value, double slope, double low, double high, double maxSteps) {
+    double n = maxSteps;
+    if (slope > 0.0 && high < INF) {
+        n = std::min(n, std::ceil((high - value) / slope) - 1.0);
+    }
+    else if (slope < 0.0 && low > -INF) {
+        n = std::min(n, std::floor((value - low) / -slope));
+    }
+    return std::max(0.0, n);
+}
+
+}
+
+FastForward::FastForward(SimStepper& stepper, float stepSeconds)
+    : stepper(stepper), stepSeconds(stepSeconds) {}
+
+FastForward::Report FastForward::Advance(const std::vector<Colony*>& colonies, ResourceManager& resources,
+                                         TimeManager& time, int steps) {
+    auto begin = std::chrono::steady_clock::now();
+    report = Report();
+    report.steps = std::max(0, steps);
+    stepCount = report.steps;
+    this->resources = &resources;
+
+    Build(colonies);
+    PrepareClock(time, stepCount);
+
+    for (int step = 0; step < stepCount; step++) {
+        time.Advance(stepSeconds);
+
+        bool clockSet = false;
+        for (ColonyTrack& colony : colonyTracks) {
+            if (colony.activeAt > step) continue;
+            if (!clockSet) {
+                stepper.SetClockTime(clockAt[step]);
+                clockSet = true;
+            }
+            RunColony(colony, step);
+            colony.activeAt = NextActiveStep(colony, step);
+            report.coastedColonySteps += std::min(colony.activeAt, stepCount) - step - 1;
+        }
+    }
+
+    // Land every coasting sect and packet on the last step
+    for (ColonyTrack& colony : colonyTracks) {
+        for (int i = 0; i < colony.sectCount; i++) {
+            Coast(sects[colony.firstSect + i], stepCount - 1);
+        }
+        colony.colony->CoastTransportJobs(stepSeconds, stepCount - 1 - colony.jobsSynced);
+    }
+    if (stepCount > 0) stepper.SetClockTime(clockAt[stepCount - 1]);
+
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    return report;
+}
+
+void FastForward::Build(const std::vector<Colony*>& colonies) {
+    size_t total = 0;
+    for (const Colony* colony : colonies) {
+        if (colony) total += colony->GetSects().size();
+    }
+
+    sects.clear();
+    sects.resize(total);
+    colonyTracks.clear();
+    trackOf.clear();
+
+    int next = 0;
+    for (Colony* colony : colonies) {
+        if (!colony) continue;
+        ColonyTrack track;
+        track.colony = colony;
+        track.firstSect = next;
+        for (Sect* sect : colony->GetSects()) {
+            if (!sect) continue;
+            sects[next].sect = sect;
+            sects[next].single.assign(1, sect);
+            trackOf[sect] = next;
+            next++;
+        }
+        track.sectCount = next - track.firstSect;
+        colonyTracks.push_back(track);
+    }
+    sects.resize(next);
+}
+
+void FastForward::PrepareClock(const TimeManager& time, int steps) {
+    TimeManager ahead = time;
+    std::vector<int> ticks(steps);
+    clockAt.resize(steps);
+    tickEnd.resize(steps);
+    ambientBefore.assign(steps + 1, 0.0);
+    ambientStep.resize(steps);
+    gridAmbient.clear();
+
+    double now = stepper.GetClockTime();
+    for (int i = 0; i < steps; i++) {
+        ahead.Advance(stepSeconds);
+        now += stepSeconds;
+        clockAt[i] = now;
+        ticks[i] = ahead.GetTicks();
+        float ambient = Sect::AmbientEnergyPerSecond(ahead.GetTimeOfDay()) * stepSeconds;
+        ambientStep[i] = ambient;
+        ambientBefore[i + 1] = ambientBefore[i] + ambient;
+    }
+    for (int i = steps - 1; i >= 0; i--) {
+        tickEnd[i] = (i + 1 < steps && ticks[i + 1] == ticks[i]) ? tickEnd[i + 1] : i;
+    }
+}
+
+void FastForward::RunColony(ColonyTrack& colony, int step) {
+    for (int i = 0; i < colony.sectCount; i++) {
+        SectTrack& track = sects[colony.firstSect + i];
+        if (track.hasRates && track.through >= step) {
+            CoastStorage(track, step);
+        }
+        else {
+            Coast(track, step - 1);
+            StepSect(track, step);
+        }
+    }
+
+    colony.colony->CoastTransportJobs(stepSeconds, step - 1 - colony.jobsSynced);
+    colony.colony->ManageResources();
+    colony.colony->ProcessTransportJobs(stepSeconds);
+    colony.jobsSynced = step;
+    report.colonySteps++;
+
+    for (int i = 0; i < colony.sectCount; i++) {
+        Revalidate(sects[colony.firstSect + i], step);
+    }
+}
+
+void FastForward::StepSect(SectTrack& track, int step) {
+    Sect* sect = track.sect;
+
+    // Left alone since it last stepped, the sect reads as it did then
+    bool ambientBeforeStep = track.readAmbient;
+    if (track.read.empty() || StateSignature(*sect) != track.readSignature) {
+        ambientBeforeStep = sect->ReadLanes(stepSeconds, before);
+        KeepBinades(before);
+    }
+    else {
+        before.swap(track.read);
+    }
+
+    if (stepper.IsBatchingModules()) {
+        track.modules.Update(track.single, stepSeconds);
+    }
+    depletion.clear();
+    bool updated = sect->NeedsUpdate();
+    if (updated) {
+        sect->UpdateLocal(stepSeconds);
+        depletion = sect->GetPendingDepletion();
+        sect->CommitDepletion();
+    }
+
+    bool ambientAfterStep = sect->ReadLanes(stepSeconds, after);
+    track.synced = step;
+    track.unitsSynced = step;
+    report.sectSteps++;
+
+    KeepBinades(after);
+    track.read = after;
+    track.readAmbient = ambientAfterStep;
+    track.readSignature = StateSignature(*sect);
+
+    // A sect whose energy is topped back up within the step, by a flush
+    // or by beginning it full, leaves the same energy before ambient
+    // whatever it began with. Its energy lane then follows the day curve
+    // from there, proven by two measures that began apart, or held while
+    // it begins full. Its other lanes still need their ranges and rates.
+    int energy = static_cast<int>(ResourceType::ENERGY);
+    float begun = before[energy].value;
+    float drawn = updated ? DrawnEnergy(*sect, stepSeconds) : -1.0f;
+    bool full = begun == sect->GetStorageCapacity(ResourceType::ENERGY);
+    auto refills = [&](float otherDrawn, float otherBegun) {
+        return drawn >= 0.0f && otherDrawn == drawn && (otherBegun != begun || full);
+    };
+
+    bool inRange = SameRanges(before, after);
+    bool inRangeBesideEnergy = inRange || SameRanges(before, after, energy);
+    if (!inRangeBesideEnergy) {
+        track.hasRates = false;
+        track.lastStep = -2;
+        return;
+    }
+
+    // With the sect in the ambient band the day curve is applied on its
+    // own, so the rest of the energy change can be held constant
+    bool ambient = ambientBeforeStep && ambientAfterStep;
+    change.resize(after.size());
+    for (size_t i = 0; i < after.size(); i++) {
+        change[i] = after[i].value - before[i].value;
+    }
+    const std::vector<double>& sums = AmbientSums(after[energy].value);
+    if (ambient) {
+        change[energy] -= static_cast<float>(sums[step + 1] - sums[step]);
+    }
+
+    bool refillsRates = !track.rate.empty() && refills(track.drawn, track.begun) &&
+                        SameChange(change, track.rate, after, energy) && SameDepletion(depletion, track.depletion);
+    bool refillsLast = track.lastStep == step - 1 && refills(track.lastDrawn, track.lastEnergy) &&
+                       SameChange(change, track.lastChange, after, energy) &&
+                       SameDepletion(depletion, track.lastDepletion);
+    bool refill = refillsRates || refillsLast;
+    bool refillProven = (refillsRates && track.begun != begun) || (refillsLast && track.lastEnergy != begun);
+
+    bool matchesRates = inRange && !track.rate.empty() && !track.refill && track.ambient == ambient &&
+                        SameChange(change, track.rate, after) && SameDepletion(depletion, track.depletion);
+    bool matchesLast = inRange && track.lastStep == step - 1 && track.lastInRange && track.lastAmbient == ambient &&
+                       SameChange(change, track.lastChange, after) && SameDepletion(depletion, track.lastDepletion);
+
+    track.hasRates = refill || matchesRates || matchesLast;
+    if (track.hasRates) {
+        track.rate = change;
+        track.range = after;
+        track.depletion = depletion;
+        track.refill = refill;
+        track.drawn = drawn;
+        track.begun = begun;
+        track.ambient = ambient && !refill;
+        track.ambientSums = &sums;
+        track.lanes = after;
+        if (refill) track.rate[energy] = 0.0f;
+
+        // Transfers only move storage, so the other lanes' limit holds
+        // for as long as the rates do
+        track.unitsThrough = stepCount - 1;
+        for (size_t i = RESOURCE_TYPE_COUNT; i < after.size() && track.unitsThrough > step; i++) {
+            if (change[i] == 0.0f) continue;
+            track.unitsThrough = LastInRange(after[i].value, change[i], 0.0, ambientBefore,
+                                             after[i].low, after[i].high, step, track.unitsThrough);
+        }
+
+        // Past the tick the day curve changes the step, unless ambient
+        // energy is added on its own or last, onto a refilled storage
+        if (refill) {
+            track.clockThrough = refillProven ? stepCount - 1 : FullEnergyThrough(track, step);
+        }
+        else {
+            track.clockThrough = (ambient || !updated) ? stepCount - 1 : -1;
+        }
+    }
+    track.lastChange.swap(change);
+    track.lastDepletion.swap(depletion);
+    track.lastAmbient = ambient;
+    track.lastInRange = inRange;
+    track.lastEnergy = begun;
+    track.lastDrawn = drawn;
+    track.lastStep = step;
+}
+
+void FastForward::Coast(SectTrack& track, int upTo) {
+    CoastStorage(track, upTo);
+    CoastAfterStorage(track, upTo);
+}
+
+void FastForward::CoastStorage(SectTrack& track, int upTo) {
+    int steps = upTo - track.synced;
+    if (steps <= 0 || !track.hasRates) return;
+
+    // Nothing but this engine moves a coasting sect, so its lanes are
+    // where the last sync left them
+    std::vector<SteadyLane>& lanes = track.lanes;
+    int energy = static_cast<int>(ResourceType::ENERGY);
+    for (int i = 0; i < RESOURCE_TYPE_COUNT; i++) {
+        double weight = (track.ambient && i == energy) ? 1.0 : 0.0;
+        if (track.rate[i] == 0.0f && weight == 0.0) continue;
+        lanes[i].value = static_cast<float>(LaneAt(lanes[i].value, track.rate[i], weight, *track.ambientSums, track.synced, steps));
+    }
+    if (track.refill) lanes[energy].value = RefilledEnergy(track, upTo);
+    track.sect->WriteStorageLanes(lanes);
+
+    track.synced = upTo;
+    report.coastedSectSteps += steps;
+}
+
+void FastForward::CoastAfterStorage(SectTrack& track, int upTo) {
+    int steps = upTo - track.unitsSynced;
+    if (steps <= 0 || !track.hasRates) return;
+
+    std::vector<SteadyLane>& lanes = track.lanes;
+    for (size_t i = RESOURCE_TYPE_COUNT; i < lanes.size(); i++) {
+        if (track.rate[i] == 0.0f) continue;
+        lanes[i].value = static_cast<float>(LaneAt(lanes[i].value, track.rate[i], 0.0, ambientBefore, track.unitsSynced, steps));
+    }
+    track.sect->WriteLanesAfterStorage(lanes);
+
+    for (const ResourceManager::Depletion& depletion : track.depletion) {
+        resources->UpdateResourceDepletion(depletion.gridX, depletion.gridY, depletion.type,
+                                           depletion.amount * static_cast<float>(steps));
+    }
+    track.unitsSynced = upTo;
+}
+
+void FastForward::Revalidate(SectTrack& track, int step) {
+    if (!track.hasRates) return;
+
+    // Transfers and deliveries may have moved the sect out of the range its
+    // rates were measured in; they keep them as candidates either way.
+    // They only move storage, the leading lanes.
+    std::vector<SteadyLane>& lanes = track.lanes;
+    const ResourceVector& storage = track.sect->GetResourceStorage();
+    // A refilling energy lane holds while nothing but the refill moved it.
+    int energy = static_cast<int>(ResourceType::ENERGY);
+    for (int i = 0; i < RESOURCE_TYPE_COUNT; i++) {
+        float value = storage.Get(static_cast<ResourceType>(i));
+        bool holds = track.refill && i == energy ? value == lanes[i].value
+                                                 : value >= track.range[i].low && value < track.range[i].high;
+        if (!holds) {
+            CoastAfterStorage(track, step);
+            track.hasRates = false;
+            return;
+        }
+        lanes[i].value = value;
+    }
+
+    int through = std::min(track.unitsThrough, std::max(tickEnd[step], track.clockThrough));
+    for (int i = 0; i < RESOURCE_TYPE_COUNT && through > step; i++) {
+        double weight = (track.ambient && static_cast<int>(i) == energy) ? 1.0 : 0.0;
+        if (track.rate[i] == 0.0f && weight == 0.0) continue;
+        through = LastInRange(lanes[i].value, track.rate[i], weight, *track.ambientSums,
+                              track.range[i].low, track.range[i].high, step, through);
+    }
+    track.through = through;
+}
+
+float FastForward::RefilledEnergy(const SectTrack& track, int step) const {
+    float capacity = track.sect->GetStorageCapacity(ResourceType::ENERGY);
+    if (track.drawn == capacity) return capacity;
+    float energy = track.drawn + ambientStep[step];
+    return energy <= capacity ? energy : capacity;
+}
+
+int FastForward::FullEnergyThrough(const SectTrack& track, int step) const {
+    // The first step to end short of capacity is the last; the one after
+    // begins below it, where the refill has not been seen. Ambient energy
+    // only changes with the tick.
+    float capacity = track.sect->GetStorageCapacity(ResourceType::ENERGY);
+    for (int t = step; t < stepCount; t = tickEnd[t] + 1) {
+        if (RefilledEnergy(track, t) < capacity) return t;
+    }
+    return stepCount - 1;
+}
+
+int FastForward::NextActiveStep(const ColonyTrack& colony, int step) {
+    int next = stepCount;
+    for (int i = 0; i < colony.sectCount; i++) {
+        const SectTrack& track = sects[colony.firstSect + i];
+        if (!track.hasRates) return step + 1;
+        next = std::min(next, track.through + 1);
+    }
+    if (next <= step + 1) return step + 1;
+
+    const Colony* owner = colony.colony;
+
+    // Packets arriving, first as they cost little and shorten the
+    // searches below
+    for (const TransportJob& job : owner->GetTransportJobs()) {
+        if (job.status != TransportStatus::IN_TRANSIT || !job.road) continue;
+        float travelTime = job.road->GetTravelTime();
+        if (travelTime <= 0.0f) continue;
+        double advance = stepSeconds / travelTime;
+        int arrival = static_cast<int>(std::ceil((1.0 - job.progress) / advance));
+        next = std::min(next, step + std::max(1, arrival - 1));
+    }
+
+    auto meet = [&](int crossing) {
+        next = std::min(next, std::max(step + 1, crossing - 1));
+    };
+    auto crossBand = [&](double value, double rate, double weight, double threshold) {
+        if ((rate == 0.0 && weight == 0.0) || next <= step + 1) return;
+        int limit = std::min(stepCount - 1, next);
+        double band = THRESHOLD_BAND * (std::fabs(threshold) + 1.0);
+        meet(FirstCrossing(value, rate, weight, ambientBefore, threshold - band, step, limit));
+        meet(FirstCrossing(value, rate, weight, ambientBefore, threshold + band, step, limit));
+    };
+    // A refilling energy lane goes up and down with the day between what
+    // the units leave and capacity, so a line inside that span may be met
+    // on any step
+    auto crossSpan = [&](double low, double high, double rate, double weight, double threshold) {
+        double band = THRESHOLD_BAND * (std::fabs(threshold) + 1.0);
+        if (threshold + band >= low && threshold - band <= high) {
+            next = step + 1;
+            return;
+        }
+        crossBand(low, rate, weight, threshold);
+        crossBand(high, rate, weight, threshold);
+    };
+
+    const ResourceVector& reserves = owner->GetStrategicReserves();
+    const ResourceVector& reserveCapacity = owner->GetReserveCapacity();
+    int energy = static_cast<int>(ResourceType::ENERGY);
+
+    // Sect surplus and deficit lines, and the storage level at which a
+    // blocked surplus would fit into the reserves
+    for (int i = 0; i < colony.sectCount && next > step + 1; i++) {
+        const SectTrack& track = sects[colony.firstSect + i];
+        const Sect* sect = track.sect;
+        const ResourceVector& capacities = sect->GetStorageCapacity();
+        for (auto [type, amount] : sect->GetResourceStorage()) {
+            if (!capacities.Has(type) || capacities.Get(type) <= 0.0f) continue;
+            float capacity = capacities.Get(type);
+
+            // A transfer that would run on the next pass
+            if (sect->IsSurplus(type) && owner->CanAcceptResource(type, amount - capacity * 0.5f)) {
+                return step + 1;
+            }
+            if (sect->IsDeficit(type) && reserves.Has(type) && reserves.Get(type) > 0.0f) {
+                return step + 1;
+            }
+
+            int lane = static_cast<int>(type);
+            double rate = track.rate[lane];
+            double weight = (track.ambient && lane == energy) ? 1.0 : 0.0;
+            double low = (track.refill && lane == energy) ? track.drawn : amount;
+            double high = (track.refill && lane == energy) ? capacity : amount;
+            auto cross = [&](double threshold) {
+                if (low == high) crossBand(amount, rate, weight, threshold);
+                else crossSpan(low, high, rate, weight, threshold);
+            };
+            cross(0.0);
+            cross(capacity * Balance().storageDeficitThreshold);
+            cross(capacity * Balance().storageSurplusThreshold);
+            if (reserveCapacity.Has(type)) {
+                double room = reserveCapacity.Get(type) - reserves.Get(type);
+                cross(capacity * 0.5 + room);
+            }
+        }
+    }
+
+    for (const Road& road : owner->GetRoads()) {
+        if (!road.sectA || !road.sectB || road.mode == TransportMode::MANUAL) continue;
+
+        // The rate limit running out, found on the clock of the run
+        if (road.activePacketCount < MAX_PACKETS_PER_ROAD &&
+            !road.CanAcceptNewJob(static_cast<float>(clockAt[step]))) {
+            auto first = std::partition_point(clockAt.begin() + step + 1, clockAt.begin() + std::min(next, stepCount),
+                [&](double now) { return !road.CanAcceptNewJob(static_cast<float>(now)); });
+            next = std::min(next, static_cast<int>(first - clockAt.begin()));
+        }
+
+        // A transfer a road earlier in the pass set up by moving storage
+        else if (road.CanAcceptNewJob(static_cast<float>(clockAt[step])) && WantsTransfer(road)) {
+            return step + 1;
+        }
+
+        if (road.mode != TransportMode::AUTO_BALANCE) continue;
+        auto a = trackOf.find(road.sectA);
+        auto b = trackOf.find(road.sectB);
+        if (a == trackOf.end() || b == trackOf.end()) continue;
+        const SectTrack& trackA = sects[a->second];
+        const SectTrack& trackB = sects[b->second];
+
+        // The fill ratio gap, a lane of its own
+        for (ResourceType type : SINGULAR_RESOURCE_TYPES) {
+            double capacityA = road.sectA->GetStorageCapacity(type);
+            double capacityB = road.sectB->GetStorageCapacity(type);
+            if (capacityA <= 0.0 || capacityB <= 0.0) continue;
+            int lane = static_cast<int>(type);
+            double gap = road.sectA->GetResourceStorage(type) / capacityA -
+                         road.sectB->GetResourceStorage(type) / capacityB;
+            double rate = trackA.rate[lane] / capacityA - trackB.rate[lane] / capacityB;
+            double weight = 0.0;
+            double low = gap;
+            double high = gap;
+            if (lane == energy) {
+                weight = (trackA.ambient ? 1.0 / capacityA : 0.0) - (trackB.ambient ? 1.0 / capacityB : 0.0);
+                double fillA = road.sectA->GetResourceStorage(type) / capacityA;
+                double fillB = road.sectB->GetResourceStorage(type) / capacityB;
+                low = (trackA.refill ? trackA.drawn / capacityA : fillA) - (trackB.refill ? 1.0 : fillB);
+                high = (trackA.refill ? 1.0 : fillA) - (trackB.refill ? trackB.drawn / capacityB : fillB);
+            }
+            if (low == high) {
+                crossBand(gap, rate, weight, Balance().autoBalanceThreshold);
+                crossBand(gap, rate, weight, -Balance().autoBalanceThreshold);
+            }
+            else {
+                crossSpan(low, high, rate, weight, Balance().autoBalanceThreshold);
+                crossSpan(low, high, rate, weight, -Balance().autoBalanceThreshold);
+            }
+        }
+    }
+
+    return std::max(step + 1, std::min(next, stepCount));
+}
+
+const std::vector<double>& FastForward::AmbientSums(float around) {
+    if (!(std::fabs(around) >= 1.0f) || !std::isfinite(around)) return ambientBefore;
+
+    int exponent;
+    std::frexp(std::fabs(around), &exponent);
+    std::vector<double>& sums = gridAmbient[exponent];
+    if (sums.empty()) {
+        // What a float in that binade gains from each step's ambient
+        // energy, rounding included
+        float base = std::ldexp(0.5f, exponent);
+        sums.assign(ambientStep.size() + 1, 0.0);
+        for (size_t i = 0; i < ambientStep.size(); i++) {
+            sums[i + 1] = sums[i] + ((base + ambientStep[i]) - base);
+        }
+    }
+    return sums;
+}
+
+double FastForward::LaneAt(double value, double rate, double ambientWeight, const std::vector<double>& ambient,
+                           int from, int steps) const {
+    double result = value + rate * steps;
+    if (ambientWeight != 0.0) {
+        result += ambientWeight * (ambient[from + 1 + steps] - ambient[from + 1]);
+    }
+    return result;
+}
+
+int FastForward::LastInRange(double value, double rate, double ambientWeight, const std::vector<double>& ambient,
+                             double low, double high, int from, int limit) const {
+    if (limit <= from) return from;
+    if (ambientWeight == 0.0) {
+        return from + static_cast<int>(StepsInRange(value, rate, low, high, limit - from));
+    }
+
+    // The ambient gain is constant within a game tick, so the lane is a
+    // line per tick
+    int step = from + 1;
+    while (step <= limit) {
+        int end = std::min(tickEnd[step], limit);
+        double slope = rate + ambientWeight * (ambient[step + 1] - ambient[step]);
+        double length = end - step + 1;
+        double inside = StepsInRange(value, slope, low, high, length);
+        if (inside < length) return step - 1 + static_cast<int>(inside);
+        value += slope * length;
+        step = end + 1;
+    }
+    return limit;
+}
+
+int FastForward::FirstCrossing(double value, double rate, double ambientWeight, const std::vector<double>& ambient,
+                               double threshold, int from, int limit) const {
+    if (value == threshold) return from + 1;
+    if (value < threshold) {
+        return LastInRange(value, rate, ambientWeight, ambient, -INF, threshold, from, limit) + 1;
+    }
+    return LastInRange(value, rate, ambientWeight, ambient, std::nextafter(threshold, INF), INF, from, limit) + 1;
+}
+
+bool MeasureDrift(const std::vector<Colony*>& fast, const std::vector<Colony*>& stepped,
+                  FastForwardDrift& drift) {
+    drift = FastForwardDrift();
+    if (fast.size() != stepped.size()) return false;
+
+    double total = 0.0;
+    int lanes = 0;
+    for (size_t c = 0; c < fast.size(); c++) {
+        const Colony* a = fast[c];
+        const Colony* b = stepped[c];
+        if (!a || !b || a->GetSects().size() != b->GetSects().size()) return false;
+
+        for (size_t s = 0; s < a->GetSects().size(); s++) {
+            const Sect* sectA = a->GetSects()[s];
+            const Sect* sectB = b->GetSects()[s];
+            for (auto [type, capacity] : sectA->GetStorageCapacity()) {
+                if (capacity <= 0.0f) continue;
+                float error = std::fabs(sectA->GetResourceStorage(type) - sectB->GetResourceStorage(type)) / capacity;
+                total += error;
+                lanes++;
+                if (error > drift.maxStorageError) {
+                    drift.maxStorageError = error;
+                    drift.worst = "colony " + std::to_string(c) + " sect " + std::to_string(s) + " " +
+                                  ResourceTypeToString(type);
+                }
+            }
+        }
+
+        for (auto [type, capacity] : a->GetReserveCapacity()) {
+            if (capacity <= 0.0f) continue;
+            float error = std::fabs(a->GetStrategicReserves().Get(type) - b->GetStrategicReserves().Get(type)) / capacity;
+            drift.maxReserveError = std::max(drift.maxReserveError, error);
+        }
+        drift.packetDifference += std::abs(static_cast<int>(a->GetTransportJobs().size()) -
+                                           static_cast<int>(b->GetTransportJobs().size()));
+    }
+    drift.meanStorageError = lanes > 0 ? static_cast<float>(total / lanes) : 0.0f;
+    return true;
+}
+
+bool ValidateFastForward(const std::string& path, int steps, bool batchedModules,
+                         FastForwardValidation& out, std::string* error) {
+    out = FastForwardValidation();
+
+    ResourceManager fastResources(0, 1.0f);
+    ResourceManager steppedResources(0, 1.0f);
+    TimeManager fastTime;
+    TimeManager steppedTime;
+    SimStepper fastStepper;
+    SimStepper steppedStepper;
+    std::vector<Colony*> fast;
+    std::vector<Colony*> stepped;
+
+    if (!SaveGame::Load(path, fastResources, fastTime, fast, error, fastStepper.GetClock())) return false;
+    if (!SaveGame::Load(path, steppedResources, steppedTime, stepped, error, steppedStepper.GetClock())) {
+        for (Colony* colony : fast) delete colony;
+        return false;
+    }
+    fastStepper.SetBatchedModules(batchedModules);
+    steppedStepper.SetBatchedModules(batchedModules);
+
+    FastForward engine(fastStepper);
+    out.report = engine.Advance(fast, fastResources, fastTime, steps);
+
+    auto begin = std::chrono::steady_clock::now();
+    for (int step = 0; step < steps; step++) {
+        steppedTime.Advance(SimScheduler::STEP_SECONDS);
+        steppedStepper.Step(stepped, SimScheduler::STEP_SECONDS);
+    }
+    out.steppedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    bool matched = MeasureDrift(fast, stepped, out.drift);
+    fastStepper.Release();
+    steppedStepper.Release();
+    for (Colony* colony : fast) delete colony;
+    for (Colony* colony : stepped) delete colony;
+
+    if (!matched) SetError(error, "fast-forwarded world no longer matches the stepped one in shape");
+    return matched;
+}
@@ -0,0 +1,190 @@
+#ifndef FAST_FORWARD_H
+#define FAST_FORWARD_H
+
+#include "module_store.h"
+#include "resource_manager.h"
+#include "sim_scheduler.h"
+#include "unit.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class Colony;
+class Sect;
+class SimStepper;
+
+// Skips the simulation ahead by many steps at a time, ending where
+// stepping would have up to float rounding.
+//
+// Between events a sect's update moves its state by the same amount every
+// step: modules run at a fixed efficiency, extraction digs at a fixed
+// rate, wear creeps and timers run down. The engine measures that change
+// (two real updates in a row that agree), then applies it for as many
+// steps as it holds in one go, x + n * rate, with the ambient solar
+// energy summed from the day curve. A sect's rates hold until one of its
+// lanes leaves its range (Sect::ReadLanes) or would reach a float binade
+// where adding the same rate rounds differently, or to the end of the
+// game tick when its rates follow the time of day. A sect that tops its
+// energy storage back up within every step leaves the same energy before
+// the ambient gain whatever it began with, so that lane is set from the
+// day curve rather than moved by a rate.
+//
+// A colony's transfers and transport are what turn rates into events, so
+// each colony has a horizon too: the first step at which a sect storage
+// could cross the deficit, surplus, reserve-room or empty line, a road's
+// fill ratios could cross AUTO_BALANCE_THRESHOLD, a road's rate limit
+// runs out or a packet arrives. Up to it the colony coasts and none of
+// its code runs. At it the colony takes a step: transfers and transport
+// run as normal, sects whose rates still hold advance by them and the
+// rest update for real and are measured again. So stepping is only paid
+// for around events, and only by the colony they happen in.
+//
+// Colonies are coupled only by the planet map, where depletion commutes.
+class FastForward {
+public:
+    struct Report {
+        int steps = 0;
+        int sectSteps = 0;              // sect updates run for real
+        int coastedSectSteps = 0;       // sect updates applied from rates
+        int colonySteps = 0;            // colony transfer and transport passes run
+        int coastedColonySteps = 0;     // passes skipped as no-ops
+        double seconds = 0.0;           // wall time
+    };
+
+    explicit FastForward(SimStepper& stepper, float stepSeconds = SimScheduler::STEP_SECONDS);
+
+    // Advances the colonies, the planet and `time` by `steps` steps, as
+    // time.Advance and stepper.Step would; the stepper's clock ends where
+    // stepping would leave it and its module batching is followed.
+    Report Advance(const std::vector<Colony*>& colonies, ResourceManager& resources,
+                   TimeManager& time, int steps);
+
+private:
+    struct SectTrack {
+        Sect* sect = nullptr;
+        std::vector<Sect*> single;                      // the sect alone, for `modules`
+        ModuleStore modules;
+
+        bool hasRates = false;
+        bool ambient = false;                           // energy lane excludes the ambient gain
+        bool refill = false;                            // energy lane is `drawn` plus the step's ambient gain
+        float drawn = -1.0f;                            // energy the units left before ambient; -1 when it cannot refill
+        float begun = 0.0f;                             // energy storage the measure began with
+        const std::vector<double>* ambientSums = nullptr;      // the gain, for the energy lane's binade
+        std::vector<float> rate;                        // per step, one per lane
+        std::vector<SteadyLane> range;                  // where the rates were measured
+        std::vector<SteadyLane> lanes;                  // the sect as last synced, while it has rates
+        std::vector<ResourceManager::Depletion> depletion;     // per step
+        int synced = -1;                                // last step applied
+        int unitsSynced = -1;                           // the same for the lanes after storage, and depletion
+        int through = -1;                               // last step the rates may be applied to
+        int unitsThrough = -1;                          // the same for the lanes after storage
+        int clockThrough = -1;                          // last step the time of day leaves the rates alone
+
+        // The previous real update, to measure against
+        std::vector<float> lastChange;
+        std::vector<ResourceManager::Depletion> lastDepletion;
+        bool lastAmbient = false;
+        bool lastInRange = false;                       // every lane, energy included, kept its range
+        float lastEnergy = 0.0f;                        // energy storage it began with
+        float lastDrawn = -1.0f;                        // and left before ambient energy
+        int lastStep = -2;
+
+        // The lanes after the last real update, binades kept, and the
+        // sect's StateSignature then
+        std::vector<SteadyLane> read;
+        bool readAmbient = false;
+        uint64_t readSignature = 0;
+    };
+
+    struct ColonyTrack {
+        Colony* colony = nullptr;
+        int firstSect = 0;                              // index into sects
+        int sectCount = 0;
+        int activeAt = 0;                               // next step it runs
+        int jobsSynced = -1;                            // last step its packets moved
+    };
+
+    void Build(const std::vector<Colony*>& colonies);
+    void PrepareClock(const TimeManager& time, int steps);
+
+    void RunColony(ColonyTrack& colony, int step);
+    void StepSect(SectTrack& track, int step);
+    // Colony passes only read storage, so a coasting sect's other lanes
+    // and its depletion wait for it to step or the run to end
+    void Coast(SectTrack& track, int upTo);
+    void CoastStorage(SectTrack& track, int upTo);
+    void CoastAfterStorage(SectTrack& track, int upTo);
+    void Revalidate(SectTrack& track, int step);
+    int NextActiveStep(const ColonyTrack& colony, int step);
+    // Energy a refilling sect ends `step` with: what the units left, plus
+    // the step's ambient energy as Sect::GenerateAmbientEnergy adds it
+    float RefilledEnergy(const SectTrack& track, int step) const;
+    // Last step a sect measured at `step` with its energy storage full
+    // stays full whatever the time of day
+    int FullEnergyThrough(const SectTrack& track, int step) const;
+
+    // Ambient energy summed over the steps before each step, as a float
+    // lane of `around`'s binade gains it; exact sums below 1
+    const std::vector<double>& AmbientSums(float around);
+
+    // Value of a lane `steps` after `from`, the gain in `ambient` included
+    // when `ambientWeight` is not 0
+    double LaneAt(double value, double rate, double ambientWeight, const std::vector<double>& ambient,
+                  int from, int steps) const;
+    // Last step at or after `from` with the lane still in [low, high)
+    int LastInRange(double value, double rate, double ambientWeight, const std::vector<double>& ambient,
+                    double low, double high, int from, int limit) const;
+    // First step after `from` with the lane at or across `threshold`;
+    // limit + 1 when there is none by `limit`
+    int FirstCrossing(double value, double rate, double ambientWeight, const std::vector<double>& ambient,
+                      double threshold, int from, int limit) const;
+
+    SimStepper& stepper;
+    float stepSeconds;
+    int stepCount = 0;
+    ResourceManager* resources = nullptr;
+    Report report;
+
+    std::vector<SectTrack> sects;
+    std::vector<ColonyTrack> colonyTracks;
+    std::unordered_map<const Sect*, int> trackOf;      // sect to its index in sects
+
+    // Per step of the run
+    std::vector<double> clockAt;                        // transport clock after the step
+    std::vector<double> ambientBefore;                  // ambient energy of the steps before it
+    std::vector<float> ambientStep;                     // ambient energy of the step
+    std::unordered_map<int, std::vector<double>> gridAmbient;  // ambientBefore per binade exponent
+    std::vector<int> tickEnd;                           // last step of its game tick
+
+    std::vector<SteadyLane> before;                     // scratch
+    std::vector<SteadyLane> after;
+    std::vector<float> change;
+    std::vector<ResourceManager::Depletion> depletion;
+};
+
+// How far a fast-forwarded world ended from the same world stepped
+struct FastForwardDrift {
+    float maxStorageError = 0.0f;       // largest sect storage gap, as a fraction of capacity
+    float meanStorageError = 0.0f;
+    float maxReserveError = 0.0f;       // largest colony reserve gap, as a fraction of capacity
+    int packetDifference = 0;           // packets in flight, summed over colonies
+    std::string worst;                  // where maxStorageError is, e.g. "colony 2 sect 5 Fe"
+};
+
+// Compares two copies of one world, colony by colony and sect by sect.
+// False when their shapes differ.
+bool MeasureDrift(const std::vector<Colony*>& fast, const std::vector<Colony*>& stepped,
+                  FastForwardDrift& drift);
+
+// Validation mode: loads the save at `path` twice, runs one copy through
+// FastForward and steps the other `steps` times, and measures the drift.
+struct FastForwardValidation {
+    FastForward::Report report;
+    double steppedSeconds = 0.0;        // wall time of the stepped copy
+    FastForwardDrift drift;
+};
+bool ValidateFastForward(const std::string& path, int steps, bool batchedModules,
+                         FastForwardValidation& out, std::string* error);
+
+#endif // FAST_FORWARD_H
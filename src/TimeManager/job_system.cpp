@@ -0,0 +1,140 @@
+#include "job_system.h"
+#include <algorithm>
+
+int JobSystem::DefaultWorkerCount()
+{
+#ifdef __EMSCRIPTEN__
+    return 0;
+#else
+    int hardware = static_cast<int>(std::thread::hardware_concurrency());
+    return std::max(0, hardware - 1);
+#endif
+}
+
+JobSystem::JobSystem(int workerCount)
+    : queued(0),
+      stolen(0),
+      stopping(false)
+{
+#ifdef __EMSCRIPTEN__
+    workerCount = 0;
+#endif
+    workerCount = std::max(0, workerCount);
+    for (int i = 0; i <= workerCount; i++) {
+        queues.push_back(std::make_unique<Queue>());
+    }
+    for (int i = 0; i < workerCount; i++) {
+        workers.emplace_back(&JobSystem::WorkerLoop, this, i + 1);
+    }
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    workReady.notify_all();
+    for (std::thread& worker : workers) {
+        if (worker.joinable()) worker.join();
+    }
+}
+
+void JobSystem::ParallelFor(int count, const IndexFn& fn)
+{
+    if (count <= 0) return;
+
+    // Nothing to share the loop with
+    if (workers.empty() || count == 1) {
+        for (int i = 0; i < count; i++) fn(i);
+        return;
+    }
+
+    Batch batch;
+    batch.fn = &fn;
+    batch.remaining = count;
+
+    const int queueCount = static_cast<int>(queues.size());
+    for (int q = 0; q < queueCount; q++) {
+        std::lock_guard<std::mutex> lock(queues[q]->mutex);
+        for (int i = q; i < count; i += queueCount) {
+            queues[q]->tasks.push_back({&batch, i});
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        queued += count;
+    }
+    workReady.notify_all();
+
+    // Help out until the last task (possibly running elsewhere) finishes
+    while (batch.remaining.load() > 0) {
+        Task task;
+        if (FindTask(0, task)) {
+            Run(task);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        batchDone.wait(lock, [&] { return batch.remaining.load() == 0 || queued.load() > 0; });
+    }
+}
+
+bool JobSystem::PopOwn(int self, Task& task)
+{
+    Queue& queue = *queues[self];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) return false;
+    task = queue.tasks.back();
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool JobSystem::Steal(int self, Task& task)
+{
+    const int queueCount = static_cast<int>(queues.size());
+    for (int offset = 1; offset < queueCount; offset++) {
+        Queue& victim = *queues[(self + offset) % queueCount];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.tasks.empty()) continue;
+        task = victim.tasks.front();
+        victim.tasks.pop_front();
+        stolen++;
+        return true;
+    }
+    return false;
+}
+
+bool JobSystem::FindTask(int self, Task& task)
+{
+    if (PopOwn(self, task) || Steal(self, task)) {
+        queued--;
+        return true;
+    }
+    return false;
+}
+
+void JobSystem::Run(const Task& task)
+{
+    (*task.batch->fn)(task.index);
+
+    // The batch lives on the caller's stack: touch nothing of it after this
+    if (task.batch->remaining.fetch_sub(1) == 1) {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        batchDone.notify_all();
+    }
+}
+
+void JobSystem::WorkerLoop(int self)
+{
+    while (true) {
+        Task task;
+        if (FindTask(self, task)) {
+            Run(task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        workReady.wait(lock, [&] { return stopping || queued.load() > 0; });
+        if (stopping && queued.load() == 0) return;
+    }
+}
@@ -0,0 +1,80 @@
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing thread pool for the simulation step.
+//
+// ParallelFor() splits a loop into one task per index and deals them out
+// round-robin over per-thread queues. Each thread takes from the back of
+// its own queue and, when that runs dry, steals from the front of the
+// others', so a few slow tasks (a busy extraction sect) do not leave the
+// rest of the pool idle. The calling thread works through the loop too and
+// returns once every index has run.
+//
+// Tasks must only touch state their index owns; anything shared has to be
+// recorded per task and merged by the caller afterwards, in index order,
+// so results do not depend on scheduling. Web builds have no workers and
+// run loops inline.
+class JobSystem {
+public:
+    using IndexFn = std::function<void(int index)>;
+
+    // Hardware threads minus the calling thread
+    static int DefaultWorkerCount();
+
+    explicit JobSystem(int workerCount = DefaultWorkerCount());
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // Runs fn(0) .. fn(count - 1), each exactly once, and blocks until done
+    void ParallelFor(int count, const IndexFn& fn);
+
+    int GetWorkerCount() const { return static_cast<int>(workers.size()); }
+    uint64_t GetStolenCount() const { return stolen.load(); }   // tasks run off another thread's queue
+
+private:
+    struct Batch {
+        const IndexFn* fn;
+        std::atomic<int> remaining;
+    };
+
+    struct Task {
+        Batch* batch;
+        int index;
+    };
+
+    // Queue 0 belongs to the calling thread, queue i + 1 to worker i
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    bool PopOwn(int self, Task& task);
+    bool Steal(int self, Task& task);
+    bool FindTask(int self, Task& task);
+    void Run(const Task& task);
+    void WorkerLoop(int self);
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+
+    std::mutex sleepMutex;
+    std::condition_variable workReady;      // tasks queued, or stopping
+    std::condition_variable batchDone;
+    std::atomic<int> queued;
+    std::atomic<uint64_t> stolen;
+    bool stopping;
+};
+
+#endif // JOB_SYSTEM_H
@@ -0,0 +1,43 @@
+#ifndef SIM_CLOCK_H
+#define SIM_CLOCK_H
+
+#include <chrono>
+
+// Time source for simulation code that needs "now" in seconds (transport
+// rate limits). The sim never reads the window clock itself, so it runs
+// without a GL context: by default it uses a monotonic clock started at
+// construction, and headless runs and tests can install a ManualClock to
+// step time as fast as they like.
+class SimClock {
+public:
+    virtual ~SimClock() = default;
+    virtual double Now() const = 0;
+};
+
+// Wall-clock seconds since construction (the default).
+class SteadyClock : public SimClock {
+public:
+    SteadyClock() : start(std::chrono::steady_clock::now()) {}
+
+    double Now() const override {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+private:
+    std::chrono::steady_clock::time_point start;
+};
+
+// Time that only moves when told to.
+class ManualClock : public SimClock {
+public:
+    explicit ManualClock(double start = 0.0) : now(start) {}
+
+    double Now() const override { return now; }
+    void Set(double seconds) { now = seconds; }
+    void Advance(double seconds) { now += seconds; }
+
+private:
+    double now;
+};
+
+#endif // SIM_CLOCK_H
@@ -0,0 +1,51 @@
+#include "sim_scheduler.h"
+#include <cmath>
+
+SimScheduler::SimScheduler(TimeManager& time, float step, int maxTicks)
+    : timeManager(time),
+      stepSeconds(step > 0.0f ? step : STEP_SECONDS),
+      maxTicksPerFrame(maxTicks > 0 ? maxTicks : 1),
+      accumulator(0.0),
+      tickCount(0),
+      lastFrameTicks(0),
+      droppedTicks(0)
+{
+}
+
+int SimScheduler::Advance(float frameSeconds, const StepFn& step) {
+    lastFrameTicks = 0;
+    if (timeManager.IsPaused() || frameSeconds <= 0.0f) return 0;
+
+    accumulator += static_cast<double>(frameSeconds) * timeManager.GetTimeScale();
+
+    int ticks = 0;
+    while (accumulator >= stepSeconds && ticks < maxTicksPerFrame) {
+        timeManager.Advance(stepSeconds);
+        if (step) step(stepSeconds);
+        accumulator -= stepSeconds;
+        ticks++;
+    }
+
+    // Over the cap: keep the fractional part for interpolation, drop the rest
+    if (accumulator >= stepSeconds) {
+        double behind = std::floor(accumulator / stepSeconds);
+        droppedTicks += static_cast<uint64_t>(behind);
+        accumulator -= behind * stepSeconds;
+    }
+
+    tickCount += ticks;
+    lastFrameTicks = ticks;
+    return ticks;
+}
+
+void SimScheduler::Reset() {
+    accumulator = 0.0;
+    tickCount = 0;
+    lastFrameTicks = 0;
+    droppedTicks = 0;
+}
+
+float SimScheduler::GetAlpha() const {
+    float alpha = static_cast<float>(accumulator / stepSeconds);
+    return alpha < 0.0f ? 0.0f : (alpha > 1.0f ? 1.0f : alpha);
+}
@@ -0,0 +1,54 @@
+#ifndef SIM_SCHEDULER_H
+#define SIM_SCHEDULER_H
+
+#include "time_manager.h"
+#include <cstdint>
+#include <functional>
+
+// Fixed-timestep driver for the simulation.
+//
+// Frame time goes in, whole ticks of STEP_SECONDS game time come out, so
+// the same amount of play produces the same sequence of steps at any
+// frame rate. Time scale is applied by running more (or fewer) ticks, not
+// by stretching them, and TimeManager's game clock advances tick by tick.
+// A slow frame runs at most MAX_TICKS_PER_FRAME ticks; time beyond that is
+// dropped rather than carried into a catch-up spiral.
+class SimScheduler {
+public:
+    static constexpr float STEP_SECONDS = 1.0f / 30.0f;
+    static const int MAX_TICKS_PER_FRAME = 64;
+
+    using StepFn = std::function<void(float stepSeconds)>;
+
+    explicit SimScheduler(TimeManager& time,
+                          float step = STEP_SECONDS,
+                          int maxTicks = MAX_TICKS_PER_FRAME);
+
+    // Adds one frame of real time (scaled by the TimeManager's time scale;
+    // nothing while paused) and calls `step` once per tick it pays for.
+    // Returns the number of ticks run.
+    int Advance(float frameSeconds, const StepFn& step);
+
+    void Reset();
+
+    // How far game time has got past the last tick, as a fraction of a
+    // step (0..1). Renderers blend the previous and current tick by it.
+    float GetAlpha() const;
+
+    float GetStepSeconds() const { return stepSeconds; }
+    uint64_t GetTickCount() const { return tickCount; }
+    int GetLastFrameTicks() const { return lastFrameTicks; }
+    uint64_t GetDroppedTicks() const { return droppedTicks; }   // lost to the per-frame cap
+
+private:
+    TimeManager& timeManager;
+    float stepSeconds;
+    int maxTicksPerFrame;
+
+    double accumulator;     // game seconds not yet stepped
+    uint64_t tickCount;
+    int lastFrameTicks;
+    uint64_t droppedTicks;
+};
+
+#endif // SIM_SCHEDULER_H
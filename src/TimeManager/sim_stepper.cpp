@@ -0,0 +1,89 @@
+#include "sim_stepper.h"
+#include "balance_params.h"
+#include "colony.h"
+#include "sect.h"
+
+SimStepper::SimStepper(int workerCount)
+    : batchModules(true),
+      jobs(workerCount),
+      parallelUpdate(true)
+{
+}
+
+void SimStepper::Step(const std::vector<Colony*>& allColonies, float dt) {
+    clock.Advance(dt);
+
+    // At level of detail only the viewed and measuring colonies step here;
+    // the rest move as aggregated flows in EndStep
+    const bool detail = lod.IsEnabled();
+    const std::vector<Colony*>& colonies = detail ? lod.BeginStep(allColonies, dt) : allColonies;
+
+    allSects.clear();
+    for (Colony* colony : colonies) {
+        allSects.insert(allSects.end(), colony->GetSects().begin(), colony->GetSects().end());
+    }
+
+    // Module production/consumption for every sect, one loop per kind
+    if (batchModules) {
+        moduleStore.Update(allSects, dt);
+    }
+
+    if (parallelUpdate && jobs.GetWorkerCount() > 0) {
+        // Only sects with something to do are stepped
+        activeSects.clear();
+        for (Sect* sect : allSects) {
+            if (sect->NeedsUpdate()) activeSects.push_back(sect);
+        }
+
+        // Sects only touch their own storage and units; planet depletion is
+        // logged per sect and applied in sect order, as the serial loop did.
+        // Workers run under the caller's balance.
+        const BalanceParams& balance = Balance();
+        jobs.ParallelFor(static_cast<int>(activeSects.size()), [&](int i) {
+            BalanceScope scope(balance);
+            activeSects[i]->UpdateLocal(dt);
+        });
+        for (Sect* sect : activeSects) {
+            if (detail) lod.RecordDepletion(sect);
+            sect->CommitDepletion();
+        }
+        if (detail) lod.AfterSects();
+
+        // Colony transfers move resources between a colony's own sects and
+        // reserves, so colonies are independent tasks
+        jobs.ParallelFor(static_cast<int>(colonies.size()), [&](int i) {
+            BalanceScope scope(balance);
+            colonies[i]->ManageResources();
+            colonies[i]->ProcessTransportJobs(dt);
+        });
+    } else {
+        // Sect::Update steps each of its units, so units are not
+        // updated again here
+        for (Colony* colony : colonies) {
+            for (Sect* sect : colony->GetSects()) {
+                if (sect->NeedsUpdate()) {
+                    sect->UpdateLocal(dt);
+                    if (detail) lod.RecordDepletion(sect);
+                    sect->CommitDepletion();
+                }
+            }
+        }
+        if (detail) lod.AfterSects();
+
+        for (Colony* colony : colonies) {
+            // Push surplus from sects to colony reserves and pull deficits
+            colony->ManageResources();
+
+            colony->ProcessTransportJobs(dt);
+        }
+    }
+
+    if (detail) lod.EndStep();
+}
+
+void SimStepper::SetBatchedModules(bool enabled) {
+    if (!enabled) {
+        moduleStore.Release();
+    }
+    batchModules = enabled;
+}
@@ -0,0 +1,73 @@
+#ifndef SIM_STEPPER_H
+#define SIM_STEPPER_H
+
+#include "colony_lod.h"
+#include "module_store.h"
+#include "job_system.h"
+#include "sim_clock.h"
+#include <vector>
+
+class Colony;
+class Sect;
+class TimeManager;
+
+// One simulation tick over a set of colonies: the module batches, every
+// sect with work, then each colony's transfers and transport.
+//
+// GameManager runs it once per SimScheduler tick; headless tools (session
+// replay, benchmarks) call Step() directly, so both advance the world the
+// same way. It also owns the clock colonies read for transport rate
+// limits: the clock moves by the step, not by the wall, so transport
+// timing follows game time and a replay sees the same times as the run it
+// replays.
+class SimStepper {
+public:
+    // `workerCount` sizes the job system; 0 steps everything on the
+    // calling thread, for callers that run many worlds side by side
+    explicit SimStepper(int workerCount = JobSystem::DefaultWorkerCount());
+
+    void Step(const std::vector<Colony*>& colonies, float dt);
+
+    // Non-extraction modules run from the ModuleStore (per-kind batches)
+    // instead of unit by unit; off restores Unit::ProcessModuleEffects
+    void SetBatchedModules(bool enabled);
+    bool IsBatchingModules() const { return batchModules; }
+
+    // Sects, then colonies, step as tasks on the job system. Results are
+    // the same as the serial loop; off runs that loop instead.
+    void SetParallelUpdate(bool enabled) { parallelUpdate = enabled; }
+    bool IsParallelUpdate() const { return parallelUpdate; }
+
+    // Level of detail (ColonyLod): colonies outside the viewed set are
+    // measured, then run as aggregated flows every few steps. `time` gives
+    // the solar curve; nullptr brings every colony back to full detail.
+    void SetLevelOfDetail(const TimeManager* time) { lod.Enable(time); }
+    bool IsLevelOfDetail() const { return lod.IsEnabled(); }
+    void SetViewedColonies(const std::vector<Colony*>& viewed) { lod.SetViewed(viewed); }
+    // Brings aggregated colonies' storage up to the current step
+    void ReconcileDetail() { lod.Reconcile(); }
+    const ColonyLod& GetLevelOfDetail() const { return lod; }
+
+    // The module store and level of detail point into the colonies and
+    // units: call before they go away
+    void Release() { moduleStore.Release(); lod.Clear(); }
+
+    const SimClock* GetClock() const { return &clock; }
+    double GetClockTime() const { return clock.Now(); }
+    void SetClockTime(double seconds) { clock.Set(seconds); }
+
+private:
+    ModuleStore moduleStore;
+    bool batchModules;
+    std::vector<Sect*> allSects;        // every colony's sects, in update order
+    std::vector<Sect*> activeSects;     // those of them with work this tick
+
+    JobSystem jobs;
+    bool parallelUpdate;
+
+    ColonyLod lod;
+
+    ManualClock clock;
+};
+
+#endif // SIM_STEPPER_H
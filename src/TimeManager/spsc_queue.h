@@ -0,0 +1,50 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+// Bounded single-producer, single-consumer ring. One thread pushes, one
+// other thread pops; neither ever takes a lock or waits on the other. A
+// full ring refuses the push and leaves it to the producer to hold the
+// item and try again later. Capacity must be a power of two.
+template <typename T, size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "capacity must be a power of two");
+
+public:
+    SpscQueue() : head(0), tail(0) {}
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // Producer only. False, with `item` untouched, when the ring is full
+    bool Push(T& item) {
+        const size_t pos = head.load(std::memory_order_relaxed);
+        if (pos - tail.load(std::memory_order_acquire) == Capacity) return false;
+        slots[pos & (Capacity - 1)] = std::move(item);
+        head.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer only. False when there is nothing to take
+    bool Pop(T& item) {
+        const size_t pos = tail.load(std::memory_order_relaxed);
+        if (pos == head.load(std::memory_order_acquire)) return false;
+        item = std::move(slots[pos & (Capacity - 1)]);
+        tail.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Either side; a snapshot that may be stale by the time it is read
+    bool IsEmpty() const { return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire); }
+
+private:
+    T slots[Capacity];
+    // Apart, so the two threads do not share a cache line for their own index
+    alignas(64) std::atomic<size_t> head;   // next slot to fill
+    alignas(64) std::atomic<size_t> tail;   // next slot to take
+};
+
+#endif // SPSC_QUEUE_H
@@ -1,4 +1,5 @@
 #include "time_manager.h"
+#include "byte_stream.h"
 
 
 TimeManager::TimeManager()
@@ -25,7 +26,10 @@ void TimeManager::Update(float deltaTime) {
     if (isPaused) return;
 
     // Scale delta time by time scale
-    float scaledDelta = deltaTime * timeScale;
+    Advance(deltaTime * timeScale);
+}
+
+void TimeManager::Advance(float scaledDelta) {
     gameTime += scaledDelta;
 
     // Accumulate time towards next tick
@@ -62,6 +66,24 @@ void TimeManager::Resume() {
 void TimeManager::SetTimeScale(float scale) {
     timeScale = scale > 0.0f ? scale : 1.0f;
 }
+
+void TimeManager::SaveState(ByteWriter& out) const {
+    out.Write<float>(gameTime);
+    out.Write<float>(timeScale);
+    out.Write<float>(accumulatedTime);
+    out.Write<int32_t>(currentTicks);
+    out.WriteBool(isPaused);
+}
+
+bool TimeManager::LoadState(ByteReader& in) {
+    gameTime = in.Read<float>();
+    timeScale = in.Read<float>();
+    accumulatedTime = in.Read<float>();
+    currentTicks = in.Read<int32_t>();
+    isPaused = in.ReadBool();
+    if (!(timeScale > 0.0f) || currentTicks < 0) in.Fail();
+    return in.Ok();
+}
 /*
 //---------------------------------------------------------------------------------------------
 //            Production management
@@ -331,48 +353,6 @@ void TimeManager::ProcessTick() {
     currentTicks++;
 }
 
-void TimeManager::Draw(int screenWidth, int screenHeight) {
-
-    int currentDay = GetCurrentDay();
-
-    // Calculate text properties
-    const char* text = TextFormat("Day %d", currentDay);
-    int fontSize = 18;
-    int textWidth = MeasureText(text, fontSize);
-
-    // Position text at top center of screen with slight padding
-    int xPos = (screenWidth - textWidth) / 2;
-    int yPos = 10;  // Padding from top
-
-    // Draw background rectangle for better visibility
-    Color bgColor = Color{0, 0, 0, 100};  // Semi-transparent black
-    int padding = 8;
-    DrawRectangle(
-        xPos - padding,
-        yPos - padding/2,
-        textWidth + padding*2,
-        fontSize + padding,
-        bgColor
-    );
-
-    // Draw the text
-    DrawText(text, xPos, yPos, fontSize, WHITE);
-
-    // If game is paused, show pause indicator
-    if (isPaused) {
-        const char* pausedText = "PAUSED";
-        int pausedFontSize = 20;
-        int pausedWidth = MeasureText(pausedText, pausedFontSize);
-        DrawText(
-            pausedText,
-            (screenWidth - pausedWidth) / 2,
-            yPos + fontSize + padding,
-            pausedFontSize,
-            RED
-        );
-    }
-}
-
 int TimeManager::GetCurrentDay() const {
     return currentTicks / TICKS_PER_DAY;
 }
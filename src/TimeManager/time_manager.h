@@ -15,6 +15,8 @@
 //#include "game_structs.h"
 #include "game_constants.h"
 
+class ByteWriter;
+class ByteReader;
 
 
 // Production cycle status
@@ -46,12 +48,17 @@ public:
     ~TimeManager();
 
     // Core time functions
-    void Update(float deltaTime);
+    void Update(float deltaTime);       // real seconds; applies pause and time scale
+    void Advance(float scaledDelta);    // game seconds, already scaled (SimScheduler)
     void Reset();
     void Pause();
     void Resume();
     void SetTimeScale(float scale);
 
+    // Save game snapshot of the clock (SaveGame::Save / Load)
+    void SaveState(ByteWriter& out) const;
+    bool LoadState(ByteReader& in);
+
    /*
     // Production management
     void StartProduction(Unit* unit);
@@ -85,8 +92,7 @@ public:
     float TicksToSeconds(int ticks) const;
     int SecondsToTicks(float seconds) const;
 
-    // Draw Time functions
-    void Draw(int screenWidth, int screenHeight);
+    // Day clock (drawn by RenderManager::DrawTimeHud)
     int GetCurrentDay() const;
     float GetTimeOfDay() const;  // Returns 0.0-1.0 (fraction of current day)
 
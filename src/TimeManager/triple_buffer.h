@@ -0,0 +1,57 @@
+#ifndef TRIPLE_BUFFER_H
+#define TRIPLE_BUFFER_H
+
+#include <atomic>
+#include <cstdint>
+#include <utility>
+
+// Latest-value handoff between one writer thread and one reader thread,
+// lock-free and wait-free on both sides.
+//
+// Three slots: the writer fills its back slot and swaps it with the
+// middle one; the reader, when the middle one is newer than what it holds,
+// swaps it for its front slot. Neither ever touches the slot the other is
+// using, so the writer never waits for a slow reader and the reader always
+// gets the newest complete value; values the reader never got to are
+// simply overwritten.
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() : middle(MIDDLE_START), back(BACK_START), front(FRONT_START) {}
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // Writer only: fill this, then Publish()
+    T& GetBack() { return slots[back]; }
+
+    // Writer only: hands the back slot to the reader
+    void Publish() {
+        back = middle.exchange(back | FRESH, std::memory_order_acq_rel) & INDEX;
+    }
+
+    // Reader only: takes the newest published value, if there is one the
+    // reader has not taken yet. True when front changed.
+    bool Update() {
+        if (!(middle.load(std::memory_order_relaxed) & FRESH)) return false;
+        front = middle.exchange(front, std::memory_order_acq_rel) & INDEX;
+        return true;
+    }
+
+    // Reader only: the value taken by the last Update()
+    T& GetFront() { return slots[front]; }
+
+private:
+    static constexpr uint8_t INDEX = 0x3;
+    static constexpr uint8_t FRESH = 0x4;   // set on the middle slot by Publish, cleared by Update
+    static constexpr uint8_t FRONT_START = 0;
+    static constexpr uint8_t MIDDLE_START = 1;
+    static constexpr uint8_t BACK_START = 2;
+
+    T slots[3];
+    std::atomic<uint8_t> middle;
+    uint8_t back;       // writer's
+    uint8_t front;      // reader's
+};
+
+#endif // TRIPLE_BUFFER_H
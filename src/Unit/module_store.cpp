@@ -0,0 +1,160 @@
+#include "module_store.h"
+#include "sect.h"
+#include "unit.h"
+#include <algorithm>
+#include <unordered_set>
+
+void ModuleStore::KindBatch::Clear() {
+    tier.clear();
+    efficiency.clear();
+    active.clear();
+    production.clear();
+    consumption.clear();
+    sect.clear();
+    owner.clear();
+}
+
+bool ModuleStore::IsStale(const std::vector<Sect*>& sects) const {
+    if (sects.size() != sectSlots.size()) return true;
+
+    for (size_t i = 0; i < sects.size(); i++) {
+        if (sectSlots[i].sect != sects[i] || sectSlots[i].unitCount != sects[i]->GetUnits().size()) {
+            return true;
+        }
+    }
+
+    for (const OwnerSlot& owner : owners) {
+        if (owner.unit->GetModuleRevision() != owner.revision) return true;
+    }
+    return false;
+}
+
+void ModuleStore::Rebuild(const std::vector<Sect*>& sects) {
+    std::vector<OwnerSlot> previous = std::move(owners);
+    for (KindBatch& batch : batches) {
+        batch.Clear();
+    }
+    sectSlots.clear();
+    owners.clear();
+
+    for (Sect* sect : sects) {
+        const int sectIndex = static_cast<int>(sectSlots.size());
+        sectSlots.push_back({sect, nullptr, nullptr, sect->GetUnits().size()});
+
+        for (Unit* unit : sect->GetUnits()) {
+            // Extraction production is the extraction pipeline, not a rate table
+            if (!unit || unit->GetType() == UnitType::Extraction) continue;
+
+            // Every unit of a sect shares the sect's storage
+            sectSlots[sectIndex].storage = &unit->resourceStorage;
+            sectSlots[sectIndex].capacity = &unit->storageCapacity;
+
+            // ProcessModuleEffects recomputes consumption every tick; the
+            // rates only change with a revision bump, so once here is enough
+            bool running = unit->IsActive() && !unit->activeModuleIndices.empty();
+            if (running) {
+                unit->CalculateConsumption();
+            }
+
+            const int ownerIndex = static_cast<int>(owners.size());
+            owners.push_back({unit, &unit->overflowBuffer, unit->GetModuleRevision(), sectIndex});
+            unit->modulesBatched = true;
+
+            for (size_t m = 0; m < unit->modules.size(); m++) {
+                const Unit::UnitModule& module = unit->modules[m];
+                KindBatch& batch = batches[static_cast<int>(module.kind)];
+
+                batch.tier.push_back(module.tier);
+                batch.efficiency.push_back(module.efficiency);
+                batch.active.push_back(running && unit->activeModuleIndices.count(static_cast<int>(m)) > 0);
+                batch.production.push_back(module.productionRates);
+                batch.consumption.push_back(module.consumptionRates);
+                batch.sect.push_back(sectIndex);
+                batch.owner.push_back(ownerIndex);
+            }
+        }
+    }
+
+    // Units left out now (their colony aggregated, see ColonyLod) get
+    // their own module step back, as Release gives it
+    if (!previous.empty()) {
+        std::unordered_set<const Unit*> kept;
+        for (const OwnerSlot& owner : owners) kept.insert(owner.unit);
+        for (OwnerSlot& owner : previous) {
+            if (kept.count(owner.unit) > 0) continue;
+            owner.unit->modulesBatched = false;
+            owner.unit->Wake();
+        }
+    }
+}
+
+void ModuleStore::Release() {
+    for (OwnerSlot& owner : owners) {
+        owner.unit->modulesBatched = false;
+        owner.unit->Wake();         // its module step is its own again
+    }
+    for (KindBatch& batch : batches) {
+        batch.Clear();
+    }
+    sectSlots.clear();
+    owners.clear();
+}
+
+int ModuleStore::GetModuleCount(ModuleKind kind) const {
+    return batches[static_cast<int>(kind)].Size();
+}
+
+void ModuleStore::Update(const std::vector<Sect*>& sects, float deltaTime) {
+    if (IsStale(sects)) {
+        Rebuild(sects);
+    }
+
+    for (KindBatch& batch : batches) {
+        RunKernel(batch, deltaTime);
+    }
+
+    for (OwnerSlot& owner : owners) {
+        if (owner.unit->FlushOverflow()) {
+            owner.unit->MarkChanged();
+            sectSlots[owner.sect].sect->MarkChanged();
+        }
+    }
+}
+
+// One kind's modules, in sect then unit order. The body is
+// Unit::ProcessModuleEffects for a single module.
+void ModuleStore::RunKernel(KindBatch& batch, float deltaTime) {
+    const int count = batch.Size();
+    for (int i = 0; i < count; i++) {
+        if (!batch.active[i]) continue;
+
+        const SectSlot& slot = sectSlots[batch.sect[i]];
+        ResourceVector& storage = *slot.storage;
+        const ResourceVector& consumption = batch.consumption[i];
+
+        // Availability-limited efficiency, floored at 50% when degraded
+        float efficiencyMultiplier = 1.0f;
+        for (const auto& [type, rate] : consumption) {
+            if (rate <= 0.0f) continue;
+
+            float required = rate * deltaTime;
+            float available = storage[type];
+            if (available < required) {
+                efficiencyMultiplier = std::min(efficiencyMultiplier, available / required);
+            }
+        }
+        if (efficiencyMultiplier < 1.0f && efficiencyMultiplier > 0.0f) {
+            efficiencyMultiplier = std::max(0.5f * efficiencyMultiplier + 0.5f * 1.0f, efficiencyMultiplier);
+        }
+        if (efficiencyMultiplier <= 0.0f) continue;
+
+        storage.Drain(consumption, deltaTime * efficiencyMultiplier);
+
+        // rate * deltaTime * efficiency, in the order AddResource got it
+        ResourceVector produced = batch.production[i] * deltaTime;
+        produced *= efficiencyMultiplier;
+        storage.Deposit(produced, *slot.capacity, *owners[batch.owner[i]].overflow);
+        slot.sect->MarkChanged();
+        owners[batch.owner[i]].unit->MarkChanged();
+    }
+}
@@ -0,0 +1,84 @@
+#ifndef MODULE_STORE_H
+#define MODULE_STORE_H
+
+#include "resource_vector.h"
+#include "game_enums.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+class Sect;
+class Unit;
+
+// Module state of every non-extraction unit, laid out as one set of
+// parallel arrays per ModuleKind, and the production/consumption step run
+// as one loop per kind across all sects.
+//
+// It replaces Unit::ProcessModuleEffects for those units (extraction units
+// keep their own path: their production is the extraction pipeline, not a
+// rate table). Per module the step is the same - availability-limited
+// efficiency, drain the consumption rates, deposit the production up to
+// capacity and buffer the rest - so sect storage ends up as the per-unit
+// loop leaves it. What differs is order: modules run grouped by kind
+// rather than unit by unit, and before the sect's extraction unit, so the
+// two only diverge when modules compete for a resource that runs short
+// within a tick.
+//
+// The store copies rates out of the units. Units bump a module revision
+// whenever rates or active state change; Update() rebuilds when any
+// revision, the sect list or a sect's unit list has moved on. Sects and
+// units whose state it writes are marked changed, as their own update
+// would have.
+class ModuleStore {
+public:
+    // Rebuilds if stale, runs every kind's kernel, then flushes the
+    // batched units' overflow buffers. Units covered here skip their own
+    // module step in Unit::Update.
+    void Update(const std::vector<Sect*>& sects, float deltaTime);
+
+    void Rebuild(const std::vector<Sect*>& sects);
+    bool IsStale(const std::vector<Sect*>& sects) const;
+
+    // Hands the units back to Unit::Update's own module step
+    void Release();
+
+    int GetModuleCount(ModuleKind kind) const;
+    int GetUnitCount() const { return static_cast<int>(owners.size()); }
+
+private:
+    // One kind's modules, one element per module in every column
+    struct KindBatch {
+        std::vector<int> tier;
+        std::vector<float> efficiency;
+        std::vector<uint8_t> active;                  // module active and its unit running
+        std::vector<ResourceVector> production;
+        std::vector<ResourceVector> consumption;
+        std::vector<int> sect;                        // index into sectSlots
+        std::vector<int> owner;                       // index into owners
+
+        void Clear();
+        int Size() const { return static_cast<int>(tier.size()); }
+    };
+
+    struct SectSlot {
+        Sect* sect;
+        ResourceVector* storage;
+        ResourceVector* capacity;
+        size_t unitCount;
+    };
+
+    struct OwnerSlot {
+        Unit* unit;
+        ResourceVector* overflow;
+        uint32_t revision;
+        int sect;                                     // index into sectSlots
+    };
+
+    void RunKernel(KindBatch& batch, float deltaTime);
+
+    std::array<KindBatch, MODULE_KIND_COUNT> batches;
+    std::vector<SectSlot> sectSlots;
+    std::vector<OwnerSlot> owners;
+};
+
+#endif // MODULE_STORE_H
@@ -2,9 +2,8 @@
 #define SEPARATION_NODE_H
 
 #include <string>
-#include <map>
 #include <vector>
-#include "resource_types.h"
+#include "resource_vector.h"
 
 // Types of separation processes
 enum class SeparationNodeType {
@@ -27,37 +26,24 @@ struct SeparationNode {
     bool isActive = true;
 
     // Input: what this node accepts (resource type -> fraction consumed)
-    std::map<ResourceType, float> inputRatios;
+    ResourceVector inputRatios;
 
     // Output: what this node produces (resource type -> yield fraction)
-    std::map<ResourceType, float> outputRatios;
+    ResourceVector outputRatios;
 
     // Waste output
     float wasteRatio = 0.0f;       // Fraction lost to waste
 
-    // Process input regolith and return outputs
-    std::map<ResourceType, float> Process(const std::map<ResourceType, float>& input, float deltaTime) const
+    // Process input regolith and return outputs. Every output draws on the
+    // same weighted input total, so that's one dot product and one scale.
+    ResourceVector Process(const ResourceVector& input, float deltaTime) const
     {
-        std::map<ResourceType, float> output;
-
-        if (!isActive) return output;
+        if (!isActive) return ResourceVector();
 
         float effectiveEfficiency = efficiency * (1.0f - wear * 0.5f);
+        float totalInput = input.Dot(inputRatios);
 
-        for (const auto& [outType, ratio] : outputRatios)
-        {
-            float totalInput = 0.0f;
-            for (const auto& [inType, inAmount] : input)
-            {
-                if (inputRatios.count(inType) > 0)
-                {
-                    totalInput += inAmount * inputRatios.at(inType);
-                }
-            }
-            output[outType] = totalInput * ratio * effectiveEfficiency * deltaTime;
-        }
-
-        return output;
+        return outputRatios * (totalInput * effectiveEfficiency * deltaTime);
     }
 };
 
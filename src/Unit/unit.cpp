@@ -1,13 +1,142 @@
 #include "unit.h"
 #include "unlock_registry.h"
+#include "balance_params.h"
+#include "sim_log.h"
+#include "byte_stream.h"
 #include <iostream>
 #include <cmath>
+#include <cstdarg>
+#include <cstdio>
+#include <limits>
+
+namespace {
+    // printf-style text for ShowMessage. Stands in for raylib's TextFormat
+    // so the simulation doesn't need raylib at link time.
+    std::string FormatMessage(const char* fmt, ...)
+    {
+        char buffer[256];
+        va_list args;
+        va_start(args, fmt);
+        vsnprintf(buffer, sizeof(buffer), fmt, args);
+        va_end(args);
+        return buffer;
+    }
+
+    void WriteNamedValues(ByteWriter& out, const std::map<std::string, float>& values)
+    {
+        out.WriteCount(values.size());
+        for (const auto& [name, value] : values) {
+            out.WriteString(name);
+            out.Write<float>(value);
+        }
+    }
+
+    std::map<std::string, float> ReadNamedValues(ByteReader& in)
+    {
+        std::map<std::string, float> values;
+        size_t count = in.ReadCount(8);
+        for (size_t i = 0; i < count; i++) {
+            std::string name = in.ReadString();
+            values[name] = in.Read<float>();
+        }
+        return values;
+    }
+
+    void WriteModule(ByteWriter& out, const Unit::UnitModule& module)
+    {
+        out.WriteString(module.name);
+        out.WriteEnum(module.kind);
+        out.Write<int32_t>(module.level);
+        out.Write<int32_t>(module.tier);
+        out.WriteBool(module.isBuilt);
+        out.WriteBool(module.isActive);
+        out.Write<float>(module.efficiency);
+        out.Write<float>(module.energyRequired);
+        out.WriteString(module.description);
+        out.WriteCount(module.tierDependencies.size());
+        for (const std::string& tech : module.tierDependencies) out.WriteString(tech);
+        out.WriteResources(module.consumptionRates);
+        out.WriteResources(module.productionRates);
+        out.WriteResources(module.maxProductionRates);
+
+        out.WriteCount(module.upgradeCosts.size());
+        for (const auto& [level, costs] : module.upgradeCosts) {
+            out.Write<int32_t>(level);
+            out.WriteResourceMap(costs);
+        }
+        out.WriteCount(module.enhancements.size());
+        for (const auto& [level, values] : module.enhancements) {
+            out.Write<int32_t>(level);
+            WriteNamedValues(out, values);
+        }
+    }
+
+    void ReadModule(ByteReader& in, Unit::UnitModule& module)
+    {
+        module.name = in.ReadString();
+        module.kind = in.ReadEnum(static_cast<ModuleKind>(MODULE_KIND_COUNT - 1));
+        module.level = in.Read<int32_t>();
+        module.tier = in.Read<int32_t>();
+        module.isBuilt = in.ReadBool();
+        module.isActive = in.ReadBool();
+        module.efficiency = in.Read<float>();
+        module.energyRequired = in.Read<float>();
+        module.description = in.ReadString();
+        module.tierDependencies.resize(in.ReadCount(4));
+        for (std::string& tech : module.tierDependencies) tech = in.ReadString();
+        module.consumptionRates = in.ReadResources();
+        module.productionRates = in.ReadResources();
+        module.maxProductionRates = in.ReadResources();
+
+        module.upgradeCosts.clear();
+        size_t costLevels = in.ReadCount(8);
+        for (size_t i = 0; i < costLevels; i++) {
+            int level = in.Read<int32_t>();
+            module.upgradeCosts[level] = in.ReadResourceMap<float>();
+        }
+        module.enhancements.clear();
+        size_t enhancementLevels = in.ReadCount(8);
+        for (size_t i = 0; i < enhancementLevels; i++) {
+            int level = in.Read<int32_t>();
+            module.enhancements[level] = ReadNamedValues(in);
+        }
+    }
+
+    void WriteSeparationNode(ByteWriter& out, const SeparationNode& node)
+    {
+        out.WriteEnum(node.type);
+        out.WriteString(node.name);
+        out.Write<float>(node.efficiency);
+        out.Write<float>(node.wear);
+        out.Write<float>(node.energyConsumption);
+        out.Write<float>(node.temperature);
+        out.WriteBool(node.isActive);
+        out.WriteResources(node.inputRatios);
+        out.WriteResources(node.outputRatios);
+        out.Write<float>(node.wasteRatio);
+    }
+
+    void ReadSeparationNode(ByteReader& in, SeparationNode& node)
+    {
+        node.type = in.ReadEnum(SeparationNodeType::DIRECT_OUTPUT);
+        node.name = in.ReadString();
+        node.efficiency = in.Read<float>();
+        node.wear = in.Read<float>();
+        node.energyConsumption = in.Read<float>();
+        node.temperature = in.Read<float>();
+        node.isActive = in.ReadBool();
+        node.inputRatios = in.ReadResources();
+        node.outputRatios = in.ReadResources();
+        node.wasteRatio = in.Read<float>();
+    }
+}
 
 Unit::Unit(std::string type, Vector2 &position, ResourceManager &resource,
-           TimeManager &time, std::map<ResourceType, float> &storage,
-           std::map<ResourceType, float> &capacity) :
+           TimeManager &time, ResourceVector &storage,
+           ResourceVector &capacity) :
     unit_type(type),
-    status("inactive"),
+    unitKind(UnitType::Construction),
+    status(UnitStatus::INACTIVE),
     energy_cost(0),
     isUnderConstruction(false),
     productionCycleTime(0),
@@ -22,11 +151,17 @@ Unit::Unit(std::string type, Vector2 &position, ResourceManager &resource,
     lastClickedModule(-1),
     showingStats(false)
 {
+    if (!UnitTypeFromString(unit_type, unitKind))
+    {
+        COLONY_LOG_INFO(Unit, "[Unit] Unknown unit type '" << unit_type << "', using generic modules");
+    }
+
     SetInitialParameters();
+    BindTickParameters();
     InitializeModules();
     InitializeStorage();
 
-    if (unit_type == "Extraction")
+    if (unitKind == UnitType::Extraction)
     {
         Vector2 gp = GetGridPosition();
         int gx = static_cast<int>(gp.x);
@@ -34,7 +169,7 @@ Unit::Unit(std::string type, Vector2 &position, ResourceManager &resource,
         int prosTier = 0;
         for (const auto& m : modules)
         {
-            if (m.moduleType == "PROSPECTING")
+            if (m.kind == ModuleKind::PROSPECTING)
             {
                 prosTier = m.tier;
                 break;
@@ -52,14 +187,16 @@ Unit::~Unit() {
 void Unit::Start() {
     // Only start if we have an active module
 
-        status = "active";
-        std::cout << "Unit " << unit_type << " started." << std::endl;
+        status = UnitStatus::ACTIVE;
+        ModulesChanged();
+        COLONY_LOG_INFO(Unit, "Unit " << unit_type << " started.");
 
 }
 
 void Unit::Stop() {
-    status = "inactive";
-    std::cout << "Unit " << unit_type << " stopped." << std::endl;
+    status = UnitStatus::INACTIVE;
+    ModulesChanged();
+    COLONY_LOG_INFO(Unit, "Unit " << unit_type << " stopped.");
 }
 
 void Unit::UpdateUnitStatus() {
@@ -73,26 +210,29 @@ void Unit::UpdateUnitStatus() {
     }
 
     // Update unit status based on module state
-    status = !activeModuleIndices.empty() ? "active" : "inactive";
+    status = !activeModuleIndices.empty() ? UnitStatus::ACTIVE : UnitStatus::INACTIVE;
+    ModulesChanged();
 }
 
 void Unit::Upgrade(int level) {
     // TODO: Implement upgrade logic
-    std::cout << "Unit " << unit_type << " upgraded to level " << level << std::endl;
+    COLONY_LOG_INFO(Unit, "Unit " << unit_type << " upgraded to level " << level);
 }
 
 void Unit::CalculateConsumption() {
     if (activeModuleIndices.empty()) {
-        std::cout << "No active modules, skipping consumption calculation" << std::endl;
+        COLONY_LOG_DEBUG(Unit, "No active modules, skipping consumption calculation");
         return;
     }
 
+    ModulesChanged();
+
     // Calculate consumption for each active module
     for (int moduleIndex : activeModuleIndices) {
         UnitModule& module = modules[moduleIndex];
 
         // Clear existing consumption rates for this module
-        module.consumptionRates.clear();
+        module.consumptionRates.Clear();
 
         // For each production rate in this module
         for (const auto& [producedResource, productionRate] : module.productionRates) {
@@ -118,22 +258,33 @@ void Unit::CalculateConsumption() {
 
 std::map<std::string, float> Unit::CalculateProduction() const {
     // TODO: Implement production calculation
-    std::cout << "Unit " << unit_type << " production calculated." << std::endl;
+    COLONY_LOG_INFO(Unit, "Unit " << unit_type << " production calculated.");
     return production;
 }
 
 void Unit::DisplayStats() const {
-    std::cout << "Unit Type: " << unit_type << ", Status: " << status << std::endl;
+    COLONY_LOG_INFO(Unit, "Unit Type: " << unit_type << ", Status: " << UnitStatusToString(status));
     for (const auto& param : parameters) {
-        std::cout << param.first << ": " << param.second << std::endl;
+        COLONY_LOG_INFO(Unit, param.first << ": " << param.second);
     }
+    // The tick updates these in place; `parameters` holds the starting values
+    COLONY_LOG_INFO(Unit, "Current Efficiency: " << tick.efficiency
+              << ", Fertility: " << tick.fertilityLevel
+              << ", Construction: " << tick.constructionProgress << "/" << tick.buildTime);
 }
 
 void Unit::Update(float deltaTime) {
-    ProcessModuleEffects(deltaTime, resourceManager);
+    stateRevision++;
 
-    // Update sweep engine calibration
-    if (prospectingSystem && prospectingSystem->GetSweep().IsCalibrating())
+    // Batched units have their modules run (and overflow flushed) by ModuleStore
+    if (!modulesBatched) {
+        ProcessModuleEffects(deltaTime, resourceManager);
+    }
+
+    // Update sweep engine calibration. Asked through the const view, as
+    // mutable access drops the survey progress cache.
+    const ProspectingSystem* prospecting = prospectingSystem.get();
+    if (prospecting && prospecting->GetSweep().IsCalibrating())
     {
         prospectingSystem->GetSweep().UpdateCalibration(deltaTime);
     }
@@ -148,77 +299,152 @@ void Unit::Update(float deltaTime) {
         }
     }
 
-    // Flush overflow buffer into sect storage
-    for (auto& [type, buffered] : overflowBuffer)
-    {
-        if (buffered <= 0.0f) continue;
+    if (!modulesBatched) {
+        FlushOverflow();
+    }
+}
 
-        auto capacityIt = storageCapacity.find(type);
-        if (capacityIt == storageCapacity.end()) continue;
+bool Unit::HasWork() const {
+    // Module step (batched units have theirs run by the ModuleStore)
+    if (!modulesBatched && IsActive() && !activeModuleIndices.empty()) return true;
 
-        float available = capacityIt->second - resourceStorage[type];
-        if (available > 0.0f)
-        {
-            float transfer = std::min(buffered, available);
-            resourceStorage[type] += transfer;
-            buffered -= transfer;
+    const ProspectingSystem* prospecting = GetProspectingSystem();
+    if (prospecting && prospecting->GetSweep().IsCalibrating()) return true;
+
+    // Wear creeps up to 1 on running excavators (and is clamped back if a
+    // directive pushed it past)
+    for (const auto& exc : excavators) {
+        if (exc.rate > 0.0f && exc.wear != 1.0f) return true;
+    }
+
+    // Buffered production still to flush
+    if (!modulesBatched) {
+        for (const auto& [type, buffered] : overflowBuffer) {
+            if (buffered > 0.0f && storageCapacity.Has(type)) return true;
         }
+    }
+    return false;
+}
 
-        // Cap overflow buffer to prevent unbounded growth
-        const float OVERFLOW_BUFFER_CAP = 200.0f;
-        if (buffered > OVERFLOW_BUFFER_CAP)
-        {
-            buffered = OVERFLOW_BUFFER_CAP;
+void Unit::ReadLanes(float deltaTime, std::vector<SteadyLane>& lanes, bool everyBuffer) const {
+    const float inf = std::numeric_limits<float>::infinity();
+
+    // The buffers that get a lane, named by the first; it holds only at
+    // its value, so a new buffer ends the rates
+    uint32_t held = everyBuffer ? (1u << RESOURCE_TYPE_COUNT) - 1 : overflowBuffer.GetMask();
+    float heldLane = static_cast<float>(held);
+    lanes.push_back({heldLane, heldLane, std::nextafter(heldLane, inf)});
+
+    // Flushing stops once a buffer runs dry; a full one drops the rest.
+    // A step buffers production before it flushes.
+    if (held != 0) {
+        ResourceVector consumption;
+        ResourceVector production;
+        AddRunningRates(consumption, production);
+        for (int i = 0; i < RESOURCE_TYPE_COUNT; i++) {
+            if ((held & (1u << i)) == 0) continue;
+            ResourceType type = static_cast<ResourceType>(i);
+            float buffered = overflowBuffer.Get(type);
+            float reach = production.Get(type) * deltaTime;
+            if (buffered < OVERFLOW_BUFFER_CAP) {
+                lanes.push_back({buffered, 0.0f, OVERFLOW_BUFFER_CAP, reach});
+            } else {
+                lanes.push_back({buffered, OVERFLOW_BUFFER_CAP, inf, reach});
+            }
         }
     }
+
+    // A worn-out excavator stops counting towards extraction
+    for (const auto& exc : excavators) {
+        lanes.push_back({exc.wear, -inf, exc.wear < 1.0f ? 1.0f : inf});
+    }
+
+    if (prospectingSystem) {
+        const SweepEngine& sweep = GetProspectingSystem()->GetSweep();
+        if (sweep.IsCalibrating()) {
+            // Calibration ends as the timer reaches 0, not after it
+            lanes.push_back({sweep.GetCalibrationTimeLeft(), std::numeric_limits<float>::min(), inf});
+        } else {
+            lanes.push_back({0.0f, -inf, inf});
+        }
+    }
+
+    lanes.push_back({totalRegolithExtracted, -inf, inf});
 }
 
-void Unit::DrawInSectView(Vector2 corePosition, float coreRadius, int index) {
-    float angle = (index * 45.0f) * DEG2RAD;  // 8 units evenly spaced (360/8 = 45 degrees)
-    float radius = coreRadius * 1.2f;  // Distance from the core
+size_t Unit::WriteLanes(const std::vector<SteadyLane>& lanes, size_t at) {
+    uint32_t held = static_cast<uint32_t>(lanes[at++].value);
+    for (int i = 0; i < RESOURCE_TYPE_COUNT; i++) {
+        if ((held & (1u << i)) == 0) continue;
+        ResourceType type = static_cast<ResourceType>(i);
+        float value = lanes[at++].value;
+        if (overflowBuffer.Has(type) || value != 0.0f) {
+            overflowBuffer[type] = value;
+        }
+    }
 
-    Vector2 unitPosition = {
-        corePosition.x + radius * cosf(angle),
-        corePosition.y + radius * sinf(angle)
-    };
+    for (auto& exc : excavators) {
+        exc.wear = lanes[at++].value;
+    }
+
+    if (prospectingSystem) {
+        const ProspectingSystem* prospecting = prospectingSystem.get();
+        const SweepEngine& sweep = prospecting->GetSweep();
+        float timeLeft = lanes[at++].value;
+        if (sweep.IsCalibrating()) {
+            prospectingSystem->GetSweep().UpdateCalibration(sweep.GetCalibrationTimeLeft() - timeLeft);
+        }
+    }
 
-    // Draw the unit circle
-    bool isBuilt = (status == "active");
-    float unitRadius = 30;
-    DrawCircleV(unitPosition, unitRadius, isBuilt ? BLUE : BLANK);
-    DrawCircleLines(unitPosition.x, unitPosition.y, unitRadius, GREEN);
+    totalRegolithExtracted = lanes[at++].value;
+    stateRevision++;
+    return at;
 }
 
-void Unit::DrawInUnitView() {
-    const int screenWidth = GetScreenWidth();
-    const int screenHeight = GetScreenHeight();
+void Unit::AddRunningRates(ResourceVector& consumption, ResourceVector& production) const {
+    if (!IsActive()) return;
 
-    // Draw main background
-    DrawRectangle(0, 0, screenWidth, screenHeight, RAYWHITE);
+    for (int moduleIndex : activeModuleIndices) {
+        consumption += modules[moduleIndex].consumptionRates;
+        production += modules[moduleIndex].productionRates;
+    }
+}
 
-    // Draw UI sections
-    DrawTopBar();
-    DrawBottomBar();
+bool Unit::HasClockDependentRates() const {
+    return unitKind == UnitType::Extraction && IsActive() &&
+           activeDirective.type == DirectiveType::THERMAL_SYNC;
+}
 
-    // Draw three-panel layout
-    if (isInModuleView) {
-        DrawModuleList();
-        DrawModuleDetails();
-        DrawControlPanel();
+// Moves buffered production into sect storage as space frees up
+bool Unit::FlushOverflow() {
+    bool changed = false;
+    for (auto [type, buffered] : overflowBuffer)
+    {
+        if (buffered <= 0.0f) continue;
 
+        if (!storageCapacity.Has(type)) continue;
 
-    } else {
-        DrawModuleList();
-        DrawResourcePanel();
-        DrawControlPanel();
+        float available = storageCapacity.Get(type) - resourceStorage[type];
+        if (available > 0.0f)
+        {
+            float transfer = std::min(buffered, available);
+            resourceStorage[type] += transfer;
+            buffered -= transfer;
+            changed = true;
+        }
 
+        // Cap overflow buffer to prevent unbounded growth
+        if (buffered > OVERFLOW_BUFFER_CAP)
+        {
+            buffered = OVERFLOW_BUFFER_CAP;
+            changed = true;
+        }
     }
-
-    UpdateMessage(GetFrameTime());
+    return changed;
 }
 
 void Unit::SetInitialParameters() {
-    if (unit_type == "Extraction") {
+    if (unitKind == UnitType::Extraction) {
         parameters["H2ExtractionRate"] = DEFAULT_H2ExtractionRate;
         parameters["O2ExtractionRate"] = DEFAULT_O2ExtractionRate;
         parameters["CExtractionRate"] = DEFAULT_CExtractionRate;
@@ -230,7 +456,7 @@ void Unit::SetInitialParameters() {
         parameters["Efficiency"] = DEFAULT_Efficiency;
         parameters["StorageCapacity"] = DEFAULT_StorageCapacity;
         parameters["BreakdownChance"] = DEFAULT_BreakdownChance;
-    } else if (unit_type == "Farming") {
+    } else if (unitKind == UnitType::Farming) {
         parameters["FoodProductionRate"] = 10;
         parameters["WaterConsumption"] = 3;
         parameters["EnergyConsumption"] = 2;
@@ -238,7 +464,7 @@ void Unit::SetInitialParameters() {
         parameters["StorageCapacity"] = 200;
         parameters["GrowthBoost"] = 1.1;
         parameters["CropFocus"] = 1; // 1 could represent "Grain"
-    } else if (unit_type == "Energy") {
+    } else if (unitKind == UnitType::Energy) {
         parameters["EnergyOutput"] = 15;
         parameters["EnergySource"] = 1; // 1 could represent "Solar"
         parameters["StorageCapacity"] = 500;
@@ -246,7 +472,7 @@ void Unit::SetInitialParameters() {
         parameters["FuelConsumption"] = 2;
         parameters["WeatherImpact"] = -0.2;
         parameters["MaintenanceCost"] = 0.1; // 1 Fe per 10 minutes
-    } else if (unit_type == "Manufacture") {
+    } else if (unitKind == UnitType::Manufacture) {
         parameters["ProductionRate"] = 1;
         parameters["BlueprintsUnlocked"] = 1; // 1 could represent "Tools"
         parameters["EnergyConsumption"] = 5;
@@ -254,14 +480,14 @@ void Unit::SetInitialParameters() {
         parameters["ProductStorage"] = 100;
         parameters["ProductionEfficiency"] = 0.85;
         parameters["UpgradeEffect"] = 0.1;
-    } else if (unit_type == "Construction") {
+    } else if (unitKind == UnitType::Construction) {
         parameters["BuildSpeed"] = 0.2; // 1 structure per 5 minutes
         parameters["RepairEfficiency"] = 0.9;
         parameters["EnergyConsumption"] = 4;
         parameters["MaterialConsumption"] = 5;
         parameters["MaintenanceCost"] = 0.2; // 2 Fe per 10 minutes
         parameters["ConstructionRange"] = 2;
-    } else if (unit_type == "Transport") {
+    } else if (unitKind == UnitType::Transport) {
         parameters["TransportCapacity"] = 50;
         parameters["Speed"] = 10;
         parameters["EnergyConsumption"] = 5;
@@ -269,7 +495,7 @@ void Unit::SetInitialParameters() {
         parameters["Efficiency"] = 0.8;
         parameters["RoadConstructionSpeed"] = 1.0/24; // 1 km per day
         parameters["UpgradeEffect"] = 0.1;
-    } else if (unit_type == "Research") {
+    } else if (unitKind == UnitType::Research) {
         parameters["ResearchPointsPerTick"] = 5;
         parameters["EnergyConsumption"] = 10;
         parameters["RareMetalConsumption"] = 1;
@@ -277,7 +503,7 @@ void Unit::SetInitialParameters() {
         parameters["ResearchSpeedMultiplier"] = 1.0;
         parameters["BreakthroughChance"] = 0.05;
         parameters["UpgradeEffect"] = 0.2;
-    } else if (unit_type == "Communication") {
+    } else if (unitKind == UnitType::Commerce) {
         parameters["TradeCapacity"] = 100;
         parameters["ExchangeRate"] = 1;
         parameters["EnergyConsumption"] = 3;
@@ -287,15 +513,44 @@ void Unit::SetInitialParameters() {
     }
 }
 
+void Unit::BindTickParameters() {
+    auto get = [this](const char* name) {
+        auto it = parameters.find(name);
+        return it != parameters.end() ? it->second : 0.0f;
+    };
+
+    tick = TickParameters();
+    if (unitKind == UnitType::Extraction) {
+        tick.extractionRates = {
+            {ResourceType::H2, get("H2ExtractionRate")},
+            {ResourceType::O2, get("O2ExtractionRate")},
+            {ResourceType::C,  get("CExtractionRate")},
+            {ResourceType::Fe, get("FeExtractionRate")},
+            {ResourceType::Si, get("SiExtractionRate")}
+        };
+    }
+    tick.efficiency = get("Efficiency");
+    tick.foodProductionRate = get("FoodProductionRate");
+    tick.fertilityLevel = get("FertilityLevel");
+    tick.growthBoost = get("GrowthBoost");
+    tick.waterConsumption = get("WaterConsumption");
+    tick.energyOutput = get("EnergyOutput");
+    tick.weatherImpact = get("WeatherImpact");
+    tick.fuelConsumption = get("FuelConsumption");
+    tick.maintenanceCost = get("MaintenanceCost");
+    tick.buildTime = get("BuildTime");
+    tick.constructionProgress = get("ConstructionProgress");
+}
+
 
 void Unit::ProcessFarming(float deltaTime) {
     if (!IsActive()) return;
 
     // Get relevant parameters
-    float productionRate = parameters["FoodProductionRate"];
-    float fertility = parameters["FertilityLevel"];
-    float growthBoost = parameters["GrowthBoost"];
-    float waterConsumption = parameters["WaterConsumption"];
+    float productionRate = tick.foodProductionRate;
+    float fertility = tick.fertilityLevel;
+    float growthBoost = tick.growthBoost;
+    float waterConsumption = tick.waterConsumption;
 
     // Calculate water needed and check availability (graceful degradation)
     float waterNeeded = waterConsumption * deltaTime;
@@ -321,17 +576,17 @@ void Unit::ProcessFarming(float deltaTime) {
     AddResource(ResourceType::FOOD, foodProduced);
 
     // Reduce fertility over time (soil degradation)
-    parameters["FertilityLevel"] = std::max(0.2f, fertility - (0.01f * deltaTime));
+    tick.fertilityLevel = std::max(0.2f, fertility - (0.01f * deltaTime));
 }
 
 void Unit::ProcessEnergy(float deltaTime) {
     if (!IsActive()) return;
 
     // Get relevant parameters
-    float energyOutput = parameters["EnergyOutput"];
-    float efficiency = parameters["Efficiency"];
-    float weatherImpact = parameters["WeatherImpact"];
-    float fuelConsumption = parameters["FuelConsumption"];
+    float energyOutput = tick.energyOutput;
+    float efficiency = tick.efficiency;
+    float weatherImpact = tick.weatherImpact;
+    float fuelConsumption = tick.fuelConsumption;
 
     // Check fuel availability (graceful degradation)
     float efficiencyMultiplier = 1.0f;
@@ -360,60 +615,55 @@ void Unit::ProcessEnergy(float deltaTime) {
     AddResource(ResourceType::ENERGY, energyProduced);
 
     // Apply maintenance degradation
-    float maintenanceCost = parameters["MaintenanceCost"];
-    parameters["Efficiency"] = std::max(0.2f, efficiency - (maintenanceCost * deltaTime));
+    tick.efficiency = std::max(0.2f, efficiency - (tick.maintenanceCost * deltaTime));
 }
 
 void Unit::UpdateConstruction(float deltaTime) {
     if (!IsUnderConstruction()) return;
 
-    float buildTime = parameters["BuildTime"];
-    float currentProgress = parameters["ConstructionProgress"];
-
     // Update construction progress
-    currentProgress += deltaTime;
-    parameters["ConstructionProgress"] = currentProgress;
+    tick.constructionProgress += deltaTime;
 
     // Check if construction is complete
-    if (currentProgress >= buildTime) {
+    if (tick.constructionProgress >= tick.buildTime) {
         OnConstructionComplete();
     }
 }
 
 void Unit::OnConstructionComplete() {
-    SetStatus("active");
-    parameters["ConstructionProgress"] = parameters["BuildTime"];
+    SetStatus(UnitStatus::ACTIVE);
+    tick.constructionProgress = tick.buildTime;
 
     // Initialize operational parameters based on unit type
-    if (unit_type == "Extraction") {
-        parameters["Efficiency"] = 0.8f;  // Start at 80% efficiency
-    } else if (unit_type == "Farming") {
-        parameters["FertilityLevel"] = 0.75f;  // Start with 75% fertility
-    } else if (unit_type == "Energy") {
-        parameters["Efficiency"] = 0.9f;  // Start at 90% efficiency
+    if (unitKind == UnitType::Extraction) {
+        tick.efficiency = 0.8f;  // Start at 80% efficiency
+    } else if (unitKind == UnitType::Farming) {
+        tick.fertilityLevel = 0.75f;  // Start with 75% fertility
+    } else if (unitKind == UnitType::Energy) {
+        tick.efficiency = 0.9f;  // Start at 90% efficiency
     }
 
-    std::cout << "Construction complete for " << unit_type << " unit!" << std::endl;
+    COLONY_LOG_INFO(Unit, "Construction complete for " << unit_type << " unit!");
 }
 
 void Unit::InitializeModules() {
-    if (unit_type == "Extraction")
+    if (unitKind == UnitType::Extraction)
     {
         InitializeExtractionModules();
     }
-    else if (unit_type == "Farming")
+    else if (unitKind == UnitType::Farming)
     {
         InitializeFarmingModules();
     }
-    else if (unit_type == "Energy")
+    else if (unitKind == UnitType::Energy)
     {
         InitializeEnergyModules();
     }
-    else if (unit_type == "Manufacture")
+    else if (unitKind == UnitType::Manufacture)
     {
         InitializeManufactureModules();
     }
-    else if (unit_type == "Research")
+    else if (unitKind == UnitType::Research)
     {
         InitializeResearchModules();
     }
@@ -450,7 +700,7 @@ void Unit::InitializeExtractionModules() {
     {
         UnitModule mod;
         mod.name = "Prospecting";
-        mod.moduleType = "PROSPECTING";
+        mod.kind = ModuleKind::PROSPECTING;
         mod.tier = 0;
         mod.level = 1;
         mod.isBuilt = true;
@@ -468,7 +718,7 @@ void Unit::InitializeExtractionModules() {
     {
         UnitModule mod;
         mod.name = "Excavation";
-        mod.moduleType = "EXCAVATION";
+        mod.kind = ModuleKind::EXCAVATION;
         mod.tier = 0;
         mod.level = 1;
         mod.isBuilt = true;
@@ -493,7 +743,7 @@ void Unit::InitializeExtractionModules() {
     {
         UnitModule mod;
         mod.name = "Beneficiation";
-        mod.moduleType = "BENEFICIATION";
+        mod.kind = ModuleKind::BENEFICIATION;
         mod.tier = 0;
         mod.level = 1;
         mod.isBuilt = true;
@@ -514,7 +764,7 @@ void Unit::InitializeExtractionModules() {
     {
         UnitModule mod;
         mod.name = "Operations";
-        mod.moduleType = "OPERATIONS";
+        mod.kind = ModuleKind::OPERATIONS;
         mod.tier = 0;
         mod.level = 1;
         mod.isBuilt = false;  // Requires tier 1 unlock
@@ -530,7 +780,7 @@ void Unit::InitializeExtractionModules() {
     {
         UnitModule mod;
         mod.name = "Directives";
-        mod.moduleType = "DIRECTIVES";
+        mod.kind = ModuleKind::DIRECTIVES;
         mod.tier = 0;
         mod.level = 1;
         mod.isBuilt = false;  // Requires tier 1 unlock
@@ -548,20 +798,20 @@ void Unit::InitializeExtractionModules() {
 void Unit::InitializeFarmingModules() {
     productionCosts = FARMING_PRODUCTION_COSTS;
 
-    struct ModuleInfo { std::string name; std::string type; std::string desc; };
+    struct ModuleInfo { std::string name; ModuleKind kind; std::string desc; };
     std::vector<ModuleInfo> farmModules = {
-        {"Irrigation", "IRRIGATION", "Water distribution and soil management."},
-        {"Greenhouse", "GREENHOUSE", "Controlled environment agriculture."},
-        {"Hydroponics", "HYDROPONICS", "Water-based soilless cultivation."},
-        {"Harvest", "HARVEST", "Automated crop collection and processing."},
-        {"Storage", "STORAGE", "Cold storage and preservation systems."}
+        {"Irrigation", ModuleKind::IRRIGATION, "Water distribution and soil management."},
+        {"Greenhouse", ModuleKind::GREENHOUSE, "Controlled environment agriculture."},
+        {"Hydroponics", ModuleKind::HYDROPONICS, "Water-based soilless cultivation."},
+        {"Harvest", ModuleKind::HARVEST, "Automated crop collection and processing."},
+        {"Storage", ModuleKind::STORAGE, "Cold storage and preservation systems."}
     };
 
     for (size_t i = 0; i < farmModules.size(); i++)
     {
         UnitModule mod;
         mod.name = farmModules[i].name;
-        mod.moduleType = farmModules[i].type;
+        mod.kind = farmModules[i].kind;
         mod.tier = 0;
         mod.level = 1;
         mod.isBuilt = (i < 3);   // First 3 built
@@ -586,20 +836,20 @@ void Unit::InitializeFarmingModules() {
 }
 
 void Unit::InitializeEnergyModules() {
-    struct ModuleInfo { std::string name; std::string type; std::string desc; };
+    struct ModuleInfo { std::string name; ModuleKind kind; std::string desc; };
     std::vector<ModuleInfo> energyModules = {
-        {"Solar Array", "SOLAR_ARRAY", "Photovoltaic energy generation."},
-        {"Battery", "BATTERY", "Energy storage systems."},
-        {"Nuclear", "NUCLEAR", "Nuclear fission power generation."},
-        {"Grid", "GRID", "Power distribution network."},
-        {"Emergency", "EMERGENCY", "Backup power and emergency systems."}
+        {"Solar Array", ModuleKind::SOLAR_ARRAY, "Photovoltaic energy generation."},
+        {"Battery", ModuleKind::BATTERY, "Energy storage systems."},
+        {"Nuclear", ModuleKind::NUCLEAR, "Nuclear fission power generation."},
+        {"Grid", ModuleKind::GRID, "Power distribution network."},
+        {"Emergency", ModuleKind::EMERGENCY, "Backup power and emergency systems."}
     };
 
     for (size_t i = 0; i < energyModules.size(); i++)
     {
         UnitModule mod;
         mod.name = energyModules[i].name;
-        mod.moduleType = energyModules[i].type;
+        mod.kind = energyModules[i].kind;
         mod.tier = 0;
         mod.level = 1;
         mod.isBuilt = (i < 3);
@@ -620,20 +870,20 @@ void Unit::InitializeEnergyModules() {
 }
 
 void Unit::InitializeManufactureModules() {
-    struct ModuleInfo { std::string name; std::string type; std::string desc; };
+    struct ModuleInfo { std::string name; ModuleKind kind; std::string desc; };
     std::vector<ModuleInfo> mfgModules = {
-        {"Fabrication", "FABRICATION", "Raw material processing and shaping."},
-        {"Assembly", "ASSEMBLY", "Component assembly line."},
-        {"Quality", "QUALITY", "Quality control and testing."},
-        {"Logistics", "LOGISTICS", "Material handling and routing."},
-        {"Automation", "AUTOMATION", "Automated production control."}
+        {"Fabrication", ModuleKind::FABRICATION, "Raw material processing and shaping."},
+        {"Assembly", ModuleKind::ASSEMBLY, "Component assembly line."},
+        {"Quality", ModuleKind::QUALITY, "Quality control and testing."},
+        {"Logistics", ModuleKind::LOGISTICS, "Material handling and routing."},
+        {"Automation", ModuleKind::AUTOMATION, "Automated production control."}
     };
 
     for (size_t i = 0; i < mfgModules.size(); i++)
     {
         UnitModule mod;
         mod.name = mfgModules[i].name;
-        mod.moduleType = mfgModules[i].type;
+        mod.kind = mfgModules[i].kind;
         mod.tier = 0;
         mod.level = 1;
         mod.isBuilt = (i < 3);
@@ -655,20 +905,20 @@ void Unit::InitializeManufactureModules() {
 }
 
 void Unit::InitializeResearchModules() {
-    struct ModuleInfo { std::string name; std::string type; std::string desc; };
+    struct ModuleInfo { std::string name; ModuleKind kind; std::string desc; };
     std::vector<ModuleInfo> resModules = {
-        {"Laboratory", "LABORATORY", "Fundamental research facility."},
-        {"Analysis", "ANALYSIS", "Data analysis and computation."},
-        {"Simulation", "SIMULATION", "Numerical simulation systems."},
-        {"Archive", "ARCHIVE", "Research data storage and retrieval."},
-        {"Publication", "PUBLICATION", "Research output and knowledge sharing."}
+        {"Laboratory", ModuleKind::LABORATORY, "Fundamental research facility."},
+        {"Analysis", ModuleKind::ANALYSIS, "Data analysis and computation."},
+        {"Simulation", ModuleKind::SIMULATION, "Numerical simulation systems."},
+        {"Archive", ModuleKind::ARCHIVE, "Research data storage and retrieval."},
+        {"Publication", ModuleKind::PUBLICATION, "Research output and knowledge sharing."}
     };
 
     for (size_t i = 0; i < resModules.size(); i++)
     {
         UnitModule mod;
         mod.name = resModules[i].name;
-        mod.moduleType = resModules[i].type;
+        mod.kind = resModules[i].kind;
         mod.tier = 0;
         mod.level = 1;
         mod.isBuilt = (i < 3);
@@ -693,7 +943,7 @@ void Unit::InitializeResearchModules() {
 void Unit::InitializeGenericModules() {
     UnitModule basicModule;
     basicModule.name = "Basic " + unit_type;
-    basicModule.moduleType = "GENERIC";
+    basicModule.kind = ModuleKind::GENERIC;
     basicModule.tier = 0;
     basicModule.level = 1;
     basicModule.isBuilt = true;
@@ -712,6 +962,7 @@ bool Unit::UpgradeModule(int moduleIndex) {
     }
 
     UnitModule& module = modules[moduleIndex];
+    MarkChanged();
 
     // Check if we have required resources for upgrade
     const auto& costs = module.upgradeCosts[module.level + 1];
@@ -726,19 +977,17 @@ bool Unit::UpgradeModule(int moduleIndex) {
     float levelMultiplier = 1.0f + (module.level - 1) * 0.2f;
 
     // Consumption rates decrease with level
-    for (auto& [type, rate] : module.consumptionRates) {
-        rate = rate * (2.0f - levelMultiplier);
-    }
+    module.consumptionRates *= 2.0f - levelMultiplier;
 
     // Update maximum production rates
-    for (auto& [type, rate] : module.maxProductionRates) {
+    for (auto [type, rate] : module.maxProductionRates) {
         float baseRate = rate / (1.0f + (module.level - 2) * 0.2f);  // Get original base rate
         rate = baseRate * levelMultiplier;  // Apply new level multiplier
     }
 
     // Update actual production rates to maintain same proportion of max
-    for (auto& [type, rate] : module.productionRates) {
-        if (module.maxProductionRates.count(type) > 0) {
+    for (auto [type, rate] : module.productionRates) {
+        if (module.maxProductionRates.Has(type)) {
             float proportion = rate / module.maxProductionRates[type];
             rate = module.maxProductionRates[type] * proportion;
         }
@@ -749,7 +998,7 @@ bool Unit::UpgradeModule(int moduleIndex) {
         CalculateConsumption();
     }
 
-    ShowMessage(TextFormat("Module upgraded to level %d - Production set to maximum", module.level));
+    ShowMessage(FormatMessage("Module upgraded to level %d - Production set to maximum", module.level));
     return true;
 }
 
@@ -760,6 +1009,7 @@ bool Unit::UpgradeModuleTier(int moduleIndex) {
     }
 
     UnitModule& module = modules[moduleIndex];
+    MarkChanged();
 
     if (module.tier >= 3)
     {
@@ -773,9 +1023,9 @@ bool Unit::UpgradeModuleTier(int moduleIndex) {
     {
         if (!registry.IsUnlocked(dep))
         {
-            ShowMessage(TextFormat("Requires tech: %s", dep.c_str()));
-            std::cout << "[TIER UPGRADE] Module " << module.name
-                      << " requires tech: " << dep << std::endl;
+            ShowMessage(FormatMessage("Requires tech: %s", dep.c_str()));
+            COLONY_LOG_INFO(Unit, "[TIER UPGRADE] Module " << module.name
+                      << " requires tech: " << dep);
             return false;
         }
     }
@@ -789,7 +1039,7 @@ bool Unit::UpgradeModuleTier(int moduleIndex) {
         {
             if (resourceStorage[resource] < cost)
             {
-                ShowMessage(TextFormat("Not enough %s for tier upgrade.",
+                ShowMessage(FormatMessage("Not enough %s for tier upgrade.",
                             ResourceTypeToString(resource)));
                 return false;
             }
@@ -806,19 +1056,16 @@ bool Unit::UpgradeModuleTier(int moduleIndex) {
     module.tier = nextTier;
 
     // Scale efficiency and rates by tier
-    static const float tierMults[] = {1.0f, 1.4f, 1.9f, 2.5f};
+    const float* tierMults = Balance().moduleTierMultipliers;
     float tierMultiplier = tierMults[std::min(module.tier, 3)];
     module.efficiency = std::min(1.0f, 0.5f + module.tier * 0.18f);
 
     // Scale production rates
-    for (auto& [type, rate] : module.maxProductionRates)
-    {
-        rate *= tierMultiplier / tierMults[std::min(module.tier - 1, 3)];  // Incremental increase
-    }
+    module.maxProductionRates *= tierMultiplier / tierMults[std::min(module.tier - 1, 3)];  // Incremental increase
     module.productionRates = module.maxProductionRates;
 
     // Update description based on tier
-    if (module.moduleType == "PROSPECTING")
+    if (module.kind == ModuleKind::PROSPECTING)
     {
         const char* tierDescs[] = {
             "Visual estimation. ~40% accuracy.",
@@ -828,7 +1075,7 @@ bool Unit::UpgradeModuleTier(int moduleIndex) {
         };
         module.description = tierDescs[module.tier];
     }
-    else if (module.moduleType == "EXCAVATION")
+    else if (module.kind == ModuleKind::EXCAVATION)
     {
         const char* tierDescs[] = {
             "Manual scoop. 1 excavator, 10cm depth.",
@@ -838,7 +1085,7 @@ bool Unit::UpgradeModuleTier(int moduleIndex) {
         };
         module.description = tierDescs[module.tier];
     }
-    else if (module.moduleType == "BENEFICIATION")
+    else if (module.kind == ModuleKind::BENEFICIATION)
     {
         const char* tierDescs[] = {
             "Direct output. Raw regolith passthrough.",
@@ -875,7 +1122,7 @@ bool Unit::UpgradeModuleTier(int moduleIndex) {
             separationChain.push_back(SeparationNodes::CreateMRE());
         }
     }
-    else if (module.moduleType == "EXCAVATION")
+    else if (module.kind == ModuleKind::EXCAVATION)
     {
         // Add excavators based on tier
         int targetCount = 1;
@@ -899,7 +1146,7 @@ bool Unit::UpgradeModuleTier(int moduleIndex) {
     }
 
     // Update tier dependencies for the NEXT tier
-    if (module.moduleType == "PROSPECTING")
+    if (module.kind == ModuleKind::PROSPECTING)
     {
         std::vector<std::vector<std::string>> deps = {
             {"Spectroscopy"}, {"Geophysics"}, {"SwarmAI"}, {}
@@ -907,7 +1154,7 @@ bool Unit::UpgradeModuleTier(int moduleIndex) {
         if (module.tier < 3) module.tierDependencies = deps[module.tier];
         else module.tierDependencies.clear();
     }
-    else if (module.moduleType == "EXCAVATION")
+    else if (module.kind == ModuleKind::EXCAVATION)
     {
         std::vector<std::vector<std::string>> deps = {
             {"MechanizedDrilling"}, {"HeavyEquipment"}, {"AutonomousFleet"}, {}
@@ -915,7 +1162,7 @@ bool Unit::UpgradeModuleTier(int moduleIndex) {
         if (module.tier < 3) module.tierDependencies = deps[module.tier];
         else module.tierDependencies.clear();
     }
-    else if (module.moduleType == "BENEFICIATION")
+    else if (module.kind == ModuleKind::BENEFICIATION)
     {
         std::vector<std::vector<std::string>> deps = {
             {"MagneticSeparation"}, {"ProcessingChain"}, {"RefineryComplex"}, {}
@@ -930,13 +1177,13 @@ bool Unit::UpgradeModuleTier(int moduleIndex) {
         CalculateConsumption();
     }
 
-    if (module.moduleType == "PROSPECTING" && prospectingSystem)
+    if (module.kind == ModuleKind::PROSPECTING && prospectingSystem)
     {
         prospectingSystem->SetTier(module.tier);
     }
 
-    ShowMessage(TextFormat("%s upgraded to Tier %d", module.name.c_str(), module.tier));
-    std::cout << "[TIER UPGRADE] " << module.name << " -> Tier " << module.tier << std::endl;
+    ShowMessage(FormatMessage("%s upgraded to Tier %d", module.name.c_str(), module.tier));
+    COLONY_LOG_INFO(Unit, "[TIER UPGRADE] " << module.name << " -> Tier " << module.tier);
     return true;
 }
 
@@ -944,15 +1191,16 @@ bool Unit::DebugUpgradeModuleTier(int moduleIndex)
 {
     if (moduleIndex < 0 || moduleIndex >= static_cast<int>(modules.size()))
     {
-        std::cout << "[DEBUG] Invalid module index: " << moduleIndex << std::endl;
+        COLONY_LOG_DEBUG(Unit, "[DEBUG] Invalid module index: " << moduleIndex);
         return false;
     }
 
     UnitModule& module = modules[moduleIndex];
+    MarkChanged();
 
     if (module.tier >= 3)
     {
-        std::cout << "[DEBUG] " << module.name << " already at max tier (3)." << std::endl;
+        COLONY_LOG_DEBUG(Unit, "[DEBUG] " << module.name << " already at max tier (3).");
         ShowMessage("Module already at maximum tier (3).");
         return false;
     }
@@ -961,17 +1209,14 @@ bool Unit::DebugUpgradeModuleTier(int moduleIndex)
     int nextTier = module.tier + 1;
     module.tier = nextTier;
 
-    static const float tierMults[] = {1.0f, 1.4f, 1.9f, 2.5f};
+    const float* tierMults = Balance().moduleTierMultipliers;
     float tierMultiplier = tierMults[std::min(module.tier, 3)];
     module.efficiency = std::min(1.0f, 0.5f + module.tier * 0.18f);
 
-    for (auto& [type, rate] : module.maxProductionRates)
-    {
-        rate *= tierMultiplier / tierMults[std::min(module.tier - 1, 3)];
-    }
+    module.maxProductionRates *= tierMultiplier / tierMults[std::min(module.tier - 1, 3)];
     module.productionRates = module.maxProductionRates;
 
-    if (module.moduleType == "PROSPECTING")
+    if (module.kind == ModuleKind::PROSPECTING)
     {
         const char* tierDescs[] = {
             "Visual estimation. ~40% accuracy.",
@@ -981,7 +1226,7 @@ bool Unit::DebugUpgradeModuleTier(int moduleIndex)
         };
         module.description = tierDescs[module.tier];
     }
-    else if (module.moduleType == "EXCAVATION")
+    else if (module.kind == ModuleKind::EXCAVATION)
     {
         const char* tierDescs[] = {
             "Manual scoop. 1 excavator, 10cm depth.",
@@ -991,7 +1236,7 @@ bool Unit::DebugUpgradeModuleTier(int moduleIndex)
         };
         module.description = tierDescs[module.tier];
     }
-    else if (module.moduleType == "BENEFICIATION")
+    else if (module.kind == ModuleKind::BENEFICIATION)
     {
         const char* tierDescs[] = {
             "Direct output. Raw regolith passthrough.",
@@ -1027,7 +1272,7 @@ bool Unit::DebugUpgradeModuleTier(int moduleIndex)
             separationChain.push_back(SeparationNodes::CreateMRE());
         }
     }
-    else if (module.moduleType == "EXCAVATION")
+    else if (module.kind == ModuleKind::EXCAVATION)
     {
         int targetCount = 1;
         if (module.tier == 1) targetCount = 2;
@@ -1049,7 +1294,7 @@ bool Unit::DebugUpgradeModuleTier(int moduleIndex)
         }
     }
 
-    if (module.moduleType == "PROSPECTING")
+    if (module.kind == ModuleKind::PROSPECTING)
     {
         std::vector<std::vector<std::string>> deps = {
             {"Spectroscopy"}, {"Geophysics"}, {"SwarmAI"}, {}
@@ -1057,7 +1302,7 @@ bool Unit::DebugUpgradeModuleTier(int moduleIndex)
         if (module.tier < 3) module.tierDependencies = deps[module.tier];
         else module.tierDependencies.clear();
     }
-    else if (module.moduleType == "EXCAVATION")
+    else if (module.kind == ModuleKind::EXCAVATION)
     {
         std::vector<std::vector<std::string>> deps = {
             {"MechanizedDrilling"}, {"HeavyEquipment"}, {"AutonomousFleet"}, {}
@@ -1065,7 +1310,7 @@ bool Unit::DebugUpgradeModuleTier(int moduleIndex)
         if (module.tier < 3) module.tierDependencies = deps[module.tier];
         else module.tierDependencies.clear();
     }
-    else if (module.moduleType == "BENEFICIATION")
+    else if (module.kind == ModuleKind::BENEFICIATION)
     {
         std::vector<std::vector<std::string>> deps = {
             {"MagneticSeparation"}, {"ProcessingChain"}, {"RefineryComplex"}, {}
@@ -1079,13 +1324,37 @@ bool Unit::DebugUpgradeModuleTier(int moduleIndex)
         CalculateConsumption();
     }
 
-    if (module.moduleType == "PROSPECTING" && prospectingSystem)
+    if (module.kind == ModuleKind::PROSPECTING && prospectingSystem)
     {
         prospectingSystem->SetTier(module.tier);
     }
 
-    ShowMessage(TextFormat("[DEBUG] %s force-upgraded to Tier %d", module.name.c_str(), module.tier));
-    std::cout << "[DEBUG] Force upgraded " << module.name << " to tier " << module.tier << std::endl;
+    ShowMessage(FormatMessage("[DEBUG] %s force-upgraded to Tier %d", module.name.c_str(), module.tier));
+    COLONY_LOG_DEBUG(Unit, "[DEBUG] Force upgraded " << module.name << " to tier " << module.tier);
+    return true;
+}
+
+bool Unit::DebugBuildModule(int moduleIndex)
+{
+    if (moduleIndex < 0 || moduleIndex >= static_cast<int>(modules.size()))
+    {
+        COLONY_LOG_DEBUG(Unit, "[DEBUG] Invalid module index: " << moduleIndex);
+        return false;
+    }
+
+    UnitModule& module = modules[moduleIndex];
+    MarkChanged();
+    if (!module.isBuilt)
+    {
+        module.isBuilt = true;
+        module.level = std::max(module.level, 1);
+    }
+    if (activeModuleIndices.count(moduleIndex) == 0)
+    {
+        ActivateModule(moduleIndex);
+    }
+
+    COLONY_LOG_DEBUG(Unit, "[DEBUG] Force built " << module.name);
     return true;
 }
 
@@ -1095,17 +1364,17 @@ void Unit::ProcessModuleEffects(float deltaTime, ResourceManager& resourceManage
     CalculateConsumption();  // Update consumption rates when modules are activated
 
     // --- Dynamic energy consumption for extraction modules ---
-    if (unit_type == "Extraction")
+    if (unitKind == UnitType::Extraction)
     {
         for (int idx : activeModuleIndices)
         {
             UnitModule& mod = modules[idx];
 
-            if (mod.moduleType == "PROSPECTING")
+            if (mod.kind == ModuleKind::PROSPECTING)
             {
                 mod.consumptionRates[ResourceType::ENERGY] = 0.2f;
             }
-            else if (mod.moduleType == "EXCAVATION")
+            else if (mod.kind == ModuleKind::EXCAVATION)
             {
                 int activeExcavators = 0;
                 for (const auto& exc : excavators)
@@ -1117,7 +1386,7 @@ void Unit::ProcessModuleEffects(float deltaTime, ResourceManager& resourceManage
                                           std::max(1, activeExcavators);
                 mod.consumptionRates[ResourceType::ENERGY] = excavationEnergy;
             }
-            else if (mod.moduleType == "BENEFICIATION")
+            else if (mod.kind == ModuleKind::BENEFICIATION)
             {
                 float benefEnergy = 0.3f;  // Base overhead
                 for (const auto& node : separationChain)
@@ -1129,12 +1398,12 @@ void Unit::ProcessModuleEffects(float deltaTime, ResourceManager& resourceManage
                 }
                 mod.consumptionRates[ResourceType::ENERGY] = benefEnergy;
             }
-            else if (mod.moduleType == "OPERATIONS")
+            else if (mod.kind == ModuleKind::OPERATIONS)
             {
                 static const float opsEnergy[] = {0.1f, 0.2f, 0.35f, 0.5f};
                 mod.consumptionRates[ResourceType::ENERGY] = opsEnergy[std::min(mod.tier, 3)];
             }
-            else if (mod.moduleType == "DIRECTIVES")
+            else if (mod.kind == ModuleKind::DIRECTIVES)
             {
                 float directiveEnergy = 0.15f;  // Base
                 if (activeDirective.type == DirectiveType::MAXIMIZE)
@@ -1181,13 +1450,10 @@ void Unit::ProcessModuleEffects(float deltaTime, ResourceManager& resourceManage
         }
 
         // Consume resources proportional to efficiency
-        for (const auto& [type, rate] : module.consumptionRates) {
-            float consumption = rate * deltaTime * efficiencyMultiplier;
-            resourceStorage[type] = std::max(0.0f, resourceStorage[type] - consumption);
-        }
+        resourceStorage.Drain(module.consumptionRates, deltaTime * efficiencyMultiplier);
 
         // Handle production based on unit type (scaled by efficiency)
-        if (unit_type == "Extraction") {
+        if (unitKind == UnitType::Extraction) {
             ProcessExtraction(deltaTime * efficiencyMultiplier, resourceManager);
         }
         else {
@@ -1220,15 +1486,16 @@ void Unit::ProcessExtraction(float deltaTime, ResourceManager& resourceManager)
     auto availableResources = resourceManager.GetResourcesAtGridLayer(gridX, gridY, activeLayer);
 
     // --- Survey-gated extraction efficiency ---
-    float scanMultiplier = SURVEY_UNSCANNED_EFFICIENCY;
+    const BalanceParams& balance = Balance();
+    float scanMultiplier = balance.surveyUnscannedEfficiency;
     if (prospectingSystem)
     {
         float survey = prospectingSystem->GetSurveyProgress();
-        scanMultiplier = SURVEY_UNSCANNED_EFFICIENCY + SURVEY_SCANNED_BONUS * survey;
+        scanMultiplier = balance.surveyUnscannedEfficiency + balance.surveyScannedBonus * survey;
 
         if (prospectingSystem->IsMarkedSite())
         {
-            scanMultiplier += SURVEY_MARKED_SITE_BONUS;
+            scanMultiplier += balance.surveyMarkedSiteBonus;
         }
     }
 
@@ -1274,7 +1541,7 @@ void Unit::ProcessExtraction(float deltaTime, ResourceManager& resourceManager)
     UnitModule* excavationMod = nullptr;
     for (auto& mod : modules)
     {
-        if (mod.moduleType == "EXCAVATION" && mod.isActive)
+        if (mod.kind == ModuleKind::EXCAVATION && mod.isActive)
         {
             excavationMod = &mod;
             break;
@@ -1284,25 +1551,15 @@ void Unit::ProcessExtraction(float deltaTime, ResourceManager& resourceManager)
     if (!excavationMod) return;
 
     float efficiency = excavationMod->efficiency;
-    static const float tierMults[] = {1.0f, 1.4f, 1.9f, 2.5f};
-    float tierMultiplier = tierMults[std::min(excavationMod->tier, 3)];
-
-    // Map for base extraction rates
-    std::map<ResourceType, float> extractionRates = {
-        {ResourceType::H2, parameters["H2ExtractionRate"]},
-        {ResourceType::O2, parameters["O2ExtractionRate"]},
-        {ResourceType::C,  parameters["CExtractionRate"]},
-        {ResourceType::Fe, parameters["FeExtractionRate"]},
-        {ResourceType::Si, parameters["SiExtractionRate"]}
-    };
+    float tierMultiplier = Balance().moduleTierMultipliers[std::min(excavationMod->tier, 3)];
 
     // --- Stage 1: Excavation (raw regolith) ---
-    std::map<ResourceType, float> rawRegolith;
+    ResourceVector rawRegolith;
 
     for (const auto& [resourceType, abundance] : availableResources)
     {
-        float baseRate = extractionRates.count(resourceType) ?
-            extractionRates[resourceType] : 0.01f;
+        float baseRate = tick.extractionRates.Has(resourceType) ?
+            tick.extractionRates.Get(resourceType) : 0.01f;
 
         // Apply directive priority boost
         float priorityBoost = 1.0f;
@@ -1324,20 +1581,24 @@ void Unit::ProcessExtraction(float deltaTime, ResourceManager& resourceManager)
         }
         extractionAmount *= std::max(1, activeExcavators);
 
-        // Deplete from planet
-        resourceManager.UpdateResourceDepletion(gridX, gridY, resourceType, extractionAmount);
+        // Deplete from planet (deferred while sects step in parallel)
+        if (depletionLog) {
+            depletionLog->push_back({gridX, gridY, resourceType, extractionAmount});
+        } else {
+            resourceManager.UpdateResourceDepletion(gridX, gridY, resourceType, extractionAmount);
+        }
 
         rawRegolith[resourceType] = extractionAmount;
     }
 
     // --- Stage 2: Beneficiation (separation chain) ---
-    std::map<ResourceType, float> processedOutput = rawRegolith;
+    ResourceVector processedOutput = rawRegolith;
 
     // Find beneficiation module efficiency
     float beneficiationEfficiency = 0.5f;
     for (const auto& mod : modules)
     {
-        if (mod.moduleType == "BENEFICIATION" && mod.isActive)
+        if (mod.kind == ModuleKind::BENEFICIATION && mod.isActive)
         {
             beneficiationEfficiency = mod.efficiency;
             break;
@@ -1345,6 +1606,7 @@ void Unit::ProcessExtraction(float deltaTime, ResourceManager& resourceManager)
     }
 
     // Process through each node in the separation chain
+    const float separationEfficiency = Balance().separationEfficiency;
     for (const auto& node : separationChain)
     {
         if (!node.isActive) continue;
@@ -1354,15 +1616,12 @@ void Unit::ProcessExtraction(float deltaTime, ResourceManager& resourceManager)
         // Merge node output back (replace values for processed types)
         for (const auto& [type, amount] : nodeOutput)
         {
-            processedOutput[type] = amount;  // No per-node efficiency multiply
+            processedOutput[type] = amount * separationEfficiency;  // No per-node efficiency multiply
         }
     }
 
     // Apply beneficiation module efficiency once after all nodes
-    for (auto& [type, amount] : processedOutput)
-    {
-        amount *= beneficiationEfficiency;
-    }
+    processedOutput *= beneficiationEfficiency;
 
     // --- Stage 3: Add to storage ---
     for (const auto& [resourceType, amount] : processedOutput)
@@ -1374,29 +1633,24 @@ void Unit::ProcessExtraction(float deltaTime, ResourceManager& resourceManager)
     }
 
     // Track total extracted
-    for (const auto& [type, amount] : rawRegolith)
-    {
-        totalRegolithExtracted += amount;
-    }
+    totalRegolithExtracted += rawRegolith.Sum();
 }
 
 // Add getters/setters for resource storage
 float Unit::GetStoredResource(ResourceType type) const {
-    auto it = resourceStorage.find(type);
-    return it != resourceStorage.end() ? it->second : 0.0f;
+    return resourceStorage.Get(type);
 }
 
 void Unit::AddResource(ResourceType type, float amount) {
     // Check if storage has capacity for this resource
-    auto capacityIt = storageCapacity.find(type);
-    if (capacityIt == storageCapacity.end()) {
+    if (!storageCapacity.Has(type)) {
         // No capacity limit defined, add directly (shouldn't happen)
         resourceStorage[type] += amount;
         return;
     }
 
     float currentStorage = resourceStorage[type];
-    float maxCapacity = capacityIt->second;
+    float maxCapacity = storageCapacity.Get(type);
     float availableSpace = maxCapacity - currentStorage;
 
     if (availableSpace >= amount) {
@@ -1474,7 +1728,7 @@ void Unit::InitializeFutureModules() {
                                 "\nHighest production potential with maximum resource cost.";
 
     // Initialize production and consumption rates based on unit type
-    if (unit_type == "Extraction") {
+    if (unitKind == UnitType::Extraction) {
         // Enhanced Module
         enhancedModule.maxProductionRates = {
             {ResourceType::H2, parameters["H2ExtractionRate"] * 1.2f},
@@ -1515,7 +1769,7 @@ void Unit::InitializeFutureModules() {
         };
         deepCoreModule.consumptionRates[ResourceType::ENERGY] = parameters["EnergyConsumption"] * 2.0f;
     }
-    else if (unit_type == "Farming") {
+    else if (unitKind == UnitType::Farming) {
         // Enhanced Module
         enhancedModule.maxProductionRates[ResourceType::FOOD] = parameters["FoodProductionRate"] * 1.2f;
         enhancedModule.consumptionRates[ResourceType::WATER] = parameters["WaterConsumption"] * 1.1f;
@@ -1598,9 +1852,9 @@ void Unit::InitializeStorage() {
     resourceStorage[ResourceType::Si] = 0.0f;
 
     // Debug print to verify initialization
-    std::cout << "Unit storage initialized with values:" << std::endl;
+    COLONY_LOG_DEBUG(Unit, "Unit storage initialized with values:");
     for (const auto& [type, amount] : resourceStorage) {
-        std::cout << "Resource " << static_cast<int>(type) << ": " << amount << std::endl;
+        COLONY_LOG_DEBUG(Unit, "Resource " << static_cast<int>(type) << ": " << amount);
     }
 
 }
@@ -1619,7 +1873,7 @@ Vector2 Unit::WorldToGrid(Vector2 worldPos) const {
 bool Unit::ActivateModule(int moduleIndex) {
     // Validate module index
     if (moduleIndex < 0 || moduleIndex >= modules.size()) {
-        std::cout << "ERROR: Invalid module index " << moduleIndex << std::endl;
+        COLONY_LOG_ERROR(Unit, "ERROR: Invalid module index " << moduleIndex);
         return false;
     }
 
@@ -1627,13 +1881,13 @@ bool Unit::ActivateModule(int moduleIndex) {
 
     // Check if module is built
     if (!module.isBuilt) {
-        std::cout << "Cannot activate unbuilt module: " << module.name << std::endl;
+        COLONY_LOG_INFO(Unit, "Cannot activate unbuilt module: " << module.name);
         return false;
     }
 
     // Check if already active
     if (activeModuleIndices.count(moduleIndex) > 0) {
-        std::cout << "Module " << module.name << " is already active" << std::endl;
+        COLONY_LOG_INFO(Unit, "Module " << module.name << " is already active");
         return false;
     }
 
@@ -1647,20 +1901,20 @@ bool Unit::ActivateModule(int moduleIndex) {
     // Recalculate consumption
     CalculateConsumption();
 
-    std::cout << "Activated module: " << module.name << " (index " << moduleIndex << ")" << std::endl;
+    COLONY_LOG_INFO(Unit, "Activated module: " << module.name << " (index " << moduleIndex << ")");
     return true;
 }
 
 bool Unit::DeactivateModule(int moduleIndex) {
     // Validate module index
     if (moduleIndex < 0 || moduleIndex >= modules.size()) {
-        std::cout << "ERROR: Invalid module index " << moduleIndex << std::endl;
+        COLONY_LOG_ERROR(Unit, "ERROR: Invalid module index " << moduleIndex);
         return false;
     }
 
     // Check if module is active
     if (activeModuleIndices.count(moduleIndex) == 0) {
-        std::cout << "Module is not currently active" << std::endl;
+        COLONY_LOG_INFO(Unit, "Module is not currently active");
         return false;
     }
 
@@ -1678,7 +1932,7 @@ bool Unit::DeactivateModule(int moduleIndex) {
         CalculateConsumption();
     }
 
-    std::cout << "Deactivated module: " << module.name << " (index " << moduleIndex << ")" << std::endl;
+    COLONY_LOG_INFO(Unit, "Deactivated module: " << module.name << " (index " << moduleIndex << ")");
     return true;
 }
 
@@ -1690,8 +1944,10 @@ void Unit::MoveExcavator(int excavatorId, int gridX, int gridY) {
         if (exc.id == excavatorId)
         {
             exc.gridPos = {static_cast<float>(gridX), static_cast<float>(gridY)};
-            std::cout << "[EXCAVATION] Excavator " << excavatorId
-                      << " moved to (" << gridX << "," << gridY << ")" << std::endl;
+            MarkChanged();
+            Wake();
+            COLONY_LOG_INFO(Unit, "[EXCAVATION] Excavator " << excavatorId
+                      << " moved to (" << gridX << "," << gridY << ")");
             return;
         }
     }
@@ -1705,7 +1961,7 @@ void Unit::SetExcavatorDepth(int excavatorId, float depth) {
             float maxDepth = 10.0f;
             for (const auto& mod : modules)
             {
-                if (mod.moduleType == "EXCAVATION")
+                if (mod.kind == ModuleKind::EXCAVATION)
                 {
                     float tierMaxDepths[] = {10.0f, 30.0f, 100.0f, 300.0f};
                     maxDepth = tierMaxDepths[std::min(mod.tier, 3)];
@@ -1713,6 +1969,7 @@ void Unit::SetExcavatorDepth(int excavatorId, float depth) {
                 }
             }
             exc.depth = std::clamp(depth, 0.0f, maxDepth);
+            MarkChanged();
             return;
         }
     }
@@ -1724,6 +1981,8 @@ void Unit::SetExcavatorRate(int excavatorId, float rate) {
         if (exc.id == excavatorId)
         {
             exc.rate = std::clamp(rate, 0.0f, 500.0f);
+            MarkChanged();
+            Wake();
             return;
         }
     }
@@ -1737,7 +1996,8 @@ void Unit::SwapSeparationNodes(int indexA, int indexB) {
         indexA != indexB)
     {
         std::swap(separationChain[indexA], separationChain[indexB]);
-        std::cout << "[BENEFICIATION] Swapped nodes " << indexA << " and " << indexB << std::endl;
+        MarkChanged();
+        COLONY_LOG_INFO(Unit, "[BENEFICIATION] Swapped nodes " << indexA << " and " << indexB);
     }
 }
 
@@ -1745,19 +2005,22 @@ void Unit::ToggleSeparationNodeActive(int index) {
     if (index >= 0 && index < static_cast<int>(separationChain.size()))
     {
         separationChain[index].isActive = !separationChain[index].isActive;
+        MarkChanged();
     }
 }
 
 void Unit::AddSeparationNode(const SeparationNode& node) {
     separationChain.push_back(node);
-    std::cout << "[BENEFICIATION] Added node: " << node.name << std::endl;
+    MarkChanged();
+    COLONY_LOG_INFO(Unit, "[BENEFICIATION] Added node: " << node.name);
 }
 
 void Unit::RemoveSeparationNode(int index) {
     if (index >= 0 && index < static_cast<int>(separationChain.size()))
     {
-        std::cout << "[BENEFICIATION] Removed node: " << separationChain[index].name << std::endl;
+        COLONY_LOG_INFO(Unit, "[BENEFICIATION] Removed node: " << separationChain[index].name);
         separationChain.erase(separationChain.begin() + index);
+        MarkChanged();
     }
 }
 
@@ -1770,7 +2033,7 @@ void Unit::SetDirective(const ActiveDirective& directive) {
 
     for (const auto& mod : modules)
     {
-        if (mod.moduleType == "DIRECTIVES" && mod.isActive)
+        if (mod.kind == ModuleKind::DIRECTIVES && mod.isActive)
         {
             canSetDirective = true;
             directivesTier = mod.tier;
@@ -1802,20 +2065,22 @@ void Unit::SetDirective(const ActiveDirective& directive) {
     }
 
     activeDirective = directive;
+    MarkChanged();
+    Wake();
 
     const char* directiveNames[] = {
         "NONE", "PRIORITIZE", "MAXIMIZE", "CONSERVE",
         "EXPLORATION_MODE", "EMERGENCY_HARVEST", "THERMAL_SYNC"
     };
-    std::cout << "[DIRECTIVES] Set directive: "
-              << directiveNames[static_cast<int>(directive.type)] << std::endl;
+    COLONY_LOG_INFO(Unit, "[DIRECTIVES] Set directive: "
+              << directiveNames[static_cast<int>(directive.type)]);
 }
 
 float Unit::GetOperationsEfficiencyModifier() const {
     // Find operations module
     for (const auto& mod : modules)
     {
-        if (mod.moduleType == "OPERATIONS")
+        if (mod.kind == ModuleKind::OPERATIONS)
         {
             if (!mod.isBuilt || !mod.isActive)
             {
@@ -1846,10 +2111,285 @@ float Unit::GetOperationsEfficiencyModifier() const {
 bool Unit::IsOperationsActive() const {
     for (const auto& mod : modules)
     {
-        if (mod.moduleType == "OPERATIONS" && mod.isBuilt && mod.isActive)
+        if (mod.kind == ModuleKind::OPERATIONS && mod.isBuilt && mod.isActive)
         {
             return true;
         }
     }
     return false;
 }
+
+// Module actions and status messages (shared by the unit UIs)
+
+void Unit::ShowMessage(const std::string& text) {
+    currentMessage.text = text;
+    currentMessage.opacity = 1.0f;
+    currentMessage.timeRemaining = 2.0f;
+}
+
+void Unit::UpdateMessage(float deltaTime) {
+    if (currentMessage.timeRemaining > 0) {
+        currentMessage.timeRemaining -= deltaTime;
+        if (currentMessage.timeRemaining <= 0.5f) {
+            currentMessage.opacity = currentMessage.timeRemaining / 0.5f;
+        }
+    }
+}
+
+void Unit::HandleModuleActivation(int moduleIndex) {
+    if (moduleIndex < 0 || moduleIndex >= modules.size()) {
+        return;
+    }
+
+    UnitModule& module = modules[moduleIndex];
+    if (!module.isBuilt) {
+        ShowMessage("Module needs to be built first");
+        return;
+    }
+
+    // Toggle the selected module's active state
+    if (module.isActive) {
+        // Deactivate the module
+        if (DeactivateModule(moduleIndex)) {
+            ShowMessage(module.name + " deactivated");
+        }
+    } else {
+        // Activate the module (allows multiple active modules now)
+        if (ActivateModule(moduleIndex)) {
+            ShowMessage(module.name + " activated");
+        }
+    }
+}
+
+bool Unit::CanUpgradeModule(const UnitModule& module) {
+    if (!module.isBuilt || module.level >= 5) return false;
+
+    // Safely check if next level costs exist
+    auto costIter = module.upgradeCosts.find(module.level + 1);
+    if (costIter == module.upgradeCosts.end()) {
+        return false;
+    }
+
+    // Check if we have required resources for upgrade
+    for (const auto& [resource, amount] : costIter->second) {
+        if (resourceStorage[resource] < amount) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Unit::CanBuildModule(const UnitModule& module) {
+    if (module.isBuilt) return false;
+
+    // Safely check if level 1 costs exist
+    auto costIter = module.upgradeCosts.find(1);  // Changed from .at() to .find()
+    if (costIter == module.upgradeCosts.end()) {
+        return false;
+    }
+
+    // Check if we have required resources for initial build
+    for (const auto& [resource, amount] : costIter->second) {
+        if (resourceStorage[resource] < amount) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Public wrapper methods for RenderManager access
+bool Unit::PublicCanUpgradeModule(int moduleIndex) const {
+    if (moduleIndex < 0 || moduleIndex >= static_cast<int>(modules.size())) return false;
+    return const_cast<Unit*>(this)->CanUpgradeModule(modules[moduleIndex]);
+}
+
+bool Unit::PublicCanBuildModule(int moduleIndex) const {
+    if (moduleIndex < 0 || moduleIndex >= static_cast<int>(modules.size())) return false;
+    return const_cast<Unit*>(this)->CanBuildModule(modules[moduleIndex]);
+}
+
+void Unit::SetModuleProductionRate(int moduleIndex, ResourceType resource, float rate) {
+    if (moduleIndex < 0 || moduleIndex >= static_cast<int>(modules.size())) return;
+
+    modules[moduleIndex].productionRates[resource] = rate;
+    ModulesChanged();
+    CalculateConsumption();  // consumption follows production
+}
+
+void Unit::PublicBuildModule(int moduleIndex) {
+    BuildModule(moduleIndex);
+}
+
+void Unit::PublicHandleModuleActivation(int moduleIndex) {
+    HandleModuleActivation(moduleIndex);
+}
+
+void Unit::PublicShowMessage(const std::string& text) {
+    ShowMessage(text);
+}
+
+void Unit::BuildModule(int moduleIndex) {
+    if (moduleIndex < 0 || moduleIndex >= modules.size()) return;
+
+    UnitModule& module = modules[moduleIndex];
+    if (module.isBuilt) return;
+    MarkChanged();
+
+    // Safely get level 1 costs
+    auto costIter = module.upgradeCosts.find(1);
+    if (costIter == module.upgradeCosts.end()) {
+        ShowMessage("Error: No build costs defined!");
+        return;
+    }
+
+    bool inquiryRequired = false;
+    std::map<ResourceType, float> requiredResources;
+    // Check resources
+    for (const auto& [resource, amount] : costIter->second) {
+        if (amount < resourceStorage[resource]) {
+            inquiryRequired = true;
+            requiredResources[resource] = amount;
+        }
+
+    }
+
+    if (!inquiryRequired) {
+        // Consume resources
+        for (const auto& [resource, amount] : costIter->second) {
+            resourceStorage[resource] -= amount;
+        }
+
+        module.isBuilt = true;
+        module.level = 1;
+        ShowMessage(module.name + "Module was built successfully!");
+    } else{
+        ShowMessage(module.name + "Anticipating resources from Sect!");
+    }
+
+
+    module.isBuilt = true;
+    module.level = 1;
+    ShowMessage(module.name + " built successfully!");
+}
+
+// --- Save game ---
+
+uint32_t Unit::GetStateRevision() const {
+    return stateRevision + (prospectingSystem ? prospectingSystem->GetRevision() : 0);
+}
+
+void Unit::SaveState(ByteWriter& out) const {
+    out.WriteEnum(status);
+    out.WriteBool(isUnderConstruction);
+    out.Write<float>(productionCycleTime);
+    out.Write<float>(energy_cost);
+    WriteNamedValues(out, parameters);
+    WriteNamedValues(out, consumption);
+    WriteNamedValues(out, production);
+    out.WriteCount(upgrades.size());
+    for (const std::string& upgrade : upgrades) out.WriteString(upgrade);
+
+    out.WriteResources(tick.extractionRates);
+    out.Write<float>(tick.efficiency);
+    out.Write<float>(tick.foodProductionRate);
+    out.Write<float>(tick.fertilityLevel);
+    out.Write<float>(tick.growthBoost);
+    out.Write<float>(tick.waterConsumption);
+    out.Write<float>(tick.energyOutput);
+    out.Write<float>(tick.weatherImpact);
+    out.Write<float>(tick.fuelConsumption);
+    out.Write<float>(tick.maintenanceCost);
+    out.Write<float>(tick.buildTime);
+    out.Write<float>(tick.constructionProgress);
+
+    out.WriteCount(modules.size());
+    for (const UnitModule& module : modules) WriteModule(out, module);
+    out.WriteCount(activeModuleIndices.size());
+    for (int index : activeModuleIndices) out.Write<int32_t>(index);
+    out.WriteResources(overflowBuffer);
+
+    out.WriteCount(excavators.size());
+    for (const Excavator& excavator : excavators) {
+        out.Write<int32_t>(excavator.id);
+        out.Write<float>(excavator.gridPos.x);
+        out.Write<float>(excavator.gridPos.y);
+        out.WriteString(excavator.method);
+        out.Write<float>(excavator.depth);
+        out.Write<float>(excavator.rate);
+        out.Write<float>(excavator.wear);
+    }
+    out.Write<float>(totalRegolithExtracted);
+
+    out.WriteCount(separationChain.size());
+    for (const SeparationNode& node : separationChain) WriteSeparationNode(out, node);
+
+    out.WriteEnum(activeDirective.type);
+    out.WriteEnum(activeDirective.targetResource);
+    out.Write<float>(activeDirective.strength);
+
+    out.WriteBool(prospectingSystem != nullptr);
+    if (prospectingSystem) prospectingSystem->SaveState(out);
+}
+
+bool Unit::LoadState(ByteReader& in) {
+    status = in.ReadEnum(UnitStatus::ACTIVE);
+    isUnderConstruction = in.ReadBool();
+    productionCycleTime = in.Read<float>();
+    energy_cost = in.Read<float>();
+    parameters = ReadNamedValues(in);
+    consumption = ReadNamedValues(in);
+    production = ReadNamedValues(in);
+    upgrades.resize(in.ReadCount(4));
+    for (std::string& upgrade : upgrades) upgrade = in.ReadString();
+
+    tick.extractionRates = in.ReadResources();
+    tick.efficiency = in.Read<float>();
+    tick.foodProductionRate = in.Read<float>();
+    tick.fertilityLevel = in.Read<float>();
+    tick.growthBoost = in.Read<float>();
+    tick.waterConsumption = in.Read<float>();
+    tick.energyOutput = in.Read<float>();
+    tick.weatherImpact = in.Read<float>();
+    tick.fuelConsumption = in.Read<float>();
+    tick.maintenanceCost = in.Read<float>();
+    tick.buildTime = in.Read<float>();
+    tick.constructionProgress = in.Read<float>();
+
+    modules.resize(in.ReadCount(40));
+    for (UnitModule& module : modules) ReadModule(in, module);
+    activeModuleIndices.clear();
+    size_t activeCount = in.ReadCount(4);
+    for (size_t i = 0; i < activeCount; i++) {
+        int index = in.Read<int32_t>();
+        if (index < 0 || index >= static_cast<int>(modules.size())) in.Fail();
+        else activeModuleIndices.insert(index);
+    }
+    overflowBuffer = in.ReadResources();
+
+    excavators.resize(in.ReadCount(28));
+    for (Excavator& excavator : excavators) {
+        excavator.id = in.Read<int32_t>();
+        excavator.gridPos.x = in.Read<float>();
+        excavator.gridPos.y = in.Read<float>();
+        excavator.method = in.ReadString();
+        excavator.depth = in.Read<float>();
+        excavator.rate = in.Read<float>();
+        excavator.wear = in.Read<float>();
+    }
+    totalRegolithExtracted = in.Read<float>();
+
+    separationChain.resize(in.ReadCount(30));
+    for (SeparationNode& node : separationChain) ReadSeparationNode(in, node);
+
+    activeDirective.type = in.ReadEnum(DirectiveType::THERMAL_SYNC);
+    activeDirective.targetResource = in.ReadResourceType();
+    activeDirective.strength = in.Read<float>();
+
+    // Only extraction units have a prospecting system, and the saved unit
+    // had the same type as this one
+    if (in.ReadBool() != (prospectingSystem != nullptr)) in.Fail();
+    else if (prospectingSystem) prospectingSystem->LoadState(in);
+
+    ModulesChanged();
+    return in.Ok();
+}
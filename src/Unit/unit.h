@@ -8,27 +8,50 @@
 #include <set>
 
 #include "resource_manager.h"
+#include "resource_vector.h"
+#include "unit_kinds.h"
 #include "time_manager.h"
 #include "game_constants.h"
 #include "unit_ui.h"
 #include "separation_node.h"
 #include "prospecting_system.h"
+#include "active_set.h"
 #include <utility>
 #include <cmath>
 #include <memory>
 
+class ModuleStore;
+class CommandSink;
+class ByteWriter;
+class ByteReader;
+
+// One quantity an update moves by the same amount every step while the
+// rules that move it stay put, and the range it can move in before one of
+// them changes what a step does (FastForward)
+struct SteadyLane {
+    float value;
+    float low;
+    float high;
+    float reach = 0.0f;     // how far a step may take it before it settles
+};
+
 class Unit {
+    friend class ModuleStore;   // runs the module step of batched units
+
 public:
+    // Buffered production beyond this is dropped (FlushOverflow)
+    static constexpr float OVERFLOW_BUFFER_CAP = 200.0f;
+
     // Constructor
     Unit(std::string type, Vector2& position, ResourceManager& resource, TimeManager &time,
-         std::map<ResourceType, float> &storage, std::map<ResourceType, float> &capacity);
+         ResourceVector &storage, ResourceVector &capacity);
 
     // Destrructor
     ~Unit();
 
     struct UnitModule {
         std::string name;
-        std::string moduleType;                           // e.g., "PROSPECTING", "EXCAVATION"
+        ModuleKind kind = ModuleKind::GENERIC;            // e.g. PROSPECTING, EXCAVATION
         int level = 1;                                    // Legacy level for non-extraction units
         int tier = 0;                                     // Tier 0-3 for extraction modules
         bool isBuilt;
@@ -37,9 +60,9 @@ public:
         float energyRequired = 0.0f;                      // kW required for this tier
         std::string description;
         std::vector<std::string> tierDependencies;         // Tech names required for next tier
-        std::map<ResourceType, float> consumptionRates;
-        std::map<ResourceType, float> productionRates;
-        std::map<ResourceType, float> maxProductionRates;
+        ResourceVector consumptionRates;
+        ResourceVector productionRates;
+        ResourceVector maxProductionRates;
         std::map<int, std::map<ResourceType, float>> upgradeCosts;
         std::map<int, std::map<std::string, float>> enhancements;
     };
@@ -52,8 +75,7 @@ public:
     std::map<std::string, float> CalculateProduction() const;
     void DisplayStats() const;
     void Update(float deltaTime);
-    void DrawInSectView(Vector2 corePosition, float coreRadius, int index);
-    void DrawInUnitView();
+    void DrawInUnitView(CommandSink* commands = nullptr);
 
     void SetInitialParameters();
 
@@ -62,19 +84,20 @@ public:
     void SetParentSectPosition(Vector2 position) {parentSectPosition = position;}
 
     // State checking
-    bool IsActive() const { return status == "active"; }
+    bool IsActive() const { return status == UnitStatus::ACTIVE; }
     bool IsUnderConstruction() const { return isUnderConstruction; }
 
     // Getters
-    std::string GetStatus() const { return status; }
+    UnitStatus GetStatus() const { return status; }
     Vector2 GetUnitPosInSectView() const { return positionInSectView;}
     float GetUnitRadiusInSectView() const { return radiusInSectView;}
-    std::string GetUnitType() const { return unit_type;}
+    UnitType GetType() const { return unitKind; }
+    const std::string& GetUnitType() const { return unit_type; }    // display name
 
     // Setters
     void SetUnitPosInSectView(Vector2 position) {positionInSectView = position;}
     void SetUnitRadiusInSectView(float radius) {radiusInSectView = radius;}
-    void SetStatus(const std::string& newStatus) { status = newStatus; }
+    void SetStatus(UnitStatus newStatus) { status = newStatus; ModulesChanged(); }
     float GetProductionCycleTime() const { return productionCycleTime; }
 
     // Production processing
@@ -91,6 +114,7 @@ public:
     bool UpgradeModule(int moduleIndex);
     bool UpgradeModuleTier(int moduleIndex);
     bool DebugUpgradeModuleTier(int moduleIndex);
+    bool DebugBuildModule(int moduleIndex);     // builds and activates, build cost skipped
     void ProcessModuleEffects(float deltaTime, ResourceManager& );
     void ProcessExtraction(float deltaTime, ResourceManager& );
     float GetStoredResource(ResourceType type) const;
@@ -100,8 +124,52 @@ public:
     // Module activation/deactivation
     bool ActivateModule(int moduleIndex);
     bool DeactivateModule(int moduleIndex);
+    // Player-set rate of one resource (legacy unit view rate buttons)
+    void SetModuleProductionRate(int moduleIndex, ResourceType resource, float rate);
     const std::set<int>& GetActiveModuleIndices() const { return activeModuleIndices; }
 
+    // Bumped whenever module rates or active state change (ModuleStore
+    // rebuilds on it). Batched units leave their module step to the store.
+    uint32_t GetModuleRevision() const { return moduleRevision; }
+    bool AreModulesBatched() const { return modulesBatched; }
+
+    // Bumped whenever anything SaveState writes may have changed: every
+    // update, module and status change, player action and mutable access
+    // to the prospecting system. Incremental autosave rewrites a unit only
+    // when this has moved on. MarkChanged is for code that writes unit
+    // state directly (ModuleStore).
+    uint32_t GetStateRevision() const;
+    void MarkChanged() { stateRevision++; }
+
+    // When set, planet depletion is appended here instead of applied, and
+    // the owner applies it (Sect::CommitDepletion)
+    void SetDepletionLog(std::vector<ResourceManager::Depletion>* log) { depletionLog = log; }
+
+    // Membership of the owning sect's active set. A unit wakes itself on
+    // module, status, directive and excavator changes; code that gives an
+    // idle unit work any other way calls Wake(). HasWork() is false only
+    // when Update would change nothing.
+    void SetActivitySlot(ActiveSet* set, int index) { activity = set; activityIndex = index; }
+    void Wake() { if (activity) activity->Wake(activityIndex); }
+    bool HasWork() const;
+
+    // Fast-forward (FastForward). ReadLanes appends the state an update
+    // moves at a steady rate: a bit mask of the resources whose overflow
+    // buffer follows, only those the buffer has taken unless `everyBuffer`,
+    // one lane for each of them, then each excavator's wear, the
+    // calibration time left and the regolith total. WriteLanes reads the
+    // same lanes back from `at` and returns the index after them.
+    void ReadLanes(float deltaTime, std::vector<SteadyLane>& lanes, bool everyBuffer = false) const;
+    size_t WriteLanes(const std::vector<SteadyLane>& lanes, size_t at);
+
+    // Adds what the modules running now consume and produce per second:
+    // the most a step can ask of storage before efficiency drops, and the
+    // most it can deposit before production is clamped at capacity
+    void AddRunningRates(ResourceVector& consumption, ResourceVector& production) const;
+
+    // True when the update's rates follow the time of day (THERMAL_SYNC)
+    bool HasClockDependentRates() const;
+
     // Excavation system
     struct Excavator {
         int id;
@@ -146,9 +214,9 @@ public:
     bool IsShowingStats() const { return showingStats; }
     void SetShowingStats(bool val) { showingStats = val; }
     const UIMessage& GetCurrentMessage() const { return currentMessage; }
-    const std::map<ResourceType, float>& GetResourceStorage() const { return resourceStorage; }
-    const std::map<ResourceType, float>& GetStorageCapacity() const { return storageCapacity; }
-    const std::map<ResourceType, float>& GetOverflowBuffer() const { return overflowBuffer; }
+    const ResourceVector& GetResourceStorage() const { return resourceStorage; }
+    const ResourceVector& GetStorageCapacity() const { return storageCapacity; }
+    const ResourceVector& GetOverflowBuffer() const { return overflowBuffer; }
     float GetTotalRegolithExtracted() const { return totalRegolithExtracted; }
 
     // Module action wrappers for RenderManager
@@ -180,6 +248,13 @@ public:
     float GetOperationsEfficiencyModifier() const;
     bool IsOperationsActive() const;
 
+    // Save game snapshot of everything the simulation changes: status,
+    // parameters, modules, excavators, the separation chain, directive and
+    // prospecting. Loading goes into a unit constructed with the same
+    // type and wakes it.
+    void SaveState(ByteWriter& out) const;
+    bool LoadState(ByteReader& in);
+
 private:
     // Include UI-related members
     UNIT_UI_PRIVATE_MEMBERS
@@ -187,12 +262,18 @@ private:
     Vector2 parentSectPosition;
     ResourceManager& resourceManager;
     TimeManager& timeManager;
-    std::map<ResourceType, float>& resourceStorage;
-    std::map<ResourceType, float>& storageCapacity;
-    std::map<ResourceType, float> overflowBuffer;  // Buffer for resources that exceed capacity
+    ResourceVector& resourceStorage;
+    ResourceVector& storageCapacity;
+    ResourceVector overflowBuffer;  // Buffer for resources that exceed capacity
 
     std::vector<UnitModule> modules;
     std::set<int> activeModuleIndices;  // Indices of currently active modules
+    uint32_t moduleRevision = 0;
+    uint32_t stateRevision = 0;
+    bool modulesBatched = false;        // ModuleStore runs ProcessModuleEffects' work
+    std::vector<ResourceManager::Depletion>* depletionLog = nullptr;
+    ActiveSet* activity = nullptr;
+    int activityIndex = 0;
     std::map<ResourceType, std::map<ResourceType, float>> productionCosts;
 
     // Prospecting system (extraction units only)
@@ -212,17 +293,38 @@ private:
     float productionCycleTime;
     Vector2 positionInSectView;
     float radiusInSectView;
-    std::string unit_type;
+    std::string unit_type;          // display name; logic uses unitKind
+    UnitType unitKind;
     std::map<std::string, float> parameters;
     std::map<std::string, float> consumption;
     std::map<std::string, float> production;
-    std::string status;
+    UnitStatus status;
+
+    // The `parameters` the tick reads, bound to fields once at construction
+    // so the update does no string lookups. `parameters` keeps the named
+    // values for display.
+    struct TickParameters {
+        ResourceVector extractionRates;     // Extraction: base rate per resource
+        float efficiency = 0.0f;
+        float foodProductionRate = 0.0f;
+        float fertilityLevel = 0.0f;
+        float growthBoost = 0.0f;
+        float waterConsumption = 0.0f;
+        float energyOutput = 0.0f;
+        float weatherImpact = 0.0f;
+        float fuelConsumption = 0.0f;
+        float maintenanceCost = 0.0f;
+        float buildTime = 0.0f;
+        float constructionProgress = 0.0f;
+    };
+    TickParameters tick;
     std::vector<std::string> upgrades;
     float energy_cost;
 
     // Include UI-related methods
     UNIT_UI_PRIVATE_METHODS
 
+    void BindTickParameters();
     void InitializeStorage();
     void UpdateStorage();
 
@@ -235,6 +337,8 @@ private:
     void InitializeGenericModules();
 
     void UpdateUnitStatus();
+    bool FlushOverflow();                   // true if the buffer changed
+    void ModulesChanged() { moduleRevision++; stateRevision++; Wake(); }
 
     Vector2 WorldToGrid(Vector2 worldPos) const;
 
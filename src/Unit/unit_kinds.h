@@ -0,0 +1,100 @@
+#ifndef UNIT_KINDS_H
+#define UNIT_KINDS_H
+
+#include <string>
+#include "game_enums.h"
+
+// String names for the unit/module enums. Only UI, logging and the TOML
+// loader need these; the simulation compares enums.
+
+inline const char* UnitTypeToString(UnitType type)
+{
+    switch (type)
+    {
+        case UnitType::Extraction:   return "Extraction";
+        case UnitType::Farming:      return "Farming";
+        case UnitType::Energy:       return "Energy";
+        case UnitType::Construction: return "Construction";
+        case UnitType::Transport:    return "Transport";
+        case UnitType::Manufacture:  return "Manufacture";
+        case UnitType::Research:     return "Research";
+        case UnitType::Commerce:     return "Commerce";
+    }
+    return "Unknown";
+}
+
+// Returns false for names with no UnitType. "Communication" is the name
+// sects give their Commerce unit.
+inline bool UnitTypeFromString(const std::string& name, UnitType& out)
+{
+    static const UnitType all[] = {
+        UnitType::Extraction, UnitType::Farming, UnitType::Energy, UnitType::Construction,
+        UnitType::Transport, UnitType::Manufacture, UnitType::Research, UnitType::Commerce
+    };
+    for (UnitType type : all)
+    {
+        if (name == UnitTypeToString(type))
+        {
+            out = type;
+            return true;
+        }
+    }
+    if (name == "Communication")
+    {
+        out = UnitType::Commerce;
+        return true;
+    }
+    return false;
+}
+
+inline const char* UnitStatusToString(UnitStatus status)
+{
+    return status == UnitStatus::ACTIVE ? "active" : "inactive";
+}
+
+inline const char* ModuleKindToString(ModuleKind kind)
+{
+    switch (kind)
+    {
+        case ModuleKind::GENERIC:       return "GENERIC";
+        case ModuleKind::PROSPECTING:   return "PROSPECTING";
+        case ModuleKind::EXCAVATION:    return "EXCAVATION";
+        case ModuleKind::BENEFICIATION: return "BENEFICIATION";
+        case ModuleKind::OPERATIONS:    return "OPERATIONS";
+        case ModuleKind::DIRECTIVES:    return "DIRECTIVES";
+        case ModuleKind::IRRIGATION:    return "IRRIGATION";
+        case ModuleKind::GREENHOUSE:    return "GREENHOUSE";
+        case ModuleKind::HYDROPONICS:   return "HYDROPONICS";
+        case ModuleKind::HARVEST:       return "HARVEST";
+        case ModuleKind::STORAGE:       return "STORAGE";
+        case ModuleKind::SOLAR_ARRAY:   return "SOLAR_ARRAY";
+        case ModuleKind::BATTERY:       return "BATTERY";
+        case ModuleKind::NUCLEAR:       return "NUCLEAR";
+        case ModuleKind::GRID:          return "GRID";
+        case ModuleKind::EMERGENCY:     return "EMERGENCY";
+        case ModuleKind::FABRICATION:   return "FABRICATION";
+        case ModuleKind::ASSEMBLY:      return "ASSEMBLY";
+        case ModuleKind::QUALITY:       return "QUALITY";
+        case ModuleKind::LOGISTICS:     return "LOGISTICS";
+        case ModuleKind::AUTOMATION:    return "AUTOMATION";
+        case ModuleKind::LABORATORY:    return "LABORATORY";
+        case ModuleKind::ANALYSIS:      return "ANALYSIS";
+        case ModuleKind::SIMULATION:    return "SIMULATION";
+        case ModuleKind::ARCHIVE:       return "ARCHIVE";
+        case ModuleKind::PUBLICATION:   return "PUBLICATION";
+    }
+    return "GENERIC";
+}
+
+// Unknown names map to GENERIC
+inline ModuleKind ModuleKindFromString(const std::string& name)
+{
+    for (int i = 0; i <= static_cast<int>(ModuleKind::PUBLICATION); i++)
+    {
+        ModuleKind kind = static_cast<ModuleKind>(i);
+        if (name == ModuleKindToString(kind)) return kind;
+    }
+    return ModuleKind::GENERIC;
+}
+
+#endif // UNIT_KINDS_H
@@ -1,4 +1,5 @@
 #include "unit.h"
+#include "command.h"
 
 void Unit::DrawTopBar() {
     const int barHeight = 60;
@@ -94,27 +95,19 @@ void Unit::DrawResourceStats(int startX, int startY, int panelWidth) {
                 startX, startY, fontSize, BLACK);
         startY += rowHeight;
 
-        DrawText(TextFormat("Status: %s", status.c_str()),
+        DrawText(TextFormat("Status: %s", UnitStatusToString(status)),
                 startX, startY, fontSize,
-                status == "active" ? darkGreen : GRAY);
+                IsActive() ? darkGreen : GRAY);
         startY += rowHeight * 2;
 
         // Aggregate all rates from active modules
-        std::map<ResourceType, float> totalProduction;
-        std::map<ResourceType, float> totalConsumption;
+        ResourceVector totalProduction;
+        ResourceVector totalConsumption;
 
         for (int moduleIndex : activeModuleIndices) {
             const UnitModule& module = modules[moduleIndex];
-
-            // Aggregate production rates
-            for (const auto& [type, rate] : module.productionRates) {
-                totalProduction[type] += rate;
-            }
-
-            // Aggregate consumption rates
-            for (const auto& [type, rate] : module.consumptionRates) {
-                totalConsumption[type] += rate;
-            }
+            totalProduction += module.productionRates;
+            totalConsumption += module.consumptionRates;
         }
 
         // Column headers for rates
@@ -126,8 +119,8 @@ void Unit::DrawResourceStats(int startX, int startY, int panelWidth) {
 
         // Draw aggregated rates
         for (const auto& [type, name] : resources) {
-            float prodRate = totalProduction[type];
-            float consRate = totalConsumption[type];
+            float prodRate = totalProduction.Get(type);
+            float consRate = totalConsumption.Get(type);
 
             if (prodRate > 0 || consRate > 0) {
                 DrawText(name, startX, startY, fontSize, BLACK);
@@ -181,7 +174,7 @@ void Unit::DrawResourceStats(int startX, int startY, int panelWidth) {
     }
 }
 
-void Unit::DrawControlPanel() {
+void Unit::DrawControlPanel(CommandSink* commands) {
     const int rightPanelWidth = 300;
     const int topMargin = 60;
     const int padding = 10;
@@ -217,7 +210,8 @@ void Unit::DrawControlPanel() {
                     20, WHITE);
 
             if (canBuild && IsModuleButtonClicked(buildButton)) {
-                BuildModule(selectedModuleIndex);  // You'll need to implement this
+                if (commands) commands->SubmitFor(this, Command(CommandType::BUILD_MODULE, selectedModuleIndex));
+                else BuildModule(selectedModuleIndex);
             }
         }
         // Draw upgrade button if built and not max level
@@ -246,7 +240,8 @@ void Unit::DrawControlPanel() {
                     20, WHITE);
 
             if (canUpgrade && IsModuleButtonClicked(upgradeButton)) {
-                UpgradeModule(selectedModuleIndex);
+                if (commands) commands->SubmitFor(this, Command(CommandType::UPGRADE_MODULE, selectedModuleIndex));
+                else UpgradeModule(selectedModuleIndex);
             }
         }
 
@@ -278,7 +273,8 @@ void Unit::DrawControlPanel() {
 
             // Only handle activation on actual click
             if (IsModuleButtonClicked(toggleButton)) {
-                HandleModuleActivation(selectedModuleIndex);
+                if (commands) commands->SubmitFor(this, Command(CommandType::TOGGLE_MODULE, selectedModuleIndex));
+                else HandleModuleActivation(selectedModuleIndex);
             }
         }
     }
@@ -379,10 +375,12 @@ void Unit::DrawControlPanel() {
                     if (CheckCollisionPointRec(GetMousePosition(), buttonRect)) {
                         buttonColor = Fade(buttonColor, 0.7f);
                         if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
-                            module.productionRates[resource] = buttonRate;
+                            Command setRate(CommandType::SET_PRODUCTION_RATE, firstActiveModule,
+                                            static_cast<int>(resource), 0, buttonRate);
+                            if (commands) commands->SubmitFor(this, setRate);
+                            else SetModuleProductionRate(firstActiveModule, resource, buttonRate);
                             ShowMessage(TextFormat("%s production rate set to %.1f",
                                                  resourceName.c_str(), buttonRate));
-                            CalculateConsumption();  // Recalculate consumption when production changes
                         }
                     }
 
@@ -712,149 +710,35 @@ void Unit::DrawMultilineText(const std::string& text, int x, int y, int fontSize
     }
 }
 
-void Unit::ShowMessage(const std::string& text) {
-    currentMessage.text = text;
-    currentMessage.opacity = 1.0f;
-    currentMessage.timeRemaining = 2.0f;
-}
-
-void Unit::UpdateMessage(float deltaTime) {
-    if (currentMessage.timeRemaining > 0) {
-        currentMessage.timeRemaining -= deltaTime;
-        if (currentMessage.timeRemaining <= 0.5f) {
-            currentMessage.opacity = currentMessage.timeRemaining / 0.5f;
-        }
-    }
-}
-
 bool Unit::IsModuleButtonClicked(Rectangle buttonRect) {
     Vector2 mousePoint = GetMousePosition();
     return CheckCollisionPointRec(mousePoint, buttonRect) && IsMouseButtonPressed(MOUSE_BUTTON_LEFT);
 }
 
-void Unit::HandleModuleActivation(int moduleIndex) {
-    if (moduleIndex < 0 || moduleIndex >= modules.size()) {
-        return;
-    }
-
-    UnitModule& module = modules[moduleIndex];
-    if (!module.isBuilt) {
-        ShowMessage("Module needs to be built first");
-        return;
-    }
-
-    // Toggle the selected module's active state
-    if (module.isActive) {
-        // Deactivate the module
-        if (DeactivateModule(moduleIndex)) {
-            ShowMessage(module.name + " deactivated");
-        }
-    } else {
-        // Activate the module (allows multiple active modules now)
-        if (ActivateModule(moduleIndex)) {
-            ShowMessage(module.name + " activated");
-        }
-    }
-}
-
-bool Unit::CanUpgradeModule(const UnitModule& module) {
-    if (!module.isBuilt || module.level >= 5) return false;
-
-    // Safely check if next level costs exist
-    auto costIter = module.upgradeCosts.find(module.level + 1);
-    if (costIter == module.upgradeCosts.end()) {
-        return false;
-    }
-
-    // Check if we have required resources for upgrade
-    for (const auto& [resource, amount] : costIter->second) {
-        if (resourceStorage[resource] < amount) {
-            return false;
-        }
-    }
-    return true;
-}
-
-bool Unit::CanBuildModule(const UnitModule& module) {
-    if (module.isBuilt) return false;
-
-    // Safely check if level 1 costs exist
-    auto costIter = module.upgradeCosts.find(1);  // Changed from .at() to .find()
-    if (costIter == module.upgradeCosts.end()) {
-        return false;
-    }
-
-    // Check if we have required resources for initial build
-    for (const auto& [resource, amount] : costIter->second) {
-        if (resourceStorage[resource] < amount) {
-            return false;
-        }
-    }
-    return true;
-}
-
-// Public wrapper methods for RenderManager access
-bool Unit::PublicCanUpgradeModule(int moduleIndex) const {
-    if (moduleIndex < 0 || moduleIndex >= static_cast<int>(modules.size())) return false;
-    return const_cast<Unit*>(this)->CanUpgradeModule(modules[moduleIndex]);
-}
-
-bool Unit::PublicCanBuildModule(int moduleIndex) const {
-    if (moduleIndex < 0 || moduleIndex >= static_cast<int>(modules.size())) return false;
-    return const_cast<Unit*>(this)->CanBuildModule(modules[moduleIndex]);
-}
-
-void Unit::PublicBuildModule(int moduleIndex) {
-    BuildModule(moduleIndex);
-}
-
-void Unit::PublicHandleModuleActivation(int moduleIndex) {
-    HandleModuleActivation(moduleIndex);
-}
-
-void Unit::PublicShowMessage(const std::string& text) {
-    ShowMessage(text);
-}
-
-void Unit::BuildModule(int moduleIndex) {
-    if (moduleIndex < 0 || moduleIndex >= modules.size()) return;
+void Unit::DrawInUnitView(CommandSink* commands) {
+    const int screenWidth = GetScreenWidth();
+    const int screenHeight = GetScreenHeight();
 
-    UnitModule& module = modules[moduleIndex];
-    if (module.isBuilt) return;
+    // Draw main background
+    DrawRectangle(0, 0, screenWidth, screenHeight, RAYWHITE);
 
-    // Safely get level 1 costs
-    auto costIter = module.upgradeCosts.find(1);
-    if (costIter == module.upgradeCosts.end()) {
-        ShowMessage("Error: No build costs defined!");
-        return;
-    }
+    // Draw UI sections
+    DrawTopBar();
+    DrawBottomBar();
 
-    bool inquiryRequired = false;
-    std::map<ResourceType, float> requiredResources;
-    // Check resources
-    for (const auto& [resource, amount] : costIter->second) {
-        if (amount < resourceStorage[resource]) {
-            inquiryRequired = true;
-            requiredResources[resource] = amount;
-        }
+    // Draw three-panel layout
+    if (isInModuleView) {
+        DrawModuleList();
+        DrawModuleDetails();
+        DrawControlPanel(commands);
 
-    }
 
-    if (!inquiryRequired) {
-        // Consume resources
-        for (const auto& [resource, amount] : costIter->second) {
-            resourceStorage[resource] -= amount;
-        }
+    } else {
+        DrawModuleList();
+        DrawResourcePanel();
+        DrawControlPanel(commands);
 
-        module.isBuilt = true;
-        module.level = 1;
-        ShowMessage(module.name + "Module was built successfully!");
-    } else{
-        ShowMessage(module.name + "Anticipating resources from Sect!");
     }
 
-
-    module.isBuilt = true;
-    module.level = 1;
-    ShowMessage(module.name + " built successfully!");
+    UpdateMessage(GetFrameTime());
 }
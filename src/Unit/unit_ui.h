@@ -34,7 +34,7 @@ struct UIMessage {
     void DrawModuleDetails(); \
     void DrawResourcePanel(); \
     void DrawResourceStats(int startX, int startY, int panelWidth); \
-    void DrawControlPanel(); \
+    void DrawControlPanel(CommandSink* commands); \
     void ShowMessage(const std::string& text); \
     void UpdateMessage(float deltaTime); \
     bool IsModuleButtonClicked(Rectangle buttonRect); \
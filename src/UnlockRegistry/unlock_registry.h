@@ -1,11 +1,15 @@
 #ifndef UNLOCK_REGISTRY_H
 #define UNLOCK_REGISTRY_H
 
+#include <mutex>
 #include <set>
+#include <shared_mutex>
 #include <string>
 #include <vector>
 #include <iostream>
 
+// Process-wide set of unlocked technologies. Read by the renderer while
+// the sim thread may unlock, so every access takes the lock.
 class UnlockRegistry {
 public:
     static UnlockRegistry& Instance()
@@ -16,22 +20,35 @@ public:
 
     void Unlock(const std::string& tech)
     {
-        unlockedTechs.insert(tech);
+        {
+            std::unique_lock<std::shared_mutex> lock(mutex);
+            unlockedTechs.insert(tech);
+        }
         std::cout << "UNLOCKED: " << tech << std::endl;
     }
 
     bool IsUnlocked(const std::string& tech) const
     {
+        std::shared_lock<std::shared_mutex> lock(mutex);
         return unlockedTechs.count(tech) > 0;
     }
 
     std::vector<std::string> GetAll() const
     {
+        std::shared_lock<std::shared_mutex> lock(mutex);
         return std::vector<std::string>(unlockedTechs.begin(), unlockedTechs.end());
     }
 
+    // Replaces the unlocked set with a saved one (SaveGame::Load)
+    void Restore(const std::vector<std::string>& techs)
+    {
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        unlockedTechs = std::set<std::string>(techs.begin(), techs.end());
+    }
+
     void PrintStatus() const
     {
+        std::shared_lock<std::shared_mutex> lock(mutex);
         std::cout << "\n=== UNLOCK REGISTRY ===" << std::endl;
         if (unlockedTechs.empty())
         {
@@ -74,6 +91,7 @@ private:
     UnlockRegistry(const UnlockRegistry&) = delete;
     UnlockRegistry& operator=(const UnlockRegistry&) = delete;
 
+    mutable std::shared_mutex mutex;
     std::set<std::string> unlockedTechs;
 };
 
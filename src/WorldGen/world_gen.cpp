@@ -0,0 +1,372 @@
+#include "world_gen.h"
+#include "colony.h"
+#include "sect.h"
+#include "unit.h"
+#include "resource_manager.h"
+#include "time_manager.h"
+#include "prospecting_system.h"
+#include "separation_node.h"
+#include "game_constants.h"
+#include "sim_log.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <sstream>
+
+namespace {
+    const int MAX_MODULE_TIER = 3;
+    const int MAX_SAMPLES_PER_UNIT = 6;
+    const int MAX_SEPARATION_NODES = 4;
+
+    void SetError(std::string* error, const std::string& message) {
+        if (error) *error = message;
+    }
+
+    // mt19937 output is fixed by the standard, the std distributions are
+    // not; mapping the raw output here keeps worlds equal across
+    // standard libraries
+    class WorldRandom {
+    public:
+        explicit WorldRandom(unsigned int seed) : engine(seed) {}
+
+        float Unit() { return (engine() >> 8) * (1.0f / 16777216.0f); }
+        bool Roll(float chance) { return Unit() < chance; }
+        int Range(int lo, int hi) {
+            return lo + static_cast<int>(engine() % static_cast<uint32_t>(hi - lo + 1));
+        }
+        int Weighted(const float* weights, int count) {
+            float total = 0.0f;
+            for (int i = 0; i < count; i++) total += weights[i];
+            float pick = Unit() * total;
+            for (int i = 0; i < count; i++) {
+                if (pick < weights[i]) return i;
+                pick -= weights[i];
+            }
+            return count - 1;
+        }
+
+    private:
+        std::mt19937 engine;
+    };
+
+    const ResourceType BASIC_RESOURCES[] = {
+        ResourceType::Fe, ResourceType::Ti, ResourceType::Si, ResourceType::Al,
+        ResourceType::Ca, ResourceType::H2, ResourceType::O2, ResourceType::C
+    };
+    const int BASIC_RESOURCE_COUNT = sizeof(BASIC_RESOURCES) / sizeof(BASIC_RESOURCES[0]);
+
+    SeparationNode MakeSeparationNode(int kind) {
+        switch (kind) {
+            case 0:  return SeparationNodes::CreateSizeSort();
+            case 1:  return SeparationNodes::CreateMagnetic();
+            case 2:  return SeparationNodes::CreateElectrostatic();
+            case 3:  return SeparationNodes::CreateThermal();
+            default: return SeparationNodes::CreateMRE();
+        }
+    }
+
+    bool ParseInt(const std::string& text, int lo, int hi, int& out) {
+        char* end = nullptr;
+        long value = std::strtol(text.c_str(), &end, 10);
+        if (text.empty() || *end != '\0' || value < lo || value > hi) return false;
+        out = static_cast<int>(value);
+        return true;
+    }
+
+    bool ParseFloat(const std::string& text, float lo, float hi, float& out) {
+        char* end = nullptr;
+        float value = std::strtof(text.c_str(), &end);
+        if (text.empty() || *end != '\0' || !(value >= lo && value <= hi)) return false;
+        out = value;
+        return true;
+    }
+
+    // The shortest %g that reads back as the same float
+    std::string FormatFloat(float value) {
+        char text[32];
+        for (int precision = 6; precision < 9; precision++) {
+            std::snprintf(text, sizeof(text), "%.*g", precision, value);
+            if (std::strtof(text, nullptr) == value) return text;
+        }
+        std::snprintf(text, sizeof(text), "%.9g", value);
+        return text;
+    }
+
+    bool ApplyPreset(const std::string& name, WorldSpec& spec) {
+        if (name == "small") {
+            spec.colonies = 4;
+            spec.minSects = 4;
+            spec.maxSects = 8;
+        } else if (name == "large") {
+            spec.colonies = 20;
+            spec.minSects = 16;
+            spec.maxSects = 24;
+            spec.extraRoads = 1.0f;
+            spec.maxTier = 3;
+            spec.packets = 1000;
+        } else if (name == "huge") {
+            spec.colonies = 64;
+            spec.minSects = 24;
+            spec.maxSects = 40;
+            spec.extraRoads = 1.5f;
+            spec.maxTier = 3;
+            spec.packets = 10000;
+        } else {
+            return false;
+        }
+        spec.modeWeights[0] = 6.0f;
+        spec.modeWeights[1] = 2.0f;
+        spec.modeWeights[2] = 2.0f;
+        return true;
+    }
+
+    bool ApplyPair(const std::string& key, const std::string& value, WorldSpec& spec) {
+        if (key == "seed") {
+            int seed = 0;
+            if (!ParseInt(value, 1, 0x7fffffff, seed)) return false;
+            spec.seed = static_cast<unsigned int>(seed);
+            return true;
+        }
+        if (key == "colonies") return ParseInt(value, 1, 4096, spec.colonies);
+        if (key == "sects") {
+            size_t dash = value.find('-');
+            if (dash == std::string::npos) {
+                if (!ParseInt(value, 1, 4096, spec.minSects)) return false;
+                spec.maxSects = spec.minSects;
+                return true;
+            }
+            return ParseInt(value.substr(0, dash), 1, 4096, spec.minSects) &&
+                   ParseInt(value.substr(dash + 1), spec.minSects, 4096, spec.maxSects);
+        }
+        if (key == "roads") return ParseFloat(value, 0.0f, 64.0f, spec.extraRoads);
+        if (key == "modes") {
+            std::stringstream list(value);
+            std::string weight;
+            float weights[3];
+            int count = 0;
+            while (std::getline(list, weight, ':')) {
+                if (count == 3 || !ParseFloat(weight, 0.0f, 1e6f, weights[count])) return false;
+                count++;
+            }
+            if (count != 3 || weights[0] + weights[1] + weights[2] <= 0.0f) return false;
+            std::copy(weights, weights + 3, spec.modeWeights);
+            return true;
+        }
+        if (key == "active") return ParseFloat(value, 0.0f, 1.0f, spec.unitActive);
+        if (key == "build") return ParseFloat(value, 0.0f, 1.0f, spec.moduleBuilt);
+        if (key == "tier") return ParseInt(value, 0, MAX_MODULE_TIER, spec.maxTier);
+        if (key == "separation") return ParseFloat(value, 0.0f, 1.0f, spec.separation);
+        if (key == "prospecting") return ParseFloat(value, 0.0f, 1.0f, spec.prospecting);
+        if (key == "packets") return ParseInt(value, 0, 10000000, spec.packets);
+        return false;
+    }
+
+    void EquipUnit(Unit* unit, const WorldSpec& spec, TimeManager& time, WorldRandom& random,
+                   WorldStats& stats) {
+        const std::vector<Unit::UnitModule>& modules = unit->GetModules();
+        for (int m = 0; m < static_cast<int>(modules.size()); m++) {
+            if (!modules[m].isBuilt) {
+                if (!random.Roll(spec.moduleBuilt)) continue;
+                unit->DebugBuildModule(m);
+                stats.modulesBuilt++;
+            }
+            int tier = random.Range(0, spec.maxTier);
+            while (modules[m].tier < tier && unit->DebugUpgradeModuleTier(m)) {
+                stats.moduleTiers++;
+            }
+        }
+
+        if (random.Roll(spec.unitActive)) {
+            unit->Start();
+        } else {
+            unit->Stop();
+        }
+        stats.units++;
+        if (unit->IsActive()) stats.activeUnits++;
+
+        // SetDirective refuses what the Directives tier does not allow
+        bool hasDirectives = std::any_of(modules.begin(), modules.end(), [](const Unit::UnitModule& module) {
+            return module.kind == ModuleKind::DIRECTIVES && module.isActive;
+        });
+        if (hasDirectives) {
+            Unit::ActiveDirective directive;
+            directive.type = static_cast<Unit::DirectiveType>(
+                random.Range(0, static_cast<int>(Unit::DirectiveType::THERMAL_SYNC)));
+            directive.targetResource = BASIC_RESOURCES[random.Range(0, BASIC_RESOURCE_COUNT - 1)];
+            unit->SetDirective(directive);
+            if (unit->GetDirective().type != Unit::DirectiveType::NONE) stats.directives++;
+        }
+
+        if (unit->GetType() != UnitType::Extraction) return;
+
+        if (random.Roll(spec.separation)) {
+            int nodes = random.Range(1, MAX_SEPARATION_NODES);
+            for (int n = 0; n < nodes; n++) {
+                unit->AddSeparationNode(MakeSeparationNode(random.Range(0, 4)));
+            }
+            stats.separationNodes += nodes;
+        }
+
+        ProspectingSystem* prospecting = unit->GetProspectingSystem();
+        if (!prospecting || !random.Roll(spec.prospecting)) return;
+
+        // What a player does on the prospecting tabs, at whatever the tier allows
+        stats.prospectingUnits++;
+        prospecting->gameTime = time.GetGameTime();
+        ProspectingGrid& grid = prospecting->GetGrid();
+        for (int band = 0; band < SWEEP_FREQUENCY_BANDS; band++) {
+            if (prospecting->GetSweep().CanSweep(grid, band)) {
+                prospecting->GetSweep().ExecuteSweep(grid, band, prospecting->gameTime);
+            }
+        }
+        SampleTray& tray = prospecting->GetTray();
+        int attempts = random.Range(1, MAX_SAMPLES_PER_UNIT);
+        for (int s = 0; s < attempts && !tray.IsFull(); s++) {
+            int subX = random.Range(0, grid.GetGridSize() - 1);
+            int subY = random.Range(0, grid.GetGridSize() - 1);
+            DepthLayer depth = static_cast<DepthLayer>(random.Range(0, static_cast<int>(DepthLayer::DEEP)));
+            if (!prospecting->GetSampler().CanDrill(depth)) continue;
+            prospecting->GetSampler().CollectSample(grid, tray, subX, subY, depth);
+        }
+        for (int s = 0; s < tray.GetCount(); s++) {
+            Sample& sample = *tray.GetSampleByIndex(s);
+            AnalysisTool tool = static_cast<AnalysisTool>(
+                random.Range(0, static_cast<int>(AnalysisTool::MAGNETIC_SUSCEPTIBILITY)));
+            if (random.Roll(0.5f) && prospecting->GetLab().CanApplyTool(sample, tool)) {
+                prospecting->GetLab().ApplyTool(sample, tool, prospecting->gameTime);
+            }
+        }
+        stats.samples += tray.GetCount();
+    }
+}
+
+bool ParseWorldSpec(const std::string& text, WorldSpec& spec, std::string* error) {
+    spec = WorldSpec();
+    std::stringstream pairs(text);
+    std::string pair;
+    bool first = true;
+    while (std::getline(pairs, pair, ',')) {
+        size_t equals = pair.find('=');
+        if (equals == std::string::npos) {
+            if (!first || !ApplyPreset(pair, spec)) {
+                SetError(error, "unknown world preset: " + pair);
+                return false;
+            }
+        } else if (!ApplyPair(pair.substr(0, equals), pair.substr(equals + 1), spec)) {
+            SetError(error, "bad world spec pair: " + pair);
+            return false;
+        }
+        first = false;
+    }
+    return true;
+}
+
+std::string FormatWorldSpec(const WorldSpec& spec) {
+    std::ostringstream out;
+    out << "seed=" << spec.seed
+        << ",colonies=" << spec.colonies
+        << ",sects=" << spec.minSects << "-" << spec.maxSects
+        << ",roads=" << FormatFloat(spec.extraRoads)
+        << ",modes=" << FormatFloat(spec.modeWeights[0]) << ":" << FormatFloat(spec.modeWeights[1])
+        << ":" << FormatFloat(spec.modeWeights[2])
+        << ",active=" << FormatFloat(spec.unitActive)
+        << ",build=" << FormatFloat(spec.moduleBuilt)
+        << ",tier=" << spec.maxTier
+        << ",separation=" << FormatFloat(spec.separation)
+        << ",prospecting=" << FormatFloat(spec.prospecting)
+        << ",packets=" << spec.packets;
+    return out.str();
+}
+
+int WorldGridSize(const WorldSpec& spec) {
+    int perRow = static_cast<int>(std::ceil(std::sqrt(static_cast<float>(spec.colonies))));
+    int cellsPerColony = static_cast<int>(std::ceil(2.0f * std::sqrt(static_cast<float>(spec.maxSects)))) + 4;
+    return std::max(PLANET_SIZE, perRow * cellsPerColony);
+}
+
+void GenerateWorld(const WorldSpec& spec, ResourceManager& resources, TimeManager& time,
+                   std::vector<Colony*>& outColonies, const SimClock* clock, WorldStats* stats) {
+    WorldStats built;
+    WorldRandom random(spec.seed);
+    resources.GenerateResourceMap(spec.seed);
+
+    const float cellSize = resources.GetCellSize();
+    const float extent = resources.GetGridSize() * cellSize;
+    const int perRow = static_cast<int>(std::ceil(std::sqrt(static_cast<float>(spec.colonies))));
+    const float spacing = extent / perRow;
+    auto clampToPlanet = [&](float value) { return std::min(extent - 1.0f, std::max(0.0f, value)); };
+
+    size_t firstColony = outColonies.size();
+    for (int c = 0; c < spec.colonies; c++) {
+        // Lattice sites, jittered so colonies do not line up exactly
+        Vector2 centre = {
+            clampToPlanet((c % perRow + 0.5f + (random.Unit() - 0.5f) * 0.3f) * spacing),
+            clampToPlanet((c / perRow + 0.5f + (random.Unit() - 0.5f) * 0.3f) * spacing)
+        };
+
+        Colony* colony = new Colony();
+        colony->SetArchetype(resources.GetSiteArchetype(static_cast<int>(centre.x / cellSize),
+                                                        static_cast<int>(centre.y / cellSize)));
+        colony->SetClock(clock);
+
+        // Golden-angle spiral, roughly one cell between neighbours
+        int sectCount = random.Range(spec.minSects, spec.maxSects);
+        for (int s = 0; s < sectCount; s++) {
+            float angle = s * 2.39996f;
+            float radius = cellSize * std::sqrt(static_cast<float>(s));
+            Vector2 position = {clampToPlanet(centre.x + radius * std::cos(angle)),
+                                clampToPlanet(centre.y + radius * std::sin(angle))};
+            Sect* sect = new Sect(position, resources, time);
+            colony->AddSect(sect);
+            for (Unit* unit : sect->GetUnits()) {
+                EquipUnit(unit, spec, time, random, built);
+            }
+        }
+
+        // A chain so every sect is connected, then random extra pairs
+        const std::vector<Sect*>& sects = colony->GetSects();
+        for (int s = 1; s < sectCount; s++) {
+            colony->BuildRoad(sects[s - 1], sects[s]);
+        }
+        int spare = sectCount * (sectCount - 1) / 2 - (sectCount - 1);
+        int extra = std::min(spare, static_cast<int>(std::lround(spec.extraRoads * sectCount)));
+        for (int attempt = 0; extra > 0 && attempt < extra * 8 + 16; attempt++) {
+            Sect* a = sects[random.Range(0, sectCount - 1)];
+            Sect* b = sects[random.Range(0, sectCount - 1)];
+            if (a == b || colony->GetRoad(a, b)) continue;
+            colony->BuildRoad(a, b);
+            extra--;
+        }
+
+        // Road pointers are stable once every road is built
+        for (const Road& road : colony->GetRoads()) {
+            int mode = random.Weighted(spec.modeWeights, 3);
+            colony->SetRoadTransportMode(colony->GetRoad(road.sectA, road.sectB), static_cast<TransportMode>(mode));
+            built.roadsByMode[mode]++;
+        }
+        built.sects += sectCount;
+        built.roads += static_cast<int>(colony->GetRoads().size());
+        outColonies.push_back(colony);
+    }
+    built.colonies = spec.colonies;
+
+    std::vector<std::pair<Colony*, Road*>> roads;
+    for (size_t c = firstColony; c < outColonies.size(); c++) {
+        for (const Road& road : outColonies[c]->GetRoads()) {
+            roads.push_back({outColonies[c], outColonies[c]->GetRoad(road.sectA, road.sectB)});
+        }
+    }
+    for (int p = 0; !roads.empty() && p < spec.packets; p++) {
+        auto& target = roads[p % roads.size()];
+        ResourceType type = BASIC_RESOURCES[random.Range(0, BASIC_RESOURCE_COUNT - 1)];
+        target.first->AddSyntheticTransportJob(target.second, type, TRANSPORT_PACKET_SIZE, random.Unit());
+        built.packets++;
+    }
+
+    COLONY_LOG_INFO(Colony, "[WORLDGEN] " << built.colonies << " colonies, " << built.sects << " sects, "
+                    << built.roads << " roads, " << built.packets << " packets from "
+                    << FormatWorldSpec(spec));
+    if (stats) *stats = built;
+}
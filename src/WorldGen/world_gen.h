@@ -0,0 +1,87 @@
+#ifndef WORLD_GEN_H
+#define WORLD_GEN_H
+
+#include <string>
+#include <vector>
+
+class Colony;
+class ResourceManager;
+class SimClock;
+class TimeManager;
+
+// Synthetic worlds for stress runs: far more colonies, sects, roads and
+// unit state than anyone builds by hand, from a few numbers and a seed.
+// The same spec always generates the same world, planet map included, so
+// benchmarks, previews and save tests can name a world by its spec.
+//
+// Specs are written as comma-separated key=value pairs, optionally led by
+// a preset that the pairs then override:
+//
+//   large,seed=7,packets=2000
+//   colonies=12,sects=8-24,roads=1.5,modes=6:2:2,tier=3
+//
+//   seed         map, layout and every roll (not 0)
+//   colonies     colony count
+//   sects        sects per colony, N or MIN-MAX (drawn uniformly)
+//   roads        roads per sect on top of the chain joining a colony's sects
+//   modes        AUTO_BALANCE:MANUAL:DEFICIT_TRIGGERED road weights
+//   active       chance a unit is running
+//   build        chance a module the unit lacks is built anyway
+//   tier         module tiers drawn from 0..tier (at most 3)
+//   separation   chance an extraction unit gets a separation chain
+//   prospecting  chance an extraction unit has swept, sampled and analysed
+//   packets      transport packets spread round-robin over every road
+//
+// Presets: small (4 x 4-8 sects), large (20 x 16-24), huge (64 x 24-40).
+struct WorldSpec {
+    unsigned int seed = 1;
+    int colonies = 4;
+    int minSects = 4;
+    int maxSects = 8;
+    float extraRoads = 0.5f;
+    float modeWeights[3] = {1.0f, 0.0f, 0.0f};
+    float unitActive = 0.6f;
+    float moduleBuilt = 0.3f;
+    int maxTier = 2;
+    float separation = 0.5f;
+    float prospecting = 0.5f;
+    int packets = 0;
+};
+
+// What GenerateWorld built
+struct WorldStats {
+    int colonies = 0;
+    int sects = 0;
+    int roads = 0;
+    int roadsByMode[3] = {0, 0, 0};     // indexed by TransportMode
+    int units = 0;
+    int activeUnits = 0;
+    int modulesBuilt = 0;               // built by the generator, not by default
+    int moduleTiers = 0;                // tier upgrades over every module
+    int directives = 0;
+    int separationNodes = 0;
+    int prospectingUnits = 0;
+    int samples = 0;
+    int packets = 0;
+};
+
+// Parses `text` into `spec`, which starts from the defaults above. False,
+// with a message naming the bad pair, on an unknown key, preset or value.
+bool ParseWorldSpec(const std::string& text, WorldSpec& spec, std::string* error);
+
+// The spec as key=value pairs that parse back to the same spec
+std::string FormatWorldSpec(const WorldSpec& spec);
+
+// Planet cells per side that give every colony room: at least PLANET_SIZE
+int WorldGridSize(const WorldSpec& spec);
+
+// Regenerates the planet map of `resources` from the spec's seed, then
+// appends the spec's colonies to `outColonies` (which the caller owns),
+// laid out on a lattice over whatever grid `resources` has. Colonies are
+// put on `clock` when one is given. Module builds and tiers skip their
+// costs, as the debug keys do.
+void GenerateWorld(const WorldSpec& spec, ResourceManager& resources, TimeManager& time,
+                   std::vector<Colony*>& outColonies, const SimClock* clock = nullptr,
+                   WorldStats* stats = nullptr);
+
+#endif // WORLD_GEN_H
@@ -0,0 +1,65 @@
+#include "balance_params.h"
+#include <cstddef>
+
+namespace {
+    const BalanceParams DEFAULT_BALANCE;
+    thread_local const BalanceParams* current = &DEFAULT_BALANCE;
+
+    struct ParamField {
+        const char* name;
+        float* (*get)(BalanceParams&);
+    };
+
+    const ParamField PARAM_FIELDS[] = {
+        {"STORAGE_SURPLUS_THRESHOLD", [](BalanceParams& p) { return &p.storageSurplusThreshold; }},
+        {"STORAGE_DEFICIT_THRESHOLD", [](BalanceParams& p) { return &p.storageDeficitThreshold; }},
+        {"DEFICIT_REQUEST_AMOUNT", [](BalanceParams& p) { return &p.deficitRequestAmount; }},
+        {"AUTO_BALANCE_THRESHOLD", [](BalanceParams& p) { return &p.autoBalanceThreshold; }},
+        {"STORAGE_LEVEL_MULTIPLIERS_0", [](BalanceParams& p) { return &p.storageLevelMultipliers[0]; }},
+        {"STORAGE_LEVEL_MULTIPLIERS_1", [](BalanceParams& p) { return &p.storageLevelMultipliers[1]; }},
+        {"STORAGE_LEVEL_MULTIPLIERS_2", [](BalanceParams& p) { return &p.storageLevelMultipliers[2]; }},
+        {"STORAGE_LEVEL_MULTIPLIERS_3", [](BalanceParams& p) { return &p.storageLevelMultipliers[3]; }},
+        {"MODULE_TIER_MULTIPLIERS_0", [](BalanceParams& p) { return &p.moduleTierMultipliers[0]; }},
+        {"MODULE_TIER_MULTIPLIERS_1", [](BalanceParams& p) { return &p.moduleTierMultipliers[1]; }},
+        {"MODULE_TIER_MULTIPLIERS_2", [](BalanceParams& p) { return &p.moduleTierMultipliers[2]; }},
+        {"MODULE_TIER_MULTIPLIERS_3", [](BalanceParams& p) { return &p.moduleTierMultipliers[3]; }},
+        {"SURVEY_UNSCANNED_EFFICIENCY", [](BalanceParams& p) { return &p.surveyUnscannedEfficiency; }},
+        {"SURVEY_SCANNED_BONUS", [](BalanceParams& p) { return &p.surveyScannedBonus; }},
+        {"SURVEY_MARKED_SITE_BONUS", [](BalanceParams& p) { return &p.surveyMarkedSiteBonus; }},
+        {"SEPARATION_EFFICIENCY", [](BalanceParams& p) { return &p.separationEfficiency; }},
+    };
+}
+
+float* BalanceParams::Find(const std::string& name) {
+    for (const ParamField& field : PARAM_FIELDS) {
+        if (name == field.name) return field.get(*this);
+    }
+    return nullptr;
+}
+
+const float* BalanceParams::Find(const std::string& name) const {
+    return const_cast<BalanceParams*>(this)->Find(name);
+}
+
+const std::vector<std::string>& BalanceParams::Names() {
+    static const std::vector<std::string> names = [] {
+        std::vector<std::string> list;
+        for (const ParamField& field : PARAM_FIELDS) list.push_back(field.name);
+        return list;
+    }();
+    return names;
+}
+
+const BalanceParams& Balance() {
+    return *current;
+}
+
+BalanceScope::BalanceScope(const BalanceParams& params)
+    : previous(current)
+{
+    current = &params;
+}
+
+BalanceScope::~BalanceScope() {
+    current = previous;
+}
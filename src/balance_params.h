@@ -0,0 +1,60 @@
+#ifndef BALANCE_PARAMS_H
+#define BALANCE_PARAMS_H
+
+#include "game_constants.h"
+#include <string>
+#include <vector>
+
+// The balance constants the simulation reads at run time, so a batch run
+// (BalanceRunner, tools/balance) can sweep them without rebuilding.
+// Defaults are the game_constants.h values, which the game never changes.
+//
+// Each thread has its own set: Balance() is the defaults until a
+// BalanceScope installs another, so games stepped on different threads can
+// run different balances side by side. Code that hands sim work to other
+// threads (SimStepper's job system) installs the caller's set there too.
+struct BalanceParams {
+    float storageSurplusThreshold = STORAGE_SURPLUS_THRESHOLD;
+    float storageDeficitThreshold = STORAGE_DEFICIT_THRESHOLD;
+    float deficitRequestAmount = DEFICIT_REQUEST_AMOUNT;
+    float autoBalanceThreshold = AUTO_BALANCE_THRESHOLD;
+    float storageLevelMultipliers[MAX_STORAGE_LEVEL + 1] = {
+        STORAGE_LEVEL_MULTIPLIERS[0], STORAGE_LEVEL_MULTIPLIERS[1],
+        STORAGE_LEVEL_MULTIPLIERS[2], STORAGE_LEVEL_MULTIPLIERS[3]};
+    float moduleTierMultipliers[4] = {
+        MODULE_TIER_MULTIPLIERS[0], MODULE_TIER_MULTIPLIERS[1],
+        MODULE_TIER_MULTIPLIERS[2], MODULE_TIER_MULTIPLIERS[3]};
+    float surveyUnscannedEfficiency = SURVEY_UNSCANNED_EFFICIENCY;
+    float surveyScannedBonus = SURVEY_SCANNED_BONUS;
+    float surveyMarkedSiteBonus = SURVEY_MARKED_SITE_BONUS;
+    float separationEfficiency = 1.0f;      // scales every separation node's output
+
+    // The field a parameter name refers to, or nullptr. Names are the
+    // game_constants.h ones, an index suffix picking an array element:
+    // AUTO_BALANCE_THRESHOLD, STORAGE_LEVEL_MULTIPLIERS_2,
+    // MODULE_TIER_MULTIPLIERS_3, SEPARATION_EFFICIENCY.
+    float* Find(const std::string& name);
+    const float* Find(const std::string& name) const;
+
+    // Every name Find knows, in a fixed order
+    static const std::vector<std::string>& Names();
+};
+
+// This thread's balance
+const BalanceParams& Balance();
+
+// Installs `params` as this thread's balance until it goes out of scope.
+// `params` must outlive it.
+class BalanceScope {
+public:
+    explicit BalanceScope(const BalanceParams& params);
+    ~BalanceScope();
+
+    BalanceScope(const BalanceScope&) = delete;
+    BalanceScope& operator=(const BalanceScope&) = delete;
+
+private:
+    const BalanceParams* previous;
+};
+
+#endif // BALANCE_PARAMS_H
@@ -34,6 +34,9 @@ const float DEFICIT_REQUEST_AMOUNT = 0.3f;     // Request enough to fill to 30%
 const int MAX_STORAGE_LEVEL = 3;
 const float STORAGE_LEVEL_MULTIPLIERS[] = {1.0f, 1.5f, 2.0f, 3.0f};
 
+// Extraction module rate multipliers by tier (0-3)
+const float MODULE_TIER_MULTIPLIERS[] = {1.0f, 1.4f, 1.9f, 2.5f};
+
 // Sect storage upgrade costs per level (Fe, Si, ENERGY)
 const float SECT_UPGRADE_COST_FE[]     = {0.0f, 100.0f, 250.0f, 500.0f};
 const float SECT_UPGRADE_COST_SI[]     = {0.0f,  50.0f, 150.0f, 300.0f};
@@ -59,6 +62,16 @@ const float AUTO_BALANCE_THRESHOLD = 0.3f;        // Difference threshold to tri
 const float MIN_TRANSPORT_INTERVAL = 3.0f;        // Minimum seconds between transport jobs on same road
 const int MAX_PACKETS_PER_ROAD = 3;               // Maximum concurrent packets on a road
 
+// Autosave constants
+const int AUTOSAVE_INTERVAL_TICKS = 30;           // Ticks between autosave journal entries
+
+// Rewind constants
+const int REWIND_INTERVAL_TICKS = 5;              // Ticks between in-memory rewind snapshots
+const int REWIND_SNAPSHOTS = 240;                 // Snapshots kept (20 game minutes)
+
+// Session recording constants
+const int REPLAY_HASH_INTERVAL_STEPS = 30;        // Sim steps between recorded state hashes
+
 // Calibration constants
 const float CALIBRATION_DRIFT_PER_SCAN = 0.02f;     // Quality loss per scan
 const float CALIBRATION_MIN_QUALITY = 0.5f;          // Floor for calibration quality
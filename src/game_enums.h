@@ -14,6 +14,53 @@ enum class UnitType {
 };
 
 
+// Whether a unit is running. Sim code checks this every tick; the
+// "active"/"inactive" strings are for display only.
+enum class UnitStatus {
+    INACTIVE,
+    ACTIVE
+};
+
+
+// What a unit module does. Names match the module type strings used in
+// UI and config (see ModuleKindToString).
+enum class ModuleKind {
+    GENERIC,
+    // Extraction
+    PROSPECTING,
+    EXCAVATION,
+    BENEFICIATION,
+    OPERATIONS,
+    DIRECTIVES,
+    // Farming
+    IRRIGATION,
+    GREENHOUSE,
+    HYDROPONICS,
+    HARVEST,
+    STORAGE,
+    // Energy
+    SOLAR_ARRAY,
+    BATTERY,
+    NUCLEAR,
+    GRID,
+    EMERGENCY,
+    // Manufacture
+    FABRICATION,
+    ASSEMBLY,
+    QUALITY,
+    LOGISTICS,
+    AUTOMATION,
+    // Research
+    LABORATORY,
+    ANALYSIS,
+    SIMULATION,
+    ARCHIVE,
+    PUBLICATION
+};
+
+constexpr int MODULE_KIND_COUNT = static_cast<int>(ModuleKind::PUBLICATION) + 1;
+
+
 enum class View {
     Menu,
     Planet,
@@ -0,0 +1,284 @@
+#include "sim_log.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <streambuf>
+#include <string>
+#include <thread>
+
+namespace Log {
+namespace detail {
+    std::atomic<uint8_t> levels[static_cast<int>(LogCategory::Count)] = {
+        {1}, {1}, {1}, {1}, {1}, {1}, {1}, {1}
+    };
+}
+}
+
+namespace {
+
+static_assert((Log::RING_LINES & (Log::RING_LINES - 1)) == 0, "ring size must be a power of two");
+static_assert(static_cast<int>(LogCategory::Count) == 8, "one default level per category");
+
+// Fixed-size streambuf: formatting a line never allocates, and anything
+// past LINE_BYTES is dropped
+class LineBuffer : public std::streambuf {
+public:
+    LineBuffer() { Reset(); }
+    void Reset() { setp(data, data + Log::LINE_BYTES); }
+    const char* Data() const { return data; }
+    size_t Size() const { return static_cast<size_t>(pptr() - pbase()); }
+
+protected:
+    int_type overflow(int_type ch) override { return traits_type::not_eof(ch); }
+
+private:
+    char data[Log::LINE_BYTES];
+};
+
+struct LineStream {
+    LineBuffer buffer;
+    std::ostream stream{&buffer};
+};
+
+thread_local LineStream threadLine;
+
+// Writes one line as "[warn] Transport: road full"
+void AppendLine(std::string& out, LogLevel level, LogCategory category, const char* text, size_t length) {
+    out.push_back('[');
+    out.append(Log::LevelName(level));
+    out.append("] ");
+    out.append(Log::CategoryName(category));
+    out.append(": ");
+    out.append(text, length);
+    out.push_back('\n');
+}
+
+// Bounded multi-producer, single-consumer ring. Each slot's sequence says
+// whose turn it is: == position when free for the producer claiming that
+// position, == position + 1 once the line is in and the writer may take it.
+class Logger {
+public:
+    Logger() : head(0), tail(0), written(0), dropped(0), output(&std::cout), stopping(false), direct(false) {
+        for (int i = 0; i < Log::RING_LINES; i++) {
+            slots[i].sequence.store(static_cast<uint64_t>(i), std::memory_order_relaxed);
+        }
+#ifdef __EMSCRIPTEN__
+        direct = true;
+#else
+        writer = std::thread(&Logger::WriterLoop, this);
+#endif
+    }
+
+    void Push(LogLevel level, LogCategory category, const char* text, size_t length) {
+        if (direct.load(std::memory_order_acquire)) {
+            std::string line;
+            AppendLine(line, level, category, text, length);
+            std::ostream& out = *output.load();
+            out.write(line.data(), static_cast<std::streamsize>(line.size()));
+            out.flush();
+            written++;
+            return;
+        }
+
+        uint64_t pos = head.load(std::memory_order_relaxed);
+        Slot* slot;
+        while (true) {
+            slot = &slots[pos & (Log::RING_LINES - 1)];
+            uint64_t seq = slot->sequence.load(std::memory_order_acquire);
+            int64_t diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos);
+            if (diff == 0) {
+                if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                dropped++;          // full: the writer is behind
+                return;
+            } else {
+                pos = head.load(std::memory_order_relaxed);
+            }
+        }
+
+        slot->level = level;
+        slot->category = category;
+        slot->length = static_cast<uint16_t>(length);
+        std::memcpy(slot->text, text, length);
+        slot->sequence.store(pos + 1, std::memory_order_release);
+    }
+
+    void Flush() {
+        if (direct.load()) return;
+        uint64_t target = head.load();
+        while (tail.load() < target) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    void Shutdown() {
+        if (direct.exchange(true)) return;
+        stopping = true;
+        if (writer.joinable()) writer.join();
+
+        // A producer that saw the writer running may have claimed a slot
+        // after its last pass: wait for each such line and write it here
+        std::string batch;
+        uint64_t pos = tail.load();
+        while (pos < head.load()) {
+            Slot& slot = slots[pos & (Log::RING_LINES - 1)];
+            while (slot.sequence.load(std::memory_order_acquire) != pos + 1) {
+                std::this_thread::yield();
+            }
+            AppendLine(batch, slot.level, slot.category, slot.text, slot.length);
+            slot.sequence.store(pos + Log::RING_LINES, std::memory_order_release);
+            pos++;
+            written++;
+        }
+        if (!batch.empty()) {
+            std::ostream& out = *output.load();
+            out.write(batch.data(), static_cast<std::streamsize>(batch.size()));
+            out.flush();
+        }
+        tail.store(pos);
+    }
+
+    Log::Stats GetStats() const {
+        Log::Stats stats;
+        stats.written = written.load();
+        stats.dropped = dropped.load();
+        return stats;
+    }
+
+    std::atomic<std::ostream*>& Output() { return output; }
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> sequence;
+        LogLevel level = LogLevel::Info;
+        LogCategory category = LogCategory::General;
+        uint16_t length = 0;
+        char text[Log::LINE_BYTES];
+    };
+
+    // Takes every published line, writes them as one batch, repeats;
+    // naps briefly when the ring is empty
+    void WriterLoop() {
+        std::string batch;
+        while (true) {
+            bool quit = stopping.load();
+            uint64_t pos = tail.load(std::memory_order_relaxed);
+            uint64_t taken = 0;
+            batch.clear();
+
+            while (true) {
+                Slot& slot = slots[pos & (Log::RING_LINES - 1)];
+                if (slot.sequence.load(std::memory_order_acquire) != pos + 1) break;
+                AppendLine(batch, slot.level, slot.category, slot.text, slot.length);
+                slot.sequence.store(pos + Log::RING_LINES, std::memory_order_release);
+                pos++;
+                taken++;
+            }
+
+            if (taken > 0) {
+                std::ostream& out = *output.load();
+                out.write(batch.data(), static_cast<std::streamsize>(batch.size()));
+                out.flush();
+                written += taken;
+                tail.store(pos);
+                continue;
+            }
+            if (quit) return;
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+    }
+
+    Slot slots[Log::RING_LINES];
+    std::atomic<uint64_t> head;         // next position to claim
+    std::atomic<uint64_t> tail;         // next position to write
+    std::atomic<uint64_t> written;
+    std::atomic<uint64_t> dropped;
+    std::atomic<std::ostream*> output;
+    std::atomic<bool> stopping;
+    std::atomic<bool> direct;           // no writer: print on the calling thread
+    std::thread writer;
+};
+
+// Never destroyed, so static destructors that log stay safe; the writer
+// is stopped (and drained) at exit instead
+Logger& Instance() {
+    static Logger* logger = [] {
+        Logger* created = new Logger();
+        std::atexit([] { Log::Shutdown(); });
+        return created;
+    }();
+    return *logger;
+}
+
+} // namespace
+
+namespace Log {
+
+void SetLevel(LogCategory category, LogLevel level) {
+    detail::levels[static_cast<int>(category)].store(static_cast<uint8_t>(level), std::memory_order_relaxed);
+}
+
+void SetLevel(LogLevel level) {
+    for (int i = 0; i < static_cast<int>(LogCategory::Count); i++) {
+        SetLevel(static_cast<LogCategory>(i), level);
+    }
+}
+
+LogLevel GetLevel(LogCategory category) {
+    return static_cast<LogLevel>(detail::levels[static_cast<int>(category)].load(std::memory_order_relaxed));
+}
+
+void SetOutput(std::ostream* out) {
+    Instance().Output().store(out ? out : &std::cout);
+}
+
+std::ostream& BeginLine() {
+    threadLine.buffer.Reset();
+    threadLine.stream.clear();
+    return threadLine.stream;
+}
+
+void EndLine(LogLevel level, LogCategory category) {
+    Instance().Push(level, category, threadLine.buffer.Data(), threadLine.buffer.Size());
+}
+
+void Flush() {
+    Instance().Flush();
+}
+
+void Shutdown() {
+    Instance().Shutdown();
+}
+
+Stats GetStats() {
+    return Instance().GetStats();
+}
+
+const char* LevelName(LogLevel level) {
+    switch (level) {
+        case LogLevel::Debug: return "debug";
+        case LogLevel::Info:  return "info";
+        case LogLevel::Warn:  return "warn";
+        case LogLevel::Error: return "error";
+        case LogLevel::Off:   return "off";
+    }
+    return "unknown";
+}
+
+const char* CategoryName(LogCategory category) {
+    switch (category) {
+        case LogCategory::General:   return "General";
+        case LogCategory::Planet:    return "Planet";
+        case LogCategory::Colony:    return "Colony";
+        case LogCategory::Sect:      return "Sect";
+        case LogCategory::Unit:      return "Unit";
+        case LogCategory::Transport: return "Transport";
+        case LogCategory::Input:     return "Input";
+        case LogCategory::Config:    return "Config";
+        case LogCategory::Count:     break;
+    }
+    return "Unknown";
+}
+
+} // namespace Log
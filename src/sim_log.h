@@ -0,0 +1,110 @@
+#ifndef SIM_LOG_H
+#define SIM_LOG_H
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+
+// Levelled, categorised logging that never blocks the simulation.
+//
+// COLONY_LOG_INFO(Colony, "Reserves at " << amount) formats into a
+// per-thread line buffer and pushes the line onto a lock-free ring; a
+// background thread writes the ring out. A full ring drops lines (and
+// counts them) rather than waiting on the console. Lines come out as
+// "[warn] Transport: road full".
+//
+// Levels below COLONY_LOG_MIN_LEVEL are compiled out, arguments and all.
+// The rest cost one relaxed load when their category's runtime level
+// filters them. Web builds have no writer thread and print immediately.
+
+enum class LogLevel : uint8_t {
+    Debug,
+    Info,
+    Warn,
+    Error,
+    Off
+};
+
+enum class LogCategory : uint8_t {
+    General,
+    Planet,
+    Colony,
+    Sect,
+    Unit,
+    Transport,
+    Input,
+    Config,
+    Count
+};
+
+// Lowest level compiled in (0 = Debug ... 3 = Error)
+#ifndef COLONY_LOG_MIN_LEVEL
+#define COLONY_LOG_MIN_LEVEL 0
+#endif
+
+namespace Log {
+    static const int LINE_BYTES = 256;      // longer lines are truncated
+    static const int RING_LINES = 4096;     // power of two
+
+    struct Stats {
+        uint64_t written = 0;
+        uint64_t dropped = 0;   // ring was full
+    };
+
+    namespace detail {
+        extern std::atomic<uint8_t> levels[static_cast<int>(LogCategory::Count)];
+    }
+
+    inline bool IsEnabled(LogCategory category, LogLevel level) {
+        return static_cast<uint8_t>(level) >=
+               detail::levels[static_cast<int>(category)].load(std::memory_order_relaxed);
+    }
+
+    // Runtime minimum level, per category or for all. Default: Info.
+    void SetLevel(LogCategory category, LogLevel level);
+    void SetLevel(LogLevel level);
+    LogLevel GetLevel(LogCategory category);
+
+    // Where the writer sends lines (default std::cout). Flush first when
+    // switching so earlier lines land in the old stream.
+    void SetOutput(std::ostream* out);
+
+    // The calling thread's line buffer, emptied; EndLine queues its contents
+    std::ostream& BeginLine();
+    void EndLine(LogLevel level, LogCategory category);
+
+    void Flush();           // blocks until every queued line is written
+    void Shutdown();        // flushes and stops the writer; later lines print directly
+    Stats GetStats();
+
+    const char* LevelName(LogLevel level);
+    const char* CategoryName(LogCategory category);
+
+    // False for levels below COLONY_LOG_MIN_LEVEL. Selected by #if: at the
+    // default of 0 every level is in, and comparing against it would warn.
+    constexpr bool IsCompiled(LogLevel level) {
+#if COLONY_LOG_MIN_LEVEL <= 0
+        static_cast<void>(level);
+        return true;
+#else
+        return static_cast<int>(level) >= COLONY_LOG_MIN_LEVEL;
+#endif
+    }
+}
+
+#define COLONY_LOG(level, category, expr)                                              \
+    do {                                                                               \
+        if (Log::IsCompiled(LogLevel::level) &&                                        \
+            Log::IsEnabled(LogCategory::category, LogLevel::level)) {                  \
+            Log::BeginLine() << expr;                                                  \
+            Log::EndLine(LogLevel::level, LogCategory::category);                      \
+        }                                                                              \
+    } while (0)
+
+// Not LOG_INFO etc.: raylib's TraceLogLevel already uses those names
+#define COLONY_LOG_DEBUG(category, expr) COLONY_LOG(Debug, category, expr)
+#define COLONY_LOG_INFO(category, expr)  COLONY_LOG(Info, category, expr)
+#define COLONY_LOG_WARN(category, expr)  COLONY_LOG(Warn, category, expr)
+#define COLONY_LOG_ERROR(category, expr) COLONY_LOG(Error, category, expr)
+
+#endif // SIM_LOG_H
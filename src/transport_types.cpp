@@ -23,7 +23,7 @@ Road::Road(Sect* a, Sect* b)
 }
 
 
-Vector2 TransportJob::GetCurrentPosition() const {
+Vector2 TransportJob::GetCurrentPosition(float alpha) const {
     if (!road || !road->sectA || !road->sectB) {
         return {0.0f, 0.0f};
     }
@@ -32,8 +32,9 @@ Vector2 TransportJob::GetCurrentPosition() const {
     Vector2 posB = destination->GetPosition();
 
     // Linear interpolation based on progress
+    float t = previousProgress + (progress - previousProgress) * alpha;
     return {
-        posA.x + (posB.x - posA.x) * progress,
-        posA.y + (posB.y - posA.y) * progress
+        posA.x + (posB.x - posA.x) * t,
+        posA.y + (posB.y - posA.y) * t
     };
 }
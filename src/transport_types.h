@@ -45,15 +45,17 @@ struct TransportJob {
     ResourceType resourceType;
     float amount;
     float progress;                 // 0.0 to 1.0 (position along road)
+    float previousProgress;         // progress before the last Update (render interpolation)
     TransportStatus status;
 
     TransportJob(Road* r, Sect* src, Sect* dest, ResourceType type, float amt)
         : road(r), source(src), destination(dest),
-          resourceType(type), amount(amt), progress(0.0f),
+          resourceType(type), amount(amt), progress(0.0f), previousProgress(0.0f),
           status(TransportStatus::PENDING) {}
 
     // Update progress based on delta time
     void Update(float deltaTime) {
+        previousProgress = progress;
         if (status == TransportStatus::IN_TRANSIT && road) {
             float travelTime = road->GetTravelTime();
             if (travelTime > 0.0f) {
@@ -66,8 +68,9 @@ struct TransportJob {
         }
     }
 
-    // Get current world position of the packet
-    Vector2 GetCurrentPosition() const;
+    // Get current world position of the packet. alpha blends from the
+    // previous simulation tick (0) to the latest one (1).
+    Vector2 GetCurrentPosition(float alpha = 1.0f) const;
 };
 
 
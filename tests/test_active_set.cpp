@@ -0,0 +1,155 @@
+#include <catch2/catch_test_macros.hpp>
+#include "active_set.h"
+#include "sect.h"
+#include "time_manager.h"
+#include "test_helpers.h"
+#include <vector>
+
+TEST_CASE("ActiveSet keeps awake members in index order", "[active_set]")
+{
+    ActiveSet set;
+    set.Grow(5);
+    REQUIRE(set.GetAwakeCount() == 5);
+
+    set.Sleep(1);
+    set.Sleep(3);
+    set.Sleep(3);                   // already asleep: no-op
+    REQUIRE(set.GetAwake() == std::vector<int>{0, 2, 4});
+
+    set.Wake(3);
+    set.Wake(3);
+    set.Sleep(0);
+    REQUIRE(set.GetAwake() == std::vector<int>{2, 3, 4});
+    REQUIRE(set.IsAwake(3));
+    REQUIRE_FALSE(set.IsAwake(1));
+
+    set.Grow(6);                    // new members start awake
+    REQUIRE(set.GetAwake().back() == 5);
+    REQUIRE(set.GetSize() == 6);
+}
+
+namespace
+{
+    Unit* FindUnit(Sect& sect, UnitType type)
+    {
+        for (Unit* unit : sect.GetUnits())
+        {
+            if (unit->GetType() == type) return unit;
+        }
+        return nullptr;
+    }
+
+    void Idle(Sect& sect)
+    {
+        Unit* extraction = FindUnit(sect, UnitType::Extraction);
+        extraction->Stop();
+        for (const auto& exc : extraction->GetExcavators())
+        {
+            extraction->SetExcavatorRate(exc.id, 0.0f);
+        }
+    }
+}
+
+TEST_CASE("Idle units and sects sleep until something wakes them", "[active_set]")
+{
+    ResourceManager rm = MakeTestResourceManager();
+    TimeManager tm;
+    Vector2 position = {900.0f, 900.0f};
+    Sect sect(position, rm, tm);
+    REQUIRE(sect.GetAwakeUnitCount() == static_cast<int>(sect.GetUnits().size()));
+
+    Idle(sect);
+    sect.Update(1.0f / 30.0f);
+    REQUIRE(sect.GetAwakeUnitCount() == 0);
+    REQUIRE_FALSE(sect.NeedsUpdate());
+
+    SECTION("module activation")
+    {
+        FindUnit(sect, UnitType::Farming)->Start();
+        REQUIRE(sect.GetAwakeUnitCount() == 1);
+        REQUIRE(sect.NeedsUpdate());
+    }
+
+    SECTION("excavator change")
+    {
+        Unit* extraction = FindUnit(sect, UnitType::Extraction);
+        extraction->SetExcavatorRate(extraction->GetExcavators()[0].id, 30.0f);
+        REQUIRE(sect.GetAwakeUnitCount() == 1);
+
+        // Wear only creeps while the rate is up
+        extraction->SetExcavatorRate(extraction->GetExcavators()[0].id, 0.0f);
+        sect.Update(1.0f / 30.0f);
+        REQUIRE(sect.GetAwakeUnitCount() == 0);
+    }
+
+    SECTION("storage dropping below capacity")
+    {
+        sect.ConsumeResource(ResourceType::ENERGY, 50.0f);
+        REQUIRE(sect.NeedsUpdate());
+        sect.Update(1.0f / 30.0f);
+        REQUIRE(sect.GetResourceStorage(ResourceType::ENERGY) > 950.0f);
+    }
+}
+
+// Skipping sleeping units and idle sects must not change the outcome:
+// compare against stepping every unit and the ambient energy every tick.
+TEST_CASE("Active-set stepping matches stepping everything", "[active_set]")
+{
+    ResourceManager gatedRm = MakeTestResourceManager();
+    ResourceManager fullRm = MakeTestResourceManager();
+    TimeManager tm;
+    std::vector<Vector2> positions = {{900.0f, 900.0f}, {300.0f, 1500.0f}, {1500.0f, 300.0f}};
+
+    std::vector<Sect*> gated;
+    std::vector<Sect*> full;
+    for (Vector2 position : positions)
+    {
+        gated.push_back(new Sect(position, gatedRm, tm));
+        full.push_back(new Sect(position, fullRm, tm));
+    }
+    for (std::vector<Sect*>* world : {&gated, &full})
+    {
+        Idle(*(*world)[1]);                                         // fully idle sect
+        FindUnit(*(*world)[2], UnitType::Farming)->Start();         // farming only
+        FindUnit(*(*world)[2], UnitType::Energy)->Start();
+        Idle(*(*world)[2]);
+    }
+
+    const float dt = 1.0f / 30.0f;
+    for (int tick = 0; tick < 600; tick++)
+    {
+        if (tick == 300)
+        {
+            // Something drains an idle sect mid-run
+            gated[1]->ConsumeResource(ResourceType::ENERGY, 200.0f);
+            full[1]->ConsumeResource(ResourceType::ENERGY, 200.0f);
+        }
+
+        for (Sect* sect : gated)
+        {
+            if (sect->NeedsUpdate()) sect->Update(dt);
+        }
+        for (Sect* sect : full)
+        {
+            for (Unit* unit : sect->GetUnits()) unit->Update(dt);
+            sect->CommitDepletion();
+            sect->GenerateAmbientEnergy(dt, tm.GetTimeOfDay());
+        }
+    }
+
+    REQUIRE(gated[1]->GetAwakeUnitCount() == 0);
+    REQUIRE(gatedRm.GetResourceMapVersion() == fullRm.GetResourceMapVersion());
+    for (size_t i = 0; i < gated.size(); i++)
+    {
+        const ResourceVector& a = gated[i]->GetResourceStorage();
+        const ResourceVector& b = full[i]->GetResourceStorage();
+        REQUIRE(a.GetMask() == b.GetMask());
+        for (const auto& [type, amount] : b)
+        {
+            REQUIRE(a.Get(type) == amount);
+        }
+    }
+
+    for (Sect* sect : gated) delete sect;
+    for (Sect* sect : full) delete sect;
+}
@@ -0,0 +1,329 @@
+#include <catch2/catch_test_macros.hpp>
+#include "autosave_journal.h"
+#include "colony.h"
+#include "sect.h"
+#include "time_manager.h"
+#include "sim_clock.h"
+#include "unlock_registry.h"
+#include "test_helpers.h"
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace {
+
+void RemoveAutosave(const std::string& path)
+{
+    std::remove(path.c_str());
+    std::remove((path + ".journal").c_str());
+}
+
+bool SameResources(const ResourceVector& a, const ResourceVector& b)
+{
+    if (a.GetMask() != b.GetMask()) return false;
+    for (auto [type, amount] : a)
+    {
+        if (b.Get(type) != amount) return false;
+    }
+    return true;
+}
+
+void RequireSameWorld(const std::vector<Colony*>& a, const std::vector<Colony*>& b)
+{
+    REQUIRE(a.size() == b.size());
+    for (size_t c = 0; c < a.size(); c++)
+    {
+        REQUIRE(SameResources(a[c]->GetStrategicReserves(), b[c]->GetStrategicReserves()));
+        REQUIRE(a[c]->GetReserveLevel() == b[c]->GetReserveLevel());
+        REQUIRE(a[c]->GetRoads().size() == b[c]->GetRoads().size());
+        for (size_t r = 0; r < a[c]->GetRoads().size(); r++)
+        {
+            REQUIRE(a[c]->GetRoads()[r].mode == b[c]->GetRoads()[r].mode);
+        }
+        REQUIRE(a[c]->GetTransportJobs().size() == b[c]->GetTransportJobs().size());
+
+        const auto& sectsA = a[c]->GetSects();
+        const auto& sectsB = b[c]->GetSects();
+        REQUIRE(sectsA.size() == sectsB.size());
+        for (size_t s = 0; s < sectsA.size(); s++)
+        {
+            REQUIRE(sectsA[s]->GetPosition().x == sectsB[s]->GetPosition().x);
+            REQUIRE(SameResources(sectsA[s]->GetResourceStorage(), sectsB[s]->GetResourceStorage()));
+            REQUIRE(sectsA[s]->GetTotalTypedResourceCount(ResourceType::ALLOYS) ==
+                    sectsB[s]->GetTotalTypedResourceCount(ResourceType::ALLOYS));
+            REQUIRE(sectsA[s]->GetUnits().size() == sectsB[s]->GetUnits().size());
+            for (size_t u = 0; u < sectsA[s]->GetUnits().size(); u++)
+            {
+                const Unit* unitA = sectsA[s]->GetUnits()[u];
+                const Unit* unitB = sectsB[s]->GetUnits()[u];
+                REQUIRE(unitA->GetStatus() == unitB->GetStatus());
+                REQUIRE(unitA->GetActiveModuleIndices() == unitB->GetActiveModuleIndices());
+                REQUIRE(SameResources(unitA->GetOverflowBuffer(), unitB->GetOverflowBuffer()));
+                REQUIRE(unitA->GetTotalRegolithExtracted() == unitB->GetTotalRegolithExtracted());
+                for (size_t m = 0; m < unitA->GetModules().size(); m++)
+                {
+                    REQUIRE(unitA->GetModules()[m].tier == unitB->GetModules()[m].tier);
+                }
+                if (unitA->HasProspectingSystem())
+                {
+                    const ProspectingGrid& gridA = unitA->GetProspectingSystem()->GetGrid();
+                    const ProspectingGrid& gridB = unitB->GetProspectingSystem()->GetGrid();
+                    REQUIRE(gridA.GetGridSize() == gridB.GetGridSize());
+                    REQUIRE(gridA.GetSubCell(1, 1).sweepSignal == gridB.GetSubCell(1, 1).sweepSignal);
+                    REQUIRE(gridA.GetSweepHistory().size() == gridB.GetSweepHistory().size());
+                }
+            }
+        }
+    }
+}
+
+} // namespace
+
+TEST_CASE("State revisions move only when something changes", "[autosave]")
+{
+    ResourceManager resources = MakeTestResourceManager();
+    TimeManager time;
+    ManualClock clock;
+    Colony* colony = MakeColony(resources, time, clock, 250.0f, 2);
+    Sect* sect = colony->GetSects()[0];
+    Unit* farming = sect->GetUnits()[1];
+    colony->ManageResources();      // settle the starting surplus
+
+    const uint32_t colonyRevision = colony->GetStateRevision();
+    const uint32_t sectRevision = sect->GetStateRevision();
+    const uint32_t unitRevision = farming->GetStateRevision();
+
+    // Settled: nothing to push or pull, reserves and storage stay as they are
+    colony->ManageResources();
+    REQUIRE(colony->GetStateRevision() == colonyRevision);
+    REQUIRE(sect->GetStateRevision() == sectRevision);
+
+    sect->AddResource(ResourceType::Fe, 10.0f);
+    REQUIRE(sect->GetStateRevision() != sectRevision);
+    REQUIRE(farming->GetStateRevision() == unitRevision);
+    REQUIRE(colony->GetStateRevision() == colonyRevision);
+
+    colony->BuildRoad(colony->GetSects()[0], colony->GetSects()[1]);
+    REQUIRE(colony->GetStateRevision() != colonyRevision);
+
+    farming->SetExcavatorRate(0, 10.0f);        // no excavators: unchanged
+    REQUIRE(farming->GetStateRevision() == unitRevision);
+    farming->Stop();
+    REQUIRE(farming->GetStateRevision() != unitRevision);
+
+    // Mutable prospecting access counts as a change of the unit
+    Unit* extraction = sect->GetUnits()[0];
+    const uint32_t extractionRevision = extraction->GetStateRevision();
+    extraction->GetProspectingSystem()->GetGrid().GetSubCellMut(0, 0).sweepSignal = 0.5f;
+    REQUIRE(extraction->GetStateRevision() != extractionRevision);
+
+    // Depletion lists each changed cell once
+    std::vector<int> cells;
+    int feCell = -1;
+    const int gridSize = resources.GetGridSize();
+    for (int cell = 0; cell < gridSize * gridSize && feCell < 0; cell++)
+    {
+        for (const auto& [type, abundance] : resources.GetResourcesAtGrid(cell % gridSize, cell / gridSize))
+        {
+            if (type == ResourceType::Fe && abundance > 2.0f) feCell = cell;
+        }
+    }
+    REQUIRE(feCell >= 0);
+    resources.TakeChangedCells(cells);
+    resources.UpdateResourceDepletion(feCell % gridSize, feCell / gridSize, ResourceType::Fe, 1.0f);
+    resources.UpdateResourceDepletion(feCell % gridSize, feCell / gridSize, ResourceType::Fe, 1.0f);
+    resources.UpdateResourceDepletion(0, 0, ResourceType::Fe, 0.0f);
+    resources.TakeChangedCells(cells);
+    REQUIRE(cells == std::vector<int>{feCell});
+    resources.TakeChangedCells(cells);
+    REQUIRE(cells.empty());
+
+    delete colony;
+}
+
+TEST_CASE("Autosave journals only what changed and compacts into a snapshot", "[autosave]")
+{
+    const std::string path = TempSavePath("colony_test_autosave.colony");
+    RemoveAutosave(path);
+
+    ResourceManager resources = MakeTestResourceManager();
+    TimeManager time;
+    ManualClock clock;
+    std::vector<Colony*> colonies;
+    for (int c = 0; c < 4; c++)
+    {
+        colonies.push_back(MakeColony(resources, time, clock, 250.0f + 500.0f * c, 4));
+    }
+
+    {
+        AutosaveJournal autosave(path);
+        autosave.Capture(resources, time, colonies);
+        autosave.Flush();
+        AutosaveJournal::Stats stats = autosave.GetStats();
+        REQUIRE(stats.snapshots == 1);
+        REQUIRE(stats.entries == 0);
+        REQUIRE(stats.snapshotBytes > 0);
+
+        // Nothing changed: the entry is the clock and the unlocks
+        autosave.Capture(resources, time, colonies);
+        autosave.Flush();
+        stats = autosave.GetStats();
+        REQUIRE(stats.entries == 1);
+        const size_t idleBytes = stats.journalBytes;
+        REQUIRE(idleBytes < 200);
+
+        // One sect's storage: one sect record, nothing else
+        colonies[2]->GetSects()[1]->AddResource(ResourceType::Si, 5.0f);
+        autosave.Capture(resources, time, colonies);
+        autosave.Flush();
+        stats = autosave.GetStats();
+        const size_t sectBytes = stats.journalBytes - idleBytes;
+        REQUIRE(sectBytes > idleBytes);
+        REQUIRE(sectBytes < 1000);
+
+        // Past the ratio the next capture is a snapshot and the journal restarts
+        autosave.SetCompactRatio(0.0f);
+        autosave.Capture(resources, time, colonies);
+        autosave.Flush();
+        stats = autosave.GetStats();
+        REQUIRE(stats.snapshots == 2);
+        REQUIRE(stats.journalBytes == 0);
+        REQUIRE(stats.failed == 0);
+
+        // Replacing the colonies without Reset() is caught: a snapshot again
+        autosave.SetCompactRatio(AutosaveJournal::DEFAULT_COMPACT_RATIO);
+        std::vector<Colony*> others = {MakeColony(resources, time, clock, 300.0f, 1)};
+        autosave.Capture(resources, time, others);
+        autosave.Flush();
+        REQUIRE(autosave.GetStats().snapshots == 3);
+        for (Colony* colony : others) delete colony;
+    }
+
+    for (Colony* colony : colonies) delete colony;
+    RemoveAutosave(path);
+}
+
+TEST_CASE("Recovering replays the journal onto the snapshot", "[autosave]")
+{
+    const std::string path = TempSavePath("colony_test_recover.colony");
+    RemoveAutosave(path);
+
+    ResourceManager resources = MakeTestResourceManager();
+    TimeManager time;
+    ManualClock clock;
+    std::vector<Colony*> colonies = {MakeColony(resources, time, clock, 250.0f, 3)};
+    Colony* first = colonies[0];
+    const std::vector<std::string> techsBefore = UnlockRegistry::Instance().GetAll();
+
+    AutosaveJournal autosave(path);
+    autosave.Capture(resources, time, colonies);
+
+    // Between captures: stepping, storage, roads, jobs, a new sect, a new
+    // colony, module and prospecting changes, depletion
+    StepWorld(colonies, time, clock, 4);
+    first->BuildRoad(first->GetSects()[0], first->GetSects()[1]);
+    first->SetRoadTransportMode(&const_cast<Road&>(first->GetRoads()[0]), TransportMode::MANUAL);
+    first->ReceiveSurplus(ResourceType::Fe, 60.0f);
+    first->GetSects()[2]->AddTypedResource(TypedResource(ResourceType::ALLOYS, "JournalAlloy"));
+    autosave.Capture(resources, time, colonies);
+
+    Vector2 newSect = {550.0f, 450.0f};
+    first->AddSect(new Sect(newSect, resources, time));
+    first->AddSyntheticTransportJob(&const_cast<Road&>(first->GetRoads()[0]), ResourceType::Si, 30.0f, 0.2f);
+    Unit* extraction = first->GetSects()[1]->GetUnits()[0];
+    extraction->DebugUpgradeModuleTier(0);
+    extraction->GetProspectingSystem()->GetGrid().GetSubCellMut(1, 1).sweepSignal = 0.75f;
+    extraction->GetProspectingSystem()->GetGrid().RecordSweep(1, 10.0f, 4.0f);
+    colonies.push_back(MakeColony(resources, time, clock, 1200.0f, 2));
+    UnlockRegistry::Instance().Restore({"Geophysics"});
+    StepWorld(colonies, time, clock, 6);
+    autosave.Capture(resources, time, colonies);
+    autosave.Flush();
+    REQUIRE(autosave.GetStats().snapshots == 1);
+    REQUIRE(autosave.GetStats().entries == 2);
+
+    UnlockRegistry::Instance().Restore({});
+    ResourceManager loadedResources(4, 1.0f);
+    TimeManager loadedTime;
+    std::vector<Colony*> loaded;
+    std::string error;
+    int replayed = 0;
+    REQUIRE(AutosaveJournal::Recover(path, loadedResources, loadedTime, loaded, &error, &replayed));
+    REQUIRE(replayed == 2);
+
+    REQUIRE(UnlockRegistry::Instance().IsUnlocked("Geophysics"));
+    REQUIRE(loadedTime.GetTicks() == time.GetTicks());
+    REQUIRE(loadedTime.GetGameTime() == time.GetGameTime());
+    for (int y = 0; y < resources.GetGridSize(); y++)
+    {
+        for (int x = 0; x < resources.GetGridSize(); x++)
+        {
+            REQUIRE(loadedResources.GetResourcesAtGrid(x, y) == resources.GetResourcesAtGrid(x, y));
+        }
+    }
+    RequireSameWorld(colonies, loaded);
+    REQUIRE(loaded[0]->GetTypedReserveCount(ResourceType::ALLOYS, "Steel") == 0);
+    REQUIRE(loaded[0]->GetSects()[2]->GetTypedResourceCount(ResourceType::ALLOYS, "JournalAlloy") ==
+            first->GetSects()[2]->GetTypedResourceCount(ResourceType::ALLOYS, "JournalAlloy"));
+
+    // Both carry on the same way
+    ManualClock loadedClock(clock.Now());
+    for (Colony* colony : loaded) colony->SetClock(&loadedClock);
+    StepWorld(colonies, time, clock, 10);
+    StepWorld(loaded, loadedTime, loadedClock, 10);
+    RequireSameWorld(colonies, loaded);
+
+    for (Colony* colony : loaded) delete colony;
+    for (Colony* colony : colonies) delete colony;
+    UnlockRegistry::Instance().Restore(techsBefore);
+    RemoveAutosave(path);
+}
+
+TEST_CASE("Recovery drops a torn entry and ignores a stale journal", "[autosave]")
+{
+    const std::string path = TempSavePath("colony_test_torn.colony");
+    RemoveAutosave(path);
+
+    ResourceManager resources = MakeTestResourceManager();
+    TimeManager time;
+    ManualClock clock;
+    std::vector<Colony*> colonies = {MakeColony(resources, time, clock, 250.0f, 2)};
+
+    {
+        AutosaveJournal autosave(path);
+        autosave.Capture(resources, time, colonies);
+        StepWorld(colonies, time, clock, 3);
+        autosave.Capture(resources, time, colonies);
+    }
+
+    // Half an entry, as a crash mid-write would leave
+    FILE* journal = std::fopen((path + ".journal").c_str(), "ab");
+    REQUIRE(journal != nullptr);
+    const uint8_t partial[] = {200, 0, 0, 0, 1, 2, 3, 4, 5, 6};
+    std::fwrite(partial, 1, sizeof(partial), journal);
+    std::fclose(journal);
+
+    ResourceManager loadedResources(4, 1.0f);
+    TimeManager loadedTime;
+    std::vector<Colony*> loaded;
+    int replayed = 0;
+    REQUIRE(AutosaveJournal::Recover(path, loadedResources, loadedTime, loaded, nullptr, &replayed));
+    REQUIRE(replayed == 1);
+    REQUIRE(loadedTime.GetTicks() == time.GetTicks());
+    RequireSameWorld(colonies, loaded);
+    for (Colony* colony : loaded) delete colony;
+    loaded.clear();
+
+    // A newer snapshot with the old journal beside it: the journal is stale
+    StepWorld(colonies, time, clock, 2);
+    REQUIRE(SaveGame::Save(path, resources, time, colonies, true, nullptr));
+    REQUIRE(AutosaveJournal::Recover(path, loadedResources, loadedTime, loaded, nullptr, &replayed));
+    REQUIRE(replayed == 0);
+    REQUIRE(loadedTime.GetTicks() == time.GetTicks());
+    RequireSameWorld(colonies, loaded);
+
+    for (Colony* colony : loaded) delete colony;
+    for (Colony* colony : colonies) delete colony;
+    RemoveAutosave(path);
+}
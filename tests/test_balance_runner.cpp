@@ -0,0 +1,90 @@
+#include <catch2/catch_test_macros.hpp>
+#include "balance_runner.h"
+#include "sect.h"
+#include "time_manager.h"
+#include "test_helpers.h"
+#include <string>
+#include <thread>
+
+TEST_CASE("Balance sweeps parse ranges and lists into a run grid", "[balance]")
+{
+    BalanceSweep sweep;
+    std::string error;
+    REQUIRE(ParseBalanceSweep(
+        "# two axes\n"
+        "world = colonies=1,sects=2,seed=40\n"
+        "seeds = 3; days = 2\n"
+        "AUTO_BALANCE_THRESHOLD = 0.1:0.3:0.1\n"
+        "STORAGE_LEVEL_MULTIPLIERS_1 = 1.25, 2   # a list\n",
+        sweep, &error));
+    REQUIRE(sweep.world.colonies == 1);
+    REQUIRE(sweep.days == 2);
+    REQUIRE(sweep.axes.size() == 2);
+    REQUIRE(sweep.axes[0].values.size() == 3);
+    REQUIRE(CountBalanceRuns(sweep) == 3 * 2 * 3);
+
+    // Seeds fastest, then the last axis
+    BalanceRun run = MakeBalanceRun(sweep, 4);
+    REQUIRE(run.combination == 1);
+    REQUIRE(run.seed == 41);
+    REQUIRE(run.params.autoBalanceThreshold == sweep.axes[0].values[0]);
+    REQUIRE(run.params.storageLevelMultipliers[1] == 2.0f);
+    REQUIRE(run.params.storageSurplusThreshold == STORAGE_SURPLUS_THRESHOLD);
+
+    run = MakeBalanceRun(sweep, CountBalanceRuns(sweep) - 1);
+    REQUIRE(run.params.autoBalanceThreshold == sweep.axes[0].values[2]);
+    REQUIRE(run.seed == 42);
+
+    REQUIRE_FALSE(ParseBalanceSweep("NOT_A_CONSTANT = 1", sweep, &error));
+    REQUIRE_FALSE(ParseBalanceSweep("AUTO_BALANCE_THRESHOLD = 0.5:0.1:0.1", sweep, &error));
+    REQUIRE_FALSE(ParseBalanceSweep("AUTO_BALANCE_THRESHOLD = 0.1;AUTO_BALANCE_THRESHOLD = 0.2", sweep, &error));
+    REQUIRE_FALSE(ParseBalanceSweep("seeds = 0", sweep, &error));
+}
+
+TEST_CASE("A balance scope applies to its own thread only", "[balance]")
+{
+    ResourceManager rm = MakeTestResourceManager();
+    TimeManager tm;
+    Vector2 position = {900.0f, 900.0f};
+    Sect sect(position, rm, tm);
+    sect.AddResource(ResourceType::Fe, sect.GetStorageCapacity(ResourceType::Fe) * 0.75f);
+    REQUIRE_FALSE(sect.IsSurplus(ResourceType::Fe));
+
+    BalanceParams params;
+    params.storageSurplusThreshold = 0.7f;
+    {
+        BalanceScope scope(params);
+        REQUIRE(sect.IsSurplus(ResourceType::Fe));
+
+        float elsewhere = 0.0f;
+        std::thread other([&] { elsewhere = Balance().storageSurplusThreshold; });
+        other.join();
+        REQUIRE(elsewhere == STORAGE_SURPLUS_THRESHOLD);
+    }
+    REQUIRE_FALSE(sect.IsSurplus(ResourceType::Fe));
+}
+
+TEST_CASE("Balance games are deterministic and report every day", "[balance]")
+{
+    BalanceSweep sweep;
+    std::string error;
+    REQUIRE(ParseBalanceSweep("seeds = 2; days = 3; STORAGE_SURPLUS_THRESHOLD = 0.5, 0.8", sweep, &error));
+
+    BalanceRun run = MakeBalanceRun(sweep, 1);
+    BalanceKpis first = RunBalanceGame(sweep, run);
+    BalanceKpis second = RunBalanceGame(sweep, run);
+
+    REQUIRE(first.dailyTotals.size() == 3);
+    REQUIRE(first.upgrades == second.upgrades);
+    REQUIRE(first.builds == second.builds);
+    REQUIRE(first.firstUpgradeDay == second.firstUpgradeDay);
+    REQUIRE(first.starvationEvents == second.starvationEvents);
+    for (ResourceType type : SINGULAR_RESOURCE_TYPES)
+    {
+        REQUIRE(first.finalTotals.Get(type) == second.finalTotals.Get(type));
+    }
+    REQUIRE((first.upgrades == 0) == (first.firstUpgradeDay < 0.0f));
+
+    // The game left the thread on the default balance
+    REQUIRE(Balance().storageSurplusThreshold == STORAGE_SURPLUS_THRESHOLD);
+}
@@ -0,0 +1,178 @@
+#include <catch2/catch_test_macros.hpp>
+#include "colony_lod.h"
+#include "fast_forward.h"
+#include "world_gen.h"
+#include "sim_stepper.h"
+#include "sim_scheduler.h"
+#include "colony.h"
+#include "time_manager.h"
+#include "balance_params.h"
+#include "sect.h"
+#include "test_helpers.h"
+#include <cmath>
+#include <string>
+#include <vector>
+
+// Runs `text` with level of detail, the first colony viewed, and in full
+// for `days`, and holds the aggregated colonies to their bound
+static void RequireBounded(const std::string& text, int days)
+{
+    GeneratedWorld detailed(text);
+    GeneratedWorld stepped(text);
+    detailed.stepper.SetLevelOfDetail(&detailed.time);
+    detailed.stepper.SetViewedColonies(detailed.First(1));
+
+    const int steps = days * STEPS_PER_DAY;
+    detailed.Run(steps);
+    stepped.Run(steps);
+    detailed.stepper.ReconcileDetail();
+
+    const ColonyLod::Stats& stats = detailed.stepper.GetLevelOfDetail().GetStats();
+    const long long colonySteps = static_cast<long long>(detailed.colonies.size()) * steps;
+    REQUIRE(stats.fullColonySteps + stats.aggregatedColonySteps == colonySteps);
+    REQUIRE(stats.aggregatedColonySteps > colonySteps / 10);
+    REQUIRE(stats.worstDriftBound <= ColonyLod::ERROR_BUDGET);
+    REQUIRE(stats.worstErrorBound >= stats.worstDriftBound);
+    REQUIRE_FALSE(detailed.stepper.GetLevelOfDetail().IsAggregated(detailed.colonies[0]));
+
+    // The viewed colony has not drifted at all
+    FastForwardDrift drift;
+    REQUIRE(MeasureDrift(detailed.First(1), stepped.First(1), drift));
+    REQUIRE(drift.maxStorageError == 0.0f);
+
+    // The rest stay within the bound, a pass acting a step off included
+    REQUIRE(MeasureDrift(detailed.colonies, stepped.colonies, drift));
+    INFO(drift.worst);
+    REQUIRE(drift.maxStorageError <= stats.worstErrorBound);
+    REQUIRE(drift.meanStorageError < 0.01f);
+    REQUIRE(drift.maxReserveError < 0.05f);
+}
+
+TEST_CASE("Level of detail steps viewed colonies in full and bounds the rest", "[colony_lod]")
+{
+    SECTION("busy world")
+    {
+        RequireBounded(BUSY_WORLD, 4);
+    }
+
+    SECTION("busy world, other seeds")
+    {
+        for (int seed : {1, 5}) {
+            RequireBounded(std::string(BUSY_WORLD) + ",seed=" + std::to_string(seed), 4);
+        }
+    }
+
+    SECTION("twenty colonies")
+    {
+        RequireBounded(
+            "colonies=20,sects=3-6,roads=1,modes=1:1:1,active=0.5,build=1,tier=3,"
+            "separation=1,prospecting=1,packets=40,seed=1",
+            2);
+    }
+}
+
+TEST_CASE("Level of detail transfers on the step a storage crosses the line", "[colony_lod]")
+{
+    GeneratedWorld detailed(BUSY_WORLD);
+    GeneratedWorld stepped(BUSY_WORLD);
+    detailed.stepper.SetLevelOfDetail(&detailed.time);
+    detailed.stepper.SetViewedColonies({});
+
+    // Each storage's rate, from the last step of the stepped copy
+    const int settle = ColonyLod::MEASURE_STEPS + ColonyLod::INTERVAL_STEPS;
+    detailed.Run(settle);
+    stepped.Run(settle - 1);
+    std::vector<ResourceVector> before;
+    for (Colony* colony : stepped.colonies) {
+        for (Sect* sect : colony->GetSects()) before.push_back(sect->GetResourceStorage());
+    }
+    stepped.Run(1);
+    detailed.stepper.ReconcileDetail();
+
+    // A filling storage in an aggregated colony whose surplus the reserves
+    // can take, put a few steps short of the surplus line in both copies
+    const ColonyLod& lod = detailed.stepper.GetLevelOfDetail();
+    size_t colonyIndex = 0;
+    size_t sectIndex = 0;
+    ResourceType type = ResourceType::ENERGY;
+    float line = 0.0f;
+    bool found = false;
+    size_t at = 0;
+    for (size_t c = 0; c < stepped.colonies.size(); c++) {
+        for (size_t s = 0; s < stepped.colonies[c]->GetSects().size(); s++, at++) {
+            const Sect* sect = stepped.colonies[c]->GetSects()[s];
+            for (ResourceType candidate : SINGULAR_RESOURCE_TYPES) {
+                float capacity = sect->GetStorageCapacity(candidate);
+                float rate = sect->GetResourceStorage(candidate) - before[at].Get(candidate);
+                if (found || !lod.IsAggregated(detailed.colonies[c]) || capacity <= 0.0f || rate <= 0.0f) continue;
+                float surplusLine = capacity * Balance().storageSurplusThreshold;
+                if (!stepped.colonies[c]->CanAcceptResource(candidate, capacity * 0.4f)) continue;
+
+                const float target = surplusLine - rate * ColonyLod::INTERVAL_STEPS / 2;
+                for (GeneratedWorld* world : {&detailed, &stepped}) {
+                    Sect* set = world->colonies[c]->GetSects()[s];
+                    float current = set->GetResourceStorage(candidate);
+                    if (target > current) set->AddResource(candidate, target - current);
+                    else set->ConsumeResource(candidate, current - target);
+                }
+                colonyIndex = c;
+                sectIndex = s;
+                type = candidate;
+                line = surplusLine;
+                found = true;
+            }
+        }
+    }
+    REQUIRE(found);
+    INFO(ResourceTypeToString(type));
+
+    detailed.Run(2 * ColonyLod::INTERVAL_STEPS);
+    stepped.Run(2 * ColonyLod::INTERVAL_STEPS);
+    detailed.stepper.ReconcileDetail();
+    REQUIRE(lod.IsAggregated(detailed.colonies[colonyIndex]));
+
+    // Both pushed their surplus, at the same level
+    const Sect* fast = detailed.colonies[colonyIndex]->GetSects()[sectIndex];
+    const Sect* full = stepped.colonies[colonyIndex]->GetSects()[sectIndex];
+    REQUIRE(full->GetResourceStorage(type) < line);
+    FastForwardDrift drift;
+    REQUIRE(MeasureDrift({detailed.colonies[colonyIndex]}, {stepped.colonies[colonyIndex]}, drift));
+    INFO(drift.worst);
+    REQUIRE(std::fabs(fast->GetResourceStorage(type) - full->GetResourceStorage(type)) <
+            0.002f * full->GetStorageCapacity(type));
+    REQUIRE(drift.maxStorageError <= ColonyLod::ERROR_BUDGET);
+}
+
+TEST_CASE("Level of detail expands colonies coming into view", "[colony_lod]")
+{
+    GeneratedWorld world(BUSY_WORLD);
+    world.stepper.SetLevelOfDetail(&world.time);
+    world.stepper.SetViewedColonies({});
+    world.Run(STEPS_PER_DAY);
+
+    const ColonyLod& lod = world.stepper.GetLevelOfDetail();
+    int aggregated = 0;
+    for (Colony* colony : world.colonies) {
+        if (lod.IsAggregated(colony)) aggregated++;
+    }
+    REQUIRE(aggregated > 0);
+
+    world.stepper.SetViewedColonies(world.colonies);
+    world.Run(1);
+    for (Colony* colony : world.colonies) {
+        REQUIRE_FALSE(lod.IsAggregated(colony));
+    }
+    REQUIRE(lod.GetStats().expansions == aggregated);
+
+    // Turned off, every colony steps in full
+    world.stepper.SetViewedColonies({});
+    world.Run(ColonyLod::MEASURE_STEPS + ColonyLod::INTERVAL_STEPS);
+    world.stepper.SetLevelOfDetail(nullptr);
+    REQUIRE_FALSE(world.stepper.IsLevelOfDetail());
+    for (Colony* colony : world.colonies) {
+        REQUIRE_FALSE(lod.IsAggregated(colony));
+    }
+    long long fullSteps = lod.GetStats().fullColonySteps;
+    world.Run(30);
+    REQUIRE(lod.GetStats().fullColonySteps == fullSteps);
+}
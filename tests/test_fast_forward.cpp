@@ -0,0 +1,102 @@
+#include <catch2/catch_test_macros.hpp>
+#include "fast_forward.h"
+#include "world_gen.h"
+#include "game_snapshot.h"
+#include "sim_stepper.h"
+#include "sim_scheduler.h"
+#include "colony.h"
+#include "time_manager.h"
+#include "test_helpers.h"
+#include <cstdio>
+#include <string>
+#include <vector>
+
+static void RequireEndsAlike(const std::string& spec, int days)
+{
+    GeneratedWorld fast(spec);
+    GeneratedWorld stepped(spec);
+    const int steps = days * STEPS_PER_DAY;
+
+    FastForward engine(fast.stepper);
+    FastForward::Report report = engine.Advance(fast.colonies, fast.resources, fast.time, steps);
+    stepped.Run(steps);
+
+    REQUIRE(report.steps == steps);
+    REQUIRE(fast.time.GetTicks() == stepped.time.GetTicks());
+    REQUIRE(fast.stepper.GetClockTime() == stepped.stepper.GetClockTime());
+
+    FastForwardDrift drift;
+    REQUIRE(MeasureDrift(fast.colonies, stepped.colonies, drift));
+    INFO(drift.worst);
+    REQUIRE(drift.maxStorageError < 0.001f);
+    REQUIRE(drift.maxReserveError < 0.001f);
+    REQUIRE(drift.packetDifference == 0);
+
+    // And both carry on alike
+    fast.Run(60);
+    stepped.Run(60);
+    REQUIRE(MeasureDrift(fast.colonies, stepped.colonies, drift));
+    REQUIRE(drift.maxStorageError < 0.001f);
+}
+
+TEST_CASE("Fast-forward ends where stepping does", "[fast_forward]")
+{
+    SECTION("busy world")
+    {
+        RequireEndsAlike(BUSY_WORLD, 4);
+    }
+
+    SECTION("busy world, another seed")
+    {
+        RequireEndsAlike(
+            "colonies=3,sects=3-6,roads=1,modes=1:1:1,active=0.5,build=1,tier=3,"
+            "separation=1,prospecting=1,packets=40,seed=1",
+            4);
+    }
+
+    SECTION("twenty colonies")
+    {
+        RequireEndsAlike(
+            "colonies=20,sects=3-6,roads=1,modes=1:1:1,active=0.5,build=1,tier=3,"
+            "separation=1,prospecting=1,packets=40,seed=11",
+            2);
+    }
+}
+
+TEST_CASE("Fast-forward coasts most of a month", "[fast_forward]")
+{
+    GeneratedWorld world(BUSY_WORLD);
+    const int steps = 30 * STEPS_PER_DAY;
+
+    FastForward engine(world.stepper);
+    FastForward::Report report = engine.Advance(world.colonies, world.resources, world.time, steps);
+
+    int sectSteps = report.sectSteps + report.coastedSectSteps;
+    int colonySteps = report.colonySteps + report.coastedColonySteps;
+    REQUIRE(sectSteps > 0);
+    REQUIRE(colonySteps == steps * static_cast<int>(world.colonies.size()));
+    REQUIRE(report.coastedSectSteps > sectSteps * 9 / 10);
+    REQUIRE(report.coastedColonySteps > colonySteps / 2);
+
+    // The world is still whole and keeps running
+    world.Run(30);
+}
+
+TEST_CASE("Fast-forward validates against a save", "[fast_forward]")
+{
+    GeneratedWorld world(BUSY_WORLD);
+    const std::string path = TempSavePath("colony_test_fast_forward.colony");
+    std::string error;
+    REQUIRE(SaveGame::Save(path, world.resources, world.time, world.colonies, true, &error));
+
+    FastForwardValidation validation;
+    INFO(error);
+    REQUIRE(ValidateFastForward(path, 2 * STEPS_PER_DAY, true, validation, &error));
+    std::remove(path.c_str());
+    REQUIRE(validation.report.steps == 2 * STEPS_PER_DAY);
+    REQUIRE(validation.report.coastedSectSteps > 0);
+    REQUIRE(validation.drift.maxStorageError < 0.01f);
+
+    REQUIRE_FALSE(ValidateFastForward(path, 10, true, validation, &error));
+    REQUIRE_FALSE(error.empty());
+}
@@ -1,10 +1,24 @@
 #pragma once
 
+#include <catch2/catch_test_macros.hpp>
 #include "prospecting_types.h"
 #include "sample_tray.h"
 #include "prospecting_grid.h"
 #include "resource_manager.h"
 #include "prospecting_system.h"
+#include "colony.h"
+#include "sect.h"
+#include "time_manager.h"
+#include "sim_clock.h"
+#include "world_gen.h"
+#include "sim_stepper.h"
+#include "sim_scheduler.h"
+#include "session_recording.h"
+#include "byte_stream.h"
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
 
 inline Sample MakeDummySample(DepthLayer depth = DepthLayer::SURFACE,
                                float richness = 0.5f)
@@ -53,3 +67,103 @@ inline ResourceManager MakeTestResourceManager()
     rm.GenerateOrbitalSurveyData();
     return rm;
 }
+
+inline std::string TempSavePath(const char* name)
+{
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+// Ticks every colony as the game loop does
+inline void StepWorld(std::vector<Colony*>& colonies, TimeManager& time, ManualClock& clock, int ticks)
+{
+    for (int t = 0; t < ticks; t++)
+    {
+        time.Advance(TICK_DURATION);
+        clock.Advance(TICK_DURATION);
+        for (Colony* colony : colonies)
+        {
+            for (Sect* sect : colony->GetSects())
+            {
+                sect->Update(TICK_DURATION);
+            }
+            colony->ManageResources();
+            colony->ProcessTransportJobs(TICK_DURATION);
+        }
+    }
+}
+
+// A colony of `sects` sects in a row from (x, 450), on `clock`
+inline Colony* MakeColony(ResourceManager& resources, TimeManager& time, ManualClock& clock, float x, int sects)
+{
+    Colony* colony = new Colony();
+    colony->SetClock(&clock);
+    for (int s = 0; s < sects; s++)
+    {
+        Vector2 pos = {x + 100.0f * s, 450.0f};
+        colony->AddSect(new Sect(pos, resources, time));
+    }
+    return colony;
+}
+
+// Every system in play on a few colonies, small enough to run for days
+inline const char* const BUSY_WORLD =
+    "colonies=3,sects=3-6,roads=1,modes=1:1:1,active=0.5,build=1,tier=3,"
+    "separation=1,prospecting=1,packets=40,seed=11";
+
+constexpr int STEPS_PER_DAY = 600;
+
+inline WorldSpec ParsedSpec(const std::string& text)
+{
+    WorldSpec spec;
+    std::string error;
+    INFO(error);
+    REQUIRE(ParseWorldSpec(text, spec, &error));
+    return spec;
+}
+
+// A world from a WorldSpec string, stepped the way SimScheduler steps it
+struct GeneratedWorld
+{
+    WorldSpec spec;
+    ResourceManager resources;
+    TimeManager time;
+    SimStepper stepper;
+    std::vector<Colony*> colonies;
+    WorldStats stats;
+
+    explicit GeneratedWorld(const std::string& text)
+        : spec(ParsedSpec(text)),
+          resources(WorldGridSize(spec), SECT_CORE_RADIUS * 2.0f)
+    {
+        GenerateWorld(spec, resources, time, colonies, stepper.GetClock(), &stats);
+    }
+
+    ~GeneratedWorld()
+    {
+        stepper.Release();
+        for (Colony* colony : colonies) delete colony;
+    }
+
+    GeneratedWorld(const GeneratedWorld&) = delete;
+    GeneratedWorld& operator=(const GeneratedWorld&) = delete;
+
+    void Run(int steps)
+    {
+        for (int step = 0; step < steps; step++)
+        {
+            time.Advance(SimScheduler::STEP_SECONDS);
+            stepper.Step(colonies, SimScheduler::STEP_SECONDS);
+        }
+    }
+
+    std::vector<Colony*> First(size_t count) const
+    {
+        return std::vector<Colony*>(colonies.begin(), colonies.begin() + count);
+    }
+
+    uint64_t Hash()
+    {
+        ByteWriter scratch;
+        return HashSimulationState(resources, time, colonies, scratch);
+    }
+};
@@ -0,0 +1,111 @@
+#include <catch2/catch_test_macros.hpp>
+#include "job_system.h"
+#include "sect.h"
+#include "time_manager.h"
+#include "test_helpers.h"
+#include <atomic>
+#include <vector>
+
+TEST_CASE("ParallelFor runs every index exactly once", "[job_system]")
+{
+    for (int workers : {0, 1, 3})
+    {
+        JobSystem jobs(workers);
+        REQUIRE(jobs.GetWorkerCount() == workers);
+
+        std::vector<std::atomic<int>> hits(1000);
+        for (int round = 0; round < 20; round++)
+        {
+            jobs.ParallelFor(static_cast<int>(hits.size()), [&](int i) { hits[i]++; });
+        }
+        for (const auto& count : hits)
+        {
+            REQUIRE(count.load() == 20);
+        }
+
+        int calls = 0;
+        jobs.ParallelFor(0, [&](int) { calls++; });
+        REQUIRE(calls == 0);
+    }
+}
+
+TEST_CASE("ParallelFor blocks until uneven tasks finish", "[job_system]")
+{
+    JobSystem jobs(3);
+    std::vector<long> sums(64, 0);
+
+    // Index 0 does far more work than the rest
+    jobs.ParallelFor(static_cast<int>(sums.size()), [&](int i) {
+        long iterations = (i == 0) ? 2000000 : 1000;
+        long sum = 0;
+        for (long k = 0; k < iterations; k++) sum += k % 7;
+        sums[i] = sum;
+    });
+
+    for (size_t i = 0; i < sums.size(); i++)
+    {
+        REQUIRE(sums[i] > 0);
+    }
+}
+
+// Sects stepped as parallel tasks, depletion applied afterwards in sect
+// order, must leave the planet and every sect exactly as the serial loop.
+TEST_CASE("Parallel sect step matches the serial step", "[job_system]")
+{
+    ResourceManager serialRm = MakeTestResourceManager();
+    ResourceManager parallelRm = MakeTestResourceManager();
+    TimeManager tm;
+
+    // Three sects share a cell, so their depletion order matters
+    std::vector<Vector2> positions = {
+        {900.0f, 900.0f}, {900.0f, 900.0f}, {900.0f, 900.0f}, {300.0f, 1500.0f}, {1500.0f, 300.0f}
+    };
+    std::vector<Sect*> serial;
+    std::vector<Sect*> parallel;
+    for (Vector2 position : positions)
+    {
+        serial.push_back(new Sect(position, serialRm, tm));
+        parallel.push_back(new Sect(position, parallelRm, tm));
+    }
+    unsigned int versionBefore = serialRm.GetResourceMapVersion();
+
+    JobSystem jobs(3);
+    const float dt = 1.0f / 30.0f;
+    for (int tick = 0; tick < 300; tick++)
+    {
+        for (Sect* sect : serial)
+        {
+            sect->Update(dt);
+        }
+
+        jobs.ParallelFor(static_cast<int>(parallel.size()), [&](int i) { parallel[i]->UpdateLocal(dt); });
+        for (Sect* sect : parallel)
+        {
+            sect->CommitDepletion();
+        }
+    }
+
+    REQUIRE(serialRm.GetResourceMapVersion() > versionBefore);
+    REQUIRE(parallelRm.GetResourceMapVersion() == serialRm.GetResourceMapVersion());
+
+    for (int y = 0; y < serialRm.GetGridSize(); y++)
+    {
+        for (int x = 0; x < serialRm.GetGridSize(); x++)
+        {
+            REQUIRE(parallelRm.GetResourcesAtGrid(x, y) == serialRm.GetResourcesAtGrid(x, y));
+        }
+    }
+    for (size_t i = 0; i < serial.size(); i++)
+    {
+        const ResourceVector& a = serial[i]->GetResourceStorage();
+        const ResourceVector& b = parallel[i]->GetResourceStorage();
+        REQUIRE(a.GetMask() == b.GetMask());
+        for (const auto& [type, amount] : a)
+        {
+            REQUIRE(b.Get(type) == amount);
+        }
+    }
+
+    for (Sect* sect : serial) delete sect;
+    for (Sect* sect : parallel) delete sect;
+}
@@ -0,0 +1,146 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include "module_store.h"
+#include "sect.h"
+#include "resource_manager.h"
+#include "time_manager.h"
+#include <vector>
+
+using Catch::Matchers::WithinAbs;
+
+// Two identical worlds: one stepped unit by unit through Unit::Update,
+// one through the ModuleStore. Extraction units stay idle in both so only
+// the module step differs.
+namespace
+{
+    const float DT = 1.0f / 30.0f;
+
+    struct World
+    {
+        std::vector<Sect*> sects;
+
+        World(ResourceManager& rm, TimeManager& tm)
+        {
+            for (int i = 0; i < 3; i++)
+            {
+                Vector2 position = {200.0f * i, 0.0f};
+                Sect* sect = new Sect(position, rm, tm);
+                // Units start sect storage full; leave some water, no energy
+                sect->ConsumeResource(ResourceType::WATER, 990.0f - 5.0f * i);
+                sect->ConsumeResource(ResourceType::ENERGY, 1000.0f);
+                for (Unit* unit : sect->GetUnits())
+                {
+                    if (unit->GetType() == UnitType::Extraction) unit->Stop();
+                    else if (unit->GetType() != UnitType::Manufacture) unit->Start();
+                }
+                sects.push_back(sect);
+            }
+        }
+        ~World()
+        {
+            for (Sect* sect : sects) delete sect;
+        }
+
+        Unit* Find(int sect, UnitType type) const
+        {
+            for (Unit* unit : sects[sect]->GetUnits())
+            {
+                if (unit->GetType() == type) return unit;
+            }
+            return nullptr;
+        }
+
+        void StepClassic()
+        {
+            for (Sect* sect : sects)
+            {
+                for (Unit* unit : sect->GetUnits()) unit->Update(DT);
+            }
+        }
+    };
+
+    void RequireSameStorage(const World& a, const World& b)
+    {
+        for (size_t s = 0; s < a.sects.size(); s++)
+        {
+            const ResourceVector& lhs = a.sects[s]->GetResourceStorage();
+            const ResourceVector& rhs = b.sects[s]->GetResourceStorage();
+            REQUIRE(lhs.GetMask() == rhs.GetMask());
+            for (const auto& [type, amount] : lhs)
+            {
+                REQUIRE_THAT(rhs.Get(type), WithinAbs(amount, 1e-4));
+            }
+            for (size_t u = 0; u < a.sects[s]->GetUnits().size(); u++)
+            {
+                const ResourceVector& lhsBuffer = a.sects[s]->GetUnits()[u]->GetOverflowBuffer();
+                const ResourceVector& rhsBuffer = b.sects[s]->GetUnits()[u]->GetOverflowBuffer();
+                REQUIRE(lhsBuffer.GetMask() == rhsBuffer.GetMask());
+                for (const auto& [type, amount] : lhsBuffer)
+                {
+                    REQUIRE_THAT(rhsBuffer.Get(type), WithinAbs(amount, 1e-4));
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("ModuleStore groups modules by kind across sects", "[module_store]")
+{
+    ResourceManager rm(20, 100.0f);
+    TimeManager tm;
+    World world(rm, tm);
+    ModuleStore store;
+
+    store.Rebuild(world.sects);
+    REQUIRE_FALSE(store.IsStale(world.sects));
+    REQUIRE(store.GetUnitCount() == 3 * 7);                    // every unit but Extraction
+    REQUIRE(store.GetModuleCount(ModuleKind::IRRIGATION) == 3);
+    REQUIRE(store.GetModuleCount(ModuleKind::SOLAR_ARRAY) == 3);
+    REQUIRE(store.GetModuleCount(ModuleKind::PROSPECTING) == 0);
+    REQUIRE(world.Find(0, UnitType::Farming)->AreModulesBatched());
+    REQUIRE_FALSE(world.Find(0, UnitType::Extraction)->AreModulesBatched());
+
+    // A rate or activation change invalidates the copy
+    world.Find(1, UnitType::Farming)->DeactivateModule(0);
+    REQUIRE(store.IsStale(world.sects));
+
+    store.Release();
+    REQUIRE_FALSE(world.Find(0, UnitType::Farming)->AreModulesBatched());
+}
+
+TEST_CASE("Batched module step matches ProcessModuleEffects", "[module_store]")
+{
+    ResourceManager rm(20, 100.0f);
+    TimeManager tm;
+    World classic(rm, tm);
+    World batched(rm, tm);
+    ModuleStore store;
+
+    // Long enough for water to run out; food and energy sit at capacity,
+    // so production spills into the overflow buffers
+    for (int i = 0; i < 1500; i++)
+    {
+        classic.StepClassic();
+        store.Update(batched.sects, DT);
+        batched.StepClassic();      // batched units skip their module step
+    }
+    RequireSameStorage(classic, batched);
+    REQUIRE(classic.sects[0]->GetResourceStorage().Get(ResourceType::WATER) == 0.0f);
+
+    SECTION("and keeps matching after modules change")
+    {
+        for (World* world : {&classic, &batched})
+        {
+            world->Find(0, UnitType::Farming)->DeactivateModule(0);
+            world->Find(2, UnitType::Research)->Stop();
+            world->sects[1]->AddResource(ResourceType::WATER, 100.0f);
+        }
+        for (int i = 0; i < 300; i++)
+        {
+            classic.StepClassic();
+            store.Update(batched.sects, DT);
+            batched.StepClassic();
+        }
+        RequireSameStorage(classic, batched);
+    }
+}
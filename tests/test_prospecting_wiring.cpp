@@ -11,8 +11,8 @@ namespace
         ResourceManager rm;
         TimeManager tm;
         Vector2 position;
-        std::map<ResourceType, float> storage;
-        std::map<ResourceType, float> capacity;
+        ResourceVector storage;
+        ResourceVector capacity;
 
         UnitFixture()
             : rm(20, 100.0f)
@@ -0,0 +1,65 @@
+#include <catch2/catch_test_macros.hpp>
+#include "resource_manager.h"
+#include "test_helpers.h"
+#include <algorithm>
+
+TEST_CASE("Resource map version tracks abundance changes", "[resource_manager]")
+{
+    ResourceManager rm = MakeTestResourceManager();
+    unsigned int mapVersion = rm.GetResourceMapVersion();
+    unsigned int surveyVersion = rm.GetSurveyVersion();
+
+    REQUIRE(mapVersion > 0);
+    REQUIRE(surveyVersion > 0);
+
+    SECTION("Depletion bumps the resource version only")
+    {
+        rm.EnsureBasicResources(5, 5);
+        unsigned int before = rm.GetResourceMapVersion();
+        rm.UpdateResourceDepletion(5, 5, ResourceType::Fe, 1.0f);
+        REQUIRE(rm.GetResourceMapVersion() == before + 1);
+        REQUIRE(rm.GetSurveyVersion() == surveyVersion);
+    }
+
+    SECTION("No-op depletion leaves the version alone")
+    {
+        rm.UpdateResourceDepletion(5, 5, ResourceType::Fe, 0.0f);
+        rm.UpdateResourceDepletion(-1, 5, ResourceType::Fe, 1.0f);
+        REQUIRE(rm.GetResourceMapVersion() == mapVersion);
+    }
+
+    SECTION("The overlay version moves only with a cell's colour")
+    {
+        rm.EnsureBasicResources(5, 5);
+        auto resources = rm.GetResourcesAtGrid(5, 5);
+        auto least = std::min_element(resources.begin(), resources.end(),
+                                      [](const auto& a, const auto& b) { return a.second < b.second; });
+        unsigned int overlay = rm.GetOverlayVersion();
+        rm.UpdateResourceDepletion(5, 5, least->first, 1.0f);
+        REQUIRE(rm.GetOverlayVersion() == overlay);
+
+        for (const auto& [type, amount] : resources)
+        {
+            rm.UpdateResourceDepletion(5, 5, type, amount);
+        }
+        REQUIRE(rm.GetResourceDebugColor(5, 5).a == 0);
+        REQUIRE(rm.GetOverlayVersion() > overlay);
+    }
+
+    SECTION("Survey regeneration bumps the survey version")
+    {
+        rm.GenerateOrbitalSurveyData();
+        REQUIRE(rm.GetSurveyVersion() == surveyVersion + 1);
+    }
+}
+
+TEST_CASE("Resource debug colour", "[resource_manager]")
+{
+    ResourceManager rm = MakeTestResourceManager();
+
+    REQUIRE(rm.GetResourceDebugColor(-1, 0).a == 0);
+    REQUIRE(rm.GetResourceDebugColor(0, rm.GetGridSize()).a == 0);
+
+    rm.EnsureBasicResources(3, 3);
+    REQUIRE(rm.GetResourceDebugColor(3, 3).a > 0);
+}
@@ -85,3 +85,34 @@ TEST_CASE("GetResourceDescriptor lookup", "[resource_types]")
     REQUIRE(desc.category == ResourceCategory::SINGULAR);
     REQUIRE(desc.type == ResourceType::Fe);
 }
+
+TEST_CASE("Descriptor table is indexed by ResourceType", "[resource_types]")
+{
+    static_assert(GetResourceDescriptors().size() == RESOURCE_TYPE_COUNT, "one descriptor per type");
+    static_assert(ResourceTables::DESCRIPTORS[static_cast<int>(ResourceType::ALLOYS)].subtypes.size() == 4,
+                  "subtype ranges are known at compile time");
+
+    for (int i = 0; i < RESOURCE_TYPE_COUNT; i++)
+    {
+        ResourceType type = static_cast<ResourceType>(i);
+        REQUIRE(&GetResourceDescriptor(type) == &GetResourceDescriptors()[i]);
+    }
+}
+
+TEST_CASE("Singular and typed lists partition the resource types", "[resource_types]")
+{
+    REQUIRE(SINGULAR_RESOURCE_TYPES.size() + TYPED_RESOURCE_TYPES.size() == RESOURCE_TYPE_COUNT);
+
+    for (ResourceType type : SINGULAR_RESOURCE_TYPES)
+    {
+        REQUIRE(GetResourceCategory(type) == ResourceCategory::SINGULAR);
+    }
+    for (ResourceType type : TYPED_RESOURCE_TYPES)
+    {
+        REQUIRE(GetResourceCategory(type) == ResourceCategory::TYPED);
+    }
+
+    REQUIRE(SINGULAR_RESOURCE_TYPES.front() == ResourceType::ENERGY);
+    REQUIRE(TYPED_RESOURCE_TYPES.front() == ResourceType::MACHINERY);
+    REQUIRE(ResourceUtils::GetSubtypes(ResourceType::MACHINERY)[0] == std::string("HeavyDrill"));
+}
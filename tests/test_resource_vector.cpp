@@ -0,0 +1,251 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include "resource_vector.h"
+#include "separation_node.h"
+#include <algorithm>
+#include <map>
+#include <vector>
+
+using Catch::Matchers::WithinAbs;
+
+TEST_CASE("ResourceVector tracks which resources are present", "[resource_vector]")
+{
+    ResourceVector v;
+    REQUIRE(v.Empty());
+    REQUIRE(v.Get(ResourceType::Fe) == 0.0f);
+    REQUIRE_FALSE(v.Has(ResourceType::Fe));
+
+    v[ResourceType::Fe] = 3.0f;
+    v[ResourceType::WATER];                     // operator[] inserts, like the map
+    REQUIRE(v.Has(ResourceType::Fe));
+    REQUIRE(v.Has(ResourceType::WATER));
+    REQUIRE(v.Get(ResourceType::WATER) == 0.0f);
+    REQUIRE(v.Count() == 2);
+
+    v.Erase(ResourceType::Fe);
+    REQUIRE_FALSE(v.Has(ResourceType::Fe));
+    REQUIRE(v.Get(ResourceType::Fe) == 0.0f);
+    REQUIRE(v.Count() == 1);
+
+    v.Clear();
+    REQUIRE(v.Empty());
+}
+
+TEST_CASE("ResourceVector iterates present entries in enum order", "[resource_vector]")
+{
+    ResourceVector v = {
+        {ResourceType::CONSTRUCTION_MATERIALS, 4.0f},
+        {ResourceType::Fe, 2.0f},
+        {ResourceType::ENERGY, 1.0f}
+    };
+
+    std::vector<ResourceType> order;
+    for (const auto& [type, amount] : v)
+    {
+        order.push_back(type);
+    }
+    REQUIRE(order == std::vector<ResourceType>{ResourceType::ENERGY, ResourceType::Fe,
+                                               ResourceType::CONSTRUCTION_MATERIALS});
+
+    // Non-const iteration writes through
+    for (auto [type, amount] : v)
+    {
+        amount *= 10.0f;
+    }
+    REQUIRE(v.Get(ResourceType::Fe) == 20.0f);
+    REQUIRE(v.Get(ResourceType::CONSTRUCTION_MATERIALS) == 40.0f);
+}
+
+TEST_CASE("ResourceVector whole-vector arithmetic", "[resource_vector]")
+{
+    ResourceVector storage = {{ResourceType::Fe, 10.0f}, {ResourceType::Si, 4.0f}};
+    ResourceVector rates = {{ResourceType::Fe, 2.0f}, {ResourceType::H2, 1.0f}};
+
+    SECTION("AddScaled adds and marks the rate's resources present")
+    {
+        storage.AddScaled(rates, 0.5f);
+        REQUIRE(storage.Get(ResourceType::Fe) == 11.0f);
+        REQUIRE(storage.Get(ResourceType::H2) == 0.5f);
+        REQUIRE(storage.Get(ResourceType::Si) == 4.0f);
+        REQUIRE(storage.Has(ResourceType::H2));
+    }
+
+    SECTION("Drain floors drained resources at zero and leaves others alone")
+    {
+        storage[ResourceType::Ca] = -1.0f;      // untouched: not in the rates
+        storage.Drain(rates, 10.0f);
+        REQUIRE(storage.Get(ResourceType::Fe) == 0.0f);
+        REQUIRE(storage.Get(ResourceType::H2) == 0.0f);
+        REQUIRE(storage.Has(ResourceType::H2));
+        REQUIRE(storage.Get(ResourceType::Si) == 4.0f);
+        REQUIRE(storage.Get(ResourceType::Ca) == -1.0f);
+    }
+
+    SECTION("ClampTo and Min bound against another vector")
+    {
+        ResourceVector cap = {{ResourceType::Fe, 6.0f}, {ResourceType::Si, 6.0f}};
+        storage.ClampTo(cap);
+        REQUIRE(storage.Get(ResourceType::Fe) == 6.0f);
+        REQUIRE(storage.Get(ResourceType::Si) == 4.0f);
+
+        storage.Min(rates);
+        REQUIRE(storage.Get(ResourceType::Fe) == 2.0f);
+        REQUIRE(storage.Get(ResourceType::Si) == 0.0f);
+    }
+
+    SECTION("Deposit fills to capacity and buffers the rest")
+    {
+        ResourceVector cap = {{ResourceType::Fe, 11.0f}, {ResourceType::Si, 4.0f}};
+        ResourceVector overflow;
+        storage.Deposit(rates * 2.0f, cap, overflow);
+        REQUIRE(storage.Get(ResourceType::Fe) == 11.0f);
+        REQUIRE(overflow.Get(ResourceType::Fe) == 3.0f);
+        REQUIRE(storage.Get(ResourceType::H2) == 2.0f);   // no capacity entry: taken in full
+        REQUIRE(overflow.Has(ResourceType::Fe));
+        REQUIRE_FALSE(overflow.Has(ResourceType::H2));
+        REQUIRE_FALSE(overflow.Has(ResourceType::Si));
+    }
+
+    SECTION("Scale, Dot and Sum")
+    {
+        ResourceVector scaled = storage * 0.5f;
+        REQUIRE(scaled.Get(ResourceType::Fe) == 5.0f);
+        REQUIRE(scaled.GetMask() == storage.GetMask());
+        REQUIRE(storage.Dot(rates) == 20.0f);
+        REQUIRE(storage.Sum() == 14.0f);
+        REQUIRE((storage + rates).Sum() == 17.0f);
+    }
+}
+
+TEST_CASE("SeparationNode output matches the per-resource formula", "[resource_vector][separation]")
+{
+    SeparationNode node = SeparationNodes::CreateMagnetic();
+    node.wear = 0.2f;
+    ResourceVector input = {{ResourceType::Fe, 3.0f}, {ResourceType::Ti, 2.0f}, {ResourceType::Si, 5.0f}};
+
+    ResourceVector output = node.Process(input, 0.5f);
+
+    float eff = node.efficiency * (1.0f - node.wear * 0.5f);
+    float totalInput = 3.0f * 1.0f + 2.0f * 0.8f;   // Si is not an input of this node
+    REQUIRE(output.Count() == 2);
+    REQUIRE_THAT(output.Get(ResourceType::Fe), WithinAbs(totalInput * 0.90f * eff * 0.5f, 1e-5));
+    REQUIRE_THAT(output.Get(ResourceType::Ti), WithinAbs(totalInput * 0.70f * eff * 0.5f, 1e-5));
+
+    node.isActive = false;
+    REQUIRE(node.Process(input, 0.5f).Empty());
+}
+
+// ---- Map vs ResourceVector economy tick ----
+//
+// One unit tick as Unit::ProcessModuleEffects runs it: drain each active
+// module's consumption, add its production, clamp to capacity. The map
+// version is the code this replaced.
+
+namespace
+{
+    using ResourceMap = std::map<ResourceType, float>;
+
+    struct TickModule
+    {
+        ResourceMap consumptionMap;
+        ResourceMap productionMap;
+        ResourceVector consumption;
+        ResourceVector production;
+    };
+
+    struct Economy
+    {
+        std::vector<TickModule> modules;
+        ResourceMap storageMap;
+        ResourceMap capacityMap;
+        ResourceVector storage;
+        ResourceVector capacity;
+    };
+
+    Economy MakeEconomy()
+    {
+        Economy e;
+        for (int i = 0; i < RESOURCE_TYPE_COUNT; i++)
+        {
+            ResourceType type = static_cast<ResourceType>(i);
+            float amount = 50.0f + i;
+            e.storageMap[type] = amount;
+            e.storage[type] = amount;
+            e.capacityMap[type] = 500.0f;
+            e.capacity[type] = 500.0f;
+        }
+        for (int m = 0; m < 8; m++)
+        {
+            TickModule mod;
+            for (int i = 0; i < 5; i++)
+            {
+                ResourceType in = static_cast<ResourceType>((m + i) % RESOURCE_TYPE_COUNT);
+                ResourceType out = static_cast<ResourceType>((m * 3 + i + 7) % RESOURCE_TYPE_COUNT);
+                mod.consumptionMap[in] = 0.5f + 0.1f * i;
+                mod.consumption[in] = 0.5f + 0.1f * i;
+                mod.productionMap[out] = 1.0f + 0.2f * i;
+                mod.production[out] = 1.0f + 0.2f * i;
+            }
+            e.modules.push_back(mod);
+        }
+        return e;
+    }
+
+    void TickMap(Economy& e, float dt)
+    {
+        for (const auto& mod : e.modules)
+        {
+            for (const auto& [type, rate] : mod.consumptionMap)
+            {
+                e.storageMap[type] = std::max(0.0f, e.storageMap[type] - rate * dt);
+            }
+            for (const auto& [type, rate] : mod.productionMap)
+            {
+                e.storageMap[type] = std::min(e.storageMap[type] + rate * dt, e.capacityMap[type]);
+            }
+        }
+    }
+
+    void TickVector(Economy& e, float dt)
+    {
+        for (const auto& mod : e.modules)
+        {
+            e.storage.Drain(mod.consumption, dt);
+            e.storage.AddScaled(mod.production, dt);
+            e.storage.ClampTo(e.capacity);
+        }
+    }
+}
+
+TEST_CASE("ResourceVector tick matches the map tick", "[resource_vector]")
+{
+    Economy e = MakeEconomy();
+    for (int i = 0; i < 300; i++)
+    {
+        TickMap(e, 1.0f / 30.0f);
+        TickVector(e, 1.0f / 30.0f);
+    }
+    for (const auto& [type, amount] : e.storageMap)
+    {
+        REQUIRE(e.storage.Has(type));
+        REQUIRE_THAT(e.storage.Get(type), WithinAbs(amount, 1e-3));
+    }
+}
+
+TEST_CASE("Economy tick: std::map vs ResourceVector", "[.][benchmark][resource_vector]")
+{
+    Economy e = MakeEconomy();
+
+    BENCHMARK("std::map tick")
+    {
+        TickMap(e, 1.0f / 30.0f);
+        return e.storageMap[ResourceType::Fe];
+    };
+
+    BENCHMARK("ResourceVector tick")
+    {
+        TickVector(e, 1.0f / 30.0f);
+        return e.storage.Get(ResourceType::Fe);
+    };
+}
@@ -0,0 +1,195 @@
+#include <catch2/catch_test_macros.hpp>
+#include "rewind_buffer.h"
+#include "colony.h"
+#include "sect.h"
+#include "time_manager.h"
+#include "sim_clock.h"
+#include "unlock_registry.h"
+#include "test_helpers.h"
+#include <string>
+#include <vector>
+
+namespace {
+
+int FindCellWith(const ResourceManager& resources, ResourceType wanted)
+{
+    const int gridSize = resources.GetGridSize();
+    for (int cell = 0; cell < gridSize * gridSize; cell++)
+    {
+        for (const auto& [type, abundance] : resources.GetResourcesAtGrid(cell % gridSize, cell / gridSize))
+        {
+            if (type == wanted && abundance > 2.0f) return cell;
+        }
+    }
+    return -1;
+}
+
+// What the comparisons look at: every sect in full, the colonies' reserves
+// and road counts, and the planet's cells
+struct WorldState
+{
+    std::vector<std::vector<uint8_t>> sects;
+    std::vector<ResourceVector> reserves;
+    std::vector<size_t> roads;
+    std::vector<std::vector<std::pair<ResourceType, float>>> cells;
+};
+
+WorldState ReadWorld(const ResourceManager& resources, const std::vector<Colony*>& colonies)
+{
+    WorldState state;
+    for (const Colony* colony : colonies)
+    {
+        for (const Sect* sect : colony->GetSects())
+        {
+            ByteWriter out;
+            sect->SaveState(out);
+            state.sects.push_back(out.GetBytes());
+        }
+        state.reserves.push_back(colony->GetStrategicReserves());
+        state.roads.push_back(colony->GetRoads().size());
+    }
+    const int gridSize = resources.GetGridSize();
+    for (int cell = 0; cell < gridSize * gridSize; cell++)
+    {
+        state.cells.push_back(resources.GetResourcesAtGrid(cell % gridSize, cell / gridSize));
+    }
+    return state;
+}
+
+void RequireSameWorld(const WorldState& a, const WorldState& b)
+{
+    REQUIRE(a.sects == b.sects);
+    REQUIRE(a.roads == b.roads);
+    REQUIRE(a.cells == b.cells);
+    REQUIRE(a.reserves.size() == b.reserves.size());
+    for (size_t c = 0; c < a.reserves.size(); c++)
+    {
+        for (ResourceType type : SINGULAR_RESOURCE_TYPES)
+        {
+            REQUIRE(a.reserves[c].Get(type) == b.reserves[c].Get(type));
+        }
+    }
+}
+
+} // namespace
+
+TEST_CASE("Rewind snapshots take new pages only for what changed", "[rewind]")
+{
+    ResourceManager resources = MakeTestResourceManager();
+    TimeManager time;
+    ManualClock clock;
+    std::vector<Colony*> colonies = {MakeColony(resources, time, clock, 250.0f, 3),
+                                     MakeColony(resources, time, clock, 1250.0f, 2)};
+
+    RewindBuffer rewind(3);
+    rewind.Capture(resources, time, colonies);
+    int objects = resources.GetCellChunksPerSide() * resources.GetCellChunksPerSide();
+    for (const Colony* colony : colonies)
+    {
+        objects++;
+        for (const Sect* sect : colony->GetSects())
+        {
+            objects += 1 + static_cast<int>(sect->GetUnits().size());
+        }
+    }
+    RewindBuffer::Stats stats = rewind.GetStats();
+    REQUIRE(stats.lastCapturePages == objects);
+    REQUIRE(stats.baseBytes == stats.retainedBytes);
+
+    // Nothing changed: every page shared
+    rewind.Capture(resources, time, colonies);
+    stats = rewind.GetStats();
+    REQUIRE(stats.lastCapturePages == 0);
+    REQUIRE(stats.lastCaptureBytes == 0);
+
+    // One sect's storage; one unit, which takes its sect along; one cell
+    colonies[1]->GetSects()[0]->AddResource(ResourceType::Si, 5.0f);
+    rewind.Capture(resources, time, colonies);
+    REQUIRE(rewind.GetStats().lastCapturePages == 1);
+
+    colonies[0]->GetSects()[2]->GetUnits()[1]->Stop();
+    rewind.Capture(resources, time, colonies);
+    REQUIRE(rewind.GetStats().lastCapturePages == 2);
+
+    const int feCell = FindCellWith(resources, ResourceType::Fe);
+    REQUIRE(feCell >= 0);
+    const int gridSize = resources.GetGridSize();
+    resources.UpdateResourceDepletion(feCell % gridSize, feCell / gridSize, ResourceType::Fe, 1.0f);
+    time.Advance(TICK_DURATION * 4);
+    rewind.Capture(resources, time, colonies);
+    stats = rewind.GetStats();
+    REQUIRE(stats.lastCapturePages == 1);
+
+    // The ring holds the newest three, sharing the rest
+    REQUIRE(stats.snapshots == 3);
+    REQUIRE(rewind.GetTicks(2) == time.GetTicks());
+    REQUIRE(stats.retainedSeconds == TICK_DURATION * 4);
+    REQUIRE(stats.retainedBytes > stats.baseBytes);
+    REQUIRE(stats.retainedBytes < stats.baseBytes * 2);
+    REQUIRE(stats.bytesPerSecond > 0.0f);
+
+    for (Colony* colony : colonies) delete colony;
+}
+
+TEST_CASE("Restoring a snapshot rewinds the game and drops the newer ones", "[rewind]")
+{
+    ResourceManager resources = MakeTestResourceManager();
+    TimeManager time;
+    ManualClock clock;
+    std::vector<Colony*> colonies = {MakeColony(resources, time, clock, 250.0f, 3)};
+    Colony* first = colonies[0];
+    const std::vector<std::string> techsBefore = UnlockRegistry::Instance().GetAll();
+    UnlockRegistry::Instance().Restore({});
+
+    RewindBuffer rewind;
+    StepWorld(colonies, time, clock, 3);
+    rewind.Capture(resources, time, colonies);
+    const WorldState before = ReadWorld(resources, colonies);
+    const int ticksBefore = time.GetTicks();
+
+    // Roads, a new sect and colony, a tech, module changes, depletion
+    StepWorld(colonies, time, clock, 4);
+    first->BuildRoad(first->GetSects()[0], first->GetSects()[1]);
+    Vector2 newSect = {550.0f, 450.0f};
+    first->AddSect(new Sect(newSect, resources, time));
+    first->GetSects()[1]->GetUnits()[0]->DebugUpgradeModuleTier(0);
+    colonies.push_back(MakeColony(resources, time, clock, 1200.0f, 2));
+    UnlockRegistry::Instance().Restore({"Geophysics"});
+    const int feCell = FindCellWith(resources, ResourceType::Fe);
+    const int gridSize = resources.GetGridSize();
+    resources.UpdateResourceDepletion(feCell % gridSize, feCell / gridSize, ResourceType::Fe, 2.0f);
+    rewind.Capture(resources, time, colonies);
+    StepWorld(colonies, time, clock, 5);
+    rewind.Capture(resources, time, colonies);
+
+    REQUIRE(rewind.GetCount() == 3);
+    REQUIRE(rewind.FindBefore(time.GetTicks()) == 1);
+    REQUIRE(rewind.FindBefore(time.GetTicks() + 1) == 2);
+    REQUIRE(rewind.FindBefore(ticksBefore) == -1);
+
+    ManualClock restoredClock(clock.Now());
+    std::vector<Colony*> restored;
+    ResourceManager otherPlanet(8, 100.0f);
+    REQUIRE_FALSE(rewind.Restore(0, otherPlanet, time, restored, &restoredClock));
+    REQUIRE_FALSE(rewind.Restore(3, resources, time, restored, &restoredClock));
+    REQUIRE(restored.empty());
+
+    REQUIRE(rewind.Restore(0, resources, time, restored, &restoredClock));
+    REQUIRE(time.GetTicks() == ticksBefore);
+    REQUIRE_FALSE(UnlockRegistry::Instance().IsUnlocked("Geophysics"));
+    RequireSameWorld(before, ReadWorld(resources, restored));
+    REQUIRE(rewind.GetCount() == 1);
+
+    // The restored objects took over the pages: an unchanged capture shares all
+    rewind.Capture(resources, time, restored);
+    REQUIRE(rewind.GetStats().lastCapturePages == 0);
+
+    // And the game carries on from there
+    StepWorld(restored, time, restoredClock, 2);
+    rewind.Capture(resources, time, restored);
+    REQUIRE(rewind.GetStats().lastCapturePages > 0);
+
+    for (Colony* colony : restored) delete colony;
+    for (Colony* colony : colonies) delete colony;
+    UnlockRegistry::Instance().Restore(techsBefore);
+}
@@ -0,0 +1,367 @@
+#include <catch2/catch_test_macros.hpp>
+#include "block_codec.h"
+#include "save_file.h"
+#include "game_snapshot.h"
+#include "colony.h"
+#include "sect.h"
+#include "time_manager.h"
+#include "sim_clock.h"
+#include "unlock_registry.h"
+#include "test_helpers.h"
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+bool SameResources(const ResourceVector& a, const ResourceVector& b)
+{
+    if (a.GetMask() != b.GetMask()) return false;
+    for (auto [type, amount] : a)
+    {
+        if (b.Get(type) != amount) return false;
+    }
+    return true;
+}
+
+void RequireSameWorld(const std::vector<Colony*>& a, const std::vector<Colony*>& b)
+{
+    REQUIRE(a.size() == b.size());
+    for (size_t c = 0; c < a.size(); c++)
+    {
+        REQUIRE(SameResources(a[c]->GetStrategicReserves(), b[c]->GetStrategicReserves()));
+        REQUIRE(a[c]->GetTypedReserves().GetCount(ResourceType::ALLOYS) ==
+                b[c]->GetTypedReserves().GetCount(ResourceType::ALLOYS));
+        REQUIRE(a[c]->GetRoads().size() == b[c]->GetRoads().size());
+        REQUIRE(a[c]->GetTransportJobs().size() == b[c]->GetTransportJobs().size());
+        for (size_t j = 0; j < a[c]->GetTransportJobs().size(); j++)
+        {
+            REQUIRE(a[c]->GetTransportJobs()[j].progress == b[c]->GetTransportJobs()[j].progress);
+        }
+
+        const auto& sectsA = a[c]->GetSects();
+        const auto& sectsB = b[c]->GetSects();
+        REQUIRE(sectsA.size() == sectsB.size());
+        for (size_t s = 0; s < sectsA.size(); s++)
+        {
+            REQUIRE(SameResources(sectsA[s]->GetResourceStorage(), sectsB[s]->GetResourceStorage()));
+            REQUIRE(sectsA[s]->GetTotalTypedResourceCount(ResourceType::ALLOYS) ==
+                    sectsB[s]->GetTotalTypedResourceCount(ResourceType::ALLOYS));
+            REQUIRE(sectsA[s]->GetUnits().size() == sectsB[s]->GetUnits().size());
+            for (size_t u = 0; u < sectsA[s]->GetUnits().size(); u++)
+            {
+                const Unit* unitA = sectsA[s]->GetUnits()[u];
+                const Unit* unitB = sectsB[s]->GetUnits()[u];
+                REQUIRE(unitA->GetStatus() == unitB->GetStatus());
+                REQUIRE(unitA->GetModules().size() == unitB->GetModules().size());
+                for (size_t m = 0; m < unitA->GetModules().size(); m++)
+                {
+                    REQUIRE(unitA->GetModules()[m].tier == unitB->GetModules()[m].tier);
+                    REQUIRE(SameResources(unitA->GetModules()[m].productionRates,
+                                          unitB->GetModules()[m].productionRates));
+                }
+                REQUIRE(unitA->GetTotalRegolithExtracted() == unitB->GetTotalRegolithExtracted());
+            }
+        }
+    }
+}
+
+} // namespace
+
+TEST_CASE("Block codec round-trips and rejects damaged input", "[save_game]")
+{
+    std::vector<uint8_t> repetitive;
+    for (int i = 0; i < 5000; i++) repetitive.push_back(static_cast<uint8_t>(i % 7));
+
+    std::mt19937 random(7);
+    std::vector<uint8_t> noise(3000);
+    for (uint8_t& byte : noise) byte = static_cast<uint8_t>(random());
+
+    for (const std::vector<uint8_t>* input : {&repetitive, &noise})
+    {
+        std::vector<uint8_t> packed = BlockCodec::Compress(input->data(), input->size());
+        REQUIRE(packed.size() <= BlockCodec::MaxCompressedSize(input->size()));
+
+        std::vector<uint8_t> unpacked(input->size());
+        REQUIRE(BlockCodec::Decompress(packed.data(), packed.size(), unpacked.data(), unpacked.size()));
+        REQUIRE(unpacked == *input);
+    }
+    REQUIRE(BlockCodec::Compress(repetitive.data(), repetitive.size()).size() < repetitive.size() / 10);
+
+    // Empty input, and a stream cut short
+    std::vector<uint8_t> empty = BlockCodec::Compress(nullptr, 0);
+    REQUIRE(BlockCodec::Decompress(empty.data(), empty.size(), nullptr, 0));
+
+    std::vector<uint8_t> packed = BlockCodec::Compress(repetitive.data(), repetitive.size());
+    std::vector<uint8_t> out(repetitive.size());
+    REQUIRE_FALSE(BlockCodec::Decompress(packed.data(), packed.size() / 2, out.data(), out.size()));
+}
+
+TEST_CASE("Save file sections round-trip and fail their checksum when damaged", "[save_game]")
+{
+    const std::string path = TempSavePath("colony_test_sections.colony");
+
+    ByteWriter small;
+    small.Write<int32_t>(-42);
+    small.WriteString("regolith");
+    small.WriteResources(ResourceVector{{ResourceType::Fe, 1.5f}, {ResourceType::O2, 0.25f}});
+
+    ByteWriter large;
+    for (int i = 0; i < 4000; i++) large.Write<float>(static_cast<float>(i % 16));
+
+    SaveFileWriter writer;
+    writer.AddSection(1, small, false);
+    writer.AddSection(2, large, true);
+    REQUIRE(writer.GetStoredSize() < writer.GetRawSize());
+    REQUIRE(writer.WriteTo(path, 3, nullptr));
+
+    {
+        SaveFileReader reader;
+        REQUIRE(reader.Open(path, nullptr));
+        REQUIRE(reader.GetFormatVersion() == 3);
+        REQUIRE(reader.HasSection(1));
+        REQUIRE_FALSE(reader.HasSection(9));
+        REQUIRE(reader.VerifyAll(nullptr));
+
+        ByteReader in;
+        REQUIRE(reader.GetSection(1, in, nullptr));
+        REQUIRE(in.Read<int32_t>() == -42);
+        REQUIRE(in.ReadString() == "regolith");
+        ResourceVector resources = in.ReadResources();
+        REQUIRE(resources.Get(ResourceType::Fe) == 1.5f);
+        REQUIRE(resources.Get(ResourceType::O2) == 0.25f);
+        REQUIRE(in.Ok());
+        REQUIRE(in.GetRemaining() == 0);
+        in.Read<uint8_t>();
+        REQUIRE_FALSE(in.Ok());
+
+        REQUIRE(reader.GetSection(2, in, nullptr));
+        REQUIRE(in.GetRemaining() == 4000 * sizeof(float));
+        REQUIRE(in.Read<float>() == 0.0f);
+        REQUIRE(in.Read<float>() == 1.0f);
+    }
+
+    // Flip a byte of the first section's payload (just past the header)
+    FILE* file = std::fopen(path.c_str(), "r+b");
+    REQUIRE(file != nullptr);
+    std::fseek(file, 24, SEEK_SET);
+    int byte = std::fgetc(file);
+    std::fseek(file, 24, SEEK_SET);
+    std::fputc(byte ^ 0xFF, file);
+    std::fclose(file);
+
+    SaveFileReader reader;
+    REQUIRE(reader.Open(path, nullptr));
+    std::string error;
+    REQUIRE_FALSE(reader.VerifyAll(&error));
+    REQUIRE(error.find("checksum") != std::string::npos);
+    ByteReader in;
+    REQUIRE_FALSE(reader.GetSection(1, in, nullptr));
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("A saved world loads back identical and steps identically", "[save_game]")
+{
+    const std::string path = TempSavePath("colony_test_world.colony");
+
+    ResourceManager resources = MakeTestResourceManager();
+    TimeManager time;
+    ManualClock clock;
+    time.Advance(12.5f);
+
+    // Two colonies; the first with a road, a packet and some stock
+    std::vector<Colony*> colonies;
+    for (int c = 0; c < 2; c++)
+    {
+        Colony* colony = new Colony();
+        colony->SetClock(&clock);
+        colony->SetArchetype(c == 0 ? SiteArchetype::LAVA_TUBE : SiteArchetype::MIXED);
+        for (int s = 0; s < 3 - c; s++)
+        {
+            Vector2 pos = {250.0f + 600.0f * c + 100.0f * s, 450.0f + 100.0f * c};
+            colony->AddSect(new Sect(pos, resources, time));
+        }
+        colonies.push_back(colony);
+    }
+
+    Colony* first = colonies[0];
+    const auto& sects = first->GetSects();
+    first->BuildRoad(sects[0], sects[1]);
+    first->BuildRoad(sects[1], sects[2]);
+    first->SetRoadTransportMode(first->GetRoad(sects[1], sects[2]), TransportMode::MANUAL);
+    first->ReceiveSurplus(ResourceType::Fe, 75.0f);
+    first->AddTypedReserve(TypedResource(ResourceType::ALLOYS, "Steel", 0.9f));
+    sects[0]->AddResource(ResourceType::Fe, 123.5f);
+    sects[2]->AddTypedResource(TypedResource(ResourceType::ALLOYS, "SaveTestAlloy"));
+
+    Unit* extraction = sects[0]->GetUnits()[0];
+    REQUIRE(extraction->HasProspectingSystem());
+    extraction->DebugUpgradeModuleTier(0);
+    ProspectingSystem* prospecting = extraction->GetProspectingSystem();
+    prospecting->GetTray().AddSample(MakeFullCompositionSample(DepthLayer::SHALLOW, 0.7f));
+    prospecting->GetGrid().GetSubCellMut(1, 1).sweepSignal = 0.625f;
+    prospecting->GetGrid().RecordSweep(2, 15.0f, 12.0f);
+
+    StepWorld(colonies, time, clock, 5);
+    first->AddSyntheticTransportJob(first->GetRoad(sects[0], sects[1]), ResourceType::Si, 40.0f, 0.3f);
+
+    const std::vector<std::string> techsBefore = UnlockRegistry::Instance().GetAll();
+    UnlockRegistry::Instance().Restore({"Geophysics"});
+
+    SaveGame::SaveStats stats;
+    std::string error;
+    REQUIRE(SaveGame::Save(path, resources, time, colonies, true, &error, &stats));
+    REQUIRE(stats.fileBytes > 0);
+    REQUIRE(stats.fileBytes < stats.rawBytes);
+
+    SaveGame::Summary summary;
+    REQUIRE(SaveGame::ReadSummary(path, summary, &error));
+    REQUIRE(summary.colonyCount == 2);
+    REQUIRE(summary.sectCount == 5);
+    REQUIRE(summary.gridSize == resources.GetGridSize());
+    REQUIRE(summary.ticks == time.GetTicks());
+
+    UnlockRegistry::Instance().Restore({});
+    ResourceManager loadedResources(4, 1.0f);
+    TimeManager loadedTime;
+    std::vector<Colony*> loaded;
+    REQUIRE(SaveGame::Load(path, loadedResources, loadedTime, loaded, &error));
+    REQUIRE(UnlockRegistry::Instance().IsUnlocked("Geophysics"));
+
+    // Planet and clock
+    REQUIRE(loadedResources.GetGridSize() == resources.GetGridSize());
+    REQUIRE(loadedResources.GetResourcesAtGrid(3, 4) == resources.GetResourcesAtGrid(3, 4));
+    REQUIRE(loadedResources.GetResourcesAtGridLayer(5, 5, DepthLayer::DEEP) ==
+            resources.GetResourcesAtGridLayer(5, 5, DepthLayer::DEEP));
+    REQUIRE(loadedResources.GetSiteArchetype(7, 2) == resources.GetSiteArchetype(7, 2));
+    REQUIRE(loadedTime.GetGameTime() == time.GetGameTime());
+    REQUIRE(loadedTime.GetTicks() == time.GetTicks());
+
+    // Colonies, down to the prospecting tray
+    REQUIRE(loaded[0]->GetArchetype() == SiteArchetype::LAVA_TUBE);
+    REQUIRE(loaded[0]->GetSects()[0]->GetPosition().x == sects[0]->GetPosition().x);
+    REQUIRE(loaded[0]->GetRoads()[1].mode == TransportMode::MANUAL);
+    REQUIRE(loaded[0]->GetTransportJobs().size() == 1);
+    REQUIRE(loaded[0]->GetTransportJobs()[0].road == &loaded[0]->GetRoads()[0]);
+    REQUIRE(loaded[0]->GetTypedReserveCount(ResourceType::ALLOYS, "Steel") ==
+            first->GetTypedReserveCount(ResourceType::ALLOYS, "Steel"));
+    for (int s = 0; s < 3; s++)
+    {
+        REQUIRE(loaded[0]->GetSects()[s]->GetTypedResourceCount(ResourceType::ALLOYS, "SaveTestAlloy") ==
+                sects[s]->GetTypedResourceCount(ResourceType::ALLOYS, "SaveTestAlloy"));
+    }
+
+    const ProspectingSystem* loadedProspecting = loaded[0]->GetSects()[0]->GetUnits()[0]->GetProspectingSystem();
+    REQUIRE(loadedProspecting->GetTier() == prospecting->GetTier());
+    REQUIRE(loadedProspecting->GetTray().GetCount() == 1);
+    REQUIRE(loadedProspecting->GetTray().GetSamples()[0].id == prospecting->GetTray().GetSamples()[0].id);
+    REQUIRE(loadedProspecting->GetTray().GetSamples()[0].trueComposition ==
+            prospecting->GetTray().GetSamples()[0].trueComposition);
+    REQUIRE(loadedProspecting->GetGrid().GetSubCell(1, 1).sweepSignal == 0.625f);
+    REQUIRE(loadedProspecting->GetGrid().GetSweepHistory().size() == 1);
+    REQUIRE(loadedProspecting->GetSurveyProgress() == prospecting->GetSurveyProgress());
+    RequireSameWorld(colonies, loaded);
+
+    // Both worlds carry on the same way
+    ManualClock loadedClock(clock.Now());
+    for (Colony* colony : loaded) colony->SetClock(&loadedClock);
+    StepWorld(colonies, time, clock, 20);
+    StepWorld(loaded, loadedTime, loadedClock, 20);
+    RequireSameWorld(colonies, loaded);
+    REQUIRE(loadedResources.GetResourcesAtGrid(2, 4) == resources.GetResourcesAtGrid(2, 4));
+
+    for (Colony* colony : colonies) delete colony;
+    for (Colony* colony : loaded) delete colony;
+    UnlockRegistry::Instance().Restore(techsBefore);
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Packets in flight load back when they end the colony section", "[save_game]")
+{
+    const std::string path = TempSavePath("colony_test_packets.colony");
+
+    ResourceManager resources = MakeTestResourceManager();
+    TimeManager time;
+    ManualClock clock;
+    std::vector<Colony*> colonies = {MakeColony(resources, time, clock, 250.0f, 3)};
+    Colony* owner = colonies[0];
+    const auto& sects = owner->GetSects();
+    owner->BuildRoad(sects[0], sects[1]);
+    owner->BuildRoad(sects[1], sects[2]);
+
+    // The last bytes of the section are the job records; each is 26 bytes
+    owner->AddSyntheticTransportJob(owner->GetRoad(sects[0], sects[1]), ResourceType::Fe, 10.0f, 0.2f);
+    owner->AddSyntheticTransportJob(owner->GetRoad(sects[1], sects[2]), ResourceType::Si, 20.0f, 0.5f);
+    owner->AddSyntheticTransportJob(owner->GetRoad(sects[0], sects[1]), ResourceType::ENERGY, 30.0f, 0.8f);
+
+    std::string error;
+    REQUIRE(SaveGame::Save(path, resources, time, colonies, true, &error));
+
+    ResourceManager loadedResources(4, 1.0f);
+    TimeManager loadedTime;
+    std::vector<Colony*> loaded;
+    INFO(error);
+    REQUIRE(SaveGame::Load(path, loadedResources, loadedTime, loaded, &error));
+    REQUIRE(loaded.size() == 1);
+    REQUIRE(loaded[0]->GetTransportJobs().size() == 3);
+    RequireSameWorld(colonies, loaded);
+
+    for (Colony* colony : colonies) delete colony;
+    for (Colony* colony : loaded) delete colony;
+    std::remove(path.c_str());
+}
+
+TEST_CASE("A failed load leaves the running game untouched", "[save_game]")
+{
+    const std::string path = TempSavePath("colony_test_bad.colony");
+
+    ResourceManager resources = MakeTestResourceManager();
+    TimeManager time;
+    time.Advance(3.0f);
+    std::vector<Colony*> colonies;
+
+    std::string error;
+    REQUIRE_FALSE(SaveGame::Load(TempSavePath("colony_test_missing.colony"), resources, time, colonies, &error));
+    REQUIRE_FALSE(error.empty());
+
+    // A container with the right sections but another format version
+    SaveFileWriter writer;
+    ByteWriter empty;
+    writer.AddSection(SaveGame::SECTION_META, empty, false);
+    REQUIRE(writer.WriteTo(path, SaveGame::FORMAT_VERSION + 1, nullptr));
+    REQUIRE_FALSE(SaveGame::Load(path, resources, time, colonies, &error));
+    REQUIRE(error.find("format version") != std::string::npos);
+
+    // The right version with a colony section that runs short
+    ByteWriter planet;
+    resources.SaveState(planet);
+    ByteWriter clock;
+    time.SaveState(clock);
+    ByteWriter unlocks;
+    unlocks.WriteCount(0);
+    ByteWriter truncated;
+    truncated.WriteCount(1);
+    truncated.Write<uint8_t>(0);
+
+    SaveFileWriter bad;
+    bad.AddSection(SaveGame::SECTION_META, empty, false);
+    bad.AddSection(SaveGame::SECTION_TIME, clock, false);
+    bad.AddSection(SaveGame::SECTION_UNLOCKS, unlocks, false);
+    bad.AddSection(SaveGame::SECTION_PLANET, planet, true);
+    bad.AddSection(SaveGame::SECTION_COLONIES, truncated, false);
+    REQUIRE(bad.WriteTo(path, SaveGame::FORMAT_VERSION, nullptr));
+
+    ResourceManager small(6, 10.0f);
+    small.GenerateResourceMap(3);
+    unsigned int version = small.GetResourceMapVersion();
+    REQUIRE_FALSE(SaveGame::Load(path, small, time, colonies, &error));
+    REQUIRE(colonies.empty());
+    REQUIRE(small.GetGridSize() == 6);
+    REQUIRE(small.GetResourceMapVersion() == version);
+    REQUIRE(time.GetGameTime() == 3.0f);
+
+    std::remove(path.c_str());
+}
@@ -0,0 +1,325 @@
+#include <catch2/catch_test_macros.hpp>
+#include "session_recording.h"
+#include "command.h"
+#include "sim_stepper.h"
+#include "sim_scheduler.h"
+#include "byte_stream.h"
+#include "colony.h"
+#include "sect.h"
+#include "time_manager.h"
+#include "test_helpers.h"
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace {
+
+void DeleteColonies(std::vector<Colony*>& colonies)
+{
+    for (Colony* colony : colonies) delete colony;
+    colonies.clear();
+}
+
+// What GameManager does around a recording: the world reloaded from the
+// starting snapshot, commands applied and recorded, steps as the scheduler
+// runs them
+struct LiveSession
+{
+    ResourceManager resources = MakeTestResourceManager();
+    TimeManager time;
+    SimStepper stepper;
+    SessionRecorder recorder;
+    std::vector<Colony*> colonies;
+
+    ~LiveSession() { DeleteColonies(colonies); }
+
+    void Start(const std::string& path)
+    {
+        std::string error;
+        recorder.Begin(resources, time, colonies, stepper);
+        REQUIRE(recorder.WriteStart(path, &error));
+
+        stepper.Release();
+        std::vector<Colony*> loaded;
+        REQUIRE(SaveGame::Load(path, resources, time, loaded, &error, stepper.GetClock()));
+        DeleteColonies(colonies);
+        colonies = std::move(loaded);
+    }
+
+    bool Submit(const Command& command)
+    {
+        if (!ApplyCommand(command, resources, time, colonies, stepper.GetClock())) return false;
+        recorder.Record(command);
+        return true;
+    }
+
+    void Step(int steps)
+    {
+        for (int s = 0; s < steps; s++)
+        {
+            time.Advance(SimScheduler::STEP_SECONDS);
+            stepper.Step(colonies, SimScheduler::STEP_SECONDS);
+            recorder.AfterStep(resources, time, colonies);
+        }
+    }
+};
+
+Command ForColony(CommandType type, int colony, int a = 0, int b = 0)
+{
+    Command command(type, a, b);
+    command.colony = colony;
+    return command;
+}
+
+Command ForUnit(CommandType type, int colony, int sect, int unit, int a = 0, int b = 0, float value = 0.0f)
+{
+    Command command(type, a, b, 0, value);
+    command.colony = colony;
+    command.sect = sect;
+    command.unit = unit;
+    return command;
+}
+
+// A colony of three sects with roads and transport running, plus module
+// and prospecting commands along the way
+void PlaySession(LiveSession& session, const std::string& path)
+{
+    ManualClock setupClock;
+    REQUIRE(ApplyCommand(Command(CommandType::FOUND_COLONY, 2, 3), session.resources, session.time,
+                         session.colonies, &setupClock));
+    session.Start(path);
+
+    Command sect(CommandType::BUILD_SECT);
+    sect.colony = 0;
+    sect.x = 450.0f;
+    sect.y = 350.0f;
+    REQUIRE(session.Submit(sect));
+    sect.x = 250.0f;
+    sect.y = 500.0f;
+    REQUIRE(session.Submit(sect));
+    session.Step(20);
+
+    REQUIRE(session.Submit(ForColony(CommandType::BUILD_ROAD, 0, 0, 1)));
+    REQUIRE(session.Submit(ForColony(CommandType::BUILD_ROAD, 0, 1, 2)));
+    session.Step(40);
+
+    REQUIRE(session.Submit(ForColony(CommandType::SET_ROAD_MODE, 0, 1,
+                                     static_cast<int>(TransportMode::DEFICIT_TRIGGERED))));
+    REQUIRE(session.Submit(ForUnit(CommandType::PROSPECT_SWEEP, 0, 0, 0, 0)));
+    session.Step(45);
+
+    Unit* farming = session.colonies[0]->GetSects()[1]->GetUnits()[1];
+    int module = farming->GetActiveModuleIndices().empty() ? 0 : *farming->GetActiveModuleIndices().begin();
+    REQUIRE(session.Submit(ForUnit(CommandType::TOGGLE_MODULE, 0, 1, 1, module)));
+    session.Step(65);
+}
+
+} // namespace
+
+TEST_CASE("A recorded session replays headless with every hash agreeing", "[replay]")
+{
+    const std::string path = TempSavePath("colony_test_session.colonyrec");
+    LiveSession session;
+    PlaySession(session, path);
+
+    std::string error;
+    const int steps = session.recorder.GetStepCount();
+    const size_t commands = session.recorder.GetCommandCount();
+    REQUIRE(steps == 170);
+    REQUIRE(commands == 7);
+    REQUIRE(session.recorder.Finish(path, session.resources, session.time, session.colonies, &error));
+    REQUIRE_FALSE(session.recorder.IsRecording());
+
+    ByteWriter scratch;
+    const uint64_t liveHash = HashSimulationState(session.resources, session.time, session.colonies, scratch);
+
+    // Serial and parallel stepping replay the same
+    for (bool parallel : {true, false})
+    {
+        ResourceManager resources(0, 1.0f);
+        TimeManager time;
+        SimStepper stepper;
+        stepper.SetParallelUpdate(parallel);
+        std::vector<Colony*> colonies;
+        ReplayReport report;
+        REQUIRE(ReplaySession(path, ReplayOptions(), stepper, resources, time, colonies, report, &error));
+
+        REQUIRE(report.steps == steps);
+        REQUIRE(report.commands == static_cast<int>(commands));
+        REQUIRE(report.rejectedCommands == 0);
+        REQUIRE(report.hashesChecked == steps / REPLAY_HASH_INTERVAL_STEPS + 1);
+        REQUIRE(report.mismatches == 0);
+        REQUIRE(report.firstMismatchStep == -1);
+
+        REQUIRE(colonies.size() == 1);
+        REQUIRE(colonies[0]->GetSects().size() == 3);
+        REQUIRE(colonies[0]->GetRoads().size() == 2);
+        REQUIRE(HashSimulationState(resources, time, colonies, scratch) == liveHash);
+        stepper.Release();
+        DeleteColonies(colonies);
+    }
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("A change made outside the command path shows up as a mismatch", "[replay]")
+{
+    const std::string path = TempSavePath("colony_test_diverged.colonyrec");
+    LiveSession session;
+    ManualClock setupClock;
+    REQUIRE(ApplyCommand(Command(CommandType::FOUND_COLONY, 4, 4), session.resources, session.time,
+                         session.colonies, &setupClock));
+    session.Start(path);
+
+    session.Step(40);
+    // Not a command: never recorded, so the replay cannot reproduce it
+    session.colonies[0]->GetSects()[0]->AddResource(ResourceType::Si, 3.0f);
+    session.Step(80);
+
+    std::string error;
+    REQUIRE(session.recorder.Finish(path, session.resources, session.time, session.colonies, &error));
+
+    ResourceManager resources(0, 1.0f);
+    TimeManager time;
+    SimStepper stepper;
+    std::vector<Colony*> colonies;
+    ReplayReport report;
+    REQUIRE(ReplaySession(path, ReplayOptions(), stepper, resources, time, colonies, report, &error));
+    REQUIRE(report.mismatches == 1);
+    REQUIRE(report.firstMismatchStep == 60);        // the first check after step 40
+    REQUIRE(report.hashesChecked == 2);
+    REQUIRE(report.steps == 60);                    // stopped there
+    REQUIRE(report.expectedHash != report.actualHash);
+    stepper.Release();
+    DeleteColonies(colonies);
+
+    // Run on, every later check disagrees too
+    ReplayOptions keepGoing;
+    keepGoing.stopAtMismatch = false;
+    REQUIRE(ReplaySession(path, keepGoing, stepper, resources, time, colonies, report, &error));
+    REQUIRE(report.steps == 120);
+    REQUIRE(report.firstMismatchStep == 60);
+    REQUIRE(report.mismatches == 4);              // 60, 90, 120 and the final state
+    REQUIRE(report.hashesChecked == 5);
+    stepper.Release();
+    DeleteColonies(colonies);
+
+    // A plain save is not a recording
+    REQUIRE(SaveGame::Save(path, session.resources, session.time, session.colonies, true, &error));
+    REQUIRE_FALSE(ReplaySession(path, ReplayOptions(), stepper, resources, time, colonies, report, &error));
+    REQUIRE(error.find("not a session recording") != std::string::npos);
+    REQUIRE(colonies.empty());
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Commands round-trip and refused ones change nothing", "[replay]")
+{
+    Command command(CommandType::SET_DIRECTIVE, 2, 5, -3, 0.75f);
+    command.colony = 1;
+    command.sect = 4;
+    command.unit = 2;
+    command.x = 12.5f;
+    command.y = -8.0f;
+
+    ByteWriter out;
+    WriteCommand(out, command);
+    ByteReader in(out.GetBytes().data(), out.GetSize());
+    Command read;
+    REQUIRE(ReadCommand(in, read));
+    REQUIRE(read.type == command.type);
+    REQUIRE(read.colony == 1);
+    REQUIRE(read.sect == 4);
+    REQUIRE(read.unit == 2);
+    REQUIRE(read.a == 2);
+    REQUIRE(read.b == 5);
+    REQUIRE(read.c == -3);
+    REQUIRE(read.value == 0.75f);
+    REQUIRE(read.x == 12.5f);
+    REQUIRE(read.y == -8.0f);
+    REQUIRE(std::string(GetCommandName(CommandType::PROSPECT_SEPARATE)) == "PROSPECT_SEPARATE");
+
+    ResourceManager resources = MakeTestResourceManager();
+    TimeManager time;
+    ManualClock clock;
+    std::vector<Colony*> colonies;
+    REQUIRE(ApplyCommand(Command(CommandType::FOUND_COLONY, 3, 3), resources, time, colonies, &clock));
+    REQUIRE(colonies.size() == 1);
+    REQUIRE(colonies[0]->GetSects().size() == 1);
+
+    ByteWriter scratch;
+    const uint64_t before = HashSimulationState(resources, time, colonies, scratch);
+
+    // Inside the first colony's jurisdiction, bad indices, a road to itself
+    REQUIRE_FALSE(ApplyCommand(Command(CommandType::FOUND_COLONY, 3, 3), resources, time, colonies, &clock));
+    REQUIRE_FALSE(ApplyCommand(Command(CommandType::FOUND_COLONY, -1, 0), resources, time, colonies, &clock));
+    REQUIRE_FALSE(ApplyCommand(ForColony(CommandType::BUILD_ROAD, 0, 0, 0), resources, time, colonies, &clock));
+    REQUIRE_FALSE(ApplyCommand(ForColony(CommandType::SET_ROAD_MODE, 0, 0, 1), resources, time, colonies, &clock));
+    REQUIRE_FALSE(ApplyCommand(ForColony(CommandType::UPGRADE_RESERVES, 5), resources, time, colonies, &clock));
+    REQUIRE_FALSE(ApplyCommand(ForUnit(CommandType::TOGGLE_MODULE, 0, 0, 9), resources, time, colonies, &clock));
+    REQUIRE_FALSE(ApplyCommand(ForUnit(CommandType::TOGGLE_MODULE, 0, 0, 1, 99), resources, time, colonies, &clock));
+    REQUIRE_FALSE(ApplyCommand(ForUnit(CommandType::SET_PRODUCTION_RATE, 0, 0, 1, 0, 999, 1.0f),
+                               resources, time, colonies, &clock));
+    REQUIRE_FALSE(ApplyCommand(ForUnit(CommandType::PROSPECT_ANALYSE, 0, 0, 0, 0), resources, time, colonies, &clock));
+    REQUIRE_FALSE(ApplyCommand(ForUnit(CommandType::PROSPECT_SWEEP, 0, 0, 1), resources, time, colonies, &clock));
+    REQUIRE(colonies.size() == 1);
+    REQUIRE(HashSimulationState(resources, time, colonies, scratch) == before);
+
+    // Addressed by pointer through a sink
+    struct RecordingSink : CommandSink
+    {
+        std::vector<Colony*>& targets;
+        std::vector<Command> submitted;
+        explicit RecordingSink(std::vector<Colony*>& targets) : targets(targets) {}
+        bool Submit(const Command& command) override { submitted.push_back(command); return true; }
+        const std::vector<Colony*>& GetCommandTargets() const override { return targets; }
+    } sink(colonies);
+
+    const Unit* farming = colonies[0]->GetSects()[0]->GetUnits()[1];
+    REQUIRE(sink.SubmitFor(farming, Command(CommandType::TOGGLE_MODULE, 0)));
+    REQUIRE(sink.submitted.back().colony == 0);
+    REQUIRE(sink.submitted.back().sect == 0);
+    REQUIRE(sink.submitted.back().unit == 1);
+    Colony stranger;
+    REQUIRE_FALSE(sink.SubmitFor(&stranger, Command(CommandType::UPGRADE_RESERVES)));
+    REQUIRE(sink.submitted.size() == 1);
+
+    DeleteColonies(colonies);
+}
+
+TEST_CASE("Transport timing follows the stepper clock", "[replay]")
+{
+    ResourceManager resources = MakeTestResourceManager();
+    TimeManager time;
+    SimStepper stepper;
+    std::vector<Colony*> colonies;
+    REQUIRE(ApplyCommand(Command(CommandType::FOUND_COLONY, 5, 5), resources, time, colonies, stepper.GetClock()));
+    REQUIRE(stepper.GetClockTime() == 0.0);
+
+    for (int s = 0; s < 90; s++)
+    {
+        time.Advance(SimScheduler::STEP_SECONDS);
+        stepper.Step(colonies, SimScheduler::STEP_SECONDS);
+    }
+    REQUIRE(stepper.GetClockTime() > 2.99);
+    REQUIRE(stepper.GetClockTime() < 3.01);
+
+    // Switching clocks keeps each road's time since its last dispatch
+    Command sect(CommandType::BUILD_SECT);
+    sect.colony = 0;
+    sect.x = 700.0f;
+    sect.y = 550.0f;
+    REQUIRE(ApplyCommand(sect, resources, time, colonies, stepper.GetClock()));
+    REQUIRE(ApplyCommand(ForColony(CommandType::BUILD_ROAD, 0, 0, 1), resources, time, colonies, stepper.GetClock()));
+    const Road& road = colonies[0]->GetRoads()[0];
+    const double sinceDispatch = stepper.GetClockTime() - road.lastTransportTime;
+
+    ManualClock later(1000.0);
+    colonies[0]->SetClock(&later);
+    REQUIRE(std::abs((later.Now() - road.lastTransportTime) - sinceDispatch) < 1e-3);
+
+    stepper.Release();
+    DeleteColonies(colonies);
+}
@@ -0,0 +1,69 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include "sim_clock.h"
+#include "colony.h"
+#include "sect.h"
+#include "resource_manager.h"
+#include "time_manager.h"
+
+using Catch::Matchers::WithinAbs;
+
+TEST_CASE("ManualClock only moves when told to", "[sim_clock]")
+{
+    ManualClock clock(5.0);
+    REQUIRE_THAT(clock.Now(), WithinAbs(5.0, 1e-9));
+
+    clock.Advance(2.5);
+    REQUIRE_THAT(clock.Now(), WithinAbs(7.5, 1e-9));
+
+    clock.Set(1.0);
+    REQUIRE_THAT(clock.Now(), WithinAbs(1.0, 1e-9));
+}
+
+TEST_CASE("SteadyClock starts near zero and never goes backwards", "[sim_clock]")
+{
+    SteadyClock clock;
+    double first = clock.Now();
+    double second = clock.Now();
+    REQUIRE(first >= 0.0);
+    REQUIRE(first < 1.0);
+    REQUIRE(second >= first);
+}
+
+// Sects, units and colonies are built here with no window open: the
+// simulation must not need a GL context.
+TEST_CASE("Transport rate limiting follows the colony clock", "[sim_clock][transport]")
+{
+    ResourceManager rm(20, 100.0f);
+    TimeManager tm;
+    Vector2 posA = {100.0f, 100.0f};
+    Vector2 posB = {300.0f, 100.0f};
+
+    ManualClock clock;
+    Colony colony;
+    colony.SetClock(&clock);
+
+    Sect* a = new Sect(posA, rm, tm);
+    Sect* b = new Sect(posB, rm, tm);
+    colony.AddSect(a);
+    colony.AddSect(b);
+    colony.BuildRoad(a, b);
+    a->AddResource(ResourceType::Fe, 500.0f);
+
+    REQUIRE_THAT(colony.Now(), WithinAbs(0.0, 1e-9));
+
+    clock.Set(10.0);
+    colony.CreateTransportJob(a, b, ResourceType::Fe, 50.0f);
+    REQUIRE(colony.GetTransportJobs().size() == 1);
+
+    // Inside MIN_TRANSPORT_INTERVAL the road refuses new jobs
+    clock.Advance(MIN_TRANSPORT_INTERVAL * 0.5);
+    colony.CreateTransportJob(a, b, ResourceType::Fe, 50.0f);
+    REQUIRE(colony.GetTransportJobs().size() == 1);
+
+    clock.Advance(MIN_TRANSPORT_INTERVAL);
+    colony.CreateTransportJob(a, b, ResourceType::Fe, 50.0f);
+    REQUIRE(colony.GetTransportJobs().size() == 2);
+
+    REQUIRE_THAT(a->GetResourceStorage(ResourceType::Fe), WithinAbs(400.0f, 1e-3));
+}
@@ -0,0 +1,137 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include "sim_scheduler.h"
+#include "time_manager.h"
+#include "transport_types.h"
+#include "sect.h"
+#include "resource_manager.h"
+#include <vector>
+
+using Catch::Matchers::WithinAbs;
+
+namespace
+{
+    // Binary-exact step and frame sizes, so tick counts don't depend on
+    // float rounding
+    const float STEP = 0.25f;
+
+    struct Run
+    {
+        int ticks = 0;
+        float simulated = 0.0f;
+        std::vector<float> steps;
+    };
+
+    Run Drive(SimScheduler& scheduler, float frameSeconds, int frames)
+    {
+        Run run;
+        for (int i = 0; i < frames; i++)
+        {
+            run.ticks += scheduler.Advance(frameSeconds, [&run](float dt)
+            {
+                run.simulated += dt;
+                run.steps.push_back(dt);
+            });
+        }
+        return run;
+    }
+}
+
+TEST_CASE("SimScheduler steps are independent of frame rate", "[sim_scheduler]")
+{
+    TimeManager fastTime;
+    TimeManager slowTime;
+    SimScheduler fast(fastTime, STEP);
+    SimScheduler slow(slowTime, STEP);
+
+    Run fastRun = Drive(fast, 0.125f, 64);    // 8 s at 8 fps-equivalent slices
+    Run slowRun = Drive(slow, 0.5f, 16);      // 8 s in half-second frames
+
+    REQUIRE(fastRun.ticks == 32);
+    REQUIRE(slowRun.ticks == 32);
+    REQUIRE(fastRun.steps == slowRun.steps);
+    REQUIRE_THAT(fastTime.GetGameTime(), WithinAbs(slowTime.GetGameTime(), 1e-5));
+    REQUIRE(fastTime.GetTicks() == slowTime.GetTicks());
+}
+
+TEST_CASE("SimScheduler honours time scale with more ticks, not longer ones", "[sim_scheduler]")
+{
+    TimeManager time;
+    time.SetTimeScale(4.0f);
+    SimScheduler scheduler(time, STEP);
+
+    Run run = Drive(scheduler, 0.5f, 2);
+
+    REQUIRE(run.ticks == 16);
+    for (float dt : run.steps)
+    {
+        REQUIRE(dt == STEP);
+    }
+    REQUIRE_THAT(time.GetGameTime(), WithinAbs(4.0f, 1e-5));
+}
+
+TEST_CASE("SimScheduler does nothing while paused", "[sim_scheduler]")
+{
+    TimeManager time;
+    SimScheduler scheduler(time, STEP);
+
+    time.Pause();
+    REQUIRE(Drive(scheduler, 1.0f, 4).ticks == 0);
+    REQUIRE(time.GetGameTime() == 0.0f);
+
+    time.Resume();
+    REQUIRE(Drive(scheduler, 1.0f, 1).ticks == 4);
+}
+
+TEST_CASE("SimScheduler caps catch-up per frame and drops the rest", "[sim_scheduler]")
+{
+    TimeManager time;
+    SimScheduler scheduler(time, STEP, 8);
+
+    Run run = Drive(scheduler, 10.0f + STEP * 0.5f, 1);    // a 10 s hitch
+
+    REQUIRE(run.ticks == 8);
+    REQUIRE(scheduler.GetLastFrameTicks() == 8);
+    REQUIRE(scheduler.GetDroppedTicks() == 32);
+    REQUIRE_THAT(scheduler.GetAlpha(), WithinAbs(0.5f, 1e-5));
+
+    // The next ordinary frame is not still paying off the hitch
+    REQUIRE(Drive(scheduler, STEP, 1).ticks == 1);
+}
+
+TEST_CASE("SimScheduler alpha is the fraction of a step not yet simulated", "[sim_scheduler]")
+{
+    TimeManager time;
+    SimScheduler scheduler(time, STEP);
+
+    Drive(scheduler, STEP * 0.5f, 1);
+    REQUIRE(scheduler.GetTickCount() == 0);
+    REQUIRE_THAT(scheduler.GetAlpha(), WithinAbs(0.5f, 1e-5));
+
+    Drive(scheduler, STEP * 0.75f, 1);
+    REQUIRE(scheduler.GetTickCount() == 1);
+    REQUIRE_THAT(scheduler.GetAlpha(), WithinAbs(0.25f, 1e-5));
+
+    scheduler.Reset();
+    REQUIRE(scheduler.GetTickCount() == 0);
+    REQUIRE(scheduler.GetAlpha() == 0.0f);
+}
+
+TEST_CASE("Transport packets interpolate between the last two ticks", "[sim_scheduler][transport]")
+{
+    ResourceManager rm(20, 100.0f);
+    TimeManager tm;
+    Vector2 posA = {0.0f, 0.0f};
+    Vector2 posB = {400.0f, 0.0f};
+    Sect a(posA, rm, tm);
+    Sect b(posB, rm, tm);
+    Road road(&a, &b);
+
+    TransportJob job(&road, &a, &b, ResourceType::Fe, 10.0f);
+    job.status = TransportStatus::IN_TRANSIT;
+    job.Update(road.GetTravelTime() * 0.5f);    // halfway after one tick
+
+    REQUIRE_THAT(job.GetCurrentPosition(0.0f).x, WithinAbs(0.0f, 1e-3));
+    REQUIRE_THAT(job.GetCurrentPosition(0.5f).x, WithinAbs(100.0f, 1e-3));
+    REQUIRE_THAT(job.GetCurrentPosition().x, WithinAbs(200.0f, 1e-3));
+}
@@ -0,0 +1,50 @@
+#include <catch2/catch_test_macros.hpp>
+#include "text_run_cache.h"
+#include <string>
+
+TEST_CASE("Text cache formats a label only when its values change", "[text_cache]")
+{
+    TextRunCache cache;
+    static const char* slot = "Tier: %d";
+    int calls = 0;
+    auto tierText = [&](int tier) {
+        calls++;
+        return "Tier: " + std::to_string(tier);
+    };
+
+    std::string first = cache.Format(slot, 0, {1.0}, [&] { return tierText(1); });
+    std::string again = cache.Format(slot, 0, {1.0}, [&] { return tierText(1); });
+    REQUIRE(first == "Tier: 1");
+    REQUIRE(again == "Tier: 1");
+    REQUIRE(calls == 1);
+
+    SECTION("A changed value reformats")
+    {
+        std::string next = cache.Format(slot, 0, {2.0}, [&] { return tierText(2); });
+        REQUIRE(next == "Tier: 2");
+        REQUIRE(calls == 2);
+    }
+
+    SECTION("Rows of the same label are kept apart")
+    {
+        std::string row = cache.Format(slot, 1, {3.0}, [&] { return tierText(3); });
+        REQUIRE(row == "Tier: 3");
+        REQUIRE(std::string(cache.Format(slot, 0, {1.0}, [&] { return tierText(1); })) == "Tier: 1");
+        REQUIRE(calls == 2);
+    }
+
+    SECTION("Frame stats count formats and skips")
+    {
+        cache.BeginFrame();
+        const TextRunCache::Stats& stats = cache.GetFrameStats();
+        REQUIRE(stats.formats == 1);
+        REQUIRE(stats.formatsSkipped == 1);
+    }
+
+    SECTION("Clear drops stored labels")
+    {
+        cache.Clear();
+        cache.Format(slot, 0, {1.0}, [&] { return tierText(1); });
+        REQUIRE(calls == 2);
+    }
+}
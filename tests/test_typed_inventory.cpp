@@ -0,0 +1,127 @@
+#include <catch2/catch_test_macros.hpp>
+#include "typed_inventory.h"
+#include "colony.h"
+#include "sect.h"
+#include "time_manager.h"
+#include "test_helpers.h"
+#include <tuple>
+#include <vector>
+
+TEST_CASE("Known subtypes intern to stable ids", "[typed_inventory]")
+{
+    SubtypeId steel = InternSubtype("Steel");
+    REQUIRE(InternSubtype("Steel") == steel);
+    REQUIRE(SubtypeName(steel) == "Steel");
+    REQUIRE(InternSubtype("HeavyDrill") == 0);      // first table entry
+
+    SubtypeId found = 0;
+    REQUIRE(FindSubtype("Beam", found));
+    REQUIRE(SubtypeName(found) == "Beam");
+    REQUIRE_FALSE(FindSubtype("NoSuchPart", found));
+}
+
+TEST_CASE("Typed inventory counts by subtype and efficiency", "[typed_inventory]")
+{
+    TypedInventory inventory(5);
+    SubtypeId steel = InternSubtype("Steel");
+    SubtypeId bronze = InternSubtype("Bronze");
+
+    REQUIRE(inventory.Add(TypedResource(ResourceType::ALLOYS, "Steel")));
+    REQUIRE(inventory.Add(ResourceType::ALLOYS, steel));
+    REQUIRE(inventory.Add(ResourceType::ALLOYS, steel, 0.8f));
+    REQUIRE(inventory.Add(ResourceType::ALLOYS, bronze));
+    REQUIRE_FALSE(inventory.Add(ResourceType::Fe, steel));       // not a typed resource
+
+    REQUIRE(inventory.GetCount(ResourceType::ALLOYS) == 4);
+    REQUIRE(inventory.GetCount(ResourceType::ALLOYS, steel) == 3);
+    REQUIRE(inventory.GetCount(ResourceType::MACHINERY) == 0);
+
+    std::vector<std::tuple<SubtypeId, float, int>> buckets;
+    inventory.ForEach(ResourceType::ALLOYS, [&](SubtypeId subtype, float efficiency, int count) {
+        buckets.emplace_back(subtype, efficiency, count);
+    });
+    REQUIRE(buckets.size() == 3);
+    REQUIRE(buckets[0] == std::make_tuple(steel, 1.0f, 2));
+    REQUIRE(buckets[1] == std::make_tuple(steel, 0.8f, 1));
+
+    // Capacity is per type
+    REQUIRE(inventory.Add(ResourceType::ALLOYS, bronze));
+    REQUIRE_FALSE(inventory.Add(ResourceType::ALLOYS, bronze));
+    REQUIRE(inventory.Add(ResourceType::MACHINERY, InternSubtype("Conveyor")));
+
+    REQUIRE(inventory.Remove(ResourceType::ALLOYS, steel));     // newest bucket first
+    REQUIRE(inventory.GetCount(ResourceType::ALLOYS, steel) == 2);
+    REQUIRE_FALSE(inventory.Remove(ResourceType::ALLOYS, InternSubtype("Titanium")));
+
+    TypedResource taken;
+    REQUIRE(inventory.TakeAny(ResourceType::ALLOYS, taken));
+    REQUIRE(taken.baseType == ResourceType::ALLOYS);
+    REQUIRE(taken.subType == "Bronze");
+    REQUIRE(inventory.GetCount(ResourceType::ALLOYS) == 3);
+}
+
+TEST_CASE("Typed inventory moves counts within the destination's capacity", "[typed_inventory]")
+{
+    TypedInventory source(50);
+    TypedInventory dest(10);
+    SubtypeId beam = InternSubtype("Beam");
+    SubtypeId pipe = InternSubtype("Pipe");
+
+    for (int i = 0; i < 20; i++) source.Add(ResourceType::CONSTRUCTION_MATERIALS, beam);
+    for (int i = 0; i < 6; i++) source.Add(ResourceType::CONSTRUCTION_MATERIALS, pipe, 0.9f);
+    dest.Add(ResourceType::CONSTRUCTION_MATERIALS, beam);
+
+    REQUIRE(source.MoveTo(dest, ResourceType::CONSTRUCTION_MATERIALS, 100) == 9);
+    REQUIRE(dest.GetCount(ResourceType::CONSTRUCTION_MATERIALS) == 10);
+    REQUIRE(source.GetCount(ResourceType::CONSTRUCTION_MATERIALS) == 17);
+
+    // Items keep their subtype and efficiency across the move
+    REQUIRE(dest.GetCount(ResourceType::CONSTRUCTION_MATERIALS, pipe) == 6);
+    REQUIRE(dest.GetCount(ResourceType::CONSTRUCTION_MATERIALS, beam) == 4);
+    TypedResource item;
+    dest.Remove(ResourceType::CONSTRUCTION_MATERIALS, beam);
+    dest.Remove(ResourceType::CONSTRUCTION_MATERIALS, beam);
+    dest.Remove(ResourceType::CONSTRUCTION_MATERIALS, beam);
+    dest.Remove(ResourceType::CONSTRUCTION_MATERIALS, beam);
+    REQUIRE(dest.TakeAny(ResourceType::CONSTRUCTION_MATERIALS, item));
+    REQUIRE(item.subType == "Pipe");
+    REQUIRE(item.efficiency == 0.9f);
+
+    REQUIRE(dest.MoveTo(source, ResourceType::CONSTRUCTION_MATERIALS, 2) == 2);
+    REQUIRE(source.GetCount(ResourceType::CONSTRUCTION_MATERIALS, pipe) == 2);
+}
+
+TEST_CASE("Sects trade typed surplus and deficit with their colony in bulk", "[typed_inventory]")
+{
+    ResourceManager rm = MakeTestResourceManager();
+    TimeManager tm;
+    Vector2 position = {900.0f, 900.0f};
+    Colony colony;
+    Sect* sect = new Sect(position, rm, tm);
+    colony.AddSect(sect);
+
+    for (int i = 0; i < 45; i++) {
+        REQUIRE(sect->AddTypedResource(TypedResource(ResourceType::MACHINERY, i % 2 ? "Conveyor" : "Assembler")));
+    }
+    REQUIRE(sect->GetTypedResourceCount(ResourceType::MACHINERY, "Conveyor") == 22);
+    for (int i = 0; i < 5; i++) {
+        REQUIRE(sect->AddTypedResource(TypedResource(ResourceType::MACHINERY, "HeavyDrill")));
+    }
+    REQUIRE_FALSE(sect->AddTypedResource(TypedResource(ResourceType::MACHINERY, "HeavyDrill")));   // 50 is full
+
+    // Everything above half capacity goes up
+    sect->PushSurplusToColony(&colony);
+    REQUIRE(sect->GetTotalTypedResourceCount(ResourceType::MACHINERY) == 25);
+    REQUIRE(colony.GetTotalTypedReserveCount(ResourceType::MACHINERY) == 25);
+    REQUIRE(colony.GetTypedReserveCount(ResourceType::MACHINERY, "HeavyDrill") == 5);
+
+    // Below 10% pulls back up to 30%
+    while (sect->GetTotalTypedResourceCount(ResourceType::MACHINERY) > 4) {
+        REQUIRE((sect->RemoveTypedResource(ResourceType::MACHINERY, "Conveyor") ||
+                 sect->RemoveTypedResource(ResourceType::MACHINERY, "Assembler")));
+    }
+    sect->PullDeficitFromColony(&colony);
+    REQUIRE(sect->GetTotalTypedResourceCount(ResourceType::MACHINERY) == 15);
+    REQUIRE(colony.GetTotalTypedReserveCount(ResourceType::MACHINERY) == 14);
+    REQUIRE_FALSE(sect->HasTypedResource(ResourceType::MACHINERY, "NoSuchPart"));
+}
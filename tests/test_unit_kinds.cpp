@@ -0,0 +1,87 @@
+#include <catch2/catch_test_macros.hpp>
+#include "unit_kinds.h"
+#include "unit.h"
+#include "time_manager.h"
+
+TEST_CASE("Unit type names round-trip", "[unit_kinds]")
+{
+    for (int i = 0; i <= static_cast<int>(UnitType::Commerce); i++)
+    {
+        UnitType type = static_cast<UnitType>(i);
+        UnitType parsed;
+        REQUIRE(UnitTypeFromString(UnitTypeToString(type), parsed));
+        REQUIRE(parsed == type);
+    }
+
+    UnitType parsed;
+    REQUIRE(UnitTypeFromString("Communication", parsed));
+    REQUIRE(parsed == UnitType::Commerce);
+    REQUIRE_FALSE(UnitTypeFromString("Teleporter", parsed));
+}
+
+TEST_CASE("Module kind names round-trip", "[unit_kinds]")
+{
+    for (int i = 0; i <= static_cast<int>(ModuleKind::PUBLICATION); i++)
+    {
+        ModuleKind kind = static_cast<ModuleKind>(i);
+        REQUIRE(ModuleKindFromString(ModuleKindToString(kind)) == kind);
+    }
+    REQUIRE(ModuleKindFromString("NOT_A_MODULE") == ModuleKind::GENERIC);
+}
+
+TEST_CASE("Units resolve their kind and module kinds at construction", "[unit_kinds]")
+{
+    ResourceManager rm(20, 100.0f);
+    TimeManager tm;
+    Vector2 position = {500.0f, 500.0f};
+    ResourceVector storage;
+    ResourceVector capacity;
+
+    Unit extraction("Extraction", position, rm, tm, storage, capacity);
+    REQUIRE(extraction.GetType() == UnitType::Extraction);
+    REQUIRE(extraction.GetUnitType() == "Extraction");
+
+    const auto& modules = extraction.GetModules();
+    REQUIRE(modules.size() >= 5);
+    REQUIRE(modules[0].kind == ModuleKind::PROSPECTING);
+    REQUIRE(modules[1].kind == ModuleKind::EXCAVATION);
+    REQUIRE(modules[2].kind == ModuleKind::BENEFICIATION);
+
+    Unit comms("Communication", position, rm, tm, storage, capacity);
+    REQUIRE(comms.GetType() == UnitType::Commerce);
+    REQUIRE(comms.GetModules()[0].kind == ModuleKind::GENERIC);
+
+    extraction.Stop();
+    REQUIRE(extraction.GetStatus() == UnitStatus::INACTIVE);
+    REQUIRE_FALSE(extraction.IsActive());
+}
+
+TEST_CASE("A debug build turns on a module the game cannot build", "[unit_kinds]")
+{
+    ResourceManager rm(20, 100.0f);
+    TimeManager tm;
+    Vector2 position = {500.0f, 500.0f};
+    ResourceVector storage;
+    ResourceVector capacity;
+    Unit extraction("Extraction", position, rm, tm, storage, capacity);
+
+    const int directives = 4;
+    REQUIRE(extraction.GetModules()[directives].kind == ModuleKind::DIRECTIVES);
+    REQUIRE_FALSE(extraction.GetModules()[directives].isBuilt);
+
+    Unit::ActiveDirective directive;
+    directive.type = Unit::DirectiveType::THERMAL_SYNC;
+    extraction.SetDirective(directive);
+    REQUIRE(extraction.GetDirective().type == Unit::DirectiveType::NONE);
+
+    REQUIRE(extraction.DebugBuildModule(directives));
+    REQUIRE(extraction.GetModules()[directives].isBuilt);
+    REQUIRE(extraction.GetModules()[directives].isActive);
+    while (extraction.DebugUpgradeModuleTier(directives)) {}
+    REQUIRE(extraction.GetModules()[directives].tier == 3);
+
+    extraction.SetDirective(directive);
+    REQUIRE(extraction.GetDirective().type == Unit::DirectiveType::THERMAL_SYNC);
+
+    REQUIRE_FALSE(extraction.DebugBuildModule(99));
+}
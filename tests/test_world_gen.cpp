@@ -0,0 +1,138 @@
+#include <catch2/catch_test_macros.hpp>
+#include "world_gen.h"
+#include "session_recording.h"
+#include "game_snapshot.h"
+#include "sim_stepper.h"
+#include "sim_scheduler.h"
+#include "byte_stream.h"
+#include "colony.h"
+#include "sect.h"
+#include "unit.h"
+#include "time_manager.h"
+#include "test_helpers.h"
+#include <cstdio>
+#include <string>
+#include <vector>
+
+TEST_CASE("World specs parse, format back and reject bad pairs", "[world_gen]")
+{
+    WorldSpec spec;
+    std::string error;
+    REQUIRE(ParseWorldSpec("large,seed=7,sects=3-9,modes=1:2:3,packets=5", spec, &error));
+    REQUIRE(spec.colonies == 20);
+    REQUIRE(spec.seed == 7);
+    REQUIRE(spec.minSects == 3);
+    REQUIRE(spec.maxSects == 9);
+    REQUIRE(spec.modeWeights[2] == 3.0f);
+    REQUIRE(spec.packets == 5);
+
+    WorldSpec reparsed;
+    REQUIRE(ParseWorldSpec(FormatWorldSpec(spec), reparsed, &error));
+    REQUIRE(FormatWorldSpec(reparsed) == FormatWorldSpec(spec));
+    REQUIRE(reparsed.extraRoads == spec.extraRoads);
+    REQUIRE(FormatWorldSpec(WorldSpec()).find(",active=0.6,") != std::string::npos);
+
+    REQUIRE(ParseWorldSpec("", spec, &error));
+    REQUIRE(spec.colonies == WorldSpec().colonies);
+    REQUIRE(WorldGridSize(spec) >= PLANET_SIZE);
+
+    REQUIRE_FALSE(ParseWorldSpec("enormous", spec, &error));
+    REQUIRE(error.find("enormous") != std::string::npos);
+    REQUIRE_FALSE(ParseWorldSpec("colonies=4,small", spec, &error));
+    REQUIRE_FALSE(ParseWorldSpec("sects=9-3", spec, &error));
+    REQUIRE_FALSE(ParseWorldSpec("modes=0:0:0", spec, &error));
+    REQUIRE_FALSE(ParseWorldSpec("tier=4", spec, &error));
+    REQUIRE_FALSE(ParseWorldSpec("seed=0", spec, &error));
+    REQUIRE_FALSE(ParseWorldSpec("active=1.5", spec, &error));
+    REQUIRE_FALSE(ParseWorldSpec("colour=blue", spec, &error));
+}
+
+TEST_CASE("A world spec builds what it asks for", "[world_gen]")
+{
+    GeneratedWorld world(BUSY_WORLD);
+    const WorldStats& stats = world.stats;
+
+    REQUIRE(world.colonies.size() == 3);
+    REQUIRE(stats.colonies == 3);
+    int sects = 0;
+    int roads = 0;
+    int packets = 0;
+    int chainNodes = 0;
+    for (const Colony* colony : world.colonies)
+    {
+        int count = static_cast<int>(colony->GetSects().size());
+        REQUIRE(count >= 3);
+        REQUIRE(count <= 6);
+        REQUIRE(static_cast<int>(colony->GetRoads().size()) >= count - 1);
+        sects += count;
+        roads += static_cast<int>(colony->GetRoads().size());
+        packets += static_cast<int>(colony->GetTransportJobs().size());
+        for (const Sect* sect : colony->GetSects())
+        {
+            for (const Unit* unit : sect->GetUnits())
+            {
+                chainNodes += static_cast<int>(unit->GetSeparationChain().size());
+                for (const Unit::UnitModule& module : unit->GetModules())
+                {
+                    REQUIRE(module.isBuilt);        // build=1
+                }
+            }
+        }
+    }
+    REQUIRE(stats.sects == sects);
+    REQUIRE(stats.roads == roads);
+    REQUIRE(stats.packets == 40);
+    REQUIRE(packets == 40);
+    REQUIRE(stats.roadsByMode[0] + stats.roadsByMode[1] + stats.roadsByMode[2] == roads);
+    REQUIRE(stats.roadsByMode[0] > 0);
+    REQUIRE(stats.roadsByMode[1] > 0);
+    REQUIRE(stats.roadsByMode[2] > 0);
+
+    // Every extraction unit got a chain and went prospecting
+    REQUIRE(stats.prospectingUnits == sects);
+    REQUIRE(stats.separationNodes >= sects);
+    REQUIRE(chainNodes >= stats.separationNodes);
+    REQUIRE(stats.samples > 0);
+    REQUIRE(stats.moduleTiers > 0);
+    REQUIRE(stats.activeUnits > 0);
+    REQUIRE(stats.activeUnits < stats.units);
+
+    // It runs like any world
+    world.Run(60);
+}
+
+TEST_CASE("The same spec always builds the same world", "[world_gen]")
+{
+    GeneratedWorld first(BUSY_WORLD);
+    GeneratedWorld second(BUSY_WORLD);
+    REQUIRE(first.Hash() == second.Hash());
+
+    first.Run(45);
+    second.Run(45);
+    REQUIRE(first.Hash() == second.Hash());
+
+    GeneratedWorld reseeded(std::string(BUSY_WORLD) + ",seed=12");
+    REQUIRE(reseeded.Hash() != second.Hash());
+}
+
+TEST_CASE("A generated world saves and loads back identical", "[world_gen]")
+{
+    GeneratedWorld world(BUSY_WORLD);
+    world.Run(30);
+    const std::string path = TempSavePath("colony_test_world_gen.colony");
+
+    std::string error;
+    REQUIRE(SaveGame::Save(path, world.resources, world.time, world.colonies, true, &error));
+
+    ResourceManager resources(0, 1.0f);
+    TimeManager time;
+    SimStepper stepper;
+    std::vector<Colony*> loaded;
+    REQUIRE(SaveGame::Load(path, resources, time, loaded, &error, stepper.GetClock()));
+    std::remove(path.c_str());
+
+    ByteWriter scratch;
+    REQUIRE(HashSimulationState(resources, time, loaded, scratch) == world.Hash());
+
+    for (Colony* colony : loaded) delete colony;
+}
@@ -0,0 +1,196 @@
+#include <catch2/catch_test_macros.hpp>
+#include "world_mirror.h"
+#include "world_pages.h"
+#include "spsc_queue.h"
+#include "triple_buffer.h"
+#include "colony.h"
+#include "sect.h"
+#include "time_manager.h"
+#include "sim_clock.h"
+#include "test_helpers.h"
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Everything Sync is meant to carry over, as bytes
+std::vector<std::vector<uint8_t>> ReadWorld(const TimeManager& time, const std::vector<Colony*>& colonies)
+{
+    std::vector<std::vector<uint8_t>> state;
+    ByteWriter clock;
+    time.SaveState(clock);
+    state.push_back(clock.GetBytes());
+    for (const Colony* colony : colonies)
+    {
+        ByteWriter own;
+        colony->SaveOwnState(own);
+        state.push_back(own.GetBytes());
+        for (const Sect* sect : colony->GetSects())
+        {
+            ByteWriter out;
+            sect->SaveState(out);
+            state.push_back(out.GetBytes());
+        }
+    }
+    return state;
+}
+
+} // namespace
+
+TEST_CASE("The SPSC queue hands items over in order and refuses when full", "[sim_thread]")
+{
+    SpscQueue<int, 4> small;
+    for (int i = 0; i < 4; i++)
+    {
+        REQUIRE(small.Push(i));
+    }
+    int item = 99;
+    REQUIRE_FALSE(small.Push(item));
+    REQUIRE(item == 99);
+    REQUIRE(small.Pop(item));
+    REQUIRE(item == 0);
+    REQUIRE(small.Push(item));
+
+    SpscQueue<int, 64> queue;
+    const int count = 20000;
+    std::thread producer([&] {
+        for (int i = 0; i < count; i++)
+        {
+            int value = i;
+            while (!queue.Push(value)) std::this_thread::yield();
+        }
+    });
+    int expected = 0;
+    bool inOrder = true;
+    while (expected < count)
+    {
+        int value;
+        if (!queue.Pop(value))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        inOrder = inOrder && value == expected;
+        expected++;
+    }
+    producer.join();
+    REQUIRE(inOrder);
+    REQUIRE(queue.IsEmpty());
+}
+
+TEST_CASE("The triple buffer gives the reader the newest whole value", "[sim_thread]")
+{
+    TripleBuffer<int> latest;
+    REQUIRE_FALSE(latest.Update());
+    latest.GetBack() = 1;
+    latest.Publish();
+    latest.GetBack() = 2;
+    latest.Publish();
+    REQUIRE(latest.Update());
+    REQUIRE(latest.GetFront() == 2);
+    REQUIRE_FALSE(latest.Update());
+
+    // A writer that never waits; the reader never sees a torn or older value
+    struct Pair { int a = 0; int b = 0; };
+    TripleBuffer<Pair> pairs;
+    const int count = 20000;
+    std::thread writer([&] {
+        for (int i = 1; i <= count; i++)
+        {
+            pairs.GetBack().a = i;
+            pairs.GetBack().b = i * 2;
+            pairs.Publish();
+        }
+    });
+    int last = 0;
+    bool whole = true;
+    bool newer = true;
+    while (last < count)
+    {
+        if (!pairs.Update()) continue;
+        const Pair& pair = pairs.GetFront();
+        whole = whole && pair.b == pair.a * 2;
+        newer = newer && pair.a > last;
+        last = pair.a;
+    }
+    writer.join();
+    REQUIRE(whole);
+    REQUIRE(newer);
+}
+
+TEST_CASE("A world mirror follows the game in place, loading what changed", "[sim_thread]")
+{
+    ResourceManager resources = MakeTestResourceManager();
+    TimeManager time;
+    ManualClock clock;
+    std::vector<Colony*> colonies = {MakeColony(resources, time, clock, 250.0f, 3),
+                                     MakeColony(resources, time, clock, 1250.0f, 2)};
+    StepWorld(colonies, time, clock, 2);
+
+    ResourceManager copyResources = resources;
+    TimeManager copyTime;
+    ManualClock copyClock(clock.Now());
+    std::vector<Colony*> copy;
+    WorldMirror mirror;
+    WorldMirror::SyncStats stats;
+
+    std::shared_ptr<const WorldPages> pages =
+        std::make_shared<const WorldPages>(WorldPages::Capture(resources, time, colonies));
+    REQUIRE(mirror.Sync(*pages, copyResources, copyTime, copy, &copyClock, &stats));
+    REQUIRE(stats.coloniesBuilt == 2);
+    REQUIRE(ReadWorld(copyTime, copy) == ReadWorld(time, colonies));
+    const std::vector<Colony*> built = copy;
+    Sect* selected = copy[0]->GetSects()[1];
+
+    // The game moves on: the copy reloads just the new pages, into the
+    // objects it already has
+    StepWorld(colonies, time, clock, 3);
+    colonies[1]->GetSects()[0]->AddResource(ResourceType::Si, 5.0f);
+    pages = std::make_shared<const WorldPages>(WorldPages::Capture(resources, time, colonies, pages.get()));
+    copyClock.Set(clock.Now());
+    REQUIRE(mirror.Sync(*pages, copyResources, copyTime, copy, &copyClock, &stats));
+    REQUIRE(stats.pagesLoaded == pages->newPages);
+    REQUIRE(stats.coloniesBuilt == 0);
+    REQUIRE_FALSE(stats.objectsRemoved);
+    REQUIRE(copy == built);
+    REQUIRE(copy[0]->GetSects()[1] == selected);
+    REQUIRE(ReadWorld(copyTime, copy) == ReadWorld(time, colonies));
+
+    // Nothing new: nothing loaded. A change made to the copy alone is put back.
+    REQUIRE(mirror.Sync(*pages, copyResources, copyTime, copy, &copyClock, &stats));
+    REQUIRE(stats.pagesLoaded == 0);
+    copy[1]->GetSects()[1]->AddResource(ResourceType::Fe, 3.0f);
+    REQUIRE(mirror.Sync(*pages, copyResources, copyTime, copy, &copyClock, &stats));
+    REQUIRE(stats.pagesLoaded == 1);
+    REQUIRE(ReadWorld(copyTime, copy) == ReadWorld(time, colonies));
+
+    // New sects and roads are followed in place
+    Vector2 newSect = {550.0f, 450.0f};
+    colonies[0]->AddSect(new Sect(newSect, resources, time));
+    colonies[0]->BuildRoad(colonies[0]->GetSects()[0], colonies[0]->GetSects()[3]);
+    pages = std::make_shared<const WorldPages>(WorldPages::Capture(resources, time, colonies, pages.get()));
+    REQUIRE(mirror.Sync(*pages, copyResources, copyTime, copy, &copyClock, &stats));
+    REQUIRE(stats.coloniesBuilt == 0);
+    REQUIRE(copy[0]->GetSects().size() == 4);
+    REQUIRE(copy[0]->GetRoads().size() == colonies[0]->GetRoads().size());
+    REQUIRE(ReadWorld(copyTime, copy) == ReadWorld(time, colonies));
+
+    // What the copy has and the game does not (a predicted command the
+    // game refused) goes: a whole colony, or a sect, which takes a rebuild
+    copy.push_back(MakeColony(copyResources, copyTime, copyClock, 1800.0f, 1));
+    Vector2 refusedSect = {700.0f, 450.0f};
+    copy[1]->AddSect(new Sect(refusedSect, copyResources, copyTime));
+    REQUIRE(mirror.Sync(*pages, copyResources, copyTime, copy, &copyClock, &stats));
+    REQUIRE(stats.objectsRemoved);
+    REQUIRE(stats.coloniesBuilt == 1);
+    REQUIRE(copy.size() == 2);
+    REQUIRE(copy[0] == built[0]);
+    REQUIRE(ReadWorld(copyTime, copy) == ReadWorld(time, colonies));
+
+    ResourceManager otherPlanet(8, 100.0f);
+    REQUIRE_FALSE(mirror.Sync(*pages, otherPlanet, copyTime, copy, &copyClock));
+
+    for (Colony* colony : copy) delete colony;
+    for (Colony* colony : colonies) delete colony;
+}
@@ -0,0 +1,184 @@
+// Balance batch runner.
+//
+// Plays every run of a balance sweep (see src/Balance/balance_runner.h):
+// seeded headless games over a grid of balance parameters, each driven by
+// the scripted policy, spread over every core with the job system. Writes
+// one CSV row of KPIs per run, optionally the daily resource curves, and
+// prints the throughput as key=value lines. Headless: links colony_sim only.
+//
+// Usage (from the repo root):
+//   cmake --build build --target colony_balance
+//   build/src/colony_balance --sweep sweep.txt --out runs.csv
+//   build/src/colony_balance --set "AUTO_BALANCE_THRESHOLD=0.1:0.5:0.1;seeds=100;days=10"
+//
+// Exit status: 0 on success, 1 on a bad sweep or an unwritable output.
+
+#include "balance_runner.h"
+#include "job_system.h"
+#include "sim_log.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+struct BalanceOptions
+{
+    std::string sweepText;          // sweep file contents, then --set lines
+    std::string outPath = "balance_runs.csv";
+    std::string curvesPath;         // daily totals, when given
+    int threads = JobSystem::DefaultWorkerCount() + 1;
+};
+
+static void PrintUsage()
+{
+    std::cout
+        << "Usage: colony_balance [options]\n"
+        << "\n"
+        << "  --sweep <path>     read the sweep definition from a file\n"
+        << "  --set <LINES>      sweep lines, ';' separated, after the file's\n"
+        << "  --out <path>       per-run KPIs (default: balance_runs.csv)\n"
+        << "  --curves <path>    also write daily resource totals per run\n"
+        << "  --threads <N>      games at once (default: every core)\n"
+        << "  --params           list the balance parameters and defaults\n"
+        << "  --help             show this message\n";
+}
+
+static bool ReadFile(const std::string& path, std::string& text)
+{
+    std::ifstream in(path);
+    if (!in) return false;
+    std::stringstream contents;
+    contents << in.rdbuf();
+    text = contents.str();
+    return true;
+}
+
+static bool ParseArgs(int argc, char** argv, BalanceOptions& options)
+{
+    std::string setLines;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        bool hasNext = i + 1 < argc;
+
+        if (arg == "--help" || arg == "-h")
+        {
+            PrintUsage();
+            return false;
+        }
+        else if (arg == "--params")
+        {
+            const BalanceParams defaults;
+            for (const std::string& name : BalanceParams::Names())
+            {
+                std::cout << name << " = " << *defaults.Find(name) << "\n";
+            }
+            return false;
+        }
+        else if (arg == "--sweep" && hasNext)
+        {
+            std::string path = argv[++i];
+            if (!ReadFile(path, options.sweepText))
+            {
+                std::cerr << "Cannot read " << path << "\n";
+                return false;
+            }
+        }
+        else if (arg == "--set" && hasNext)
+        {
+            setLines += std::string(argv[++i]) + "\n";
+        }
+        else if (arg == "--out" && hasNext)
+        {
+            options.outPath = argv[++i];
+        }
+        else if (arg == "--curves" && hasNext)
+        {
+            options.curvesPath = argv[++i];
+        }
+        else if (arg == "--threads" && hasNext)
+        {
+            options.threads = std::max(1, std::atoi(argv[++i]));
+        }
+        else
+        {
+            std::cerr << "Unknown or incomplete option: " << arg << "\n";
+            PrintUsage();
+            return false;
+        }
+    }
+    options.sweepText += "\n" + setLines;
+    return true;
+}
+
+static bool WriteColumns(const std::string& path, const BalanceSweep& sweep,
+                         const std::vector<BalanceKpis>& results, bool curves)
+{
+    std::ofstream out(path);
+    if (!out)
+    {
+        std::cerr << "Cannot write " << path << "\n";
+        return false;
+    }
+    if (curves) WriteBalanceCurves(out, results);
+    else WriteBalanceRuns(out, sweep, results);
+    return static_cast<bool>(out);
+}
+
+int main(int argc, char** argv)
+{
+    BalanceOptions options;
+    if (!ParseArgs(argc, argv, options)) return 1;
+
+    BalanceSweep sweep;
+    std::string error;
+    if (!ParseBalanceSweep(options.sweepText, sweep, &error))
+    {
+        std::cerr << error << "\n";
+        return 1;
+    }
+    const int runs = CountBalanceRuns(sweep);
+    if (runs == 0)
+    {
+        std::cerr << "Sweep has too many runs\n";
+        return 1;
+    }
+
+    Log::SetLevel(LogLevel::Warn);
+
+    // One game per task; results land by run index, so the output does not
+    // depend on which thread played what
+    std::vector<BalanceKpis> results(runs);
+    JobSystem pool(options.threads - 1);
+    auto start = std::chrono::steady_clock::now();
+    pool.ParallelFor(runs, [&](int index) {
+        results[index] = RunBalanceGame(sweep, MakeBalanceRun(sweep, index));
+    });
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (!WriteColumns(options.outPath, sweep, results, false)) return 1;
+    if (!options.curvesPath.empty() && !WriteColumns(options.curvesPath, sweep, results, true)) return 1;
+
+    int upgraded = 0;
+    long long starvationEvents = 0;
+    for (const BalanceKpis& kpis : results)
+    {
+        if (kpis.upgrades > 0) upgraded++;
+        starvationEvents += kpis.starvationEvents;
+    }
+
+    std::printf("runs=%d combinations=%d seeds=%d days=%d threads=%d\n",
+                runs, runs / sweep.seeds, sweep.seeds, sweep.days, pool.GetWorkerCount() + 1);
+    std::printf("seconds=%.3f games_per_minute=%.1f game_days_per_second=%.1f\n",
+                seconds, runs * 60.0 / seconds, static_cast<double>(runs) * sweep.days / seconds);
+    std::printf("runs_upgraded=%d starvation_events=%lld out=%s\n",
+                upgraded, starvationEvents, options.outPath.c_str());
+    Log::Flush();
+    return 0;
+}
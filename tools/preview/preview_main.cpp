@@ -10,6 +10,9 @@
 //   tools/preview/preview.sh --view orbital
 //   tools/preview/preview.sh --view planet --out build/preview/planet.png
 //   tools/preview/preview.sh --all
+//   tools/preview/preview.sh --packets 20000 --frames 240
+//   tools/preview/preview.sh --bench --view colony --sects 16 --packets 2000
+//   tools/preview/preview.sh --bench --view planet --world large,seed=7
 
 #include "raylib.h"
 
@@ -22,8 +25,15 @@
 #include "game_constants.h"
 #include "resource_manager.h"
 #include "terrain_synthesis.h"
+#include "packet_renderer.h"
+#include "resource_types.h"
+#include "world_gen.h"
 
+#include <algorithm>
+#include <cmath>
+#include <fstream>
 #include <iostream>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -39,6 +49,14 @@ struct PreviewOptions
     int cellX = 10;    // planet grid cell for --view sect
     int cellY = 10;
     std::string tune;  // named terrain tuning preset (sect view)
+    int packets = 0;   // > 0: transport packet stress run instead of a view
+    int frames = 120;  // frames timed by the stress run / bench
+    bool bench = false;     // frame-time benchmark over a synthetic world
+    int colonies = 4;       // bench world size
+    int sects = 8;          // per colony
+    int roads = 12;         // per colony
+    std::string world;      // bench world spec (world_gen.h) instead of the three above
+    std::string jsonPath;   // bench report; stdout when empty
 };
 
 static void PrintUsage()
@@ -46,10 +64,22 @@ static void PrintUsage()
     std::cout
         << "Usage: colony_preview [options]\n"
         << "\n"
-        << "  --view <name>   orbital | planet | sect (default: orbital)\n"
+        << "  --view <name>   orbital | planet | colony | sect (default: orbital)\n"
         << "  --cell <X,Y>    planet grid cell for sect view (default: 10,10)\n"
         << "  --tune <name>   terrain preset: baseline|silky|rough|rolling|\n"
         << "                  boulders|dramatic   (sect view)\n"
+        << "  --packets <N>   stress run: animate N transport packets and\n"
+        << "                  report frame time (replaces --view)\n"
+        << "  --frames <K>    frames timed by --packets / --bench (default: 120)\n"
+        << "  --bench         time --view over a synthetic world and report\n"
+        << "                  p50/p95/p99 frame time and draw calls as JSON\n"
+        << "  --colonies <N>  bench world: colonies      (default: 4)\n"
+        << "  --sects <N>     bench world: sects/colony  (default: 8)\n"
+        << "  --roads <N>     bench world: roads/colony  (default: 12)\n"
+        << "                  (--packets N puts N packets on the bench roads)\n"
+        << "  --world <spec>  bench world from the world generator instead,\n"
+        << "                  e.g. large,seed=7 (see src/WorldGen/world_gen.h)\n"
+        << "  --json <path>   write the bench report here instead of stdout\n"
         << "  --size <WxH>    output resolution       (default: 1280x720)\n"
         << "  --out <path>    output PNG path         (default: preview.png)\n"
         << "  --help          show this message\n";
@@ -79,6 +109,45 @@ static bool ParseArgs(int argc, char** argv, PreviewOptions& options)
         {
             options.tune = argv[++i];
         }
+        else if (arg == "--packets" && hasNext)
+        {
+            options.packets = TextToInteger(argv[++i]);
+        }
+        else if (arg == "--frames" && hasNext)
+        {
+            options.frames = std::max(1, TextToInteger(argv[++i]));
+        }
+        else if (arg == "--bench")
+        {
+            options.bench = true;
+        }
+        else if (arg == "--colonies" && hasNext)
+        {
+            options.colonies = std::max(1, TextToInteger(argv[++i]));
+        }
+        else if (arg == "--sects" && hasNext)
+        {
+            options.sects = std::max(1, TextToInteger(argv[++i]));
+        }
+        else if (arg == "--roads" && hasNext)
+        {
+            options.roads = std::max(0, TextToInteger(argv[++i]));
+        }
+        else if (arg == "--world" && hasNext)
+        {
+            options.world = argv[++i];
+            WorldSpec spec;
+            std::string error;
+            if (!ParseWorldSpec(options.world, spec, &error))
+            {
+                std::cout << error << "\n";
+                return false;
+            }
+        }
+        else if (arg == "--json" && hasNext)
+        {
+            options.jsonPath = argv[++i];
+        }
         else if (arg == "--cell" && hasNext)
         {
             std::string value = argv[++i];
@@ -109,6 +178,370 @@ static bool ParseArgs(int argc, char** argv, PreviewOptions& options)
     return true;
 }
 
+// Synthetic packet travelling back and forth between two world points.
+struct StressPacket
+{
+    Vector2 from;
+    Vector2 to;
+    Color color;
+    float progress;
+    float speed;  // progress per second
+};
+
+// Animates options.packets packets across the planet through the batched
+// PacketRenderer and reports per-frame times. The last frame is left in
+// the backbuffer for the usual PNG export.
+static void RunPacketStress(const PreviewOptions& options)
+{
+    SetRandomSeed(PREVIEW_MAP_SEED);
+    const auto& descriptors = GetResourceDescriptors();
+
+    std::vector<StressPacket> packets(options.packets);
+    for (auto& p : packets)
+    {
+        p.from = {(float)GetRandomValue(0, (int)PLANET_WIDTH),
+                  (float)GetRandomValue(0, (int)PLANET_HEIGHT)};
+        p.to = {(float)GetRandomValue(0, (int)PLANET_WIDTH),
+                (float)GetRandomValue(0, (int)PLANET_HEIGHT)};
+        p.color = descriptors[GetRandomValue(0, (int)descriptors.size() - 1)].color;
+        p.progress = GetRandomValue(0, 1000) / 1000.0f;
+        p.speed = 0.05f + GetRandomValue(0, 100) / 1000.0f;
+    }
+
+    Camera2D camera = {0};
+    camera.target = {PLANET_WIDTH / 2.0f, PLANET_HEIGHT / 2.0f};
+    camera.offset = {options.width / 2.0f, options.height / 2.0f};
+    camera.zoom = std::min(options.width / PLANET_WIDTH,
+                           options.height / PLANET_HEIGHT);
+
+    PacketRenderer packetRenderer;
+    std::vector<double> frameMs;
+    frameMs.reserve(options.frames);
+    const float dt = 1.0f / 60.0f;
+
+    for (int frame = 0; frame < options.frames; frame++)
+    {
+        double start = GetTime();
+
+        packetRenderer.Clear();
+        for (auto& p : packets)
+        {
+            p.progress += p.speed * dt;
+            if (p.progress >= 1.0f) p.progress -= 1.0f;
+            Vector2 pos = {p.from.x + (p.to.x - p.from.x) * p.progress,
+                           p.from.y + (p.to.y - p.from.y) * p.progress};
+            packetRenderer.Add(pos, p.color, p.progress);
+        }
+
+        BeginDrawing();
+        ClearBackground(BLACK);
+        BeginMode2D(camera);
+        packetRenderer.Submit();
+        EndMode2D();
+        EndDrawing();
+
+        frameMs.push_back((GetTime() - start) * 1000.0);
+    }
+
+    // First frame includes the atlas upload; report it separately.
+    double first = frameMs.front();
+    std::vector<double> steady(frameMs.begin() + (frameMs.size() > 1 ? 1 : 0), frameMs.end());
+    double total = 0.0;
+    for (double ms : steady) total += ms;
+    std::sort(steady.begin(), steady.end());
+
+    std::cout << "Packet stress: " << options.packets << " packets, "
+              << options.frames << " frames\n"
+              << "  first frame " << first << " ms\n"
+              << "  avg " << total / steady.size() << " ms"
+              << "  min " << steady.front() << " ms"
+              << "  median " << steady[steady.size() / 2] << " ms"
+              << "  max " << steady.back() << " ms\n";
+}
+
+// ---------------------------------------------------------------------------
+// Frame-time benchmark (--bench)
+// ---------------------------------------------------------------------------
+
+// Draw-call counting. raylib's desktop GL backend calls GL through glad's
+// function pointers, so swapping glDrawElements/glDrawArrays for counting
+// wrappers sees every draw rlgl issues. The symbols are weak: against a
+// raylib without glad the tool still links and reports no draw calls.
+#if defined(__GNUC__) && !defined(_WIN32)
+extern "C" {
+typedef void (*BenchDrawElementsProc)(unsigned int mode, int count, unsigned int type, const void* indices);
+typedef void (*BenchDrawArraysProc)(unsigned int mode, int first, int count);
+extern BenchDrawElementsProc glad_glDrawElements __attribute__((weak));
+extern BenchDrawArraysProc glad_glDrawArrays __attribute__((weak));
+}
+#define PREVIEW_COUNT_DRAW_CALLS
+#endif
+
+static long g_drawCalls = 0;
+
+#ifdef PREVIEW_COUNT_DRAW_CALLS
+static BenchDrawElementsProc g_realDrawElements = nullptr;
+static BenchDrawArraysProc g_realDrawArrays = nullptr;
+
+static void CountingDrawElements(unsigned int mode, int count, unsigned int type, const void* indices)
+{
+    g_drawCalls++;
+    g_realDrawElements(mode, count, type, indices);
+}
+
+static void CountingDrawArrays(unsigned int mode, int first, int count)
+{
+    g_drawCalls++;
+    g_realDrawArrays(mode, first, count);
+}
+#endif
+
+// Returns false when this build can't count draw calls.
+static bool InstallDrawCallCounter()
+{
+#ifdef PREVIEW_COUNT_DRAW_CALLS
+    if (&glad_glDrawElements == nullptr || &glad_glDrawArrays == nullptr) return false;
+    if (glad_glDrawElements == nullptr || glad_glDrawArrays == nullptr) return false;
+    g_realDrawElements = glad_glDrawElements;
+    g_realDrawArrays = glad_glDrawArrays;
+    glad_glDrawElements = CountingDrawElements;
+    glad_glDrawArrays = CountingDrawArrays;
+    return true;
+#else
+    return false;
+#endif
+}
+
+static void RemoveDrawCallCounter()
+{
+#ifdef PREVIEW_COUNT_DRAW_CALLS
+    if (g_realDrawElements) glad_glDrawElements = g_realDrawElements;
+    if (g_realDrawArrays) glad_glDrawArrays = g_realDrawArrays;
+    g_realDrawElements = nullptr;
+    g_realDrawArrays = nullptr;
+#endif
+}
+
+// Nearest-rank percentile of an ascending sample.
+static double Percentile(const std::vector<double>& sorted, double p)
+{
+    if (sorted.empty()) return 0.0;
+    size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * sorted.size()));
+    rank = std::min(sorted.size(), std::max<size_t>(rank, 1));
+    return sorted[rank - 1];
+}
+
+static std::string SummaryJson(std::vector<double> sample)
+{
+    std::sort(sample.begin(), sample.end());
+    double total = 0.0;
+    for (double v : sample) total += v;
+
+    std::ostringstream out;
+    out << "{\"mean\": " << (sample.empty() ? 0.0 : total / sample.size())
+        << ", \"min\": " << (sample.empty() ? 0.0 : sample.front())
+        << ", \"p50\": " << Percentile(sample, 50.0)
+        << ", \"p95\": " << Percentile(sample, 95.0)
+        << ", \"p99\": " << Percentile(sample, 99.0)
+        << ", \"max\": " << (sample.empty() ? 0.0 : sample.back()) << "}";
+    return out.str();
+}
+
+// Synthetic world for --bench: colonies on a grid over the planet, sects
+// spiralling out from each colony centre, roads chaining the sects and
+// then joining random pairs, and packets spread round-robin over every
+// road. Seeded, so the same options always build the same world.
+static void BuildBenchWorld(const PreviewOptions& options, ResourceManager& resourceManager,
+                            TimeManager& timeManager, std::vector<Colony*>& colonies)
+{
+    SetRandomSeed(PREVIEW_MAP_SEED);
+    const auto& descriptors = GetResourceDescriptors();
+    const float cellSize = SECT_CORE_RADIUS * 2.0f;
+
+    int perRow = static_cast<int>(std::ceil(std::sqrt(static_cast<float>(options.colonies))));
+    float spacing = PLANET_WIDTH / perRow;
+
+    for (int c = 0; c < options.colonies; c++)
+    {
+        Colony* colony = new Colony();
+        Vector2 centre = {(c % perRow + 0.5f) * spacing, (c / perRow + 0.5f) * spacing};
+
+        for (int s = 0; s < options.sects; s++)
+        {
+            // Golden-angle spiral, roughly one cell between neighbours
+            float angle = s * 2.39996f;
+            float radius = cellSize * std::sqrt(static_cast<float>(s));
+            Vector2 pos = {std::min(PLANET_WIDTH, std::max(0.0f, centre.x + radius * cosf(angle))),
+                           std::min(PLANET_HEIGHT, std::max(0.0f, centre.y + radius * sinf(angle)))};
+            colony->AddSect(new Sect(pos, resourceManager, timeManager));
+        }
+
+        const auto& sects = colony->GetSects();
+        int count = static_cast<int>(sects.size());
+        int built = 0;
+        for (int s = 1; s < count && built < options.roads; s++, built++)
+        {
+            colony->BuildRoad(sects[s - 1], sects[s]);
+        }
+        for (int attempt = 0; built < options.roads && attempt < options.roads * 8; attempt++)
+        {
+            int a = GetRandomValue(0, count - 1);
+            int b = GetRandomValue(0, count - 1);
+            if (a == b || colony->GetRoad(sects[a], sects[b])) continue;
+            colony->BuildRoad(sects[a], sects[b]);
+            built++;
+        }
+
+        colonies.push_back(colony);
+    }
+
+    // Road pointers are stable once every road is built
+    std::vector<std::pair<Colony*, Road*>> roads;
+    for (Colony* colony : colonies)
+    {
+        for (const Road& road : colony->GetRoads())
+        {
+            roads.push_back({colony, colony->GetRoad(road.sectA, road.sectB)});
+        }
+    }
+    for (int i = 0; !roads.empty() && i < options.packets; i++)
+    {
+        auto& target = roads[i % roads.size()];
+        ResourceType type = descriptors[GetRandomValue(0, (int)descriptors.size() - 1)].type;
+        target.first->AddSyntheticTransportJob(target.second, type, TRANSPORT_PACKET_SIZE,
+                                               GetRandomValue(0, 1000) / 1000.0f);
+    }
+}
+
+// Renders options.frames frames of options.view over the synthetic world
+// through the real RenderManager and reports frame time and draw-call
+// percentiles as JSON. The last frame is left in the backbuffer for the
+// usual PNG export.
+static bool RunBench(const PreviewOptions& options, RenderManager& renderManager,
+                     Planet& planet, TimeManager& timeManager, InputManager& inputManager,
+                     ResourceManager& resourceManager)
+{
+    std::vector<Colony*> colonies;
+    double setupStart = GetTime();
+    if (options.world.empty())
+    {
+        BuildBenchWorld(options, resourceManager, timeManager, colonies);
+    }
+    else
+    {
+        WorldSpec spec;
+        ParseWorldSpec(options.world, spec, nullptr);
+        GenerateWorld(spec, resourceManager, timeManager, colonies);
+    }
+    double setupMs = (GetTime() - setupStart) * 1000.0;
+
+    int sectCount = 0;
+    int roadCount = 0;
+    int packetCount = 0;
+    for (Colony* colony : colonies)
+    {
+        sectCount += static_cast<int>(colony->GetSects().size());
+        roadCount += static_cast<int>(colony->GetRoads().size());
+        packetCount += static_cast<int>(colony->GetTransportJobs().size());
+    }
+
+    Colony* focus = colonies.front();
+    Camera2D camera = {0};
+    camera.offset = {options.width / 2.0f, options.height / 2.0f};
+    if (options.view == "colony")
+    {
+        // Frame the whole first colony
+        float extent = 2.0f * (focus->GetRadius() + SECT_CORE_RADIUS * 2.0f);
+        camera.target = focus->GetCentroid();
+        camera.zoom = std::min(options.width, options.height) / std::max(extent, 1.0f);
+    }
+    else
+    {
+        camera.target = {PLANET_WIDTH / 2.0f, PLANET_HEIGHT / 2.0f};
+        camera.zoom = std::min(options.width / PLANET_WIDTH, options.height / PLANET_HEIGHT);
+    }
+
+    bool countDraws = InstallDrawCallCounter();
+
+    // Fonts, terrain levels and overlays are built on first use; keep
+    // those frames out of the percentiles and report them separately.
+    const int warmupFrames = 2;
+    double warmupMs = 0.0;
+    std::vector<double> frameMs;
+    std::vector<double> drawCalls;
+    frameMs.reserve(options.frames);
+    drawCalls.reserve(options.frames);
+
+    for (int frame = 0; frame < warmupFrames + options.frames; frame++)
+    {
+        g_drawCalls = 0;
+        double start = GetTime();
+
+        BeginDrawing();
+        ClearBackground(BLACK);
+        if (options.view == "planet")
+        {
+            renderManager.DrawPlanetView(camera, &planet, colonies, inputManager, timeManager);
+        }
+        else if (options.view == "colony")
+        {
+            renderManager.DrawColonyView(camera, focus, &planet, colonies, inputManager, timeManager);
+        }
+        else if (options.view == "sect")
+        {
+            renderManager.DrawSectView(focus->GetSects().front(), timeManager);
+        }
+        else
+        {
+            renderManager.DrawOrbitalView();
+        }
+        EndDrawing();
+
+        double ms = (GetTime() - start) * 1000.0;
+        if (frame < warmupFrames)
+        {
+            warmupMs += ms;
+            continue;
+        }
+        frameMs.push_back(ms);
+        drawCalls.push_back(static_cast<double>(g_drawCalls));
+    }
+
+    RemoveDrawCallCounter();
+
+    std::ostringstream json;
+    json << "{\n"
+         << "  \"view\": \"" << options.view << "\",\n"
+         << "  \"width\": " << options.width << ",\n"
+         << "  \"height\": " << options.height << ",\n"
+         << "  \"frames\": " << options.frames << ",\n"
+         << "  \"world\": {\"colonies\": " << colonies.size() << ", \"sects\": " << sectCount
+         << ", \"roads\": " << roadCount << ", \"packets\": " << packetCount << "},\n"
+         << "  \"setupMs\": " << setupMs << ",\n"
+         << "  \"warmupMs\": " << warmupMs << ",\n"
+         << "  \"frameMs\": " << SummaryJson(frameMs) << ",\n"
+         << "  \"drawCalls\": " << (countDraws ? SummaryJson(drawCalls) : std::string("null")) << "\n"
+         << "}\n";
+
+    for (Colony* colony : colonies) delete colony;
+
+    if (options.jsonPath.empty())
+    {
+        std::cout << json.str();
+        return true;
+    }
+
+    std::ofstream file(options.jsonPath);
+    file << json.str();
+    if (!file)
+    {
+        std::cout << "Failed to write " << options.jsonPath << "\n";
+        return false;
+    }
+    std::cout << "Wrote " << options.jsonPath << "\n";
+    return true;
+}
+
 int main(int argc, char** argv)
 {
     PreviewOptions options;
@@ -194,8 +627,20 @@ int main(int argc, char** argv)
         camera.rotation = 0.0f;
         camera.zoom = 1.0f;
 
+        bool timedRun = options.bench || options.packets > 0;
+        if (options.bench)
+        {
+            if (!RunBench(options, renderManager, planet, timeManager,
+                          inputManager, resourceManager))
+                status = 1;
+        }
+        else if (options.packets > 0)
+        {
+            RunPacketStress(options);
+        }
+
         // Draw twice: the first frame lets fonts and textures settle.
-        for (int frame = 0; frame < 2; frame++)
+        for (int frame = 0; !timedRun && frame < 2; frame++)
         {
             BeginDrawing();
             ClearBackground(BLACK);
@@ -225,8 +670,10 @@ int main(int argc, char** argv)
 
         if (exported)
         {
-            std::cout << "Wrote " << options.outPath
-                      << " (view=" << options.view << ")\n";
+            std::cout << "Wrote " << options.outPath << " (view="
+                      << (options.bench ? "bench " + options.view
+                          : options.packets > 0 ? std::string("packets") : options.view)
+                      << ")\n";
         }
         else
         {
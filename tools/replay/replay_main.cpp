@@ -0,0 +1,132 @@
+// Session replay.
+//
+// Loads a session recording (F11 in game writes one), steps it headless at
+// full speed with every recorded command applied at its step, and checks
+// the state hashes the game took along the way. Prints one key=value line
+// per figure so scripts and CI can read it. Headless: links colony_sim only.
+//
+// Usage (from the repo root):
+//   cmake --build build --target colony_replay
+//   build/src/colony_replay session.colonyrec
+//   build/src/colony_replay session.colonyrec --serial --keep-going
+//
+// Exit status: 0 when every hash agreed, 1 on a mismatch or a refused
+// command, 2 when the recording cannot be read.
+
+#include "colony.h"
+#include "resource_manager.h"
+#include "session_recording.h"
+#include "sim_log.h"
+#include "sim_stepper.h"
+#include "time_manager.h"
+
+#include <cinttypes>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+struct ReplayToolOptions
+{
+    std::string path;
+    bool serial = false;            // step without the worker pool
+    bool keepGoing = false;         // count every mismatch, not just the first
+    bool quiet = true;              // simulation log at Warn
+};
+
+static void PrintUsage()
+{
+    std::cout
+        << "Usage: colony_replay <recording> [options]\n"
+        << "\n"
+        << "  --serial       step sects on one thread\n"
+        << "  --keep-going   replay to the end past a mismatch\n"
+        << "  --verbose      keep the simulation log at Info\n"
+        << "  --help         show this message\n";
+}
+
+static bool ParseArgs(int argc, char** argv, ReplayToolOptions& options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+
+        if (arg == "--help" || arg == "-h")
+        {
+            PrintUsage();
+            return false;
+        }
+        else if (arg == "--serial")
+        {
+            options.serial = true;
+        }
+        else if (arg == "--keep-going")
+        {
+            options.keepGoing = true;
+        }
+        else if (arg == "--verbose")
+        {
+            options.quiet = false;
+        }
+        else if (!arg.empty() && arg[0] != '-' && options.path.empty())
+        {
+            options.path = arg;
+        }
+        else
+        {
+            std::cerr << "Unknown option: " << arg << "\n";
+            PrintUsage();
+            return false;
+        }
+    }
+    if (options.path.empty())
+    {
+        PrintUsage();
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    ReplayToolOptions options;
+    if (!ParseArgs(argc, argv, options)) return 2;
+
+    if (options.quiet) Log::SetLevel(LogLevel::Warn);
+
+    ResourceManager resources(0, 1.0f);
+    TimeManager time;
+    SimStepper stepper;
+    stepper.SetParallelUpdate(!options.serial);
+    std::vector<Colony*> colonies;
+
+    ReplayOptions replayOptions;
+    replayOptions.stopAtMismatch = !options.keepGoing;
+    ReplayReport report;
+    std::string error;
+    bool ok = ReplaySession(options.path, replayOptions, stepper, resources, time, colonies, report, &error);
+    for (Colony* colony : colonies) delete colony;
+    Log::Flush();
+
+    if (!ok)
+    {
+        std::cerr << options.path << ": " << error << "\n";
+        return 2;
+    }
+
+    std::printf("steps=%d\n", report.steps);
+    std::printf("commands=%d\n", report.commands);
+    std::printf("rejected_commands=%d\n", report.rejectedCommands);
+    std::printf("hashes_checked=%d\n", report.hashesChecked);
+    std::printf("mismatches=%d\n", report.mismatches);
+    std::printf("first_mismatch_step=%d\n", report.firstMismatchStep);
+    if (report.mismatches > 0)
+    {
+        std::printf("expected_hash=%016" PRIx64 "\n", report.expectedHash);
+        std::printf("actual_hash=%016" PRIx64 "\n", report.actualHash);
+    }
+    std::printf("seconds=%.3f\n", report.seconds);
+    std::printf("steps_per_second=%.1f\n", report.seconds > 0.0 ? report.steps / report.seconds : 0.0);
+
+    return (report.mismatches == 0 && report.rejectedCommands == 0) ? 0 : 1;
+}
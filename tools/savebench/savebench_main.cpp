@@ -0,0 +1,276 @@
+// Save/load benchmark.
+//
+// Builds synthetic worlds of growing size, runs them for a few simulated
+// seconds so storage, depletion and transport are not at their defaults,
+// then times SaveGame::Save, SaveGame::Load and SaveGame::ReadSummary on
+// each. Then runs on with a RewindBuffer snapshot every
+// REWIND_INTERVAL_TICKS and reports the mean capture time, the time to
+// rewind to the oldest snapshot and the memory kept per retained second.
+// Headless: links colony_sim only.
+//
+// Usage (from the repo root):
+//   cmake --build build --target colony_savebench
+//   build/src/colony_savebench
+//   build/src/colony_savebench --grids 20,80,320 --sects-per-cell 0.05 --raw
+
+#include "colony.h"
+#include "game_constants.h"
+#include "game_snapshot.h"
+#include "resource_manager.h"
+#include "rewind_buffer.h"
+#include "sect.h"
+#include "sim_log.h"
+#include "time_manager.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+static const unsigned int BENCH_MAP_SEED = 20260813u;
+
+struct BenchOptions
+{
+    std::vector<int> grids = {20, 40, 80, 160};
+    float sectsPerCell = 0.02f;     // world size: sects scale with planet area
+    int sectsPerColony = 8;
+    int warmupSeconds = 30;         // simulated before saving
+    int rewindSeconds = 120;        // simulated with rewind snapshots
+    int repeats = 5;                // best of
+    bool compress = true;
+    std::string path = "savebench.colony";
+};
+
+static void PrintUsage()
+{
+    std::cout
+        << "Usage: colony_savebench [options]\n"
+        << "\n"
+        << "  --grids <A,B,..>      planet grid sizes (default: 20,40,80,160)\n"
+        << "  --sects-per-cell <F>  sects per planet cell (default: 0.02)\n"
+        << "  --sects <N>           sects per colony (default: 8)\n"
+        << "  --warmup <S>          simulated seconds before saving (default: 30)\n"
+        << "  --rewind <S>          simulated seconds of rewind snapshots (default: 120)\n"
+        << "  --repeat <K>          timed runs per size, best kept (default: 5)\n"
+        << "  --raw                 store sections uncompressed\n"
+        << "  --out <path>          scratch save file (default: savebench.colony)\n"
+        << "  --help                show this message\n";
+}
+
+static bool ParseArgs(int argc, char** argv, BenchOptions& options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        bool hasNext = i + 1 < argc;
+
+        if (arg == "--help" || arg == "-h")
+        {
+            PrintUsage();
+            return false;
+        }
+        else if (arg == "--grids" && hasNext)
+        {
+            options.grids.clear();
+            std::stringstream list(argv[++i]);
+            std::string item;
+            while (std::getline(list, item, ','))
+            {
+                options.grids.push_back(std::max(4, std::atoi(item.c_str())));
+            }
+        }
+        else if (arg == "--sects-per-cell" && hasNext)
+        {
+            options.sectsPerCell = std::max(0.0f, static_cast<float>(std::atof(argv[++i])));
+        }
+        else if (arg == "--sects" && hasNext)
+        {
+            options.sectsPerColony = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (arg == "--warmup" && hasNext)
+        {
+            options.warmupSeconds = std::max(0, std::atoi(argv[++i]));
+        }
+        else if (arg == "--rewind" && hasNext)
+        {
+            options.rewindSeconds = std::max(0, std::atoi(argv[++i]));
+        }
+        else if (arg == "--repeat" && hasNext)
+        {
+            options.repeats = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (arg == "--raw")
+        {
+            options.compress = false;
+        }
+        else if (arg == "--out" && hasNext)
+        {
+            options.path = argv[++i];
+        }
+        else
+        {
+            std::cerr << "Unknown or incomplete option: " << arg << "\n";
+            PrintUsage();
+            return false;
+        }
+    }
+    return true;
+}
+
+// Colonies of `sectsPerColony` sects each, at random cells, chained by
+// roads with a packet on every other one
+static std::vector<Colony*> BuildWorld(ResourceManager& resources, TimeManager& time,
+                                       int sectCount, int sectsPerColony)
+{
+    std::mt19937 random(BENCH_MAP_SEED);
+    const float cellSize = resources.GetCellSize();
+    std::uniform_real_distribution<float> coordinate(0.0f, resources.GetGridSize() * cellSize);
+
+    std::vector<Colony*> colonies;
+    for (int placed = 0; placed < sectCount; )
+    {
+        Colony* colony = new Colony();
+        Vector2 centre = {coordinate(random), coordinate(random)};
+        for (int s = 0; s < sectsPerColony && placed < sectCount; s++, placed++)
+        {
+            float angle = s * 2.39996f;
+            float radius = cellSize * std::sqrt(static_cast<float>(s));
+            Vector2 pos = {centre.x + radius * std::cos(angle), centre.y + radius * std::sin(angle)};
+            colony->AddSect(new Sect(pos, resources, time));
+        }
+
+        const auto& sects = colony->GetSects();
+        for (size_t s = 1; s < sects.size(); s++)
+        {
+            colony->BuildRoad(sects[s - 1], sects[s]);
+        }
+        for (size_t s = 1; s < sects.size(); s += 2)
+        {
+            colony->AddSyntheticTransportJob(colony->GetRoad(sects[s - 1], sects[s]),
+                                             ResourceType::Fe, TRANSPORT_PACKET_SIZE, 0.5f);
+        }
+        colonies.push_back(colony);
+    }
+    return colonies;
+}
+
+static void RunWarmup(TimeManager& time, std::vector<Colony*>& colonies, int seconds)
+{
+    const int ticks = static_cast<int>(seconds / TICK_DURATION);
+    for (int t = 0; t < ticks; t++)
+    {
+        time.Advance(TICK_DURATION);
+        for (Colony* colony : colonies)
+        {
+            for (Sect* sect : colony->GetSects())
+            {
+                if (sect->NeedsUpdate()) sect->Update(TICK_DURATION);
+            }
+            colony->ManageResources();
+            colony->ProcessTransportJobs(TICK_DURATION);
+        }
+    }
+}
+
+template <typename Fn>
+static double BestMilliseconds(int repeats, Fn&& fn)
+{
+    double best = 1e30;
+    for (int r = 0; r < repeats; r++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        if (!fn()) return -1.0;
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+int main(int argc, char** argv)
+{
+    BenchOptions options;
+    if (!ParseArgs(argc, argv, options)) return 1;
+
+    Log::SetLevel(LogLevel::Warn);
+
+    std::printf("%6s %7s %10s %10s %10s %10s %10s %10s %10s %10s\n",
+                "grid", "sects", "raw KB", "file KB", "save ms", "load ms", "meta ms",
+                "snap us", "rewind ms", "KB/s kept");
+
+    for (int grid : options.grids)
+    {
+        ResourceManager resources(grid, SECT_CORE_RADIUS * 2.0f);
+        resources.GenerateResourceMap(BENCH_MAP_SEED);
+        TimeManager time;
+
+        int sectCount = std::max(1, static_cast<int>(grid * grid * options.sectsPerCell));
+        std::vector<Colony*> colonies = BuildWorld(resources, time, sectCount, options.sectsPerColony);
+        RunWarmup(time, colonies, options.warmupSeconds);
+
+        std::string error;
+        SaveGame::SaveStats stats;
+        double saveMs = BestMilliseconds(options.repeats, [&]() {
+            return SaveGame::Save(options.path, resources, time, colonies, options.compress, &error, &stats);
+        });
+
+        double loadMs = BestMilliseconds(options.repeats, [&]() {
+            ResourceManager loadedResources(0, 1.0f);
+            TimeManager loadedTime;
+            std::vector<Colony*> loaded;
+            bool ok = SaveGame::Load(options.path, loadedResources, loadedTime, loaded, &error);
+            for (Colony* colony : loaded) delete colony;
+            return ok;
+        });
+
+        double metaMs = BestMilliseconds(options.repeats, [&]() {
+            SaveGame::Summary summary;
+            return SaveGame::ReadSummary(options.path, summary, &error);
+        });
+
+        // Snapshots over the rewind run, then straight back to the oldest
+        RewindBuffer rewind;
+        double captureMs = 0.0;
+        int captures = 0;
+        const int rewindTicks = static_cast<int>(options.rewindSeconds / TICK_DURATION);
+        for (int t = 0; t < rewindTicks; t += REWIND_INTERVAL_TICKS)
+        {
+            RunWarmup(time, colonies, static_cast<int>(REWIND_INTERVAL_TICKS * TICK_DURATION));
+            auto start = std::chrono::steady_clock::now();
+            rewind.Capture(resources, time, colonies);
+            captureMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            captures++;
+        }
+        RewindBuffer::Stats rewindStats = rewind.GetStats();
+        double rewindMs = 0.0;
+        if (rewind.GetCount() > 0)
+        {
+            std::vector<Colony*> restored;
+            auto start = std::chrono::steady_clock::now();
+            rewind.Restore(0, resources, time, restored);
+            rewindMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            for (Colony* colony : restored) delete colony;
+        }
+
+        for (Colony* colony : colonies) delete colony;
+
+        if (saveMs < 0.0 || loadMs < 0.0 || metaMs < 0.0)
+        {
+            std::cerr << "grid " << grid << ": " << error << "\n";
+            std::remove(options.path.c_str());
+            return 1;
+        }
+        std::printf("%6d %7d %10.1f %10.1f %10.2f %10.2f %10.3f %10.1f %10.2f %10.1f\n",
+                    grid, sectCount, stats.rawBytes / 1024.0, stats.fileBytes / 1024.0,
+                    saveMs, loadMs, metaMs,
+                    captures > 0 ? captureMs * 1000.0 / captures : 0.0,
+                    rewindMs, rewindStats.bytesPerSecond / 1024.0);
+    }
+
+    std::remove(options.path.c_str());
+    return 0;
+}
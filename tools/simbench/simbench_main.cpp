@@ -0,0 +1,392 @@
+// Simulation throughput benchmark.
+//
+// Builds canned worlds, steps each headless with SimStepper for a fixed
+// number of ticks (SimScheduler::STEP_SECONDS of game time each, as the
+// game runs them) and reports throughput, allocations and memory, one
+// line of key=value pairs per scenario so runs can be diffed and tracked
+// over time. Headless: links colony_sim only.
+//
+// Usage (from the repo root):
+//   cmake --build build --target colony_sim_bench
+//   build/src/colony_sim_bench
+//   build/src/colony_sim_bench --scenarios mesh --ticks 3000 --serial
+//   build/src/colony_sim_bench --world large,seed=7
+//
+// Peak RSS is the process high-water mark, so it only isolates a scenario
+// when that scenario runs alone (--scenarios <name>).
+
+#include "colony.h"
+#include "game_constants.h"
+#include "resource_manager.h"
+#include "sect.h"
+#include "sim_log.h"
+#include "sim_scheduler.h"
+#include "sim_stepper.h"
+#include "time_manager.h"
+#include "unit.h"
+#include "world_gen.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+// ---------------------------------------------------------------------------
+// Allocation counting: every plain new in the process goes through here
+// ---------------------------------------------------------------------------
+
+static std::atomic<unsigned long long> allocationCount{0};
+static std::atomic<unsigned long long> allocationBytes{0};
+
+static void* CountedAllocate(std::size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocationBytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* memory = std::malloc(size ? size : 1)) return memory;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size) { return CountedAllocate(size); }
+void* operator new[](std::size_t size) { return CountedAllocate(size); }
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
+
+// Kilobytes, or 0 where the platform does not say
+static long PeakResidentKilobytes()
+{
+#if defined(__APPLE__)
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<long>(usage.ru_maxrss / 1024);     // bytes on macOS
+#elif defined(__unix__)
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<long>(usage.ru_maxrss);            // kilobytes on Linux
+#else
+    return 0;
+#endif
+}
+
+// ---------------------------------------------------------------------------
+// Scenarios
+// ---------------------------------------------------------------------------
+
+static const unsigned int BENCH_MAP_SEED = 20260813u;
+
+enum class RoadLayout { NONE, CHAIN, MESH };
+
+struct Scenario
+{
+    const char* name;
+    const char* description;
+    int colonies;
+    int sectsPerColony;
+    RoadLayout roads;
+    bool extraction;        // extraction units at tier 3, every directive in use
+};
+
+static const Scenario SCENARIOS[] = {
+    {"single", "1 colony x 8 sects, roads chained", 1, 8, RoadLayout::CHAIN, false},
+    {"mesh", "20 colonies x 20 sects, full road mesh in AUTO_BALANCE", 20, 20, RoadLayout::MESH, false},
+    {"extraction", "8 colonies x 12 sects, tier 3 extraction, all directives", 8, 12, RoadLayout::CHAIN, true},
+};
+
+struct BenchOptions
+{
+    std::vector<std::string> scenarios;     // empty: all
+    std::string world;                      // world spec (world_gen.h) run as scenario "world"
+    int ticks = 900;                        // 30 s of game time
+    int warmup = 90;                        // untimed, so first-touch costs settle
+    bool parallel = true;
+    bool batched = true;
+};
+
+static void PrintUsage()
+{
+    std::cout
+        << "Usage: colony_sim_bench [options]\n"
+        << "\n"
+        << "  --scenarios <A,B,..>  scenarios to run (default: all)\n"
+        << "  --world <SPEC>        run a generated world instead, e.g. large,seed=7\n"
+        << "  --ticks <N>           timed ticks per scenario (default: 900)\n"
+        << "  --warmup <N>          untimed ticks first (default: 90)\n"
+        << "  --serial              step sects on one thread\n"
+        << "  --unbatched           run modules unit by unit, not from the ModuleStore\n"
+        << "  --list                list the scenarios\n"
+        << "  --help                show this message\n";
+}
+
+static bool ParseArgs(int argc, char** argv, BenchOptions& options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        bool hasNext = i + 1 < argc;
+
+        if (arg == "--help" || arg == "-h")
+        {
+            PrintUsage();
+            return false;
+        }
+        else if (arg == "--list")
+        {
+            for (const Scenario& scenario : SCENARIOS)
+            {
+                std::cout << scenario.name << ": " << scenario.description << "\n";
+            }
+            return false;
+        }
+        else if (arg == "--scenarios" && hasNext)
+        {
+            std::stringstream list(argv[++i]);
+            std::string item;
+            while (std::getline(list, item, ','))
+            {
+                options.scenarios.push_back(item);
+            }
+        }
+        else if (arg == "--world" && hasNext)
+        {
+            options.world = argv[++i];
+        }
+        else if (arg == "--ticks" && hasNext)
+        {
+            options.ticks = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (arg == "--warmup" && hasNext)
+        {
+            options.warmup = std::max(0, std::atoi(argv[++i]));
+        }
+        else if (arg == "--serial")
+        {
+            options.parallel = false;
+        }
+        else if (arg == "--unbatched")
+        {
+            options.batched = false;
+        }
+        else
+        {
+            std::cerr << "Unknown or incomplete option: " << arg << "\n";
+            PrintUsage();
+            return false;
+        }
+    }
+
+    for (const std::string& name : options.scenarios)
+    {
+        bool known = std::any_of(std::begin(SCENARIOS), std::end(SCENARIOS),
+                                 [&](const Scenario& scenario) { return name == scenario.name; });
+        if (!known)
+        {
+            std::cerr << "Unknown scenario: " << name << " (--list shows them)\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+static int FindModule(const Unit* unit, ModuleKind kind)
+{
+    const auto& modules = unit->GetModules();
+    for (size_t m = 0; m < modules.size(); m++)
+    {
+        if (modules[m].kind == kind) return static_cast<int>(m);
+    }
+    return -1;
+}
+
+// Every extraction module built and at tier 3, then one of the six
+// directives, chosen by sect so a colony runs all of them
+static void EquipExtraction(Unit* unit, int sectIndex)
+{
+    for (ModuleKind kind : {ModuleKind::EXCAVATION, ModuleKind::BENEFICIATION,
+                            ModuleKind::OPERATIONS, ModuleKind::DIRECTIVES})
+    {
+        int module = FindModule(unit, kind);
+        if (module < 0) continue;
+        unit->DebugBuildModule(module);
+        while (unit->DebugUpgradeModuleTier(module)) {}
+    }
+
+    static const ResourceType targets[] = {ResourceType::Fe, ResourceType::Ti, ResourceType::Si, ResourceType::Al};
+    Unit::ActiveDirective directive;
+    directive.type = static_cast<Unit::DirectiveType>(1 + sectIndex % 6);
+    directive.targetResource = targets[(sectIndex / 6) % 4];
+    unit->SetDirective(directive);
+}
+
+// Colonies on a square lattice far enough apart that jurisdictions do not
+// overlap, sects in a sunflower around each centre
+static std::vector<Colony*> BuildWorld(const Scenario& scenario, ResourceManager& resources, TimeManager& time,
+                                       const SimClock* clock)
+{
+    const float cellSize = resources.GetCellSize();
+    const int perRow = static_cast<int>(std::ceil(std::sqrt(static_cast<float>(scenario.colonies))));
+    const float spacing = cellSize * (2.0f * std::sqrt(static_cast<float>(scenario.sectsPerColony)) + 4.0f);
+
+    std::vector<Colony*> colonies;
+    for (int c = 0; c < scenario.colonies; c++)
+    {
+        Colony* colony = new Colony();
+        colony->SetClock(clock);
+        Vector2 centre = {spacing * (c % perRow + 0.5f), spacing * (c / perRow + 0.5f)};
+        for (int s = 0; s < scenario.sectsPerColony; s++)
+        {
+            float angle = s * 2.39996f;
+            float radius = cellSize * std::sqrt(static_cast<float>(s));
+            Vector2 pos = {centre.x + radius * std::cos(angle), centre.y + radius * std::sin(angle)};
+            Sect* sect = new Sect(pos, resources, time);
+            colony->AddSect(sect);
+
+            if (scenario.extraction)
+            {
+                for (Unit* unit : sect->GetUnits())
+                {
+                    if (unit->GetType() == UnitType::Extraction) EquipExtraction(unit, s);
+                }
+            }
+        }
+
+        const auto& sects = colony->GetSects();
+        for (size_t a = 0; a < sects.size(); a++)
+        {
+            if (scenario.roads == RoadLayout::CHAIN && a > 0)
+            {
+                colony->BuildRoad(sects[a - 1], sects[a]);
+            }
+            if (scenario.roads == RoadLayout::MESH)
+            {
+                for (size_t b = a + 1; b < sects.size(); b++)
+                {
+                    colony->BuildRoad(sects[a], sects[b]);
+                }
+            }
+        }
+        for (const Road& road : colony->GetRoads())
+        {
+            colony->SetRoadTransportMode(colony->GetRoad(road.sectA, road.sectB), TransportMode::AUTO_BALANCE);
+        }
+        colonies.push_back(colony);
+    }
+    return colonies;
+}
+
+// Warms up, then times options.ticks steps and prints the scenario's line
+static void TimeWorld(const char* name, std::vector<Colony*>& colonies, TimeManager& time,
+                      SimStepper& stepper, const BenchOptions& options)
+{
+    int sects = 0;
+    int roads = 0;
+    for (const Colony* colony : colonies)
+    {
+        sects += static_cast<int>(colony->GetSects().size());
+        roads += static_cast<int>(colony->GetRoads().size());
+    }
+
+    const float dt = SimScheduler::STEP_SECONDS;
+    auto step = [&]() {
+        time.Advance(dt);
+        stepper.Step(colonies, dt);
+    };
+    for (int t = 0; t < options.warmup; t++) step();
+
+    const unsigned long long allocationsBefore = allocationCount.load();
+    const unsigned long long bytesBefore = allocationBytes.load();
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < options.ticks; t++) step();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const double allocations = static_cast<double>(allocationCount.load() - allocationsBefore);
+    const double bytes = static_cast<double>(allocationBytes.load() - bytesBefore);
+
+    std::printf("scenario=%s colonies=%d sects=%d roads=%d ticks=%d parallel=%d batched=%d "
+                "seconds=%.4f ticks_per_second=%.1f ns_per_sect_tick=%.1f "
+                "allocs_per_tick=%.2f alloc_bytes_per_tick=%.1f peak_rss_kb=%ld\n",
+                name, static_cast<int>(colonies.size()), sects, roads, options.ticks,
+                options.parallel ? 1 : 0, options.batched ? 1 : 0,
+                seconds, options.ticks / seconds,
+                seconds * 1e9 / (static_cast<double>(options.ticks) * std::max(1, sects)),
+                allocations / options.ticks, bytes / options.ticks, PeakResidentKilobytes());
+    std::fflush(stdout);
+}
+
+static void RunScenario(const Scenario& scenario, const BenchOptions& options)
+{
+    int perRow = static_cast<int>(std::ceil(std::sqrt(static_cast<float>(scenario.colonies))));
+    int gridCells = static_cast<int>(std::ceil(perRow * (2.0f * std::sqrt(static_cast<float>(scenario.sectsPerColony)) + 4.0f)));
+
+    ResourceManager resources(std::max(20, gridCells), SECT_CORE_RADIUS * 2.0f);
+    resources.GenerateResourceMap(BENCH_MAP_SEED);
+    TimeManager time;
+    SimStepper stepper;
+    stepper.SetParallelUpdate(options.parallel);
+    stepper.SetBatchedModules(options.batched);
+
+    std::vector<Colony*> colonies = BuildWorld(scenario, resources, time, stepper.GetClock());
+    TimeWorld(scenario.name, colonies, time, stepper, options);
+
+    stepper.Release();
+    for (Colony* colony : colonies) delete colony;
+}
+
+static void RunGeneratedWorld(const WorldSpec& spec, const BenchOptions& options)
+{
+    ResourceManager resources(WorldGridSize(spec), SECT_CORE_RADIUS * 2.0f);
+    TimeManager time;
+    SimStepper stepper;
+    stepper.SetParallelUpdate(options.parallel);
+    stepper.SetBatchedModules(options.batched);
+
+    std::vector<Colony*> colonies;
+    GenerateWorld(spec, resources, time, colonies, stepper.GetClock());
+    TimeWorld("world", colonies, time, stepper, options);
+
+    stepper.Release();
+    for (Colony* colony : colonies) delete colony;
+}
+
+int main(int argc, char** argv)
+{
+    BenchOptions options;
+    if (!ParseArgs(argc, argv, options)) return 1;
+
+    Log::SetLevel(LogLevel::Warn);
+
+    if (!options.world.empty())
+    {
+        WorldSpec spec;
+        std::string error;
+        if (!ParseWorldSpec(options.world, spec, &error))
+        {
+            std::cerr << error << "\n";
+            return 1;
+        }
+        RunGeneratedWorld(spec, options);
+        Log::Flush();
+        return 0;
+    }
+
+    for (const Scenario& scenario : SCENARIOS)
+    {
+        bool selected = options.scenarios.empty() ||
+                        std::find(options.scenarios.begin(), options.scenarios.end(), scenario.name) !=
+                            options.scenarios.end();
+        if (selected) RunScenario(scenario, options);
+    }
+
+    Log::Flush();
+    return 0;
+}
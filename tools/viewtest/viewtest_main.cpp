@@ -11,6 +11,7 @@
 //   I                            toggle the issue overlay
 //   R                            re-roll the sect's grid cell (new terrain)
 //   wheel / - / +                planet view: zoom out to the whole moon
+//   F12 / Shift+F12              screenshot / toggle burst recording
 //
 // Build:  cmake --build build --target colony_viewtest
 // Run:    tools/viewtest/viewtest.sh          (headless screenshots)
@@ -28,8 +29,10 @@
 #include "game_constants.h"
 #include "game_enums.h"
 #include "terrain_synthesis.h"
+#include "screenshot_capture.h"
 
 #include <cstdlib>
+#include <ctime>
 #include <string>
 #include <vector>
 
@@ -157,6 +160,8 @@ struct ViewTestContext
     Camera2D camera = {0};
     bool headless = false;
     std::string shotPrefix;
+    ScreenshotCapture* capture = nullptr;
+    int burstInterval = 0;      // --burst N: record every Nth frame from launch
 };
 
 static ViewTestContext g_ctx;
@@ -423,6 +428,28 @@ static void HandleInput(ViewTestContext& ctx)
     if (IsKeyPressed(KEY_FOUR)) ctx.level = 3;
     if (IsKeyPressed(KEY_I)) ctx.showIssues = !ctx.showIssues;
 
+    if (IsKeyPressed(KEY_F12) && ctx.capture)
+    {
+        time_t now = time(nullptr);
+        char name[64];
+        bool shift = IsKeyDown(KEY_LEFT_SHIFT) || IsKeyDown(KEY_RIGHT_SHIFT);
+        if (shift && ctx.capture->IsBursting())
+        {
+            ctx.capture->StopBurst();
+        }
+        else if (shift)
+        {
+            strftime(name, sizeof(name), "viewtest_burst_%Y%m%d_%H%M%S", localtime(&now));
+            ctx.capture->StartBurst(name, ctx.burstInterval > 0 ? ctx.burstInterval
+                                                               : ScreenshotCapture::DEFAULT_BURST_INTERVAL);
+        }
+        else
+        {
+            strftime(name, sizeof(name), "viewtest_%Y%m%d_%H%M%S.png", localtime(&now));
+            ctx.capture->Request(name);
+        }
+    }
+
     // Planet view zooms out to the whole moon and back.
     if (ctx.level == 1)
     {
@@ -599,6 +626,7 @@ static void DrawFrame(ViewTestContext& ctx)
     if (ctx.showIssues) DrawIssuePanel(ctx);
     DrawNavBar(ctx);
 
+    if (ctx.capture) ctx.capture->EndFrame();
     EndDrawing();
 }
 
@@ -620,6 +648,10 @@ int main(int argc, char** argv)
             g_ctx.headless = true;
             g_ctx.shotPrefix = argv[++i];
         }
+        else if (a == "--burst" && i + 1 < argc)
+        {
+            g_ctx.burstInterval = atoi(argv[++i]);
+        }
         else if (a == "--nodisturb")
         {
             SetSiteDisturbanceEnabled(false);
@@ -650,6 +682,7 @@ int main(int argc, char** argv)
         resourceManager.GenerateResourceMap(20260813u);
         Planet planet;
         Colony colony;
+        ScreenshotCapture capture;
 
         g_ctx.renderManager = &renderManager;
         g_ctx.timeManager = &timeManager;
@@ -658,6 +691,7 @@ int main(int argc, char** argv)
         g_ctx.planet = &planet;
         g_ctx.colony = &colony;
         g_ctx.colonies.push_back(&colony);
+        g_ctx.capture = &capture;
 
         g_ctx.camera.target = {PLANET_WIDTH / 2.0f, PLANET_HEIGHT / 2.0f};
         g_ctx.camera.offset = {VT_WIDTH / 2.0f, VT_HEIGHT / 2.0f};
@@ -678,14 +712,11 @@ int main(int argc, char** argv)
             for (int lvl = 0; lvl < 4; lvl++)
             {
                 g_ctx.level = lvl;
-                DrawFrame(g_ctx);      // settle fonts/textures
-                DrawFrame(g_ctx);
-                Image shot = LoadImageFromScreen();
                 const char* names[4] = {"orbital", "planet", "colony", "sect"};
                 std::string path = g_ctx.shotPrefix + "_" + names[lvl] + ".png";
-                ExportImage(shot, path.c_str());
-                UnloadImage(shot);
-                TraceLog(LOG_WARNING, "wrote %s", path.c_str());
+                DrawFrame(g_ctx);      // settle fonts/textures
+                capture.Request(path);
+                DrawFrame(g_ctx);
             }
 
             // Planet-view zoom sweep: playfield -> regional -> globe.
@@ -698,12 +729,8 @@ int main(int argc, char** argv)
                 {
                     g_ctx.planetZoomT = ts[i];
                     DrawFrame(g_ctx);
+                    capture.Request(g_ctx.shotPrefix + "_" + zn[i] + ".png");
                     DrawFrame(g_ctx);
-                    Image sh = LoadImageFromScreen();
-                    std::string pth = g_ctx.shotPrefix + "_" + zn[i] + ".png";
-                    ExportImage(sh, pth.c_str());
-                    UnloadImage(sh);
-                    TraceLog(LOG_WARNING, "wrote %s", pth.c_str());
                 }
                 g_ctx.planetZoomT = 1.0f;
             }
@@ -734,15 +761,13 @@ int main(int argc, char** argv)
                     SetMousePosition((int)d.mx, (int)d.my);
                     DrawFrame(g_ctx);
                     SetMousePosition((int)d.mx, (int)d.my);
+                    capture.Request(g_ctx.shotPrefix + "_" + d.name + ".png");
                     DrawFrame(g_ctx);
-                    Image sh = LoadImageFromScreen();
-                    std::string pth = g_ctx.shotPrefix + "_" + d.name + ".png";
-                    ExportImage(sh, pth.c_str());
-                    UnloadImage(sh);
-                    TraceLog(LOG_WARNING, "wrote %s", pth.c_str());
                 }
                 g_ctx.pickPending = false;
             }
+
+            capture.Flush();
         }
         else
         {
@@ -750,6 +775,8 @@ int main(int argc, char** argv)
             emscripten_set_main_loop_arg(UpdateFrame, &g_ctx, 0, 1);
 #else
             SetTargetFPS(60);
+            if (g_ctx.burstInterval > 0)
+                capture.StartBurst("viewtest_burst", g_ctx.burstInterval);
             while (!WindowShouldClose())
             {
                 UpdateFrame(&g_ctx);
@@ -757,6 +784,8 @@ int main(int argc, char** argv)
 #endif
         }
 
+        capture.Flush();
+        g_ctx.capture = nullptr;
         delete g_ctx.sect;
         g_ctx.sect = nullptr;
     }
@@ -0,0 +1,164 @@
+// Synthetic world generator.
+//
+// Generates a world from a compact spec (see src/WorldGen/world_gen.h for
+// the keys and presets), optionally steps it, and writes it as an ordinary
+// save. Written as quicksave.colony it loads in game with Shift+F9. Prints
+// what it built as key=value lines. Headless: links colony_sim only.
+//
+// Usage (from the repo root):
+//   cmake --build build --target colony_worldgen
+//   build/src/colony_worldgen --spec large,seed=7 --out quicksave.colony
+//   build/src/colony_worldgen --spec colonies=64,sects=8-32,modes=1:1:1 --steps 300
+//
+// Exit status: 0 on success, 1 on a bad spec or a failed save.
+
+#include "colony.h"
+#include "game_constants.h"
+#include "game_snapshot.h"
+#include "resource_manager.h"
+#include "sim_log.h"
+#include "sim_scheduler.h"
+#include "sim_stepper.h"
+#include "time_manager.h"
+#include "world_gen.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+struct WorldGenOptions
+{
+    std::string spec = "small";
+    std::string path = "world.colony";
+    int steps = 0;                  // simulation steps before saving
+    bool compress = true;
+    bool quiet = true;              // simulation log at Warn
+};
+
+static void PrintUsage()
+{
+    std::cout
+        << "Usage: colony_worldgen [options]\n"
+        << "\n"
+        << "  --spec <SPEC>    world spec, e.g. large,seed=7 (default: small)\n"
+        << "  --out <path>     save file to write (default: world.colony)\n"
+        << "  --steps <N>      run N simulation steps before saving (default: 0)\n"
+        << "  --uncompressed   write the save without block compression\n"
+        << "  --verbose        keep the simulation log at Info\n"
+        << "  --help           show this message\n"
+        << "\n"
+        << "Spec keys: seed colonies sects roads modes active build tier\n"
+        << "           separation prospecting packets; presets small large huge\n";
+}
+
+static bool ParseArgs(int argc, char** argv, WorldGenOptions& options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        bool hasNext = i + 1 < argc;
+
+        if (arg == "--help" || arg == "-h")
+        {
+            PrintUsage();
+            return false;
+        }
+        else if (arg == "--spec" && hasNext)
+        {
+            options.spec = argv[++i];
+        }
+        else if (arg == "--out" && hasNext)
+        {
+            options.path = argv[++i];
+        }
+        else if (arg == "--steps" && hasNext)
+        {
+            options.steps = std::max(0, std::atoi(argv[++i]));
+        }
+        else if (arg == "--uncompressed")
+        {
+            options.compress = false;
+        }
+        else if (arg == "--verbose")
+        {
+            options.quiet = false;
+        }
+        else
+        {
+            std::cerr << "Unknown or incomplete option: " << arg << "\n";
+            PrintUsage();
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    WorldGenOptions options;
+    if (!ParseArgs(argc, argv, options)) return 1;
+
+    WorldSpec spec;
+    std::string error;
+    if (!ParseWorldSpec(options.spec, spec, &error))
+    {
+        std::cerr << error << "\n";
+        return 1;
+    }
+    if (options.quiet) Log::SetLevel(LogLevel::Warn);
+
+    ResourceManager resources(WorldGridSize(spec), SECT_CORE_RADIUS * 2.0f);
+    TimeManager time;
+    SimStepper stepper;
+    std::vector<Colony*> colonies;
+    WorldStats stats;
+
+    auto start = std::chrono::steady_clock::now();
+    GenerateWorld(spec, resources, time, colonies, stepper.GetClock(), &stats);
+    double generateMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    for (int step = 0; step < options.steps; step++)
+    {
+        time.Advance(SimScheduler::STEP_SECONDS);
+        stepper.Step(colonies, SimScheduler::STEP_SECONDS);
+    }
+    stepper.Release();
+
+    SaveGame::SaveStats saveStats;
+    bool saved = SaveGame::Save(options.path, resources, time, colonies, options.compress, &error, &saveStats);
+    for (Colony* colony : colonies) delete colony;
+    Log::Flush();
+
+    if (!saved)
+    {
+        std::cerr << options.path << ": " << error << "\n";
+        return 1;
+    }
+
+    std::printf("spec=%s\n", FormatWorldSpec(spec).c_str());
+    std::printf("grid=%d\n", resources.GetGridSize());
+    std::printf("colonies=%d\n", stats.colonies);
+    std::printf("sects=%d\n", stats.sects);
+    std::printf("roads=%d\n", stats.roads);
+    std::printf("roads_auto_balance=%d\n", stats.roadsByMode[0]);
+    std::printf("roads_manual=%d\n", stats.roadsByMode[1]);
+    std::printf("roads_deficit_triggered=%d\n", stats.roadsByMode[2]);
+    std::printf("units=%d\n", stats.units);
+    std::printf("active_units=%d\n", stats.activeUnits);
+    std::printf("modules_built=%d\n", stats.modulesBuilt);
+    std::printf("module_tiers=%d\n", stats.moduleTiers);
+    std::printf("directives=%d\n", stats.directives);
+    std::printf("separation_nodes=%d\n", stats.separationNodes);
+    std::printf("prospecting_units=%d\n", stats.prospectingUnits);
+    std::printf("samples=%d\n", stats.samples);
+    std::printf("packets=%d\n", stats.packets);
+    std::printf("steps=%d\n", options.steps);
+    std::printf("generate_ms=%.1f\n", generateMs);
+    std::printf("save=%s\n", options.path.c_str());
+    std::printf("save_kb=%.1f\n", saveStats.fileBytes / 1024.0);
+    return 0;
+}